@@ -0,0 +1,41 @@
+# SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+#
+
+if(TARGET benchmark::benchmark)
+  return()
+endif()
+
+if(OTK_USE_VCPKG)
+    find_package(benchmark CONFIG REQUIRED)
+    return()
+endif()
+
+if( NOT OTK_FETCH_CONTENT )
+  find_package( benchmark REQUIRED )
+  return()
+endif()
+
+include(FetchContent)
+
+set( BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "Enable testing of the benchmark library" )
+set( BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "Enable installation of benchmark" )
+set( BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "Enable building the unit tests which depend on gtest" )
+
+message(VERBOSE "Finding benchmark...")
+FetchContent_Declare(
+  benchmark
+  GIT_REPOSITORY https://github.com/google/benchmark.git
+  GIT_TAG v1.9.1
+  GIT_SHALLOW TRUE
+  FIND_PACKAGE_ARGS
+)
+FetchContent_MakeAvailable(benchmark)
+# Let find_package know we have it
+set(benchmark_FOUND ON PARENT_SCOPE)
+
+foreach(_target benchmark benchmark_main)
+  if(TARGET ${_target})
+    set_property(TARGET ${_target} PROPERTY FOLDER ThirdParty/benchmark)
+  endif()
+endforeach()
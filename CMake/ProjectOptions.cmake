@@ -19,6 +19,7 @@ option( OTK_USE_OIIO          "Use OpenImageIO to allow DemandLoading to read PN
 option( OTK_FETCH_CONTENT     "Use FetchContent for third party libraries, if OTK_USE_VCPKG is OFF" ON )
 option( OTK_BUILD_EXAMPLES    "Enable build of OptiXToolkit examples" ON )
 option( OTK_BUILD_TESTS       "Enable build of OptiXToolkit test" ON )
+option( OTK_BUILD_BENCHMARKS  "Enable build of OptiXToolkit host-side benchmarks" OFF )
 option( OTK_BUILD_DOCS        "Enable build of OptiXToolkit documentation" ON )
 option( OTK_BUILD_PYOPTIX     "Enable build of PyOptiX libraries" OFF )
 option( OTK_WARNINGS_AS_ERRORS "Treat compiler warnings as errors" OFF )
@@ -66,6 +67,7 @@ if( OTK_USE_VCPKG )
     otk_vcpkg_feature( OTK_USE_OIIO           "otk-openimageio" )
     otk_vcpkg_feature( OTK_BUILD_EXAMPLES     "otk-examples" )
     otk_vcpkg_feature( OTK_BUILD_TESTS        "otk-tests" )
+    otk_vcpkg_feature( OTK_BUILD_BENCHMARKS   "otk-benchmarks" )
     
     # Enable otk-neuraltextures feature if NeuralTextures library is being built
     if( OTK_LIBRARIES STREQUAL "ALL" OR "NeuralTextures" IN_LIST OTK_LIBRARIES )
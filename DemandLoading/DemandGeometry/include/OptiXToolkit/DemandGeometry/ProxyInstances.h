@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -12,6 +12,7 @@
 
 #include <functional>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
 #include <OptiXToolkit/DemandGeometry/DemandGeometry.h>
@@ -27,11 +28,23 @@ class DemandLoader;
 
 namespace demandGeometry {
 
+/// Proxies are intersected as instances of a unit cube custom primitive.
+///
+/// Each proxy occupies an instance slot that is stable until the instance acceleration
+/// structure is compacted.  Removing a proxy leaves a tombstone instance in its slot, and
+/// adding a proxy reuses free slots before growing the instance array.  createTraversable
+/// only uploads the changed instances and refits the IAS while the number of slots is
+/// unchanged.  The IAS is rebuilt when slots are appended, and compacted when the fraction
+/// of free slots exceeds the maximum fragmentation.
+///
 class ProxyInstances : public GeometryLoader
 {
   public:
     static constexpr uint_t PAGE_CHUNK_SIZE = 16U;
 
+    /// The default maximum fraction of free instance slots before the IAS is compacted.
+    static constexpr float DEFAULT_MAX_FRAGMENTATION = 0.25f;
+
     ProxyInstances( demandLoading::DemandLoader* loader );
     ~ProxyInstances() override = default;
 
@@ -84,6 +97,8 @@ class ProxyInstances : public GeometryLoader
 
     /// Create the traversable for the proxies.
     ///
+    /// Compacting the instance slots also copies the moved proxy data to the device.
+    ///
     /// @param  dc          The OptiX device context to use for the AS build.
     /// @param  stream      The stream used to build the traversable.
     ///
@@ -116,7 +131,24 @@ class ProxyInstances : public GeometryLoader
     /// The default is to not recycle proxy ids.
     void setRecycleProxyIds( bool enable ) override { m_recycleProxyIds = enable; }
 
+    /// Return the maximum fraction of free instance slots before the IAS is compacted.
+    float getMaxFragmentation() const { return m_maxFragmentation; }
+
+    /// Set the maximum fraction of free instance slots before the IAS is compacted.
+    ///
+    /// @param  fraction    A value in [0, 1]; zero compacts on every removal.
+    ///
+    void setMaxFragmentation( float fraction ) { m_maxFragmentation = fraction; }
+
+    /// Return the number of instance slots, including free slots.
+    uint_t getNumInstanceSlots() const;
+
+    /// Return the number of free instance slots.
+    uint_t getNumFreeInstanceSlots() const;
+
   private:
+    static constexpr uint_t FREE_SLOT = ~0U;
+
     struct PageIdRange
     {
         uint_t m_size;
@@ -134,10 +166,14 @@ class ProxyInstances : public GeometryLoader
     uint_t allocateResource();
     void   deallocateResource( uint_t pageId );
 
-    uint_t insertResource( uint_t pageId );
+    uint_t allocateSlot( uint_t pageId );
+
+    OptixInstance getInstance( uint_t slot ) const;
+    void          compactSlots();
 
     void                   createProxyGeomAS( OptixDeviceContext dc, CUstream stream );
     OptixTraversableHandle createProxyInstanceAS( OptixDeviceContext dc, CUstream stream );
+    void                   buildProxyInstanceAS( OptixDeviceContext dc, CUstream stream, OptixBuildOperation operation );
 
     mutable std::mutex m_proxyDataMutex;  // protects the CPU proxy data structures.
 
@@ -145,15 +181,19 @@ class ProxyInstances : public GeometryLoader
     std::vector<PageIdRange>     m_pageRanges;
     std::vector<uint_t>          m_freePages;
 
-    otk::SyncVector<OptixAabb> m_primitiveBounds;
-    otk::SyncVector<OptixAabb> m_proxyData;
-    std::vector<uint_t>        m_proxyPageIds;
-    otk::DeviceBuffer          m_devTempAccelBuffer;
-    otk::DeviceBuffer          m_devProxyGeomAccelBuffer;
-    OptixTraversableHandle     m_proxyGeomTraversable{};
+    otk::SyncVector<OptixAabb>         m_primitiveBounds;
+    otk::SyncVector<OptixAabb>         m_proxyData;    // proxy bounds, indexed by instance slot
+    std::vector<uint_t>                m_slotPageIds;  // proxy page ids, indexed by instance slot; FREE_SLOT if unused
+    std::unordered_map<uint_t, uint_t> m_pageIdSlots;  // instance slot of each proxy page id
+    std::vector<uint_t>                m_freeSlots;
+    std::vector<uint_t>                m_dirtySlots;   // instance slots changed since the last IAS build
+    otk::DeviceBuffer                  m_devTempAccelBuffer;
+    otk::DeviceBuffer                  m_devProxyGeomAccelBuffer;
+    OptixTraversableHandle             m_proxyGeomTraversable{};
 
     otk::SyncVector<OptixInstance> m_proxyInstances;
     otk::DeviceBuffer              m_devProxyInstanceAccelBuffer;
+    OptixAccelBufferSizes          m_proxyInstanceAccelSizes{};
     OptixTraversableHandle         m_proxyInstanceTraversable{};
     otk::SyncVector<uint32_t>      m_sbtIndices;
 
@@ -161,7 +201,8 @@ class ProxyInstances : public GeometryLoader
 
     std::vector<uint_t> m_requestedResources;
 
-    bool m_recycleProxyIds{};
+    bool  m_recycleProxyIds{};
+    float m_maxFragmentation{ DEFAULT_MAX_FRAGMENTATION };
 };
 
 }  // namespace demandGeometry
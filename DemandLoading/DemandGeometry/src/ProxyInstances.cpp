@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -64,9 +64,9 @@ uint_t ProxyInstances::add( const OptixAabb& bounds )
 {
     std::lock_guard<std::mutex> lock( m_proxyDataMutex );
 
-    const uint_t index = allocateResource();
-    m_proxyData.insert( m_proxyData.begin() + index, bounds );
-    return m_proxyPageIds[index];
+    const uint_t pageId = allocateResource();
+    m_proxyData[allocateSlot( pageId )] = bounds;
+    return pageId;
 }
 
 void ProxyInstances::remove( uint_t pageId )
@@ -77,13 +77,17 @@ void ProxyInstances::remove( uint_t pageId )
     std::lock_guard<std::mutex> lock( m_proxyDataMutex );
 
     {
-        auto pos = std::lower_bound( m_proxyPageIds.begin(), m_proxyPageIds.end(), pageId );
-        if( pos == m_proxyPageIds.end() || *pos != pageId )
+        auto pos = m_pageIdSlots.find( pageId );
+        if( pos == m_pageIdSlots.end() )
             throw std::runtime_error( "Resource not found for page " + std::to_string( pageId ) );
 
-        const int index = static_cast<int>( pos - m_proxyPageIds.begin() );
-        m_proxyData.erase( m_proxyData.begin() + index );
-        m_proxyPageIds.erase( m_proxyPageIds.begin() + index );
+        // Leave a tombstone in the slot, so that the instance count is unchanged.
+        const uint_t slot = pos->second;
+        m_pageIdSlots.erase( pos );
+        m_slotPageIds[slot] = FREE_SLOT;
+        m_proxyData[slot]   = OptixAabb{};
+        m_freeSlots.push_back( slot );
+        m_dirtySlots.push_back( slot );
     }
 
     {
@@ -95,6 +99,18 @@ void ProxyInstances::remove( uint_t pageId )
     deallocateResource( pageId );
 }
 
+uint_t ProxyInstances::getNumInstanceSlots() const
+{
+    std::lock_guard<std::mutex> lock( m_proxyDataMutex );
+    return static_cast<uint_t>( m_slotPageIds.size() );
+}
+
+uint_t ProxyInstances::getNumFreeInstanceSlots() const
+{
+    std::lock_guard<std::mutex> lock( m_proxyDataMutex );
+    return static_cast<uint_t>( m_freeSlots.size() );
+}
+
 void ProxyInstances::copyToDevice()
 {
     m_proxyData.copyToDevice();
@@ -155,43 +171,123 @@ static void transform( float ( &result )[12], const OptixAabb& bounds )
     std::copy( std::begin( matrix ), std::end( matrix ), std::begin( result ) );
 }
 
+OptixInstance ProxyInstances::getInstance( uint_t slot ) const
+{
+    OptixInstance instance{};
+    instance.traversableHandle = m_proxyGeomTraversable;
+    instance.flags             = OPTIX_INSTANCE_FLAG_NONE;
+    if( m_slotPageIds[slot] == FREE_SLOT )
+    {
+        // A tombstone has a zero transform and visibility mask, so it is never intersected.
+        instance.visibilityMask = 0U;
+        return instance;
+    }
+
+    transform( instance.transform, m_proxyData[slot] );
+    instance.instanceId     = m_slotPageIds[slot];
+    instance.sbtOffset      = 0U;
+    instance.visibilityMask = 255U;
+    return instance;
+}
+
+void ProxyInstances::compactSlots()
+{
+    // Move the proxies down over the free slots, preserving their order.
+    uint_t numSlots = 0;
+    for( uint_t slot = 0; slot < m_slotPageIds.size(); ++slot )
+    {
+        const uint_t pageId = m_slotPageIds[slot];
+        if( pageId == FREE_SLOT )
+            continue;
+
+        m_slotPageIds[numSlots] = pageId;
+        m_proxyData[numSlots]   = m_proxyData[slot];
+        m_pageIdSlots[pageId]   = numSlots;
+        ++numSlots;
+    }
+    m_slotPageIds.resize( numSlots );
+    m_proxyData.resize( numSlots );
+    m_freeSlots.clear();
+}
+
 OptixTraversableHandle ProxyInstances::createProxyInstanceAS( OptixDeviceContext dc, CUstream stream )
 {
-    m_proxyInstances.clear();
-    for( size_t i = 0; i < m_proxyData.size(); ++i )
+    std::lock_guard<std::mutex> lock( m_proxyDataMutex );
+
+    bool rebuild = m_proxyInstanceTraversable == NULL_TRAVERSABLE;
+    if( !m_freeSlots.empty()
+        && static_cast<float>( m_freeSlots.size() ) > m_maxFragmentation * static_cast<float>( m_slotPageIds.size() ) )
+    {
+        // Compaction moves proxies to other slots, so their device data must move with them.
+        compactSlots();
+        m_proxyData.copyToDeviceAsync( stream );
+        rebuild = true;
+    }
+
+    // Changing the number of instances requires a full build.
+    if( rebuild || m_slotPageIds.size() != m_proxyInstances.size() )
     {
-        OptixInstance instance{};
-        transform( instance.transform, m_proxyData[i] );
-        instance.instanceId        = m_proxyPageIds[i];
-        instance.sbtOffset         = 0U;
-        instance.visibilityMask    = 255U;
-        instance.flags             = OPTIX_INSTANCE_FLAG_NONE;
-        instance.traversableHandle = m_proxyGeomTraversable;
-        m_proxyInstances.push_back( instance );
+        m_proxyInstances.resize( m_slotPageIds.size() );
+        for( uint_t slot = 0; slot < m_slotPageIds.size(); ++slot )
+        {
+            m_proxyInstances[slot] = getInstance( slot );
+        }
+        m_proxyInstances.copyToDeviceAsync( stream );
+        m_dirtySlots.clear();
+        buildProxyInstanceAS( dc, stream, OPTIX_BUILD_OPERATION_BUILD );
+        return m_proxyInstanceTraversable;
+    }
+
+    if( m_dirtySlots.empty() )
+    {
+        return m_proxyInstanceTraversable;
+    }
+
+    // Upload runs of consecutive changed instances and refit the IAS.
+    std::sort( m_dirtySlots.begin(), m_dirtySlots.end() );
+    m_dirtySlots.erase( std::unique( m_dirtySlots.begin(), m_dirtySlots.end() ), m_dirtySlots.end() );
+    for( size_t i = 0; i < m_dirtySlots.size(); )
+    {
+        const uint_t first = m_dirtySlots[i];
+        uint_t       count = 0;
+        for( ; i < m_dirtySlots.size() && m_dirtySlots[i] == first + count; ++i, ++count )
+        {
+            m_proxyInstances[m_dirtySlots[i]] = getInstance( m_dirtySlots[i] );
+        }
+        m_proxyInstances.copyToDeviceAsync( first, count, stream );
     }
-    m_proxyInstances.copyToDeviceAsync( stream );
+    m_dirtySlots.clear();
+    buildProxyInstanceAS( dc, stream, OPTIX_BUILD_OPERATION_UPDATE );
+    return m_proxyInstanceTraversable;
+}
 
+void ProxyInstances::buildProxyInstanceAS( OptixDeviceContext dc, CUstream stream, OptixBuildOperation operation )
+{
     const uint_t    NUM_BUILD_INPUTS = 1;
     OptixBuildInput inputs[NUM_BUILD_INPUTS]{};
-    otk::BuildInputBuilder( inputs ).instanceArray( m_proxyInstances, static_cast<uint_t>( m_proxyData.size() ) );
+    otk::BuildInputBuilder( inputs ).instanceArray( m_proxyInstances, static_cast<uint_t>( m_proxyInstances.size() ) );
 
     OptixAccelBuildOptions options = {
-        OPTIX_BUILD_FLAG_NONE,       // buildFlags
-        OPTIX_BUILD_OPERATION_BUILD,  // operation
+        OPTIX_BUILD_FLAG_ALLOW_UPDATE,  // buildFlags
+        operation,                      // operation
         OptixMotionOptions{/*numKeys=*/0, /*flags=*/0, /*timeBegin=*/0.f, /*timeEnd=*/0.f}
     };
-    OptixAccelBufferSizes sizes{};
-    OTK_ERROR_CHECK( optixAccelComputeMemoryUsage( dc, &options, inputs, NUM_BUILD_INPUTS, &sizes ) );
+    if( operation == OPTIX_BUILD_OPERATION_BUILD )
+    {
+        OTK_ERROR_CHECK( optixAccelComputeMemoryUsage( dc, &options, inputs, NUM_BUILD_INPUTS, &m_proxyInstanceAccelSizes ) );
+        m_devProxyInstanceAccelBuffer.resize( m_proxyInstanceAccelSizes.outputSizeInBytes );
+    }
 
-    m_devTempAccelBuffer.resize( sizes.tempSizeInBytes );
-    m_devProxyInstanceAccelBuffer.resize( sizes.outputSizeInBytes );
+    // An update refits the IAS in place.
+    const size_t tempSizeInBytes = operation == OPTIX_BUILD_OPERATION_BUILD ? m_proxyInstanceAccelSizes.tempSizeInBytes :
+                                                                              m_proxyInstanceAccelSizes.tempUpdateSizeInBytes;
+    m_devTempAccelBuffer.resize( tempSizeInBytes );
     OTK_ERROR_CHECK( optixAccelBuild( dc, stream, &options, inputs, NUM_BUILD_INPUTS, m_devTempAccelBuffer,
-                                  sizes.tempSizeInBytes, m_devProxyInstanceAccelBuffer, sizes.outputSizeInBytes,
+                                  tempSizeInBytes, m_devProxyInstanceAccelBuffer, m_proxyInstanceAccelSizes.outputSizeInBytes,
                                   &m_proxyInstanceTraversable, nullptr, 0 ) );
 #ifndef NDEBG
     OTK_CUDA_SYNC_CHECK();
 #endif    
-    return m_proxyInstanceTraversable;
 }
 
 OptixTraversableHandle ProxyInstances::createTraversable( OptixDeviceContext dc, CUstream stream )
@@ -223,12 +319,9 @@ bool ProxyInstances::callback( CUstream /*stream*/, uint_t pageId, void** /*page
 {
     std::lock_guard<std::mutex> lock( m_proxyDataMutex );
 
-    {
-        auto pos = std::lower_bound( m_proxyPageIds.begin(), m_proxyPageIds.end(), pageId);
-        if( pos == m_proxyPageIds.end() || *pos != pageId )
-            throw std::runtime_error( "Callback invoked for resource " + std::to_string( pageId )
-                                      + " not associated with a proxy." );
-    }
+    if( m_pageIdSlots.find( pageId ) == m_pageIdSlots.end() )
+        throw std::runtime_error( "Callback invoked for resource " + std::to_string( pageId )
+                                  + " not associated with a proxy." );
 
     // Deduplicate the requested resource page id.
     auto pos = std::lower_bound( m_requestedResources.begin(), m_requestedResources.end(), pageId );
@@ -240,15 +333,28 @@ bool ProxyInstances::callback( CUstream /*stream*/, uint_t pageId, void** /*page
     return false;
 }
 
-uint_t ProxyInstances::insertResource( const uint_t pageId )
+uint_t ProxyInstances::allocateSlot( const uint_t pageId )
 {
-    auto pos = std::lower_bound( m_proxyPageIds.begin(), m_proxyPageIds.end(), pageId);
-    if( pos != m_proxyPageIds.end() && *pos == pageId )
+    if( m_pageIdSlots.find( pageId ) != m_pageIdSlots.end() )
         throw std::runtime_error( "Duplicate Resource found for page " + std::to_string( pageId ) );
 
-    const uint_t index = static_cast<uint_t>( pos - m_proxyPageIds.begin() );
-    m_proxyPageIds.insert( pos, pageId );
-    return index;
+    // Reuse a free slot before growing the instance array, so that the instance count is unchanged.
+    uint_t slot;
+    if( !m_freeSlots.empty() )
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+        m_slotPageIds[slot] = pageId;
+    }
+    else
+    {
+        slot = static_cast<uint_t>( m_slotPageIds.size() );
+        m_slotPageIds.push_back( pageId );
+        m_proxyData.push_back( OptixAabb{} );
+    }
+    m_pageIdSlots[pageId] = slot;
+    m_dirtySlots.push_back( slot );
+    return slot;
 }
 
 uint_t ProxyInstances::allocateResource()
@@ -257,15 +363,14 @@ uint_t ProxyInstances::allocateResource()
     {
         const uint_t pageId = m_freePages.back();
         m_freePages.pop_back();
-        return insertResource( pageId );
+        return pageId;
     }
 
     for( PageIdRange& range : m_pageRanges )
     {
         if( range.m_used < range.m_size )
         {
-            const uint_t pageId = range.m_start + range.m_used++;
-            return insertResource( pageId );
+            return range.m_start + range.m_used++;
         }
     }
 
@@ -274,7 +379,7 @@ uint_t ProxyInstances::allocateResource()
     range.m_start = m_loader->createResource( range.m_size, s_callback, this );
     range.m_used  = 1;
     m_pageRanges.push_back( range );
-    return insertResource( range.m_start );
+    return range.m_start;
 }
 
 void ProxyInstances::deallocateResource( uint_t pageId )
@@ -84,6 +84,10 @@ static auto isBuildingNumInstances = []( uint_t buildInput, uint_t numInstances
 
 static auto immutable = AllOf( NotNull(), isBuildOperation(), Not( buildAllowsUpdate() ) );
 
+static auto updatable = AllOf( NotNull(), isBuildOperation(), buildAllowsUpdate() );
+
+static auto refit = AllOf( NotNull(), isUpdateOperation(), buildAllowsUpdate() );
+
 static auto setHandle = []( OptixTraversableHandle handle ) {
     return DoAll( SetArgPointee<9>( handle ), Return( OPTIX_SUCCESS ) );
 };
@@ -113,19 +117,50 @@ class TestProxyInstance : public Test
             .WillOnce( setHandle( traversable ) );
     }
 
+    template <typename Matcher>
+    Expectation configureInstanceAccelComputeMemoryUsage( Matcher& matcher )
+    {
+        const uint_t numBuildInputs = 1;
+        return EXPECT_CALL( m_optix, accelComputeMemoryUsage( m_fakeDc, updatable, matcher, numBuildInputs, NotNull() ) )
+            .WillOnce( Return( OPTIX_SUCCESS ) );
+    }
+
+    template <typename Matcher>
+    Expectation configureInstanceAccelBuild( Matcher& matcher, OptixTraversableHandle traversable )
+    {
+        const uint_t numBuildInputs = 1;
+        return EXPECT_CALL( m_optix,
+                            accelBuild( m_fakeDc, m_stream, updatable, matcher, numBuildInputs, _, _, _, _, NotNull(), _, _ ) )
+            .WillOnce( setHandle( traversable ) );
+    }
+
     template <typename Matcher>
     void configureUpdatedBuild( const ExpectationSet& first, Matcher& isUpdatedIAS, OptixTraversableHandle updatedIAS )
     {
         const uint_t numUpdatedBuildInputs{ 1 };
-        EXPECT_CALL( m_optix, accelComputeMemoryUsage( m_fakeDc, immutable, isUpdatedIAS, numUpdatedBuildInputs, NotNull() ) )
+        EXPECT_CALL( m_optix, accelComputeMemoryUsage( m_fakeDc, updatable, isUpdatedIAS, numUpdatedBuildInputs, NotNull() ) )
             .After( first )
             .WillOnce( Return( OPTIX_SUCCESS ) );
-        EXPECT_CALL( m_optix, accelBuild( m_fakeDc, m_stream, immutable, isUpdatedIAS, numUpdatedBuildInputs, _, _, _,
+        EXPECT_CALL( m_optix, accelBuild( m_fakeDc, m_stream, updatable, isUpdatedIAS, numUpdatedBuildInputs, _, _, _,
                                           _, NotNull(), _, _ ) )
             .After( first )
             .WillOnce( setHandle( updatedIAS ) );
     }
 
+    template <typename Matcher>
+    void configureRefit( const ExpectationSet& first, Matcher& isRefitIAS, OptixTraversableHandle refitIAS )
+    {
+        const uint_t numRefitBuildInputs{ 1 };
+        EXPECT_CALL( m_optix, accelComputeMemoryUsage( _, _, _, _, _ ) ).Times( 0 ).After( first );
+        EXPECT_CALL( m_optix, accelBuild( m_fakeDc, m_stream, refit, isRefitIAS, numRefitBuildInputs, _, _, _, _,
+                                          NotNull(), _, _ ) )
+            .After( first )
+            .WillOnce( setHandle( refitIAS ) );
+    }
+
+    // Add proxies and build the initial traversables.
+    ExpectationSet createInitialTraversable( uint_t numProxies, std::vector<uint_t>& pageIds );
+
     MockDemandLoader m_loader;
     ProxyInstances   m_instances{ &m_loader };
     MockOptix        m_optix;
@@ -155,6 +190,26 @@ void TestProxyInstance::SetUp()
     initMockOptix( m_optix );
 }
 
+ExpectationSet TestProxyInstance::createInitialTraversable( uint_t numProxies, std::vector<uint_t>& pageIds )
+{
+    EXPECT_CALL( m_loader, createResource( _, _, _ ) ).WillOnce( Return( m_startPageId ) );
+    for( uint_t i = 0; i < numProxies; ++i )
+    {
+        const float     minCoord = static_cast<float>( i );
+        const OptixAabb bounds{ minCoord, minCoord, minCoord, minCoord + 1.0f, minCoord + 1.0f, minCoord + 1.0f };
+        pageIds.push_back( m_instances.add( bounds ) );
+    }
+    auto           isGAS = AllOf( NotNull(), hasCustomPrimitiveBuildInput( 0, hasNumCustomPrimitives( 1U ) ) );
+    auto           isIAS = isBuildingNumInstances( 0, numProxies );
+    ExpectationSet first;
+    first += configureAccelComputeMemoryUsage( isGAS );
+    first += configureInstanceAccelComputeMemoryUsage( isIAS );
+    first += configureAccelBuild( isGAS, m_fakeGAS );
+    first += configureInstanceAccelBuild( isIAS, m_fakeIAS );
+    EXPECT_EQ( m_fakeIAS, m_instances.createTraversable( m_fakeDc, m_stream ) );
+    return first;
+}
+
 }  // namespace
 
 TEST_F( TestProxyInstance, addProxyAllocatesResource )
@@ -193,11 +248,11 @@ TEST_F( TestProxyInstance, createAccelsUsesExpectedTransform )
     OptixAccelBufferSizes gasSizes{ 1000, 1100, 0 };
     EXPECT_CALL( m_optix, accelComputeMemoryUsage( m_fakeDc, immutable, isGAS, numBuildInputs, NotNull() ) ).WillOnce( setSize( gasSizes ) );
     OptixAccelBufferSizes iasSizes{ 2000, 2200, 0 };
-    EXPECT_CALL( m_optix, accelComputeMemoryUsage( m_fakeDc, immutable, isIAS, numBuildInputs, NotNull() ) ).WillOnce( setSize( iasSizes ) );
+    EXPECT_CALL( m_optix, accelComputeMemoryUsage( m_fakeDc, updatable, isIAS, numBuildInputs, NotNull() ) ).WillOnce( setSize( iasSizes ) );
     EXPECT_CALL( m_optix, accelBuild( m_fakeDc, m_stream, immutable, isGAS, numBuildInputs, Ne( 0 ), gasSizes.tempSizeInBytes,
                                       Ne( 0 ), gasSizes.outputSizeInBytes, NotNull(), nullptr, 0 ) )
         .WillOnce( setHandle( m_fakeGAS ) );
-    EXPECT_CALL( m_optix, accelBuild( m_fakeDc, m_stream, immutable, isIAS, numBuildInputs, Ne( 0 ), iasSizes.tempSizeInBytes,
+    EXPECT_CALL( m_optix, accelBuild( m_fakeDc, m_stream, updatable, isIAS, numBuildInputs, Ne( 0 ), iasSizes.tempSizeInBytes,
                                       Ne( 0 ), iasSizes.outputSizeInBytes, NotNull(), nullptr, 0 ) )
         .WillOnce( setHandle( m_fakeIAS ) );
 
@@ -230,9 +285,9 @@ TEST_F( TestProxyInstance, multipleProxiesInstantiatesGASOncePerProxy )
                                          hasDeviceInstances( hasInstance( 0U, hasInstanceTransform( expectedTransform1 ) ),
                                                              hasInstance( 1U, hasInstanceTransform( expectedTransform2 ) ) ) ) ) );
     configureAccelComputeMemoryUsage( isGAS );
-    configureAccelComputeMemoryUsage( isIAS );
+    configureInstanceAccelComputeMemoryUsage( isIAS );
     configureAccelBuild( isGAS, m_fakeGAS );
-    configureAccelBuild( isIAS, m_fakeIAS );
+    configureInstanceAccelBuild( isIAS, m_fakeIAS );
 
     OptixTraversableHandle result = m_instances.createTraversable( m_fakeDc, m_stream );
 
@@ -249,9 +304,9 @@ TEST_F( TestProxyInstance, proxyInstantiatesCustomPrimitive )
                hasInstanceBuildInput( 0, hasAll( hasNumInstances( 1U ),
                                                  hasDeviceInstances( hasInstance( 0U, hasInstanceTraversable( m_fakeGAS ) ) ) ) ) );
     configureAccelComputeMemoryUsage( isGAS );
-    configureAccelComputeMemoryUsage( isIAS );
+    configureInstanceAccelComputeMemoryUsage( isIAS );
     configureAccelBuild( isGAS, m_fakeGAS );
-    configureAccelBuild( isIAS, m_fakeIAS );
+    configureInstanceAccelBuild( isIAS, m_fakeIAS );
 
     m_instances.createTraversable( m_fakeDc, m_stream );
 }
@@ -304,9 +359,9 @@ TEST_F( TestProxyInstance, removingAProxyRemovesTheCustomPrimitiveInstance )
                                                                                   hasInstanceTransform( m_proxy1Transform ) ) ) ) ) );
     ExpectationSet first;
     first += configureAccelComputeMemoryUsage( isGAS );
-    first += configureAccelComputeMemoryUsage( isIAS );
+    first += configureInstanceAccelComputeMemoryUsage( isIAS );
     first += configureAccelBuild( isGAS, m_fakeGAS );
-    first += configureAccelBuild( isIAS, m_fakeIAS );
+    first += configureInstanceAccelBuild( isIAS, m_fakeIAS );
     OptixTraversableHandle updatedIAS{ 7777 };
     auto                   isUpdatedIAS = isBuildingNumInstances( 0, 0U );
     configureUpdatedBuild( first, isUpdatedIAS, updatedIAS );
@@ -342,9 +397,9 @@ TEST_F( TestProxyInstance, removingMultipleProxiesKeepsOtherProxies )
                                            hasInstance( 2U, hasInstanceId( id3 ), hasInstanceTransform( expectedTransform3 ) ) ) ) ) );
     ExpectationSet first;
     first += configureAccelComputeMemoryUsage( isGAS );
-    first += configureAccelComputeMemoryUsage( isIAS );
+    first += configureInstanceAccelComputeMemoryUsage( isIAS );
     first += configureAccelBuild( isGAS, m_fakeGAS );
-    first += configureAccelBuild( isIAS, m_fakeIAS );
+    first += configureInstanceAccelBuild( isIAS, m_fakeIAS );
     OptixTraversableHandle updatedIAS{ 7777 };
     auto                   isUpdatedIAS =
         AllOf( NotNull(),
@@ -398,7 +453,8 @@ TEST_F( TestProxyInstance, removeOutOfOrderPageIdProxies )
         batch1ProxyIds.push_back( m_instances.add( bounds ) );
         EXPECT_GE( batch1ProxyIds.back(), batch1StartId );
     }
-    const uint_t lowerInstanceIndex = 0U;
+    // Instance slots are assigned in the order proxies are added, not in page id order.
+    const uint_t lowerInstanceIndex = ProxyInstances::PAGE_CHUNK_SIZE;
     const uint_t lowerPageId        = m_instances.add( m_proxy1Bounds );
     EXPECT_LT( lowerPageId, batch1StartId );
     auto         isGAS = AllOf( NotNull(), hasCustomPrimitiveBuildInput( 0, hasNumCustomPrimitives( 1U ) ) );
@@ -410,14 +466,14 @@ TEST_F( TestProxyInstance, removeOutOfOrderPageIdProxies )
                                                                           hasInstanceTransform( m_proxy1Transform ) ) ) ) ) );
     ExpectationSet first;
     first += configureAccelComputeMemoryUsage( isGAS );
-    first += configureAccelComputeMemoryUsage( isIAS );
+    first += configureInstanceAccelComputeMemoryUsage( isIAS );
     first += configureAccelBuild( isGAS, m_fakeGAS );
-    first += configureAccelBuild( isIAS, m_fakeIAS );
+    first += configureInstanceAccelBuild( isIAS, m_fakeIAS );
     OptixTraversableHandle updatedIAS{ 7777 };
     auto                   isUpdatedIAS =
-        AllOf( NotNull(), hasInstanceBuildInput( 0, hasAll( hasNumInstances( numInitialInstances - 1U ),
+        AllOf( NotNull(), hasInstanceBuildInput( 0, hasAll( hasNumInstances( numInitialInstances ),
                                                             hasDeviceInstances( hasNoInstanceWithId( lowerPageId ) ) ) ) );
-    configureUpdatedBuild( first, isUpdatedIAS, updatedIAS );
+    configureRefit( first, isUpdatedIAS, updatedIAS );
     OptixTraversableHandle initialHandle = m_instances.createTraversable( m_fakeDc, m_stream );
     EXPECT_CALL( m_loader, invalidatePage( _ ) ).Times( 0 );
 
@@ -480,3 +536,97 @@ TEST_F( TestProxyInstance, removingTwiceThrowsException )
 
     EXPECT_THROW( m_instances.remove( id1 ), std::runtime_error );
 }
+
+TEST_F( TestProxyInstance, removedProxyLeavesTombstoneInstance )
+{
+    std::vector<uint_t>  pageIds;
+    const ExpectationSet first = createInitialTraversable( 4, pageIds );
+    const uint_t         removedIndex{ 1 };
+    OptixTraversableHandle refitIAS{ 7777 };
+    auto                   isRefitIAS =
+        AllOf( NotNull(),
+               hasInstanceBuildInput( 0, hasAll( hasNumInstances( 4 ),
+                                                 hasDeviceInstances( hasNoInstanceWithId( pageIds[removedIndex] ),
+                                                                     hasInstance( removedIndex, hasInstanceVisibilityMask( 0U ) ),
+                                                                     hasInstance( 2U, hasInstanceId( pageIds[2] ) ) ) ) ) );
+    configureRefit( first, isRefitIAS, refitIAS );
+
+    m_instances.remove( pageIds[removedIndex] );
+    const OptixTraversableHandle handle = m_instances.createTraversable( m_fakeDc, m_stream );
+
+    EXPECT_EQ( refitIAS, handle );
+    EXPECT_EQ( 4U, m_instances.getNumInstanceSlots() );
+    EXPECT_EQ( 1U, m_instances.getNumFreeInstanceSlots() );
+}
+
+TEST_F( TestProxyInstance, addedProxyReusesFreeSlot )
+{
+    std::vector<uint_t>  pageIds;
+    const ExpectationSet first = createInitialTraversable( 4, pageIds );
+    const uint_t         removedIndex{ 1 };
+    OptixTraversableHandle refitIAS{ 7777 };
+    m_instances.remove( pageIds[removedIndex] );
+    const uint_t pageId     = m_instances.add( m_proxy1Bounds );
+    auto         isRefitIAS = AllOf(
+        NotNull(), hasInstanceBuildInput( 0, hasAll( hasNumInstances( 4 ),
+                                                     hasDeviceInstances( hasInstance( removedIndex, hasInstanceId( pageId ),
+                                                                                      hasInstanceVisibilityMask( 255U ),
+                                                                                      hasInstanceTransform( m_proxy1Transform ) ) ) ) ) );
+    configureRefit( first, isRefitIAS, refitIAS );
+
+    const OptixTraversableHandle handle = m_instances.createTraversable( m_fakeDc, m_stream );
+
+    EXPECT_EQ( refitIAS, handle );
+    EXPECT_EQ( 4U, m_instances.getNumInstanceSlots() );
+    EXPECT_EQ( 0U, m_instances.getNumFreeInstanceSlots() );
+}
+
+TEST_F( TestProxyInstance, appendingProxyRebuildsInstanceAS )
+{
+    std::vector<uint_t>    pageIds;
+    const ExpectationSet   first = createInitialTraversable( 2, pageIds );
+    OptixTraversableHandle updatedIAS{ 7777 };
+    const uint_t           pageId = m_instances.add( m_proxy1Bounds );
+    auto                   isUpdatedIAS =
+        AllOf( NotNull(), hasInstanceBuildInput( 0, hasAll( hasNumInstances( 3 ),
+                                                            hasDeviceInstances( hasInstance( 0U, hasInstanceId( pageIds[0] ) ),
+                                                                                hasInstance( 2U, hasInstanceId( pageId ) ) ) ) ) );
+    configureUpdatedBuild( first, isUpdatedIAS, updatedIAS );
+
+    const OptixTraversableHandle handle = m_instances.createTraversable( m_fakeDc, m_stream );
+
+    EXPECT_EQ( updatedIAS, handle );
+}
+
+TEST_F( TestProxyInstance, fragmentationPastThresholdCompactsInstances )
+{
+    std::vector<uint_t>  pageIds;
+    const ExpectationSet first = createInitialTraversable( 4, pageIds );
+    m_instances.setMaxFragmentation( 0.25f );
+    OptixTraversableHandle updatedIAS{ 7777 };
+    auto                   isUpdatedIAS =
+        AllOf( NotNull(), hasInstanceBuildInput( 0, hasAll( hasNumInstances( 2 ),
+                                                            hasDeviceInstances( hasInstance( 0U, hasInstanceId( pageIds[1] ) ),
+                                                                                hasInstance( 1U, hasInstanceId( pageIds[3] ) ) ) ) ) );
+    configureUpdatedBuild( first, isUpdatedIAS, updatedIAS );
+
+    m_instances.remove( pageIds[0] );
+    m_instances.remove( pageIds[2] );
+    const OptixTraversableHandle handle = m_instances.createTraversable( m_fakeDc, m_stream );
+
+    EXPECT_EQ( updatedIAS, handle );
+    EXPECT_EQ( 2U, m_instances.getNumInstanceSlots() );
+    EXPECT_EQ( 0U, m_instances.getNumFreeInstanceSlots() );
+}
+
+TEST_F( TestProxyInstance, unchangedProxiesReuseInstanceAS )
+{
+    std::vector<uint_t>  pageIds;
+    const ExpectationSet first = createInitialTraversable( 2, pageIds );
+    EXPECT_CALL( m_optix, accelComputeMemoryUsage( _, _, _, _, _ ) ).Times( 0 ).After( first );
+    EXPECT_CALL( m_optix, accelBuild( _, _, _, _, _, _, _, _, _, _, _, _ ) ).Times( 0 ).After( first );
+
+    const OptixTraversableHandle handle = m_instances.createTraversable( m_fakeDc, m_stream );
+
+    EXPECT_EQ( m_fakeIAS, handle );
+}
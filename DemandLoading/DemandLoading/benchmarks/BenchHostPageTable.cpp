@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+// Compare the host page table used by PagingSystem against the std::map it replaced, using the
+// access patterns of PagingSystem: fills (isResident + addMappingBody), evictions (stageStalePages
+// + freeStagedPage) and range invalidation (invalidatePages).
+
+#include "HostPageTable.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+using namespace demandLoading;
+
+namespace {
+
+using Entry = HostPageTable::Entry;
+
+const unsigned int NUM_PAGES = 64 * 1024 * 1024;  // Options::numPages default
+
+// The previous PagingSystem page table, wrapped in the HostPageTable interface.
+class MapPageTable
+{
+  public:
+    explicit MapPageTable( unsigned int /*numPages*/ ) {}
+
+    Entry* find( unsigned int pageId )
+    {
+        auto it = m_map.find( pageId );
+        return it != m_map.end() ? &it->second : nullptr;
+    }
+
+    Entry& insert( unsigned int pageId, const Entry& value ) { return m_map[pageId] = value; }
+
+    void erase( unsigned int pageId ) { m_map.erase( pageId ); }
+
+    Entry* next( unsigned int& pageId, unsigned int endId )
+    {
+        auto it = m_map.lower_bound( pageId );
+        if( it == m_map.end() || it->first >= endId )
+            return nullptr;
+        pageId = it->first;
+        return &it->second;
+    }
+
+  private:
+    std::map<unsigned int, Entry> m_map;
+};
+
+// Resident pages are clustered in runs, like the tiles of demand-loaded textures.
+std::vector<unsigned int> makePageIds( size_t numPages )
+{
+    std::mt19937                                rng( 42 );
+    std::uniform_int_distribution<unsigned int> start( 0, NUM_PAGES - 1024 );
+    std::vector<unsigned int>                   pageIds;
+    pageIds.reserve( numPages );
+    while( pageIds.size() < numPages )
+    {
+        const unsigned int first = start( rng );
+        for( unsigned int i = 0; i < 256 && pageIds.size() < numPages; ++i )
+            pageIds.push_back( first + i );
+    }
+    std::sort( pageIds.begin(), pageIds.end() );
+    pageIds.erase( std::unique( pageIds.begin(), pageIds.end() ), pageIds.end() );
+    std::shuffle( pageIds.begin(), pageIds.end(), rng );
+    return pageIds;
+}
+
+template <class Table>
+void fillPages( Table& table, const std::vector<unsigned int>& pageIds )
+{
+    for( unsigned int pageId : pageIds )
+    {
+        Entry* e = table.find( pageId );
+        if( e == nullptr || !e->resident )
+            table.insert( pageId, Entry{pageId, true, true, false, false} );
+    }
+}
+
+template <class Table>
+void BM_PageTableFill( benchmark::State& state )
+{
+    const std::vector<unsigned int> pageIds = makePageIds( state.range( 0 ) );
+    for( auto _ : state )
+    {
+        Table table( NUM_PAGES );
+        fillPages( table, pageIds );
+        benchmark::DoNotOptimize( table.find( pageIds[0] ) );
+    }
+    state.SetItemsProcessed( state.iterations() * pageIds.size() );
+}
+
+template <class Table>
+void BM_PageTableEvict( benchmark::State& state )
+{
+    const std::vector<unsigned int> pageIds = makePageIds( state.range( 0 ) );
+    Table                           table( NUM_PAGES );
+    for( auto _ : state )
+    {
+        state.PauseTiming();
+        fillPages( table, pageIds );
+        state.ResumeTiming();
+
+        // Stage the pages, then free them.
+        for( unsigned int pageId : pageIds )
+        {
+            Entry* e = table.find( pageId );
+            if( e != nullptr && e->resident && !e->inStagedList )
+            {
+                e->resident     = false;
+                e->staged       = true;
+                e->inStagedList = true;
+            }
+        }
+        for( unsigned int pageId : pageIds )
+        {
+            Entry* e = table.find( pageId );
+            if( e != nullptr && e->staged )
+                table.erase( pageId );
+        }
+    }
+    state.SetItemsProcessed( state.iterations() * pageIds.size() );
+}
+
+template <class Table>
+void BM_PageTableInvalidateRange( benchmark::State& state )
+{
+    const std::vector<unsigned int> pageIds = makePageIds( state.range( 0 ) );
+    Table                           table( NUM_PAGES );
+    size_t                          numInvalidated = 0;
+    for( auto _ : state )
+    {
+        state.PauseTiming();
+        fillPages( table, pageIds );
+        state.ResumeTiming();
+
+        // Invalidate every other page in the lower half of the page table.
+        const unsigned int endId  = NUM_PAGES / 2;
+        unsigned int       pageId = 0;
+        for( Entry* e = table.next( pageId, endId ); e != nullptr; e = table.next( ++pageId, endId ) )
+        {
+            if( ( e->entry & 1 ) == 0 )
+            {
+                table.erase( pageId );
+                ++numInvalidated;
+            }
+        }
+    }
+    state.SetItemsProcessed( numInvalidated );
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE( BM_PageTableFill, MapPageTable )->RangeMultiplier( 16 )->Range( 4096, 1 << 20 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_PageTableFill, HostPageTable )->RangeMultiplier( 16 )->Range( 4096, 1 << 20 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_PageTableEvict, MapPageTable )->RangeMultiplier( 16 )->Range( 4096, 1 << 20 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_PageTableEvict, HostPageTable )->RangeMultiplier( 16 )->Range( 4096, 1 << 20 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_PageTableInvalidateRange, MapPageTable )->RangeMultiplier( 16 )->Range( 4096, 1 << 20 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_PageTableInvalidateRange, HostPageTable )->RangeMultiplier( 16 )->Range( 4096, 1 << 20 )->Unit( benchmark::kMillisecond );
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+// Benchmark the host-side request path of the RequestProcessor: finding the RequestHandler for each
+// requested page (PageTableManager::getRequestHandler), and moving batches of requests through the
+// RequestQueue to the worker threads.
+
+#include "PageTableManager.h"
+#include "RequestHandler.h"
+#include "RequestQueue.h"
+#include "TicketImpl.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace demandLoading;
+
+namespace {
+
+class NullRequestHandler : public RequestHandler
+{
+};
+
+// Random page ids within the first numPages pages.
+std::vector<unsigned int> makeRequests( unsigned int numRequests, unsigned int numPages )
+{
+    std::mt19937                                rng( 42 );
+    std::uniform_int_distribution<unsigned int> page( 0, numPages - 1 );
+    std::vector<unsigned int>                   pageIds( numRequests );
+    for( unsigned int& pageId : pageIds )
+        pageId = page( rng );
+    return pageIds;
+}
+
+// Look up the handlers of a batch of requests in a page table with the given number of resources,
+// each of which spans 64 pages (like a small texture).
+void BM_GetRequestHandler( benchmark::State& state )
+{
+    const unsigned int pagesPerResource = 64;
+    const unsigned int numResources     = static_cast<unsigned int>( state.range( 0 ) );
+    const unsigned int numPages         = numResources * pagesPerResource;
+
+    PageTableManager                                 pageTableManager( numPages, numPages );
+    std::vector<std::unique_ptr<NullRequestHandler>> handlers;
+    for( unsigned int i = 0; i < numResources; ++i )
+    {
+        handlers.emplace_back( new NullRequestHandler );
+        pageTableManager.reserveBackedPages( pagesPerResource, handlers.back().get() );
+    }
+
+    const std::vector<unsigned int> pageIds = makeRequests( 4096, numPages );
+    for( auto _ : state )
+    {
+        for( unsigned int pageId : pageIds )
+            benchmark::DoNotOptimize( pageTableManager.getRequestHandler( pageId ) );
+    }
+    state.SetItemsProcessed( state.iterations() * pageIds.size() );
+}
+
+// Push batches of requests and pop them on the same thread, which measures the queue overhead
+// without contention.
+void BM_RequestQueuePushPop( benchmark::State& state )
+{
+    const unsigned int              batchSize = static_cast<unsigned int>( state.range( 0 ) );
+    const std::vector<unsigned int> pageIds   = makeRequests( batchSize, 1u << 20 );
+    RequestQueue                    queue( batchSize );
+    RequestChunk                    chunk;
+    for( auto _ : state )
+    {
+        queue.push( pageIds.data(), batchSize, TicketImpl::create( CUstream{} ) );
+        while( queue.size() > 0 && queue.popOrWait( 0, &chunk ) )
+            benchmark::DoNotOptimize( chunk.pageIds() );
+    }
+    state.SetItemsProcessed( state.iterations() * batchSize );
+}
+
+// Push batches of prioritized requests, which are split into chunks at priority boundaries.
+void BM_RequestQueuePushPopPrioritized( benchmark::State& state )
+{
+    const unsigned int        batchSize = static_cast<unsigned int>( state.range( 0 ) );
+    std::vector<unsigned int> pageIds   = makeRequests( batchSize, 1u << 20 );
+    std::vector<unsigned int> priorities( batchSize );
+    for( unsigned int i = 0; i < batchSize; ++i )
+        priorities[i] = i * 16 / batchSize;
+
+    RequestQueue queue( batchSize );
+    RequestChunk chunk;
+    for( auto _ : state )
+    {
+        queue.push( pageIds.data(), batchSize, TicketImpl::create( CUstream{} ), priorities.data() );
+        while( queue.size() > 0 && queue.popOrWait( 0, &chunk ) )
+            benchmark::DoNotOptimize( chunk.pageIds() );
+    }
+    state.SetItemsProcessed( state.iterations() * batchSize );
+}
+
+// Push batches of requests from the benchmark thread while the given number of workers pop them.
+void BM_RequestQueueWorkers( benchmark::State& state )
+{
+    const unsigned int              numWorkers = static_cast<unsigned int>( state.range( 0 ) );
+    const unsigned int              batchSize  = 1024;
+    const std::vector<unsigned int> pageIds    = makeRequests( batchSize, 1u << 20 );
+
+    for( auto _ : state )
+    {
+        RequestQueue             queue( batchSize * 64, numWorkers );
+        std::vector<std::thread> workers;
+        for( unsigned int i = 0; i < numWorkers; ++i )
+        {
+            workers.emplace_back( [&queue, i] {
+                RequestChunk chunk;
+                while( queue.popOrWait( i, &chunk ) )
+                    TicketImpl::getImpl( chunk.batch->ticket )->notify( chunk.size() );
+            } );
+        }
+
+        std::vector<Ticket> tickets;
+        for( unsigned int batch = 0; batch < 64; ++batch )
+        {
+            tickets.push_back( TicketImpl::create( CUstream{} ) );
+            queue.push( pageIds.data(), batchSize, tickets.back() );
+        }
+        for( Ticket& ticket : tickets )
+            ticket.wait();
+
+        queue.shutDown();
+        for( std::thread& worker : workers )
+            worker.join();
+    }
+    state.SetItemsProcessed( state.iterations() * 64 * batchSize );
+}
+
+}  // namespace
+
+BENCHMARK( BM_GetRequestHandler )->RangeMultiplier( 16 )->Range( 16, 1 << 16 );
+BENCHMARK( BM_RequestQueuePushPop )->RangeMultiplier( 8 )->Range( 16, 1 << 13 );
+BENCHMARK( BM_RequestQueuePushPopPrioritized )->RangeMultiplier( 8 )->Range( 16, 1 << 13 );
+BENCHMARK( BM_RequestQueueWorkers )->RangeMultiplier( 2 )->Range( 1, 16 )->Unit( benchmark::kMillisecond )->UseRealTime();
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+// Benchmark getUniformTileColor, which TextureRequestHandler runs on every tile it fills when
+// coalescing uniform tiles.  Uniform tiles are scanned completely, in a single pass; the worst case
+// is a tile that differs only in its last texel.
+
+#include <cuda.h>
+
+#include "UniformTileCheck.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <vector>
+
+using namespace demandLoading;
+using namespace imageSource;
+using namespace otk;
+
+namespace {
+
+enum TileContents
+{
+    UNIFORM_BLACK,
+    ALMOST_UNIFORM,
+    RANDOM
+};
+
+std::vector<char> makeTile( TileContents contents )
+{
+    std::vector<char> tile( TILE_SIZE_IN_BYTES, 0 );
+    if( contents == ALMOST_UNIFORM )
+    {
+        tile.back() = 1;
+    }
+    else if( contents == RANDOM )
+    {
+        std::mt19937 rng( 42 );
+        for( char& c : tile )
+            c = static_cast<char>( rng() );
+    }
+    return tile;
+}
+
+void BM_ClassifyTile( benchmark::State& state, CUarray_format format, int numChannels )
+{
+    std::vector<char> tile = makeTile( static_cast<TileContents>( state.range( 0 ) ) );
+    UniformTileColor  color;
+    for( auto _ : state )
+        benchmark::DoNotOptimize( getUniformTileColor( tile.data(), format, numChannels, color ) );
+    state.SetBytesProcessed( state.iterations() * tile.size() );
+}
+
+}  // namespace
+
+BENCHMARK_CAPTURE( BM_ClassifyTile, float4, CU_AD_FORMAT_FLOAT, 4 )->DenseRange( UNIFORM_BLACK, RANDOM );
+BENCHMARK_CAPTURE( BM_ClassifyTile, half4, CU_AD_FORMAT_HALF, 4 )->DenseRange( UNIFORM_BLACK, RANDOM );
+BENCHMARK_CAPTURE( BM_ClassifyTile, uchar4, CU_AD_FORMAT_UNSIGNED_INT8, 4 )->DenseRange( UNIFORM_BLACK, RANDOM );
+BENCHMARK_CAPTURE( BM_ClassifyTile, uchar, CU_AD_FORMAT_UNSIGNED_INT8, 1 )->DenseRange( UNIFORM_BLACK, RANDOM );
@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+/// \file CacheSimulator.h
+/// Host-only simulation of texture tile residency, for tuning the eviction options without a GPU.
+
+#include <OptiXToolkit/DemandLoading/Options.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace demandLoading {
+
+/// Eviction policies known to the cache simulator.
+enum class EvictionPolicy
+{
+    LRU_THRESHOLD,  ///< The LRU table and threshold heuristic used by the PagingSystem (useLruTable = true).
+    RANDOM,         ///< The randomized eviction used by the PagingSystem without an LRU table.
+    CLOCK,          ///< CLOCK (second chance) replacement.
+    ARC,            ///< Adaptive replacement cache (Megiddo and Modha).
+    TWO_Q           ///< Full 2Q replacement (Johnson and Shasha).
+};
+
+/// Get the name of an eviction policy, e.g. "lru-threshold".
+const char* getEvictionPolicyName( EvictionPolicy policy );
+
+/// Find an eviction policy by name.  Returns false if the name is unknown.
+bool findEvictionPolicy( const char* name, EvictionPolicy& policy );
+
+/// The eviction policy that the PagingSystem uses for the given options.
+inline EvictionPolicy getDefaultEvictionPolicy( const Options& options )
+{
+    return options.useLruTable ? EvictionPolicy::LRU_THRESHOLD : EvictionPolicy::RANDOM;
+}
+
+/// A CachePolicy chooses the resident pages that the cache simulator stages for eviction.  The
+/// simulator tells the policy when pages become resident, are referenced, or leave the cache.
+class CachePolicy
+{
+  public:
+    virtual ~CachePolicy() {}
+
+    /// The page became resident, after a miss or after being restored from the staged pages.
+    virtual void insert( unsigned int pageId ) = 0;
+
+    /// The resident page was referenced.
+    virtual void access( unsigned int pageId ) = 0;
+
+    /// The page is no longer resident, because it was staged or invalidated.
+    virtual void remove( unsigned int pageId ) = 0;
+
+    /// The frame is over.  The referenced pages are those requested during the frame.
+    virtual void endFrame( const std::unordered_set<unsigned int>& /*referencedPages*/ ) {}
+
+    /// Choose up to maxPages resident pages to stage, best candidate first.  Pages referenced
+    /// during the frame must not be chosen.  The chosen pages are removed by the simulator.
+    virtual void getStalePages( unsigned int maxPages, const std::unordered_set<unsigned int>& referencedPages, std::vector<unsigned int>& stalePages ) = 0;
+};
+
+/// Create one of the built-in cache policies, sized for the given options.
+std::unique_ptr<CachePolicy> createCachePolicy( EvictionPolicy policy, const Options& options );
+
+/// Cache simulator statistics, for a frame or for the whole simulation.  A page that is requested
+/// while it is staged is restored without being read again, as in the PagingSystem.
+struct CacheSimulatorStats
+{
+    uint64_t     timestamp      = 0;  ///< Trace time of the frame, in nanoseconds.
+    unsigned int numFrames      = 0;
+    unsigned int numRequests    = 0;  ///< Tile requests, not counting duplicates within a frame.
+    unsigned int numHits        = 0;  ///< Requests for resident tiles.
+    unsigned int numRestores    = 0;  ///< Requests for staged tiles.
+    unsigned int numLoads       = 0;  ///< Tiles read from their images.
+    unsigned int numReloads     = 0;  ///< Loaded tiles that had been loaded before.
+    unsigned int numDropped     = 0;  ///< Requests that could not be filled because memory was full.
+    unsigned int numStaged      = 0;  ///< Tiles staged for eviction.
+    unsigned int numEvicted     = 0;  ///< Staged tiles whose memory was freed.
+    unsigned int numInvalidated = 0;  ///< Resident or staged tiles that were invalidated.
+    uint64_t     bytesRead      = 0;
+    uint64_t     bytesReread    = 0;  ///< Bytes read for tiles that had been loaded before.
+
+    unsigned int numResidentPages = 0;  ///< Resident tiles at the end of the frame (or simulation).
+    unsigned int numStagedPages   = 0;  ///< Staged tiles at the end of the frame (or simulation).
+
+    /// Fraction of the requests that were satisfied without reading an image.
+    double hitRate() const { return numRequests ? double( numHits + numRestores ) / numRequests : 1.0; }
+
+    /// Tiles loaded or evicted.
+    unsigned int churn() const { return numLoads + numEvicted; }
+
+    /// Accumulate the counts of a frame.  The timestamp and the resident and staged counts are replaced.
+    CacheSimulatorStats& operator+=( const CacheSimulatorStats& frame );
+};
+
+/// CacheSimulator replays page requests against a simulated texture tile pool, mimicking the
+/// residency, staging and eviction of the PagingSystem.  Each frame corresponds to one launch: its
+/// requested pages are treated as that launch's references.  Pages below numPageTableEntries
+/// (samplers and base colors) are ignored, and each other page occupies one tile.
+///
+/// Memory is limited to maxTexMemPerDevice bytes (0 is unlimited).  Once less than maxStagedPages
+/// tiles are free, eviction is active: at the end of every frame the policy chooses up to
+/// maxStalePages unreferenced pages to stage (keeping at most maxStagedPages staged), and staged
+/// tiles are freed, oldest first, to keep maxStagedPages tiles free.
+class CacheSimulator
+{
+  public:
+    /// Simulate one of the built-in eviction policies.
+    CacheSimulator( const Options& options, EvictionPolicy policy );
+
+    /// Simulate a custom eviction policy.
+    CacheSimulator( const Options& options, std::unique_ptr<CachePolicy> policy );
+
+    /// Simulate a frame that requests the given pages.  Returns the statistics of the frame.
+    CacheSimulatorStats simulateFrame( const unsigned int* pageIds, unsigned int numPageIds, uint64_t timestamp = 0 );
+
+    /// Invalidate the pages from startPage up to (but not including) endPage.
+    void invalidatePages( unsigned int startPage, unsigned int endPage );
+
+    /// Get the statistics of all the frames simulated so far.
+    const CacheSimulatorStats& getTotals() const { return m_totals; }
+
+    /// Get the maximum number of tiles that fit in memory (0 is unlimited).
+    size_t getMaxTiles() const { return m_maxTiles; }
+
+  private:
+    enum class PageState
+    {
+        RESIDENT,
+        STAGED
+    };
+
+    struct StagedPage
+    {
+        unsigned int pageId;
+        uint64_t     stageId;  // Identifies the staging, since a page can be restored and staged again.
+    };
+
+    struct PageEntry
+    {
+        PageState state;
+        uint64_t  stageId;
+    };
+
+    Options                      m_options;
+    std::unique_ptr<CachePolicy> m_policy;
+    size_t                       m_maxTiles;
+    bool                         m_evictionActive = false;
+
+    std::unordered_map<unsigned int, PageEntry> m_pages;        // Resident and staged pages.
+    std::deque<StagedPage>                      m_stagedPages;  // Staged pages, oldest first (some may be restored).
+    unsigned int                                m_numStagedPages = 0;
+    uint64_t                                    m_nextStageId    = 0;
+    std::unordered_set<unsigned int>            m_loadedPages;  // Pages that have ever been loaded.
+
+    std::unordered_set<unsigned int> m_referencedPages;
+    std::vector<unsigned int>        m_misses;
+    std::vector<unsigned int>        m_stalePages;
+    CacheSimulatorStats              m_totals;
+
+    size_t getNumFreeTiles() const;
+
+    // Free the oldest staged tile.  Returns false if no tiles are staged.
+    bool evictStagedPage( CacheSimulatorStats& stats );
+};
+
+/// Get the options recorded for a device in a trace file, or the default options if none were.
+Options getTraceFileOptions( const char* filename, unsigned int deviceIndex = 0 );
+
+/// Simulate the page requests that a device made in a trace file, treating each batch of requests
+/// as a frame.  Invalidations of whole page ranges are simulated.  Returns the statistics of each
+/// frame.  Note that the trace only holds requests for pages that were not resident when it was
+/// recorded, so the simulation can't see references to pages that stayed resident.
+std::vector<CacheSimulatorStats> simulateTraceFile( const char* filename, const Options& options, EvictionPolicy policy, unsigned int deviceIndex = 0 );
+
+}  // namespace demandLoading
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -30,12 +30,15 @@ struct Options
     bool useSparseTextures           = true;   ///< whether to use sparse or dense textures
     bool useSmallTextureOptimization = false;  ///< whether to use dense textures for very small textures
     bool useCascadingTextureSizes    = false;  ///< whether to use cascading texture sizes
-    bool coalesceWhiteBlackTiles     = false;  ///< whether to use the same backing store for all white/black tiles
+    bool coalesceWhiteBlackTiles     = false;  ///< whether to use the same backing store for all tiles of the same uniform color
     bool coalesceDuplicateImages     = false;  ///< whether to coalesce duplicate images
+    bool coalesceDuplicateTiles      = false;  ///< whether to use the same backing store for tiles with the same contents (by hash)
+    unsigned int maxUniformTiles     = 4096;   ///< max distinct uniform-color tiles to share when coalescing (0 is unlimited)
 
     // Memory limits
     size_t maxTexMemPerDevice = 0;  ///< texture to allocate per device (in MB) before starting eviction (0 is unlimited)
     size_t maxPinnedMemory = 64 * 1024 * 1024;  ///< max pinned memory to use for data transfer between host and device
+                                                ///< (half of it for tile-sized transfer buffers; device transfer memory is limited likewise)
 
     // Eviction
     unsigned int maxStalePages       = 8192;  ///< max stale (resident but not used) pages to pull from device in processRequests
@@ -51,6 +54,9 @@ struct Options
 
     // Trace file
     std::string traceFile;  ///< trace filename (disabled if empty).
+
+    // Image hash cache
+    std::string imageHashCacheFile;  ///< file caching image hashes for coalesceDuplicateImages across runs (disabled if empty).
 };
 // clang-format on
 
@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+namespace demandLoading {
+
+/// The kind of data requested by a page request.
+enum class RequestKind
+{
+    SAMPLER,   // Texture sampler, base color, or cascade page.
+    RESOURCE,  // Page of a resource with a user-provided callback.
+    MIP_TAIL,  // Mip tail of a sparse texture.
+    TILE       // Tile of a sparse texture.
+};
+
+/// Description of a page request, which a RequestPriorityPolicy uses to rank it.
+struct RequestInfo
+{
+    unsigned int pageId;
+    RequestKind  kind;
+    unsigned int mipLevel;  // Mip level of a TILE request (0 is the finest level), otherwise zero.
+};
+
+/// A RequestPriorityPolicy ranks the page requests in each batch before they are queued for the
+/// worker threads.  Requests with lower priority values are processed first.
+class RequestPriorityPolicy
+{
+  public:
+    virtual ~RequestPriorityPolicy() { }
+    virtual unsigned int priority( const RequestInfo& request ) = 0;
+};
+
+}  // namespace demandLoading
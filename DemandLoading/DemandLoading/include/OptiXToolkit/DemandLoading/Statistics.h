@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -22,6 +22,12 @@ struct Statistics
     size_t deviceMemoryUsed;
     size_t bytesTransferredToDevice;
     unsigned int numEvictions;
+    size_t numTilesCoalesced;  // tiles mapped to a shared uniform-color tile
+    size_t bytesCoalesced;     // device memory saved by sharing uniform-color tiles
+    size_t numTilesDeduplicated;  // tiles mapped to a shared tile with the same contents
+    size_t bytesDeduplicated;     // device memory saved by sharing tiles with the same contents
+    size_t tileTransferPinnedMemory;  // pinned memory held by tile-sized transfer buffers
+    size_t tileTransferDeviceMemory;  // device memory held by tile-sized transfer buffers
 };
 
 }  // namespace demandLoading
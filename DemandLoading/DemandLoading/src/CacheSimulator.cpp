@@ -0,0 +1,704 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <OptiXToolkit/DemandLoading/CacheSimulator.h>
+
+#include "Util/TraceFile.h"
+
+#include <OptiXToolkit/DemandLoading/LRU.h>
+#include <OptiXToolkit/Error/ErrorCheck.h>
+#include <OptiXToolkit/Memory/MemoryBlockDesc.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <map>
+#include <random>
+#include <set>
+
+using namespace otk;
+
+namespace demandLoading {
+
+namespace {
+
+const char* const POLICY_NAMES[] = {"lru-threshold", "random", "clock", "arc", "2q"};
+
+// The PagingSystem's eviction policy with an LRU table.  Each resident page has a 4-bit LRU value,
+// which is reset when the page is referenced and otherwise incremented logarithmically every
+// launch.  Pages whose value is at least the LRU threshold are stale, and the oldest of them are
+// staged first.  The threshold adapts to the number of stale pages found.
+class LruThresholdPolicy : public CachePolicy
+{
+  public:
+    LruThresholdPolicy( const Options& options )
+        : m_maxStalePages( options.maxStalePages )
+    {
+    }
+
+    void insert( unsigned int pageId ) override { m_lruVals[pageId] = 0; }
+    void access( unsigned int pageId ) override { m_lruVals[pageId] = 0; }
+    void remove( unsigned int pageId ) override { m_lruVals.erase( pageId ); }
+
+    void endFrame( const std::unordered_set<unsigned int>& referencedPages ) override
+    {
+        // Age the unreferenced pages, gathering stale pages in page order as devicePullRequests does.
+        ++m_launchNum;
+        unsigned int numStalePages = 0;
+        m_stalePages.clear();
+        for( std::pair<const unsigned int, unsigned int>& lruVal : m_lruVals )
+        {
+            if( referencedPages.count( lruVal.first ) != 0 )
+                continue;
+            lruVal.second = lruInc( lruVal.second, m_launchNum + lruVal.first );
+            if( lruVal.second >= m_lruThreshold )
+            {
+                ++numStalePages;
+                if( m_stalePages.size() < m_maxStalePages )
+                    m_stalePages.push_back( StalePage{lruVal.second, lruVal.first} );
+            }
+        }
+
+        // Sort the stale pages from oldest to newest, and update the threshold.
+        numStalePages = std::min( numStalePages, m_maxStalePages );
+        std::stable_sort( m_stalePages.begin(), m_stalePages.end(),
+                          []( const StalePage& a, const StalePage& b ) { return a.lruVal > b.lruVal; } );
+        const unsigned int medianLruVal = m_stalePages.empty() ? 0 : m_stalePages[( m_stalePages.size() - 1 ) / 2].lruVal;
+        updateLruThreshold( numStalePages, m_maxStalePages, medianLruVal );
+    }
+
+    void getStalePages( unsigned int maxPages, const std::unordered_set<unsigned int>& /*referencedPages*/, std::vector<unsigned int>& stalePages ) override
+    {
+        for( size_t i = 0; i < m_stalePages.size() && stalePages.size() < maxPages; ++i )
+            stalePages.push_back( m_stalePages[i].pageId );
+    }
+
+  private:
+    struct StalePage
+    {
+        unsigned int lruVal;
+        unsigned int pageId;
+    };
+
+    // As in PagingSystem.
+    const unsigned int MIN_LRU_THRESHOLD = 2;
+
+    unsigned int                       m_maxStalePages;
+    unsigned int                       m_lruThreshold = MIN_LRU_THRESHOLD;
+    unsigned int                       m_launchNum    = 0;
+    std::map<unsigned int, unsigned int> m_lruVals;
+    std::vector<StalePage>             m_stalePages;
+
+    // Host version of lruInc in Paging.h.
+    static unsigned int lruInc( unsigned int count, unsigned int launchNum )
+    {
+        unsigned int mask = ( 1u << count ) - 1;
+        return ( ( mask & launchNum ) == 0 && count < MAX_LRU_VAL ) ? count + 1u : count;
+    }
+
+    // Same heuristic as PagingSystem::updateLruThreshold.
+    void updateLruThreshold( unsigned int returnedStalePages, unsigned int requestedStalePages, unsigned int medianLruVal )
+    {
+        if( requestedStalePages == 0 )
+            return;
+        if( returnedStalePages < requestedStalePages / 2 )
+            m_lruThreshold -= std::min( m_lruThreshold - MIN_LRU_THRESHOLD, 4u );
+        else if( returnedStalePages < requestedStalePages )
+            m_lruThreshold -= std::min( m_lruThreshold - MIN_LRU_THRESHOLD, 2u );
+        else if( medianLruVal > m_lruThreshold )
+            m_lruThreshold++;
+    }
+};
+
+// The PagingSystem's eviction policy without an LRU table: every unreferenced page is stale, and
+// the stale pages gathered in page order are shuffled.
+class RandomPolicy : public CachePolicy
+{
+  public:
+    RandomPolicy( const Options& options )
+        : m_maxStalePages( options.maxStalePages )
+    {
+    }
+
+    void insert( unsigned int pageId ) override { m_pages.insert( pageId ); }
+    void access( unsigned int /*pageId*/ ) override {}
+    void remove( unsigned int pageId ) override { m_pages.erase( pageId ); }
+
+    void getStalePages( unsigned int maxPages, const std::unordered_set<unsigned int>& referencedPages, std::vector<unsigned int>& stalePages ) override
+    {
+        const size_t first = stalePages.size();
+        for( std::set<unsigned int>::const_iterator it = m_pages.begin(); it != m_pages.end() && stalePages.size() - first < m_maxStalePages; ++it )
+        {
+            if( referencedPages.count( *it ) == 0 )
+                stalePages.push_back( *it );
+        }
+        std::shuffle( stalePages.begin() + first, stalePages.end(), m_rng );
+        stalePages.resize( std::min( stalePages.size(), first + maxPages ) );
+    }
+
+  private:
+    unsigned int           m_maxStalePages;
+    std::set<unsigned int> m_pages;
+    std::mt19937           m_rng;  // Default seed, as in PagingSystem.
+};
+
+// CLOCK replacement: the pages form a ring with a reference bit each.  The hand sweeps the ring,
+// clearing reference bits, and chooses the first page whose bit was already clear.
+class ClockPolicy : public CachePolicy
+{
+  public:
+    ClockPolicy()
+        : m_hand( m_ring.end() )
+    {
+    }
+
+    void insert( unsigned int pageId ) override
+    {
+        // New pages go just behind the hand, so they are the last to be visited.
+        m_pages[pageId] = m_ring.insert( m_hand, Entry{pageId, true} );
+    }
+
+    void access( unsigned int pageId ) override { m_pages[pageId]->referenced = true; }
+
+    void remove( unsigned int pageId ) override
+    {
+        std::unordered_map<unsigned int, std::list<Entry>::iterator>::iterator it = m_pages.find( pageId );
+        if( it == m_pages.end() )
+            return;
+        if( m_hand == it->second )
+            ++m_hand;
+        m_ring.erase( it->second );
+        m_pages.erase( it );
+    }
+
+    void getStalePages( unsigned int maxPages, const std::unordered_set<unsigned int>& referencedPages, std::vector<unsigned int>& stalePages ) override
+    {
+        // Two sweeps are enough to clear every reference bit.
+        std::unordered_set<unsigned int> chosen;
+        const size_t                     maxSteps = 2 * m_ring.size();
+        for( size_t step = 0; step < maxSteps && chosen.size() < maxPages; ++step )
+        {
+            if( m_hand == m_ring.end() )
+                m_hand = m_ring.begin();
+            Entry& entry = *m_hand++;
+            if( referencedPages.count( entry.pageId ) != 0 || chosen.count( entry.pageId ) != 0 )
+                continue;
+            if( entry.referenced )
+                entry.referenced = false;
+            else
+            {
+                chosen.insert( entry.pageId );
+                stalePages.push_back( entry.pageId );
+            }
+        }
+    }
+
+  private:
+    struct Entry
+    {
+        unsigned int pageId;
+        bool         referenced;
+    };
+
+    std::list<Entry>                                             m_ring;
+    std::list<Entry>::iterator                                   m_hand;
+    std::unordered_map<unsigned int, std::list<Entry>::iterator> m_pages;
+};
+
+// A set of LRU lists with a common page index, used by the ARC and 2Q policies.  The front of each
+// list is the most recently used page.
+class PageLists
+{
+  public:
+    PageLists( unsigned int numLists )
+        : m_lists( numLists )
+    {
+    }
+
+    // Get the list holding a page, or -1 if it is not in any list.
+    int find( unsigned int pageId ) const
+    {
+        std::unordered_map<unsigned int, Location>::const_iterator it = m_index.find( pageId );
+        return it == m_index.end() ? -1 : it->second.list;
+    }
+
+    // Move a page to the front of a list, adding it if necessary.
+    void pushFront( int list, unsigned int pageId )
+    {
+        erase( pageId );
+        m_lists[list].push_front( pageId );
+        m_index[pageId] = Location{list, m_lists[list].begin()};
+    }
+
+    // Remove a page from its list.
+    void erase( unsigned int pageId )
+    {
+        std::unordered_map<unsigned int, Location>::iterator it = m_index.find( pageId );
+        if( it == m_index.end() )
+            return;
+        m_lists[it->second.list].erase( it->second.it );
+        m_index.erase( it );
+    }
+
+    // Remove the least recently used page of a list.
+    void popBack( int list ) { erase( m_lists[list].back() ); }
+
+    const std::list<unsigned int>& operator[]( int list ) const { return m_lists[list]; }
+    size_t size( int list ) const { return m_lists[list].size(); }
+
+  private:
+    struct Location
+    {
+        int                               list;
+        std::list<unsigned int>::iterator it;
+    };
+
+    std::vector<std::list<unsigned int>>       m_lists;
+    std::unordered_map<unsigned int, Location> m_index;
+};
+
+// Choose pages from the back of a list, skipping referenced and already chosen pages.
+class ListCursor
+{
+  public:
+    ListCursor( const std::list<unsigned int>& list, const std::unordered_set<unsigned int>& referencedPages )
+        : m_it( list.rbegin() )
+        , m_end( list.rend() )
+        , m_referencedPages( referencedPages )
+    {
+        skipReferenced();
+    }
+
+    bool         done() const { return m_it == m_end; }
+    unsigned int next()
+    {
+        const unsigned int pageId = *m_it++;
+        skipReferenced();
+        return pageId;
+    }
+
+  private:
+    std::list<unsigned int>::const_reverse_iterator m_it;
+    std::list<unsigned int>::const_reverse_iterator m_end;
+    const std::unordered_set<unsigned int>&         m_referencedPages;
+
+    void skipReferenced()
+    {
+        while( m_it != m_end && m_referencedPages.count( *m_it ) != 0 )
+            ++m_it;
+    }
+};
+
+size_t getCacheCapacity( const Options& options )
+{
+    const size_t maxTiles = options.maxTexMemPerDevice / TILE_SIZE_IN_BYTES;
+    return options.maxTexMemPerDevice == 0 ? std::numeric_limits<size_t>::max() / 2 : std::max<size_t>( maxTiles, 1 );
+}
+
+// Adaptive replacement cache.  Pages seen once are in T1 and pages seen again are in T2.  Evicted
+// pages are remembered in the ghost lists B1 and B2, and misses on ghosts adapt the target size of
+// T1.  Pages restored from the staged pages count as ghost hits.
+class ArcPolicy : public CachePolicy
+{
+  public:
+    ArcPolicy( const Options& options )
+        : m_capacity( getCacheCapacity( options ) )
+        , m_lists( NUM_LISTS )
+    {
+    }
+
+    void insert( unsigned int pageId ) override
+    {
+        const int list = m_lists.find( pageId );
+        if( list == B1 )
+        {
+            const size_t delta = std::max<size_t>( m_lists.size( B2 ) / m_lists.size( B1 ), 1 );
+            m_target           = std::min( m_target + delta, m_capacity );
+            m_lists.pushFront( T2, pageId );
+        }
+        else if( list == B2 )
+        {
+            const size_t delta = std::max<size_t>( m_lists.size( B1 ) / m_lists.size( B2 ), 1 );
+            m_target -= std::min( m_target, delta );
+            m_lists.pushFront( T2, pageId );
+        }
+        else
+        {
+            m_lists.pushFront( T1, pageId );
+        }
+        trimGhosts();
+    }
+
+    void access( unsigned int pageId ) override { m_lists.pushFront( T2, pageId ); }
+
+    void remove( unsigned int pageId ) override
+    {
+        const int list = m_lists.find( pageId );
+        if( list == T1 )
+            m_lists.pushFront( B1, pageId );
+        else if( list == T2 )
+            m_lists.pushFront( B2, pageId );
+        trimGhosts();
+    }
+
+    void getStalePages( unsigned int maxPages, const std::unordered_set<unsigned int>& referencedPages, std::vector<unsigned int>& stalePages ) override
+    {
+        // Replace from T1 while it is larger than the target, otherwise from T2.
+        ListCursor t1( m_lists[T1], referencedPages );
+        ListCursor t2( m_lists[T2], referencedPages );
+        size_t     t1Size = m_lists.size( T1 );
+        for( unsigned int i = 0; i < maxPages; ++i )
+        {
+            if( !t1.done() && ( t1Size > m_target || t2.done() ) )
+            {
+                stalePages.push_back( t1.next() );
+                --t1Size;
+            }
+            else if( !t2.done() )
+                stalePages.push_back( t2.next() );
+            else
+                break;
+        }
+    }
+
+  private:
+    enum
+    {
+        T1,
+        T2,
+        B1,
+        B2,
+        NUM_LISTS
+    };
+
+    size_t    m_capacity;
+    size_t    m_target = 0;  // Target size of T1.
+    PageLists m_lists;
+
+    void trimGhosts()
+    {
+        if( m_lists.size( T1 ) + m_lists.size( B1 ) > m_capacity && m_lists.size( B1 ) > 0 )
+            m_lists.popBack( B1 );
+        if( m_lists.size( T1 ) + m_lists.size( T2 ) + m_lists.size( B1 ) + m_lists.size( B2 ) > 2 * m_capacity )
+            m_lists.popBack( m_lists.size( B2 ) > 0 ? B2 : B1 );
+    }
+};
+
+// Full 2Q.  New pages enter the FIFO A1in, and pages evicted from it are remembered in the ghost
+// FIFO A1out.  Pages that are requested again while in A1out are promoted to the LRU list Am.
+class TwoQPolicy : public CachePolicy
+{
+  public:
+    TwoQPolicy( const Options& options )
+        : m_maxIn( std::max<size_t>( getCacheCapacity( options ) / 4, 1 ) )
+        , m_maxOut( std::max<size_t>( getCacheCapacity( options ) / 2, 1 ) )
+        , m_lists( NUM_LISTS )
+    {
+    }
+
+    void insert( unsigned int pageId ) override { m_lists.pushFront( m_lists.find( pageId ) == A1OUT ? AM : A1IN, pageId ); }
+
+    void access( unsigned int pageId ) override
+    {
+        if( m_lists.find( pageId ) == AM )
+            m_lists.pushFront( AM, pageId );
+    }
+
+    void remove( unsigned int pageId ) override
+    {
+        if( m_lists.find( pageId ) == A1IN )
+        {
+            m_lists.pushFront( A1OUT, pageId );
+            if( m_lists.size( A1OUT ) > m_maxOut )
+                m_lists.popBack( A1OUT );
+        }
+        else
+        {
+            m_lists.erase( pageId );
+        }
+    }
+
+    void getStalePages( unsigned int maxPages, const std::unordered_set<unsigned int>& referencedPages, std::vector<unsigned int>& stalePages ) override
+    {
+        // Reclaim from A1in while it is over its size limit, then from Am, then from A1in again.
+        ListCursor a1in( m_lists[A1IN], referencedPages );
+        ListCursor am( m_lists[AM], referencedPages );
+        size_t     a1inSize = m_lists.size( A1IN );
+        while( stalePages.size() < maxPages && !a1in.done() && a1inSize > m_maxIn )
+        {
+            stalePages.push_back( a1in.next() );
+            --a1inSize;
+        }
+        while( stalePages.size() < maxPages && !am.done() )
+            stalePages.push_back( am.next() );
+        while( stalePages.size() < maxPages && !a1in.done() )
+            stalePages.push_back( a1in.next() );
+    }
+
+  private:
+    enum
+    {
+        A1IN,
+        AM,
+        A1OUT,
+        NUM_LISTS
+    };
+
+    size_t    m_maxIn;
+    size_t    m_maxOut;
+    PageLists m_lists;
+};
+
+}  // namespace
+
+const char* getEvictionPolicyName( EvictionPolicy policy )
+{
+    return POLICY_NAMES[static_cast<int>( policy )];
+}
+
+bool findEvictionPolicy( const char* name, EvictionPolicy& policy )
+{
+    for( int i = 0; i < static_cast<int>( sizeof( POLICY_NAMES ) / sizeof( POLICY_NAMES[0] ) ); ++i )
+    {
+        if( strcmp( name, POLICY_NAMES[i] ) == 0 )
+        {
+            policy = static_cast<EvictionPolicy>( i );
+            return true;
+        }
+    }
+    return false;
+}
+
+std::unique_ptr<CachePolicy> createCachePolicy( EvictionPolicy policy, const Options& options )
+{
+    switch( policy )
+    {
+        case EvictionPolicy::LRU_THRESHOLD:
+            return std::unique_ptr<CachePolicy>( new LruThresholdPolicy( options ) );
+        case EvictionPolicy::RANDOM:
+            return std::unique_ptr<CachePolicy>( new RandomPolicy( options ) );
+        case EvictionPolicy::CLOCK:
+            return std::unique_ptr<CachePolicy>( new ClockPolicy );
+        case EvictionPolicy::ARC:
+            return std::unique_ptr<CachePolicy>( new ArcPolicy( options ) );
+        case EvictionPolicy::TWO_Q:
+            return std::unique_ptr<CachePolicy>( new TwoQPolicy( options ) );
+    }
+    OTK_ASSERT_MSG( false, "Unknown eviction policy" );
+    return std::unique_ptr<CachePolicy>();
+}
+
+CacheSimulatorStats& CacheSimulatorStats::operator+=( const CacheSimulatorStats& frame )
+{
+    timestamp = frame.timestamp;
+    numFrames += frame.numFrames;
+    numRequests += frame.numRequests;
+    numHits += frame.numHits;
+    numRestores += frame.numRestores;
+    numLoads += frame.numLoads;
+    numReloads += frame.numReloads;
+    numDropped += frame.numDropped;
+    numStaged += frame.numStaged;
+    numEvicted += frame.numEvicted;
+    numInvalidated += frame.numInvalidated;
+    bytesRead += frame.bytesRead;
+    bytesReread += frame.bytesReread;
+    numResidentPages = frame.numResidentPages;
+    numStagedPages   = frame.numStagedPages;
+    return *this;
+}
+
+CacheSimulator::CacheSimulator( const Options& options, EvictionPolicy policy )
+    : CacheSimulator( options, createCachePolicy( policy, options ) )
+{
+}
+
+CacheSimulator::CacheSimulator( const Options& options, std::unique_ptr<CachePolicy> policy )
+    : m_options( options )
+    , m_policy( std::move( policy ) )
+    , m_maxTiles( options.maxTexMemPerDevice == 0 ? 0 : std::max<size_t>( options.maxTexMemPerDevice / TILE_SIZE_IN_BYTES, 1 ) )
+{
+    OTK_ASSERT_MSG( m_policy != nullptr, "CacheSimulator requires a cache policy" );
+}
+
+size_t CacheSimulator::getNumFreeTiles() const
+{
+    if( m_maxTiles == 0 )
+        return std::numeric_limits<size_t>::max();
+    return m_pages.size() < m_maxTiles ? m_maxTiles - m_pages.size() : 0;
+}
+
+bool CacheSimulator::evictStagedPage( CacheSimulatorStats& stats )
+{
+    while( !m_stagedPages.empty() )
+    {
+        const StagedPage stagedPage = m_stagedPages.front();
+        m_stagedPages.pop_front();
+
+        // Skip pages that were restored or invalidated after they were staged.
+        std::unordered_map<unsigned int, PageEntry>::iterator it = m_pages.find( stagedPage.pageId );
+        if( it != m_pages.end() && it->second.state == PageState::STAGED && it->second.stageId == stagedPage.stageId )
+        {
+            m_pages.erase( it );
+            --m_numStagedPages;
+            ++stats.numEvicted;
+            return true;
+        }
+    }
+    return false;
+}
+
+CacheSimulatorStats CacheSimulator::simulateFrame( const unsigned int* pageIds, unsigned int numPageIds, uint64_t timestamp )
+{
+    CacheSimulatorStats stats;
+    stats.timestamp = timestamp;
+    stats.numFrames = 1;
+
+    // Sort the requests into hits, restores and misses.
+    m_referencedPages.clear();
+    m_misses.clear();
+    for( unsigned int i = 0; i < numPageIds; ++i )
+    {
+        const unsigned int pageId = pageIds[i];
+        if( pageId < m_options.numPageTableEntries || !m_referencedPages.insert( pageId ).second )
+            continue;
+        ++stats.numRequests;
+
+        std::unordered_map<unsigned int, PageEntry>::iterator it = m_pages.find( pageId );
+        if( it == m_pages.end() )
+        {
+            m_misses.push_back( pageId );
+        }
+        else if( it->second.state == PageState::RESIDENT )
+        {
+            ++stats.numHits;
+            m_policy->access( pageId );
+        }
+        else
+        {
+            // Restore a staged page (second chance), as PagingSystem::processRequests does.
+            ++stats.numRestores;
+            it->second.state = PageState::RESIDENT;
+            --m_numStagedPages;
+            m_policy->insert( pageId );
+        }
+    }
+
+    // Fill the misses, freeing staged tiles when memory is full.
+    for( unsigned int pageId : m_misses )
+    {
+        if( getNumFreeTiles() == 0 && !evictStagedPage( stats ) )
+        {
+            ++stats.numDropped;
+            continue;
+        }
+        m_pages[pageId] = PageEntry{PageState::RESIDENT, 0};
+        m_policy->insert( pageId );
+        ++stats.numLoads;
+        stats.bytesRead += TILE_SIZE_IN_BYTES;
+        if( !m_loadedPages.insert( pageId ).second )
+        {
+            ++stats.numReloads;
+            stats.bytesReread += TILE_SIZE_IN_BYTES;
+        }
+    }
+
+    // Free staged tiles until maxStagedPages tiles are free, as DemandLoaderImpl::freeStagedTiles does.
+    while( m_maxTiles != 0 && getNumFreeTiles() < m_options.maxStagedPages )
+    {
+        m_evictionActive = true;
+        if( !evictStagedPage( stats ) )
+            break;
+    }
+
+    // Stage stale pages.
+    m_policy->endFrame( m_referencedPages );
+    if( m_evictionActive && m_numStagedPages < m_options.maxStagedPages )
+    {
+        const unsigned int maxPages = std::min( std::min( m_options.maxStalePages, m_options.maxStagedPages - m_numStagedPages ),
+                                                m_options.maxInvalidatedPages - 1 );
+        m_stalePages.clear();
+        m_policy->getStalePages( maxPages, m_referencedPages, m_stalePages );
+        OTK_ASSERT_MSG( m_stalePages.size() <= maxPages, "CachePolicy returned too many stale pages" );
+        for( unsigned int pageId : m_stalePages )
+        {
+            std::unordered_map<unsigned int, PageEntry>::iterator it = m_pages.find( pageId );
+            OTK_ASSERT_MSG( it != m_pages.end() && it->second.state == PageState::RESIDENT && m_referencedPages.count( pageId ) == 0,
+                            "CachePolicy chose a page that cannot be staged" );
+            it->second = PageEntry{PageState::STAGED, m_nextStageId};
+            m_stagedPages.push_back( StagedPage{pageId, m_nextStageId++} );
+            ++m_numStagedPages;
+            ++stats.numStaged;
+            m_policy->remove( pageId );
+        }
+    }
+
+    stats.numResidentPages = static_cast<unsigned int>( m_pages.size() ) - m_numStagedPages;
+    stats.numStagedPages   = m_numStagedPages;
+    m_totals += stats;
+    return stats;
+}
+
+void CacheSimulator::invalidatePages( unsigned int startPage, unsigned int endPage )
+{
+    std::vector<unsigned int> pageIds;
+    for( const std::pair<const unsigned int, PageEntry>& page : m_pages )
+    {
+        if( page.first >= startPage && page.first < endPage )
+            pageIds.push_back( page.first );
+    }
+
+    // Staged pages are left in the staging queue, and skipped when it is drained.
+    for( unsigned int pageId : pageIds )
+    {
+        std::unordered_map<unsigned int, PageEntry>::iterator it = m_pages.find( pageId );
+        if( it->second.state == PageState::RESIDENT )
+            m_policy->remove( pageId );
+        else
+            --m_numStagedPages;
+        m_pages.erase( it );
+    }
+    m_totals.numInvalidated += static_cast<unsigned int>( pageIds.size() );
+    m_totals.numResidentPages = static_cast<unsigned int>( m_pages.size() ) - m_numStagedPages;
+    m_totals.numStagedPages   = m_numStagedPages;
+}
+
+Options getTraceFileOptions( const char* filename, unsigned int deviceIndex )
+{
+    // The options are recorded when a demand loader is created, before its requests.
+    TraceFileReader reader( filename );
+    TraceRecord     record;
+    while( reader.readRecord( record ) )
+    {
+        if( record.deviceIndex != deviceIndex )
+            continue;
+        if( record.type == TraceRecordType::OPTIONS )
+            return record.options;
+        if( record.type == TraceRecordType::REQUESTS )
+            break;
+    }
+    return Options();
+}
+
+std::vector<CacheSimulatorStats> simulateTraceFile( const char* filename, const Options& options, EvictionPolicy policy, unsigned int deviceIndex )
+{
+    CacheSimulator                   simulator( options, policy );
+    std::vector<CacheSimulatorStats> frames;
+
+    TraceFileReader reader( filename );
+    TraceRecord     record;
+    while( reader.readRecord( record ) )
+    {
+        if( record.deviceIndex != deviceIndex )
+            continue;
+        if( record.type == TraceRecordType::REQUESTS )
+            frames.push_back( simulator.simulateFrame( record.pageIds.data(), static_cast<unsigned int>( record.pageIds.size() ), record.timestamp ) );
+        else if( record.type == TraceRecordType::INVALIDATION && !record.hasPredicate )
+            simulator.invalidatePages( record.startPage, record.endPage );
+    }
+    return frames;
+}
+
+}  // namespace demandLoading
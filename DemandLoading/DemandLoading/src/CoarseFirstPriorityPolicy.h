@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <OptiXToolkit/DemandLoading/RequestPriorityPolicy.h>
+
+namespace demandLoading {
+
+/// The default request priority policy.  Samplers and resources come first, since nothing can be
+/// shown without them, followed by mip tails, followed by tiles from the coarsest mip level to the
+/// finest.
+class CoarseFirstPriorityPolicy : public RequestPriorityPolicy
+{
+  public:
+    /// Tiles in mip levels at or above this level share the highest tile priority.
+    static const unsigned int MAX_RANKED_MIP_LEVEL = 15;
+
+    unsigned int priority( const RequestInfo& request ) override
+    {
+        switch( request.kind )
+        {
+            case RequestKind::SAMPLER:
+            case RequestKind::RESOURCE:
+                return 0;
+            case RequestKind::MIP_TAIL:
+                return 1;
+            case RequestKind::TILE:
+            {
+                const unsigned int mipLevel = request.mipLevel < MAX_RANKED_MIP_LEVEL ? request.mipLevel : MAX_RANKED_MIP_LEVEL;
+                return 2 + MAX_RANKED_MIP_LEVEL - mipLevel;
+            }
+        }
+        return 0;
+    }
+};
+
+}  // namespace demandLoading
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -119,6 +119,24 @@ std::shared_ptr<demandLoading::Options> configure( demandLoading::Options option
     return std::shared_ptr<Options>( new Options( options ) );
 }
 
+const unsigned int TRANSFER_BUFFER_ALIGNMENT = 4096;
+
+// Number of tile-sized transfer buffers cached by each request processing thread.
+const unsigned int TRANSFER_BUFFER_MAGAZINE_SIZE = 8;
+
+// The pinned transfer memory budget (Options::maxPinnedMemory) is split between the pools of
+// tile-sized transfer buffers and the other transfer buffers, and so is the device transfer memory,
+// which has the same budget.  Zero leaves both unlimited.
+size_t tileTransferMemory( const Options& options )
+{
+    return options.maxPinnedMemory / 2;
+}
+
+size_t otherTransferMemory( const Options& options )
+{
+    return options.maxPinnedMemory - tileTransferMemory( options );
+}
+
 }  // anonymous namespace
 
 DemandLoaderImpl::DemandLoaderImpl( const Options& options )
@@ -128,11 +146,36 @@ DemandLoaderImpl::DemandLoaderImpl( const Options& options )
     , m_pageLoader( new DemandPageLoaderImpl( m_pageTableManager, &m_requestProcessor, m_options ) )
     , m_samplerRequestHandler( this )
     , m_cascadeRequestHandler( this )
-    , m_deviceTransferPool( new otk::DeviceAsyncAllocator(), new RingSuballocator(), DEFAULT_ALLOC_SIZE, options.maxPinnedMemory )
+    , m_deviceTransferPool( new otk::DeviceAsyncAllocator(), new RingSuballocator(), DEFAULT_ALLOC_SIZE, otherTransferMemory( options ) )
+    , m_pinnedTileTransferPool( new otk::PinnedAllocator(), new FixedSuballocator( TILE_SIZE_IN_BYTES, TRANSFER_BUFFER_ALIGNMENT ),
+                                DEFAULT_ALLOC_SIZE, tileTransferMemory( options ) )
+    , m_deviceTileTransferPool( new otk::DeviceAsyncAllocator(), new FixedSuballocator( TILE_SIZE_IN_BYTES, TRANSFER_BUFFER_ALIGNMENT ),
+                                DEFAULT_ALLOC_SIZE, tileTransferMemory( options ) )
+    , m_pinnedTileTransferCache( &m_pinnedTileTransferPool, TILE_SIZE_IN_BYTES, TRANSFER_BUFFER_ALIGNMENT, TRANSFER_BUFFER_MAGAZINE_SIZE )
+    , m_deviceTileTransferCache( &m_deviceTileTransferPool, TILE_SIZE_IN_BYTES, TRANSFER_BUFFER_ALIGNMENT, TRANSFER_BUFFER_MAGAZINE_SIZE )
 {
     // The demand loader is for the current cuda context
     OTK_ERROR_CHECK( cuCtxGetCurrent( &m_cudaContext ) );
 
+    // The page loader's pinned memory pool holds the other pinned transfer buffers.
+    m_pageLoader->getPinnedMemoryPool()->setMaxSize( otherTransferMemory( options ), false );
+
+    // Demand loaders with the same trace file share it, and tag their records with their device index.
+    if( !m_options->traceFile.empty() )
+    {
+        CUdevice device;
+        OTK_ERROR_CHECK( cuCtxGetDevice( &device ) );
+        m_traceDeviceIndex = static_cast<unsigned int>( device );
+        m_traceFile        = TraceFileWriter::open( m_options->traceFile );
+        m_traceFile->recordOptions( m_traceDeviceIndex, options );
+        m_requestProcessor.setTraceFile( m_traceFile.get(), m_traceDeviceIndex );
+        getPagingSystem()->setTraceFile( m_traceFile.get(), m_traceDeviceIndex );
+    }
+
+    // Demand loaders with the same image hash cache share it.
+    if( m_options->coalesceDuplicateImages && !m_options->imageHashCacheFile.empty() )
+        m_imageHashCache = ImageHashCache::open( m_options->imageHashCacheFile );
+
     // Reserve pages in the sampler request handler for all possible textures.
     m_samplerRequestHandler.setPageRange( 0, m_options->numPageTableEntries );
 
@@ -236,6 +279,9 @@ DemandTextureImpl* DemandLoaderImpl::makeTextureOrVariant( unsigned int textureI
                                                            const TextureDescriptor& textureDesc, 
                                                            std::shared_ptr<imageSource::ImageSource>& imageSource )
 {
+    if( m_traceFile )
+        m_traceFile->recordTexture( m_traceDeviceIndex, textureId, *imageSource, textureDesc );
+
     // Check to see if the image source has already been used
     auto imageIt = m_imageToTextureId.find( imageSource.get() );
     if( imageIt != m_imageToTextureId.end() )
@@ -244,25 +290,24 @@ DemandTextureImpl* DemandLoaderImpl::makeTextureOrVariant( unsigned int textureI
         return new DemandTextureImpl( textureId, masterTexture, textureDesc, this );
     }
 
-    // Check to see if the image source is identical to another in use.
-    // TODO: Move this to SamplerRequestHandler to keep lazy opening of image files.
-    unsigned long long hash = 0;
+    // Record the textureId for the current image.
+    m_imageToTextureId[imageSource.get()] = textureId;
+
+    // Hashing an image reads it, so the check for an identical image is deferred until the texture
+    // is requested (see linkDuplicateTexture).  In the meantime, the image is hashed by the request
+    // processor when it is idle.
     if( m_options->coalesceDuplicateImages )
     {
-        hash = imageSource->getHash( (CUstream)0 );
-        auto hashIt = m_hashToTextureId.find( hash );
-        if( hashIt != m_hashToTextureId.end() )
-        {
-            DemandTextureImpl* masterTexture = m_textures[hashIt->second].get();
-            return new DemandTextureImpl( textureId, masterTexture, textureDesc, this );
-        }
+        std::shared_ptr<PendingImageHash> pending( new PendingImageHash );
+        pending->image                  = imageSource;
+        m_pendingImageHashes[textureId] = pending;
+        m_requestProcessor.addTask( [this, pending]() {
+            ContextSaver contextSaver;
+            OTK_ERROR_CHECK( cuCtxSetCurrent( m_cudaContext ) );
+            getImageHash( *pending );
+        } );
     }
 
-    // Record the textureId for the current image and its hash.
-    m_imageToTextureId[imageSource.get()] = textureId;
-    if( hash )
-        m_hashToTextureId[hash] = textureId;
-
     // For cascading texture sizes, make a CascadeImage wrapper.
     if( getOptions().useCascadingTextureSizes )
     {
@@ -275,6 +320,70 @@ DemandTextureImpl* DemandLoaderImpl::makeTextureOrVariant( unsigned int textureI
     return new DemandTextureImpl( textureId, textureDesc, imageSource, this );
 }
 
+unsigned long long DemandLoaderImpl::getImageHash( PendingImageHash& pending )
+{
+    std::unique_lock<std::mutex> lock( pending.mutex );
+    if( pending.isHashed )
+        return pending.hash;
+    pending.isHashed = true;
+
+    // A hash of 0 leaves the texture unlinked, so a failure to read the image is reported when the
+    // texture is opened rather than here.
+    try
+    {
+        const std::string path = pending.image->getPath();
+        if( m_imageHashCache && !path.empty() && m_imageHashCache->find( path, &pending.hash ) )
+            return pending.hash;
+
+        pending.hash = pending.image->getHash( CUstream{} );
+        if( m_imageHashCache && !path.empty() && pending.hash != 0 )
+            m_imageHashCache->insert( path, pending.hash );
+    }
+    catch( ... )
+    {
+        pending.hash = 0;
+    }
+    return pending.hash;
+}
+
+void DemandLoaderImpl::linkDuplicateTexture( unsigned int textureId )
+{
+    std::shared_ptr<PendingImageHash> pending;
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        auto                         it = m_pendingImageHashes.find( textureId );
+        if( it == m_pendingImageHashes.end() )
+            return;
+        pending = it->second;
+    }
+
+    // Hash the image without holding the loader mutex, unless a background task already has.
+    const unsigned long long hash = getImageHash( *pending );
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    // Another request for the texture (its sampler or base color) might have linked it already.
+    auto it = m_pendingImageHashes.find( textureId );
+    if( it == m_pendingImageHashes.end() || it->second != pending )
+        return;
+    m_pendingImageHashes.erase( it );
+    if( hash == 0 )
+        return;
+
+    // Make the texture a variant of the first texture with an identical image, or make it the
+    // texture for the image hash.
+    auto hashIt = m_hashToTextureId.find( hash );
+    if( hashIt == m_hashToTextureId.end() )
+    {
+        m_hashToTextureId[hash] = textureId;
+        return;
+    }
+    DemandTextureImpl* masterTexture = m_textures.at( hashIt->second ).get();
+    while( masterTexture->getMasterTexture() )
+        masterTexture = masterTexture->getMasterTexture();
+    m_textures.at( textureId )->setMasterTexture( masterTexture );
+}
+
 unsigned int DemandLoaderImpl::createResource( unsigned int numPages, ResourceCallback callback, void* callbackContext )
 {
     OTK_ASSERT_CONTEXT_IS( m_cudaContext );
@@ -291,7 +400,7 @@ unsigned int DemandLoaderImpl::createResource( unsigned int numPages, ResourceCa
 void DemandLoaderImpl::invalidatePage( unsigned int pageId )
 {
     std::unique_lock<std::mutex> lock( m_mutex );
-    m_pageLoader->invalidatePageRange( pageId, pageId + 1, nullptr );
+    invalidatePageRange( pageId, pageId + 1, nullptr );
 }
 
 void DemandLoaderImpl::loadTextureTiles( CUstream stream, unsigned int textureId, bool reloadIfResident )
@@ -323,11 +432,11 @@ void DemandLoaderImpl::unloadTextureTiles( unsigned int textureId )
 
         // Unload texture tiles
         TilePoolReturnPredicate* predicate = new TilePoolReturnPredicate( getDeviceMemoryManager() );
-        m_pageLoader->invalidatePageRange( startPage, endPage, predicate );
+        invalidatePageRange( startPage, endPage, predicate );
 
         // Unload base color
         unsigned int baseColorId = samplerIdToBaseColorId( textureId, getOptions().maxTextures );
-        m_pageLoader->invalidatePageRange( baseColorId, baseColorId + 1, nullptr );
+        invalidatePageRange( baseColorId, baseColorId + 1, nullptr );
     }
 }
 
@@ -340,7 +449,7 @@ void DemandLoaderImpl::migrateTextureTiles( const TextureSampler& oldSampler, De
     unsigned int startPage = oldSampler.startPage;
     unsigned int endPage   = oldSampler.startPage + oldSampler.numPages;
     MigrateTextureTilesPredicate* predicate = new MigrateTextureTilesPredicate( oldSampler, newTexture, m_pageLoader.get(), getDeviceMemoryManager() );
-    m_pageLoader->invalidatePageRange( startPage, endPage, predicate );
+    invalidatePageRange( startPage, endPage, predicate );
 }
 
 void DemandLoaderImpl::replaceTexture( CUstream                                  stream,
@@ -358,6 +467,9 @@ void DemandLoaderImpl::replaceTexture( CUstream
 
     std::unique_lock<std::mutex> lock( m_mutex );
 
+    // The replaced image can't make the texture a duplicate.
+    m_pendingImageHashes.erase( textureId );
+
     // Copy the old sampler (for migrating tiles), and replace the texture
     bool textureOpen = m_textures.at( textureId )->isOpen();
     TextureSampler oldSampler = ( textureOpen ) ? m_textures.at( textureId )->getSampler() : TextureSampler{};
@@ -521,6 +633,8 @@ void DemandLoaderImpl::freeStagedTiles( CUstream stream )
     PagingSystem* pagingSystem = getPagingSystem();
     PageMapping   mapping;
 
+    std::vector<unsigned int> evictedPageIds;
+
     while( getDeviceMemoryManager()->needTileBlocksFreed() )
     {
         pagingSystem->activateEviction( true );
@@ -528,24 +642,30 @@ void DemandLoaderImpl::freeStagedTiles( CUstream stream )
         {
             unmapTileResource( stream, mapping.id );
             getDeviceMemoryManager()->freeTileBlock( mapping.page );
+            if( m_traceFile )
+                evictedPageIds.push_back( mapping.id );
         }
         else 
         {
             break;
         }
     }
+
+    if( !evictedPageIds.empty() )
+        m_traceFile->recordEviction( m_traceDeviceIndex, evictedPageIds.data(), static_cast<unsigned int>( evictedPageIds.size() ) );
 }
 
 const TransferBufferDesc DemandLoaderImpl::allocateTransferBuffer( CUmemorytype memoryType, size_t size, CUstream /*stream*/ )
 {
-    const unsigned int alignment = 4096;
-
     OTK_ASSERT_CONTEXT_IS( m_cudaContext );
+
+    // Tile-sized buffers come from the calling thread's cache, bypassing the pool's lock.
+    const bool      isTile = size == TILE_SIZE_IN_BYTES;
     MemoryBlockDesc memoryBlock{};
     if( memoryType == CU_MEMORYTYPE_HOST )
-        memoryBlock = m_pageLoader->getPinnedMemoryPool()->alloc( size, alignment );
+        memoryBlock = isTile ? m_pinnedTileTransferCache.alloc() : m_pageLoader->getPinnedMemoryPool()->alloc( size, TRANSFER_BUFFER_ALIGNMENT );
     else if( memoryType == CU_MEMORYTYPE_DEVICE )
-        memoryBlock = m_deviceTransferPool.alloc( size, alignment );
+        memoryBlock = isTile ? m_deviceTileTransferCache.alloc() : m_deviceTransferPool.alloc( size, TRANSFER_BUFFER_ALIGNMENT );
 
     return TransferBufferDesc{ memoryType, memoryBlock };
 }
@@ -556,8 +676,13 @@ void DemandLoaderImpl::freeTransferBuffer( const TransferBufferDesc& transferBuf
 
     OTK_ASSERT_CONTEXT_IS( m_cudaContext );
     OTK_ASSERT_CONTEXT_MATCHES_STREAM( stream );
-    if( transferBuffer.memoryType == CU_MEMORYTYPE_HOST )
+    const bool isTile = transferBuffer.memoryBlock.size == TILE_SIZE_IN_BYTES;
+    if( transferBuffer.memoryType == CU_MEMORYTYPE_HOST && isTile )
+        m_pinnedTileTransferCache.freeAsync( transferBuffer.memoryBlock, stream );
+    else if( transferBuffer.memoryType == CU_MEMORYTYPE_HOST )
         m_pageLoader->getPinnedMemoryPool()->freeAsync( transferBuffer.memoryBlock, stream );
+    else if( transferBuffer.memoryType == CU_MEMORYTYPE_DEVICE && isTile )
+        m_deviceTileTransferCache.freeAsync( transferBuffer.memoryBlock, stream );
     else if( transferBuffer.memoryType == CU_MEMORYTYPE_DEVICE )
         m_deviceTransferPool.freeAsync( transferBuffer.memoryBlock, stream );
     else 
@@ -569,9 +694,15 @@ Statistics DemandLoaderImpl::getStatistics() const
     std::unique_lock<std::mutex> lock( m_mutex );
 
     Statistics stats{};
-    stats.numTextures           = m_textures.size();
-    stats.requestProcessingTime = m_pageLoader->getTotalProcessingTime();
-    stats.deviceMemoryUsed      = getDeviceMemoryManager()->getTotalDeviceMemory();
+    stats.numTextures              = m_textures.size();
+    stats.requestProcessingTime    = m_pageLoader->getTotalProcessingTime();
+    stats.deviceMemoryUsed         = getDeviceMemoryManager()->getTotalDeviceMemory();
+    stats.numTilesCoalesced        = getDeviceMemoryManager()->getNumTilesCoalesced();
+    stats.bytesCoalesced           = stats.numTilesCoalesced * TILE_SIZE_IN_BYTES;
+    stats.numTilesDeduplicated     = getDeviceMemoryManager()->getNumTilesDeduplicated();
+    stats.bytesDeduplicated        = stats.numTilesDeduplicated * TILE_SIZE_IN_BYTES;
+    stats.tileTransferPinnedMemory = m_pinnedTileTransferPool.trackedSize();
+    stats.tileTransferDeviceMemory = m_deviceTileTransferPool.trackedSize();
 
     // Multiple textures can share the same ImageSource. Use a set to avoid duplicate counting.
     std::set<imageSource::ImageSource*> images;
@@ -609,6 +740,43 @@ void DemandLoaderImpl::setMaxTextureMemory( size_t maxMem )
     m_pageLoader->setMaxTextureMemory( maxMem );
 }
 
+void DemandLoaderImpl::invalidatePageRange( unsigned int startPage, unsigned int endPage, PageInvalidatorPredicate* predicate )
+{
+    if( m_traceFile )
+        m_traceFile->recordInvalidation( m_traceDeviceIndex, startPage, endPage, predicate != nullptr );
+    m_pageLoader->invalidatePageRange( startPage, endPage, predicate );
+}
+
+void DemandLoaderImpl::replayTexture( unsigned int textureId, std::shared_ptr<imageSource::ImageSource> image, const TextureDescriptor& textureDesc )
+{
+    OTK_ASSERT_CONTEXT_IS( m_cudaContext );
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_isActive = true;
+
+    OTK_ASSERT_MSG( textureId >= m_textures.size() && textureId < getOptions().maxTextures, "Invalid texture id in trace file" );
+    for( unsigned int emptyId = static_cast<unsigned int>( m_textures.size() ); emptyId < textureId; ++emptyId )
+    {
+        m_textures.emplace( emptyId, nullptr );
+        m_pageLoader->setPageTableEntry( emptyId, false, 0ULL );
+    }
+
+    DemandTextureImpl* tex = makeTextureOrVariant( textureId, textureDesc, image );
+    m_textures.emplace( textureId, tex );
+}
+
+Ticket DemandLoaderImpl::replayRequests( CUstream stream, const unsigned int* pageIds, unsigned int numPageIds )
+{
+    OTK_ASSERT_CONTEXT_IS( m_cudaContext );
+    OTK_ASSERT_CONTEXT_MATCHES_STREAM( stream );
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    Ticket             ticket = TicketImpl::create( stream );
+    const unsigned int id     = m_ticketId++;
+    m_requestProcessor.setTicket( id, ticket );
+    m_requestProcessor.addRequests( stream, id, pageIds, numPageIds );
+    return ticket;
+}
+
 unsigned int DemandLoaderImpl::allocateTexturePages( unsigned int numTextures )
 {
     // Allocate pages for numTextures. Note: pages for all textures were reserved in the constructor of DemandLoaderImpl.
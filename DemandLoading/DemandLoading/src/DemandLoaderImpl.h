@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -8,6 +8,8 @@
 
 #include "DemandPageLoaderImpl.h"
 #include <OptiXToolkit/Memory/Allocators.h>
+#include <OptiXToolkit/Memory/FixedSuballocator.h>
+#include <OptiXToolkit/Memory/MagazineCache.h>
 #include <OptiXToolkit/Memory/MemoryPool.h>
 #include <OptiXToolkit/Memory/RingSuballocator.h>
 #include "PageTableManager.h"
@@ -19,6 +21,8 @@
 #include "Textures/CascadeRequestHandler.h"
 #include <OptiXToolkit/DemandLoading/TextureCascade.h>
 #include "TransferBufferDesc.h"
+#include "Util/ImageHashCache.h"
+#include "Util/TraceFile.h"
 
 #include <cuda.h>
 
@@ -146,6 +150,12 @@ class DemandLoaderImpl : public DemandLoader
     /// Get the specified texture.
     DemandTextureImpl* getTexture( unsigned int textureId ) { return m_textures.at( textureId ).get(); }
 
+    /// If coalesceDuplicateImages is set, and the texture was created with an image whose hash is
+    /// pending, link it to the texture with an identical image, if any, or make it the texture for
+    /// its image hash.  The image is hashed if the hash hasn't been computed in the background.
+    /// Called when the texture's sampler or base color is first requested, before it is opened.
+    void linkDuplicateTexture( unsigned int textureId );
+
     /// Get the PagingSystem for the current CUDA context.
     PagingSystem* getPagingSystem() const;
     
@@ -177,6 +187,20 @@ class DemandLoaderImpl : public DemandLoader
     /// Get the OptiX context associated with this demand loader
     OptixDeviceContext getOptixContext() override { return m_optixContext; }
 
+    /// Get the trace file, or null if tracing is disabled.
+    TraceFileWriter* getTraceFile() const { return m_traceFile.get(); }
+
+    /// Get the device index with which trace records are tagged.
+    unsigned int getTraceDeviceIndex() const { return m_traceDeviceIndex; }
+
+    /// Create a texture with the given id, for trace file replay.  Texture ids that were skipped
+    /// (e.g. empty slots in udim textures) are left empty.
+    void replayTexture( unsigned int textureId, std::shared_ptr<imageSource::ImageSource> image, const TextureDescriptor& textureDesc );
+
+    /// Enqueue a batch of page requests from a trace file.  Returns a ticket that is notified when
+    /// the requests have been filled.
+    Ticket replayRequests( CUstream stream, const unsigned int* pageIds, unsigned int numPageIds );
+
   private:
     mutable std::mutex       m_mutex;
     std::shared_ptr<Options> m_options;
@@ -184,6 +208,9 @@ class DemandLoaderImpl : public DemandLoader
     OptixDeviceContext       m_optixContext; // The optix context
     bool                     m_isActive = false;  // Controls whether pullRequests kernel is launched.
 
+    std::shared_ptr<TraceFileWriter> m_traceFile;  // Records page requests, etc. (if Options::traceFile is set)
+    unsigned int                     m_traceDeviceIndex = 0;
+
     std::shared_ptr<PageTableManager>     m_pageTableManager;  // Allocates ranges of virtual pages.
     ThreadPoolRequestProcessor            m_requestProcessor;  // Asynchronously processes page requests.
     std::unique_ptr<DemandPageLoaderImpl> m_pageLoader;
@@ -192,11 +219,35 @@ class DemandLoaderImpl : public DemandLoader
     std::map<imageSource::ImageSource*, unsigned int> m_imageToTextureId;  // look up textureId from image*
     std::map<unsigned long long, unsigned int> m_hashToTextureId; // look up textureId from image hash
 
+    // The image hash of a texture that hasn't been linked to a duplicate yet.  The hash is computed
+    // once, either by a background task or when the texture is first requested.
+    struct PendingImageHash
+    {
+        std::shared_ptr<imageSource::ImageSource> image;
+        std::mutex                                mutex;
+        bool                                      isHashed = false;
+        unsigned long long                        hash     = 0;
+    };
+    std::map<unsigned int, std::shared_ptr<PendingImageHash>> m_pendingImageHashes;  // indexed by textureId
+    std::shared_ptr<ImageHashCache> m_imageHashCache;  // Persistent image hashes (if Options::imageHashCacheFile is set)
+
     SamplerRequestHandler m_samplerRequestHandler;  // Handles requests for texture samplers.
     CascadeRequestHandler m_cascadeRequestHandler;  // Handles cascading texture sizes.
 
     otk::MemoryPool<otk::DeviceAsyncAllocator, otk::RingSuballocator> m_deviceTransferPool;
 
+    // Pools of tile-sized transfer buffers.  They are separate from the pinned memory pool and the
+    // device transfer pool, so the free tiles parked in the caches' magazines never hold memory that
+    // other allocations from those pools (page mapping staging, mip tails) are waiting for.  Each
+    // kind of transfer memory is limited to its share of Options::maxPinnedMemory.
+    otk::MemoryPool<otk::PinnedAllocator, otk::FixedSuballocator>      m_pinnedTileTransferPool;
+    otk::MemoryPool<otk::DeviceAsyncAllocator, otk::FixedSuballocator> m_deviceTileTransferPool;
+
+    // Per-thread caches of tile-sized transfer buffers, which every request processing thread
+    // allocates and frees for every tile it loads.
+    otk::MagazineCache<otk::PinnedAllocator, otk::FixedSuballocator>      m_pinnedTileTransferCache;
+    otk::MagazineCache<otk::DeviceAsyncAllocator, otk::FixedSuballocator> m_deviceTileTransferCache;
+
     std::vector<std::unique_ptr<ResourceRequestHandler>> m_resourceRequestHandlers;  // Request handlers for arbitrary resources.
 
     unsigned int m_ticketId{};
@@ -207,8 +258,14 @@ class DemandLoaderImpl : public DemandLoader
     // Create a normal or variant version of a demand texture, based on the imageSource 
     DemandTextureImpl* makeTextureOrVariant( unsigned int textureId, const TextureDescriptor& textureDesc, std::shared_ptr<imageSource::ImageSource>& imageSource );
 
+    // Get the hash of a pending image, computing it (or finding it in the image hash cache) if necessary.
+    unsigned long long getImageHash( PendingImageHash& pending );
+
     // Allocate pages for a number of textures (samplers and base colors)
     unsigned int allocateTexturePages( unsigned int numTextures );
+
+    // Queue a range of pages for invalidation, recording it in the trace file.
+    void invalidatePageRange( unsigned int startPage, unsigned int endPage, PageInvalidatorPredicate* predicate );
 };
 
 }  // namespace demandLoading
@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <OptiXToolkit/Error/ErrorCheck.h>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace demandLoading {
+
+/// HostPageTable is the host-side residency table used by the PagingSystem for eviction.  It is a
+/// two-level paged array indexed directly by page id: the top level is a vector of pointers to
+/// fixed-size chunks of entries, which are allocated on first use.  A lookup is two array index
+/// operations (no hashing or tree traversal), and a range of pages can be walked in increasing
+/// page id order, skipping chunks that hold no valid entries.  Chunks are retained once allocated,
+/// since pages that are evicted tend to be filled again.  HostPageTable is not thread safe.
+class HostPageTable
+{
+  public:
+    struct Entry
+    {
+        unsigned long long entry;
+        bool               valid;         // Whether the entry is present in the table.
+        bool               resident;      // Whether a page is considered resident on the GPU
+        bool               staged;        // Pages that are currently staged (and not restored by second chance).
+        bool               inStagedList;  // All pages that are in the staged list, whether restored or not.
+    };
+
+    /// Number of entries per chunk (as a power of two).
+    static const unsigned int CHUNK_BITS = 12;
+    static const unsigned int CHUNK_SIZE = 1u << CHUNK_BITS;
+
+    /// Construct a table that can hold page ids in [0, numPages).  No chunks are allocated yet.
+    explicit HostPageTable( unsigned int numPages )
+        : m_numPages( numPages )
+        , m_chunks( ( static_cast<size_t>( numPages ) + CHUNK_SIZE - 1 ) >> CHUNK_BITS )
+    {
+    }
+
+    /// Return the number of valid entries in the table.
+    size_t size() const { return m_size; }
+
+    /// Return the maximum number of pages the table can hold.
+    unsigned int capacity() const { return m_numPages; }
+
+    /// Find the entry for the given page. Returns nullptr if the page is not in the table.
+    Entry* find( unsigned int pageId )
+    {
+        Chunk* chunk = getChunk( pageId );
+        if( chunk == nullptr )
+            return nullptr;
+        Entry& e = chunk->entries[pageId & ( CHUNK_SIZE - 1 )];
+        return e.valid ? &e : nullptr;
+    }
+
+    /// Insert or overwrite the entry for the given page, returning a reference to it.
+    Entry& insert( unsigned int pageId, const Entry& value )
+    {
+        OTK_ASSERT_MSG( pageId < m_numPages, "pageId outside of host page table range." );
+        std::unique_ptr<Chunk>& chunk = m_chunks[pageId >> CHUNK_BITS];
+        if( !chunk )
+            chunk.reset( new Chunk() );
+
+        Entry& e = chunk->entries[pageId & ( CHUNK_SIZE - 1 )];
+        if( !e.valid )
+        {
+            ++chunk->numValid;
+            ++m_size;
+        }
+        e       = value;
+        e.valid = true;
+        return e;
+    }
+
+    /// Remove the entry for the given page, if present.
+    void erase( unsigned int pageId )
+    {
+        Chunk* chunk = getChunk( pageId );
+        if( chunk == nullptr )
+            return;
+        Entry& e = chunk->entries[pageId & ( CHUNK_SIZE - 1 )];
+        if( e.valid )
+        {
+            e.valid = false;
+            --chunk->numValid;
+            --m_size;
+        }
+    }
+
+    /// Return the first valid entry with a page id in [pageId, endId), updating pageId to its page
+    /// id. Returns nullptr if there are no valid entries in the range.  Used to walk a range in order:
+    ///   for( Entry* e = table.next( id, endId ); e; e = table.next( ++id, endId ) ) ...
+    Entry* next( unsigned int& pageId, unsigned int endId )
+    {
+        if( endId > m_numPages )
+            endId = m_numPages;
+        while( pageId < endId )
+        {
+            Chunk* chunk = m_chunks[pageId >> CHUNK_BITS].get();
+            const unsigned long long chunkEnd = ( static_cast<unsigned long long>( pageId >> CHUNK_BITS ) + 1 ) << CHUNK_BITS;
+            const unsigned int       last     = chunkEnd < endId ? static_cast<unsigned int>( chunkEnd ) : endId;
+            if( chunk == nullptr || chunk->numValid == 0 )
+            {
+                pageId = last;
+                continue;
+            }
+            for( ; pageId < last; ++pageId )
+            {
+                Entry& e = chunk->entries[pageId & ( CHUNK_SIZE - 1 )];
+                if( e.valid )
+                    return &e;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Not copyable.
+    HostPageTable( const HostPageTable& ) = delete;
+
+    /// Not assignable.
+    HostPageTable& operator=( const HostPageTable& ) = delete;
+
+  private:
+    struct Chunk
+    {
+        Entry        entries[CHUNK_SIZE]{};
+        unsigned int numValid = 0;
+    };
+
+    Chunk* getChunk( unsigned int pageId ) const
+    {
+        return pageId < m_numPages ? m_chunks[pageId >> CHUNK_BITS].get() : nullptr;
+    }
+
+    unsigned int                        m_numPages;
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+    size_t                              m_size = 0;
+};
+
+}  // namespace demandLoading
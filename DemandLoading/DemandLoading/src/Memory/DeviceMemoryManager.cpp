@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -7,21 +7,81 @@
 
 #include <OptiXToolkit/Error/ErrorCheck.h>
 
+#include <utility>
+
 using namespace otk;
 
 namespace demandLoading {
 
 static const unsigned int SAMPLER_POOL_ALLOC_SIZE = 65536;
 
+// Add a reference to the shared tile with the given key, or make bh the shared tile for the key if
+// there is none and the table has room (maxSize 0 is unlimited).  Returns an empty handle if full.
+template <class KeyMap, class BlockMap, class Key>
+static TileBlockHandle shareTile( KeyMap& tiles, BlockMap& keys, const Key& key, const TileBlockHandle& bh, unsigned int maxSize, size_t& numShared )
+{
+    auto it = tiles.find( key );
+    if( it != tiles.end() )
+    {
+        ++it->second.refCount;
+        ++numShared;
+        return it->second.bh;
+    }
+
+    if( maxSize != 0 && tiles.size() >= maxSize )
+        return TileBlockHandle{ 0, 0 };
+
+    tiles.insert( std::make_pair( key, typename KeyMap::mapped_type{ bh, 1 } ) );
+    keys[bh.block.data] = key;
+    return bh;
+}
+
+// Release a reference to a block if it is in the given table of shared tiles.  Returns false if
+// it isn't, otherwise sets freeBlock to whether the last reference was released.
+template <class KeyMap, class BlockMap>
+static bool releaseTile( KeyMap& tiles, BlockMap& keys, const TileBlockDesc& blockDesc, bool& freeBlock )
+{
+    auto keyIt = keys.find( blockDesc.data );
+    if( keyIt == keys.end() )
+        return false;
+
+    auto tileIt = tiles.find( keyIt->second );
+    OTK_ASSERT( tileIt != tiles.end() && tileIt->second.refCount > 0 );
+    freeBlock = --tileIt->second.refCount == 0;
+    if( freeBlock )
+    {
+        tiles.erase( tileIt );
+        keys.erase( keyIt );
+    }
+    return true;
+}
+
+// Remove shared tiles whose arenas were deleted when the tile pool shrank.
+template <class KeyMap, class BlockMap>
+static void eraseDeletedSharedTiles( KeyMap& tiles, BlockMap& keys, uint64_t numArenas )
+{
+    for( auto it = tiles.begin(); it != tiles.end(); )
+    {
+        if( it->second.bh.block.arenaId >= numArenas )
+        {
+            keys.erase( it->second.bh.block.data );
+            it = tiles.erase( it );
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
 DeviceMemoryManager::DeviceMemoryManager( std::shared_ptr<Options> options )
     : m_options( options )
     , m_samplerPool( new DeviceAllocator(), new FixedSuballocator( sizeof( TextureSampler ), alignof( TextureSampler ) ), SAMPLER_POOL_ALLOC_SIZE )
     , m_deviceContextMemory( new DeviceAllocator(), nullptr )
-    , m_whiteBlackTiles( static_cast<int>( WB_NONE ), otk::TileBlockHandle{0, 0} )
 {
     if( m_options->useSparseTextures )
     {
-        m_tilePool.reset( new TilePool( new TextureTileAllocator(), new HeapSuballocator(),
+        m_tilePool.reset( new TilePool( new TextureTileAllocator(), new TlsfSuballocator(),
                                         TextureTileAllocator::getRecommendedAllocationSize(), m_options->maxTexMemPerDevice ) );
     }
 }
@@ -76,13 +136,34 @@ void DeviceMemoryManager::setMaxTextureTileMemory( size_t maxMemory )
 
     m_tilePool->setMaxSize( static_cast<uint64_t>( maxMemory ), true, CUstream{0} );
 
-    // Remove references to white/black tiles that were deleted
-    uint64_t numArenas = m_tilePool->numAllocations();
-    for( otk::TileBlockHandle &bh : m_whiteBlackTiles )
-    {
-        if( bh.handle != 0 && bh.block.arenaId >= numArenas )
-            bh = otk::TileBlockHandle{0,0};
-    }
+    // Remove shared tiles that were deleted
+    std::unique_lock<std::mutex> lock( m_sharedTilesMutex );
+    uint64_t                     numArenas = m_tilePool->numAllocations();
+    eraseDeletedSharedTiles( m_uniformTiles, m_uniformTileColors, numArenas );
+    eraseDeletedSharedTiles( m_duplicateTiles, m_duplicateTileHashes, numArenas );
+}
+
+otk::TileBlockHandle DeviceMemoryManager::shareUniformTile( const UniformTileColor& color, const otk::TileBlockHandle& bh )
+{
+    std::unique_lock<std::mutex> lock( m_sharedTilesMutex );
+    return shareTile( m_uniformTiles, m_uniformTileColors, color, bh, m_options->maxUniformTiles, m_numTilesCoalesced );
+}
+
+otk::TileBlockHandle DeviceMemoryManager::shareDuplicateTile( const TileContentHash& hash, const otk::TileBlockHandle& bh )
+{
+    std::unique_lock<std::mutex> lock( m_sharedTilesMutex );
+    return shareTile( m_duplicateTiles, m_duplicateTileHashes, hash, bh, 0, m_numTilesDeduplicated );
+}
+
+bool DeviceMemoryManager::releaseSharedTile( const otk::TileBlockDesc& blockDesc )
+{
+    std::unique_lock<std::mutex> lock( m_sharedTilesMutex );
+    bool                         freeBlock;
+    if( releaseTile( m_uniformTiles, m_uniformTileColors, blockDesc, freeBlock ) )
+        return freeBlock;
+    if( releaseTile( m_duplicateTiles, m_duplicateTileHashes, blockDesc, freeBlock ) )
+        return freeBlock;
+    return true;
 }
 
 }  // namespace demandLoading
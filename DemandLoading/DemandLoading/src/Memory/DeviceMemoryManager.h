@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -14,15 +14,19 @@
 #include <OptiXToolkit/Memory/HeapSuballocator.h>
 #include <OptiXToolkit/Memory/MemoryBlockDesc.h>
 #include <OptiXToolkit/Memory/MemoryPool.h>
+#include <OptiXToolkit/Memory/TlsfSuballocator.h>
 
 #include <cstddef>
 #include <OptiXToolkit/DemandLoading/DeviceContext.h>
 #include <OptiXToolkit/DemandLoading/Options.h>
 #include <OptiXToolkit/DemandLoading/Statistics.h>
 #include <OptiXToolkit/DemandLoading/TextureSampler.h>
-#include "WhiteBlackTileCheck.h"
+#include "TileContentHash.h"
+#include "UniformTileCheck.h"
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 namespace demandLoading {
@@ -50,34 +54,40 @@ class DeviceMemoryManager
         return m_tilePool->allocTextureTiles( numBytes );
     }
 
-    /// Free a TileBlock for this device.
+    /// Free a TileBlock for this device.  A shared tile (uniform or duplicate) loses a reference,
+    /// and is freed with its last reference.
     void freeTileBlock( const otk::TileBlockDesc& blockDesc )
     {
         OTK_ASSERT( m_tilePool );
-        // Do not free coalesced white/black tiles
-        if( m_options->coalesceWhiteBlackTiles )
-        {
-            TileBlockHandle bh = TileBlockHandle{ getTileBlockHandle( blockDesc ), blockDesc };
-            if( getWhiteBlackTileType( bh ) != WB_NONE )
-                return;
-        }
+        if( ( m_options->coalesceWhiteBlackTiles || m_options->coalesceDuplicateTiles ) && !releaseSharedTile( blockDesc ) )
+            return;
         m_tilePool->freeTextureTiles( blockDesc );
     }
 
-    /// Return the fixed tile block for a given WhiteBlackTileType. Handle will be 0 if not present.
-    otk::TileBlockHandle getWhiteBlackTileBlock( WhiteBlackTileType wbtype ) { return m_whiteBlackTiles[wbtype]; }
-    /// Set the tile block for a given WhiteBlackTileType.
-    void setWhiteBlackTileBlock( WhiteBlackTileType wbtype, TileBlockHandle bh ) { m_whiteBlackTiles[wbtype] = bh; }
+    /// Get the shared tile block for a uniform color, adding a reference to it.  If the color has no
+    /// shared block, the given block, which the caller fills with the color, becomes the shared block
+    /// with one reference.  Returns an empty handle if the maximum number of shared tiles is reached.
+    otk::TileBlockHandle shareUniformTile( const UniformTileColor& color, const otk::TileBlockHandle& bh );
 
-    /// Return the WhiteBlackTileType for a tile.
-    WhiteBlackTileType getWhiteBlackTileType( TileBlockHandle bh )
+    /// Get the shared tile block for the given tile contents, adding a reference to it.  If no block
+    /// with the contents is shared, the given block, which the caller fills with the contents, becomes
+    /// the shared block with one reference.
+    otk::TileBlockHandle shareDuplicateTile( const TileContentHash& hash, const otk::TileBlockHandle& bh );
+
+    /// Check whether a tile block is a shared uniform tile.
+    bool isUniformTile( const otk::TileBlockDesc& blockDesc ) const
+    {
+        std::unique_lock<std::mutex> lock( m_sharedTilesMutex );
+        return m_uniformTileColors.find( blockDesc.data ) != m_uniformTileColors.end();
+    }
+
+    /// Check whether a tile block is shared, either as a uniform tile or a duplicate tile.  Shared
+    /// tiles must not be overwritten.
+    bool isSharedTile( const otk::TileBlockDesc& blockDesc ) const
     {
-        for( unsigned int i = 0; i < m_whiteBlackTiles.size(); ++i )
-        {
-            if( m_whiteBlackTiles[i] == bh )
-                return static_cast<WhiteBlackTileType>( i );
-        }
-        return WB_NONE;
+        std::unique_lock<std::mutex> lock( m_sharedTilesMutex );
+        return m_uniformTileColors.find( blockDesc.data ) != m_uniformTileColors.end()
+               || m_duplicateTileHashes.find( blockDesc.data ) != m_duplicateTileHashes.end();
     }
 
     /// Get the memory handle associated with the tileBlock.
@@ -107,17 +117,48 @@ class DeviceMemoryManager
     size_t getTextureTileMemory() const { return m_tilePool ? m_tilePool->trackedSize() : 0; }
     size_t getTotalDeviceMemory() const { return getSamplerMemory() + getDeviceContextMemory() + getTextureTileMemory(); }
 
+    /// Return the number of tiles that were mapped to a shared uniform tile instead of their own block.
+    size_t getNumTilesCoalesced() const
+    {
+        std::unique_lock<std::mutex> lock( m_sharedTilesMutex );
+        return m_numTilesCoalesced;
+    }
+
+    /// Return the number of tiles that were mapped to a shared tile with the same contents instead of their own block.
+    size_t getNumTilesDeduplicated() const
+    {
+        std::unique_lock<std::mutex> lock( m_sharedTilesMutex );
+        return m_numTilesDeduplicated;
+    }
+
   private:
     std::shared_ptr<Options> m_options;
 
     using SamplerPool = otk::MemoryPool<otk::DeviceAllocator, otk::FixedSuballocator>;
     using DeviceContextPool = otk::MemoryPool<otk::DeviceAllocator, otk::HeapSuballocator>;
-    using TilePool          = otk::MemoryPool<otk::TextureTileAllocator, otk::HeapSuballocator>;
+    using TilePool          = otk::MemoryPool<otk::TextureTileAllocator, otk::TlsfSuballocator>;
 
     SamplerPool               m_samplerPool;
     DeviceContextPool         m_deviceContextMemory;
     std::unique_ptr<TilePool> m_tilePool; // null if sparse textures disabled.
-    std::vector<otk::TileBlockHandle> m_whiteBlackTiles;
+
+    // Shared tiles, keyed by uniform color or content hash, with reverse maps from tile block to key.
+    struct SharedTile
+    {
+        otk::TileBlockHandle bh;
+        unsigned int         refCount;
+    };
+    mutable std::mutex                                                     m_sharedTilesMutex;
+    std::unordered_map<UniformTileColor, SharedTile, UniformTileColorHash> m_uniformTiles;
+    std::unordered_map<uint64_t, UniformTileColor>                         m_uniformTileColors;
+    std::unordered_map<TileContentHash, SharedTile, TileContentHashHash>   m_duplicateTiles;
+    std::unordered_map<uint64_t, TileContentHash>                          m_duplicateTileHashes;
+    size_t                                                                 m_numTilesCoalesced    = 0;
+    size_t                                                                 m_numTilesDeduplicated = 0;
+
+    // Release a reference to a block if it is a shared tile.  Returns true if the block should be
+    // freed: it isn't shared, or the last reference was released.
+    bool releaseSharedTile( const otk::TileBlockDesc& blockDesc );
 
     std::vector<DeviceContext*> m_deviceContextPool;
     std::vector<DeviceContext*> m_deviceContextFreeList;
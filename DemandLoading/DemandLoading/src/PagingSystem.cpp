@@ -12,13 +12,13 @@
 #include "RequestContext.h"
 #include "Util/CudaCallback.h"
 #include "Util/Math.h"
+#include "Util/TraceFile.h"
 
 #include <OptiXToolkit/DemandLoading/RequestProcessor.h>
 #include <OptiXToolkit/Error/ErrorCheck.h>
 #include <OptiXToolkit/Error/cuErrorCheck.h>
 
 #include <algorithm>
-#include <set>
 
 using namespace otk;
 
@@ -32,6 +32,7 @@ PagingSystem::PagingSystem( std::shared_ptr<Options> options,
     , m_deviceMemoryManager( deviceMemoryManager )
     , m_requestProcessor( requestProcessor )
     , m_pinnedMemoryPool( pinnedMemoryPool )
+    , m_pageTable( options->numPages )
 {
     OTK_ASSERT( m_options->maxFilledPages >= m_options->maxRequestedPages );
 
@@ -162,6 +163,9 @@ void PagingSystem::processRequests( const DeviceContext& context, RequestContext
     }
     pinnedRequestContext->arrayLengths[PAGE_REQUESTS_LENGTH] = numRequestedPages;
 
+    if( m_traceFile && numRequestedPages > 0 )
+        m_traceFile->recordRequests( m_traceDeviceIndex, stream, pinnedRequestContext->requestedPages, numRequestedPages );
+
     // Enqueue the requests for processing.
     // Must do this even when zero pages are requested to get proper end-to-end asynchronous communication via the Ticket mechanism.
     m_requestProcessor->addRequests( stream, id, pinnedRequestContext->requestedPages, numRequestedPages );
@@ -202,11 +206,11 @@ void PagingSystem::addMapping( unsigned int pageId, unsigned int lruVal, unsigne
 bool PagingSystem::isResident( unsigned int pageId, unsigned long long* entry )
 {
     std::unique_lock<std::mutex> lock( m_mutex );
-    const auto&                  p = m_pageTable.find( pageId );
+    const HostPageTable::Entry*  p = m_pageTable.find( pageId );
 
-    bool resident = ( p != m_pageTable.end() ) ? p->second.resident : false;
+    bool resident = ( p != nullptr ) ? p->resident : false;
     if( resident && entry )
-        *entry = p->second.entry;
+        *entry = p->entry;
     return resident;
 }
 
@@ -243,6 +247,7 @@ void PagingSystem::stageStalePages( RequestContext* requestContext, std::deque<P
 
     unsigned int numStalePages = requestContext->arrayLengths[STALE_PAGES_LENGTH];
     size_t       numStaged     = getNumStagedPages();
+    const size_t firstStaged   = stagedMappings.size();
 
     // Count backwards to stage the oldest pages first
     for( int i = static_cast<int>( numStalePages - 1 ); i >= 0; --i )
@@ -251,20 +256,30 @@ void PagingSystem::stageStalePages( RequestContext* requestContext, std::deque<P
         if( numStaged >= m_options->maxStagedPages || m_pageMappingsContext->numInvalidatedPages >= m_options->maxInvalidatedPages - 1 )
             break;
 
-        const auto& p = m_pageTable.find( sp.pageId );
-        if( p != m_pageTable.end() && p->second.resident == true && p->second.inStagedList == false )
+        HostPageTable::Entry* p = m_pageTable.find( sp.pageId );
+        if( p != nullptr && p->resident == true && p->inStagedList == false )
         {
             // Stage the page
-            stagedMappings.emplace_back( PageMapping{sp.pageId, sp.lruVal, p->second.entry} );
-            p->second.resident     = false;
-            p->second.staged       = true;
-            p->second.inStagedList = true;
+            stagedMappings.emplace_back( PageMapping{sp.pageId, sp.lruVal, p->entry} );
+            p->resident     = false;
+            p->staged       = true;
+            p->inStagedList = true;
+            ++m_numStagedPages;
 
             // Schedule the page mapping to be invalidated on the device
             m_pageMappingsContext->invalidatedPages[m_pageMappingsContext->numInvalidatedPages++] = sp.pageId;
             numStaged++;
         }
     }
+
+    if( m_traceFile && stagedMappings.size() > firstStaged )
+    {
+        std::vector<unsigned int> stagedPageIds;
+        stagedPageIds.reserve( stagedMappings.size() - firstStaged );
+        for( size_t i = firstStaged; i < stagedMappings.size(); ++i )
+            stagedPageIds.push_back( stagedMappings[i].id );
+        m_traceFile->recordStaging( m_traceDeviceIndex, stagedPageIds.data(), static_cast<unsigned int>( stagedPageIds.size() ) );
+    }
 }
 
 bool PagingSystem::freeStagedPage( PageMapping* m )
@@ -283,21 +298,22 @@ bool PagingSystem::freeStagedPage( PageMapping* m )
         // Pop the next staged page off the list
         *m = m_stagedPages[0].mappings.front();
         m_stagedPages[0].mappings.pop_front();
+        --m_numStagedPages;
 
-        const auto& p = m_pageTable.find( m->id );
-        if( p == m_pageTable.end() )
+        HostPageTable::Entry* p = m_pageTable.find( m->id );
+        if( p == nullptr )
         {
             // FIXME: Avoid the duplicate frees
             //printf("PagingSystem::freeStagedPage duplicate free %d\n", m->id);
             continue;
         }
 
-        p->second.inStagedList = false;
+        p->inStagedList = false;
 
         // If the page is still staged, return. Otherwise, go around and look for another one
-        if( p->second.staged == true )
+        if( p->staged == true )
         {
-            m_pageTable.erase( p );
+            m_pageTable.erase( m->id );
             return true;
         }
     }
@@ -333,7 +349,7 @@ void PagingSystem::addMappingBody( unsigned int pageId, unsigned int lruVal, uns
     }
 
     m_pageMappingsContext->filledPages[m_pageMappingsContext->numFilledPages++] = PageMapping{pageId, lruVal, entry};
-    m_pageTable[pageId] = HostPageTableEntry{entry, true, false, false};
+    m_pageTable.insert( pageId, HostPageTable::Entry{entry, true, true, false, false} );
 
     // If the buffer for page mappings is about to overflow, push the mappings to clear it.
     // This should not happen very often.  Usually, the mappings will be pushed from pushMappings.
@@ -352,26 +368,18 @@ bool PagingSystem::restoreMapping( unsigned int pageId )
 {
     // Mutex acquired in caller (processRequests).
 
-    const auto& p = m_pageTable.find( pageId );
-    if( p != m_pageTable.end() && p->second.staged && !p->second.resident
+    HostPageTable::Entry* p = m_pageTable.find( pageId );
+    if( p != nullptr && p->staged && !p->resident
         && m_pageMappingsContext->numFilledPages < m_pageMappingsContext->maxFilledPages )
     {
-        p->second.staged = false;
-        addMappingBody( pageId, 0, p->second.entry );
+        p->staged = false;
+        addMappingBody( pageId, 0, p->entry );
         return true;
     }
 
     return false;
 }
 
-size_t PagingSystem::getNumStagedPages()
-{
-    size_t numPages = 0;
-    for( StagedPageList s : m_stagedPages )
-        numPages += s.mappings.size();
-    return numPages;
-}
-
 void PagingSystem::pushMappingsAndInvalidations( const DeviceContext& context, CUstream stream )
 {
     // Mutex acquired in caller 
@@ -413,24 +421,24 @@ void PagingSystem::invalidatePages( unsigned int              startId,
 {
     std::unique_lock<std::mutex> lock( m_mutex );
 
-    // Remove specified page entries from the page table.
-    std::set<unsigned int> stagedInvalidatedPages;
-    auto p = m_pageTable.lower_bound( startId );
-    while( p != m_pageTable.end() && p->first < endId )
+    // Remove specified page entries from the page table. The table is walked in page id order,
+    // so the list of invalidated staged pages is sorted.
+    std::vector<unsigned int> stagedInvalidatedPages;
+    unsigned int pageId = startId;
+    for( HostPageTable::Entry* p = m_pageTable.next( pageId, endId ); p != nullptr; p = m_pageTable.next( ++pageId, endId ) )
     {
-        const unsigned int pageId = p->first;
-        const unsigned long long pageVal = p->second.entry;
+        const unsigned long long pageVal = p->entry;
 
         if( !predicate || (*predicate)( pageId, pageVal, stream ) )
         {
             OTK_ASSERT_MSG( m_pageMappingsContext->numInvalidatedPages < m_options->maxInvalidatedPages,
                             "Maximum number of invalidated pages exceeded (Options::maxInvalidPages)" );
             m_pageMappingsContext->invalidatedPages[m_pageMappingsContext->numInvalidatedPages++] = pageId;
-            if( p->second.inStagedList )
+            if( p->inStagedList )
             {
-                stagedInvalidatedPages.insert( pageId );
+                stagedInvalidatedPages.push_back( pageId );
             }
-            p = m_pageTable.erase(p);
+            m_pageTable.erase( pageId );
 
             // If the buffer for invalidations is about to overflow, push the invalidated pages to clear it. 
             // This should not happen very often.  Usually, the mappings will be pushed from pushMappings.
@@ -440,10 +448,6 @@ void PagingSystem::invalidatePages( unsigned int              startId,
                 cuStreamSynchronize( stream ); // wait for the stream because we will reuse the context
             }
         }
-        else 
-        {
-            ++p;
-        }
     }
     
     if( stagedInvalidatedPages.empty() )
@@ -456,13 +460,14 @@ void PagingSystem::invalidatePages( unsigned int              startId,
     {
         for( int i=0; i < static_cast<int>( spl.mappings.size() ); ++i )
         {
-            const unsigned int pageId = spl.mappings[i].id;
-            if( pageId >= startId && pageId < endId )
+            const unsigned int stagedPageId = spl.mappings[i].id;
+            if( stagedPageId >= startId && stagedPageId < endId )
             {
-                if( stagedInvalidatedPages.find(pageId) != stagedInvalidatedPages.end() )
+                if( std::binary_search( stagedInvalidatedPages.begin(), stagedInvalidatedPages.end(), stagedPageId ) )
                 {
                     spl.mappings[i] = spl.mappings.back();
                     spl.mappings.pop_back();
+                    --m_numStagedPages;
                     --i;
                 }
             }
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include "HostPageTable.h"
+
 #include <OptiXToolkit/DemandLoading/DeviceContext.h>  // for PageMapping
 #include <OptiXToolkit/DemandLoading/Options.h>
 #include <OptiXToolkit/DemandLoading/Ticket.h>
@@ -15,7 +17,6 @@
 #include <cuda.h>
 
 #include <deque>
-#include <map>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -30,6 +31,7 @@ class PinnedMemoryManager;
 struct RequestContext;
 class RequestProcessor;
 class TicketImpl;
+class TraceFileWriter;
 
 class PageInvalidatorPredicate
 {
@@ -79,24 +81,25 @@ class PagingSystem
     /// Invalidate a half open interval of page ids, from startId up to but not including endId, based on a predicate
     void invalidatePages( unsigned int startId, unsigned int endId, PageInvalidatorPredicate* predicate, const DeviceContext& context, CUstream stream );
 
-  private:
-    struct HostPageTableEntry
+    /// Record page requests and staged pages in the given trace file, tagged with the given device index.
+    void setTraceFile( TraceFileWriter* traceFile, unsigned int deviceIndex )
     {
-        unsigned long long entry;
-        bool               resident;      // Whether a page is considered resident on the GPU
-        bool               staged;        // Pages that are currently staged (and not restored by second chance).
-        bool               inStagedList;  // All pages that are in the staged list, whether restored or not.
-    };
+        m_traceFile        = traceFile;
+        m_traceDeviceIndex = deviceIndex;
+    }
 
+  private:
     std::shared_ptr<Options> m_options{};
     DeviceMemoryManager*     m_deviceMemoryManager{};
     RequestProcessor*        m_requestProcessor{};
+    TraceFileWriter*         m_traceFile{};
+    unsigned int             m_traceDeviceIndex = 0;
 
     otk::MemoryBlockDesc m_pageMappingsContextBlock;
     PageMappingsContext* m_pageMappingsContext; 
     otk::MemoryPool<otk::PinnedAllocator, otk::RingSuballocator>* m_pinnedMemoryPool;
 
-    std::map<unsigned int, HostPageTableEntry> m_pageTable;  // Host-side. Not copied to/from device. Used for eviction.
+    HostPageTable m_pageTable;  // Host-side. Not copied to/from device. Used for eviction.
     std::mutex m_mutex;  // Guards m_pageTable and filledPages list (see addMapping).
 
     std::mt19937 m_rng; // Used for randomized eviction when LRU table is not present.
@@ -127,6 +130,7 @@ class PagingSystem
         std::deque<PageMapping>      mappings;
     };
     std::deque<StagedPageList> m_stagedPages;
+    size_t                     m_numStagedPages = 0;  // Total number of mappings in m_stagedPages.
 
     // Pool of pinned RequestContext for processRequests function
     std::vector<RequestContext*> m_pinnedRequestContextPool;
@@ -148,7 +152,7 @@ class PagingSystem
     void stageStalePages( RequestContext* requestContext, std::deque<PageMapping>& stagedMappings );
 
     // Get the number of staged pages (ready to be freed for reuse)
-    size_t getNumStagedPages();
+    size_t getNumStagedPages() const { return m_numStagedPages; }
 
     // Allocate a PageMappingsContext in pinned memory.
     void initPageMappingsContext();
@@ -6,6 +6,7 @@
 
 #include "Util/MutexArray.h"
 
+#include <OptiXToolkit/DemandLoading/RequestPriorityPolicy.h>
 #include <OptiXToolkit/Error/ErrorCheck.h>
 #include <OptiXToolkit/Error/cuErrorCheck.h>
 
@@ -47,6 +48,17 @@ class RequestHandler
     /// Fill a request for the specified page using the given stream.
     virtual void fillRequest( CUstream /*stream*/, unsigned int /*pageId*/ ) {}
 
+    /// Fill a batch of requests for pages in this handler's range using the given stream.  The
+    /// default implementation fills each request individually.
+    virtual void fillRequests( CUstream stream, const unsigned int* pageIds, unsigned int numPageIds )
+    {
+        for( unsigned int i = 0; i < numPageIds; ++i )
+            fillRequest( stream, pageIds[i] );
+    }
+
+    /// Describe a request for the specified page, which is used to prioritize it.
+    virtual RequestInfo getRequestInfo( unsigned int pageId ) { return RequestInfo{ pageId, RequestKind::RESOURCE, 0 }; }
+
     /// Get the start page for the request handler
     unsigned int getStartPage() { return m_startPage; }
 
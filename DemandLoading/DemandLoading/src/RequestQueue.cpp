@@ -1,9 +1,10 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #include "RequestQueue.h"
 #include "TicketImpl.h"
+#include "Util/Math.h"
 
 #include <OptiXToolkit/Error/cuErrorCheck.h>
 
@@ -11,57 +12,171 @@
 
 namespace demandLoading {
 
+const unsigned int RequestQueue::MAX_CHUNK_SIZE;
+
+RequestQueue::RequestQueue( unsigned int maxQueueSize, unsigned int numWorkers )
+    : m_maxQueueSize( maxQueueSize )
+{
+    numWorkers = std::max( numWorkers, 1u );
+    m_queues.reserve( numWorkers );
+    for( unsigned int i = 0; i < numWorkers; ++i )
+        m_queues.emplace_back( new WorkerQueue );
+}
+
 void RequestQueue::shutDown()
 {
     {
-        std::unique_lock<std::mutex> lock( m_mutex );
+        std::unique_lock<std::mutex> lock( m_waitMutex );
         m_isShutDown = true;
+        m_tasks.clear();
     }
     m_requestAvailable.notify_all();
 }
 
-bool RequestQueue::popOrWait( PageRequest* requestPtr )
+unsigned int RequestQueue::size() const
 {
-    // Wait until the queue is non-empty or destroyed.
-    std::unique_lock<std::mutex> lock( m_mutex );
-    m_requestAvailable.wait( lock, [this] { return !m_requests.empty() || m_isShutDown; } );
+    return static_cast<unsigned int>( std::max( m_numRequests.load(), 0 ) );
+}
 
-    if( m_isShutDown )
+bool RequestQueue::tryPop( unsigned int queueIndex, RequestChunk* chunk )
+{
+    WorkerQueue&                 queue = *m_queues[queueIndex];
+    std::unique_lock<std::mutex> lock( queue.mutex );
+    if( queue.chunks.empty() )
         return false;
 
-    *requestPtr = std::move( m_requests.front() );
-    m_requests.pop_front();
-
+    *chunk = std::move( queue.chunks.front() );
+    queue.chunks.pop_front();
+    --m_numChunks;
+    m_numRequests -= static_cast<int>( chunk->size() );
     return true;
 }
 
-void RequestQueue::push( const unsigned int* pageIds, unsigned int numPageIds, Ticket ticket )
+void RequestQueue::insertChunk( std::deque<RequestChunk>& chunks, RequestChunk&& chunk )
 {
-    std::unique_lock<std::mutex> lock( m_mutex );
+    // Chunks are usually pushed in priority order, so check the back of the deque first.
+    if( chunks.empty() || chunks.back().priority <= chunk.priority )
+    {
+        chunks.push_back( std::move( chunk ) );
+        return;
+    }
+    const auto pos = std::upper_bound( chunks.begin(), chunks.end(), chunk.priority,
+                                       []( unsigned int priority, const RequestChunk& c ) { return priority < c.priority; } );
+    chunks.insert( pos, std::move( chunk ) );
+}
+
+unsigned int RequestQueue::numTasks() const
+{
+    std::unique_lock<std::mutex> lock( m_waitMutex );
+    return static_cast<unsigned int>( m_tasks.size() );
+}
 
+void RequestQueue::pushTask( std::function<void()> task )
+{
+    {
+        std::unique_lock<std::mutex> lock( m_waitMutex );
+        if( m_isShutDown )
+            return;
+        m_tasks.push_back( std::move( task ) );
+    }
+    m_requestAvailable.notify_one();
+}
+
+bool RequestQueue::popOrWait( unsigned int workerIndex, RequestChunk* chunk, std::function<void()>* task )
+{
+    const unsigned int numQueues = static_cast<unsigned int>( m_queues.size() );
+    workerIndex %= numQueues;
+
+    while( true )
+    {
+        if( m_isShutDown )
+            return false;
+
+        // Pop from the worker's own deque first, then steal from the others.
+        for( unsigned int i = 0; i < numQueues; ++i )
+        {
+            if( tryPop( ( workerIndex + i ) % numQueues, chunk ) )
+                return true;
+        }
+
+        // Run a background task if there are no requests.
+        std::unique_lock<std::mutex> lock( m_waitMutex );
+        if( task != nullptr && !m_tasks.empty() && !m_isShutDown )
+        {
+            *task = std::move( m_tasks.front() );
+            m_tasks.pop_front();
+            return true;
+        }
+
+        // Wait until a chunk (or a task) is pushed or the queue is shut down.
+        ++m_numWaiting;
+        m_requestAvailable.wait( lock, [this, task] { return m_numChunks > 0 || m_isShutDown || ( task != nullptr && !m_tasks.empty() ); } );
+        --m_numWaiting;
+    }
+}
+
+unsigned int RequestQueue::push( const unsigned int* pageIds, unsigned int numPageIds, Ticket ticket, const unsigned int* priorities, unsigned int numOtherTasks )
+{
     // Don't push requests if the queue is shut down.
     if( m_isShutDown )
         numPageIds = 0;
-    
+
     // Don't overfill the queue
-    if( m_requests.size() >= m_maxQueueSize )
+    const unsigned int queueSize = size();
+    if( queueSize >= m_maxQueueSize )
         numPageIds = 0;
-    else if( numPageIds + m_requests.size() > m_maxQueueSize )
-        numPageIds = static_cast<unsigned int>( m_maxQueueSize - m_requests.size() );
+    else if( numPageIds + queueSize > m_maxQueueSize )
+        numPageIds = m_maxQueueSize - queueSize;
 
     // Update the ticket, now that the number of tasks is known.
-    TicketImpl::getImpl( ticket )->update( numPageIds );
+    TicketImpl::getImpl( ticket )->update( numPageIds + numOtherTasks );
 
     if( numPageIds == 0 )
-        return;
+        return 0;
 
-    for( unsigned int i = 0; i < numPageIds; ++i )
+    // Divide each run of requests with the same priority into chunks.
+    std::shared_ptr<RequestBatch> batch( new RequestBatch( pageIds, numPageIds, std::move( ticket ) ) );
+    const unsigned int            numQueues = static_cast<unsigned int>( m_queues.size() );
+    std::vector<RequestChunk>     chunks;
+    for( unsigned int runBegin = 0, runEnd = 0; runBegin < numPageIds; runBegin = runEnd )
     {
-        m_requests.emplace_back( pageIds[i], ticket );
+        const unsigned int priority = priorities ? priorities[runBegin] : 0;
+        runEnd                      = priorities ? runBegin + 1 : numPageIds;
+        while( runEnd < numPageIds && priorities[runEnd] == priority )
+            ++runEnd;
+
+        const unsigned int chunkSize = std::min( idivCeil( runEnd - runBegin, numQueues ), MAX_CHUNK_SIZE );
+        for( unsigned int begin = runBegin; begin < runEnd; begin += chunkSize )
+            chunks.emplace_back( batch, begin, std::min( begin + chunkSize, runEnd ), priority );
     }
 
-    // Notify any threads in popOrWait().
-    m_requestAvailable.notify_all();
+    // The chunks are distributed round-robin over the worker deques.
+    const unsigned int numChunks  = static_cast<unsigned int>( chunks.size() );
+    const unsigned int firstQueue = m_nextQueue.fetch_add( numChunks ) % numQueues;
+    for( unsigned int i = 0; i < numQueues && i < numChunks; ++i )
+    {
+        WorkerQueue&                 queue = *m_queues[( firstQueue + i ) % numQueues];
+        std::unique_lock<std::mutex> lock( queue.mutex );
+        for( unsigned int chunkIndex = i; chunkIndex < numChunks; chunkIndex += numQueues )
+            insertChunk( queue.chunks, std::move( chunks[chunkIndex] ) );
+    }
+    m_numRequests += static_cast<int>( numPageIds );
+    m_numChunks += static_cast<int>( numChunks );
+
+    // Wake one waiting thread per chunk.
+    unsigned int numWaiting;
+    {
+        std::unique_lock<std::mutex> lock( m_waitMutex );
+        numWaiting = m_numWaiting;
+    }
+    if( numChunks >= numWaiting )
+        m_requestAvailable.notify_all();
+    else
+    {
+        for( unsigned int i = 0; i < numChunks; ++i )
+            m_requestAvailable.notify_one();
+    }
+    return numPageIds;
 }
 
 }  // namespace demandLoading
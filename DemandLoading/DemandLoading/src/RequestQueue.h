@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -11,51 +11,108 @@
 #include <atomic>
 #include <condition_variable>
 #include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <vector>
 
 namespace demandLoading {
 
-/// A page request contains a page id, which is a index into the page table.  It also holds a shared
-/// pointer to a Ticket, which must be notified when the request has been filled.
-struct PageRequest
+/// A batch of page requests, which holds the page ids pushed by a single call to RequestQueue::push.
+/// The batch holds the only queue-side reference to the Ticket that must be notified as the requests
+/// are filled.
+struct RequestBatch
 {
-    unsigned int pageId{};
-    Ticket       ticket;
+    std::vector<unsigned int> pageIds;
+    Ticket                    ticket;
+
+    /// The CUDA context of the ticket's stream, which is determined by the first worker to process
+    /// a chunk of the batch (processRequests is not permitted to make CUDA API calls).
+    std::atomic<CUcontext> context{};
+
+    RequestBatch( const unsigned int* pageIds_, unsigned int numPageIds, Ticket ticket_ )
+        : pageIds( pageIds_, pageIds_ + numPageIds )
+        , ticket( std::move( ticket_ ) )
+    {
+    }
+};
+
+/// A chunk is a contiguous range of the page requests in a batch that share the same priority.
+/// Chunks are the unit of work that is popped from the RequestQueue by worker threads.
+struct RequestChunk
+{
+    std::shared_ptr<RequestBatch> batch;
+    unsigned int                  begin{};
+    unsigned int                  end{};
+    unsigned int                  priority{};  // Lower values are popped first.
 
     // A constructor is necessary for emplace_back.
-    PageRequest( unsigned int pageId_, Ticket ticket_ )
-        : pageId( pageId_ )
-        , ticket( ticket_ )
+    RequestChunk( std::shared_ptr<RequestBatch> batch_, unsigned int begin_, unsigned int end_, unsigned int priority_ = 0 )
+        : batch( std::move( batch_ ) )
+        , begin( begin_ )
+        , end( end_ )
+        , priority( priority_ )
     {
     }
 
     // Default constructor
-    PageRequest() = default;
+    RequestChunk() = default;
+
+    /// Get the page ids of the chunk.
+    const unsigned int* pageIds() const { return batch->pageIds.data() + begin; }
+
+    /// Get the number of page requests in the chunk.
+    unsigned int size() const { return end - begin; }
 };
 
+/// The RequestQueue holds page requests for a pool of worker threads.  Each worker has its own deque
+/// of request chunks, guarded by its own mutex, which is ordered by chunk priority.  A worker pops
+/// chunks from the front of its own deque, and when that is empty it steals the most urgent chunk
+/// from the other workers' deques.  Since each batch is distributed round-robin over the deques,
+/// the most urgent requests of a batch are processed first.  Pushing a batch only wakes as many
+/// idle workers as there are new chunks.  The queue also holds background tasks, which workers run
+/// only when there are no requests, so that they never delay page requests.
 class RequestQueue
 {
   public:
-    /// Construct request queue.
-    RequestQueue( unsigned int maxQueueSize )
-        : m_maxQueueSize( maxQueueSize )
-    {
-    }
-
-    /// Pop a request, waiting if necessary until the queue is non-empty or shut down.  Returns
-    /// false if the queue was shut down.
-    bool popOrWait( PageRequest* request );
-
-    /// Push a batch of page requests.  Notifies any threads waiting in popOrWait().  Updates the
-    /// given Ticket with the number of requests, and retains it for notifications as requests are
-    /// filled.
-    void push( const unsigned int* pageIds, unsigned int numPageIds, Ticket ticket );
+    /// The maximum number of page requests in a chunk.  Smaller batches are divided into smaller
+    /// chunks so that they are spread across all the workers.
+    static const unsigned int MAX_CHUNK_SIZE = 16;
+
+    /// Construct request queue for the given number of worker threads.
+    RequestQueue( unsigned int maxQueueSize, unsigned int numWorkers = 1 );
+
+    /// Pop a chunk of requests for the specified worker, waiting if necessary until the queue is
+    /// non-empty or shut down.  If a task is given, a background task is popped instead when there
+    /// are no requests, leaving the chunk empty.  Returns false if the queue was shut down.
+    bool popOrWait( unsigned int workerIndex, RequestChunk* chunk, std::function<void()>* task = nullptr );
+
+    /// Push a batch of page requests.  Notifies threads waiting in popOrWait().  Updates the given
+    /// Ticket with the number of requests plus the specified number of other tasks (which the caller
+    /// must notify), and retains it for notifications as requests are filled.  If priorities are
+    /// specified, the requests must be sorted by priority; requests that do not fit in the queue are
+    /// dropped from the end of the batch.  Returns the number of requests that were pushed.
+    unsigned int push( const unsigned int* pageIds,
+                       unsigned int        numPageIds,
+                       Ticket              ticket,
+                       const unsigned int* priorities    = nullptr,
+                       unsigned int        numOtherTasks = 0 );
+
+    /// Push a background task.  Notifies one thread waiting in popOrWait(), so every worker of a
+    /// queue with tasks should accept them.  Tasks that have not been popped when the queue is shut
+    /// down are discarded.
+    void pushTask( std::function<void()> task );
+
+    /// Get the number of background tasks in the queue (not including those that have been popped).
+    unsigned int numTasks() const;
 
     /// Shut down the queue, signalling any waiting threads to exit.  Clients must call shutDown()
     /// and join with any waiting threads before invoking the RequestQueue destructor.
     void shutDown();
 
+    /// Get the number of page requests in the queue (not including those that have been popped).
+    unsigned int size() const;
+
     /// Not copyable.
     RequestQueue( const RequestQueue& ) = delete;
 
@@ -63,11 +120,31 @@ class RequestQueue
     RequestQueue& operator=( const RequestQueue& ) = delete;
 
   private:
-    std::deque<PageRequest> m_requests;
-    std::mutex              m_mutex;
-    std::condition_variable m_requestAvailable;
-    unsigned int            m_maxQueueSize;
-    bool                    m_isShutDown = false;
+    struct WorkerQueue
+    {
+        std::mutex               mutex;
+        std::deque<RequestChunk> chunks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+    unsigned int                              m_maxQueueSize;
+    std::atomic<unsigned int>                 m_nextQueue{0};  // Round-robin position for push.
+
+    // The counts are updated after the per-worker deques, so they can be transiently negative.
+    std::atomic<int> m_numChunks{0};
+    std::atomic<int> m_numRequests{0};
+
+    mutable std::mutex                m_waitMutex;  // Guards m_numWaiting and m_tasks; serializes waits with notifications.
+    std::condition_variable           m_requestAvailable;
+    unsigned int                      m_numWaiting = 0;
+    std::deque<std::function<void()>> m_tasks;
+    std::atomic<bool>                 m_isShutDown{false};
+
+    // Try to pop the most urgent chunk from the specified worker's deque.
+    bool tryPop( unsigned int queueIndex, RequestChunk* chunk );
+
+    // Insert a chunk into a deque (which must be locked), keeping the deque ordered by priority.
+    static void insertChunk( std::deque<RequestChunk>& chunks, RequestChunk&& chunk );
 };
 
 }  // namespace demandLoading
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "RequestScheduler.h"
+
+#include "CoarseFirstPriorityPolicy.h"
+#include "PageTableManager.h"
+#include "RequestHandler.h"
+#include "RequestQueue.h"
+#include "TicketImpl.h"
+
+#include <algorithm>
+
+namespace demandLoading {
+
+RequestScheduler::RequestScheduler( PageTableManager* pageTableManager )
+    : m_pageTableManager( pageTableManager )
+    , m_policy( new CoarseFirstPriorityPolicy )
+{
+}
+
+void RequestScheduler::setPriorityPolicy( std::shared_ptr<RequestPriorityPolicy> policy )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_policy = std::move( policy );
+}
+
+void RequestScheduler::schedule( const unsigned int* pageIds, unsigned int numPageIds, Ticket ticket, RequestQueue* queue )
+{
+    std::shared_ptr<TicketImpl>  ticketImpl = TicketImpl::getImpl( ticket );
+    std::unique_lock<std::mutex> lock( m_mutex );
+
+    // Rank the requests for pages that are not in flight, and mark them as in flight.  Requests for
+    // pages that are already in flight (or repeated in this batch) are dropped.
+    m_ranked.clear();
+    m_dropped.clear();
+    for( unsigned int i = 0; i < numPageIds; ++i )
+    {
+        const unsigned int pageId = pageIds[i];
+        if( !m_inFlight.emplace( pageId, std::vector<std::shared_ptr<TicketImpl>>() ).second )
+        {
+            m_dropped.push_back( pageId );
+            continue;
+        }
+        unsigned int priority = 0;
+        if( m_policy )
+        {
+            RequestHandler* handler = m_pageTableManager->getRequestHandler( pageId );
+            RequestInfo info = handler ? handler->getRequestInfo( pageId ) : RequestInfo{ pageId, RequestKind::RESOURCE, 0 };
+            priority = m_policy->priority( info );
+        }
+        m_ranked.push_back( RankedRequest{ priority, pageId } );
+    }
+
+    // Sort the requests by priority, then by page id, so that requests for the same resource (e.g.
+    // the tiles of a texture) are adjacent and can be processed as a batch.
+    if( m_policy )
+    {
+        std::sort( m_ranked.begin(), m_ranked.end(), []( const RankedRequest& a, const RankedRequest& b ) {
+            return a.priority < b.priority || ( a.priority == b.priority && a.pageId < b.pageId );
+        } );
+    }
+    m_pageIds.resize( m_ranked.size() );
+    m_priorities.resize( m_ranked.size() );
+    for( size_t i = 0; i < m_ranked.size(); ++i )
+    {
+        m_pageIds[i]    = m_ranked[i].pageId;
+        m_priorities[i] = m_ranked[i].priority;
+    }
+
+    // Push the ranked requests.  The ticket also tracks the dropped requests, which are finished
+    // when the corresponding in-flight requests are finished.  Workers cannot finish the new
+    // requests until the mutex is released.
+    const unsigned int numRanked = static_cast<unsigned int>( m_pageIds.size() );
+    const unsigned int numPushed = queue->push( m_pageIds.data(), numRanked, std::move( ticket ), m_priorities.data(),
+                                                static_cast<unsigned int>( m_dropped.size() ) );
+    for( unsigned int pageId : m_dropped )
+        m_inFlight[pageId].push_back( ticketImpl );
+
+    // Requests that did not fit in the queue are not in flight.
+    for( unsigned int i = numPushed; i < numRanked; ++i )
+    {
+        auto it = m_inFlight.find( m_pageIds[i] );
+        for( std::shared_ptr<TicketImpl>& waiting : it->second )
+            waiting->notify();
+        m_inFlight.erase( it );
+    }
+}
+
+void RequestScheduler::finish( const unsigned int* pageIds, unsigned int numPageIds )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    for( unsigned int i = 0; i < numPageIds; ++i )
+    {
+        auto it = m_inFlight.find( pageIds[i] );
+        if( it == m_inFlight.end() )
+            continue;
+        for( std::shared_ptr<TicketImpl>& waiting : it->second )
+            waiting->notify();
+        m_inFlight.erase( it );
+    }
+}
+
+void RequestScheduler::clear()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_inFlight.clear();
+}
+
+unsigned int RequestScheduler::getNumInFlight() const
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    return static_cast<unsigned int>( m_inFlight.size() );
+}
+
+}  // namespace demandLoading
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <OptiXToolkit/DemandLoading/RequestPriorityPolicy.h>
+#include <OptiXToolkit/DemandLoading/Ticket.h>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace demandLoading {
+
+class PageTableManager;
+class RequestQueue;
+class TicketImpl;
+
+/// The RequestScheduler sits between the RequestProcessor and its RequestQueue.  It ranks each batch
+/// of requests with a RequestPriorityPolicy and drops requests for pages that are already in flight
+/// (i.e. queued or being filled).  The ticket of a dropped request is notified when the in-flight
+/// request is finished, so a ticket still tracks the completion of all the requests in its batch.
+class RequestScheduler
+{
+  public:
+    /// Construct request scheduler, which uses the given PageTableManager to find the RequestHandler
+    /// that describes each request.
+    RequestScheduler( PageTableManager* pageTableManager );
+
+    /// Set the policy that ranks requests.  The default is a CoarseFirstPriorityPolicy.  A null
+    /// policy preserves the order of the requests.
+    void setPriorityPolicy( std::shared_ptr<RequestPriorityPolicy> policy );
+
+    /// Rank a batch of requests, drop duplicates and requests that are already in flight, and push
+    /// the remainder onto the given queue, ordered by priority and page id.  Updates the ticket with
+    /// the number of requests it tracks.
+    void schedule( const unsigned int* pageIds, unsigned int numPageIds, Ticket ticket, RequestQueue* queue );
+
+    /// Record that the requests for the given pages have been processed.  Notifies the tickets of
+    /// any requests for these pages that were dropped while they were in flight.
+    void finish( const unsigned int* pageIds, unsigned int numPageIds );
+
+    /// Forget all in-flight requests, e.g. after the request queue is shut down.
+    void clear();
+
+    /// Get the number of pages in flight.
+    unsigned int getNumInFlight() const;
+
+  private:
+    PageTableManager*                      m_pageTableManager;
+    std::shared_ptr<RequestPriorityPolicy> m_policy;
+
+    // Tickets of dropped requests, keyed by the in-flight page id.
+    std::unordered_map<unsigned int, std::vector<std::shared_ptr<TicketImpl>>> m_inFlight;
+    mutable std::mutex                                                       m_mutex;
+
+    // Scratch space for schedule(), which is guarded by m_mutex.
+    struct RankedRequest
+    {
+        unsigned int priority;
+        unsigned int pageId;
+    };
+    std::vector<RankedRequest> m_ranked;
+    std::vector<unsigned int>  m_pageIds;
+    std::vector<unsigned int>  m_priorities;
+    std::vector<unsigned int>  m_dropped;
+};
+
+}  // namespace demandLoading
@@ -21,6 +21,9 @@ class CascadeRequestHandler : public RequestHandler
     /// Fill a request for the specified page on the stream.
     void fillRequest( CUstream stream, unsigned int pageId ) override;
 
+    /// Cascade requests resize a sampler, so they are ranked as SAMPLER requests.
+    RequestInfo getRequestInfo( unsigned int pageId ) override { return RequestInfo{ pageId, RequestKind::SAMPLER, 0 }; }
+
     /// Load or reload a page on the given stream.
     void loadPage( CUstream stream, unsigned int pageId, bool reloadIfResident );
 
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -9,6 +9,7 @@
 #include "Textures/TextureRequestHandler.h"
 #include "Util/Math.h"
 #include "Util/Stopwatch.h"
+#include "Util/TraceFile.h"
 
 #include <OptiXToolkit/DemandLoading/TileIndexing.h>
 #include <OptiXToolkit/Error/ErrorCheck.h>
@@ -50,6 +51,19 @@ DemandTextureImpl::DemandTextureImpl( unsigned int id, DemandTextureImpl* master
     masterTexture->addVariantId( id );
 }
 
+bool DemandTextureImpl::setMasterTexture( DemandTextureImpl* masterTexture )
+{
+    std::unique_lock<std::mutex> lock( m_initMutex );
+    if( m_isInitialized || m_masterTexture )
+        return false;
+
+    m_masterTexture = masterTexture;
+    m_image         = masterTexture->m_image;
+    m_isOpen        = false;
+    masterTexture->addVariantId( m_id );
+    return true;
+}
+
 DemandTextureImpl::~DemandTextureImpl()
 {
     if( m_sampler.extraData )
@@ -361,6 +375,23 @@ bool DemandTextureImpl::readTile( unsigned int mipLevel, unsigned int tileX, uns
     return m_image->readTile( tileBuffer, mipLevel, { tileX, tileY, getTileWidth(), getTileHeight() }, stream );
 }
 
+bool DemandTextureImpl::readTiles( unsigned int mipLevel, const uint2* tileCoords, char* const* tileBuffers, unsigned int numTiles,
+                                   size_t tileBufferSize, CUstream stream ) const
+{
+    OTK_ASSERT( m_isInitialized );
+    OTK_ASSERT( mipLevel < m_info.numMipLevels );
+
+    const unsigned int bytesPerTile  = ( getTileWidth() * getTileHeight() * getBitsPerPixel( getInfo() ) ) / BITS_PER_BYTE;
+    OTK_ASSERT_MSG( bytesPerTile <= tileBufferSize, "Maximum tile size exceeded" );
+    (void)bytesPerTile;  // silence unused variable warning
+    (void)tileBufferSize;
+
+    std::vector<imageSource::Tile> tiles( numTiles );
+    for( unsigned int i = 0; i < numTiles; ++i )
+        tiles[i] = imageSource::Tile{ tileCoords[i].x, tileCoords[i].y, getTileWidth(), getTileHeight() };
+    return m_image->readTiles( tileBuffers, mipLevel, tiles.data(), numTiles, stream );
+}
+
 // Tiles can be filled concurrently.
 void DemandTextureImpl::fillTile( CUstream                     stream,
                                   unsigned int                 mipLevel,
@@ -466,6 +497,9 @@ void DemandTextureImpl::open()
         m_image->open( &m_info );
         OTK_ASSERT( m_info.isValid );
         m_isOpen = true;
+
+        if( m_loader->getTraceFile() )
+            m_loader->getTraceFile()->recordTextureInfo( m_loader->getTraceDeviceIndex(), m_id, m_info );
     }
 }
 
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -127,6 +127,11 @@ class DemandTextureImpl : public DemandTexture
     bool readTile( unsigned int mipLevel, unsigned int tileX, unsigned int tileY, char* tileBuffer,
                    size_t tileBufferSize, CUstream stream ) const;
 
+    /// Read the specified tiles of a mip level into the given buffers, as a single batch.
+    /// Throws an exception on error.
+    bool readTiles( unsigned int mipLevel, const uint2* tileCoords, char* const* tileBuffers, unsigned int numTiles,
+                    size_t tileBufferSize, CUstream stream ) const;
+
     /// Fill the device tile backing storage for a texture tile and with the given data.
     void fillTile( CUstream                     stream,
                    unsigned int                 mipLevel,
@@ -194,6 +199,10 @@ class DemandTextureImpl : public DemandTexture
     /// Get the master texture for a texture variant
     DemandTextureImpl* getMasterTexture() { return m_masterTexture; }
 
+    /// Make this texture a variant of the given master texture, which has an identical image.
+    /// Returns false if this texture has already been initialized.
+    bool setMasterTexture( DemandTextureImpl* masterTexture );
+
     /// Add a variant id to this (assumes this is a master texture)
     void addVariantId( unsigned int id ) { m_variantTextureIds.push_back( id ); }
 
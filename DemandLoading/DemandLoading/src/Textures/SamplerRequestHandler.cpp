@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -63,6 +63,8 @@ void SamplerRequestHandler::loadPage( CUstream stream, unsigned int pageId, bool
     };
 
     DemandTextureImpl* texture = getTextureForSamplerId( samplerId );
+    if( m_loader->getOptions().coalesceDuplicateImages )
+        m_loader->linkDuplicateTexture( samplerId );
     texture->open();
 
     // Load base color if the page is for a base color
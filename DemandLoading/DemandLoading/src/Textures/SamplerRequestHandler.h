@@ -23,6 +23,9 @@ class SamplerRequestHandler : public RequestHandler
     /// Fill a request for the specified page using the given stream.  
     void fillRequest( CUstream stream, unsigned int pageId ) override;
 
+    /// Sampler and base color requests are ranked as SAMPLER requests.
+    RequestInfo getRequestInfo( unsigned int pageId ) override { return RequestInfo{ pageId, RequestKind::SAMPLER, 0 }; }
+
     /// Load or reload a page on the given stream
     void loadPage( CUstream stream, unsigned int pageId, bool reloadIfResident = true );
 
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -9,11 +9,18 @@
 #include "Textures/DemandTextureImpl.h"
 #include "TransferBufferDesc.h"
 #include "Util/NVTXProfiling.h"
+#include "Util/TraceFile.h"
 
 #include <OptiXToolkit/DemandLoading/DemandLoadLogger.h>
 #include <OptiXToolkit/DemandLoading/TileIndexing.h>
 
-#include "WhiteBlackTileCheck.h"
+#include "TileContentHash.h"
+#include "UniformTileCheck.h"
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <vector>
 
 using namespace otk;
 
@@ -24,6 +31,19 @@ void TextureRequestHandler::fillRequest( CUstream stream, unsigned int pageId )
    loadPage( stream, pageId, false );
 }
 
+RequestInfo TextureRequestHandler::getRequestInfo( unsigned int pageId )
+{
+    if( pageId == m_startPage && m_texture->isMipmapped() )
+        return RequestInfo{ pageId, RequestKind::MIP_TAIL, 0 };
+
+    // The sampler is invariant once it's created, and tile requests never occur before the sampler is created.
+    unsigned int mipLevel;
+    unsigned int tileX;
+    unsigned int tileY;
+    unpackTileIndex( m_texture->getSampler(), pageId - m_startPage, mipLevel, tileX, tileY );
+    return RequestInfo{ pageId, RequestKind::TILE, mipLevel };
+}
+
 void TextureRequestHandler::loadPage( CUstream stream, unsigned int pageId, bool reloadIfResident )
 {
     // Try to make sure there are free tiles to handle the request
@@ -55,9 +75,140 @@ void TextureRequestHandler::loadPage( CUstream stream, unsigned int pageId, bool
         fillTileRequest( stream, pageId, bh );
 }
 
+// Upper bound on the tiles that fillRequests prepares at once.  Each prepared tile holds a tile block
+// and a transfer buffer until it is filled, so larger requests are filled in chunks of this size.
+static const unsigned int MAX_TILES_PER_BATCH = 16;
+
+void TextureRequestHandler::fillRequests( CUstream stream, const unsigned int* pageIds, unsigned int numPageIds )
+{
+    if( numPageIds < 2 )
+    {
+        RequestHandler::fillRequests( stream, pageIds, numPageIds );
+        return;
+    }
+    SCOPED_NVTX_RANGE_FUNCTION_NAME();
+
+    // Fill the mip tail first (it is read separately), then the tiles.  The mip tail has the lowest page id,
+    // and the tile pages are locked in increasing order, so concurrent batches cannot deadlock.
+    std::vector<unsigned int> sortedPageIds( pageIds, pageIds + numPageIds );
+    std::sort( sortedPageIds.begin(), sortedPageIds.end() );
+    sortedPageIds.erase( std::unique( sortedPageIds.begin(), sortedPageIds.end() ), sortedPageIds.end() );
+
+    size_t first = 0;
+    if( sortedPageIds[0] == m_startPage && m_texture->isMipmapped() )
+    {
+        loadPage( stream, m_startPage, false );
+        first = 1;
+    }
+    for( size_t begin = first; begin < sortedPageIds.size(); begin += MAX_TILES_PER_BATCH )
+    {
+        const size_t count = std::min<size_t>( MAX_TILES_PER_BATCH, sortedPageIds.size() - begin );
+        fillTileRequests( stream, &sortedPageIds[begin], count );
+    }
+}
+
+void TextureRequestHandler::fillTileRequests( CUstream stream, const unsigned int* pageIds, size_t numPageIds )
+{
+    // Try to make sure there are free tiles to handle the requests.  This is done before locking
+    // the pages, because freeing staged tiles locks the pages it unmaps.
+    m_loader->freeStagedTiles( stream );
+
+    std::vector<std::unique_ptr<MutexArrayLock>> locks;
+    std::vector<TileRequest>                     requests;
+    locks.reserve( numPageIds );
+    requests.reserve( numPageIds );
+    for( size_t i = 0; i < numPageIds; ++i )
+    {
+        const unsigned int pageId = pageIds[i];
+        locks.emplace_back( new MutexArrayLock( m_mutex.get(), pageId - m_startPage ) );
+
+        // Do nothing if the page is resident.
+        if( m_loader->getPagingSystem()->isResident( pageId ) )
+            continue;
+
+        TileRequest request;
+        if( prepareTileRequest( stream, pageId, TileBlockHandle{0, 0}, request ) )
+            requests.push_back( request );
+    }
+
+    // Read the tiles of each mip level as a batch.  The tile indices are sorted by mip level.
+    // Requests before 'finished' have been handed to finishTileRequest.
+    std::vector<uint2> tileCoords;
+    std::vector<char*> tileBuffers;
+    size_t             finished = 0;
+    try
+    {
+        for( size_t begin = 0, end = 0; begin < requests.size(); begin = end )
+        {
+            const unsigned int mipLevel = requests[begin].mipLevel;
+            tileCoords.clear();
+            tileBuffers.clear();
+            for( end = begin; end < requests.size() && requests[end].mipLevel == mipLevel; ++end )
+            {
+                tileCoords.push_back( make_uint2( requests[end].tileX, requests[end].tileY ) );
+                tileBuffers.push_back( reinterpret_cast<char*>( requests[end].transferBuffer.memoryBlock.ptr ) );
+            }
+
+            if( m_texture->readTiles( mipLevel, tileCoords.data(), tileBuffers.data(), static_cast<unsigned int>( end - begin ),
+                                      TILE_SIZE_IN_BYTES, stream ) )
+            {
+                while( finished < end )
+                    finishTileRequest( stream, requests[finished++], true );
+                continue;
+            }
+
+            // The batch read failed as a whole, so read the tiles one at a time to find out which tiles can be filled.
+            while( finished < end )
+            {
+                TileRequest& request   = requests[finished];
+                const bool   satisfied = m_texture->readTile( request.mipLevel, request.tileX, request.tileY,
+                                                              reinterpret_cast<char*>( request.transferBuffer.memoryBlock.ptr ),
+                                                              request.transferBuffer.memoryBlock.size, stream );
+                ++finished;
+                finishTileRequest( stream, request, satisfied );
+            }
+        }
+    }
+    catch( const std::exception& e )
+    {
+        // Release the tile blocks and transfer buffers of the tiles that were not filled.
+        while( finished < requests.size() )
+            finishTileRequest( stream, requests[finished++], false );
+
+        std::stringstream ss;
+        ss << "readTiles call failed: " << e.what() << ": " << __FILE__ << " (" << __LINE__ << ")";
+        throw std::runtime_error( ss.str().c_str() );
+    }
+}
+
 void TextureRequestHandler::fillTileRequest( CUstream stream, unsigned int pageId, TileBlockHandle bh )
 {
     SCOPED_NVTX_RANGE_FUNCTION_NAME();
+
+    TileRequest request;
+    if( !prepareTileRequest( stream, pageId, bh, request ) )
+        return;
+
+    // Read the tile (possibly from disk) into the transfer buffer.
+    bool satisfied;
+    try
+    {
+        satisfied = m_texture->readTile( request.mipLevel, request.tileX, request.tileY,
+                                         reinterpret_cast<char*>( request.transferBuffer.memoryBlock.ptr ),
+                                         request.transferBuffer.memoryBlock.size, stream );
+    }
+    catch( const std::exception& e )
+    {
+        std::stringstream ss;
+        ss << "readTile call failed: " << e.what() << ": " << __FILE__ << " (" << __LINE__ << ")";
+        throw std::runtime_error( ss.str().c_str() );
+    }
+
+    finishTileRequest( stream, request, satisfied );
+}
+
+bool TextureRequestHandler::prepareTileRequest( CUstream stream, unsigned int pageId, TileBlockHandle bh, TileRequest& request )
+{
     DeviceMemoryManager* deviceMemoryManager = m_loader->getDeviceMemoryManager();
 
     // Get the texture sampler.  This is thread safe because the sampler is invariant once it's created,
@@ -66,95 +217,73 @@ void TextureRequestHandler::fillTileRequest( CUstream stream, unsigned int pageI
 
     // Unpack tile index into miplevel and tile coordinates.
     const unsigned int tileIndex = pageId - m_startPage;
-    unsigned int       mipLevel;
-    unsigned int       tileX;
-    unsigned int       tileY;
-    unpackTileIndex( sampler, tileIndex, mipLevel, tileX, tileY );
+    request.pageId               = pageId;
+    unpackTileIndex( sampler, tileIndex, request.mipLevel, request.tileX, request.tileY );
 
     DL_LOG(5, "[Page " + std::to_string(pageId) + "] Tile(tex=" + std::to_string(m_texture->getId())
-        + ", mip=" + std::to_string(mipLevel) + ", x=" + std::to_string(tileX) + ", y=" + std::to_string(tileY) + ")");
+        + ", mip=" + std::to_string(request.mipLevel) + ", x=" + std::to_string(request.tileX) + ", y=" + std::to_string(request.tileY) + ")");
 
-    // A coalesced white/black tile needs new backing storage if replaced by a non white/black tile.
-    bool coalesceWhiteBlackTiles = m_loader->getOptions().coalesceWhiteBlackTiles;
-    if( coalesceWhiteBlackTiles && bh.handle != 0 && deviceMemoryManager->getWhiteBlackTileType(bh) != WB_NONE )
-        bh = TileBlockHandle{0, 0};
+    // A shared tile can't be overwritten, so the page gets new backing storage, and its reference
+    // to the shared tile is released once the page is remapped.
+    const Options& options    = m_loader->getOptions();
+    bool           shareTiles = options.coalesceWhiteBlackTiles || options.coalesceDuplicateTiles;
+    if( shareTiles && bh.handle != 0 && deviceMemoryManager->isSharedTile( bh.block ) )
+    {
+        request.replacedSharedTile = bh.block;
+        bh                         = TileBlockHandle{0, 0};
+    }
 
     // Make sure to have device memory for the tile
-    bool useNewBlock = bh.block.isBad();
-    if( useNewBlock )
+    request.useNewBlock = bh.block.isBad();
+    if( request.useNewBlock )
     {
         bh = deviceMemoryManager->allocateTileBlock( TILE_SIZE_IN_BYTES );
         if( bh.block.isBad() )
         {
             // If the allocation failed, set max memory to current size to prevent repeat requests.
             m_loader->setMaxTextureMemory( deviceMemoryManager->getTextureTileMemory() );
-            return;
+            return false;
         }
     }
+    request.bh = bh;
 
     // Allocate a transfer buffer.
-    TransferBufferDesc transferBuffer = m_loader->allocateTransferBuffer( m_texture->getFillType(), TILE_SIZE_IN_BYTES, stream );
-    if( transferBuffer.memoryBlock.size == 0 && useNewBlock )
+    request.transferBuffer = m_loader->allocateTransferBuffer( m_texture->getFillType(), TILE_SIZE_IN_BYTES, stream );
+    if( request.transferBuffer.memoryBlock.size == 0 && request.useNewBlock )
     {
         deviceMemoryManager->freeTileBlock( bh.block );
-        return;
+        return false;
     }
+    return true;
+}
 
-    // Read the tile (possibly from disk) into the transfer buffer.
-    bool satisfied;
-    try
-    {
-        satisfied = m_texture->readTile( mipLevel, tileX, tileY, reinterpret_cast<char*>( transferBuffer.memoryBlock.ptr ),
-                                         transferBuffer.memoryBlock.size, stream );
-    }
-    catch( const std::exception& e )
-    {
-        std::stringstream ss;
-        ss << "readTile call failed: " << e.what() << ": " << __FILE__ << " (" << __LINE__ << ")";
-        throw std::runtime_error( ss.str().c_str() );
-    }
+void TextureRequestHandler::finishTileRequest( CUstream stream, TileRequest& request, bool satisfied )
+{
+    DeviceMemoryManager* deviceMemoryManager = m_loader->getDeviceMemoryManager();
+    TransferBufferDesc&  transferBuffer      = request.transferBuffer;
+    TileBlockHandle&     bh                  = request.bh;
 
     if( satisfied )
     {
-        // Coalesce white/black tiles
-        bool evictable = true;
-        WhiteBlackTileType wbtype = WB_NONE;
-        if( coalesceWhiteBlackTiles && useNewBlock && m_texture->getFillType() == CU_MEMORYTYPE_HOST )
-        {
-            char* tbuff = reinterpret_cast<char*>( transferBuffer.memoryBlock.ptr );
-            const imageSource::TextureInfo& info = m_texture->getInfo();
-            wbtype = classifyTileAsWhiteOrBlack( tbuff, info.format, info.numChannels );
-            if( wbtype != WB_NONE )
-            {
-                evictable = false;
-                if( deviceMemoryManager->getWhiteBlackTileBlock( wbtype ).handle != 0 )
-                {
-                    deviceMemoryManager->freeTileBlock( bh.block );
-                    m_loader->freeTransferBuffer( transferBuffer, stream );
-                    otk::TileBlockHandle cbh = deviceMemoryManager->getWhiteBlackTileBlock( wbtype );
-                    m_texture->mapTile( stream, mipLevel, tileX, tileY, cbh.handle, cbh.block.offset() );
-                    m_loader->setPageTableEntry( pageId, evictable, cbh.block.data );
-                    return;
-                }
-                else
-                {
-                    deviceMemoryManager->setWhiteBlackTileBlock( wbtype, bh );
-                }
-            }
-        }
+        TraceFileWriter::addBytesRead( TILE_SIZE_IN_BYTES );
+
+        // Map the tile to shared backing storage if another tile has the same contents.
+        if( request.useNewBlock && m_texture->getFillType() == CU_MEMORYTYPE_HOST && mapSharedTile( stream, request ) )
+            return;
 
         // Copy data from transfer buffer to the sparse texture on the device
         m_texture->fillTile( stream,
-                             mipLevel, tileX, tileY,                                     // Tile to fill
+                             request.mipLevel, request.tileX, request.tileY,             // Tile to fill
                              reinterpret_cast<char*>( transferBuffer.memoryBlock.ptr ),  // Src buffer
                              transferBuffer.memoryType, TILE_SIZE_IN_BYTES,              // Src type and size
                              bh.handle, bh.block.offset()                                // Dest
                              );
 
         // Add a mapping for the tile, which will be sent to the device in pushMappings().
-        if( useNewBlock )
+        if( request.useNewBlock )
         {
-            m_loader->setPageTableEntry( pageId, evictable, static_cast<unsigned long long>( bh.block.data ) );
+            m_loader->setPageTableEntry( request.pageId, true, static_cast<unsigned long long>( bh.block.data ) );
+            releaseReplacedSharedTile( request );
         }
     }
     else
@@ -165,6 +294,42 @@ void TextureRequestHandler::fillTileRequest( CUstream stream, unsigned int pageI
     m_loader->freeTransferBuffer( transferBuffer, stream );
 }
 
+bool TextureRequestHandler::mapSharedTile( CUstream stream, TileRequest& request )
+{
+    DeviceMemoryManager*            deviceMemoryManager = m_loader->getDeviceMemoryManager();
+    const Options&                  options             = m_loader->getOptions();
+    const imageSource::TextureInfo& info                = m_texture->getInfo();
+    const char*                     tbuff               = reinterpret_cast<const char*>( request.transferBuffer.memoryBlock.ptr );
+
+    // Uniform-color tiles are found without hashing.  Other tiles, and uniform tiles that don't fit in
+    // the uniform tile table, are matched by a hash of their contents (see TileContentHash for the
+    // collision bound).  Shared tiles are reference counted, so they stay evictable.
+    TileBlockHandle  cbh{0, 0};
+    UniformTileColor color;
+    if( options.coalesceWhiteBlackTiles && getUniformTileColor( tbuff, info.format, info.numChannels, color ) )
+        cbh = deviceMemoryManager->shareUniformTile( color, request.bh );
+    if( cbh.handle == 0 && options.coalesceDuplicateTiles )
+        cbh = deviceMemoryManager->shareDuplicateTile( hashTileContent( tbuff, TILE_SIZE_IN_BYTES, info.format, info.numChannels ), request.bh );
+
+    // If the tile wasn't shared, or its block became the shared block, it is filled as usual.
+    if( cbh.handle == 0 || cbh == request.bh )
+        return false;
+
+    deviceMemoryManager->freeTileBlock( request.bh.block );
+    m_loader->freeTransferBuffer( request.transferBuffer, stream );
+    m_texture->mapTile( stream, request.mipLevel, request.tileX, request.tileY, cbh.handle, cbh.block.offset() );
+    m_loader->setPageTableEntry( request.pageId, true, cbh.block.data );
+    releaseReplacedSharedTile( request );
+    return true;
+}
+
+void TextureRequestHandler::releaseReplacedSharedTile( TileRequest& request )
+{
+    if( request.replacedSharedTile.data != 0 )
+        m_loader->getDeviceMemoryManager()->freeTileBlock( request.replacedSharedTile );
+    request.replacedSharedTile = otk::TileBlockDesc( 0 );
+}
+
 void TextureRequestHandler::fillMipTailRequest( CUstream stream, unsigned int pageId, TileBlockHandle bh )
 {
     SCOPED_NVTX_RANGE_FUNCTION_NAME();
@@ -210,6 +375,8 @@ void TextureRequestHandler::fillMipTailRequest( CUstream stream, unsigned int pa
 
     if( satisfied )
     {
+        TraceFileWriter::addBytesRead( mipTailSize );
+
         // Copy data from the transfer buffer to the sparse texture on the device
         m_texture->fillMipTail( stream,
                                 reinterpret_cast<char*>( transferBuffer.memoryBlock.ptr ),  // Src buffer
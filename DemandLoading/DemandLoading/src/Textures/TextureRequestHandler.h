@@ -1,10 +1,11 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #pragma once
 
 #include "RequestHandler.h"
+#include "TransferBufferDesc.h"
 #include <OptiXToolkit/Memory/MemoryBlockDesc.h>
 
 #include <atomic>
@@ -30,6 +31,13 @@ class TextureRequestHandler : public RequestHandler
     /// Fill a request for the specified page using the given stream.  
     void fillRequest( CUstream stream, unsigned int pageId ) override;
 
+    /// Fill a batch of requests for pages of this texture, reading the tiles of each mip level with
+    /// a single call to ImageSource::readTiles.  Large batches are filled in bounded chunks.
+    void fillRequests( CUstream stream, const unsigned int* pageIds, unsigned int numPageIds ) override;
+
+    /// Describe a request for the mip tail or a tile of the texture.
+    RequestInfo getRequestInfo( unsigned int pageId ) override;
+
     // Load or reload a page
     void loadPage( CUstream stream, unsigned int pageId, bool reloadIfResident );
 
@@ -46,7 +54,25 @@ class TextureRequestHandler : public RequestHandler
     DemandTextureImpl* m_texture = nullptr;
     DemandLoaderImpl*  m_loader = nullptr;
 
+    // A tile request whose device memory and transfer buffer have been allocated, awaiting tile data.
+    struct TileRequest
+    {
+        unsigned int         pageId;
+        unsigned int         mipLevel;
+        unsigned int         tileX;
+        unsigned int         tileY;
+        otk::TileBlockHandle bh{0, 0};
+        bool                 useNewBlock;
+        TransferBufferDesc   transferBuffer;
+        otk::TileBlockDesc   replacedSharedTile{ 0 };  // shared tile to release once the page is remapped
+    };
+
+    void fillTileRequests( CUstream stream, const unsigned int* pageIds, size_t numPageIds );
     void fillTileRequest( CUstream stream, unsigned int pageId, otk::TileBlockHandle bh );
+    bool prepareTileRequest( CUstream stream, unsigned int pageId, otk::TileBlockHandle bh, TileRequest& request );
+    void finishTileRequest( CUstream stream, TileRequest& request, bool satisfied );
+    bool mapSharedTile( CUstream stream, TileRequest& request );
+    void releaseReplacedSharedTile( TileRequest& request );
     void fillMipTailRequest( CUstream stream, unsigned int pageId, otk::TileBlockHandle bh );
 };
 
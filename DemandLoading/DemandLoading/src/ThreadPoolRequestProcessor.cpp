@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -7,6 +7,7 @@
 #include "DemandLoaderImpl.h"
 #include "RequestHandler.h"
 #include "TicketImpl.h"
+#include "Util/TraceFile.h"
 
 #include <OptiXToolkit/Error/ErrorCheck.h>
 #include <OptiXToolkit/Error/cuErrorCheck.h>
@@ -16,6 +17,7 @@ namespace demandLoading {
 ThreadPoolRequestProcessor::ThreadPoolRequestProcessor( std::shared_ptr<PageTableManager> pageTableManager, const Options& options )
     : m_pageTableManager( std::move( pageTableManager ) )
     , m_options( options )
+    , m_scheduler( m_pageTableManager.get() )
 {
     m_requests.reset( new RequestQueue( options.maxRequestQueueSize ) );
 }
@@ -25,14 +27,14 @@ void ThreadPoolRequestProcessor::start()
     if( m_started )
         return;
 
-    m_requests.reset( new RequestQueue( m_options.maxRequestQueueSize ) );
     unsigned int maxThreads = m_options.maxThreads;
     if( maxThreads == 0 )
         maxThreads = std::thread::hardware_concurrency();
+    m_requests.reset( new RequestQueue( m_options.maxRequestQueueSize, maxThreads ) );
     m_threads.reserve( maxThreads );
     for( unsigned int i = 0; i < maxThreads; ++i )
     {
-        m_threads.emplace_back( &ThreadPoolRequestProcessor::worker, this );
+        m_threads.emplace_back( &ThreadPoolRequestProcessor::worker, this, i );
     }
     m_started = true;
 }
@@ -52,6 +54,7 @@ void ThreadPoolRequestProcessor::stop()
         thread.join();
     }
     m_requests.reset();
+    m_scheduler.clear();
     m_threads.clear();
     m_started = false;
 }
@@ -67,18 +70,25 @@ void ThreadPoolRequestProcessor::addRequests( CUstream /*stream*/, unsigned int
     // We won't issue this id again, so we can discard it from the map.
     m_tickets.erase( it );
 
-    // Filter the batch of requests, and add it to the main request list with the ticket to track their progress
+    // Filter the batch of requests, and schedule it on the main request list with the ticket to track their progress
     if( numPageIds > 0 && m_requestFilter )
     {
         std::vector<unsigned int> filteredRequests = m_requestFilter->filter( pageIds, numPageIds );
-        m_requests->push( &filteredRequests[0], static_cast<unsigned int>( filteredRequests.size() ), ticket );
+        m_scheduler.schedule( filteredRequests.data(), static_cast<unsigned int>( filteredRequests.size() ), ticket, m_requests.get() );
     }
     else
     {
-        m_requests->push( pageIds, numPageIds, ticket );
+        m_scheduler.schedule( pageIds, numPageIds, ticket, m_requests.get() );
     }
 }
 
+void ThreadPoolRequestProcessor::addTask( std::function<void()> task )
+{
+    std::unique_lock<std::mutex> lock( m_ticketsMutex );
+    start();
+    m_requests->pushTask( std::move( task ) );
+}
+
 void ThreadPoolRequestProcessor::setTicket( unsigned int id, Ticket ticket )
 {
     std::unique_lock<std::mutex> lock( m_ticketsMutex );
@@ -86,34 +96,88 @@ void ThreadPoolRequestProcessor::setTicket( unsigned int id, Ticket ticket )
     m_tickets[id] = ticket;
 }
 
-void ThreadPoolRequestProcessor::worker()
+void ThreadPoolRequestProcessor::setBatchContext( RequestBatch& batch )
+{
+    // The context of the ticket's stream is looked up once per batch.
+    CUcontext context = batch.context.load();
+    if( context == nullptr )
+    {
+        OTK_ERROR_CHECK( cuStreamGetCtx( TicketImpl::getImpl( batch.ticket )->getStream(), &context ) );
+        batch.context = context;
+    }
+
+    CUcontext current;
+    OTK_ERROR_CHECK( cuCtxGetCurrent( &current ) );
+    if( current != context )
+        OTK_ERROR_CHECK( cuCtxSetCurrent( context ) );
+}
+
+void ThreadPoolRequestProcessor::worker( unsigned int workerIndex )
 {
     try
     {
-        PageRequest request;
+        RequestChunk                 chunk;
+        std::function<void()>        task;
+        std::vector<RequestHandler*> handlers;
+        std::vector<unsigned int>    group;
         while( true )
         {
-            // Pop a request from the queue, waiting if necessary until the queue is non-empty or shut down.
-            if( !m_requests->popOrWait( &request ) )
+            // Pop a chunk of requests from the queue, waiting if necessary until the queue is non-empty or shut down.
+            // When there are no requests, a background task is popped instead.
+            if( !m_requests->popOrWait( workerIndex, &chunk, &task ) )
                 return;  // Exit thread when queue is shut down.
-
-            // Ask the PageTableManager for the request handler associated with the range of pages in
-            // which the request occurred.
-            RequestHandler* handler = m_pageTableManager->getRequestHandler( request.pageId );
-            OTK_ASSERT_MSG( handler != nullptr, "Invalid page requested (no associated handler)" );
+            if( task )
+            {
+                task();
+                task = nullptr;
+                continue;
+            }
 
             // Use the CUDA context associated with the stream in the ticket.
-            std::shared_ptr<TicketImpl>& ticket = TicketImpl::getImpl( request.ticket );
-            CUcontext                    context;
-            OTK_ERROR_CHECK( cuStreamGetCtx( ticket->getStream(), &context ) );
-            OTK_ERROR_CHECK( cuCtxSetCurrent( context ) );
-
-            // Process the request.  Page table updates are accumulated in the PagingSystem.
-            handler->fillRequest( ticket->getStream(), request.pageId );
+            setBatchContext( *chunk.batch );
+            std::shared_ptr<TicketImpl>& ticket = TicketImpl::getImpl( chunk.batch->ticket );
 
-            // Notify the associated Ticket that the request has been filled.
-            ticket->notify();
-            ticket.reset();
+            // Ask the PageTableManager for the request handler associated with the range of pages in
+            // which each request occurred.
+            handlers.resize( chunk.size() );
+            for( unsigned int i = 0; i < chunk.size(); ++i )
+            {
+                handlers[i] = m_pageTableManager->getRequestHandler( chunk.pageIds()[i] );
+                OTK_ASSERT_MSG( handlers[i] != nullptr, "Invalid page requested (no associated handler)" );
+            }
+
+            // Group the requests by handler (e.g. by texture), and process each group as a batch, which
+            // allows the handler to coalesce reads.  Page table updates are accumulated in the PagingSystem.
+            for( unsigned int i = 0; i < chunk.size(); ++i )
+            {
+                RequestHandler* handler = handlers[i];
+                if( handler == nullptr )
+                    continue;
+                group.clear();
+                for( unsigned int j = i; j < chunk.size(); ++j )
+                {
+                    if( handlers[j] == handler )
+                    {
+                        group.push_back( chunk.pageIds()[j] );
+                        handlers[j] = nullptr;
+                    }
+                }
+                const uint64_t startTime = m_traceFile ? m_traceFile->getTime() : 0;
+                TraceFileWriter::takeBytesRead();
+                handler->fillRequests( ticket->getStream(), group.data(), static_cast<unsigned int>( group.size() ) );
+                if( m_traceFile )
+                {
+                    m_traceFile->recordFill( m_traceDeviceIndex, group.data(), static_cast<unsigned int>( group.size() ), startTime,
+                                             m_traceFile->getTime() - startTime, TraceFileWriter::takeBytesRead() );
+                }
+            }
+
+            // The pages are no longer in flight, which notifies the tickets of requests that were dropped
+            // as duplicates.  Then notify the associated Ticket that the requests have been filled, and
+            // release the batch.
+            m_scheduler.finish( chunk.pageIds(), chunk.size() );
+            ticket->notify( chunk.size() );
+            chunk = RequestChunk();
         }
     }
     catch( const std::exception& e )
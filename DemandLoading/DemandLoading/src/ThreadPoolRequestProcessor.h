@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -8,9 +8,11 @@
 #include <OptiXToolkit/DemandLoading/RequestProcessor.h>
 
 #include "RequestQueue.h"
+#include "RequestScheduler.h"
 
 #include <cuda.h>
 
+#include <functional>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -20,6 +22,7 @@
 namespace demandLoading {
 
 class PageTableManager;
+class TraceFileWriter;
 
 class ThreadPoolRequestProcessor : public RequestProcessor
 {
@@ -35,12 +38,27 @@ class ThreadPoolRequestProcessor : public RequestProcessor
     /// Add a batch of page requests to the request queue.
     void addRequests( CUstream stream, unsigned id, const unsigned int* pageIds, unsigned int numPageIds ) override;
 
+    /// Add a background task, which the worker threads run when there are no page requests to
+    /// process, starting the threads if necessary.  The task must catch its own exceptions.  Tasks
+    /// that haven't run are discarded when the request processor is stopped.
+    void addTask( std::function<void()> task );
+
     /// Add a request filter to preprocess batches of requests
     void setRequestFilter( std::shared_ptr<RequestFilter> requestFilter ) { m_requestFilter = requestFilter; }
 
+    /// Set the policy that ranks the requests in each batch.  A null policy preserves the order of the requests.
+    void setRequestPriorityPolicy( std::shared_ptr<RequestPriorityPolicy> policy ) { m_scheduler.setPriorityPolicy( policy ); }
+
     /// Set the ticket that will track requests with the given ticket id
     void setTicket( unsigned int id, Ticket ticket );
 
+    /// Record filled requests in the given trace file, tagged with the given device index.
+    void setTraceFile( TraceFileWriter* traceFile, unsigned int deviceIndex )
+    {
+        m_traceFile        = traceFile;
+        m_traceDeviceIndex = deviceIndex;
+    }
+
 private:
     std::shared_ptr<PageTableManager> m_pageTableManager;
     std::unique_ptr<RequestQueue>     m_requests;
@@ -50,12 +68,18 @@ private:
     Options                           m_options;
     bool                              m_started = false;
     std::shared_ptr<RequestFilter>    m_requestFilter;
+    RequestScheduler                  m_scheduler;
+    TraceFileWriter*                  m_traceFile = nullptr;
+    unsigned int                      m_traceDeviceIndex = 0;
 
     /// Start processing requests.
     void start();
 
     // Per-thread worker function.
-    void worker();
+    void worker( unsigned int workerIndex );
+
+    // Make the CUDA context of the given batch's stream current, if it isn't already.
+    static void setBatchContext( RequestBatch& batch );
 };
 
 }  // namespace demandLoading
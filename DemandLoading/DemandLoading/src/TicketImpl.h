@@ -77,15 +77,15 @@ class TicketImpl
         }
     }
 
-    /// Decrement the number of tasks remaining, notifying any waiting threads
-    /// when all the tasks are done.
-    void notify()
+    /// Decrement the number of tasks remaining by the given number of finished tasks, notifying any
+    /// waiting threads when all the tasks are done.
+    void notify( unsigned int numTasksDone = 1 )
     {
         std::unique_lock<std::mutex> lock( m_mutex );
 
         // Atomically decrement the number of tasks remaining.
-        OTK_ASSERT( m_numTasksRemaining > 0 );
-        --m_numTasksRemaining;
+        OTK_ASSERT( m_numTasksRemaining >= static_cast<int>( numTasksDone ) );
+        m_numTasksRemaining -= static_cast<int>( numTasksDone );
 
         // If there are no tasks remaining, notify any threads waiting on the condition variable.
         // It's not necessary to acquire the mutex.  Redundant notifications are OK.
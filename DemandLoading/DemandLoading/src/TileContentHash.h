@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <OptiXToolkit/ShaderUtil/ContentHash.h>
+
+#include <cuda.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace demandLoading {
+
+/// A 128-bit hash of the contents of a tile, with the format of its texels.  Tiles with equal
+/// hashes and formats are treated as identical, so that they can share backing storage, without
+/// comparing their texels: the device copy of a shared tile has no host copy to compare against.
+/// For n distinct tiles, the probability that two of them share a hash is about n^2 / 2^129, so
+/// even 2^32 distinct tiles (256 TiB of texels) alias with probability below 2^-65.
+struct TileContentHash
+{
+    CUarray_format format;
+    unsigned int   numChannels;
+    uint64_t       value[2];
+};
+
+inline bool operator==( const TileContentHash& a, const TileContentHash& b )
+{
+    return a.format == b.format && a.numChannels == b.numChannels && a.value[0] == b.value[0] && a.value[1] == b.value[1];
+}
+
+/// Hash function for TileContentHash.  The value is already well mixed.
+struct TileContentHashHash
+{
+    size_t operator()( const TileContentHash& hash ) const { return std::hash<uint64_t>()( hash.value[0] ); }
+};
+
+/// Hash the contents of a tile with otk::ContentHasher.
+inline TileContentHash hashTileContent( const char* tile, size_t size, CUarray_format format, unsigned int numChannels )
+{
+    TileContentHash hash;
+    hash.format      = format;
+    hash.numChannels = numChannels;
+    otk::hashContent( tile, size, hash.value );
+    return hash;
+}
+
+}  // namespace demandLoading
@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <OptiXToolkit/ImageSource/TextureInfo.h>
+#include <OptiXToolkit/Memory/MemoryBlockDesc.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+namespace demandLoading {
+
+/// The color of a tile whose texels (or compressed blocks) are all the same.  The texel is
+/// replicated to fill 16 bytes, so that equal colors of the same format have equal values.
+struct UniformTileColor
+{
+    CUarray_format format;
+    unsigned int   numChannels;
+    uint64_t       value[2];
+};
+
+inline bool operator==( const UniformTileColor& a, const UniformTileColor& b )
+{
+    return a.format == b.format && a.numChannels == b.numChannels && a.value[0] == b.value[0] && a.value[1] == b.value[1];
+}
+
+/// Hash function for UniformTileColor.
+struct UniformTileColorHash
+{
+    size_t operator()( const UniformTileColor& color ) const
+    {
+        const uint64_t key = ( color.value[0] * 0x9E3779B97F4A7C15ULL ) ^ ( color.value[1] + ( color.value[1] << 6 ) )
+                             ^ ( ( static_cast<uint64_t>( color.format ) << 32 ) | color.numChannels );
+        return std::hash<uint64_t>()( key );
+    }
+};
+
+/// Get the size of the element that repeats in a uniform tile: a texel, or a 4x4 block of a
+/// block-compressed format.  Returns 0 if the size doesn't divide 16 bytes.
+inline unsigned int getUniformTileElementSize( CUarray_format format, unsigned int numChannels )
+{
+    imageSource::TextureInfo info{};
+    info.format      = format;
+    info.numChannels = numChannels;
+
+    const unsigned int bitsPerPixel = imageSource::getBitsPerPixel( info );
+    const unsigned int elementSize  = imageSource::isBcFormat( format ) ? bitsPerPixel * 16 / imageSource::BITS_PER_BYTE :
+                                                                          bitsPerPixel / imageSource::BITS_PER_BYTE;
+    return ( elementSize > 0 && elementSize <= 16 && 16 % elementSize == 0 ) ? elementSize : 0;
+}
+
+/// Check whether a tile has a uniform color, in any format and number of channels, returning the
+/// color if so.  The tile is compared in a single pass with its first texel replicated over a
+/// 4 KB span, using memcmp, which is vectorized by the C library.  Non-uniform tiles are usually
+/// rejected in the first span.
+inline bool getUniformTileColor( const char* tile, CUarray_format format, unsigned int numChannels, UniformTileColor& color )
+{
+    const unsigned int elementSize = getUniformTileElementSize( format, numChannels );
+    if( elementSize == 0 )
+        return false;
+
+    uint64_t value[2];
+    for( unsigned int i = 0; i < sizeof( value ); i += elementSize )
+        memcpy( reinterpret_cast<char*>( value ) + i, tile, elementSize );
+
+    const size_t spanSize = 4096;
+    uint64_t     pattern[spanSize / sizeof( uint64_t )];
+    for( size_t i = 0; i < spanSize / sizeof( uint64_t ); i += 2 )
+    {
+        pattern[i]     = value[0];
+        pattern[i + 1] = value[1];
+    }
+    for( size_t span = 0; span < otk::TILE_SIZE_IN_BYTES; span += spanSize )
+    {
+        if( memcmp( &tile[span], pattern, spanSize ) != 0 )
+            return false;
+    }
+
+    color.format      = format;
+    color.numChannels = numChannels;
+    color.value[0]    = value[0];
+    color.value[1]    = value[1];
+    return true;
+}
+
+}  // namespace demandLoading
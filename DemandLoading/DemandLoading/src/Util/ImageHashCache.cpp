@@ -0,0 +1,144 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "Util/ImageHashCache.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+namespace demandLoading {
+
+namespace {
+
+const char IMAGE_HASH_CACHE_MAGIC[] = "OTKIMAGEHASH";
+
+}  // namespace
+
+std::shared_ptr<ImageHashCache> ImageHashCache::open( const std::string& filename )
+{
+    static std::mutex                                            cachesMutex;
+    static std::map<std::string, std::weak_ptr<ImageHashCache>> caches;
+
+    std::unique_lock<std::mutex>    lock( cachesMutex );
+    std::shared_ptr<ImageHashCache> cache = caches[filename].lock();
+    if( !cache )
+    {
+        cache.reset( new ImageHashCache( filename ) );
+        caches[filename] = cache;
+    }
+    return cache;
+}
+
+ImageHashCache::ImageHashCache( const std::string& filename )
+    : m_filename( filename )
+{
+    load();
+}
+
+ImageHashCache::~ImageHashCache()
+{
+    save();
+}
+
+void ImageHashCache::load()
+{
+    std::ifstream file( m_filename );
+    std::string   magic;
+    unsigned int  version = 0;
+    if( !( file >> magic >> version ) || magic != IMAGE_HASH_CACHE_MAGIC || version != IMAGE_HASH_CACHE_VERSION )
+        return;
+
+    // Each line holds the hash, time and size, followed by the path, which can contain spaces.
+    std::string line;
+    while( std::getline( file, line ) )
+    {
+        std::istringstream stream( line );
+        Entry              entry;
+        std::string        path;
+        if( !( stream >> std::hex >> entry.hash >> std::dec >> entry.modifiedTime >> entry.fileSize ) )
+            continue;
+        stream.get();
+        if( std::getline( stream, path ) && !path.empty() )
+            m_entries[path] = entry;
+    }
+}
+
+bool ImageHashCache::save()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    if( !m_isModified )
+        return true;
+
+    // Write a temporary file and rename it, so that a failed write doesn't lose the old cache.
+    const std::string tempFilename = m_filename + ".tmp";
+    {
+        std::ofstream file( tempFilename, std::ios::trunc );
+        file << IMAGE_HASH_CACHE_MAGIC << ' ' << IMAGE_HASH_CACHE_VERSION << '\n';
+        for( const auto& it : m_entries )
+            file << std::hex << it.second.hash << std::dec << ' ' << it.second.modifiedTime << ' ' << it.second.fileSize << ' ' << it.first << '\n';
+        if( !file.flush() )
+            return false;
+    }
+    std::remove( m_filename.c_str() );
+    if( std::rename( tempFilename.c_str(), m_filename.c_str() ) != 0 )
+        return false;
+
+    m_isModified = false;
+    return true;
+}
+
+bool ImageHashCache::find( const std::string& path, unsigned long long* hash )
+{
+    long long          modifiedTime;
+    unsigned long long fileSize;
+    if( !getFileStamp( path, &modifiedTime, &fileSize ) )
+        return false;
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    auto                         it = m_entries.find( path );
+    if( it == m_entries.end() || it->second.modifiedTime != modifiedTime || it->second.fileSize != fileSize )
+        return false;
+    *hash = it->second.hash;
+    return true;
+}
+
+void ImageHashCache::insert( const std::string& path, unsigned long long hash )
+{
+    Entry entry;
+    entry.hash = hash;
+    if( !getFileStamp( path, &entry.modifiedTime, &entry.fileSize ) )
+        return;
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_entries[path] = entry;
+    m_isModified    = true;
+}
+
+size_t ImageHashCache::size() const
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    return m_entries.size();
+}
+
+bool ImageHashCache::getFileStamp( const std::string& path, long long* modifiedTime, unsigned long long* fileSize )
+{
+#ifdef _WIN32
+    struct _stat64 status;
+    if( _stat64( path.c_str(), &status ) != 0 )
+        return false;
+#else
+    struct stat status;
+    if( stat( path.c_str(), &status ) != 0 )
+        return false;
+#endif
+    *modifiedTime = static_cast<long long>( status.st_mtime );
+    *fileSize     = static_cast<unsigned long long>( status.st_size );
+    return true;
+}
+
+}  // namespace demandLoading
@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+/// \file ImageHashCache.h
+/// A persistent cache of image hashes, which allows duplicate images to be found without reading them.
+///
+/// The cache is a text file.  The first line holds "OTKIMAGEHASH" and a version number, and each
+/// following line holds the hash of an image file (in hex), the file's modification time and size,
+/// and its path.  A cached hash is used only if the file's time and size are unchanged.
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace demandLoading {
+
+/// The image hash cache version.  It must be incremented when ImageSource::getHash changes.
+const unsigned int IMAGE_HASH_CACHE_VERSION = 1;
+
+class ImageHashCache
+{
+  public:
+    /// Get the cache stored in the given file, loading it if it isn't already loaded.  Demand loaders
+    /// with the same cache file share it.  An unreadable or outdated file starts an empty cache.
+    static std::shared_ptr<ImageHashCache> open( const std::string& filename );
+
+    /// Construct a cache, loading it from the given file.
+    explicit ImageHashCache( const std::string& filename );
+
+    /// The destructor saves the cache if it has changed.
+    ~ImageHashCache();
+
+    /// Find the hash of the image file at the given path.  Returns false if the file isn't in the
+    /// cache, or has changed since it was hashed.
+    bool find( const std::string& path, unsigned long long* hash );
+
+    /// Record the hash of the image file at the given path.
+    void insert( const std::string& path, unsigned long long hash );
+
+    /// Save the cache if it has changed, replacing the file.  Returns false on error.
+    bool save();
+
+    /// Get the number of entries in the cache.
+    size_t size() const;
+
+  private:
+    struct Entry
+    {
+        long long          modifiedTime;
+        unsigned long long fileSize;
+        unsigned long long hash;
+    };
+
+    mutable std::mutex           m_mutex;
+    std::string                  m_filename;
+    std::map<std::string, Entry> m_entries;
+    bool                         m_isModified = false;
+
+    void load();
+
+    // Get the modification time and size of a file.  Returns false if the file doesn't exist.
+    static bool getFileStamp( const std::string& path, long long* modifiedTime, unsigned long long* fileSize );
+};
+
+}  // namespace demandLoading
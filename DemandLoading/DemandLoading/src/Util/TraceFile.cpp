@@ -1,100 +1,345 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
-#include "TraceFile.h"
+#include "Util/TraceFile.h"
 #include "DemandLoaderImpl.h"
 
-#include <OptiXToolkit/DemandLoading/Options.h>
-#include <OptiXToolkit/DemandLoading/TextureDescriptor.h>
+#include <OptiXToolkit/DemandLoading/DeviceContext.h>
 #include <OptiXToolkit/Error/ErrorCheck.h>
 #include <OptiXToolkit/Error/cuErrorCheck.h>
-#include <OptiXToolkit/ImageSource/EXRReader.h>
+#include <OptiXToolkit/ImageSource/ImageSource.h>
 
-#include <cassert>
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
 
 namespace demandLoading {
 
-enum RecordType
+namespace {
+
+const char     TRACE_FILE_MAGIC[8]  = {'O', 'T', 'K', 'T', 'R', 'A', 'C', 'E'};
+const char     TRACE_INDEX_MAGIC[8] = {'O', 'T', 'K', 'I', 'N', 'D', 'E', 'X'};
+const uint32_t INDEX_MARKER         = 0xFFFFFFFFu;  // Stored in place of a block codec before the index.
+
+// Records are buffered until a block holds this many bytes.
+const size_t TRACE_BLOCK_SIZE = 1 << 20;
+
+// Block codec ids.  A codec's format never changes once it has been written to trace files; a
+// change to the format takes a new id, so that older traces remain readable.  See TraceFile.h.
+enum BlockCodec : uint32_t
+{
+    CODEC_NONE  = 0,  // Records stored uncompressed.
+    CODEC_LZ_V1 = 1   // Records compressed with compressLZ.
+};
+
+// Each block starts with this header, followed by the (possibly compressed) records.
+struct BlockHeader
 {
-    OPTIONS,
-    TEXTURE,
-    REQUESTS
+    uint32_t codec;
+    uint32_t uncompressedSize;
+    uint32_t compressedSize;
+    uint32_t reserved;
+    uint64_t firstTimestamp;
 };
 
-// Check that the current CUDA context matches the one associated with the given stream
-// and return the associated device index.
-static unsigned int getDeviceIndex( CUstream /*stream*/ )
+void writeVarint( std::vector<uint8_t>& out, uint64_t value )
+{
+    while( value >= 0x80 )
+    {
+        out.push_back( static_cast<uint8_t>( value | 0x80 ) );
+        value >>= 7;
+    }
+    out.push_back( static_cast<uint8_t>( value ) );
+}
+
+// Read a varint from data, advancing position.  Throws if the varint runs past the end.
+uint64_t readVarint( const uint8_t* data, size_t size, size_t& position )
+{
+    uint64_t value = 0;
+    for( unsigned int shift = 0; shift < 64; shift += 7 )
+    {
+        if( position >= size )
+            throw std::runtime_error( "Truncated record in trace file" );
+        const uint8_t byte = data[position++];
+        value |= static_cast<uint64_t>( byte & 0x7f ) << shift;
+        if( ( byte & 0x80 ) == 0 )
+            return value;
+    }
+    throw std::runtime_error( "Invalid varint in trace file" );
+}
+
+// Signed deltas are zigzag encoded so that small negative values are small varints.
+uint64_t zigzag( int64_t value )
 {
-    // Get the current CUDA context.
-    CUcontext cudaContext, streamContext;
-    OTK_ERROR_CHECK( cuCtxGetCurrent( &cudaContext ) );
-    OTK_ERROR_CHECK( cuCtxGetCurrent( &streamContext ) );
-    OTK_ASSERT_MSG( cudaContext == streamContext,
-                       "The current CUDA context must match the one associated with the given stream" );
+    return ( static_cast<uint64_t>( value ) << 1 ) ^ static_cast<uint64_t>( value >> 63 );
+}
 
-    // Get the device index from the CUDA context.
-    CUdevice device;
-    OTK_ERROR_CHECK( cuCtxGetDevice( &device ) );
-    return static_cast<unsigned int>( device );
+int64_t unzigzag( uint64_t value )
+{
+    return static_cast<int64_t>( value >> 1 ) ^ -static_cast<int64_t>( value & 1 );
 }
 
-TraceFileWriter::TraceFileWriter( const char* filename )
-    : m_file( filename, std::ios::out | std::ios::binary )
+// Parameters of the LZ77 codec (see compressLZ in TraceFile.h).
+const unsigned int LZ_HASH_BITS  = 14;
+const size_t       LZ_MIN_MATCH  = 4;
+const size_t       LZ_MAX_OFFSET = 1 << 16;
+
+// Integer and boolean options are recorded by name, so that options can be added without changing
+// the trace file version.
+template <typename Visitor>
+void visitOptions( Options& options, Visitor&& visit )
 {
+    visit( "numPages", options.numPages );
+    visit( "numPageTableEntries", options.numPageTableEntries );
+    visit( "maxRequestedPages", options.maxRequestedPages );
+    visit( "maxFilledPages", options.maxFilledPages );
+    visit( "maxTextures", options.maxTextures );
+    visit( "useSparseTextures", options.useSparseTextures );
+    visit( "useSmallTextureOptimization", options.useSmallTextureOptimization );
+    visit( "useCascadingTextureSizes", options.useCascadingTextureSizes );
+    visit( "coalesceWhiteBlackTiles", options.coalesceWhiteBlackTiles );
+    visit( "coalesceDuplicateImages", options.coalesceDuplicateImages );
+    visit( "coalesceDuplicateTiles", options.coalesceDuplicateTiles );
+    visit( "maxUniformTiles", options.maxUniformTiles );
+    visit( "maxTexMemPerDevice", options.maxTexMemPerDevice );
+    visit( "maxPinnedMemory", options.maxPinnedMemory );
+    visit( "maxStalePages", options.maxStalePages );
+    visit( "maxEvictablePages", options.maxEvictablePages );
+    visit( "maxInvalidatedPages", options.maxInvalidatedPages );
+    visit( "maxStagedPages", options.maxStagedPages );
+    visit( "maxRequestQueueSize", options.maxRequestQueueSize );
+    visit( "useLruTable", options.useLruTable );
+    visit( "evictionActive", options.evictionActive );
+    visit( "maxThreads", options.maxThreads );
+}
+
+// Collects the options' names and values.
+struct OptionWriter
+{
+    std::vector<std::pair<const char*, uint64_t>>& values;
+
+    template <typename T>
+    void operator()( const char* name, const T& option ) const
+    {
+        values.emplace_back( name, static_cast<uint64_t>( option ) );
+    }
+};
+
+// Sets the named option.
+struct OptionReader
+{
+    const std::string& name;
+    uint64_t           value;
+
+    template <typename T>
+    void operator()( const char* optionName, T& option ) const
+    {
+        if( name == optionName )
+            option = static_cast<T>( value );
+    }
+};
+
+thread_local uint64_t t_bytesRead = 0;
+
+}  // anonymous namespace
+
+void compressLZ( const std::vector<uint8_t>& in, std::vector<uint8_t>& out )
+{
+    const uint32_t        NONE = 0xFFFFFFFFu;
+    std::vector<uint32_t> table( 1 << LZ_HASH_BITS, NONE );
+
+    out.clear();
+    size_t literalStart = 0;
+    size_t pos          = 0;
+    while( pos + LZ_MIN_MATCH <= in.size() )
+    {
+        uint32_t sequence;
+        std::memcpy( &sequence, &in[pos], sizeof( sequence ) );
+        const uint32_t hash      = ( sequence * 2654435761u ) >> ( 32 - LZ_HASH_BITS );
+        const uint32_t candidate = table[hash];
+        table[hash]              = static_cast<uint32_t>( pos );
+
+        if( candidate == NONE || pos - candidate > LZ_MAX_OFFSET || std::memcmp( &in[candidate], &in[pos], LZ_MIN_MATCH ) != 0 )
+        {
+            ++pos;
+            continue;
+        }
+
+        size_t length = LZ_MIN_MATCH;
+        while( pos + length < in.size() && in[candidate + length] == in[pos + length] )
+            ++length;
+
+        writeVarint( out, pos - literalStart );
+        out.insert( out.end(), in.begin() + literalStart, in.begin() + pos );
+        writeVarint( out, length );
+        writeVarint( out, pos - candidate );
+        pos += length;
+        literalStart = pos;
+    }
+    writeVarint( out, in.size() - literalStart );
+    out.insert( out.end(), in.begin() + literalStart, in.end() );
+    writeVarint( out, 0 );
+}
+
+void decompressLZ( const std::vector<uint8_t>& in, std::vector<uint8_t>& out, size_t uncompressedSize )
+{
+    // Don't trust the stored size for more than a block's worth of memory up front.
+    out.clear();
+    out.reserve( std::min( uncompressedSize, TRACE_BLOCK_SIZE ) );
+    size_t pos = 0;
+    while( true )
+    {
+        const uint64_t numLiterals = readVarint( in.data(), in.size(), pos );
+        if( numLiterals > in.size() - pos || numLiterals > uncompressedSize - out.size() )
+            throw std::runtime_error( "Corrupt block in trace file" );
+        out.insert( out.end(), in.begin() + pos, in.begin() + pos + numLiterals );
+        pos += numLiterals;
+
+        const uint64_t length = readVarint( in.data(), in.size(), pos );
+        if( length == 0 )
+            break;
+        const uint64_t offset = readVarint( in.data(), in.size(), pos );
+        if( offset == 0 || offset > out.size() || length > uncompressedSize - out.size() )
+            throw std::runtime_error( "Corrupt block in trace file" );
+
+        // Copy byte by byte, since the match can overlap the bytes it produces.
+        size_t from = out.size() - offset;
+        for( uint64_t i = 0; i < length; ++i )
+            out.push_back( out[from + i] );
+    }
+    if( out.size() != uncompressedSize )
+        throw std::runtime_error( "Corrupt block in trace file" );
+}
+
+//------------------------------------------------------------------------------
+// TraceFileWriter
+
+std::shared_ptr<TraceFileWriter> TraceFileWriter::open( const std::string& filename )
+{
+    static std::mutex                                             writersMutex;
+    static std::map<std::string, std::weak_ptr<TraceFileWriter>> writers;
+
+    std::unique_lock<std::mutex>     lock( writersMutex );
+    std::shared_ptr<TraceFileWriter> writer = writers[filename].lock();
+    if( !writer )
+    {
+        writer.reset( new TraceFileWriter( filename ) );
+        writers[filename] = writer;
+    }
+    return writer;
+}
+
+TraceFileWriter::TraceFileWriter( const std::string& filename )
+    : m_file( filename, std::ios::out | std::ios::binary | std::ios::trunc )
+    , m_startTime( std::chrono::steady_clock::now() )
+{
+    if( !m_file )
+        throw std::runtime_error( "Unable to create trace file " + filename );
+    const uint32_t version = TRACE_FILE_VERSION;
+    m_file.write( TRACE_FILE_MAGIC, sizeof( TRACE_FILE_MAGIC ) );
+    m_file.write( reinterpret_cast<const char*>( &version ), sizeof( version ) );
 }
 
 TraceFileWriter::~TraceFileWriter()
 {
-    m_file.close();
+    flushBlock();
+
+    // Write the block index, followed by its offset, so that readers can find it from the end of the file.
+    const uint64_t indexOffset = static_cast<uint64_t>( m_file.tellp() );
+    const uint64_t numBlocks   = m_index.size();
+    m_file.write( reinterpret_cast<const char*>( &INDEX_MARKER ), sizeof( INDEX_MARKER ) );
+    m_file.write( reinterpret_cast<const char*>( &numBlocks ), sizeof( numBlocks ) );
+    m_file.write( reinterpret_cast<const char*>( m_index.data() ), m_index.size() * sizeof( BlockIndexEntry ) );
+    m_file.write( reinterpret_cast<const char*>( &indexOffset ), sizeof( indexOffset ) );
+    m_file.write( TRACE_INDEX_MAGIC, sizeof( TRACE_INDEX_MAGIC ) );
 }
 
-template <>
-void TraceFileWriter::write( const std::string& str )
+uint64_t TraceFileWriter::getTime() const
 {
-    write( str.size() );
-    write( str.data(), str.size() );
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now() - m_startTime ).count() );
 }
 
-void TraceFileWriter::recordOptions( const Options& options )
+void TraceFileWriter::addBytesRead( uint64_t numBytes )
 {
-    std::unique_lock<std::mutex> lock( m_mutex );
-    write( OPTIONS );
-    write( getDeviceIndex( CUstream{0} ) );
-    writeOption( "numPages", options.numPages );
-    writeOption( "numPageTableEntries", options.numPageTableEntries );
-    writeOption( "maxRequestedPages", options.maxRequestedPages );
-    writeOption( "maxFilledPages", options.maxFilledPages );
-    writeOption( "maxStalePages", options.maxStalePages );
-    writeOption( "maxEvictablePages", options.maxEvictablePages );
-    writeOption( "maxInvalidatedPages", options.maxInvalidatedPages );
-    writeOption( "maxStagedPages", options.maxStagedPages );
-    writeOption( "useLruTable", options.useLruTable );
-    writeOption( "maxTexMemPerDevice", options.maxTexMemPerDevice );
-    writeOption( "maxPinnedMemory", options.maxPinnedMemory );
-    writeOption( "maxThreads", options.maxThreads );
-}
-
-void TraceFileWriter::recordTexture( std::shared_ptr<imageSource::ImageSource> imageSource, const TextureDescriptor& desc )
+    t_bytesRead += numBytes;
+}
+
+uint64_t TraceFileWriter::takeBytesRead()
+{
+    const uint64_t numBytes = t_bytesRead;
+    t_bytesRead             = 0;
+    return numBytes;
+}
+
+void TraceFileWriter::beginRecord( TraceRecordType type, unsigned int deviceIndex, uint64_t timestamp )
+{
+    // Timestamps are stored as deltas from the previous record.  They can decrease, because fills
+    // are recorded when they finish, with the time that they started.
+    if( m_records.empty() )
+    {
+        m_blockStartTime = timestamp;
+        m_lastTime       = timestamp;
+    }
+    writeVarint( m_records, static_cast<uint64_t>( type ) );
+    writeVarint( m_records, zigzag( static_cast<int64_t>( timestamp - m_lastTime ) ) );
+    writeVarint( m_records, deviceIndex );
+    m_lastTime = timestamp;
+}
+
+void TraceFileWriter::endRecord()
+{
+    if( m_records.size() >= TRACE_BLOCK_SIZE )
+        flushBlock();
+}
+
+void TraceFileWriter::writePageIds( const unsigned int* pageIds, unsigned int numPageIds )
+{
+    // Page ids are delta encoded, which keeps runs of nearby pages (e.g. the tiles of a texture) small.
+    writeVarint( m_records, numPageIds );
+    unsigned int previous = 0;
+    for( unsigned int i = 0; i < numPageIds; ++i )
+    {
+        writeVarint( m_records, zigzag( static_cast<int64_t>( pageIds[i] ) - previous ) );
+        previous = pageIds[i];
+    }
+}
+
+void TraceFileWriter::writeString( const std::string& str )
+{
+    writeVarint( m_records, str.size() );
+    m_records.insert( m_records.end(), str.begin(), str.end() );
+}
+
+void TraceFileWriter::flush()
 {
     std::unique_lock<std::mutex> lock( m_mutex );
+    flushBlock();
+    m_file.flush();
+}
 
-    // For now, only EXRReader can be serialized.
-    std::shared_ptr<imageSource::EXRReader> exrReader( std::dynamic_pointer_cast<imageSource::EXRReader>( imageSource ) );
-    if( !exrReader )
-        throw std::runtime_error( "Cannot serialize ImageSource (expected EXRReader)" );
+void TraceFileWriter::flushBlock()
+{
+    if( m_records.empty() )
+        return;
 
-    write( TEXTURE );
-    write( getDeviceIndex( CUstream{0} ) );
-    exrReader->serialize( m_file );
+    compressLZ( m_records, m_compressed );
+    const bool            compressed = m_compressed.size() < m_records.size();
+    std::vector<uint8_t>& data       = compressed ? m_compressed : m_records;
 
-    // Serialize TextureDescriptor.
-    write( desc.addressMode[0] );
-    write( desc.addressMode[1] );
-    write( desc.filterMode );
-    write( desc.mipmapFilterMode );
-    write( desc.maxAnisotropy );
-    write( desc.flags );
+    BlockHeader header{};
+    header.codec            = compressed ? CODEC_LZ_V1 : CODEC_NONE;
+    header.uncompressedSize = static_cast<uint32_t>( m_records.size() );
+    header.compressedSize   = static_cast<uint32_t>( data.size() );
+    header.firstTimestamp   = m_blockStartTime;
+
+    m_index.push_back( BlockIndexEntry{static_cast<uint64_t>( m_file.tellp() ), m_blockStartTime} );
+    m_file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    m_file.write( reinterpret_cast<const char*>( data.data() ), data.size() );
+    m_records.clear();
 }
 
 // CUDA streams are assigned integer identifiers as they are encountered.
@@ -108,235 +353,585 @@ unsigned int TraceFileWriter::getStreamId( CUstream stream )
     return streamId;
 }
 
-void TraceFileWriter::recordRequests( CUstream stream, const unsigned int* pageIds, unsigned int numPageIds )
+void TraceFileWriter::recordOptions( unsigned int deviceIndex, const Options& options )
 {
-    if( !m_file )
-        return;
+    std::unique_lock<std::mutex> lock( m_mutex );
+    beginRecord( TraceRecordType::OPTIONS, deviceIndex, getTime() );
+
+    std::vector<std::pair<const char*, uint64_t>> values;
+    Options                                       copy( options );
+    visitOptions( copy, OptionWriter{values} );
+    writeVarint( m_records, values.size() );
+    for( const auto& value : values )
+    {
+        writeString( value.first );
+        writeVarint( m_records, value.second );
+    }
+    endRecord();
+}
 
+void TraceFileWriter::recordTexture( unsigned int deviceIndex, unsigned int textureId, const imageSource::ImageSource& image, const TextureDescriptor& desc )
+{
     std::unique_lock<std::mutex> lock( m_mutex );
-    unsigned int deviceIndex = getDeviceIndex( stream );
-    unsigned int streamId = getStreamId( stream ) ;
+    beginRecord( TraceRecordType::TEXTURE, deviceIndex, getTime() );
+    writeVarint( m_records, textureId );
+    writeString( image.getPath() );
+    writeVarint( m_records, desc.addressMode[0] );
+    writeVarint( m_records, desc.addressMode[1] );
+    writeVarint( m_records, desc.filterMode );
+    writeVarint( m_records, desc.mipmapFilterMode );
+    writeVarint( m_records, desc.maxAnisotropy );
+    writeVarint( m_records, desc.flags );
+    writeVarint( m_records, desc.conservativeFilter );
+    endRecord();
+}
 
-    write( REQUESTS );
-    write( deviceIndex );
-    write( streamId );
-    write( numPageIds );
-    write( pageIds, numPageIds );
+void TraceFileWriter::recordTextureInfo( unsigned int deviceIndex, unsigned int textureId, const imageSource::TextureInfo& info )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    beginRecord( TraceRecordType::TEXTURE_INFO, deviceIndex, getTime() );
+    writeVarint( m_records, textureId );
+    writeVarint( m_records, info.width );
+    writeVarint( m_records, info.height );
+    writeVarint( m_records, info.format );
+    writeVarint( m_records, info.numChannels );
+    writeVarint( m_records, info.numMipLevels );
+    writeVarint( m_records, info.isValid );
+    writeVarint( m_records, info.isTiled );
+    endRecord();
 }
 
-class TraceFileReader
+void TraceFileWriter::recordRequests( unsigned int deviceIndex, CUstream stream, const unsigned int* pageIds, unsigned int numPageIds )
 {
-  public:
-    TraceFileReader( const char* filename )
-        : m_file( filename, std::ios::in | std::ios::binary )
+    std::unique_lock<std::mutex> lock( m_mutex );
+    beginRecord( TraceRecordType::REQUESTS, deviceIndex, getTime() );
+    writeVarint( m_records, getStreamId( stream ) );
+    writePageIds( pageIds, numPageIds );
+    endRecord();
+}
+
+void TraceFileWriter::recordFill( unsigned int deviceIndex, const unsigned int* pageIds, unsigned int numPageIds, uint64_t startTime, uint64_t duration, uint64_t bytesRead )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    beginRecord( TraceRecordType::FILL, deviceIndex, startTime );
+    writePageIds( pageIds, numPageIds );
+    writeVarint( m_records, duration );
+    writeVarint( m_records, bytesRead );
+    endRecord();
+}
+
+void TraceFileWriter::recordStaging( unsigned int deviceIndex, const unsigned int* pageIds, unsigned int numPageIds )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    beginRecord( TraceRecordType::STAGING, deviceIndex, getTime() );
+    writePageIds( pageIds, numPageIds );
+    endRecord();
+}
+
+void TraceFileWriter::recordEviction( unsigned int deviceIndex, const unsigned int* pageIds, unsigned int numPageIds )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    beginRecord( TraceRecordType::EVICTION, deviceIndex, getTime() );
+    writePageIds( pageIds, numPageIds );
+    endRecord();
+}
+
+void TraceFileWriter::recordInvalidation( unsigned int deviceIndex, unsigned int startPage, unsigned int endPage, bool hasPredicate )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    beginRecord( TraceRecordType::INVALIDATION, deviceIndex, getTime() );
+    writeVarint( m_records, startPage );
+    writeVarint( m_records, endPage );
+    writeVarint( m_records, hasPredicate );
+    endRecord();
+}
+
+//------------------------------------------------------------------------------
+// TraceFileReader
+
+TraceFileReader::TraceFileReader( const std::string& filename )
+    : m_file( filename, std::ios::in | std::ios::binary )
+{
+    if( !m_file )
+        throw std::runtime_error( "Unable to open trace file " + filename );
+
+    char     magic[sizeof( TRACE_FILE_MAGIC )];
+    uint32_t version = 0;
+    m_file.read( magic, sizeof( magic ) );
+    m_file.read( reinterpret_cast<char*>( &version ), sizeof( version ) );
+    if( !m_file || std::memcmp( magic, TRACE_FILE_MAGIC, sizeof( magic ) ) != 0 )
+        throw std::runtime_error( "Not a trace file (or an unsupported version 1 trace file): " + filename );
+    if( version != TRACE_FILE_VERSION )
     {
+        std::stringstream stream;
+        stream << "Unsupported trace file version " << version << " in " << filename;
+        throw std::runtime_error( stream.str() );
     }
+    m_version = version;
 
-    Options readOptions()
-    {
-        RecordType recordType;
-        read( &recordType );
-        assert( recordType == OPTIONS );
+    readIndex();
+    if( m_index.empty() )
+        scanBlocks();
+}
+
+// Read the block index written when the trace was closed.
+void TraceFileReader::readIndex()
+{
+    const std::streamoff footerSize = sizeof( uint64_t ) + sizeof( TRACE_INDEX_MAGIC );
+    m_file.seekg( 0, std::ios::end );
+    const std::streamoff fileSize = m_file.tellg();
+    if( fileSize < footerSize )
+        return;
 
-        Options options;
-        unsigned int deviceIndex = 0;
-        read( &deviceIndex );
-        readOption( "numPages", &options.numPages );
-        readOption( "numPageTableEntries", &options.numPageTableEntries );
-        readOption( "maxRequestedPages", &options.maxRequestedPages );
-        readOption( "maxFilledPages", &options.maxFilledPages );
-        readOption( "maxStalePages", &options.maxStalePages );
-        readOption( "maxEvictablePages", &options.maxEvictablePages );
-        readOption( "maxInvalidatedPages", &options.maxInvalidatedPages );
-        readOption( "maxStagedPages", &options.maxStagedPages );
-        readOption( "useLruTable", &options.useLruTable );
-        readOption( "maxTexMemPerDevice", &options.maxTexMemPerDevice );
-        readOption( "maxPinnedMemory", &options.maxPinnedMemory );
-        readOption( "maxThreads", &options.maxThreads );
-        return options;
+    uint64_t indexOffset;
+    char     magic[sizeof( TRACE_INDEX_MAGIC )];
+    m_file.seekg( fileSize - footerSize );
+    m_file.read( reinterpret_cast<char*>( &indexOffset ), sizeof( indexOffset ) );
+    m_file.read( magic, sizeof( magic ) );
+    if( !m_file || std::memcmp( magic, TRACE_INDEX_MAGIC, sizeof( magic ) ) != 0 || indexOffset >= static_cast<uint64_t>( fileSize ) )
+    {
+        m_file.clear();
+        return;
     }
 
-    void replay( std::vector<DemandLoader*>& loaders )
+    uint32_t marker;
+    uint64_t numBlocks;
+    m_file.seekg( indexOffset );
+    m_file.read( reinterpret_cast<char*>( &marker ), sizeof( marker ) );
+    m_file.read( reinterpret_cast<char*>( &numBlocks ), sizeof( numBlocks ) );
+    if( !m_file || marker != INDEX_MARKER || numBlocks > static_cast<uint64_t>( fileSize ) / sizeof( BlockHeader ) )
     {
-        while( true )
-        {
-            RecordType recordType;
-            read( &recordType );
-            if( m_file.eof() )
-                break;
-            if( recordType == TEXTURE )
-            {
-                replayCreateTexture( loaders );
-            }
-            else if( recordType == REQUESTS )
-            {
-                replayRequests( loaders );
-            }
-            else
-            {
-                throw std::runtime_error( "Unknown record type in trace file" );
-            }
-        }
+        m_file.clear();
+        return;
+    }
+    m_index.resize( numBlocks );
+    m_file.read( reinterpret_cast<char*>( m_index.data() ), numBlocks * sizeof( BlockIndexEntry ) );
+    if( !m_file )
+    {
+        m_index.clear();
+        m_file.clear();
     }
+}
 
-    CUcontext getContext( unsigned int deviceIndex )
+// Build the block index of a trace that was not closed cleanly, stopping at the first incomplete block.
+void TraceFileReader::scanBlocks()
+{
+    m_file.seekg( 0, std::ios::end );
+    const uint64_t fileSize = static_cast<uint64_t>( m_file.tellg() );
+    uint64_t       offset   = sizeof( TRACE_FILE_MAGIC ) + sizeof( uint32_t );
+    while( offset + sizeof( BlockHeader ) <= fileSize )
     {
-        if( deviceIndex >= m_contexts.size() )
-        {
-            m_contexts.resize( deviceIndex + 1 );
-        }
-        if( !m_contexts[deviceIndex] )
-        {
-            CUdevice device;
-            OTK_ERROR_CHECK( cuDeviceGet( &device, deviceIndex ) );
-#if CUDA_VERSION >= 13000
-	    CUctxCreateParams params{};
-            OTK_ERROR_CHECK( cuCtxCreate( &m_contexts[deviceIndex], &params, 0, device ) );
-#else
-            OTK_ERROR_CHECK( cuCtxCreate( &m_contexts[deviceIndex], 0, device ) );
-#endif
-        }
-        return m_contexts[deviceIndex];
+        BlockHeader header;
+        m_file.seekg( offset );
+        m_file.read( reinterpret_cast<char*>( &header ), sizeof( header ) );
+        if( !m_file || header.codec == INDEX_MARKER || offset + sizeof( header ) + header.compressedSize > fileSize )
+            break;
+        m_index.push_back( BlockIndexEntry{offset, header.firstTimestamp} );
+        offset += sizeof( header ) + header.compressedSize;
     }
+    m_file.clear();
+}
 
-  private:
-    std::ifstream          m_file;
-    std::vector<CUcontext> m_contexts;
-    std::vector<CUstream>  m_streams;
+void TraceFileReader::seek( uint64_t timestamp )
+{
+    auto it = std::upper_bound( m_index.begin(), m_index.end(), timestamp,
+                                []( uint64_t time, const BlockIndexEntry& entry ) { return time < entry.firstTimestamp; } );
+    m_nextBlock = ( it == m_index.begin() ) ? 0 : static_cast<size_t>( it - m_index.begin() ) - 1;
+    m_records.clear();
+    m_position = 0;
+}
 
-    template <typename T>
-    void read( T* dest )
+bool TraceFileReader::readBlock()
+{
+    if( m_nextBlock >= m_index.size() )
+        return false;
+
+    BlockHeader header;
+    m_file.seekg( m_index[m_nextBlock].offset );
+    m_file.read( reinterpret_cast<char*>( &header ), sizeof( header ) );
+    if( !m_file )
+        throw std::runtime_error( "Truncated block in trace file" );
+
+    if( header.codec == CODEC_NONE )
+    {
+        if( header.compressedSize != header.uncompressedSize )
+            throw std::runtime_error( "Corrupt block in trace file" );
+        m_records.resize( header.compressedSize );
+        m_file.read( reinterpret_cast<char*>( m_records.data() ), m_records.size() );
+    }
+    else if( header.codec == CODEC_LZ_V1 )
     {
-        m_file.read( reinterpret_cast<char*>( dest ), sizeof( T ) );
+        m_compressed.resize( header.compressedSize );
+        m_file.read( reinterpret_cast<char*>( m_compressed.data() ), m_compressed.size() );
+        if( m_file )
+            decompressLZ( m_compressed, m_records, header.uncompressedSize );
     }
+    else
+    {
+        throw std::runtime_error( "Unknown block codec in trace file" );
+    }
+    if( !m_file )
+        throw std::runtime_error( "Truncated block in trace file" );
+
+    m_position = 0;
+    m_lastTime = header.firstTimestamp;
+    ++m_nextBlock;
+    return true;
+}
+
+uint64_t TraceFileReader::readVarint()
+{
+    return demandLoading::readVarint( m_records.data(), m_records.size(), m_position );
+}
 
-    std::string readString()
+void TraceFileReader::readPageIds( std::vector<unsigned int>& pageIds )
+{
+    const uint64_t numPageIds = readVarint();
+    if( numPageIds > m_records.size() - m_position )
+        throw std::runtime_error( "Corrupt page list in trace file" );
+    pageIds.resize( numPageIds );
+    int64_t previous = 0;
+    for( unsigned int& pageId : pageIds )
     {
-        size_t size;
-        read( &size );
-        std::vector<char> buffer( size );
-        m_file.read( buffer.data(), size );
-        return std::string( buffer.data(), size );
+        previous += unzigzag( readVarint() );
+        pageId = static_cast<unsigned int>( previous );
     }
+}
 
-    template <typename T>
-    void read( T* dest, unsigned int count )
+std::string TraceFileReader::readString()
+{
+    const uint64_t size = readVarint();
+    if( size > m_records.size() - m_position )
+        throw std::runtime_error( "Corrupt string in trace file" );
+    std::string str( reinterpret_cast<const char*>( m_records.data() + m_position ), size );
+    m_position += size;
+    return str;
+}
+
+bool TraceFileReader::readRecord( TraceRecord& record )
+{
+    while( m_position >= m_records.size() )
     {
-        m_file.read( reinterpret_cast<char*>( dest ), count * sizeof( T ) );
+        if( !readBlock() )
+            return false;
     }
 
-    template <typename T>
-    void readOption( const std::string& expected, T* option )
+    const uint64_t type = readVarint();
+    if( type >= static_cast<uint64_t>( TraceRecordType::NUM_TYPES ) )
+        throw std::runtime_error( "Unknown record type in trace file" );
+    record.type        = static_cast<TraceRecordType>( type );
+    m_lastTime         = m_lastTime + static_cast<uint64_t>( unzigzag( readVarint() ) );
+    record.timestamp   = m_lastTime;
+    record.deviceIndex = static_cast<unsigned int>( readVarint() );
+
+    switch( record.type )
     {
-        std::string found = readString();
-        if( found != expected )
+        case TraceRecordType::OPTIONS:
         {
-            std::stringstream stream;
-            stream << "Error reading option from trace file.  Expected " << expected << ", found " << found;
-            throw std::runtime_error( stream.str().c_str() );
+            // Options that aren't recognized (e.g. from a newer library) are ignored.
+            record.options            = Options();
+            const uint64_t numOptions = readVarint();
+            for( uint64_t i = 0; i < numOptions; ++i )
+            {
+                const std::string name  = readString();
+                const uint64_t    value = readVarint();
+                visitOptions( record.options, OptionReader{name, value} );
+            }
+            break;
         }
-        read( option );
+        case TraceRecordType::TEXTURE:
+            record.textureId                      = static_cast<unsigned int>( readVarint() );
+            record.imagePath                      = readString();
+            record.textureDesc.addressMode[0]     = static_cast<CUaddress_mode>( readVarint() );
+            record.textureDesc.addressMode[1]     = static_cast<CUaddress_mode>( readVarint() );
+            record.textureDesc.filterMode         = static_cast<unsigned int>( readVarint() );
+            record.textureDesc.mipmapFilterMode   = static_cast<CUfilter_mode>( readVarint() );
+            record.textureDesc.maxAnisotropy      = static_cast<unsigned int>( readVarint() );
+            record.textureDesc.flags              = static_cast<unsigned int>( readVarint() );
+            record.textureDesc.conservativeFilter = readVarint() != 0;
+            break;
+        case TraceRecordType::TEXTURE_INFO:
+            record.textureId                = static_cast<unsigned int>( readVarint() );
+            record.textureInfo.width        = static_cast<unsigned int>( readVarint() );
+            record.textureInfo.height       = static_cast<unsigned int>( readVarint() );
+            record.textureInfo.format       = static_cast<CUarray_format>( readVarint() );
+            record.textureInfo.numChannels  = static_cast<unsigned int>( readVarint() );
+            record.textureInfo.numMipLevels = static_cast<unsigned int>( readVarint() );
+            record.textureInfo.isValid      = readVarint() != 0;
+            record.textureInfo.isTiled      = readVarint() != 0;
+            break;
+        case TraceRecordType::REQUESTS:
+            record.streamId = static_cast<unsigned int>( readVarint() );
+            readPageIds( record.pageIds );
+            break;
+        case TraceRecordType::FILL:
+            readPageIds( record.pageIds );
+            record.duration  = readVarint();
+            record.bytesRead = readVarint();
+            break;
+        case TraceRecordType::STAGING:
+        case TraceRecordType::EVICTION:
+            readPageIds( record.pageIds );
+            break;
+        case TraceRecordType::INVALIDATION:
+            record.startPage    = static_cast<unsigned int>( readVarint() );
+            record.endPage      = static_cast<unsigned int>( readVarint() );
+            record.hasPredicate = readVarint() != 0;
+            break;
+        case TraceRecordType::NUM_TYPES:
+            break;
     }
+    return true;
+}
 
-    void replayCreateTexture( std::vector<DemandLoader*>& loaders )
+//------------------------------------------------------------------------------
+// Replay
+
+namespace {
+
+// Stands in for an image that was not read from a file, using the texture info recorded when it
+// was opened.  Its tiles are filled with zeros.
+class TraceImage : public imageSource::ImageSourceBase
+{
+  public:
+    explicit TraceImage( const imageSource::TextureInfo& info )
+        : m_info( info )
     {
-        unsigned int deviceIndex = 0;
-        read( &deviceIndex );
+    }
 
-        // FIXME: The image sources can be shared between devices and variant textures.
-        // This should be handled.
-        std::shared_ptr<imageSource::ImageSource> imageSource( imageSource::EXRReader::deserialize( m_file ) );
+    void open( imageSource::TextureInfo* info ) override
+    {
+        m_isOpen = true;
+        if( info )
+            *info = m_info;
+    }
 
-        TextureDescriptor desc;
-        read( &desc.addressMode[0] );
-        read( &desc.addressMode[1] );
-        read( &desc.filterMode );
-        read( &desc.mipmapFilterMode );
-        read( &desc.maxAnisotropy );
-        read( &desc.flags );
+    void close() override { m_isOpen = false; }
 
-        OTK_ERROR_CHECK( cuCtxSetCurrent( m_contexts[deviceIndex] ) );
-        loaders[deviceIndex]->createTexture( imageSource, desc );
+    bool isOpen() const override { return m_isOpen; }
+
+    const imageSource::TextureInfo& getInfo() const override { return m_info; }
+
+    CUmemorytype getFillType() const override { return CU_MEMORYTYPE_HOST; }
+
+    bool readTile( char* dest, unsigned int /*mipLevel*/, const imageSource::Tile& tile, CUstream /*stream*/ ) override
+    {
+        std::memset( dest, 0, static_cast<size_t>( tile.width ) * tile.height * imageSource::getBitsPerPixel( m_info ) / imageSource::BITS_PER_BYTE );
+        return true;
     }
 
-    CUstream getStream( unsigned int deviceIndex, unsigned int streamId )
+    bool readMipLevel( char* dest, unsigned int /*mipLevel*/, unsigned int expectedWidth, unsigned int expectedHeight, CUstream /*stream*/ ) override
     {
-        if( streamId < m_streams.size() )
-            return m_streams[streamId];
+        std::memset( dest, 0, static_cast<size_t>( expectedWidth ) * expectedHeight * imageSource::getBitsPerPixel( m_info ) / imageSource::BITS_PER_BYTE );
+        return true;
+    }
 
-        if( streamId != m_streams.size() )
-            throw std::runtime_error( "Unexpected stream id in page request trace file" );
+    bool readBaseColor( float4& dest ) override
+    {
+        dest = float4{0.0f, 0.0f, 0.0f, 0.0f};
+        return true;
+    }
 
-        CUcontext context = getContext( deviceIndex );
-        OTK_ERROR_CHECK( cuCtxSetCurrent( context ) );
+  private:
+    imageSource::TextureInfo m_info;
+    bool                     m_isOpen = false;
+};
 
-        CUstream stream;
-        OTK_ERROR_CHECK( cuStreamCreate( &stream, 0U ) );
-        m_streams.push_back( stream );
-        return stream;
+class TraceReplayer
+{
+  public:
+    TraceReplayer( const char* filename, TraceReplaySpeed speed )
+        : m_filename( filename )
+        , m_speed( speed )
+    {
     }
 
-    void replayRequests( std::vector<DemandLoader*>& loaders )
+    ~TraceReplayer()
     {
-        unsigned int deviceIndex;
-        read( &deviceIndex );
+        for( Device& device : m_devices )
+        {
+            if( !device.context )
+                continue;
+            OTK_ERROR_CHECK_NOTHROW( cuCtxSetCurrent( device.context ) );
+            for( CUstream stream : device.streams )
+                OTK_ERROR_CHECK_NOTHROW( cuStreamDestroy( stream ) );
+            if( device.loader )
+                destroyDemandLoader( device.loader );
+            OTK_ERROR_CHECK_NOTHROW( cuCtxDestroy( device.context ) );
+        }
+    }
 
-        unsigned int streamId;
-        read( &streamId );
+    Statistics replay()
+    {
+        OTK_ERROR_CHECK( cuInit( 0 ) );
+        OTK_ERROR_CHECK( cuDeviceGetCount( &m_numDevices ) );
+        OTK_ASSERT_MSG( m_numDevices > 0, "No CUDA devices for trace replay" );
 
-        unsigned int numPageIds;
-        read( &numPageIds );
+        // The texture info is recorded when textures are first requested, so read it in advance.
+        {
+            TraceFileReader reader( m_filename );
+            TraceRecord     record;
+            while( reader.readRecord( record ) )
+            {
+                if( record.type == TraceRecordType::TEXTURE_INFO )
+                    m_textureInfos[std::make_pair( record.deviceIndex, record.textureId )] = record.textureInfo;
+            }
+        }
 
-        std::vector<unsigned int> pageIds( numPageIds );
-        read( pageIds.data(), numPageIds );
+        TraceFileReader                             reader( m_filename );
+        TraceRecord                                 record;
+        const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        while( reader.readRecord( record ) )
+        {
+            switch( record.type )
+            {
+                case TraceRecordType::OPTIONS:
+                    createLoader( record );
+                    break;
+                case TraceRecordType::TEXTURE:
+                    createTexture( record );
+                    break;
+                case TraceRecordType::REQUESTS:
+                    if( m_speed == TraceReplaySpeed::RECORDED )
+                        std::this_thread::sleep_until( startTime + std::chrono::nanoseconds( record.timestamp ) );
+                    replayRequests( record );
+                    break;
+                case TraceRecordType::INVALIDATION:
+                    if( !record.hasPredicate )
+                        replayInvalidation( record );
+                    break;
+                default:
+                    break;
+            }
+        }
 
-        CUcontext context = getContext( deviceIndex );
-        OTK_ERROR_CHECK( cuCtxSetCurrent( context ) );
-        CUstream stream = getStream( deviceIndex, streamId );
+        // FIXME: Get stats from all loaders
+        for( Device& device : m_devices )
+        {
+            if( device.loader )
+                return device.loader->getStatistics();
+        }
+        return Statistics{};
+    }
 
-        // Downcast demand loader, since trace file playback relies on internal interface.
-        DemandLoaderImpl* loaderImpl = dynamic_cast<DemandLoaderImpl*>( loaders[deviceIndex] );
-        assert( loaderImpl );
+  private:
+    struct Device
+    {
+        CUcontext             context = nullptr;
+        DemandLoaderImpl*     loader  = nullptr;
+        std::vector<CUstream> streams;
+    };
+
+    std::string         m_filename;
+    TraceReplaySpeed    m_speed;
+    int                 m_numDevices = 0;
+    std::vector<Device> m_devices;  // Indexed by recorded device index.
+
+    std::map<std::pair<unsigned int, unsigned int>, imageSource::TextureInfo> m_textureInfos;  // Keyed by device index and texture id.
+    std::map<std::string, std::shared_ptr<imageSource::ImageSource>>          m_images;        // Images by path, shared by texture variants.
+
+    // Get the recorded device, making its context current.  Recorded devices that don't exist are
+    // replayed on the existing devices in turn.
+    Device& getDevice( unsigned int deviceIndex )
+    {
+        if( deviceIndex >= m_devices.size() )
+            m_devices.resize( deviceIndex + 1 );
+        Device& device = m_devices[deviceIndex];
+        if( !device.context )
+        {
+            CUdevice cuDevice;
+            OTK_ERROR_CHECK( cuDeviceGet( &cuDevice, static_cast<int>( deviceIndex % m_numDevices ) ) );
+#if CUDA_VERSION >= 13000
+            CUctxCreateParams params{};
+            OTK_ERROR_CHECK( cuCtxCreate( &device.context, &params, 0, cuDevice ) );
+#else
+            OTK_ERROR_CHECK( cuCtxCreate( &device.context, 0, cuDevice ) );
+#endif
+        }
+        OTK_ERROR_CHECK( cuCtxSetCurrent( device.context ) );
+        return device;
+    }
 
-        Ticket ticket = loaderImpl->replayRequests( stream, pageIds.data(), numPageIds );
-        ticket.wait();
+    DemandLoaderImpl* getLoader( const TraceRecord& record )
+    {
+        Device& device = getDevice( record.deviceIndex );
+        if( !device.loader )
+            throw std::runtime_error( "Trace file record precedes the demand loader options" );
+        return device.loader;
     }
-};
 
-Statistics replayTraceFile( const char* filename )
-{
-    // Open the trace file.  Throws an exception if an error occurs.
-    TraceFileReader reader( filename );
+    CUstream getStream( Device& device, unsigned int streamId )
+    {
+        while( device.streams.size() <= streamId )
+        {
+            CUstream stream;
+            OTK_ERROR_CHECK( cuStreamCreate( &stream, 0U ) );
+            device.streams.push_back( stream );
+        }
+        return device.streams[streamId];
+    }
 
-    // Read options.
-    Options options = reader.readOptions();
-    options.traceFile = "";
+    void createLoader( const TraceRecord& record )
+    {
+        Device& device = getDevice( record.deviceIndex );
+        if( device.loader )
+            return;
+        Options options   = record.options;
+        options.traceFile = "";
 
-    // Create demand loaders for each device.
-    int numDevices;
-    OTK_ERROR_CHECK( cuDeviceGetCount( &numDevices ) );
-    std::vector<DemandLoader*> loaders;
-    for( int deviceIndex = 0; deviceIndex < numDevices; ++deviceIndex )
+        // Downcast demand loader, since trace file playback relies on internal interface.
+        device.loader = dynamic_cast<DemandLoaderImpl*>( createDemandLoader( options ) );
+        OTK_ASSERT( device.loader );
+    }
+
+    void createTexture( const TraceRecord& record )
     {
-        CUcontext context = reader.getContext( deviceIndex );
-        OTK_ERROR_CHECK( cuCtxSetCurrent( context ) );
-        loaders.push_back( createDemandLoader( options ) );
+        DemandLoaderImpl* loader = getLoader( record );
+
+        std::shared_ptr<imageSource::ImageSource> image;
+        if( !record.imagePath.empty() )
+        {
+            std::shared_ptr<imageSource::ImageSource>& cached = m_images[record.imagePath];
+            if( !cached )
+                cached = imageSource::createImageSource( record.imagePath );
+            image = cached;
+        }
+        else
+        {
+            auto it = m_textureInfos.find( std::make_pair( record.deviceIndex, record.textureId ) );
+            image.reset( new TraceImage( it != m_textureInfos.end() ? it->second : imageSource::TextureInfo{} ) );
+        }
+        loader->replayTexture( record.textureId, image, record.textureDesc );
     }
 
-    // Replay the trace file.
-    reader.replay( loaders );
+    void replayRequests( const TraceRecord& record )
+    {
+        DemandLoaderImpl* loader = getLoader( record );
+        CUstream          stream = getStream( m_devices[record.deviceIndex], record.streamId );
 
-    // FIXME: Get stats from all loaders
-    Statistics stats = loaders[0]->getStatistics();
+        Ticket ticket = loader->replayRequests( stream, record.pageIds.data(), static_cast<unsigned int>( record.pageIds.size() ) );
+        ticket.wait();
+
+        // Push the new mappings to the device, as the recorded launch would have.
+        DeviceContext context;
+        loader->launchPrepare( stream, context );
+        loader->getDeviceMemoryManager()->freeDeviceContext( &context );
+    }
 
-    // Clean up.
-    for( int deviceIndex = 0; deviceIndex < numDevices; ++deviceIndex )
+    void replayInvalidation( const TraceRecord& record )
     {
-        destroyDemandLoader( loaders[deviceIndex] );
+        DemandLoaderImpl* loader = getLoader( record );
+        for( unsigned int pageId = record.startPage; pageId < record.endPage; ++pageId )
+            loader->invalidatePage( pageId );
     }
+};
 
-    return stats;
-}
+}  // anonymous namespace
 
+Statistics replayTraceFile( const char* filename, TraceReplaySpeed speed )
+{
+    TraceReplayer replayer( filename, speed );
+    return replayer.replay();
+}
 
 }  // namespace demandLoading
@@ -0,0 +1,240 @@
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+/// \file TraceFile.h
+/// Demand loading trace files, which record the activity of demand loaders for analysis and replay.
+///
+/// A trace file starts with a header (the string "OTKTRACE" and a version number), followed by
+/// blocks of records.  Each block is compressed separately and only appended, so a trace that was
+/// not closed cleanly can still be read up to its last complete block.  Closing the trace appends an
+/// index of the blocks' file offsets and first timestamps, which allows long traces to be seeked.
+/// Each record holds a timestamp (in nanoseconds from the start of the trace) and the index of the
+/// device whose demand loader made it.
+///
+/// Each block header names the codec of its records:
+///   - 0: stored uncompressed.
+///   - 1: LZ77, version 1 (see compressLZ).
+/// A codec's format is frozen once it has been written; a change to it takes a new codec id, and the
+/// reader keeps decoding the old ones.  Unknown codec ids are rejected.
+
+#include <OptiXToolkit/DemandLoading/Options.h>
+#include <OptiXToolkit/DemandLoading/Statistics.h>
+#include <OptiXToolkit/DemandLoading/TextureDescriptor.h>
+#include <OptiXToolkit/ImageSource/TextureInfo.h>
+
+#include <cuda.h>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace imageSource {
+class ImageSource;
+}
+
+namespace demandLoading {
+
+/// The trace file version written by TraceFileWriter and read by TraceFileReader.
+const unsigned int TRACE_FILE_VERSION = 2;
+
+/// Compress a block of trace records with the version 1 LZ77 codec, which keeps trace files free of
+/// a compression library dependency.  The compressed data is a sequence of (literal length, literals,
+/// match length, match offset) tuples, with the lengths and offsets stored as varints.  The last
+/// tuple has a match length of zero and no offset.
+void compressLZ( const std::vector<uint8_t>& in, std::vector<uint8_t>& out );
+
+/// Decompress a block compressed by compressLZ, which must expand to exactly uncompressedSize bytes.
+/// Throws std::runtime_error if the data is truncated or corrupt.
+void decompressLZ( const std::vector<uint8_t>& in, std::vector<uint8_t>& out, size_t uncompressedSize );
+
+/// Trace record types.
+enum class TraceRecordType : unsigned int
+{
+    OPTIONS = 0,   ///< Demand loader options.
+    TEXTURE,       ///< Texture creation: texture id, image path and texture descriptor.
+    TEXTURE_INFO,  ///< Texture info, recorded when the texture's image is opened.
+    REQUESTS,      ///< A batch of page requests pulled from the device.
+    FILL,          ///< A group of requests filled by a request handler.
+    STAGING,       ///< Stale pages staged for eviction.
+    EVICTION,      ///< Staged pages whose backing storage was freed.
+    INVALIDATION,  ///< A range of invalidated pages.
+    NUM_TYPES
+};
+
+/// A trace file record.  Only the fields used by the record type are valid.
+struct TraceRecord
+{
+    TraceRecordType type        = TraceRecordType::OPTIONS;
+    uint64_t        timestamp   = 0;  ///< Nanoseconds since the start of the trace.
+    unsigned int    deviceIndex = 0;
+
+    std::vector<unsigned int> pageIds;  ///< REQUESTS, FILL, STAGING and EVICTION.
+
+    unsigned int streamId     = 0;      ///< REQUESTS: streams are numbered in order of first use.
+    uint64_t     duration     = 0;      ///< FILL: nanoseconds spent filling the requests.
+    uint64_t     bytesRead    = 0;      ///< FILL: bytes of image data delivered.
+    unsigned int startPage    = 0;      ///< INVALIDATION: first page of the range.
+    unsigned int endPage      = 0;      ///< INVALIDATION: one past the last page of the range.
+    bool         hasPredicate = false;  ///< INVALIDATION: whether a predicate chose the pages in the range.
+
+    unsigned int             textureId = 0;  ///< TEXTURE and TEXTURE_INFO.
+    std::string              imagePath;      ///< TEXTURE: empty if the image is not read from a file.
+    TextureDescriptor        textureDesc;    ///< TEXTURE.
+    imageSource::TextureInfo textureInfo{};  ///< TEXTURE_INFO.
+
+    Options options;  ///< OPTIONS: the trace file name is not recorded.
+};
+
+/// TraceFileWriter appends records to a trace file.  Demand loaders that are configured with the
+/// same trace file share a writer.  The record methods are thread safe and make no CUDA calls, so
+/// they can be called from stream callbacks.
+class TraceFileWriter
+{
+  public:
+    /// Get the writer for the given trace file, creating the file if it is not already open.
+    /// Throws an exception if the file cannot be created.
+    static std::shared_ptr<TraceFileWriter> open( const std::string& filename );
+
+    /// Write the buffered records and the block index, and close the file.
+    ~TraceFileWriter();
+
+    /// Get the time in nanoseconds since the trace was opened.
+    uint64_t getTime() const;
+
+    /// Record the demand loader options.
+    void recordOptions( unsigned int deviceIndex, const Options& options );
+
+    /// Record the creation of a texture.
+    void recordTexture( unsigned int deviceIndex, unsigned int textureId, const imageSource::ImageSource& image, const TextureDescriptor& desc );
+
+    /// Record the info of a texture's image when it is opened.
+    void recordTextureInfo( unsigned int deviceIndex, unsigned int textureId, const imageSource::TextureInfo& info );
+
+    /// Record a batch of page requests.
+    void recordRequests( unsigned int deviceIndex, CUstream stream, const unsigned int* pageIds, unsigned int numPageIds );
+
+    /// Record a group of filled requests, which started at the given time.
+    void recordFill( unsigned int deviceIndex, const unsigned int* pageIds, unsigned int numPageIds, uint64_t startTime, uint64_t duration, uint64_t bytesRead );
+
+    /// Record pages staged for eviction.
+    void recordStaging( unsigned int deviceIndex, const unsigned int* pageIds, unsigned int numPageIds );
+
+    /// Record evicted pages.
+    void recordEviction( unsigned int deviceIndex, const unsigned int* pageIds, unsigned int numPageIds );
+
+    /// Record the invalidation of the pages from startPage up to (but not including) endPage.
+    void recordInvalidation( unsigned int deviceIndex, unsigned int startPage, unsigned int endPage, bool hasPredicate );
+
+    /// Compress and write the buffered records.
+    void flush();
+
+    /// Add to the count of image bytes delivered by request handlers on the calling thread.  The
+    /// count is reported in fill records.
+    static void addBytesRead( uint64_t numBytes );
+
+    /// Return the count of image bytes delivered on the calling thread, and reset it.
+    static uint64_t takeBytesRead();
+
+  private:
+    std::ofstream                         m_file;
+    std::mutex                            m_mutex;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    std::vector<uint8_t> m_records;             // Uncompressed records of the current block.
+    uint64_t             m_blockStartTime = 0;  // Timestamp of the first record in the current block.
+    uint64_t             m_lastTime       = 0;  // Timestamp of the last record, for delta encoding.
+    std::vector<uint8_t> m_compressed;
+
+    struct BlockIndexEntry
+    {
+        uint64_t offset;
+        uint64_t firstTimestamp;
+    };
+    std::vector<BlockIndexEntry> m_index;
+
+    std::map<CUstream, unsigned int> m_streamIds;
+    unsigned int                     m_nextStreamId = 0;
+
+    explicit TraceFileWriter( const std::string& filename );
+
+    // Start a record.  Called with the mutex locked.
+    void beginRecord( TraceRecordType type, unsigned int deviceIndex, uint64_t timestamp );
+
+    // Finish a record, writing the block if it is full.  Called with the mutex locked.
+    void endRecord();
+
+    void writePageIds( const unsigned int* pageIds, unsigned int numPageIds );
+    void writeString( const std::string& str );
+    void flushBlock();
+    unsigned int getStreamId( CUstream stream );
+};
+
+/// TraceFileReader reads the records of a trace file in order.
+class TraceFileReader
+{
+  public:
+    /// Open a trace file.  Throws an exception if the file cannot be read or has an unsupported version.
+    explicit TraceFileReader( const std::string& filename );
+
+    /// Get the version of the trace file.
+    unsigned int getVersion() const { return m_version; }
+
+    /// Get the number of blocks in the trace file.
+    size_t getNumBlocks() const { return m_index.size(); }
+
+    /// Read the next record.  Returns false at the end of the trace.  Throws an exception if the
+    /// trace is corrupt.
+    bool readRecord( TraceRecord& record );
+
+    /// Seek to the last block that starts at or before the given time (or the first block), so that
+    /// the next record read is the first one in that block.
+    void seek( uint64_t timestamp );
+
+  private:
+    struct BlockIndexEntry
+    {
+        uint64_t offset;
+        uint64_t firstTimestamp;
+    };
+
+    std::ifstream                m_file;
+    unsigned int                 m_version = 0;
+    std::vector<BlockIndexEntry> m_index;
+    size_t                       m_nextBlock = 0;
+
+    std::vector<uint8_t> m_records;  // Uncompressed records of the current block.
+    std::vector<uint8_t> m_compressed;
+    size_t               m_position = 0;
+    uint64_t             m_lastTime = 0;
+
+    void readIndex();
+    void scanBlocks();
+    bool readBlock();
+    uint64_t readVarint();
+    void readPageIds( std::vector<unsigned int>& pageIds );
+    std::string readString();
+};
+
+/// Trace replay speed.
+enum class TraceReplaySpeed
+{
+    MAXIMUM,  ///< Replay the page requests as fast as they can be filled.
+    RECORDED  ///< Replay each batch of page requests at its recorded time.
+};
+
+/// Replay the page requests in a trace file, creating a demand loader for each recorded device.
+/// Images are reopened from their recorded paths, and images that were not read from files are
+/// replaced by images with the recorded texture info that are filled with zeros.  Invalidations of
+/// whole page ranges are replayed, but fill, staging and eviction records are informational, as are
+/// invalidations chosen by a predicate.  Returns the statistics of the first device's demand loader.
+Statistics replayTraceFile( const char* filename, TraceReplaySpeed speed = TraceReplaySpeed::MAXIMUM );
+
+}  // namespace demandLoading
@@ -0,0 +1,226 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "Util/TraceFile.h"
+
+#include <OptiXToolkit/DemandLoading/CacheSimulator.h>
+#include <OptiXToolkit/Memory/MemoryBlockDesc.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace demandLoading;
+
+namespace {
+
+const unsigned int FIRST_TILE = 1 << 20;  // The default numPageTableEntries.
+const unsigned int MAX_TILES  = 64;
+
+const char* const TRACE_FILENAME = "testCacheSimulator.trace";
+
+Options makeOptions()
+{
+    Options options;
+    options.maxTexMemPerDevice = MAX_TILES * otk::TILE_SIZE_IN_BYTES;
+    options.maxStagedPages     = 8;
+    options.maxStalePages      = 16;
+    return options;
+}
+
+// Pages of a frame: a hot set that every frame requests, and a window of a sequential scan.
+std::vector<unsigned int> makeFrame( unsigned int frame, unsigned int numHot, unsigned int numScan )
+{
+    std::vector<unsigned int> pageIds;
+    for( unsigned int i = 0; i < numHot; ++i )
+        pageIds.push_back( FIRST_TILE + i );
+    for( unsigned int i = 0; i < numScan; ++i )
+        pageIds.push_back( FIRST_TILE + 1000 + ( frame * numScan + i ) % 500 );
+    return pageIds;
+}
+
+// A FIFO policy that checks that the simulator keeps to the CachePolicy contract.
+class FifoPolicy : public CachePolicy
+{
+  public:
+    void insert( unsigned int pageId ) override
+    {
+        EXPECT_EQ( 0U, m_resident.count( pageId ) );
+        m_resident.insert( pageId );
+        m_queue.push_back( pageId );
+    }
+    void access( unsigned int pageId ) override { EXPECT_EQ( 1U, m_resident.count( pageId ) ); }
+    void remove( unsigned int pageId ) override { EXPECT_EQ( 1U, m_resident.erase( pageId ) ); }
+    void endFrame( const std::unordered_set<unsigned int>& /*referencedPages*/ ) override { ++numFrames; }
+    void getStalePages( unsigned int maxPages, const std::unordered_set<unsigned int>& referencedPages, std::vector<unsigned int>& stalePages ) override
+    {
+        for( size_t i = 0; i < m_queue.size() && stalePages.size() < maxPages; ++i )
+        {
+            const unsigned int pageId = m_queue[i];
+            if( m_resident.count( pageId ) != 0 && referencedPages.count( pageId ) == 0 )
+                stalePages.push_back( pageId );
+        }
+    }
+
+    unsigned int numFrames = 0;
+
+  private:
+    std::unordered_set<unsigned int> m_resident;
+    std::vector<unsigned int>        m_queue;
+};
+
+}  // namespace
+
+TEST( TestCacheSimulator, PolicyNames )
+{
+    for( EvictionPolicy policy : {EvictionPolicy::LRU_THRESHOLD, EvictionPolicy::RANDOM, EvictionPolicy::CLOCK, EvictionPolicy::ARC, EvictionPolicy::TWO_Q} )
+    {
+        EvictionPolicy found;
+        ASSERT_TRUE( findEvictionPolicy( getEvictionPolicyName( policy ), found ) );
+        EXPECT_EQ( policy, found );
+    }
+    EvictionPolicy found;
+    EXPECT_FALSE( findEvictionPolicy( "belady", found ) );
+
+    Options options;
+    EXPECT_EQ( EvictionPolicy::LRU_THRESHOLD, getDefaultEvictionPolicy( options ) );
+    options.useLruTable = false;
+    EXPECT_EQ( EvictionPolicy::RANDOM, getDefaultEvictionPolicy( options ) );
+}
+
+TEST( TestCacheSimulator, UnlimitedMemory )
+{
+    CacheSimulator simulator( Options(), EvictionPolicy::LRU_THRESHOLD );
+    EXPECT_EQ( 0U, simulator.getMaxTiles() );
+
+    // Sampler pages are not tiles, and duplicate requests count once.
+    const std::vector<unsigned int> pageIds{0, 5, FIRST_TILE, FIRST_TILE + 1, FIRST_TILE + 1};
+    CacheSimulatorStats             stats = simulator.simulateFrame( pageIds.data(), static_cast<unsigned int>( pageIds.size() ) );
+    EXPECT_EQ( 2U, stats.numRequests );
+    EXPECT_EQ( 2U, stats.numLoads );
+    EXPECT_EQ( 2ULL * otk::TILE_SIZE_IN_BYTES, stats.bytesRead );
+
+    for( int frame = 0; frame < 100; ++frame )
+    {
+        stats = simulator.simulateFrame( pageIds.data() + 2, 1 );
+        EXPECT_EQ( 1U, stats.numHits );
+        EXPECT_EQ( 0U, stats.numStaged );
+    }
+    EXPECT_EQ( 2U, simulator.getTotals().numResidentPages );
+    EXPECT_EQ( 101U, simulator.getTotals().numFrames );
+}
+
+TEST( TestCacheSimulator, StagedPagesAreRestored )
+{
+    CacheSimulator simulator( makeOptions(), std::unique_ptr<CachePolicy>( new FifoPolicy ) );
+
+    // Fill memory, which activates eviction, and stage the first pages.
+    std::vector<unsigned int> pageIds;
+    for( unsigned int i = 0; i < MAX_TILES; ++i )
+        pageIds.push_back( FIRST_TILE + i );
+    CacheSimulatorStats stats = simulator.simulateFrame( pageIds.data(), MAX_TILES );
+    EXPECT_EQ( MAX_TILES, stats.numLoads );
+    EXPECT_EQ( 0U, stats.numStaged );  // every page was referenced
+
+    const std::vector<unsigned int> newPage{FIRST_TILE + MAX_TILES};
+    stats = simulator.simulateFrame( newPage.data(), 1 );
+    EXPECT_EQ( 1U, stats.numDropped );
+    EXPECT_EQ( 8U, stats.numStaged );
+    EXPECT_EQ( 8U, stats.numStagedPages );
+
+    // A staged page is restored without reading it, and the new page frees the oldest staged page.
+    const std::vector<unsigned int> requests{FIRST_TILE + 1, FIRST_TILE + MAX_TILES};
+    stats = simulator.simulateFrame( requests.data(), 2 );
+    EXPECT_EQ( 1U, stats.numRestores );
+    EXPECT_EQ( 1U, stats.numLoads );
+    EXPECT_EQ( 0U, stats.numReloads );
+    EXPECT_GE( stats.numEvicted, 1U );
+
+    // The evicted page is read again.
+    stats = simulator.simulateFrame( pageIds.data(), 1 );
+    EXPECT_EQ( 1U, stats.numReloads );
+    EXPECT_EQ( otk::TILE_SIZE_IN_BYTES, stats.bytesReread );
+}
+
+TEST( TestCacheSimulator, PoliciesKeepWithinBudget )
+{
+    for( EvictionPolicy policy : {EvictionPolicy::LRU_THRESHOLD, EvictionPolicy::RANDOM, EvictionPolicy::CLOCK, EvictionPolicy::ARC, EvictionPolicy::TWO_Q} )
+    {
+        SCOPED_TRACE( getEvictionPolicyName( policy ) );
+        CacheSimulator simulator( makeOptions(), policy );
+        std::mt19937   rng( 3 );
+        for( unsigned int frame = 0; frame < 500; ++frame )
+        {
+            std::vector<unsigned int> pageIds = makeFrame( frame, 16, 8 );
+            for( int i = 0; i < 4; ++i )
+                pageIds.push_back( FIRST_TILE + 2000 + rng() % 100 );
+
+            const CacheSimulatorStats stats = simulator.simulateFrame( pageIds.data(), static_cast<unsigned int>( pageIds.size() ) );
+            EXPECT_LE( stats.numResidentPages + stats.numStagedPages, MAX_TILES );
+            EXPECT_LE( stats.numStagedPages, 8U );
+            EXPECT_EQ( stats.numRequests, stats.numHits + stats.numRestores + stats.numLoads + stats.numDropped );
+        }
+
+        // The hot pages stay resident.
+        const CacheSimulatorStats& totals = simulator.getTotals();
+        EXPECT_GT( totals.numEvicted, 0U );
+        EXPECT_GT( totals.hitRate(), 0.5 );
+        EXPECT_EQ( totals.churn(), totals.numLoads + totals.numEvicted );
+    }
+}
+
+TEST( TestCacheSimulator, Invalidation )
+{
+    CacheSimulator simulator( makeOptions(), EvictionPolicy::CLOCK );
+    for( unsigned int frame = 0; frame < 20; ++frame )
+    {
+        const std::vector<unsigned int> pageIds = makeFrame( frame, 4, 8 );
+        simulator.simulateFrame( pageIds.data(), static_cast<unsigned int>( pageIds.size() ) );
+    }
+    const unsigned int numPages = simulator.getTotals().numResidentPages + simulator.getTotals().numStagedPages;
+
+    simulator.invalidatePages( FIRST_TILE, FIRST_TILE + 4 );
+    EXPECT_EQ( 4U, simulator.getTotals().numInvalidated );
+    EXPECT_EQ( numPages - 4, simulator.getTotals().numResidentPages + simulator.getTotals().numStagedPages );
+
+    const std::vector<unsigned int> pageIds = makeFrame( 20, 4, 0 );
+    CacheSimulatorStats             stats   = simulator.simulateFrame( pageIds.data(), 4 );
+    EXPECT_EQ( 4U, stats.numReloads );
+}
+
+TEST( TestCacheSimulator, SimulateTraceFile )
+{
+    Options options = makeOptions();
+    options.useLruTable = false;
+    {
+        std::shared_ptr<TraceFileWriter> writer = TraceFileWriter::open( TRACE_FILENAME );
+        writer->recordOptions( 0, options );
+        for( unsigned int frame = 0; frame < 50; ++frame )
+        {
+            const std::vector<unsigned int> pageIds = makeFrame( frame, 8, 16 );
+            writer->recordRequests( 0, CUstream{}, pageIds.data(), static_cast<unsigned int>( pageIds.size() ) );
+            writer->recordRequests( 1, CUstream{}, pageIds.data(), 1 );
+        }
+        writer->recordInvalidation( 0, FIRST_TILE, FIRST_TILE + 8, false );
+    }
+
+    const Options recorded = getTraceFileOptions( TRACE_FILENAME );
+    EXPECT_EQ( options.maxTexMemPerDevice, recorded.maxTexMemPerDevice );
+    EXPECT_FALSE( recorded.useLruTable );
+    EXPECT_EQ( Options().maxStagedPages, getTraceFileOptions( TRACE_FILENAME, 1 ).maxStagedPages );
+
+    const std::vector<CacheSimulatorStats> frames = simulateTraceFile( TRACE_FILENAME, recorded, getDefaultEvictionPolicy( recorded ) );
+    ASSERT_EQ( 50U, frames.size() );
+    EXPECT_EQ( 24U, frames[0].numLoads );
+    CacheSimulatorStats totals;
+    for( const CacheSimulatorStats& frame : frames )
+        totals += frame;
+    EXPECT_EQ( 50U * 24U, totals.numRequests );
+    EXPECT_GT( totals.numReloads, 0U );
+    EXPECT_EQ( frames.back().timestamp, totals.timestamp );
+
+    std::remove( TRACE_FILENAME );
+}
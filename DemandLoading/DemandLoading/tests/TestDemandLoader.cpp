@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -16,6 +16,7 @@
 #include <cuda_runtime.h>
 
 #include <functional>
+#include <vector>
 
 using namespace demandLoading;
 using namespace imageSource;
@@ -320,6 +321,65 @@ TEST_F( TestDemandLoaderResident, TestResourceResident )
 }
 
 
+TEST_F( TestDemandLoader, TestTileTransferBuffersDontHoldSharedPinnedMemory )
+{
+    OTK_ERROR_CHECK( cudaSetDevice( 0 ) );
+    DemandLoaderImpl* loader = m_loaders[0];
+    CUstream          stream = m_streams[0];
+
+    // Mix tile-sized and other transfer buffers until both kinds are exhausted.
+    const size_t                    otherSize = 3 * otk::TILE_SIZE_IN_BYTES;
+    std::vector<TransferBufferDesc> tileBuffers;
+    std::vector<TransferBufferDesc> otherBuffers;
+    for( bool tilesLeft = true, othersLeft = true; tilesLeft || othersLeft; )
+    {
+        if( tilesLeft )
+        {
+            const TransferBufferDesc buffer = loader->allocateTransferBuffer( CU_MEMORYTYPE_HOST, otk::TILE_SIZE_IN_BYTES, stream );
+            tilesLeft                       = buffer.memoryBlock.size != 0;
+            if( tilesLeft )
+                tileBuffers.push_back( buffer );
+        }
+        if( othersLeft )
+        {
+            const TransferBufferDesc buffer = loader->allocateTransferBuffer( CU_MEMORYTYPE_HOST, otherSize, stream );
+            othersLeft                      = buffer.memoryBlock.size != 0;
+            if( othersLeft )
+                otherBuffers.push_back( buffer );
+        }
+    }
+    ASSERT_FALSE( tileBuffers.empty() );
+    ASSERT_FALSE( otherBuffers.empty() );
+
+    // Free everything.  The tile buffers stay parked in this thread's magazine.
+    for( const TransferBufferDesc& buffer : tileBuffers )
+        loader->freeTransferBuffer( buffer, stream );
+    for( const TransferBufferDesc& buffer : otherBuffers )
+        loader->freeTransferBuffer( buffer, stream );
+    OTK_ERROR_CHECK( cuStreamSynchronize( stream ) );
+
+    // Other users of the pinned memory pool get all of it back, despite the parked tile buffers.
+    otk::MemoryPool<otk::PinnedAllocator, otk::RingSuballocator>* pinnedPool = loader->getPinnedMemoryPool();
+    std::vector<otk::MemoryBlockDesc> blocks;
+    for( otk::MemoryBlockDesc block = pinnedPool->alloc( otherSize ); block.isGood(); block = pinnedPool->alloc( otherSize ) )
+        blocks.push_back( block );
+    EXPECT_GE( blocks.size(), otherBuffers.size() );
+    EXPECT_GE( blocks.size() * otherSize, pinnedPool->maxSize() - otk::DEFAULT_ALLOC_SIZE );
+    for( const otk::MemoryBlockDesc& block : blocks )
+        pinnedPool->free( block );
+
+    // And the parked tile buffers are still available to tiles.
+    const TransferBufferDesc tileBuffer = loader->allocateTransferBuffer( CU_MEMORYTYPE_HOST, otk::TILE_SIZE_IN_BYTES, stream );
+    EXPECT_EQ( otk::TILE_SIZE_IN_BYTES, tileBuffer.memoryBlock.size );
+    loader->freeTransferBuffer( tileBuffer, stream );
+
+    // The tile buffers and the other buffers share one pinned memory budget, and the statistics
+    // report the memory held by the tile buffers.
+    const Statistics stats = loader->getStatistics();
+    EXPECT_GE( stats.tileTransferPinnedMemory, tileBuffers.size() * otk::TILE_SIZE_IN_BYTES );
+    EXPECT_LE( stats.tileTransferPinnedMemory + pinnedPool->maxSize(), loader->getOptions().maxPinnedMemory + otk::DEFAULT_ALLOC_SIZE );
+}
+
 TEST_F( TestDemandLoader, TestTextureVariants )
 {
     OTK_ERROR_CHECK( cudaSetDevice( 0 ) );
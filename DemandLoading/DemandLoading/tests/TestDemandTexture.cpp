@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -565,8 +565,15 @@ TEST_F( TestDemandTexture, TestDuplicateTexture )
     DemandTextureImpl* dupeTexPtr = (DemandTextureImpl*)&dupeTex;
     DemandTextureImpl* nonDupeTexPtr = (DemandTextureImpl*)&nonDupeTex;
 
-    // Make sure that the duplcate textures are considered to be duplicates.
+    // A texture with the same image is a variant immediately, but an identical image isn't hashed
+    // until its texture is requested.
     EXPECT_TRUE( copyTexPtr->getMasterTexture() == &baseTex );
+    EXPECT_TRUE( dupeTexPtr->getMasterTexture() == nullptr );
+    m_loader->initTexture( m_stream, baseTex.getId() );
+    m_loader->initTexture( m_stream, dupeTex.getId() );
+    m_loader->initTexture( m_stream, nonDupeTex.getId() );
+
+    // Make sure that the duplcate textures are considered to be duplicates.
     EXPECT_TRUE( dupeTexPtr->getMasterTexture() == &baseTex );
 
     // Make sure the non-duplicate texture is not considered to be a duplicate.
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "HostPageTable.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace demandLoading;
+
+class TestHostPageTable : public testing::Test
+{
+  public:
+    const unsigned int NUM_PAGES = 16 * HostPageTable::CHUNK_SIZE + 17;
+    HostPageTable      table;
+
+    TestHostPageTable()
+        : table( NUM_PAGES )
+    {
+    }
+
+    static HostPageTable::Entry residentEntry( unsigned long long value )
+    {
+        return HostPageTable::Entry{value, true, true, false, false};
+    }
+};
+
+TEST_F( TestHostPageTable, EmptyTable )
+{
+    EXPECT_EQ( 0u, table.size() );
+    EXPECT_EQ( NUM_PAGES, table.capacity() );
+    EXPECT_EQ( nullptr, table.find( 0 ) );
+    EXPECT_EQ( nullptr, table.find( NUM_PAGES - 1 ) );
+    EXPECT_EQ( nullptr, table.find( NUM_PAGES ) );
+
+    unsigned int pageId = 0;
+    EXPECT_EQ( nullptr, table.next( pageId, NUM_PAGES ) );
+}
+
+TEST_F( TestHostPageTable, InsertFind )
+{
+    table.insert( 5, residentEntry( 50 ) );
+    table.insert( NUM_PAGES - 1, residentEntry( 60 ) );
+    EXPECT_EQ( 2u, table.size() );
+
+    HostPageTable::Entry* e = table.find( 5 );
+    ASSERT_NE( nullptr, e );
+    EXPECT_EQ( 50ULL, e->entry );
+    EXPECT_TRUE( e->resident );
+    EXPECT_EQ( 60ULL, table.find( NUM_PAGES - 1 )->entry );
+    EXPECT_EQ( nullptr, table.find( 4 ) );
+}
+
+TEST_F( TestHostPageTable, InsertOverwrites )
+{
+    table.insert( 7, residentEntry( 1 ) );
+    table.insert( 7, residentEntry( 2 ) );
+    EXPECT_EQ( 1u, table.size() );
+    EXPECT_EQ( 2ULL, table.find( 7 )->entry );
+}
+
+TEST_F( TestHostPageTable, Erase )
+{
+    table.insert( 7, residentEntry( 1 ) );
+    table.erase( 7 );
+    table.erase( 7 );
+    table.erase( 8 );
+    EXPECT_EQ( 0u, table.size() );
+    EXPECT_EQ( nullptr, table.find( 7 ) );
+}
+
+TEST_F( TestHostPageTable, EntryFlagsAreMutable )
+{
+    table.insert( 3, residentEntry( 1 ) );
+    HostPageTable::Entry* e = table.find( 3 );
+    e->resident             = false;
+    e->staged               = true;
+    EXPECT_FALSE( table.find( 3 )->resident );
+    EXPECT_TRUE( table.find( 3 )->staged );
+}
+
+TEST_F( TestHostPageTable, WalkRangeInOrder )
+{
+    const std::vector<unsigned int> pages{1, HostPageTable::CHUNK_SIZE - 1, HostPageTable::CHUNK_SIZE,
+                                          9 * HostPageTable::CHUNK_SIZE + 3, NUM_PAGES - 1};
+    for( auto it = pages.rbegin(); it != pages.rend(); ++it )
+        table.insert( *it, residentEntry( *it ) );
+
+    std::vector<unsigned int> visited;
+    unsigned int              pageId = 0;
+    for( HostPageTable::Entry* e = table.next( pageId, NUM_PAGES ); e; e = table.next( ++pageId, NUM_PAGES ) )
+    {
+        EXPECT_EQ( pageId, e->entry );
+        visited.push_back( pageId );
+    }
+    EXPECT_EQ( pages, visited );
+}
+
+TEST_F( TestHostPageTable, WalkSubrange )
+{
+    for( unsigned int i = 0; i < NUM_PAGES; i += 100 )
+        table.insert( i, residentEntry( i ) );
+
+    const unsigned int startId = 250;
+    const unsigned int endId   = 3 * HostPageTable::CHUNK_SIZE + 1;
+    unsigned int       count   = 0;
+    unsigned int       pageId  = startId;
+    for( HostPageTable::Entry* e = table.next( pageId, endId ); e; e = table.next( ++pageId, endId ) )
+    {
+        EXPECT_GE( pageId, startId );
+        EXPECT_LT( pageId, endId );
+        EXPECT_EQ( 0u, pageId % 100 );
+        ++count;
+    }
+    EXPECT_EQ( ( endId - 1 ) / 100 - 2, count );
+}
+
+TEST_F( TestHostPageTable, EraseWhileWalking )
+{
+    for( unsigned int i = 0; i < 2 * HostPageTable::CHUNK_SIZE; ++i )
+        table.insert( i, residentEntry( i ) );
+
+    unsigned int pageId = 0;
+    for( HostPageTable::Entry* e = table.next( pageId, NUM_PAGES ); e; e = table.next( ++pageId, NUM_PAGES ) )
+    {
+        if( pageId % 2 == 0 )
+            table.erase( pageId );
+    }
+    EXPECT_EQ( static_cast<size_t>( HostPageTable::CHUNK_SIZE ), table.size() );
+    EXPECT_EQ( nullptr, table.find( 0 ) );
+    EXPECT_NE( nullptr, table.find( 1 ) );
+}
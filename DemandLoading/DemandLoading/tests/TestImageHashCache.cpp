@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "Util/ImageHashCache.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace demandLoading;
+
+namespace {
+
+const char* const CACHE_FILENAME = "testImageHashCache.txt";
+const char* const IMAGE_FILENAME = "test image hash cache.img";  // a path with spaces
+
+void writeImage( const std::string& contents )
+{
+    std::ofstream file( IMAGE_FILENAME, std::ios::binary | std::ios::trunc );
+    file << contents;
+}
+
+}  // namespace
+
+class TestImageHashCache : public testing::Test
+{
+  public:
+    void SetUp() override { writeImage( "image" ); }
+    void TearDown() override
+    {
+        std::remove( CACHE_FILENAME );
+        std::remove( IMAGE_FILENAME );
+    }
+};
+
+TEST_F( TestImageHashCache, RoundTrip )
+{
+    {
+        ImageHashCache cache( CACHE_FILENAME );
+        EXPECT_EQ( 0u, cache.size() );
+        cache.insert( IMAGE_FILENAME, 0x0123456789abcdefULL );
+        EXPECT_TRUE( cache.save() );
+    }
+
+    ImageHashCache     cache( CACHE_FILENAME );
+    unsigned long long hash = 0;
+    EXPECT_EQ( 1u, cache.size() );
+    EXPECT_TRUE( cache.find( IMAGE_FILENAME, &hash ) );
+    EXPECT_EQ( 0x0123456789abcdefULL, hash );
+}
+
+TEST_F( TestImageHashCache, MissingFileIsNotCached )
+{
+    ImageHashCache     cache( CACHE_FILENAME );
+    unsigned long long hash = 0;
+    cache.insert( "no such image.img", 1 );
+    EXPECT_EQ( 0u, cache.size() );
+    EXPECT_FALSE( cache.find( "no such image.img", &hash ) );
+}
+
+TEST_F( TestImageHashCache, ChangedFileIsNotFound )
+{
+    ImageHashCache cache( CACHE_FILENAME );
+    cache.insert( IMAGE_FILENAME, 1 );
+
+    // Changing the file size invalidates the entry.
+    writeImage( "a larger image" );
+    unsigned long long hash = 0;
+    EXPECT_FALSE( cache.find( IMAGE_FILENAME, &hash ) );
+
+    cache.insert( IMAGE_FILENAME, 2 );
+    EXPECT_TRUE( cache.find( IMAGE_FILENAME, &hash ) );
+    EXPECT_EQ( 2ULL, hash );
+}
+
+TEST_F( TestImageHashCache, OutdatedVersionIsIgnored )
+{
+    {
+        ImageHashCache cache( CACHE_FILENAME );
+        cache.insert( IMAGE_FILENAME, 1 );
+    }
+    {
+        std::ofstream file( CACHE_FILENAME, std::ios::trunc );
+        file << "OTKIMAGEHASH " << IMAGE_HASH_CACHE_VERSION + 1 << "\n1 0 5 " << IMAGE_FILENAME << '\n';
+    }
+    ImageHashCache cache( CACHE_FILENAME );
+    EXPECT_EQ( 0u, cache.size() );
+}
+
+TEST_F( TestImageHashCache, OpenSharesCache )
+{
+    std::shared_ptr<ImageHashCache> cache1 = ImageHashCache::open( CACHE_FILENAME );
+    std::shared_ptr<ImageHashCache> cache2 = ImageHashCache::open( CACHE_FILENAME );
+    EXPECT_EQ( cache1.get(), cache2.get() );
+}
@@ -0,0 +1,301 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "PageTableManager.h"
+#include "RequestQueue.h"
+#include "TicketImpl.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+using namespace demandLoading;
+
+namespace {
+
+// Counts the number of times each page is filled.
+class FakeRequestHandler : public RequestHandler
+{
+  public:
+    explicit FakeRequestHandler( unsigned int numPages )
+        : m_fillCounts( numPages )
+    {
+    }
+
+    void fillRequest( CUstream /*stream*/, unsigned int pageId ) override
+    {
+        ++m_fillCounts[pageId - m_startPage];
+    }
+
+    unsigned int fillCount( unsigned int pageId ) const { return m_fillCounts[pageId - m_startPage]; }
+
+  private:
+    std::vector<std::atomic<unsigned int>> m_fillCounts;
+};
+
+std::vector<unsigned int> makePageIds( unsigned int first, unsigned int count )
+{
+    std::vector<unsigned int> pageIds( count );
+    std::iota( pageIds.begin(), pageIds.end(), first );
+    return pageIds;
+}
+
+}  // namespace
+
+class TestRequestQueue : public testing::Test
+{
+  public:
+    const unsigned int MAX_QUEUE_SIZE = 1024;
+};
+
+TEST_F( TestRequestQueue, PushUpdatesTicket )
+{
+    RequestQueue              queue( MAX_QUEUE_SIZE );
+    Ticket                    ticket = TicketImpl::create( CUstream{} );
+    std::vector<unsigned int> pageIds = makePageIds( 0, 5 );
+
+    queue.push( pageIds.data(), static_cast<unsigned int>( pageIds.size() ), ticket );
+
+    EXPECT_EQ( 5, ticket.numTasksTotal() );
+    EXPECT_EQ( 5u, queue.size() );
+}
+
+TEST_F( TestRequestQueue, EmptyPushCompletesTicket )
+{
+    RequestQueue queue( MAX_QUEUE_SIZE );
+    Ticket       ticket = TicketImpl::create( CUstream{} );
+
+    queue.push( nullptr, 0, ticket );
+
+    EXPECT_EQ( 0, ticket.numTasksTotal() );
+    ticket.wait();
+}
+
+TEST_F( TestRequestQueue, PopReturnsChunksInOrder )
+{
+    RequestQueue              queue( MAX_QUEUE_SIZE );
+    Ticket                    ticket  = TicketImpl::create( CUstream{} );
+    std::vector<unsigned int> pageIds = makePageIds( 100, 3 * RequestQueue::MAX_CHUNK_SIZE + 1 );
+    queue.push( pageIds.data(), static_cast<unsigned int>( pageIds.size() ), ticket );
+
+    std::vector<unsigned int> popped;
+    RequestChunk              chunk;
+    while( queue.size() > 0 && queue.popOrWait( 0, &chunk ) )
+    {
+        EXPECT_LE( chunk.size(), RequestQueue::MAX_CHUNK_SIZE );
+        popped.insert( popped.end(), chunk.pageIds(), chunk.pageIds() + chunk.size() );
+    }
+    EXPECT_EQ( pageIds, popped );
+}
+
+TEST_F( TestRequestQueue, SmallBatchIsSpreadAcrossWorkers )
+{
+    const unsigned int        numWorkers = 4;
+    RequestQueue              queue( MAX_QUEUE_SIZE, numWorkers );
+    Ticket                    ticket  = TicketImpl::create( CUstream{} );
+    std::vector<unsigned int> pageIds = makePageIds( 0, 8 );
+    queue.push( pageIds.data(), static_cast<unsigned int>( pageIds.size() ), ticket );
+
+    // Each worker pops a chunk of two requests from its own deque.
+    std::vector<unsigned int> popped;
+    for( unsigned int worker = 0; worker < numWorkers; ++worker )
+    {
+        RequestChunk chunk;
+        ASSERT_TRUE( queue.popOrWait( worker, &chunk ) );
+        EXPECT_EQ( 2u, chunk.size() );
+        popped.insert( popped.end(), chunk.pageIds(), chunk.pageIds() + chunk.size() );
+    }
+    std::sort( popped.begin(), popped.end() );
+    EXPECT_EQ( pageIds, popped );
+    EXPECT_EQ( 0u, queue.size() );
+}
+
+TEST_F( TestRequestQueue, WorkerStealsFromOtherDeques )
+{
+    RequestQueue              queue( MAX_QUEUE_SIZE, 8 );
+    Ticket                    ticket  = TicketImpl::create( CUstream{} );
+    std::vector<unsigned int> pageIds = makePageIds( 0, 200 );
+    queue.push( pageIds.data(), static_cast<unsigned int>( pageIds.size() ), ticket );
+
+    unsigned int numPopped = 0;
+    RequestChunk chunk;
+    while( queue.size() > 0 && queue.popOrWait( 3, &chunk ) )
+        numPopped += chunk.size();
+    EXPECT_EQ( 200u, numPopped );
+}
+
+TEST_F( TestRequestQueue, PushIsLimitedByMaxQueueSize )
+{
+    RequestQueue              queue( 10 );
+    Ticket                    ticket1 = TicketImpl::create( CUstream{} );
+    Ticket                    ticket2 = TicketImpl::create( CUstream{} );
+    std::vector<unsigned int> pageIds = makePageIds( 0, 8 );
+
+    queue.push( pageIds.data(), static_cast<unsigned int>( pageIds.size() ), ticket1 );
+    queue.push( pageIds.data(), static_cast<unsigned int>( pageIds.size() ), ticket2 );
+
+    EXPECT_EQ( 8, ticket1.numTasksTotal() );
+    EXPECT_EQ( 2, ticket2.numTasksTotal() );
+    EXPECT_EQ( 10u, queue.size() );
+}
+
+TEST_F( TestRequestQueue, PushReturnsNumPushed )
+{
+    RequestQueue              queue( 10 );
+    Ticket                    ticket  = TicketImpl::create( CUstream{} );
+    std::vector<unsigned int> pageIds = makePageIds( 0, 16 );
+
+    EXPECT_EQ( 10u, queue.push( pageIds.data(), static_cast<unsigned int>( pageIds.size() ), ticket, nullptr, 3 ) );
+    EXPECT_EQ( 13, ticket.numTasksTotal() );
+}
+
+TEST_F( TestRequestQueue, UrgentChunksArePoppedFirst )
+{
+    RequestQueue              queue( MAX_QUEUE_SIZE );
+    Ticket                    ticket1  = TicketImpl::create( CUstream{} );
+    Ticket                    ticket2  = TicketImpl::create( CUstream{} );
+    std::vector<unsigned int> pageIds1 = makePageIds( 0, 40 );
+    std::vector<unsigned int> pageIds2 = makePageIds( 100, 6 );
+    std::vector<unsigned int> priorities1( pageIds1.size(), 5 );
+    std::vector<unsigned int> priorities2{0, 0, 1, 1, 1, 7};
+    queue.push( pageIds1.data(), static_cast<unsigned int>( pageIds1.size() ), ticket1, priorities1.data() );
+    queue.push( pageIds2.data(), static_cast<unsigned int>( pageIds2.size() ), ticket2, priorities2.data() );
+
+    // Chunks are popped in priority order, and a chunk never mixes priorities.
+    std::vector<unsigned int> popped;
+    RequestChunk              chunk;
+    while( queue.size() > 0 && queue.popOrWait( 0, &chunk ) )
+    {
+        for( unsigned int i = 0; i < chunk.size(); ++i )
+        {
+            const unsigned int pageId = chunk.pageIds()[i];
+            EXPECT_EQ( pageId < 100 ? 5u : priorities2[pageId - 100], chunk.priority );
+            popped.push_back( pageId );
+        }
+    }
+    std::vector<unsigned int> expected{100, 101, 102, 103, 104};
+    expected.insert( expected.end(), pageIds1.begin(), pageIds1.end() );
+    expected.push_back( 105 );
+    EXPECT_EQ( expected, popped );
+}
+
+TEST_F( TestRequestQueue, ShutDownWakesWaitingWorkers )
+{
+    RequestQueue             queue( MAX_QUEUE_SIZE, 4 );
+    std::atomic<int>         numExited( 0 );
+    std::vector<std::thread> workers;
+    for( unsigned int i = 0; i < 4; ++i )
+    {
+        workers.emplace_back( [&queue, &numExited, i] {
+            RequestChunk chunk;
+            EXPECT_FALSE( queue.popOrWait( i, &chunk ) );
+            ++numExited;
+        } );
+    }
+    queue.shutDown();
+    for( std::thread& worker : workers )
+        worker.join();
+    EXPECT_EQ( 4, numExited.load() );
+}
+
+TEST_F( TestRequestQueue, TasksArePoppedWhenNoRequestsRemain )
+{
+    RequestQueue              queue( MAX_QUEUE_SIZE );
+    Ticket                    ticket  = TicketImpl::create( CUstream{} );
+    std::vector<unsigned int> pageIds = makePageIds( 0, 3 );
+    int                       numRun  = 0;
+    queue.pushTask( [&numRun] { ++numRun; } );
+    queue.push( pageIds.data(), static_cast<unsigned int>( pageIds.size() ), ticket );
+    EXPECT_EQ( 1u, queue.numTasks() );
+
+    // The request chunk is popped before the task, which was pushed first.
+    RequestChunk          chunk;
+    std::function<void()> task;
+    ASSERT_TRUE( queue.popOrWait( 0, &chunk, &task ) );
+    EXPECT_FALSE( task );
+    EXPECT_EQ( 3u, chunk.size() );
+
+    chunk = RequestChunk();
+    ASSERT_TRUE( queue.popOrWait( 0, &chunk, &task ) );
+    ASSERT_TRUE( bool( task ) );
+    EXPECT_EQ( nullptr, chunk.batch );
+    task();
+    EXPECT_EQ( 1, numRun );
+    EXPECT_EQ( 0u, queue.numTasks() );
+}
+
+TEST_F( TestRequestQueue, ShutDownDiscardsTasks )
+{
+    RequestQueue queue( MAX_QUEUE_SIZE );
+    queue.pushTask( [] {} );
+    queue.shutDown();
+    EXPECT_EQ( 0u, queue.numTasks() );
+
+    // Tasks pushed after shutdown are dropped, and no task is popped.
+    queue.pushTask( [] {} );
+    EXPECT_EQ( 0u, queue.numTasks() );
+    RequestChunk          chunk;
+    std::function<void()> task;
+    EXPECT_FALSE( queue.popOrWait( 0, &chunk, &task ) );
+    EXPECT_FALSE( task );
+}
+
+TEST_F( TestRequestQueue, WorkersFillEveryRequestOnce )
+{
+    const unsigned int numPages   = 4096;
+    const unsigned int numWorkers = 8;
+    const unsigned int numBatches = 16;
+
+    PageTableManager   pageTableManager( 1u << 20, 1u << 16 );
+    FakeRequestHandler handler( numPages );
+    const unsigned int startPage = pageTableManager.reserveBackedPages( numPages, &handler );
+
+    RequestQueue             queue( numPages, numWorkers );
+    std::vector<std::thread> workers;
+    for( unsigned int i = 0; i < numWorkers; ++i )
+    {
+        workers.emplace_back( [&queue, &pageTableManager, i] {
+            RequestChunk chunk;
+            while( queue.popOrWait( i, &chunk ) )
+            {
+                for( unsigned int j = 0; j < chunk.size(); ++j )
+                {
+                    RequestHandler* requestHandler = pageTableManager.getRequestHandler( chunk.pageIds()[j] );
+                    requestHandler->fillRequest( CUstream{}, chunk.pageIds()[j] );
+                }
+                TicketImpl::getImpl( chunk.batch->ticket )->notify( chunk.size() );
+                chunk = RequestChunk();
+            }
+        } );
+    }
+
+    // Push disjoint batches of varying sizes, then wait for all of them to be filled.
+    std::vector<Ticket> tickets;
+    const unsigned int  pagesPerBatch = numPages / numBatches;
+    for( unsigned int b = 0; b < numBatches; ++b )
+    {
+        tickets.push_back( TicketImpl::create( CUstream{} ) );
+        std::vector<unsigned int> pageIds = makePageIds( startPage + b * pagesPerBatch, 1 + b * ( pagesPerBatch - 1 ) / numBatches );
+        queue.push( pageIds.data(), static_cast<unsigned int>( pageIds.size() ), tickets.back() );
+    }
+    for( Ticket& ticket : tickets )
+        ticket.wait();
+
+    queue.shutDown();
+    for( std::thread& worker : workers )
+        worker.join();
+
+    for( unsigned int b = 0; b < numBatches; ++b )
+    {
+        const unsigned int first = startPage + b * pagesPerBatch;
+        const unsigned int count = 1 + b * ( pagesPerBatch - 1 ) / numBatches;
+        for( unsigned int pageId = first; pageId < first + pagesPerBatch; ++pageId )
+            EXPECT_EQ( pageId < first + count ? 1u : 0u, handler.fillCount( pageId ) );
+    }
+}
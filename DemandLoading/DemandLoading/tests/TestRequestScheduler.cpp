@@ -0,0 +1,185 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "CoarseFirstPriorityPolicy.h"
+#include "PageTableManager.h"
+#include "RequestQueue.h"
+#include "RequestScheduler.h"
+#include "TicketImpl.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace demandLoading;
+
+namespace {
+
+// Describes pages like a texture: the first page is the mip tail, and the remaining pages are
+// tiles, each page one mip level finer than the previous one.
+class FakeTextureRequestHandler : public RequestHandler
+{
+  public:
+    RequestInfo getRequestInfo( unsigned int pageId ) override
+    {
+        if( pageId == m_startPage )
+            return RequestInfo{pageId, RequestKind::MIP_TAIL, 0};
+        return RequestInfo{pageId, RequestKind::TILE, m_numPages - 1 - ( pageId - m_startPage )};
+    }
+};
+
+class FakeSamplerRequestHandler : public RequestHandler
+{
+  public:
+    RequestInfo getRequestInfo( unsigned int pageId ) override { return RequestInfo{pageId, RequestKind::SAMPLER, 0}; }
+};
+
+// Pop all the requests from the queue, optionally finishing them.
+std::vector<unsigned int> popAll( RequestQueue& queue, RequestScheduler* scheduler )
+{
+    std::vector<unsigned int> popped;
+    RequestChunk              chunk;
+    while( queue.size() > 0 && queue.popOrWait( 0, &chunk ) )
+    {
+        popped.insert( popped.end(), chunk.pageIds(), chunk.pageIds() + chunk.size() );
+        if( scheduler )
+        {
+            scheduler->finish( chunk.pageIds(), chunk.size() );
+            TicketImpl::getImpl( chunk.batch->ticket )->notify( chunk.size() );
+        }
+    }
+    return popped;
+}
+
+}  // namespace
+
+class TestRequestScheduler : public testing::Test
+{
+  public:
+    PageTableManager          pageTableManager;
+    FakeSamplerRequestHandler samplerHandler;
+    FakeTextureRequestHandler textureHandler;
+    RequestScheduler          scheduler;
+    RequestQueue              queue;
+    unsigned int              samplerStart;
+    unsigned int              textureStart;
+
+    TestRequestScheduler()
+        : pageTableManager( 1u << 20, 1u << 16 )
+        , scheduler( &pageTableManager )
+        , queue( 1024 )
+    {
+        samplerStart = pageTableManager.reserveBackedPages( 4, &samplerHandler );
+        textureStart = pageTableManager.reserveBackedPages( 8, &textureHandler );
+    }
+};
+
+TEST_F( TestRequestScheduler, CoarseFirstPolicy )
+{
+    CoarseFirstPriorityPolicy policy;
+    const unsigned int        sampler  = policy.priority( RequestInfo{0, RequestKind::SAMPLER, 0} );
+    const unsigned int        resource = policy.priority( RequestInfo{0, RequestKind::RESOURCE, 0} );
+    const unsigned int        mipTail  = policy.priority( RequestInfo{0, RequestKind::MIP_TAIL, 0} );
+    const unsigned int        coarse   = policy.priority( RequestInfo{0, RequestKind::TILE, 5} );
+    const unsigned int        fine     = policy.priority( RequestInfo{0, RequestKind::TILE, 0} );
+    EXPECT_EQ( sampler, resource );
+    EXPECT_LT( sampler, mipTail );
+    EXPECT_LT( mipTail, coarse );
+    EXPECT_LT( coarse, fine );
+    EXPECT_EQ( policy.priority( RequestInfo{0, RequestKind::TILE, 100} ),
+               policy.priority( RequestInfo{0, RequestKind::TILE, CoarseFirstPriorityPolicy::MAX_RANKED_MIP_LEVEL} ) );
+}
+
+TEST_F( TestRequestScheduler, RanksRequests )
+{
+    // Fine tiles, then coarse tiles, then the mip tail, then samplers.
+    std::vector<unsigned int> pageIds;
+    for( unsigned int i = 8; i > 0; --i )
+        pageIds.push_back( textureStart + i - 1 );
+    pageIds.push_back( samplerStart + 2 );
+    pageIds.push_back( samplerStart );
+
+    Ticket ticket = TicketImpl::create( CUstream{} );
+    scheduler.schedule( pageIds.data(), static_cast<unsigned int>( pageIds.size() ), ticket, &queue );
+    EXPECT_EQ( 10, ticket.numTasksTotal() );
+
+    std::vector<unsigned int> expected{samplerStart, samplerStart + 2};
+    for( unsigned int i = 0; i < 8; ++i )
+        expected.push_back( textureStart + i );
+    EXPECT_EQ( expected, popAll( queue, nullptr ) );
+}
+
+TEST_F( TestRequestScheduler, NullPolicyPreservesOrder )
+{
+    scheduler.setPriorityPolicy( nullptr );
+    std::vector<unsigned int> pageIds{textureStart + 5, samplerStart, textureStart, textureStart + 1};
+    Ticket                    ticket = TicketImpl::create( CUstream{} );
+    scheduler.schedule( pageIds.data(), static_cast<unsigned int>( pageIds.size() ), ticket, &queue );
+    EXPECT_EQ( pageIds, popAll( queue, nullptr ) );
+}
+
+TEST_F( TestRequestScheduler, DropsDuplicatesInBatch )
+{
+    std::vector<unsigned int> pageIds{textureStart + 1, textureStart + 1, textureStart + 2, textureStart + 1};
+    Ticket                    ticket = TicketImpl::create( CUstream{} );
+    scheduler.schedule( pageIds.data(), static_cast<unsigned int>( pageIds.size() ), ticket, &queue );
+
+    // The ticket tracks the dropped requests too.
+    EXPECT_EQ( 4, ticket.numTasksTotal() );
+    EXPECT_EQ( 2u, queue.size() );
+    EXPECT_EQ( 2u, scheduler.getNumInFlight() );
+
+    popAll( queue, &scheduler );
+    EXPECT_EQ( 0, ticket.numTasksRemaining() );
+    EXPECT_EQ( 0u, scheduler.getNumInFlight() );
+}
+
+TEST_F( TestRequestScheduler, DropsRequestsInFlight )
+{
+    std::vector<unsigned int> pageIds1{samplerStart, samplerStart + 1};
+    std::vector<unsigned int> pageIds2{samplerStart + 1, samplerStart + 2};
+    Ticket                    ticket1 = TicketImpl::create( CUstream{} );
+    Ticket                    ticket2 = TicketImpl::create( CUstream{} );
+    scheduler.schedule( pageIds1.data(), static_cast<unsigned int>( pageIds1.size() ), ticket1, &queue );
+    scheduler.schedule( pageIds2.data(), static_cast<unsigned int>( pageIds2.size() ), ticket2, &queue );
+    EXPECT_EQ( 3u, queue.size() );
+    EXPECT_EQ( 2, ticket2.numTasksTotal() );
+
+    // The second ticket isn't done until the first batch's request for the shared page is finished.
+    RequestChunk chunk;
+    ASSERT_TRUE( queue.popOrWait( 0, &chunk ) );
+    ASSERT_EQ( 2u, chunk.size() );
+    EXPECT_EQ( samplerStart, chunk.pageIds()[0] );
+    scheduler.finish( chunk.pageIds(), 1 );
+    EXPECT_EQ( 2, ticket2.numTasksRemaining() );
+    scheduler.finish( chunk.pageIds() + 1, 1 );
+    EXPECT_EQ( 1, ticket2.numTasksRemaining() );
+    TicketImpl::getImpl( chunk.batch->ticket )->notify( chunk.size() );
+    EXPECT_EQ( 0, ticket1.numTasksRemaining() );
+
+    popAll( queue, &scheduler );
+    EXPECT_EQ( 0, ticket2.numTasksRemaining() );
+
+    // Once finished, a page can be requested again.
+    Ticket ticket3 = TicketImpl::create( CUstream{} );
+    scheduler.schedule( pageIds1.data(), static_cast<unsigned int>( pageIds1.size() ), ticket3, &queue );
+    EXPECT_EQ( 2u, queue.size() );
+}
+
+TEST_F( TestRequestScheduler, RequestsThatDontFitAreNotInFlight )
+{
+    RequestQueue              smallQueue( 2 );
+    std::vector<unsigned int> pageIds1{textureStart + 7, textureStart + 6, textureStart + 5, textureStart + 7};
+    Ticket                    ticket1 = TicketImpl::create( CUstream{} );
+    scheduler.schedule( pageIds1.data(), static_cast<unsigned int>( pageIds1.size() ), ticket1, &smallQueue );
+
+    // The finest tile didn't fit, so its request and the duplicate request are both dropped.
+    EXPECT_EQ( 2u, smallQueue.size() );
+    EXPECT_EQ( 2u, scheduler.getNumInFlight() );
+    EXPECT_EQ( 3, ticket1.numTasksTotal() );
+    EXPECT_EQ( 2, ticket1.numTasksRemaining() );
+
+    popAll( smallQueue, &scheduler );
+    EXPECT_EQ( 0, ticket1.numTasksRemaining() );
+}
@@ -0,0 +1,188 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "Memory/DeviceMemoryManager.h"
+#include "TileContentHash.h"
+
+#include <OptiXToolkit/Error/cudaErrorCheck.h>
+
+#include <gtest/gtest.h>
+
+#include <cuda.h>
+#include <cuda_runtime.h>
+
+#include <algorithm>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+using namespace demandLoading;
+using namespace otk;
+
+namespace {
+
+const unsigned int TILE_WIDTH      = 128;  // 64 KB tiles of uchar4 texels are 128x128.
+const unsigned int TILE_HEIGHT     = 128;
+const unsigned int TILES_PER_IMAGE = 8;
+
+using Tile  = std::vector<uchar4>;
+using Image = std::vector<Tile>;
+
+// Make a tile of a smooth gradient, which differs from tile to tile by its seed.
+Tile makeTile( unsigned int seed )
+{
+    Tile tile( TILE_WIDTH * TILE_HEIGHT );
+    for( unsigned int y = 0; y < TILE_HEIGHT; ++y )
+    {
+        for( unsigned int x = 0; x < TILE_WIDTH; ++x )
+            tile[y * TILE_WIDTH + x] = make_uchar4( x + seed, y + 3 * seed, x + y, 255 );
+    }
+    return tile;
+}
+
+// Make an image (a row of tiles) whose tiles are seeded from the first seed on.
+Image makeImage( unsigned int firstSeed )
+{
+    Image image;
+    for( unsigned int i = 0; i < TILES_PER_IMAGE; ++i )
+        image.push_back( makeTile( firstSeed + i ) );
+    return image;
+}
+
+TileContentHash hashTile( const Tile& tile, CUarray_format format = CU_AD_FORMAT_UNSIGNED_INT8, unsigned int numChannels = 4 )
+{
+    return hashTileContent( reinterpret_cast<const char*>( tile.data() ), TILE_SIZE_IN_BYTES, format, numChannels );
+}
+
+size_t countUniqueTiles( const std::vector<Image>& images )
+{
+    std::unordered_set<TileContentHash, TileContentHashHash> hashes;
+    for( const Image& image : images )
+    {
+        for( const Tile& tile : image )
+            hashes.insert( hashTile( tile ) );
+    }
+    return hashes.size();
+}
+
+}  // namespace
+
+class TestTileContentHash : public testing::Test
+{
+};
+
+TEST_F( TestTileContentHash, IdenticalTilesHashEqually )
+{
+    const Tile tile = makeTile( 7 );
+    const Tile copy = tile;
+    EXPECT_TRUE( hashTile( tile ) == hashTile( copy ) );
+    EXPECT_EQ( TileContentHashHash()( hashTile( tile ) ), TileContentHashHash()( hashTile( copy ) ) );
+}
+
+TEST_F( TestTileContentHash, DuplicateImagesShareAllTiles )
+{
+    // A texture and an identical copy of it, as in a duplicated UDIM set.
+    std::vector<Image> images{ makeImage( 0 ), makeImage( 0 ) };
+    EXPECT_EQ( TILES_PER_IMAGE, countUniqueTiles( images ) );
+}
+
+TEST_F( TestTileContentHash, VariantImagesShareUnchangedTiles )
+{
+    // A variant of a texture with two tiles painted over, and an image that overlaps it by half.
+    Image base    = makeImage( 0 );
+    Image variant = base;
+    variant[2][100].x ^= 1;
+    variant[5] = makeTile( 1000 );
+    Image shifted = makeImage( TILES_PER_IMAGE / 2 );
+
+    std::vector<Image> images{ base, variant, shifted };
+    EXPECT_EQ( TILES_PER_IMAGE + 2 + TILES_PER_IMAGE / 2, countUniqueTiles( images ) );
+}
+
+TEST_F( TestTileContentHash, EveryBitChangesHash )
+{
+    const Tile            tile = makeTile( 0 );
+    const TileContentHash hash = hashTile( tile );
+
+    // Flip bits at every byte offset of a 32-byte stripe, and in stripes across the tile.
+    for( unsigned int offset = 0; offset < TILE_SIZE_IN_BYTES; offset += offset < 32 ? 1 : 4093 )
+    {
+        Tile changed = tile;
+        reinterpret_cast<char*>( changed.data() )[offset] ^= 1 << ( offset % 8 );
+        EXPECT_FALSE( hashTile( changed ) == hash ) << "offset " << offset;
+    }
+}
+
+TEST_F( TestTileContentHash, SwappedStripesChangeHash )
+{
+    Tile tile    = makeTile( 0 );
+    Tile swapped = tile;
+    std::swap_ranges( swapped.begin(), swapped.begin() + 8, swapped.begin() + 8 );
+    EXPECT_FALSE( hashTile( tile ) == hashTile( swapped ) );
+}
+
+TEST_F( TestTileContentHash, FormatIsPartOfHash )
+{
+    const Tile tile = makeTile( 0 );
+    EXPECT_FALSE( hashTile( tile, CU_AD_FORMAT_UNSIGNED_INT8, 4 ) == hashTile( tile, CU_AD_FORMAT_UNSIGNED_INT32, 1 ) );
+    EXPECT_FALSE( hashTile( tile, CU_AD_FORMAT_UNSIGNED_INT8, 4 ) == hashTile( tile, CU_AD_FORMAT_UNSIGNED_INT8, 2 ) );
+}
+
+TEST_F( TestTileContentHash, NoCollisionsAmongManyTiles )
+{
+    const unsigned int numTiles = 1024;
+    Tile               tile     = makeTile( 0 );
+    std::unordered_set<TileContentHash, TileContentHashHash> hashes;
+    for( unsigned int i = 0; i < numTiles; ++i )
+    {
+        // Tiles that differ only in a single texel counter.
+        tile[TILE_WIDTH * TILE_HEIGHT / 2].x = static_cast<unsigned char>( i );
+        tile[TILE_WIDTH * TILE_HEIGHT / 2].y = static_cast<unsigned char>( i >> 8 );
+        hashes.insert( hashTile( tile ) );
+    }
+    EXPECT_EQ( numTiles, hashes.size() );
+}
+
+class TestDuplicateTileSharing : public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+        OTK_ERROR_CHECK( cudaSetDevice( 0 ) );
+        OTK_ERROR_CHECK( cudaFree( nullptr ) );
+        std::shared_ptr<Options> options( new Options );
+        options->coalesceDuplicateTiles = true;
+        m_manager.reset( new DeviceMemoryManager( options ) );
+    }
+
+  protected:
+    std::unique_ptr<DeviceMemoryManager> m_manager;
+};
+
+TEST_F( TestDuplicateTileSharing, SharedTileIsReferenceCounted )
+{
+    const TileContentHash hash   = hashTile( makeTile( 0 ) );
+    TileBlockHandle       first  = m_manager->allocateTileBlock( TILE_SIZE_IN_BYTES );
+    TileBlockHandle       second = m_manager->allocateTileBlock( TILE_SIZE_IN_BYTES );
+
+    EXPECT_TRUE( m_manager->shareDuplicateTile( hash, first ) == first );
+    EXPECT_TRUE( m_manager->shareDuplicateTile( hash, second ) == first );
+    EXPECT_EQ( 1U, m_manager->getNumTilesDeduplicated() );
+    EXPECT_TRUE( m_manager->isSharedTile( first.block ) );
+    EXPECT_FALSE( m_manager->isUniformTile( first.block ) );
+
+    // The duplicate block isn't shared, so it is freed.
+    EXPECT_FALSE( m_manager->isSharedTile( second.block ) );
+    m_manager->freeTileBlock( second.block );
+
+    // The shared block is freed with its last reference, after which its contents can be shared again.
+    m_manager->freeTileBlock( first.block );
+    EXPECT_TRUE( m_manager->isSharedTile( first.block ) );
+    m_manager->freeTileBlock( first.block );
+    EXPECT_FALSE( m_manager->isSharedTile( first.block ) );
+
+    TileBlockHandle third = m_manager->allocateTileBlock( TILE_SIZE_IN_BYTES );
+    EXPECT_TRUE( m_manager->shareDuplicateTile( hash, third ) == third );
+    m_manager->freeTileBlock( third.block );
+}
@@ -0,0 +1,349 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "Util/TraceFile.h"
+
+#include <OptiXToolkit/ImageSource/DDSImageReader.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <vector>
+
+using namespace demandLoading;
+
+namespace {
+
+const char* const TRACE_FILENAME = "testTraceFile.trace";
+
+}  // namespace
+
+class TestTraceFile : public testing::Test
+{
+  public:
+    void TearDown() override { std::remove( TRACE_FILENAME ); }
+};
+
+TEST_F( TestTraceFile, RoundTrip )
+{
+    Options options;
+    options.maxThreads      = 3;
+    options.useLruTable     = false;
+    options.maxPinnedMemory = 5ULL << 32;
+
+    TextureDescriptor desc;
+    desc.addressMode[0] = CU_TR_ADDRESS_MODE_CLAMP;
+    desc.maxAnisotropy  = 4;
+
+    imageSource::TextureInfo info{512, 256, CU_AD_FORMAT_HALF, 4, 10, true, true};
+
+    const std::vector<unsigned int> requests{1000, 999, 4000000, 0, 17};
+    const std::vector<unsigned int> fills{2, 3, 5};
+    {
+        std::shared_ptr<TraceFileWriter> writer = TraceFileWriter::open( TRACE_FILENAME );
+        writer->recordOptions( 1, options );
+        writer->recordTexture( 1, 7, imageSource::DDSImageReader( "images/brick.dds", false ), desc );
+        writer->recordTextureInfo( 1, 7, info );
+        writer->recordRequests( 1, CUstream{}, requests.data(), static_cast<unsigned int>( requests.size() ) );
+        writer->recordFill( 1, fills.data(), static_cast<unsigned int>( fills.size() ), 0, 12345, 65536 * 3 );
+        writer->recordStaging( 1, requests.data(), 2 );
+        writer->recordEviction( 1, requests.data() + 2, 1 );
+        writer->recordInvalidation( 1, 100, 200, true );
+    }
+
+    TraceFileReader reader( TRACE_FILENAME );
+    EXPECT_EQ( TRACE_FILE_VERSION, reader.getVersion() );
+    EXPECT_EQ( 1U, reader.getNumBlocks() );
+
+    TraceRecord record;
+    ASSERT_TRUE( reader.readRecord( record ) );
+    EXPECT_EQ( TraceRecordType::OPTIONS, record.type );
+    EXPECT_EQ( 1U, record.deviceIndex );
+    EXPECT_EQ( 3U, record.options.maxThreads );
+    EXPECT_FALSE( record.options.useLruTable );
+    EXPECT_EQ( options.maxPinnedMemory, record.options.maxPinnedMemory );
+    EXPECT_EQ( options.numPages, record.options.numPages );
+
+    ASSERT_TRUE( reader.readRecord( record ) );
+    EXPECT_EQ( TraceRecordType::TEXTURE, record.type );
+    EXPECT_EQ( 7U, record.textureId );
+    EXPECT_EQ( "images/brick.dds", record.imagePath );
+    EXPECT_TRUE( desc == record.textureDesc );
+
+    ASSERT_TRUE( reader.readRecord( record ) );
+    EXPECT_EQ( TraceRecordType::TEXTURE_INFO, record.type );
+    EXPECT_TRUE( info == record.textureInfo );
+
+    ASSERT_TRUE( reader.readRecord( record ) );
+    EXPECT_EQ( TraceRecordType::REQUESTS, record.type );
+    EXPECT_EQ( 0U, record.streamId );
+    EXPECT_EQ( requests, record.pageIds );
+    const uint64_t requestTime = record.timestamp;
+
+    ASSERT_TRUE( reader.readRecord( record ) );
+    EXPECT_EQ( TraceRecordType::FILL, record.type );
+    EXPECT_EQ( fills, record.pageIds );
+    EXPECT_EQ( 0ULL, record.timestamp );
+    EXPECT_LE( record.timestamp, requestTime );
+    EXPECT_EQ( 12345ULL, record.duration );
+    EXPECT_EQ( 65536ULL * 3, record.bytesRead );
+
+    ASSERT_TRUE( reader.readRecord( record ) );
+    EXPECT_EQ( TraceRecordType::STAGING, record.type );
+    EXPECT_EQ( std::vector<unsigned int>( requests.begin(), requests.begin() + 2 ), record.pageIds );
+    EXPECT_GE( record.timestamp, requestTime );
+
+    ASSERT_TRUE( reader.readRecord( record ) );
+    EXPECT_EQ( TraceRecordType::EVICTION, record.type );
+    EXPECT_EQ( std::vector<unsigned int>{requests[2]}, record.pageIds );
+
+    ASSERT_TRUE( reader.readRecord( record ) );
+    EXPECT_EQ( TraceRecordType::INVALIDATION, record.type );
+    EXPECT_EQ( 100U, record.startPage );
+    EXPECT_EQ( 200U, record.endPage );
+    EXPECT_TRUE( record.hasPredicate );
+
+    EXPECT_FALSE( reader.readRecord( record ) );
+}
+
+TEST_F( TestTraceFile, WritersAreShared )
+{
+    std::shared_ptr<TraceFileWriter> writer = TraceFileWriter::open( TRACE_FILENAME );
+    EXPECT_EQ( writer, TraceFileWriter::open( TRACE_FILENAME ) );
+}
+
+TEST_F( TestTraceFile, SeekLargeTrace )
+{
+    // Write enough random requests to fill several blocks.
+    const unsigned int numBatches = 4000;
+    const unsigned int batchSize  = 256;
+    std::mt19937       rng( 7 );
+    {
+        std::shared_ptr<TraceFileWriter> writer = TraceFileWriter::open( TRACE_FILENAME );
+        std::vector<unsigned int>        pageIds( batchSize );
+        for( unsigned int batch = 0; batch < numBatches; ++batch )
+        {
+            for( unsigned int& pageId : pageIds )
+                pageId = rng() % ( 1 << 26 );
+            writer->recordRequests( 0, reinterpret_cast<CUstream>( static_cast<uintptr_t>( batch % 2 + 1 ) ), pageIds.data(), batchSize );
+        }
+    }
+
+    TraceFileReader reader( TRACE_FILENAME );
+    ASSERT_GT( reader.getNumBlocks(), 2U );
+
+    // Read every record, collecting timestamps.
+    std::vector<uint64_t> timestamps;
+    TraceRecord           record;
+    while( reader.readRecord( record ) )
+    {
+        EXPECT_EQ( TraceRecordType::REQUESTS, record.type );
+        EXPECT_EQ( batchSize, record.pageIds.size() );
+        EXPECT_EQ( timestamps.size() % 2, record.streamId );
+        timestamps.push_back( record.timestamp );
+    }
+    ASSERT_EQ( numBatches, timestamps.size() );
+
+    // Seeking to the last record's time starts reading in the last block.
+    reader.seek( timestamps.back() );
+    unsigned int numRecords = 0;
+    while( reader.readRecord( record ) )
+    {
+        EXPECT_LE( record.timestamp, timestamps.back() );
+        ++numRecords;
+    }
+    EXPECT_GT( numRecords, 0U );
+    EXPECT_LT( numRecords, numBatches / 2 );
+
+    // Seeking to the start reads the whole trace again.
+    reader.seek( 0 );
+    numRecords = 0;
+    while( reader.readRecord( record ) )
+        ++numRecords;
+    EXPECT_EQ( numBatches, numRecords );
+}
+
+TEST_F( TestTraceFile, ReadUnclosedTrace )
+{
+    // A trace that is still being written has no block index, but its flushed blocks can be read.
+    std::shared_ptr<TraceFileWriter> writer = TraceFileWriter::open( TRACE_FILENAME );
+    const unsigned int               pageIds[] = {1, 2, 3};
+    writer->recordRequests( 0, CUstream{}, pageIds, 3 );
+    writer->flush();
+    writer->recordRequests( 0, CUstream{}, pageIds, 2 );
+
+    TraceFileReader reader( TRACE_FILENAME );
+    EXPECT_EQ( 1U, reader.getNumBlocks() );
+    TraceRecord record;
+    ASSERT_TRUE( reader.readRecord( record ) );
+    EXPECT_EQ( 3U, record.pageIds.size() );
+    EXPECT_FALSE( reader.readRecord( record ) );
+}
+
+TEST_F( TestTraceFile, RejectsOtherFiles )
+{
+    {
+        std::ofstream file( TRACE_FILENAME, std::ios::binary );
+        file << "not a trace file";
+    }
+    EXPECT_THROW( TraceFileReader reader( TRACE_FILENAME ), std::runtime_error );
+}
+
+namespace {
+
+// Compressible test data: runs of repeated bytes interleaved with a counter.
+std::vector<uint8_t> makeCompressibleData( size_t size )
+{
+    std::vector<uint8_t> data( size );
+    for( size_t i = 0; i < size; ++i )
+        data[i] = ( i % 64 < 48 ) ? static_cast<uint8_t>( i / 256 ) : static_cast<uint8_t>( i );
+    return data;
+}
+
+// Overwrite bytes of a file in place.
+void patchFile( const char* filename, std::streamoff offset, const void* data, size_t size )
+{
+    std::fstream file( filename, std::ios::in | std::ios::out | std::ios::binary );
+    file.seekp( offset );
+    file.write( static_cast<const char*>( data ), size );
+}
+
+// The block header of the first block follows the magic string and the version.
+const std::streamoff FIRST_BLOCK_OFFSET = 8 + sizeof( uint32_t );
+
+void writeCompressibleTrace()
+{
+    std::shared_ptr<TraceFileWriter> writer = TraceFileWriter::open( TRACE_FILENAME );
+    std::vector<unsigned int>        pageIds( 1000 );
+    for( unsigned int i = 0; i < pageIds.size(); ++i )
+        pageIds[i] = i;
+    writer->recordRequests( 0, CUstream{}, pageIds.data(), static_cast<unsigned int>( pageIds.size() ) );
+}
+
+}  // namespace
+
+TEST( TestTraceCompression, RoundTrip )
+{
+    const std::vector<uint8_t> data = makeCompressibleData( 100000 );
+    std::vector<uint8_t>       compressed;
+    compressLZ( data, compressed );
+    EXPECT_LT( compressed.size(), data.size() );
+
+    std::vector<uint8_t> decompressed;
+    decompressLZ( compressed, decompressed, data.size() );
+    EXPECT_EQ( data, decompressed );
+}
+
+TEST( TestTraceCompression, RoundTripEmpty )
+{
+    std::vector<uint8_t> compressed;
+    compressLZ( std::vector<uint8_t>(), compressed );
+
+    std::vector<uint8_t> decompressed;
+    decompressLZ( compressed, decompressed, 0 );
+    EXPECT_TRUE( decompressed.empty() );
+}
+
+TEST( TestTraceCompression, RejectsTruncatedData )
+{
+    const std::vector<uint8_t> data = makeCompressibleData( 10000 );
+    std::vector<uint8_t>       compressed;
+    compressLZ( data, compressed );
+
+    std::vector<uint8_t> decompressed;
+    for( size_t size = 0; size < compressed.size(); ++size )
+    {
+        const std::vector<uint8_t> truncated( compressed.begin(), compressed.begin() + size );
+        EXPECT_THROW( decompressLZ( truncated, decompressed, data.size() ), std::runtime_error ) << "size " << size;
+    }
+}
+
+TEST( TestTraceCompression, RejectsWrongSize )
+{
+    const std::vector<uint8_t> data = makeCompressibleData( 10000 );
+    std::vector<uint8_t>       compressed;
+    compressLZ( data, compressed );
+
+    std::vector<uint8_t> decompressed;
+    EXPECT_THROW( decompressLZ( compressed, decompressed, data.size() - 1 ), std::runtime_error );
+    EXPECT_THROW( decompressLZ( compressed, decompressed, data.size() + 1 ), std::runtime_error );
+}
+
+TEST( TestTraceCompression, RejectsBadMatches )
+{
+    // Two literals, then a match with the given length and offset, then the end of the data.
+    auto decompressMatch = []( uint8_t length, uint8_t offset, size_t uncompressedSize ) {
+        const std::vector<uint8_t> compressed{2, 'a', 'b', length, offset, 0, 0};
+        std::vector<uint8_t>       decompressed;
+        decompressLZ( compressed, decompressed, uncompressedSize );
+        return decompressed;
+    };
+    EXPECT_EQ( std::vector<uint8_t>( {'a', 'b', 'a', 'b', 'a'} ), decompressMatch( 3, 2, 5 ) );
+    EXPECT_THROW( decompressMatch( 3, 0, 5 ), std::runtime_error );  // zero offset
+    EXPECT_THROW( decompressMatch( 3, 3, 5 ), std::runtime_error );  // offset before the start
+    EXPECT_THROW( decompressMatch( 4, 2, 5 ), std::runtime_error );  // longer than the block
+
+    // A huge match length must not overflow the size check.
+    const std::vector<uint8_t> compressed{1, 'a', 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x01, 1, 0, 0};
+    std::vector<uint8_t>       decompressed;
+    EXPECT_THROW( decompressLZ( compressed, decompressed, 16 ), std::runtime_error );
+}
+
+TEST( TestTraceCompression, CorruptDataThrowsOrHasExpectedSize )
+{
+    const std::vector<uint8_t> data = makeCompressibleData( 4096 );
+    std::vector<uint8_t>       compressed;
+    compressLZ( data, compressed );
+
+    std::mt19937                            rng( 1234 );
+    std::uniform_int_distribution<size_t>   position( 0, compressed.size() - 1 );
+    std::uniform_int_distribution<unsigned> byte( 0, 255 );
+    std::vector<uint8_t>                    decompressed;
+    for( int trial = 0; trial < 1000; ++trial )
+    {
+        std::vector<uint8_t> corrupt( compressed );
+        for( int i = 0; i < 4; ++i )
+            corrupt[position( rng )] = static_cast<uint8_t>( byte( rng ) );
+        try
+        {
+            decompressLZ( corrupt, decompressed, data.size() );
+            EXPECT_EQ( data.size(), decompressed.size() );
+        }
+        catch( const std::runtime_error& )
+        {
+        }
+    }
+}
+
+TEST_F( TestTraceFile, RejectsCorruptBlock )
+{
+    writeCompressibleTrace();
+
+    // Claim the block expands to more bytes than it does.
+    uint32_t uncompressedSize;
+    {
+        std::ifstream file( TRACE_FILENAME, std::ios::binary );
+        file.seekg( FIRST_BLOCK_OFFSET + sizeof( uint32_t ) );
+        file.read( reinterpret_cast<char*>( &uncompressedSize ), sizeof( uncompressedSize ) );
+    }
+    ++uncompressedSize;
+    patchFile( TRACE_FILENAME, FIRST_BLOCK_OFFSET + sizeof( uint32_t ), &uncompressedSize, sizeof( uncompressedSize ) );
+
+    TraceFileReader reader( TRACE_FILENAME );
+    TraceRecord     record;
+    EXPECT_THROW( reader.readRecord( record ), std::runtime_error );
+}
+
+TEST_F( TestTraceFile, RejectsUnknownCodec )
+{
+    writeCompressibleTrace();
+    const uint32_t codec = 7;
+    patchFile( TRACE_FILENAME, FIRST_BLOCK_OFFSET, &codec, sizeof( codec ) );
+
+    TraceFileReader reader( TRACE_FILENAME );
+    TraceRecord     record;
+    EXPECT_THROW( reader.readRecord( record ), std::runtime_error );
+}
@@ -0,0 +1,193 @@
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "Memory/DeviceMemoryManager.h"
+#include "UniformTileCheck.h"
+
+#include <OptiXToolkit/Error/cudaErrorCheck.h>
+#include <OptiXToolkit/ImageSource/ImageHelpers.h>
+
+#include <gtest/gtest.h>
+
+#include <cuda.h>
+#include <cuda_runtime.h>
+
+#include <memory>
+#include <vector>
+
+using namespace demandLoading;
+using namespace imageSource;
+using namespace otk;
+
+class TestUniformTileCheck : public testing::Test
+{
+};
+
+namespace {
+
+template <class TYPE>
+bool tileHasColor( const std::vector<TYPE>& tile, CUarray_format format, unsigned int numChannels, const TYPE& texel )
+{
+    UniformTileColor color;
+    if( !getUniformTileColor( reinterpret_cast<const char*>( tile.data() ), format, numChannels, color ) )
+        return false;
+
+    // The color holds the texel replicated to 16 bytes.
+    std::vector<TYPE> expected( 16 / sizeof( TYPE ), texel );
+    return memcmp( color.value, expected.data(), sizeof( color.value ) ) == 0 && color.format == format && color.numChannels == numChannels;
+}
+
+bool tileIsUniform( const void* tile, CUarray_format format, unsigned int numChannels )
+{
+    UniformTileColor color;
+    return getUniformTileColor( static_cast<const char*>( tile ), format, numChannels, color );
+}
+
+}  // namespace
+
+TEST_F( TestUniformTileCheck, FloatTiles )
+{
+    std::vector<float> ftile( TILE_SIZE_IN_BYTES / sizeof( float ), 1.0f );
+    EXPECT_TRUE( tileHasColor( ftile, CU_AD_FORMAT_FLOAT, 1, 1.0f ) );
+    EXPECT_TRUE( tileIsUniform( ftile.data(), CU_AD_FORMAT_FLOAT, 2 ) );
+    EXPECT_TRUE( tileIsUniform( ftile.data(), CU_AD_FORMAT_FLOAT, 4 ) );
+
+    std::fill( ftile.begin(), ftile.end(), 0.5f );
+    EXPECT_TRUE( tileHasColor( ftile, CU_AD_FORMAT_FLOAT, 1, 0.5f ) );
+
+    ftile[0] = 0.25f;
+    EXPECT_FALSE( tileIsUniform( ftile.data(), CU_AD_FORMAT_FLOAT, 1 ) );
+
+    std::vector<float4> f4tile( TILE_SIZE_IN_BYTES / sizeof( float4 ), float4{ 0.5f, 0.5f, 1.0f, 1.0f } );
+    EXPECT_TRUE( tileHasColor( f4tile, CU_AD_FORMAT_FLOAT, 4, float4{ 0.5f, 0.5f, 1.0f, 1.0f } ) );
+    f4tile.back().w = 0.0f;
+    EXPECT_FALSE( tileIsUniform( f4tile.data(), CU_AD_FORMAT_FLOAT, 4 ) );
+}
+
+TEST_F( TestUniformTileCheck, HalfTiles )
+{
+    std::vector<half> htile( TILE_SIZE_IN_BYTES / sizeof( half ), (half)1.0f );
+    EXPECT_TRUE( tileHasColor( htile, CU_AD_FORMAT_HALF, 1, (half)1.0f ) );
+    EXPECT_TRUE( tileIsUniform( htile.data(), CU_AD_FORMAT_HALF, 2 ) );
+    EXPECT_TRUE( tileIsUniform( htile.data(), CU_AD_FORMAT_HALF, 4 ) );
+
+    htile[25] = (half)0.5f;
+    EXPECT_FALSE( tileIsUniform( htile.data(), CU_AD_FORMAT_HALF, 1 ) );
+
+    std::vector<half4> h4tile( TILE_SIZE_IN_BYTES / sizeof( half4 ), half4{ 0.5f, 0.5f, 1.0f, 0.0f } );
+    EXPECT_TRUE( tileIsUniform( h4tile.data(), CU_AD_FORMAT_HALF, 4 ) );
+    EXPECT_FALSE( tileIsUniform( h4tile.data(), CU_AD_FORMAT_HALF, 1 ) );
+}
+
+TEST_F( TestUniformTileCheck, UcharTiles )
+{
+    std::vector<uchar> ubtile( TILE_SIZE_IN_BYTES / sizeof( uchar ), 128 );
+    EXPECT_TRUE( tileHasColor( ubtile, CU_AD_FORMAT_UNSIGNED_INT8, 1, uchar( 128 ) ) );
+    EXPECT_TRUE( tileIsUniform( ubtile.data(), CU_AD_FORMAT_UNSIGNED_INT8, 2 ) );
+    EXPECT_TRUE( tileIsUniform( ubtile.data(), CU_AD_FORMAT_UNSIGNED_INT8, 4 ) );
+
+    ubtile.back() = 10;
+    EXPECT_FALSE( tileIsUniform( ubtile.data(), CU_AD_FORMAT_UNSIGNED_INT8, 1 ) );
+
+    std::vector<uchar4> ub4tile( TILE_SIZE_IN_BYTES / sizeof( uchar4 ), uchar4{ 128, 128, 255, 255 } );
+    EXPECT_TRUE( tileHasColor( ub4tile, CU_AD_FORMAT_UNSIGNED_INT8, 4, uchar4{ 128, 128, 255, 255 } ) );
+    EXPECT_FALSE( tileIsUniform( ub4tile.data(), CU_AD_FORMAT_UNSIGNED_INT8, 2 ) );
+}
+
+TEST_F( TestUniformTileCheck, OtherFormats )
+{
+    std::vector<unsigned short> ustile( TILE_SIZE_IN_BYTES / sizeof( unsigned short ), 1000 );
+    EXPECT_TRUE( tileIsUniform( ustile.data(), CU_AD_FORMAT_UNSIGNED_INT16, 4 ) );
+
+    std::vector<unsigned int> uitile( TILE_SIZE_IN_BYTES / sizeof( unsigned int ), 7 );
+    EXPECT_TRUE( tileIsUniform( uitile.data(), CU_AD_FORMAT_UNSIGNED_INT32, 2 ) );
+
+    // BC1 blocks are 8 bytes, so the tile repeats a 2-word pattern.
+    std::vector<unsigned int> bc1tile( TILE_SIZE_IN_BYTES / sizeof( unsigned int ) );
+    for( size_t i = 0; i < bc1tile.size(); ++i )
+        bc1tile[i] = i % 2 ? 0x12345678 : 0x9abcdef0;
+    EXPECT_TRUE( tileIsUniform( bc1tile.data(), CU_AD_FORMAT_BC1_UNORM, 4 ) );
+    EXPECT_FALSE( tileIsUniform( bc1tile.data(), CU_AD_FORMAT_UNSIGNED_INT32, 1 ) );
+
+    // Three-channel textures are stored with four channels.
+    std::vector<uchar4> ub3tile( TILE_SIZE_IN_BYTES / sizeof( uchar4 ), uchar4{ 1, 2, 3, 0 } );
+    EXPECT_TRUE( tileIsUniform( ub3tile.data(), CU_AD_FORMAT_UNSIGNED_INT8, 3 ) );
+}
+
+TEST_F( TestUniformTileCheck, EqualColorsHashEqually )
+{
+    std::vector<float> ftile( TILE_SIZE_IN_BYTES / sizeof( float ), 0.5f );
+    UniformTileColor   a;
+    UniformTileColor   b;
+    ASSERT_TRUE( getUniformTileColor( reinterpret_cast<char*>( ftile.data() ), CU_AD_FORMAT_FLOAT, 1, a ) );
+    ASSERT_TRUE( getUniformTileColor( reinterpret_cast<char*>( ftile.data() ), CU_AD_FORMAT_FLOAT, 1, b ) );
+    EXPECT_TRUE( a == b );
+    EXPECT_EQ( UniformTileColorHash()( a ), UniformTileColorHash()( b ) );
+
+    // The same bytes in another layout are a different color.
+    ASSERT_TRUE( getUniformTileColor( reinterpret_cast<char*>( ftile.data() ), CU_AD_FORMAT_FLOAT, 2, b ) );
+    EXPECT_FALSE( a == b );
+}
+
+class TestUniformTileSharing : public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+        OTK_ERROR_CHECK( cudaSetDevice( 0 ) );
+        OTK_ERROR_CHECK( cudaFree( nullptr ) );
+        std::shared_ptr<Options> options( new Options );
+        options->coalesceWhiteBlackTiles = true;
+        options->maxUniformTiles         = 2;
+        m_manager.reset( new DeviceMemoryManager( options ) );
+    }
+
+  protected:
+    std::unique_ptr<DeviceMemoryManager> m_manager;
+
+    static UniformTileColor makeColor( float value )
+    {
+        std::vector<float> tile( TILE_SIZE_IN_BYTES / sizeof( float ), value );
+        UniformTileColor   color;
+        getUniformTileColor( reinterpret_cast<char*>( tile.data() ), CU_AD_FORMAT_FLOAT, 1, color );
+        return color;
+    }
+};
+
+TEST_F( TestUniformTileSharing, SharedTileIsReferenceCounted )
+{
+    TileBlockHandle first  = m_manager->allocateTileBlock( TILE_SIZE_IN_BYTES );
+    TileBlockHandle second = m_manager->allocateTileBlock( TILE_SIZE_IN_BYTES );
+
+    TileBlockHandle shared = m_manager->shareUniformTile( makeColor( 0.5f ), first );
+    EXPECT_TRUE( shared == first );
+    shared = m_manager->shareUniformTile( makeColor( 0.5f ), second );
+    EXPECT_TRUE( shared == first );
+    EXPECT_EQ( 1U, m_manager->getNumTilesCoalesced() );
+
+    // The duplicate block isn't shared, so it is freed.
+    EXPECT_FALSE( m_manager->isUniformTile( second.block ) );
+    m_manager->freeTileBlock( second.block );
+
+    // The shared block is freed with its last reference.
+    m_manager->freeTileBlock( first.block );
+    EXPECT_TRUE( m_manager->isUniformTile( first.block ) );
+    m_manager->freeTileBlock( first.block );
+    EXPECT_FALSE( m_manager->isUniformTile( first.block ) );
+}
+
+TEST_F( TestUniformTileSharing, RegistryIsCapped )
+{
+    std::vector<TileBlockHandle> blocks;
+    for( int i = 0; i < 3; ++i )
+        blocks.push_back( m_manager->allocateTileBlock( TILE_SIZE_IN_BYTES ) );
+
+    EXPECT_TRUE( m_manager->shareUniformTile( makeColor( 0.25f ), blocks[0] ) == blocks[0] );
+    EXPECT_TRUE( m_manager->shareUniformTile( makeColor( 0.5f ), blocks[1] ) == blocks[1] );
+    EXPECT_EQ( 0U, m_manager->shareUniformTile( makeColor( 0.75f ), blocks[2] ).handle );
+    EXPECT_FALSE( m_manager->isUniformTile( blocks[2].block ) );
+
+    for( TileBlockHandle& bh : blocks )
+        m_manager->freeTileBlock( bh.block );
+}
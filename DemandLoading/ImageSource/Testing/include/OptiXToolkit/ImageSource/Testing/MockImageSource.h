@@ -132,6 +132,7 @@ class MockImageSource : public ::testing::StrictMock<imageSource::ImageSource>
     MOCK_METHOD( unsigned long long, getNumBytesRead, (), ( const, override ) );
     MOCK_METHOD( double, getTotalReadTime, (), ( const, override ) );
     MOCK_METHOD( bool, hasCascade, (), ( const override ) );
+    MOCK_METHOD( CUdeviceptr, getSamplerExtraData, (OptixDeviceContext), ( override ) );
 };
 
 }  // namespace testing
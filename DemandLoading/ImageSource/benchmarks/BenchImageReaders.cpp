@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+// Benchmark the rate at which the image file readers deliver tiles.  The DDS benchmarks use a
+// synthetic BC1 file, saved in both the flat layout and the tiled layout written by
+// DDSImageReader::saveAsTiledFile.  The EXR benchmarks use the test textures.
+
+#include "Config.h"  // for OTK_USE_OPENEXR
+#include "ImageSourceBenchmarkConfig.h"
+
+#include <OptiXToolkit/ImageSource/DDSImageReader.h>
+#if OTK_USE_OPENEXR
+#include <OptiXToolkit/ImageSource/CoreEXRReader.h>
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace imageSource;
+
+namespace {
+
+const unsigned int DDS_SIZE = 4096;
+
+// Write a DDS file with a full BC1 mip chain (down to 4x4) filled with random blocks.
+std::string writeSyntheticDDS()
+{
+    const std::string fileName = getBinaryDir() + "/benchmarkBC1.dds";
+
+    DDSFileHeader header{};
+    header.magicNumber = DDS_MAGIC_NUMBER;
+    header.sizeCheck   = 124;
+    header.flags       = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000;  // caps, height, width, pixel format, mip count
+    header.height      = DDS_SIZE;
+    header.width       = DDS_SIZE;
+    header.mipMapCount = 11;
+    header.pixelFormat.sizeCheck = 32;
+    header.pixelFormat.flags     = 0x4;  // fourCC
+    std::memcpy( header.pixelFormat.fourCCcode, "DXT1", 4 );
+
+    std::ofstream file( fileName, std::ios::binary );
+    file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    std::mt19937      rng( 42 );
+    std::vector<char> level;
+    for( unsigned int mipLevel = 0; mipLevel < header.mipMapCount; ++mipLevel )
+    {
+        const unsigned int levelSize = DDS_SIZE >> mipLevel;
+        level.resize( ( levelSize / BC_BLOCK_WIDTH ) * ( levelSize / BC_BLOCK_HEIGHT ) * 8 );
+        for( char& c : level )
+            c = static_cast<char>( rng() );
+        file.write( level.data(), level.size() );
+    }
+    return fileName;
+}
+
+const std::string& getFlatDDS()
+{
+    static const std::string fileName = writeSyntheticDDS();
+    return fileName;
+}
+
+const std::string& getTiledDDS()
+{
+    static const std::string fileName = [] {
+        const std::string tiledName = getBinaryDir() + "/benchmarkBC1Tiled.dds";
+        DDSImageReader    reader( getFlatDDS(), false );
+        reader.saveAsTiledFile( tiledName.c_str() );
+        return tiledName;
+    }();
+    return fileName;
+}
+
+// The tiles of mip level zero.
+std::vector<Tile> getTiles( ImageSource& image )
+{
+    const TextureInfo& info       = image.getInfo();
+    const unsigned int tileWidth  = image.getTileWidth();
+    const unsigned int tileHeight = image.getTileHeight();
+    std::vector<Tile>  tiles;
+    for( unsigned int y = 0; y < ( info.height + tileHeight - 1 ) / tileHeight; ++y )
+    {
+        for( unsigned int x = 0; x < ( info.width + tileWidth - 1 ) / tileWidth; ++x )
+            tiles.push_back( Tile{x, y, tileWidth, tileHeight} );
+    }
+    return tiles;
+}
+
+// Read the tiles of mip level zero, one at a time (range 0) or as a batch (range 1).
+void readTiles( ImageSource& image, const std::vector<Tile>& tiles, std::vector<char>& buffer, size_t tileSizeInBytes, bool batched )
+{
+    std::vector<char*> dest( tiles.size() );
+    for( size_t i = 0; i < tiles.size(); ++i )
+        dest[i] = buffer.data() + i * tileSizeInBytes;
+    if( batched )
+    {
+        benchmark::DoNotOptimize( image.readTiles( dest.data(), 0, tiles.data(), static_cast<unsigned int>( tiles.size() ), CUstream{} ) );
+        return;
+    }
+    for( size_t i = 0; i < tiles.size(); ++i )
+        benchmark::DoNotOptimize( image.readTile( dest[i], 0, tiles[i], CUstream{} ) );
+}
+
+DDSReaderOptions getDDSOptions( bool mapFile )
+{
+    DDSReaderOptions options;
+    options.mapFile = mapFile;
+    return options;
+}
+
+// A flat DDS file that isn't mapped is read a mip level at a time, so use a fresh reader for each
+// iteration.
+void BM_DDSReadTilesFlat( benchmark::State& state )
+{
+    const bool         batched  = state.range( 0 ) != 0;
+    const bool         mapFile  = state.range( 1 ) != 0;
+    const std::string& fileName = getFlatDDS();
+    std::vector<char>  buffer;
+    size_t             numTiles = 0;
+    for( auto _ : state )
+    {
+        DDSImageReader reader( fileName, false, getDDSOptions( mapFile ) );
+        reader.open( nullptr );
+        const std::vector<Tile> tiles = getTiles( reader );
+        buffer.resize( tiles.size() * TILE_SIZE_IN_BYTES );
+        readTiles( reader, tiles, buffer, TILE_SIZE_IN_BYTES, batched );
+        numTiles = tiles.size();
+    }
+    state.SetItemsProcessed( state.iterations() * numTiles );
+    state.SetBytesProcessed( state.iterations() * numTiles * TILE_SIZE_IN_BYTES );
+}
+
+void BM_DDSReadTilesTiled( benchmark::State& state )
+{
+    const bool     batched = state.range( 0 ) != 0;
+    const bool     mapFile = state.range( 1 ) != 0;
+    DDSImageReader reader( getTiledDDS(), false, getDDSOptions( mapFile ) );
+    reader.open( nullptr );
+    const std::vector<Tile> tiles = getTiles( reader );
+    std::vector<char>       buffer( tiles.size() * TILE_SIZE_IN_BYTES );
+    for( auto _ : state )
+        readTiles( reader, tiles, buffer, TILE_SIZE_IN_BYTES, batched );
+    state.SetItemsProcessed( state.iterations() * tiles.size() );
+    state.SetBytesProcessed( state.iterations() * tiles.size() * TILE_SIZE_IN_BYTES );
+}
+
+// Several threads read the tiles of a tiled DDS file, each reading every numThreads'th tile.
+void BM_DDSReadTilesTiledConcurrent( benchmark::State& state )
+{
+    const bool         mapFile    = state.range( 0 ) != 0;
+    const unsigned int numThreads = static_cast<unsigned int>( state.range( 1 ) );
+    DDSImageReader     reader( getTiledDDS(), false, getDDSOptions( mapFile ) );
+    reader.open( nullptr );
+    const std::vector<Tile> tiles = getTiles( reader );
+    std::vector<char>       buffer( tiles.size() * TILE_SIZE_IN_BYTES );
+    for( auto _ : state )
+    {
+        std::vector<std::thread> threads;
+        for( unsigned int i = 0; i < numThreads; ++i )
+        {
+            threads.emplace_back( [&, i] {
+                for( size_t j = i; j < tiles.size(); j += numThreads )
+                    benchmark::DoNotOptimize( reader.readTile( buffer.data() + j * TILE_SIZE_IN_BYTES, 0, tiles[j], CUstream{} ) );
+            } );
+        }
+        for( std::thread& thread : threads )
+            thread.join();
+    }
+    state.SetItemsProcessed( state.iterations() * tiles.size() );
+    state.SetBytesProcessed( state.iterations() * tiles.size() * TILE_SIZE_IN_BYTES );
+}
+
+#if OTK_USE_OPENEXR
+void BM_CoreEXRReadTiles( benchmark::State& state, const char* textureName )
+{
+    const bool    batched = state.range( 0 ) != 0;
+    CoreEXRReader reader( getTextureDir() + "/" + textureName, false );
+    TextureInfo   info;
+    reader.open( &info );
+    if( !info.isValid )
+    {
+        state.SkipWithError( "Unable to open texture" );
+        return;
+    }
+    const std::vector<Tile> tiles           = getTiles( reader );
+    const size_t            tileSizeInBytes = reader.getTileWidth() * reader.getTileHeight() * getBitsPerPixel( info ) / 8;
+    std::vector<char>       buffer( tiles.size() * tileSizeInBytes );
+    for( auto _ : state )
+        readTiles( reader, tiles, buffer, tileSizeInBytes, batched );
+    state.SetItemsProcessed( state.iterations() * tiles.size() );
+    state.SetBytesProcessed( state.iterations() * tiles.size() * tileSizeInBytes );
+}
+#endif
+
+}  // namespace
+
+BENCHMARK( BM_DDSReadTilesFlat )->ArgNames( { "batched", "map" } )->ArgsProduct( { { 0, 1 }, { 0, 1 } } )->Unit( benchmark::kMillisecond );
+BENCHMARK( BM_DDSReadTilesTiled )->ArgNames( { "batched", "map" } )->ArgsProduct( { { 0, 1 }, { 0, 1 } } )->Unit( benchmark::kMillisecond );
+BENCHMARK( BM_DDSReadTilesTiledConcurrent )->ArgNames( { "map", "threads" } )->ArgsProduct( { { 0, 1 }, { 1, 4 } } )->Unit( benchmark::kMillisecond )->UseRealTime();
+#if OTK_USE_OPENEXR
+BENCHMARK_CAPTURE( BM_CoreEXRReadTiles, float, "TiledMipMappedFloat.exr" )->ArgName( "batched" )->DenseRange( 0, 1 )->Unit( benchmark::kMillisecond );
+BENCHMARK_CAPTURE( BM_CoreEXRReadTiles, half, "TiledMipMappedHalf.exr" )->ArgName( "batched" )->DenseRange( 0, 1 )->Unit( benchmark::kMillisecond );
+#endif
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+// Benchmark the image sources that adapt procedural and flat images for demand loading:
+// TiledImageSource, which extracts tiles from an untiled image, and MipMapImageSource, which
+// generates the mip levels of an image without them.
+
+#include <OptiXToolkit/ImageSource/CheckerBoardImage.h>
+#include <OptiXToolkit/ImageSource/MipMapImageSource.h>
+#include <OptiXToolkit/ImageSource/MultiCheckerImage.h>
+#include <OptiXToolkit/ImageSource/TiledImageSource.h>
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+using namespace imageSource;
+
+namespace {
+
+const unsigned int TILE_SIZE = 64;  // 64x64 float4 texels is a 64 KiB tile.
+
+// Read every tile of mip level zero.
+bool readAllTiles( ImageSource& image, std::vector<char>& buffer )
+{
+    const TextureInfo& info = image.getInfo();
+    bool               ok   = true;
+    for( unsigned int y = 0; y < info.height / TILE_SIZE; ++y )
+    {
+        for( unsigned int x = 0; x < info.width / TILE_SIZE; ++x )
+            ok = image.readTile( buffer.data(), 0, Tile{x, y, TILE_SIZE, TILE_SIZE}, CUstream{} ) && ok;
+    }
+    return ok;
+}
+
+// The first read from a TiledImageSource reads the whole base image, after which tiles are copied
+// out of it.  Measure both, with a fresh TiledImageSource for each iteration.
+void BM_TiledImageSourceFirstRead( benchmark::State& state )
+{
+    const unsigned int                 size = static_cast<unsigned int>( state.range( 0 ) );
+    std::shared_ptr<CheckerBoardImage> base( new CheckerBoardImage( size, size, 16, false, false ) );
+    std::vector<char>                  buffer( TILE_SIZE * TILE_SIZE * sizeof( float4 ) );
+    for( auto _ : state )
+    {
+        TiledImageSource image( base );
+        image.open( nullptr );
+        benchmark::DoNotOptimize( readAllTiles( image, buffer ) );
+    }
+    state.SetItemsProcessed( state.iterations() * ( size / TILE_SIZE ) * ( size / TILE_SIZE ) );
+    state.SetBytesProcessed( state.iterations() * size * size * sizeof( float4 ) );
+}
+
+void BM_TiledImageSourceReadTile( benchmark::State& state )
+{
+    const unsigned int size = static_cast<unsigned int>( state.range( 0 ) );
+    TiledImageSource   image( std::make_shared<CheckerBoardImage>( size, size, 16, false, false ) );
+    std::vector<char>  buffer( TILE_SIZE * TILE_SIZE * sizeof( float4 ) );
+    image.open( nullptr );
+    readAllTiles( image, buffer );
+    for( auto _ : state )
+        benchmark::DoNotOptimize( readAllTiles( image, buffer ) );
+    state.SetItemsProcessed( state.iterations() * ( size / TILE_SIZE ) * ( size / TILE_SIZE ) );
+    state.SetBytesProcessed( state.iterations() * size * size * sizeof( float4 ) );
+}
+
+// Cost of reading mip level zero of the base image, for comparison with BM_MipMapImageSourceGenerate.
+template <class TYPE>
+void BM_MultiCheckerReadBaseLevel( benchmark::State& state )
+{
+    const unsigned int      size = static_cast<unsigned int>( state.range( 0 ) );
+    MultiCheckerImage<TYPE> base( size, size, 16, false );
+    std::vector<TYPE>       buffer( size * size );
+    base.open( nullptr );
+    for( auto _ : state )
+        benchmark::DoNotOptimize( base.readMipLevel( reinterpret_cast<char*>( buffer.data() ), 0, size, size, CUstream{} ) );
+    state.SetBytesProcessed( state.iterations() * buffer.size() * sizeof( TYPE ) );
+}
+
+// Read the coarsest mip level from a fresh MipMapImageSource, which reads the base level and
+// generates every mip level from it.
+template <class TYPE>
+void BM_MipMapImageSourceGenerate( benchmark::State& state )
+{
+    const unsigned int                       size = static_cast<unsigned int>( state.range( 0 ) );
+    std::shared_ptr<MultiCheckerImage<TYPE>> base( new MultiCheckerImage<TYPE>( size, size, 16, false ) );
+    TYPE                                     texel;
+    for( auto _ : state )
+    {
+        MipMapImageSource image( base );
+        TextureInfo       info;
+        image.open( &info );
+        benchmark::DoNotOptimize( image.readMipLevel( reinterpret_cast<char*>( &texel ), info.numMipLevels - 1, 1, 1, CUstream{} ) );
+    }
+    state.SetBytesProcessed( state.iterations() * size * size * sizeof( TYPE ) );
+}
+
+}  // namespace
+
+BENCHMARK( BM_TiledImageSourceFirstRead )->RangeMultiplier( 4 )->Range( 256, 4096 )->Unit( benchmark::kMillisecond );
+BENCHMARK( BM_TiledImageSourceReadTile )->RangeMultiplier( 4 )->Range( 256, 4096 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_MultiCheckerReadBaseLevel, float4 )->RangeMultiplier( 4 )->Range( 256, 4096 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_MultiCheckerReadBaseLevel, uchar4 )->RangeMultiplier( 4 )->Range( 256, 4096 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_MipMapImageSourceGenerate, float4 )->RangeMultiplier( 4 )->Range( 256, 4096 )->Unit( benchmark::kMillisecond );
+BENCHMARK_TEMPLATE( BM_MipMapImageSourceGenerate, uchar4 )->RangeMultiplier( 4 )->Range( 256, 4096 )->Unit( benchmark::kMillisecond );
@@ -43,6 +43,12 @@ class CascadeImage : public ImageSourceBase
         return m_backingImage ? m_backingImage->readTile( dest, mipLevel + m_backingMipLevel, tile, stream) : false;
     }
 
+    /// Read a batch of tiles from the specified mip level.  Throws an exception on error.
+    bool readTiles( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles, CUstream stream ) override
+    {
+        return m_backingImage ? m_backingImage->readTiles( dest, mipLevel + m_backingMipLevel, tiles, numTiles, stream ) : false;
+    }
+
     /// Read the specified mipLevel. Throws an exception on error.
     bool readMipLevel( char* dest, unsigned int mipLevel, unsigned int expectedWidth, unsigned int expectedHeight, CUstream stream ) override
     {
@@ -1,12 +1,17 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #pragma once
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <array>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include <OptiXToolkit/ImageSource/DDSImageReader.h>
 #include <OptiXToolkit/ImageSource/CoreEXRReader.h>
@@ -31,13 +36,32 @@ struct CompressedTextureCacheOptions
 
     std::string ntcCli;                          // ntc-cli executable
     unsigned int numNtcFeatures = 8;             // Number of features to use for Neural Texture Compression
+
+    unsigned int maxJobs = 0;                    // Max files converted at once by cacheFiles (0 = hardware concurrency)
+    unsigned int maxNvcompressJobs = 4;          // Max nvcompress processes run at once (each uses device memory)
+    unsigned int maxNtcCliJobs = 1;              // Max ntc-cli processes run at once
+    unsigned int maxRetries = 2;                 // Times cacheFiles retries failed conversions, one at a time
+    std::string manifestFileName = "manifest.txt"; // Manifest of converted files in the cache folder (disabled if empty)
+};
+
+/// The outcome of CompressedTextureCacheManager::cacheFiles
+struct CompressedTextureCacheResults
+{
+    unsigned int numConverted = 0;               // Files converted
+    unsigned int numSkipped = 0;                 // Files already in the cache, with unchanged inputs
+    std::vector<std::string> failedFiles;        // Cache files that could not be made
 };
 
+class CompressedTextureCacheManifest;
+
 class CompressedTextureCacheManager
 {
   public:
     /// Create a compressed texture cache manager with the given options
-    CompressedTextureCacheManager( const CompressedTextureCacheOptions& options ) { m_options = options; }
+    CompressedTextureCacheManager( const CompressedTextureCacheOptions& options );
+
+    /// Destroy the manager, saving the cache manifest
+    ~CompressedTextureCacheManager();
 
     /// Get the cache file path that will be used for a given input file
     std::string getCacheFilePath( const std::string& cacheFileName, const std::string& extension );
@@ -48,6 +72,19 @@ class CompressedTextureCacheManager
     /// Put an input file into the compressed cache as a DDS image
     bool cacheFileAsDDS( const std::string& inputFilePath, int deviceId = 0 );
 
+    /// Put input files into the cache as DDS images, and texture sets as NTC files, running up to
+    /// maxJobs conversions at once, round robin over the given number of devices.  Files whose inputs
+    /// and options are unchanged since they were cached (according to the manifest) are skipped, as are
+    /// inputs that map to the same cache file as an earlier input.
+    CompressedTextureCacheResults cacheFiles( const std::vector<std::string>& ddsInputFilePaths,
+                                              const std::vector<std::vector<std::string>>& ntcTextureSets,
+                                              int numDevices = 1 );
+
+    /// Return true if the cache file is up to date with its input files.  Without a manifest, a cache
+    /// file is up to date if it exists.  A cache file that isn't in the manifest (from before the
+    /// manifest was used) is up to date if it is newer than its inputs.
+    bool isCached( const std::string& cacheFilePath, const std::vector<std::string>& inputFilePaths );
+
     /// Determine if a file extension is of a known type for compression
     bool isSupportedFileType( const std::string& extension );
 
@@ -58,6 +95,29 @@ class CompressedTextureCacheManager
     CompressedTextureCacheOptions m_options;
     bool m_verbose = false;
 
+    // A counting semaphore that limits the number of processes of an external tool.
+    class ToolSlots
+    {
+      public:
+        void setMax( unsigned int maxSlots ) { m_numFree = std::max( 1U, maxSlots ); }
+        void acquire();
+        void release();
+
+      private:
+        std::mutex              m_mutex;
+        std::condition_variable m_released;
+        unsigned int            m_numFree = 1;
+    };
+
+    ToolSlots m_nvcompressSlots;
+    ToolSlots m_ntcCliSlots;
+    unsigned long long m_optionsHash = 0;
+    std::unique_ptr<CompressedTextureCacheManifest> m_manifest;
+    std::mutex m_printMutex;
+
+    bool runTool( ToolSlots& slots, const std::string& command );
+    bool convertFileToDDS( const std::string& inputFilePath, const std::string& cacheFilePath, int deviceId );
+    bool recordCacheFile( const std::string& cacheFilePath, const std::vector<std::string>& inputFilePaths );
     void printCommand( const std::string& command );
     bool isHighDynamicRange( CoreEXRReader& exrReader, TextureInfo& texInfo );
     bool convertEXRtoHDR( CoreEXRReader& exrReader, TextureInfo& texInfo, const std::string& outFile );
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -19,6 +19,10 @@ namespace imageSource {
 
 /// OpenEXR Core image reader. Uses OpenEXR 3.0. This is preferred because
 /// it allows concurrent reading of tiles in the same EXR file.
+///
+/// Each thread reading a chunk takes a decode pipeline from a pool, so threads decompress chunks
+/// of the same file concurrently, and the pipelines' buffers are reused from chunk to chunk.  The
+/// chunk info of each tile is read once and cached.
 class CoreEXRReader : public ImageSourceBase
 {
   public:
@@ -72,6 +76,9 @@ class CoreEXRReader : public ImageSourceBase
     /// Returns the time in seconds spent reading image tiles.
     double getTotalReadTime() const override { return m_totalReadTime; }
 
+    /// Returns the path of the image file.
+    std::string getPath() const override { return m_filename; }
+
     int getNumExrChannels() { return m_numExrChannels; }
 
   private:
@@ -103,6 +110,12 @@ class CoreEXRReader : public ImageSourceBase
     // We are only supporting one-part files for now
     static constexpr int m_partIndex = 0;
 
+    // The decode pipelines and chunk info of the open file.
+    struct DecodeState;
+    std::unique_ptr<DecodeState> m_decodeState;
+
+    int  getNumTilesX( int mipLevel ) const;
+    int  getNumTilesY( int mipLevel ) const;
     void readActualTile( char* dest, int rowPitch, int mipLevel, int tileX, int tileY );
     void readScanlineData( char* dest );
 };
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -9,6 +9,8 @@
 #include <OptiXToolkit/ImageSource/ImageSource.h>
 #include <OptiXToolkit/ImageSource/TextureInfo.h>
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -101,25 +103,45 @@ struct DDSHeaderExtension
     uint32_t miscFlags2;
 };
 
+class ReadOnlyFile;
+
+/// Options for DDSImageReader.
+struct DDSReaderOptions
+{
+    /// Map the file into memory, so that tiles are copied straight from the mapping.  Otherwise,
+    /// or if the file can't be mapped, the file is read at the offsets of the tiles.
+    bool mapFile = true;
+
+    /// The maximum size in bytes of the mip levels of a flat (non-tiled) file that are kept in
+    /// memory when the file isn't mapped (0 disables the cache).  The least recently used levels
+    /// are evicted to make room, and the tiles of larger levels are read from the file a row of
+    /// blocks at a time.
+    size_t maxMipCacheSize = size_t( 64 ) << 20;
+};
+
 /// DDSImageReader, reads direct draw surface (.dds) image files that 
 /// encode BC1-BC7 compressed formats.
+///
+/// Reads don't share a file position, so tiles and mip levels are read concurrently without
+/// locking.  Each read holds a reference to the open file, so closing the reader while it is being
+/// read defers unmapping the file until the reads finish.
 class DDSImageReader : public ImageSourceBase
 {
   public:
     /// Create a test image with the specified dimensions.
-    DDSImageReader( const std::string& fileName, bool readBaseColor );
+    DDSImageReader( const std::string& fileName, bool readBaseColor, const DDSReaderOptions& options = DDSReaderOptions() );
 
     /// The destructor is virtual.
-    ~DDSImageReader() override { close(); }
+    ~DDSImageReader() override;
 
     /// The open method simply initializes the given image info struct.
     void open( imageSource::TextureInfo* info ) override;
 
     /// Close the image
-    void close() override { m_file.close(); }
+    void close() override;
 
     /// Check if image is currently open.
-    bool isOpen() const override { return m_file.is_open(); }
+    bool isOpen() const override { return m_isOpen.load( std::memory_order_acquire ); }
 
     /// Get the image info.  Valid only after calling open().
     const imageSource::TextureInfo& getInfo() const override { return m_info; }
@@ -130,6 +152,10 @@ class DDSImageReader : public ImageSourceBase
     /// Read the specified tile or mip level, returning the data in dest. 
     bool readTile( char* dest, unsigned int mipLevel, const imageSource::Tile& tile, CUstream stream ) override;
 
+    /// Read a batch of tiles from the specified mip level.  For tiled files, the tiles are read in
+    /// file order, with a single seek for each run of adjacent tiles.
+    bool readTiles( char* const* dest, unsigned int mipLevel, const imageSource::Tile* tiles, unsigned int numTiles, CUstream stream ) override;
+
     /// Read the specified mipLevel.  Returns true for success.
     bool readMipLevel( char* dest, unsigned int mipLevel, unsigned int width, unsigned int height, CUstream stream ) override;
 
@@ -167,11 +193,16 @@ class DDSImageReader : public ImageSourceBase
     /// Returns the time in seconds spent reading image tiles.
     double getTotalReadTime() const override { return m_totalReadTime; }
 
+    /// Returns the path of the image file.
+    std::string getPath() const override { return m_fileName; }
+
   private:
-    std::mutex m_mutex;
-    std::mutex m_mipCacheMutex;
+    std::mutex m_mutex;  // Guards opening and closing the file.
     std::string m_fileName;
-    std::ifstream m_file;
+    DDSReaderOptions m_options;
+    std::shared_ptr<const ReadOnlyFile> m_file;  // Accessed atomically; see getFile().
+    std::atomic<bool> m_isOpen{ false };
+    bool m_headerRead = false;
     int m_fileHeaderOffset;
     int m_blockSizeInBytes;
 
@@ -179,7 +210,13 @@ class DDSImageReader : public ImageSourceBase
     bool m_readBaseColor;
     float4 m_baseColor;
     imageSource::TextureInfo m_info;
-    std::vector<std::vector<char>> m_mipCache;
+
+    // Mip levels of a flat file, cached when the file isn't mapped.
+    std::mutex m_mipCacheMutex;
+    std::vector<std::shared_ptr<const std::vector<char>>> m_mipCache;
+    std::vector<unsigned long long> m_mipCacheLastUse;
+    unsigned long long m_mipCacheClock = 0;
+    size_t m_mipCacheSize = 0;
 
     DDSFileHeader m_ddsFileHeader{};
     DDSHeaderExtension m_ddsHeaderExtension{};
@@ -194,14 +231,23 @@ class DDSImageReader : public ImageSourceBase
     int getMipTailStartLevel();
     int getMipTailSize();
 
+    // Get the open file (or null if the reader is closed), which stays open while it is held.
+    std::shared_ptr<const ReadOnlyFile> getFile() const { return std::atomic_load( &m_file ); }
+
+    // Reading the header when the file is opened
+    void readHeader();
+
     // Reading flat (non-tiled) files
+    std::shared_ptr<const std::vector<char>> getCachedMipLevelFlat( unsigned int mipLevel );
     bool readTileFlat( char* dest, unsigned int mipLevel, const Tile& tile );
+    bool readTileRowFlat( std::vector<char>& dest, unsigned int mipLevel, unsigned int tileY );
     bool readMipLevelFlat( char* dest, unsigned int mipLevel );
     int getMipLevelOffsetInBytesFlat( int mipLevel );
     int getMipLevelSizeInBytesFlat( int mipLevel );
 
     // Reading tiled files
     bool readTileTiled( char* dest, unsigned int mipLevel, const Tile& tile );
+    bool readTilesTiled( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles );
     bool readMipLevelTiled( char* dest, unsigned int mipLevel );
     bool readMipTailTiled( char* dest, unsigned int mipTailFirstLevel );
     int getMipLevelOffsetInBytesTiled( int mipLevel );
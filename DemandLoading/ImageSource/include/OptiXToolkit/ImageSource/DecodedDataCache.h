@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+/// \file DecodedDataCache.h
+/// Process-wide cache of decoded image data, shared by the image source adapters.
+
+#include <OptiXToolkit/ImageSource/ImageSourceCacheStatistics.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace imageSource {
+
+/// A band of DecodedDataCache::BAND_HEIGHT consecutive rows of a decoded mip level (fewer at the
+/// bottom of the level).  The band is divided into blocks of columns that are decoded separately.
+/// The band's mutex guards the block states, so threads decoding different bands (or blocks) of
+/// an image don't wait for each other.
+struct DecodedBand
+{
+    enum BlockState : unsigned char
+    {
+        EMPTY,
+        IN_PROGRESS,
+        DONE
+    };
+
+    std::mutex                 mutex;
+    std::condition_variable    blockDone;  ///< Signaled when blocks leave the IN_PROGRESS state.
+    std::vector<char>          pixels;     ///< Allocated by the first thread to claim a block.
+    std::vector<unsigned char> blockStates;
+};
+
+/// DecodedDataCache holds bands of decoded mip levels for TiledImageSource and MipMapImageSource,
+/// within a byte budget.  The least recently used bands are evicted when the budget is exceeded.
+/// Bands are reference counted, so a band that is evicted while it is in use stays valid until
+/// its users release it, but it is decoded again on its next use.
+///
+/// All methods are threadsafe.  The cache's mutex is only held to look up bands.
+class DecodedDataCache
+{
+  public:
+    /// Rows per band.
+    static const unsigned int BAND_HEIGHT = 64;
+
+    /// The default budget of the shared cache.
+    static const size_t DEFAULT_MAX_SIZE = size_t( 1 ) << 30;
+
+    /// Get the cache shared by all image sources that don't specify one.
+    static std::shared_ptr<DecodedDataCache> getInstance();
+
+    /// Create a cache with the given budget in bytes (0 is unlimited).
+    explicit DecodedDataCache( size_t maxSizeInBytes = DEFAULT_MAX_SIZE );
+
+    /// Set the budget in bytes (0 is unlimited), evicting bands to meet it.
+    void setMaxSize( size_t maxSizeInBytes );
+
+    /// Get the budget in bytes.
+    size_t getMaxSize() const;
+
+    /// Get the total size of the cached bands in bytes.
+    size_t getSize() const;
+
+    /// Get a unique id for an image whose bands are cached.
+    unsigned long long createImageId();
+
+    /// Get a band of an image's mip level, and mark it as the most recently used.  If the band
+    /// isn't cached, one is added with the given number of blocks in the EMPTY state, counting
+    /// sizeInBytes against the budget.  Adding a band may evict others.
+    std::shared_ptr<DecodedBand> getBand( unsigned long long imageId, unsigned int mipLevel, unsigned int band, size_t sizeInBytes, unsigned int numBlocks );
+
+    /// Check whether a band is cached, without marking it as used.
+    bool hasBand( unsigned long long imageId, unsigned int mipLevel, unsigned int band ) const;
+
+    /// Remove an image's bands, e.g. when it is closed.
+    void removeImage( unsigned long long imageId );
+
+    /// Remove an image's bands and statistics, when it is destroyed.
+    void releaseImageId( unsigned long long imageId );
+
+    /// Get the statistics of an image.  Bands found by getBand are hits, and bands it adds are misses.
+    DecodedDataStatistics getStatistics( unsigned long long imageId ) const;
+
+    /// Get the statistics of all the images.
+    DecodedDataStatistics getStatistics() const;
+
+  private:
+    struct Key
+    {
+        unsigned long long imageId;
+        unsigned int       mipLevel;
+        unsigned int       band;
+
+        bool operator<( const Key& rhs ) const
+        {
+            return imageId != rhs.imageId ? imageId < rhs.imageId : mipLevel != rhs.mipLevel ? mipLevel < rhs.mipLevel : band < rhs.band;
+        }
+    };
+
+    struct Entry
+    {
+        std::shared_ptr<DecodedBand> band;
+        size_t                       sizeInBytes;
+        std::list<Key>::iterator     lruPosition;
+    };
+
+    mutable std::mutex                                  m_mutex;
+    size_t                                              m_maxSize;
+    size_t                                              m_size{};
+    unsigned long long                                  m_nextImageId{};
+    std::map<Key, Entry>                                m_bands;
+    std::list<Key>                                      m_lruList;  // Most recently used first.
+    std::map<unsigned long long, DecodedDataStatistics> m_imageStats;
+    DecodedDataStatistics                               m_totals{};
+
+    void evict( size_t maxSize );
+    void erase( std::map<Key, Entry>::iterator it );
+};
+
+}  // namespace imageSource
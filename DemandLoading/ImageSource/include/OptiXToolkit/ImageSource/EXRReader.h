@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -10,6 +10,8 @@
 #include <OptiXToolkit/ImageSource/ImageSource.h>
 #include <OptiXToolkit/ImageSource/TextureInfo.h>
 
+#include <atomic>
+#include <condition_variable>
 #include <iosfwd>
 #include <memory>
 #include <mutex>
@@ -25,6 +27,13 @@ class ImfFrameBuffer;
 
 /// OpenEXR image reader. Uses the OpenEXR 2.x tile reading API.
 /// CoreEXRReader is preferred, since it allows concurrent tile reads in the same texture.
+///
+/// An Imf::TiledInputFile reads one tile at a time, so tiled files are opened several times, and
+/// each read borrows an idle instance.  This lets threads decompress tiles of the same file
+/// concurrently, and each instance keeps its own decompression buffers.  Each open file has one
+/// instance, and the additional instances of all files are limited together (see
+/// setMaxSharedTiledInputFiles).  Closing the reader waits for the reads that hold instances, and
+/// reads that start after a close fail.
 class EXRReader : public ImageSourceBase
 {
   public:
@@ -41,7 +50,7 @@ class EXRReader : public ImageSourceBase
     void close() override;
 
     /// Check if image is currently open.
-    bool isOpen() const override { return static_cast<bool>( m_inputFile ) || static_cast<bool>( m_tiledInputFile ); }
+    bool isOpen() const override { return m_isOpen; }
 
     /// Get the image info.  Valid only after calling open().
     /// The caller should check the isValid struct member to determine
@@ -56,6 +65,10 @@ class EXRReader : public ImageSourceBase
     /// Throws an exception on error.
     bool readTile( char* dest, unsigned int mipLevel, const Tile& tile, CUstream stream ) override;
 
+    /// Read a batch of tiles from the specified mip level in file order, borrowing a file instance
+    /// once for the whole batch.  Throws an exception on error.
+    bool readTiles( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles, CUstream stream ) override;
+
     /// Read the specified mipLevel.  Throws an exception on error.
     bool readMipLevel( char* dest, unsigned int mipLevel, unsigned int expectedWidth, unsigned int expectedHeight, CUstream stream ) override;
 
@@ -89,18 +102,40 @@ class EXRReader : public ImageSourceBase
         return m_totalReadTime;
     }
 
+    /// Returns the path of the image file.
+    std::string getPath() const override { return m_filename; }
+
     /// Serialize the image filename (etc.) to the give stream.
     void serialize( std::ostream& stream ) const;
 
     /// Deserialize an EXRReader.  Called from ImageSource::deserialize.
     static std::shared_ptr<ImageSource> deserialize( std::istream& stream );
 
+    /// Set the maximum number of additional instances of tiled files that all EXRReaders together
+    /// keep open, beyond the one instance of each open file.  The default is the number of hardware
+    /// threads; an application can lower it to the number of threads that read images.  Instances
+    /// that are already open are not closed.
+    static void setMaxSharedTiledInputFiles( unsigned int maxFiles );
+
+    /// Get the number of additional instances of tiled files that all EXRReaders keep open.
+    static unsigned int getNumSharedTiledInputFiles();
+
   private:
     std::string m_firstChannelName{"R"};
     std::string m_filename;
 
-    std::unique_ptr<ImfTiledInputFile> m_tiledInputFile;
-    std::unique_ptr<ImfInputFile>      m_inputFile;
+    std::unique_ptr<ImfInputFile> m_inputFile;
+    std::mutex                    m_inputFileMutex;  // Serializes scanline reads.
+
+    // The instances of a tiled file, and the idle ones, guarded by m_mutex.
+    class TiledFileLease;
+    std::vector<std::unique_ptr<ImfTiledInputFile>> m_tiledInputFiles;
+    std::vector<ImfTiledInputFile*>                 m_idleTiledInputFiles;
+    unsigned int                                    m_numTiledInputFiles = 0;  // Including those being opened.
+    unsigned int                                    m_numTiledFileLeases = 0;  // Instances held by reads.
+    std::condition_variable                         m_tiledInputFileReleased;
+    std::condition_variable                         m_tiledFileLeasesEnded;
+    std::atomic<bool>                               m_isOpen{ false };
 
     TextureInfo        m_info{};
     unsigned int       m_pixelType;
@@ -114,8 +149,14 @@ class EXRReader : public ImageSourceBase
     unsigned long long m_numBytesRead  = 0;
     double             m_totalReadTime = 0.0;
 
+    ImfTiledInputFile* acquireTiledInputFile();
+    ImfTiledInputFile* openTiledInputFile( std::unique_lock<std::mutex>& lock );
+    void               releaseTiledInputFile( ImfTiledInputFile* file );
+    void               waitForTiledFileLeases( std::unique_lock<std::mutex>& lock );
+    void               closeTiledInputFiles();
     void setupFrameBuffer( ImfFrameBuffer& frameBuffer, char* base, size_t xStride, size_t yStride );
-    void readActualTile( char* dest, unsigned int rowPitch, unsigned int mipLevel, unsigned int tileX, unsigned int tileY );
+    bool readTileFromFile( ImfTiledInputFile& file, char* dest, unsigned int mipLevel, const Tile& tile );
+    void readActualTile( ImfTiledInputFile& file, char* dest, unsigned int rowPitch, unsigned int mipLevel, unsigned int tileX, unsigned int tileY );
     void readScanlineData( char* dest );
 };
 
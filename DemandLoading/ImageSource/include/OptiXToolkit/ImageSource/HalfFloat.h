@@ -0,0 +1,72 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+/// \file HalfFloat.h
+/// Host conversions between half precision (fp16) bit patterns and floats, for image sources that
+/// convert pixels without the CUDA half type.
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace imageSource {
+
+/// Convert the bits of a half precision value to a float.  The conversion is exact, and preserves
+/// infinities and NaNs.
+inline float halfToFloat( uint16_t h )
+{
+    const uint32_t sign     = static_cast<uint32_t>( h & 0x8000 ) << 16;
+    const uint32_t exponent = ( h >> 10 ) & 0x1f;
+    const uint32_t mantissa = h & 0x3ff;
+    uint32_t       bits;
+    if( exponent == 0x1f )
+        bits = sign | 0x7f800000 | ( mantissa << 13 );
+    else if( exponent != 0 )
+        bits = sign | ( ( exponent + 112 ) << 23 ) | ( mantissa << 13 );
+    else
+    {
+        // Zero or subnormal.
+        const float value = std::ldexp( static_cast<float>( mantissa ), -24 );
+        return sign ? -value : value;
+    }
+    float result;
+    std::memcpy( &result, &bits, sizeof( result ) );
+    return result;
+}
+
+/// Convert a float to the bits of the nearest half precision value, rounding ties to even.
+/// Values beyond the half range become infinities.
+inline uint16_t floatToHalf( float value )
+{
+    uint32_t bits;
+    std::memcpy( &bits, &value, sizeof( bits ) );
+    const uint16_t sign     = static_cast<uint16_t>( ( bits >> 16 ) & 0x8000 );
+    const int      exponent = static_cast<int>( ( bits >> 23 ) & 0xff ) - 127 + 15;
+    uint32_t       mantissa = bits & 0x7fffff;
+
+    if( ( ( bits >> 23 ) & 0xff ) == 0xff )
+        return sign | 0x7c00 | ( mantissa ? 0x200 : 0 );  // Inf or NaN
+    if( exponent >= 0x1f )
+        return sign | 0x7c00;  // Overflow to Inf
+    if( exponent <= 0 )
+    {
+        // Subnormal or zero, rounding to nearest even.
+        if( exponent < -10 )
+            return sign;
+        mantissa |= 0x800000;
+        const int      shift   = 14 - exponent;
+        const uint32_t half    = mantissa >> shift;
+        const uint32_t rest    = mantissa & ( ( 1u << shift ) - 1 );
+        const uint32_t halfway = 1u << ( shift - 1 );
+        return static_cast<uint16_t>( sign | ( half + ( rest > halfway || ( rest == halfway && ( half & 1 ) ) ) ) );
+    }
+    // Normal, rounding to nearest even.  A carry out of the mantissa correctly bumps the exponent.
+    const uint32_t result = ( static_cast<uint32_t>( exponent ) << 10 ) | ( mantissa >> 13 );
+    const uint32_t rest   = mantissa & 0x1fff;
+    return static_cast<uint16_t>( sign | ( result + ( rest > 0x1000 || ( rest == 0x1000 && ( result & 1 ) ) ) ) );
+}
+
+}  // namespace imageSource
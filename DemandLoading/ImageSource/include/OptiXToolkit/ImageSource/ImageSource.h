@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -7,6 +7,8 @@
 /// \file ImageSource.h
 /// Interface for a mipmapped image.
 
+#include <OptiXToolkit/ImageSource/ImageSourceCacheStatistics.h>
+
 #include <cuda.h>
 #include <vector_types.h>
 
@@ -72,6 +74,13 @@ class ImageSource
     /// Returns true if the request was satisfied and data was copied into dest.
     virtual bool readTile( char* dest, unsigned int mipLevel, const Tile& tile, CUstream stream ) = 0;
 
+    /// Read a batch of tiles from the specified mip level, returning the data for tiles[i] in
+    /// dest[i].  The default implementation calls readTile for each tile.  Readers override it to
+    /// order the reads by file offset and coalesce neighboring reads.
+    /// Throws an exception on error.
+    /// Returns true if every request was satisfied and data was copied into each dest.
+    virtual bool readTiles( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles, CUstream stream );
+
     /// Read the specified mipLevel. Throws an exception on error.
     /// Returns true if the request was satisfied and data was copied into dest.
     virtual bool readMipLevel( char* dest, unsigned int mipLevel, unsigned int expectedWidth, unsigned int expectedHeight, CUstream stream ) = 0;
@@ -110,10 +119,18 @@ class ImageSource
     /// Return true if the image has a cascade (larger size) that could be switched to.
     virtual bool hasCascade() const = 0;
 
+    /// Returns the statistics of the image's use of the DecodedDataCache.  They are zero unless
+    /// the image decodes into the cache, like TiledImageSource and MipMapImageSource.
+    virtual DecodedDataStatistics getDecodedDataStatistics() const { return DecodedDataStatistics{}; }
+
     /// Return a hash of the image, using a small mip level.
     unsigned long long getHash( CUstream stream );
 
     virtual CUdeviceptr getSamplerExtraData( OptixDeviceContext optixContext ) { (void)optixContext; return 0; }
+
+    /// Returns the path of the file the image is read from, or an empty string if the image is not
+    /// read from a file (e.g. procedural images).  Used to record images in trace files.
+    virtual std::string getPath() const { return std::string(); }
 };
 
 /// Base class for ImageSource with default implementation of readMipTail, etc.
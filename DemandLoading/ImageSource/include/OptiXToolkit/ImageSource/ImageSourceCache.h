@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -10,23 +10,39 @@
 #include <OptiXToolkit/ImageSource/ImageSource.h>
 #include <OptiXToolkit/ImageSource/ImageSourceCacheStatistics.h>
 
+#include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace imageSource {
 
+/// @private
+class OpenReaderBudget;
+
 /// Cache for ImageSource instances.
+///
+/// The images created by get() are readers that hold open files and decoder state.  The cache
+/// can limit the number of open readers: when the limit is exceeded, the least recently used
+/// readers that aren't being read are closed.  A closed reader is reopened transparently by its
+/// next read, and its TextureInfo is kept while it is closed.  Images added by set() are not
+/// counted against the limit.
+///
+/// All methods are threadsafe.
 class ImageSourceCache
 {
   public:
+    /// A function that creates an ImageSource from a path, like createImageSource.
+    using CreateFunction = std::function<std::shared_ptr<ImageSource>( const std::string& path )>;
+
+    /// Construct a cache that keeps at most maxOpenReaders readers open (0 is unlimited).  The
+    /// images are created by the given function, which defaults to createImageSource.
+    explicit ImageSourceCache( unsigned int maxOpenReaders = 0, CreateFunction createFunction = CreateFunction() );
+
     /// Returns the image source from the cache associated with the given path.
     /// If no such image source exists, returns an empty shared_ptr.
-    std::shared_ptr<ImageSource> find( const std::string& path ) const
-    {
-        auto it = m_cache.find( path );
-        return it == m_cache.end() ? std::shared_ptr<ImageSource>() : it->second;
-    }
+    std::shared_ptr<ImageSource> find( const std::string& path ) const;
 
     /// Get the specified ImageSource.  Returns a cached ImageSource if possible; otherwise a new
     /// instance is created.  The type of the ImageSource is determined by the filename extension.
@@ -37,12 +53,18 @@ class ImageSourceCache
     /// to insert their own ImageSources into the cache without relying on createImageSource to create
     /// the image from the associated filename.  For instance, this allows tiled or mipmap adapted
     /// images to be inserted into the cache.
-    void set( const std::string& path, const std::shared_ptr<ImageSource>& image ) { m_cache[path] = image; }
+    void set( const std::string& path, const std::shared_ptr<ImageSource>& image );
+
+    /// Set the maximum number of open readers (0 is unlimited), closing readers to meet it.
+    void setMaxOpenReaders( unsigned int maxOpenReaders );
 
     /// Return aggregate statistics for all ImageSources in the cache
     CacheStatistics getStatistics() const;
 
 private:
+    mutable std::mutex                                  m_mutex;
+    CreateFunction                                      m_createFunction;
+    std::shared_ptr<OpenReaderBudget>                   m_budget;
     std::map<std::string, std::shared_ptr<ImageSource>> m_cache;
 };
 
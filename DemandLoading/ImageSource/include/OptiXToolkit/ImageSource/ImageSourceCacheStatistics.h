@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -6,12 +6,24 @@
 
 namespace imageSource {
 
+/// Statistics of the use of the DecodedDataCache, for an image or all images.
+struct DecodedDataStatistics
+{
+    unsigned long long numHits;       ///< Bands that were found in the cache.
+    unsigned long long numMisses;     ///< Bands that were added to the cache, to be decoded.
+    unsigned long long numEvictions;  ///< Bands that were evicted to keep within the budget.
+};
+
 struct CacheStatistics
 {
-    unsigned int       numImageSources;
-    unsigned long long totalTilesRead;
-    unsigned long long totalBytesRead;
-    double             totalReadTime;
+    unsigned int          numImageSources;
+    unsigned long long    totalTilesRead;
+    unsigned long long    totalBytesRead;
+    double                totalReadTime;
+    DecodedDataStatistics decodedData;
+    unsigned int          numOpenReaders;   ///< Readers that currently hold open files.
+    unsigned long long    numReaderOpens;   ///< Times readers were opened, including reopens after closes.
+    unsigned long long    numReaderCloses;  ///< Times readers were closed to stay within the open reader limit.
 };
 
 }  // namespace imageSource
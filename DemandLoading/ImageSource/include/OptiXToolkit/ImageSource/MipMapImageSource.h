@@ -1,22 +1,49 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #pragma once
 
+#include <OptiXToolkit/ImageSource/DecodedDataCache.h>
 #include <OptiXToolkit/ImageSource/TextureInfo.h>
 #include <OptiXToolkit/ImageSource/WrappedImageSource.h>
 
+#include <memory>
 #include <mutex>
 #include <utility>
 #include <vector>
 
 namespace imageSource {
 
+struct DecodedRows;
+
+/// Filters used by MipMapImageSource to downsample mip levels.
+enum class MipMapFilter
+{
+    BOX,    ///< Average of 2x2 pixels.
+    KAISER  ///< Kaiser-windowed sinc with 8x8 taps, which is sharper than the box filter.
+};
+
+/// MipMapImageSource adds a mip chain to an image that has only one mip level.  The finer mip
+/// levels are generated on demand in blocks, so that reading a tile only computes the region of
+/// each finer level that it depends on.  Blocks of a level can be generated by several threads at
+/// once, and large regions are filtered in parallel.  The levels are kept in bands in a
+/// DecodedDataCache, which is shared by all images so that the memory they use is bounded.
+///
+/// 8, 16-bit unsigned, half and float formats are filtered.  Other formats (e.g. 32-bit integers,
+/// which may hold ids) are point sampled.  8-bit color channels are filtered in linear space if
+/// the image is sRGB encoded.
 class MipMapImageSource : public WrappedImageSource
 {
   public:
-    MipMapImageSource( std::shared_ptr<ImageSource> baseImage );
+    /// Generate mip levels for the base image with the given filter, caching them in the given
+    /// cache (by default the shared one).
+    MipMapImageSource( std::shared_ptr<ImageSource>      baseImage,
+                       MipMapFilter                      filter = MipMapFilter::BOX,
+                       bool                              isSrgb = false,
+                       std::shared_ptr<DecodedDataCache> cache  = nullptr );
+
+    ~MipMapImageSource() override;
 
     void open( TextureInfo* info ) override;
 
@@ -26,6 +53,12 @@ class MipMapImageSource : public WrappedImageSource
 
     bool readTile( char* dest, unsigned int mipLevel, const Tile& tile, CUstream stream ) override;
 
+    /// Tiles are extracted from a mip level, so each tile is read with readTile.
+    bool readTiles( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles, CUstream stream ) override
+    {
+        return ImageSource::readTiles( dest, mipLevel, tiles, numTiles, stream );
+    }
+
     bool readMipLevel( char* dest, unsigned int mipLevel, unsigned int expectedWidth, unsigned int expectedHeight, CUstream stream ) override;
 
     bool readMipTail( char*        dest,
@@ -36,22 +69,48 @@ class MipMapImageSource : public WrappedImageSource
 
     unsigned long long getNumTilesRead() const override;
 
+    DecodedDataStatistics getDecodedDataStatistics() const override;
+
   private:
+    // The dimensions of a mip level.  Its pixels are generated in square blocks, one band of the
+    // DecodedDataCache high.
+    struct MipLevel
+    {
+        unsigned int width;
+        unsigned int height;
+        unsigned int numBlocksX;
+    };
+
     void getBaseInfo();
 
-    // Must be called while the mutex is locked.
-    const char* getMipLevelBuffer( unsigned int mipLevel, CUstream stream );
+    // Read rows y0 to y1 (exclusive) of level 0 from the tiles of a tiled base image.
+    bool readBaseRows( char* dest, unsigned int y0, unsigned int y1, CUstream stream );
+
+    // Make the pixels in the given region of a mip level available, generating the blocks that
+    // hold them.  Returns false if the base image could not be read.
+    bool getMipLevelRegion( unsigned int mipLevel, unsigned int x0, unsigned int y0, unsigned int x1, unsigned int y1, CUstream stream, DecodedRows& rows );
+
+    // Filter a block of a mip level from the finer level's rows.
+    void filterBlock( unsigned int mipLevel, unsigned int blockX, unsigned int blockY, const DecodedRows& source, DecodedRows& dest );
+
+    MipMapFilter                      m_filter;
+    bool                              m_isSrgb;
+    std::shared_ptr<DecodedDataCache> m_cache;
+    unsigned long long                m_imageId;
 
-    mutable std::mutex m_dataMutex;
-    unsigned int       m_numTilesRead{};
-    TextureInfo        m_mipMapInfo{};
-    bool               m_mipMappedBase{};
-    unsigned int       m_pixelStrideInBytes{};
-    std::vector<char>  m_buffer;
-    std::vector<char*> m_mipLevels;
+    mutable std::mutex    m_dataMutex;
+    unsigned int          m_numTilesRead{};
+    TextureInfo           m_mipMapInfo{};
+    bool                  m_mipMappedBase{};
+    unsigned int          m_pixelStrideInBytes{};
+    std::vector<MipLevel> m_mipLevels;
+    std::mutex            m_baseReadMutex;  // Held while reading the base image.
 };
 
-inline std::shared_ptr<ImageSource> createMipMapImageSource( std::shared_ptr<ImageSource> baseImage )
+/// Create a MipMapImageSource for the base image, unless it is already mipmapped.
+inline std::shared_ptr<ImageSource> createMipMapImageSource( std::shared_ptr<ImageSource> baseImage,
+                                                             MipMapFilter                 filter = MipMapFilter::BOX,
+                                                             bool                         isSrgb = false )
 {
     if( !baseImage )
         return {};
@@ -62,7 +121,7 @@ inline std::shared_ptr<ImageSource> createMipMapImageSource( std::shared_ptr<Ima
     if( baseImage->getInfo().numMipLevels > 1 )
         return baseImage;
 
-    return std::make_shared<MipMapImageSource>( std::move( baseImage ) );
+    return std::make_shared<MipMapImageSource>( std::move( baseImage ), filter, isSrgb );
 }
 
 }  // namespace imageSource
@@ -88,6 +88,9 @@ class OIIOReader : public ImageSourceBase
         return m_totalReadTime;
     }
 
+    /// Returns the path of the image file.
+    std::string getPath() const override { return m_filename; }
+
   private:
     void readActualTile( char* dest, unsigned int rowPitch, unsigned int mipLevel, unsigned int tileX, unsigned int tileY );
 
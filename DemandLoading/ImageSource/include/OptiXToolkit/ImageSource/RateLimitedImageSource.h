@@ -40,6 +40,10 @@ class RateLimitedImageSource : public WrappedImageSource
     /// remaining, in which case nothing is done and false is returned.
     bool readTile( char* dest, unsigned int mipLevel, const Tile& tile, CUstream stream ) override;
 
+    /// Delegate to the wrapped ImageSource and update the time remaining, unless there is no time
+    /// remaining, in which case nothing is done and false is returned.
+    bool readTiles( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles, CUstream stream ) override;
+
     /// Delegate to the wrapped ImageSource and update the time remaining, unless there is no time
     /// remaining, in which case nothing is done and false is returned.
     bool readMipLevel( char* dest, unsigned int mipLevel, unsigned int expectedWidth, unsigned int expectedHeight, CUstream stream ) override;
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace imageSource {
+
+/// ReadOnlyFile reads a file at given offsets, without a shared file position, so that threads
+/// can read it concurrently without locking.  The file can also be mapped into memory, in which
+/// case the data can be copied straight from the mapping.
+class ReadOnlyFile
+{
+  public:
+    ReadOnlyFile() = default;
+    ~ReadOnlyFile() { close(); }
+
+    ReadOnlyFile( const ReadOnlyFile& )            = delete;
+    ReadOnlyFile& operator=( const ReadOnlyFile& ) = delete;
+
+    /// Open the file, mapping it into memory if requested.  If the file can't be mapped, it is
+    /// read instead.  Returns false if the file can't be opened.
+    bool open( const std::string& path, bool map );
+
+    /// Close the file, unmapping it.
+    void close();
+
+    /// Check if the file is open.
+    bool isOpen() const;
+
+    /// Get the size of the file in bytes.
+    unsigned long long getSize() const { return m_size; }
+
+    /// Get a pointer to size bytes at the offset in the mapped file.  Returns nullptr if the file
+    /// isn't mapped or the bytes are past the end of the file.
+    const char* getData( unsigned long long offset, size_t size ) const
+    {
+        return m_data != nullptr && offset + size <= m_size ? m_data + offset : nullptr;
+    }
+
+    /// Read size bytes at the offset into dest, copying them from the mapping if the file is
+    /// mapped.  Returns false if the bytes are past the end of the file or can't be read.
+    bool read( char* dest, size_t size, unsigned long long offset ) const;
+
+  private:
+#ifdef _WIN32
+    void* m_file{};     // HANDLE
+    void* m_mapping{};  // HANDLE
+#else
+    int m_file{ -1 };
+#endif
+    unsigned long long m_size{};
+    const char*        m_data{};
+};
+
+}  // namespace imageSource
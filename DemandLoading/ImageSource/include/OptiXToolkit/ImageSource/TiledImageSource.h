@@ -1,9 +1,10 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #pragma once
 
+#include <OptiXToolkit/ImageSource/DecodedDataCache.h>
 #include <OptiXToolkit/ImageSource/TextureInfo.h>
 #include <OptiXToolkit/ImageSource/WrappedImageSource.h>
 
@@ -16,11 +17,15 @@
 
 namespace imageSource {
 
+/// TiledImageSource reads tiles from an image that can only be read by whole mip levels.  The
+/// levels are kept in bands in a DecodedDataCache, which is shared by all images so that the
+/// memory they use is bounded.
 class TiledImageSource : public WrappedImageSource
 {
   public:
-    explicit TiledImageSource( std::shared_ptr<ImageSource> baseImage );
-    ~TiledImageSource() override = default;
+    /// Read tiles of the base image, caching its levels in the given cache (by default the shared one).
+    explicit TiledImageSource( std::shared_ptr<ImageSource> baseImage, std::shared_ptr<DecodedDataCache> cache = nullptr );
+    ~TiledImageSource() override;
 
     void open( TextureInfo* info ) override;
 
@@ -30,6 +35,8 @@ class TiledImageSource : public WrappedImageSource
 
     bool readTile( char* dest, unsigned int mipLevel, const Tile& tile, CUstream stream ) override;
 
+    bool readTiles( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles, CUstream stream ) override;
+
     bool readMipTail( char*        dest,
                       unsigned int mipTailFirstLevel,
                       unsigned int numMipLevels,
@@ -38,16 +45,20 @@ class TiledImageSource : public WrappedImageSource
 
     unsigned long long getNumTilesRead() const override;
 
+    DecodedDataStatistics getDecodedDataStatistics() const override;
+
   private:
     void getBaseInfo();
 
-    mutable std::mutex m_dataMutex;
-    bool               m_baseIsTiled{};
-    TextureInfo        m_tiledInfo{};
-    unsigned long long m_numTilesRead{};
-    std::vector<char>  m_buffer;
-    std::vector<char*> m_mipLevels;
-    std::vector<uint2> m_mipDimensions;
+    std::shared_ptr<DecodedDataCache> m_cache;
+    unsigned long long                m_imageId;
+
+    mutable std::mutex                       m_dataMutex;
+    bool                                     m_baseIsTiled{};
+    TextureInfo                              m_tiledInfo{};
+    unsigned long long                       m_numTilesRead{};
+    std::vector<uint2>                       m_mipDimensions;
+    std::vector<std::unique_ptr<std::mutex>> m_levelMutexes;  // Held while reading a level from the base image.
 };
 
 /// A simple convenience function to reliably get a tiled image source.
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -47,6 +47,13 @@ class WrappedImageSource : public ImageSource
         return m_imageSource->readTile( dest, mipLevel, tile, stream);
     }
 
+    /// Delegates to the wrapped ImageSource.  Derived classes that override readTile must also
+    /// override readTiles (e.g. with the looping ImageSource::readTiles).
+    bool readTiles( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles, CUstream stream ) override
+    {
+        return m_imageSource->readTiles( dest, mipLevel, tiles, numTiles, stream );
+    }
+
     /// Delegates to the wrapped ImageSource.
     bool readMipLevel( char* dest, unsigned int mipLevel, unsigned int expectedWidth, unsigned int expectedHeight, CUstream stream ) override
     {
@@ -84,6 +91,18 @@ class WrappedImageSource : public ImageSource
     /// Delegates to the wrapped ImageSource.
     bool hasCascade() const override { return m_imageSource->hasCascade(); }
 
+    /// Delegates to the wrapped ImageSource.
+    DecodedDataStatistics getDecodedDataStatistics() const override { return m_imageSource->getDecodedDataStatistics(); }
+
+    /// Delegates to the wrapped ImageSource.
+    std::string getPath() const override { return m_imageSource->getPath(); }
+
+    /// Delegates to the wrapped ImageSource.
+    CUdeviceptr getSamplerExtraData( OptixDeviceContext optixContext ) override
+    {
+        return m_imageSource->getSamplerExtraData( optixContext );
+    }
+
   private:
     std::shared_ptr<ImageSource> m_imageSource;
 };
@@ -1,12 +1,17 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <set>
+#include <thread>
 
 #include <OptiXToolkit/ImageSource/CompressedTextureCacheManager.h>
 
+#include "CompressedTextureCacheManifest.h"
+
 #include <half.h>
 #include <openexr.h>
 
@@ -31,6 +36,41 @@ namespace imageSource {
 std::array<const char*, 6> EXR_TO_DDS_FORMATS_STANDARD{"bc7", "bc4", "bc5", "bc7", "bc7", "bc6"};
 std::array<const char*, 6> EXR_TO_DDS_FORMATS_SMALL{"bc1", "bc4", "bc1", "bc1", "bc7", "bc6"};
 
+// Hash the options that affect the contents of cache files (FNV-1a), so that cache files made with
+// other options are remade.
+static unsigned long long hashOptions( const CompressedTextureCacheOptions& options )
+{
+    std::string key = std::to_string( options.droppedMipLevels ) + ' ' + options.flags + ' ' + std::to_string( options.minImageSize )
+                      + ' ' + std::to_string( options.hdrCheckSize ) + ' ' + std::to_string( options.saveTiled ) + ' '
+                      + std::to_string( options.numNtcFeatures );
+    for( unsigned int i = 0; i < EXR_TO_DDS_FORMATS_STANDARD.size(); ++i )
+        key += std::string( " " ) + options.exrToDdsFormats[i];
+
+    unsigned long long hash = 0xcbf29ce484222325ULL;
+    for( char c : key )
+        hash = ( hash ^ static_cast<unsigned char>( c ) ) * 0x100000001b3ULL;
+    return hash;
+}
+
+CompressedTextureCacheManager::CompressedTextureCacheManager( const CompressedTextureCacheOptions& options )
+    : m_options( options )
+    , m_optionsHash( hashOptions( options ) )
+{
+    m_nvcompressSlots.setMax( m_options.maxNvcompressJobs );
+    m_ntcCliSlots.setMax( m_options.maxNtcCliJobs );
+    if( !m_options.manifestFileName.empty() )
+    {
+        std::error_code ec;
+        fs::create_directories( m_options.cacheFolder, ec );
+        m_manifest.reset( new CompressedTextureCacheManifest( ( fs::path( m_options.cacheFolder ) / m_options.manifestFileName ).string() ) );
+    }
+}
+
+CompressedTextureCacheManager::~CompressedTextureCacheManager()
+{
+    // The manifest compacts its file when it is destroyed.
+}
+
 std::string CompressedTextureCacheManager::getCacheFilePath( const std::string& cacheFileName, const std::string& extension )
 {
     return ( fs::path( m_options.cacheFolder ) / fs::path( cacheFileName ).replace_extension( extension ) ).string();
@@ -48,13 +88,47 @@ bool CompressedTextureCacheManager::isSupportedFileType( const std::string& exte
     return false;
 }
 
+bool CompressedTextureCacheManager::isCached( const std::string& cacheFilePath, const std::vector<std::string>& inputFilePaths )
+{
+    if( !fs::exists( cacheFilePath ) )
+        return false;
+    if( !m_manifest || m_manifest->isUpToDate( cacheFilePath, m_optionsHash, inputFilePaths ) )
+        return true;
+
+    // A cache file can't be remade if its inputs are gone (a DDS input file is moved into the cache).
+    std::error_code    ec;
+    fs::file_time_type cacheTime = fs::last_write_time( cacheFilePath, ec );
+    for( const std::string& inputFilePath : inputFilePaths )
+    {
+        if( !fs::exists( inputFilePath ) )
+            return true;
+    }
+    if( ec || m_manifest->contains( cacheFilePath ) )
+        return false;
+
+    // Adopt a cache file made before the manifest was used if it is newer than its inputs.
+    for( const std::string& inputFilePath : inputFilePaths )
+    {
+        if( fs::last_write_time( inputFilePath, ec ) > cacheTime || ec )
+            return false;
+    }
+    recordCacheFile( cacheFilePath, inputFilePaths );
+    return true;
+}
+
+bool CompressedTextureCacheManager::recordCacheFile( const std::string& cacheFilePath, const std::vector<std::string>& inputFilePaths )
+{
+    return !m_manifest || m_manifest->record( cacheFilePath, m_optionsHash, inputFilePaths );
+}
+
 bool CompressedTextureCacheManager::cacheTextureSetAsNtc( const std::vector<std::string>& filePaths, int deviceId )
 {
     std::string outputFileName = filePaths[0];
     std::string cacheFilePath = getCacheFilePath( outputFileName, "" );
+    const std::vector<std::string> inputFilePaths( filePaths.begin() + 1, filePaths.end() );
 
-    // Return if the cache file already exists, or the input files do not exist.
-    if( fs::exists( cacheFilePath ) )
+    // Return if the cache file is up to date, or the input files do not exist.
+    if( isCached( cacheFilePath, inputFilePaths ) )
     {
         printCommand( "\"" + cacheFilePath + "\" exists, not converting." );
         return true;
@@ -69,6 +143,7 @@ bool CompressedTextureCacheManager::cacheTextureSetAsNtc( const std::vector<std:
     }
 
     // Construct the command to convert the texture set into an NTC file
+    std::string partialFilePath = getPartialFilePath( cacheFilePath );
     std::string command = m_options.ntcCli;
     for( unsigned int i = 1; i < filePaths.size(); ++i )
     {
@@ -79,16 +154,20 @@ bool CompressedTextureCacheManager::cacheTextureSetAsNtc( const std::vector<std:
     command += " --compress";
     std::string generateMips = " --generateMips";
     command += generateMips;
-    command += " --saveCompressed \"" + cacheFilePath + "\"";
+    command += " --saveCompressed \"" + partialFilePath + "\"";
     printCommand( command );
 
     // Run the command
     if( !m_options.showErrors )
-        command += TO_DEV_NULL;
+        command = command + " " + TO_DEV_NULL;
     if( deviceId != 0 )
         command = std::string("CUDA_VISIBLE_DEVICES=") + std::to_string(deviceId) + " " + command;
-    if( std::system( command.c_str() ) != 0 )
+    if( !runTool( m_ntcCliSlots, command ) || !commitPartialFile( partialFilePath, cacheFilePath ) )
+    {
+        deleteFile( partialFilePath );
         return false;
+    }
+    recordCacheFile( cacheFilePath, inputFilePaths );
     return true;
 }
 
@@ -96,13 +175,11 @@ bool CompressedTextureCacheManager::cacheFileAsDDS( const std::string& inputFile
 {
     if( inputFilePath.length() == 0 )
         return false;
-    std::string suffix = inputFilePath.substr( inputFilePath.rfind('.') + 1 );
-    std::transform( suffix.begin(), suffix.end(), suffix.begin(), ::tolower );
     std::string cacheFilePath = getCacheFilePath( inputFilePath, ".dds" );
 
-    // Return if the cache file already exists, or the input file does not exist.
+    // Return if the cache file is up to date, or the input file does not exist.
     {
-        if( fs::exists( cacheFilePath ) )
+        if( isCached( cacheFilePath, {inputFilePath} ) )
         {
             printCommand( "\"" + cacheFilePath + "\" exists, not converting." );
             return true;
@@ -114,6 +191,17 @@ bool CompressedTextureCacheManager::cacheFileAsDDS( const std::string& inputFile
         }
     }
 
+    if( !convertFileToDDS( inputFilePath, cacheFilePath, deviceId ) )
+        return false;
+    recordCacheFile( cacheFilePath, {inputFilePath} );
+    return true;
+}
+
+bool CompressedTextureCacheManager::convertFileToDDS( const std::string& inputFilePath, const std::string& cacheFilePath, int deviceId )
+{
+    std::string suffix = inputFilePath.substr( inputFilePath.rfind('.') + 1 );
+    std::transform( suffix.begin(), suffix.end(), suffix.begin(), ::tolower );
+
     // If already a DDS image, copy or convert directly to tiled.
     if( suffix == "dds" )
     {
@@ -141,9 +229,8 @@ bool CompressedTextureCacheManager::cacheFileAsDDS( const std::string& inputFile
         {
             if( !convertImageToDDS( inputFilePath, tempDdsFilePath, ddsFormat, deviceId ) )
                 return false;
-            if( !convertDDSToTiledDDS( tempDdsFilePath, cacheFilePath ) )
-                return false;
-            return deleteFile( tempDdsFilePath );
+            bool tiled = convertDDSToTiledDDS( tempDdsFilePath, cacheFilePath );
+            return deleteFile( tempDdsFilePath ) && tiled;
         }
     }
 
@@ -160,7 +247,8 @@ bool CompressedTextureCacheManager::cacheFileAsDDS( const std::string& inputFile
         int ddsFormatIndex = ishdr ? DDS_HDR_INDEX : texInfo.numChannels;
         std::string ddsFormat = m_options.exrToDdsFormats[ddsFormatIndex];
 
-        // Convert input file to intermediate format (exr or tga)
+        // Convert input file to intermediate format (exr or tga).  The intermediate file isn't reused
+        // from an earlier run, since it depends on the options.
         std::string intermediateFilePath = "";
         if( exrReader.getNumExrChannels() < 4 ) // Use HDR for images without alpha
         {
@@ -168,11 +256,8 @@ bool CompressedTextureCacheManager::cacheFileAsDDS( const std::string& inputFile
             std::string command = "Converting EXR file \"" + inputFilePath + "\" to HDR file \"" 
                 + intermediateFilePath + "\"";
             printCommand( command );
-            if( !fs::exists( intermediateFilePath ) )
-            {
-                if( !convertEXRtoHDR( exrReader, texInfo, intermediateFilePath ) )
-                    return false;
-            }
+            if( !convertEXRtoHDR( exrReader, texInfo, intermediateFilePath ) )
+                return false;
         }
         else // Use TGA for images with alpha
         {
@@ -180,36 +265,147 @@ bool CompressedTextureCacheManager::cacheFileAsDDS( const std::string& inputFile
             std::string command = "Converting EXR file \"" + inputFilePath + "\" to TGA file \"" 
                 + intermediateFilePath + "\"";
             printCommand( command );
-            if( !fs::exists( intermediateFilePath ) )
-            {
-                if( !convertEXRtoTGA4( exrReader, texInfo, 1.0f, 1.0f, intermediateFilePath ) )
-                    return false;
-            }
+            if( !convertEXRtoTGA4( exrReader, texInfo, 1.0f, 1.0f, intermediateFilePath ) )
+                return false;
         }
 
         // Convert the intermediate file to dds, and tile it if needed
         if( !m_options.saveTiled )
         {
-            if( !convertImageToDDS( intermediateFilePath, cacheFilePath, ddsFormat, deviceId ) )
-                return false;
-            return deleteFile( intermediateFilePath );
+            bool converted = convertImageToDDS( intermediateFilePath, cacheFilePath, ddsFormat, deviceId );
+            return deleteFile( intermediateFilePath ) && converted;
         }
         else
         {
             std::string tempDdsFilePath = cacheFilePath + ".tmp.dds";
-            if( !convertImageToDDS( intermediateFilePath, tempDdsFilePath, ddsFormat, deviceId ) )
-                return false;
-            if( !convertDDSToTiledDDS( tempDdsFilePath, cacheFilePath ) )
-                return false;
-            if( !deleteFile( intermediateFilePath ) )
-                return false;
-            return deleteFile( tempDdsFilePath );
+            bool converted = convertImageToDDS( intermediateFilePath, tempDdsFilePath, ddsFormat, deviceId );
+            converted = converted && convertDDSToTiledDDS( tempDdsFilePath, cacheFilePath );
+            bool deleted = deleteFile( intermediateFilePath );
+            deleted = deleteFile( tempDdsFilePath ) && deleted;
+            return converted && deleted;
+        }
+    }
+}
+
+CompressedTextureCacheResults CompressedTextureCacheManager::cacheFiles( const std::vector<std::string>& ddsInputFilePaths,
+                                                                         const std::vector<std::vector<std::string>>& ntcTextureSets,
+                                                                         int numDevices )
+{
+    // A job converts one input file to DDS, or one texture set to NTC.
+    struct Job
+    {
+        const std::vector<std::string>* textureSet;
+        const std::string*              inputFilePath;
+        std::string                     cacheFilePath;
+        int                             deviceId;
+    };
+
+    CompressedTextureCacheResults results;
+    std::vector<Job>              jobs;
+    std::set<std::string>         cacheFilePaths;
+    numDevices = std::max( 1, numDevices );
+
+    // Inputs that map to the same cache file (e.g. "a.png" and "a.exr") are converted once, by the
+    // first of them, since concurrent jobs would share the cache file and its temporary files.
+    auto schedule = [this, &results, &jobs, &cacheFilePaths]( const Job& job, const std::vector<std::string>& inputFilePaths ) {
+        if( !cacheFilePaths.insert( job.cacheFilePath ).second )
+        {
+            printCommand( "\"" + job.cacheFilePath + "\" is converted from other inputs, skipping." );
+            ++results.numSkipped;
+        }
+        else if( isCached( job.cacheFilePath, inputFilePaths ) )
+            ++results.numSkipped;
+        else
+            jobs.push_back( job );
+    };
+    for( const std::string& inputFilePath : ddsInputFilePaths )
+        schedule( Job{ nullptr, &inputFilePath, getCacheFilePath( inputFilePath, ".dds" ), 0 }, { inputFilePath } );
+    for( const std::vector<std::string>& textureSet : ntcTextureSets )
+    {
+        if( textureSet.empty() )
+            continue;
+        schedule( Job{ &textureSet, nullptr, getCacheFilePath( textureSet[0], "" ), 0 },
+                  std::vector<std::string>( textureSet.begin() + 1, textureSet.end() ) );
+    }
+    for( unsigned int i = 0; i < jobs.size(); ++i )
+        jobs[i].deviceId = static_cast<int>( i % numDevices );
+
+    // Run the jobs on a pool of threads.  External tools can fail when too many of them are running
+    // (e.g. when nvcompress runs out of device memory), so failed jobs are retried one at a time.
+    unsigned int maxJobs = m_options.maxJobs ? m_options.maxJobs : std::max( 1U, std::thread::hardware_concurrency() );
+    for( unsigned int pass = 0; pass <= m_options.maxRetries && !jobs.empty(); ++pass )
+    {
+        std::vector<char>         succeeded( jobs.size(), 0 );
+        std::atomic<unsigned int> nextJob( 0 );
+        auto                      worker = [this, &jobs, &succeeded, &nextJob]() {
+            for( unsigned int i = nextJob++; i < jobs.size(); i = nextJob++ )
+            {
+                const Job& job = jobs[i];
+                try
+                {
+                    succeeded[i] = job.textureSet ? cacheTextureSetAsNtc( *job.textureSet, job.deviceId ) :
+                                                    cacheFileAsDDS( *job.inputFilePath, job.deviceId );
+                }
+                catch( const std::exception& e )
+                {
+                    printCommand( std::string( "Error converting \"" ) + job.cacheFilePath + "\": " + e.what() );
+                }
+            }
+        };
+
+        const unsigned int numThreads = ( pass == 0 ) ? std::min( maxJobs, static_cast<unsigned int>( jobs.size() ) ) : 1;
+        std::vector<std::thread> threads;
+        for( unsigned int i = 1; i < numThreads; ++i )
+            threads.emplace_back( worker );
+        worker();
+        for( std::thread& thread : threads )
+            thread.join();
+
+        std::vector<Job> failedJobs;
+        for( unsigned int i = 0; i < jobs.size(); ++i )
+        {
+            if( succeeded[i] )
+                ++results.numConverted;
+            else
+                failedJobs.push_back( jobs[i] );
         }
+        jobs.swap( failedJobs );
     }
+
+    for( const Job& job : jobs )
+        results.failedFiles.push_back( job.cacheFilePath );
+    if( m_manifest )
+        m_manifest->compact();
+    return results;
+}
+
+bool CompressedTextureCacheManager::runTool( ToolSlots& slots, const std::string& command )
+{
+    slots.acquire();
+    int status = std::system( command.c_str() );
+    slots.release();
+    return status == 0;
+}
+
+void CompressedTextureCacheManager::ToolSlots::acquire()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_released.wait( lock, [this] { return m_numFree > 0; } );
+    --m_numFree;
+}
+
+void CompressedTextureCacheManager::ToolSlots::release()
+{
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        ++m_numFree;
+    }
+    m_released.notify_one();
 }
 
 void CompressedTextureCacheManager::printCommand( const std::string& command )
 {
+    std::unique_lock<std::mutex> lock( m_printMutex );
     if( m_verbose && command.length() < 100 )
         printf("    %s\n", command.c_str());
     if( m_verbose && command.length() >= 100 )
@@ -321,7 +517,8 @@ bool CompressedTextureCacheManager::convertEXRtoHDR( CoreEXRReader& exrReader, T
         }
         
         // Open output HDR file and write header
-        std::ofstream outFile( outFileName, std::ios::binary );
+        const std::string partialFileName = getPartialFilePath( outFileName );
+        std::ofstream outFile( partialFileName, std::ios::binary );
         if ( !outFile ) {
             std::cerr << "Failed to open output file: " << outFileName << std::endl;
             return false;
@@ -342,7 +539,8 @@ bool CompressedTextureCacheManager::convertEXRtoHDR( CoreEXRReader& exrReader, T
             outFile.write( reinterpret_cast<char*>(hdrScanline.data()), width * 4 );
         }
 
-        return true;
+        outFile.close();
+        return outFile && commitPartialFile( partialFileName, outFileName );
     }
     catch (const std::exception& e) 
     {
@@ -396,7 +594,8 @@ bool CompressedTextureCacheManager::convertEXRtoTGA4( CoreEXRReader& exrReader,
         }
         
         // Open output TGA file and write header
-        std::ofstream outFile( outFileName, std::ios::binary );
+        const std::string partialFileName = getPartialFilePath( outFileName );
+        std::ofstream outFile( partialFileName, std::ios::binary );
         if( !outFile ) 
         {
             std::cerr << "Failed to open output file: " << outFileName << std::endl;
@@ -423,7 +622,8 @@ bool CompressedTextureCacheManager::convertEXRtoTGA4( CoreEXRReader& exrReader,
             outFile.write( reinterpret_cast<const char*>(tgaScanline.data()), tgaScanline.size() );
         }
 
-        return true;
+        outFile.close();
+        return outFile && commitPartialFile( partialFileName, outFileName );
     }
     catch (const std::exception& e) 
     {
@@ -434,32 +634,48 @@ bool CompressedTextureCacheManager::convertEXRtoTGA4( CoreEXRReader& exrReader,
 
 bool CompressedTextureCacheManager::convertImageToDDS( const std::string& inFile, const std::string& outFile, const std::string& ddsFormat, int deviceId )
 {
+    const std::string partialFile = getPartialFilePath( outFile );
     std::string command = m_options.nvcompress + " " + m_options.flags + " -" + ddsFormat + " -silent "
-        + " \"" + inFile + "\"" + " \"" + outFile + "\"";
+        + " \"" + inFile + "\"" + " \"" + partialFile + "\"";
     if( deviceId != 0 )
         command = std::string("CUDA_VISIBLE_DEVICES=") + std::to_string(deviceId) + " " + command;
     printCommand( command );
     if( !m_options.showErrors )
         command = command + " " + TO_DEV_NULL;
 
-    if( std::system( command.c_str() ) != 0 )
+    if( !runTool( m_nvcompressSlots, command ) )
+    {
+        deleteFile( partialFile );
         return false;
+    }
 
     // Check to to see if nvcompress failed. This can happen when cudaMalloc fails because
     // multiple instances of nvcompress are running at the same time.
     const unsigned int failSize = 148;
-    std::uintmax_t fileSize = fs::file_size( fs::path( outFile ) );
-    if( fileSize <= failSize )
-        deleteFile( outFile );
-    return ( fileSize > failSize );
+    std::error_code ec{};
+    std::uintmax_t fileSize = fs::file_size( fs::path( partialFile ), ec );
+    if( ec || fileSize <= failSize )
+    {
+        deleteFile( partialFile );
+        return false;
+    }
+    return commitPartialFile( partialFile, outFile );
 }
 
 bool CompressedTextureCacheManager::convertDDSToTiledDDS( const std::string& inFile, const std::string& outFile )
 {
     std::string command = "Converting DDS file \"" + inFile + "\" to tiled DDS file \"" + outFile + "\"";
     printCommand( command );
+
+    // The reader copies the tiles from each row of tiles of the source, which it reads just once.
+    const std::string partialFile = getPartialFilePath( outFile );
     DDSImageReader reader( inFile, false );
-    return reader.saveAsTiledFile( outFile.c_str() );
+    if( !reader.saveAsTiledFile( partialFile.c_str() ) )
+    {
+        deleteFile( partialFile );
+        return false;
+    }
+    return commitPartialFile( partialFile, outFile );
 }
 
 bool CompressedTextureCacheManager::deleteFile( const std::string& fileName )
@@ -0,0 +1,172 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "CompressedTextureCacheManifest.h"
+
+#include <filesystem>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace imageSource {
+
+CompressedTextureCacheManifest::CompressedTextureCacheManifest( const std::string& fileName )
+    : m_fileName( fileName )
+{
+    load();
+}
+
+CompressedTextureCacheManifest::~CompressedTextureCacheManifest()
+{
+    if( m_numAppended > 0 )
+        compact();
+}
+
+void CompressedTextureCacheManifest::load()
+{
+    std::ifstream file( m_fileName );
+    std::string   line;
+    while( std::getline( file, line ) )
+    {
+        std::istringstream stream( line );
+        std::string        cacheFile;
+        std::string        field;
+        Entry              entry;
+        if( !std::getline( stream, cacheFile, '\t' ) || !std::getline( stream, field, '\t' ) )
+            continue;
+
+        // Malformed lines, and lines cut short by an interruption, are ignored.
+        try
+        {
+            entry.optionsHash = std::stoull( field, nullptr, 16 );
+            bool       isComplete = true;
+            InputStamp input;
+            while( isComplete && std::getline( stream, field, '\t' ) )
+            {
+                std::string time;
+                isComplete = std::getline( stream, time, '\t' ) && std::getline( stream, input.path, '\t' );
+                if( isComplete )
+                {
+                    input.size         = std::stoull( field );
+                    input.modifiedTime = std::stoll( time );
+                    entry.inputs.push_back( input );
+                }
+            }
+            if( isComplete && !entry.inputs.empty() )
+                m_entries[cacheFile] = entry;
+        }
+        catch( const std::exception& )
+        {
+        }
+    }
+}
+
+bool CompressedTextureCacheManifest::getStamps( const std::vector<std::string>& inputFiles, std::vector<InputStamp>& stamps )
+{
+    stamps.clear();
+    for( const std::string& inputFile : inputFiles )
+    {
+        std::error_code ec;
+        InputStamp      stamp;
+        stamp.size         = fs::file_size( inputFile, ec );
+        stamp.modifiedTime = ec ? 0 : static_cast<long long>( fs::last_write_time( inputFile, ec ).time_since_epoch().count() );
+        stamp.path         = inputFile;
+        if( ec )
+            return false;
+        stamps.push_back( stamp );
+    }
+    return true;
+}
+
+bool CompressedTextureCacheManifest::isUpToDate( const std::string& cacheFile, unsigned long long optionsHash, const std::vector<std::string>& inputFiles )
+{
+    std::vector<InputStamp> stamps;
+    if( !getStamps( inputFiles, stamps ) )
+        return false;
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    auto                         it = m_entries.find( cacheFile );
+    return it != m_entries.end() && it->second.optionsHash == optionsHash && it->second.inputs == stamps;
+}
+
+bool CompressedTextureCacheManifest::contains( const std::string& cacheFile )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    return m_entries.find( cacheFile ) != m_entries.end();
+}
+
+bool CompressedTextureCacheManifest::record( const std::string& cacheFile, unsigned long long optionsHash, const std::vector<std::string>& inputFiles )
+{
+    Entry entry;
+    entry.optionsHash = optionsHash;
+    if( !getStamps( inputFiles, entry.inputs ) )
+        return false;
+
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_entries[cacheFile] = entry;
+
+    // Append the entry to the manifest file, so that it survives an interruption.  The file is
+    // rewritten before the first append, in case an earlier run was interrupted mid-line.
+    if( !m_journal.is_open() )
+    {
+        if( !rewrite() )
+            return false;
+        m_journal.open( m_fileName, std::ios::app );
+        return static_cast<bool>( m_journal );
+    }
+    writeEntry( m_journal, cacheFile, entry );
+    m_journal.flush();
+    ++m_numAppended;
+    return static_cast<bool>( m_journal );
+}
+
+bool CompressedTextureCacheManifest::compact()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_journal.close();
+    return rewrite();
+}
+
+bool CompressedTextureCacheManifest::rewrite()
+{
+    const std::string partialFileName = getPartialFilePath( m_fileName );
+    {
+        std::ofstream file( partialFileName, std::ios::trunc );
+        for( const auto& it : m_entries )
+            writeEntry( file, it.first, it.second );
+        if( !file.flush() )
+            return false;
+    }
+    if( !commitPartialFile( partialFileName, m_fileName ) )
+        return false;
+    m_numAppended = 0;
+    return true;
+}
+
+void CompressedTextureCacheManifest::writeEntry( std::ostream& out, const std::string& cacheFile, const Entry& entry )
+{
+    out << cacheFile << '\t' << std::hex << entry.optionsHash << std::dec;
+    for( const InputStamp& input : entry.inputs )
+        out << '\t' << input.size << '\t' << input.modifiedTime << '\t' << input.path;
+    out << '\n';
+}
+
+std::string getPartialFilePath( const std::string& filePath )
+{
+    fs::path path( filePath );
+    fs::path extension = path.extension();
+    return path.replace_extension( ".part" ).string() + extension.string();
+}
+
+bool commitPartialFile( const std::string& partialFilePath, const std::string& filePath )
+{
+    std::error_code ec;
+    fs::rename( partialFilePath, filePath, ec );
+    if( !ec )
+        return true;
+    fs::remove( partialFilePath, ec );
+    return false;
+}
+
+}  // namespace imageSource
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace imageSource {
+
+/// The manifest of a compressed texture cache records, for each cached file, the options hash and the
+/// size and modification time of its input files when it was converted.  A cached file is up to date
+/// if its inputs and the options are unchanged.
+///
+/// The manifest is a text file with one tab-separated line per cached file:
+///     <cache file> <options hash> { <input size> <input time> <input file> }
+/// Conversions are appended to the file as they finish, so that an interrupted run loses no work,
+/// and later lines for a cache file replace earlier ones.  compact() rewrites the file without the
+/// replaced lines.
+class CompressedTextureCacheManifest
+{
+  public:
+    /// Load the manifest from the given file, if it exists.
+    explicit CompressedTextureCacheManifest( const std::string& fileName );
+
+    /// The destructor compacts the manifest if lines have been appended to it.
+    ~CompressedTextureCacheManifest();
+
+    /// Return true if the cache file was made from the given input files, unchanged since, with the same options.
+    bool isUpToDate( const std::string& cacheFile, unsigned long long optionsHash, const std::vector<std::string>& inputFiles );
+
+    /// Return true if the manifest has an entry for the cache file.
+    bool contains( const std::string& cacheFile );
+
+    /// Record that the cache file was made from the given input files with the given options.
+    /// Returns false if an input file is missing or the manifest can't be written.
+    bool record( const std::string& cacheFile, unsigned long long optionsHash, const std::vector<std::string>& inputFiles );
+
+    /// Rewrite the manifest file with one line per cache file.  Returns false on error.
+    bool compact();
+
+  private:
+    struct InputStamp
+    {
+        unsigned long long size;
+        long long          modifiedTime;
+        std::string        path;
+
+        bool operator==( const InputStamp& other ) const
+        {
+            return size == other.size && modifiedTime == other.modifiedTime && path == other.path;
+        }
+    };
+
+    struct Entry
+    {
+        unsigned long long      optionsHash;
+        std::vector<InputStamp> inputs;
+    };
+
+    std::mutex                   m_mutex;
+    std::string                  m_fileName;
+    std::map<std::string, Entry> m_entries;
+    std::ofstream                m_journal;
+    unsigned int                 m_numAppended = 0;
+
+    void        load();
+    bool        rewrite();
+    static void writeEntry( std::ostream& out, const std::string& cacheFile, const Entry& entry );
+    static bool getStamps( const std::vector<std::string>& inputFiles, std::vector<InputStamp>& stamps );
+};
+
+/// Get the path of a temporary file beside the given file, with the same extension.  Cache files are
+/// written to a temporary file that is renamed once it is complete, so an interrupted conversion never
+/// leaves a partial cache file behind.
+std::string getPartialFilePath( const std::string& filePath );
+
+/// Rename a completely written temporary file to its final path, replacing any existing file.
+bool commitPartialFile( const std::string& partialFilePath, const std::string& filePath );
+
+}  // namespace imageSource
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -18,6 +18,137 @@
 
 namespace imageSource {
 
+namespace {
+
+// Get the index of an EXR channel in the interleaved output pixel.
+int getChannelIndex( const char* channelName )
+{
+    // Luminance-only files are read as single-channel images.
+    if( strcmp( "R", channelName ) == 0 || strcmp( "Y", channelName ) == 0 )
+        return 0;
+    if( strcmp( "G", channelName ) == 0 )
+        return 1;
+    if( strcmp( "B", channelName ) == 0 )
+        return 2;
+    if( strcmp( "A", channelName ) == 0 )
+        return 3;
+    return -1;
+}
+
+}  // namespace
+
+/// The decode pipelines and cached chunk info of an open file, shared by the reading threads.
+struct CoreEXRReader::DecodeState
+{
+    // Idle decode pipelines.  Each decode takes one from the pool (or makes one), so N threads can
+    // decompress N chunks of the file at once, and returns it afterward, so that its packed,
+    // unpacked and scratch buffers are reused by the next chunk instead of being reallocated.
+    std::mutex                                          decodersMutex;
+    std::vector<std::unique_ptr<exr_decode_pipeline_t>> decoders;
+
+    // The chunk info of each tile, read on first use.  Indexed by levelTileOffsets[mipLevel] +
+    // tileY * numTilesX + tileX.
+    std::mutex                    chunkInfosMutex;
+    std::vector<exr_chunk_info_t> chunkInfos;
+    std::vector<bool>             hasChunkInfo;
+    std::vector<size_t>           levelTileOffsets;
+
+    // Decode a chunk into dest, interleaving the channels into pixels of numChannels elements.
+    // Returns the size of an element in bytes.
+    int decode( exr_context_t ctx, int partIndex, const exr_chunk_info_t& cinfo, char* dest, int numChannels, int lineStride );
+
+    // Get the chunk info of a tile, reading it from the file on first use.
+    exr_chunk_info_t getTileChunkInfo( exr_context_t ctx, int partIndex, int mipLevel, int tileX, int tileY, int numTilesX );
+
+    // Destroy the decode pipelines, releasing their buffers.
+    void destroyDecoders( exr_context_t ctx );
+};
+
+int CoreEXRReader::DecodeState::decode( exr_context_t ctx, int partIndex, const exr_chunk_info_t& cinfo, char* dest, int numChannels, int lineStride )
+{
+    std::unique_ptr<exr_decode_pipeline_t> decoder;
+    {
+        std::unique_lock<std::mutex> lock( decodersMutex );
+        if( !decoders.empty() )
+        {
+            decoder = std::move( decoders.back() );
+            decoders.pop_back();
+        }
+    }
+
+    try
+    {
+        // A pooled pipeline is updated for the new chunk, keeping its buffers.
+        if( decoder )
+        {
+            OTK_ERROR_CHECK( exr_decoding_update( ctx, partIndex, &cinfo, decoder.get() ) );
+        }
+        else
+        {
+            decoder.reset( new exr_decode_pipeline_t() );
+            OTK_ERROR_CHECK( exr_decoding_initialize( ctx, partIndex, &cinfo, decoder.get() ) );
+        }
+
+        const int bytesPerElement = decoder->channels[0].bytes_per_element;
+
+        // Setup the outputs
+        for( int c = 0; c < decoder->channel_count; ++c )
+        {
+            exr_coding_channel_info_t& channel = decoder->channels[c];
+            OTK_ASSERT_MSG( channel.bytes_per_element == bytesPerElement, "All channels must have same bit depth" );
+
+            const int channelIdx = getChannelIndex( channel.channel_name );
+            OTK_ASSERT_MSG( channelIdx >= 0 && channelIdx < 4, "Channel index out of range" );
+
+            channel.decode_to_ptr          = reinterpret_cast<uint8_t*>( dest ) + channelIdx * bytesPerElement;
+            channel.user_pixel_stride      = numChannels * bytesPerElement;
+            channel.user_line_stride       = lineStride;
+            channel.user_bytes_per_element = bytesPerElement;
+        }
+
+        // The routines depend on the output layout, so they are chosen again for each chunk.
+        OTK_ERROR_CHECK( exr_decoding_choose_default_routines( ctx, partIndex, decoder.get() ) );
+        OTK_ERROR_CHECK( exr_decoding_run( ctx, partIndex, decoder.get() ) );
+
+        std::unique_lock<std::mutex> lock( decodersMutex );
+        decoders.push_back( std::move( decoder ) );
+        return bytesPerElement;
+    }
+    catch( ... )
+    {
+        // Don't return a pipeline in an unknown state to the pool.
+        if( decoder )
+            exr_decoding_destroy( ctx, decoder.get() );
+        throw;
+    }
+}
+
+exr_chunk_info_t CoreEXRReader::DecodeState::getTileChunkInfo( exr_context_t ctx, int partIndex, int mipLevel, int tileX, int tileY, int numTilesX )
+{
+    const size_t index = levelTileOffsets[mipLevel] + static_cast<size_t>( tileY ) * numTilesX + tileX;
+    {
+        std::unique_lock<std::mutex> lock( chunkInfosMutex );
+        if( hasChunkInfo[index] )
+            return chunkInfos[index];
+    }
+
+    // Threads reading the same tile for the first time may both read its chunk info, which is harmless.
+    exr_chunk_info_t cinfo;
+    OTK_ERROR_CHECK( exr_read_tile_chunk_info( ctx, partIndex, tileX, tileY, mipLevel, mipLevel, &cinfo ) );
+
+    std::unique_lock<std::mutex> lock( chunkInfosMutex );
+    chunkInfos[index]   = cinfo;
+    hasChunkInfo[index] = true;
+    return cinfo;
+}
+
+void CoreEXRReader::DecodeState::destroyDecoders( exr_context_t ctx )
+{
+    std::unique_lock<std::mutex> lock( decodersMutex );
+    for( std::unique_ptr<exr_decode_pipeline_t>& decoder : decoders )
+        exr_decoding_destroy( ctx, decoder.get() );
+    decoders.clear();
+}
 
 CoreEXRReader::CoreEXRReader( const std::string& filename, bool readBaseColor )
     : m_filename( filename )
@@ -77,6 +208,9 @@ void CoreEXRReader::open( TextureInfo* info )
 
         OTK_ASSERT_MSG( numMipLevelsX == numMipLevelsY, "Number of mip levels must match for X and Y" );
         m_info.numMipLevels = static_cast<unsigned int>( numMipLevelsX );
+        OTK_ASSERT_MSG( numMipLevelsX <= 20, "Too many mip levels in EXR file" );
+
+        m_decodeState.reset( new DecodeState );
 
         if( !m_isScanline )
         {
@@ -97,6 +231,20 @@ void CoreEXRReader::open( TextureInfo* info )
                 m_levelWidths[mipLevel]  = levelSizeX;
                 m_levelHeights[mipLevel] = levelSizeY;
             }
+
+            // Size the chunk info table, one entry per tile.
+            size_t numTiles = 0;
+            for( int mipLevel = 0; mipLevel < numMipLevelsX; ++mipLevel )
+            {
+                m_decodeState->levelTileOffsets.push_back( numTiles );
+                numTiles += static_cast<size_t>( getNumTilesX( mipLevel ) ) * getNumTilesY( mipLevel );
+            }
+            m_decodeState->chunkInfos.resize( numTiles );
+            m_decodeState->hasChunkInfo.resize( numTiles );
+
+            // Reading the first chunk info makes the library parse the chunk offset table, which it
+            // keeps, so that concurrent reads don't all wait for it.
+            m_decodeState->getTileChunkInfo( m_exrCtx, m_partIndex, 0, 0, 0, getNumTilesX( 0 ) );
         }
 
         // Get channel list.
@@ -157,19 +305,31 @@ void CoreEXRReader::close()
 {
     if( m_exrCtx != nullptr )
     {
+        m_decodeState->destroyDecoders( m_exrCtx );
         OTK_ERROR_CHECK( exr_finish( &m_exrCtx ) );
     }
     m_exrCtx = nullptr;
+    m_decodeState.reset();
+}
+
+int CoreEXRReader::getNumTilesX( int mipLevel ) const
+{
+    return ( m_levelWidths[mipLevel] + m_tileWidths[mipLevel] - 1 ) / m_tileWidths[mipLevel];
+}
+
+int CoreEXRReader::getNumTilesY( int mipLevel ) const
+{
+    return ( m_levelHeights[mipLevel] + m_tileHeights[mipLevel] - 1 ) / m_tileHeights[mipLevel];
 }
 
 void CoreEXRReader::readActualTile( char* dest, int rowPitch, int mipLevel, int tileX, int tileY )
 {
     OTK_ASSERT( !m_isScanline );
 
-    const int numXTiles = ( m_levelWidths[mipLevel] + m_tileWidths[mipLevel] - 1 ) / m_tileWidths[mipLevel];
-    const int numYTiles = ( m_levelHeights[mipLevel] + m_tileHeights[mipLevel] - 1 ) / m_tileHeights[mipLevel];
+    const int numXTiles = getNumTilesX( mipLevel );
+    const int numYTiles = getNumTilesY( mipLevel );
 
-    if( tileX >= numXTiles || tileY > numYTiles )
+    if( tileX >= numXTiles || tileY >= numYTiles )
     {
         std::cerr << "Warning: Attempting to read non-existent tile [" << tileX << ", " << tileY << "]" << std::endl;
         return;
@@ -184,42 +344,8 @@ void CoreEXRReader::readActualTile( char* dest, int rowPitch, int mipLevel, int
     const int  actualTileWidth  = partialX ? m_levelWidths[mipLevel] % sourceTileWidth : sourceTileWidth;
     const int  actualTileHeight = partialY ? m_levelHeights[mipLevel] % sourceTileHeight : sourceTileHeight;
 
-    exr_chunk_info_t      cinfo;
-    exr_decode_pipeline_t decoder;
-    OTK_ERROR_CHECK( exr_read_tile_chunk_info( m_exrCtx, m_partIndex, tileX, tileY, mipLevel, mipLevel, &cinfo ) );
-    OTK_ERROR_CHECK( exr_decoding_initialize( m_exrCtx, 0, &cinfo, &decoder ) );
-
-    const int bytesPerChannel = decoder.channels[0].bytes_per_element;
-
-    // Setup the outputs
-    for( int c = 0; c < decoder.channel_count; ++c )
-    {
-        OTK_ASSERT_MSG( decoder.channels[c].bytes_per_element == bytesPerChannel,
-                           "All channels must have same bit depth" );
-
-        int channelIdx = -1;
-        if( strcmp( "R", decoder.channels[c].channel_name ) == 0 ||
-            ( strcmp( "Y", decoder.channels[c].channel_name ) == 0 && decoder.channel_count == 1 ) ) // Support single-channel, luminance-only files.
-            channelIdx = 0;
-        else if( strcmp( "G", decoder.channels[c].channel_name ) == 0 )
-            channelIdx = 1;
-        else if( strcmp( "B", decoder.channels[c].channel_name ) == 0 )
-            channelIdx = 2;
-        else if( strcmp( "A", decoder.channels[c].channel_name ) == 0 )
-            channelIdx = 3;
-
-        OTK_ASSERT_MSG( channelIdx >= 0 && channelIdx < 4, "Channel index out of range" );
-
-        decoder.channels[c].decode_to_ptr = reinterpret_cast<uint8_t*>( dest ) + channelIdx * decoder.channels[c].bytes_per_element;
-        decoder.channels[c].user_pixel_stride      = m_info.numChannels * decoder.channels[c].bytes_per_element;
-        decoder.channels[c].user_line_stride       = rowPitch;
-        decoder.channels[c].user_bytes_per_element = decoder.channels[c].bytes_per_element;
-    }
-
-    // Run the decoder
-    OTK_ERROR_CHECK( exr_decoding_choose_default_routines( m_exrCtx, 0, &decoder ) );
-    OTK_ERROR_CHECK( exr_decoding_run( m_exrCtx, 0, &decoder ) );
-    OTK_ERROR_CHECK( exr_decoding_destroy( m_exrCtx, &decoder ) );
+    const exr_chunk_info_t cinfo           = m_decodeState->getTileChunkInfo( m_exrCtx, m_partIndex, mipLevel, tileX, tileY, numXTiles );
+    const int              bytesPerChannel = m_decodeState->decode( m_exrCtx, m_partIndex, cinfo, dest, m_info.numChannels, rowPitch );
 
     // Stats tracking
     {
@@ -239,41 +365,10 @@ void CoreEXRReader::readScanlineData( char* dest )
     size_t offset = 0;
     for( int y = 0; y < (int)m_info.height; y += scanlinesPerChunk )
     {
-        exr_chunk_info_t      cinfo;
-        exr_decode_pipeline_t decoder;
+        exr_chunk_info_t cinfo;
         OTK_ERROR_CHECK( exr_read_scanline_chunk_info( m_exrCtx, m_partIndex, y, &cinfo ) );
-        OTK_ERROR_CHECK( exr_decoding_initialize( m_exrCtx, 0, &cinfo, &decoder ) );
-
-        const int bytesPerElement = decoder.channels[0].bytes_per_element;
-
-        // Setup the outputs
-        for( int c = 0; c < decoder.channel_count; ++c )
-        {
-            OTK_ASSERT_MSG( decoder.channels[c].bytes_per_element == bytesPerElement,
-                                "All channels must have same bit depth" );
-
-            int channelIdx = -1;
-            if( strcmp( "R", decoder.channels[c].channel_name ) == 0 || strcmp( "Y", decoder.channels[c].channel_name ) == 0 )
-                channelIdx = 0;
-            else if( strcmp( "G", decoder.channels[c].channel_name ) == 0 )
-                channelIdx = 1;
-            else if( strcmp( "B", decoder.channels[c].channel_name ) == 0 )
-                channelIdx = 2;
-            else if( strcmp( "A", decoder.channels[c].channel_name ) == 0 )
-                channelIdx = 3;
-
-            OTK_ASSERT_MSG( channelIdx >= 0 && channelIdx < 4, "Channel index out of range" );
-
-            decoder.channels[c].decode_to_ptr = reinterpret_cast<uint8_t*>( dest ) + offset + channelIdx * decoder.channels[c].bytes_per_element;
-            decoder.channels[c].user_pixel_stride      = m_info.numChannels * decoder.channels[c].bytes_per_element;
-            decoder.channels[c].user_line_stride       = m_info.width * decoder.channels[c].user_pixel_stride;
-            decoder.channels[c].user_bytes_per_element = decoder.channels[c].bytes_per_element;
-        }
-
-        // Run the decoder
-        OTK_ERROR_CHECK( exr_decoding_choose_default_routines( m_exrCtx, 0, &decoder ) );
-        OTK_ERROR_CHECK( exr_decoding_run( m_exrCtx, 0, &decoder ) );
-        OTK_ERROR_CHECK( exr_decoding_destroy( m_exrCtx, &decoder ) );
+        const int bytesPerElement = m_decodeState->decode( m_exrCtx, m_partIndex, cinfo, dest + offset, m_info.numChannels,
+                                                           m_info.width * getBitsPerPixel( m_info ) / BITS_PER_BYTE );
 
         offset += m_info.width * m_info.numChannels * bytesPerElement * scanlinesPerChunk;
     }
@@ -350,8 +445,8 @@ bool CoreEXRReader::readMipLevel( char* dest, unsigned int mipLevel, unsigned in
     }
     else
     {
-        const int numXTiles     = ( m_levelWidths[mipLevel] + m_tileWidths[mipLevel] - 1 ) / m_tileWidths[mipLevel];
-        const int numYTiles     = ( m_levelHeights[mipLevel] + m_tileHeights[mipLevel] - 1 ) / m_tileHeights[mipLevel];
+        const int numXTiles     = getNumTilesX( mipLevel );
+        const int numYTiles     = getNumTilesY( mipLevel );
         const int bytesPerPixel = getBitsPerPixel( m_info ) / BITS_PER_BYTE;
 
         for( int rowIdx = 0; rowIdx < numYTiles; ++rowIdx )
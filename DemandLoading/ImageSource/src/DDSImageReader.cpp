@@ -1,8 +1,9 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #include <OptiXToolkit/ImageSource/DDSImageReader.h>
+#include <OptiXToolkit/ImageSource/ReadOnlyFile.h>
 
 #include <OptiXToolkit/Error/ErrorCheck.h>
 #include <OptiXToolkit/Error/cuErrorCheck.h>
@@ -10,6 +11,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <utility>
 
 #include <vector_functions.h> // from CUDA toolkit
 
@@ -17,31 +19,79 @@
 
 namespace imageSource {
 
-DDSImageReader::DDSImageReader( const std::string& fileName, bool readBaseColor )
+DDSImageReader::DDSImageReader( const std::string& fileName, bool readBaseColor, const DDSReaderOptions& options )
     : m_fileName( fileName )
+    , m_options( options )
     , m_readBaseColor( readBaseColor )
 {
 }
 
+DDSImageReader::~DDSImageReader()
+{
+    close();
+}
+
 void DDSImageReader::open( TextureInfo* info )
 {
-    std::unique_lock<std::mutex> lock( m_mutex );
-    if( isOpen() )
+    // Reads call open, so avoid locking once the file is open.
+    if( !isOpen() )
     {
-        if( info != nullptr )
-            *info = m_info;
-        return;
+        std::unique_lock<std::mutex> lock( m_mutex );
+        if( !isOpen() )
+        {
+            std::shared_ptr<ReadOnlyFile> file( new ReadOnlyFile );
+            if( !file->open( m_fileName, m_options.mapFile ) )
+            {
+                if( !m_headerRead )
+                    m_info.isValid = false;
+                return;
+            }
+            std::atomic_store( &m_file, std::shared_ptr<const ReadOnlyFile>( std::move( file ) ) );
+
+            // The header is read once, since reads that overlap a close and reopen use its fields.
+            if( !m_headerRead )
+            {
+                m_info.isValid = false;
+                readHeader();
+                m_headerRead = true;
+            }
+
+            // Resize mip level cache if not a tiled file
+            if( m_info.isValid && !m_fileIsTiled )
+            {
+                std::unique_lock<std::mutex> lk( m_mipCacheMutex );
+                m_mipCache.resize( m_info.numMipLevels );
+                m_mipCacheLastUse.resize( m_info.numMipLevels );
+            }
+            m_isOpen.store( true, std::memory_order_release );
+        }
     }
 
-    m_info.isValid = false;
-    m_file.open( m_fileName, std::ios::binary );
-    if( !m_file.is_open() ) 
-        return;
-    m_file.unsetf( std::ios::skipws );
+    if( info != nullptr )
+        *info = m_info;
+}
+
+void DDSImageReader::close()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_isOpen.store( false, std::memory_order_release );
+
+    // Reads that are in progress hold their own references to the file, which is closed (and
+    // unmapped) when the last of them finishes.
+    std::atomic_store( &m_file, std::shared_ptr<const ReadOnlyFile>() );
 
+    std::unique_lock<std::mutex> mipCacheLock( m_mipCacheMutex );
+    m_mipCache.clear();
+    m_mipCacheLastUse.clear();
+    m_mipCacheSize = 0;
+}
+
+void DDSImageReader::readHeader()
+{
     // Read standard dds file header
+    const std::shared_ptr<const ReadOnlyFile> file = getFile();
     m_ddsFileHeader = DDSFileHeader{};
-    m_file.read( reinterpret_cast<char*>( &m_ddsFileHeader ), sizeof( DDSFileHeader ) );
+    file->read( reinterpret_cast<char*>( &m_ddsFileHeader ), sizeof( DDSFileHeader ), 0 );
     m_fileHeaderOffset = static_cast<int>( sizeof( DDSFileHeader ) );
     if( m_ddsFileHeader.magicNumber != DDS_MAGIC_NUMBER )
         return;
@@ -51,8 +101,8 @@ void DDSImageReader::open( TextureInfo* info )
     char* fourCC = m_ddsFileHeader.pixelFormat.fourCCcode;
     if( fourCC[0] == 'D' && fourCC[1] == 'X' && fourCC[2] == '1' && fourCC[3] == '0' )
     {
+        file->read( reinterpret_cast<char*>( &m_ddsHeaderExtension ), sizeof( DDSHeaderExtension ), m_fileHeaderOffset );
         m_fileHeaderOffset += static_cast<int>( sizeof( DDSHeaderExtension ) );
-        m_file.read( reinterpret_cast<char*>( &m_ddsHeaderExtension ), sizeof( DDSHeaderExtension ) );
     }
     int dxgiFormat = m_ddsHeaderExtension.dxgiFormat;
     m_fileIsTiled = ( m_ddsFileHeader.flags & MISC_TILED_PIXEL_LAYOUT ) != 0;
@@ -101,16 +151,6 @@ void DDSImageReader::open( TextureInfo* info )
             break;
         }
     }
-
-    // Resize mip level cache if not a tiled file
-    if( !m_fileIsTiled )
-    {
-        std::unique_lock<std::mutex> lk( m_mipCacheMutex );
-        m_mipCache.resize( m_info.numMipLevels );
-    }
-
-    if( info != nullptr )
-        *info = m_info;
 }
 
 bool DDSImageReader::readTile( char* dest, unsigned int mipLevel, const Tile& tile, CUstream /*stream*/  )
@@ -124,6 +164,18 @@ bool DDSImageReader::readTile( char* dest, unsigned int mipLevel, const Tile& ti
         return readTileFlat( dest, mipLevel, tile );
 }
 
+bool DDSImageReader::readTiles( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles, CUstream stream )
+{
+    open( nullptr );
+    OTK_ASSERT_MSG( mipLevel < m_info.numMipLevels, "Attempt to read tile from non-existent mip-level." );
+
+    // Flat files are read a mip level at a time, so there is nothing to coalesce.
+    if( m_fileIsTiled )
+        return readTilesTiled( dest, mipLevel, tiles, numTiles );
+    else
+        return ImageSourceBase::readTiles( dest, mipLevel, tiles, numTiles, stream );
+}
+
 bool DDSImageReader::readMipLevel( char* dest, unsigned int mipLevel, unsigned int /*width*/, unsigned int /*height*/, CUstream /*stream*/ )
 {
     open( nullptr );
@@ -196,7 +248,9 @@ bool DDSImageReader::saveAsTiledFile( const char* fileName )
 
     // Save Tiles
     std::vector<char> tileBuff( TILE_SIZE_IN_BYTES );
+    std::vector<char> tileRowBuff;
     int mipTailFirstLevel = getMipTailStartLevel();
+    const unsigned int tileWidthInBlocks = getTileWidth() / BC_BLOCK_WIDTH;
 
     for( int mipLevel = 0; mipLevel < static_cast<int>( m_info.numMipLevels ); ++mipLevel )
     {
@@ -204,14 +258,37 @@ bool DDSImageReader::saveAsTiledFile( const char* fileName )
             break;
         unsigned int mipLevelWidthInTiles = getMipLevelWidthInTiles( mipLevel );
         unsigned int mipLevelHeightInTiles = getMipLevelHeightInTiles( mipLevel );
+        unsigned int mipWidthInBlocks = ( m_info.width / BC_BLOCK_WIDTH ) >> mipLevel;
 
         for( unsigned int tileY = 0; tileY < mipLevelHeightInTiles; ++tileY )
         {
+            // A flat file is read a row of tiles at a time, so each byte of the source is read once.
+            if( !m_fileIsTiled && !readTileRowFlat( tileRowBuff, mipLevel, tileY ) )
+                return false;
+            const unsigned int numBlockRows = static_cast<unsigned int>( tileRowBuff.size() / ( mipWidthInBlocks * m_blockSizeInBytes ) );
+
             for( unsigned int tileX = 0; tileX < mipLevelWidthInTiles; ++tileX )
             {
-                Tile tile{tileX, tileY, getTileWidth(), getTileHeight()};
-                if ( !readTile( tileBuff.data(), mipLevel, tile, CUstream{0} ) )
-                    return false;
+                if( m_fileIsTiled )
+                {
+                    Tile tile{tileX, tileY, getTileWidth(), getTileHeight()};
+                    if ( !readTile( tileBuff.data(), mipLevel, tile, CUstream{0} ) )
+                        return false;
+                }
+                else
+                {
+                    // Copy the tile's rows of blocks, padding partial tiles with zeros.
+                    const unsigned int widthInBlocks = std::min( tileWidthInBlocks, mipWidthInBlocks - tileX * tileWidthInBlocks );
+                    std::fill( tileBuff.begin(), tileBuff.end(), 0 );
+                    for( unsigned int row = 0; row < numBlockRows; ++row )
+                    {
+                        memcpy( tileBuff.data() + row * tileWidthInBlocks * m_blockSizeInBytes,
+                                tileRowBuff.data() + ( row * mipWidthInBlocks + tileX * tileWidthInBlocks ) * m_blockSizeInBytes,
+                                widthInBlocks * m_blockSizeInBytes );
+                    }
+                    std::unique_lock<std::mutex> statsLock( m_statsMutex );
+                    m_numTilesRead += 1;
+                }
                 ofile.write( tileBuff.data(), TILE_SIZE_IN_BYTES );
             }
         }
@@ -236,7 +313,7 @@ bool DDSImageReader::saveAsTiledFile( const char* fileName )
 
     // Close file
     ofile.close();
-    return true;
+    return !ofile.fail();
 }
 
 int DDSImageReader::getMipTailStartLevel()
@@ -266,20 +343,70 @@ int DDSImageReader::getMipTailSize()
 
 //---------------- Flat (non-tiled) reading functions
 
-bool DDSImageReader::readTileFlat( char* dest, unsigned int mipLevel, const Tile& tile )
+std::shared_ptr<const std::vector<char>> DDSImageReader::getCachedMipLevelFlat( unsigned int mipLevel )
 {
-    // Read the mip level and extract the tile
+    const size_t levelSize = getMipLevelSizeInBytesFlat( mipLevel );
+    if( levelSize > m_options.maxMipCacheSize )
+        return nullptr;
+
+    // The cache is empty while the file is closed.
     {
         std::unique_lock<std::mutex> lock( m_mipCacheMutex );
-        if( m_mipCache[mipLevel].size() == 0 )
+        if( mipLevel >= m_mipCache.size() )
+            return nullptr;
+        m_mipCacheLastUse[mipLevel] = ++m_mipCacheClock;
+        if( m_mipCache[mipLevel] )
+            return m_mipCache[mipLevel];
+    }
+
+    // Read the level without holding the lock, so that reads of other levels aren't blocked.
+    std::shared_ptr<std::vector<char>> level( new std::vector<char>( levelSize ) );
+    if( !readMipLevelFlat( level->data(), mipLevel ) )
+        return nullptr;
+
+    // Another thread may have read the level meanwhile, in which case its copy is used.
+    std::unique_lock<std::mutex> lock( m_mipCacheMutex );
+    if( mipLevel >= m_mipCache.size() )
+        return level;
+    if( m_mipCache[mipLevel] )
+        return m_mipCache[mipLevel];
+
+    // Evict the least recently used levels to make room for the level.
+    while( m_mipCacheSize + levelSize > m_options.maxMipCacheSize )
+    {
+        unsigned int lruLevel = mipLevel;
+        for( unsigned int level = 0; level < m_mipCache.size(); ++level )
         {
-            m_mipCache[mipLevel].resize( getMipLevelSizeInBytes( mipLevel ) );
-            if( !readMipLevelFlat( m_mipCache[mipLevel].data(), mipLevel ) )
-                return false;
+            if( m_mipCache[level] && ( lruLevel == mipLevel || m_mipCacheLastUse[level] < m_mipCacheLastUse[lruLevel] ) )
+                lruLevel = level;
         }
+        m_mipCacheSize -= m_mipCache[lruLevel]->size();
+        m_mipCache[lruLevel].reset();
+    }
+
+    m_mipCache[mipLevel] = level;
+    m_mipCacheSize += levelSize;
+    return level;
+}
+
+bool DDSImageReader::readTileFlat( char* dest, unsigned int mipLevel, const Tile& tile )
+{
+    // Copy the tile's rows of blocks from the mapped file or the cached mip level.  If neither is
+    // available, read the rows from the file.
+    const std::shared_ptr<const ReadOnlyFile> file = getFile();
+    if( !file )
+        return false;
+    Stopwatch                                stopwatch;
+    const unsigned long long                 levelOffset = getMipLevelOffsetInBytesFlat( mipLevel );
+    const char*                              mipSrc      = file->getData( levelOffset, getMipLevelSizeInBytesFlat( mipLevel ) );
+    std::shared_ptr<const std::vector<char>> cachedLevel;
+    if( mipSrc == nullptr )
+    {
+        cachedLevel = getCachedMipLevelFlat( mipLevel );
+        if( cachedLevel )
+            mipSrc = cachedLevel->data();
     }
 
-    const char* mipSrc = m_mipCache[mipLevel].data();
     int mipWidthInBlocks = ( m_info.width / BC_BLOCK_WIDTH ) >> mipLevel; 
     int mipHeightInBlocks = ( m_info.height / BC_BLOCK_HEIGHT ) >> mipLevel;
     unsigned int tileWidthInBlocks = tile.width / BC_BLOCK_WIDTH;
@@ -294,26 +421,60 @@ bool DDSImageReader::readTileFlat( char* dest, unsigned int mipLevel, const Tile
         int mipRow = blockTile.y * tileHeightInBlocks + tileRow;
         int mipSourceOffset = ( mipRow * mipWidthInBlocks + blockTile.x * tileWidthInBlocks ) * m_blockSizeInBytes;
         int tileDestOffset = ( tileRow * tileWidthInBlocks ) * m_blockSizeInBytes;
-        memcpy( dest + tileDestOffset, mipSrc + mipSourceOffset, m_blockSizeInBytes * blockTile.width );
+        if( mipSrc != nullptr )
+            memcpy( dest + tileDestOffset, mipSrc + mipSourceOffset, m_blockSizeInBytes * blockTile.width );
+        else if( !file->read( dest + tileDestOffset, m_blockSizeInBytes * blockTile.width, levelOffset + mipSourceOffset ) )
+            return false;
     }
 
-    // Stats tracking
+    // Stats tracking.  The bytes of cached levels were counted when the levels were read.
     {
         std::unique_lock<std::mutex> statsLock( m_statsMutex );
         m_numTilesRead += 1;
+        if( !cachedLevel )
+        {
+            m_numBytesRead += static_cast<unsigned long long>( m_blockSizeInBytes ) * blockTile.width * blockTile.height;
+            m_totalReadTime += stopwatch.elapsed();
+        }
     }
     
     return true;
 }
 
+bool DDSImageReader::readTileRowFlat( std::vector<char>& dest, unsigned int mipLevel, unsigned int tileY )
+{
+    // The rows of blocks covered by a row of tiles are contiguous in a flat file.
+    Stopwatch    stopwatch;
+    const int    mipWidthInBlocks   = ( m_info.width / BC_BLOCK_WIDTH ) >> mipLevel;
+    const int    mipHeightInBlocks  = ( m_info.height / BC_BLOCK_HEIGHT ) >> mipLevel;
+    const int    tileHeightInBlocks = getTileHeight() / BC_BLOCK_HEIGHT;
+    const int    firstRow           = tileY * tileHeightInBlocks;
+    const int    numRows            = std::min( tileHeightInBlocks, mipHeightInBlocks - firstRow );
+    const size_t rowSize            = static_cast<size_t>( mipWidthInBlocks ) * m_blockSizeInBytes;
+
+    const std::shared_ptr<const ReadOnlyFile> file = getFile();
+    dest.resize( numRows * rowSize );
+    if( !file || !file->read( dest.data(), dest.size(), getMipLevelOffsetInBytesFlat( mipLevel ) + firstRow * rowSize ) )
+        return false;
+
+    // Stats tracking
+    {
+        std::unique_lock<std::mutex> statsLock( m_statsMutex );
+        m_numBytesRead += dest.size();
+        m_totalReadTime += stopwatch.elapsed();
+    }
+
+    return true;
+}
+
 bool DDSImageReader::readMipLevelFlat( char* dest, unsigned int mipLevel )
 {
     OTK_ASSERT_MSG( mipLevel < m_info.numMipLevels, "Attempt to read from non-existent mip-level." );
-    std::unique_lock<std::mutex> lock( m_mutex );
     Stopwatch stopwatch;
 
-    m_file.seekg( getMipLevelOffsetInBytesFlat( mipLevel ) );
-    m_file.read( reinterpret_cast<char*>( dest ), getMipLevelSizeInBytesFlat( mipLevel ) );
+    const std::shared_ptr<const ReadOnlyFile> file = getFile();
+    if( !file || !file->read( dest, getMipLevelSizeInBytesFlat( mipLevel ), getMipLevelOffsetInBytesFlat( mipLevel ) ) )
+        return false;
 
     // Stats tracking
     {
@@ -344,10 +505,10 @@ int DDSImageReader::getMipLevelSizeInBytesFlat( int mipLevel )
 
 bool DDSImageReader::readTileTiled( char* dest, unsigned int mipLevel, const Tile& tile )
 {
-    std::unique_lock<std::mutex> lock( m_mutex );
-    Stopwatch stopwatch;
-    m_file.seekg( getTileOffsetInBytesTiled( mipLevel, tile ) );
-    m_file.read( dest, TILE_SIZE_IN_BYTES );
+    Stopwatch                                 stopwatch;
+    const std::shared_ptr<const ReadOnlyFile> file = getFile();
+    if( !file || !file->read( dest, TILE_SIZE_IN_BYTES, getTileOffsetInBytesTiled( mipLevel, tile ) ) )
+        return false;
 
     // Stats tracking
     {
@@ -360,9 +521,39 @@ bool DDSImageReader::readTileTiled( char* dest, unsigned int mipLevel, const Til
     return true;
 }
 
+bool DDSImageReader::readTilesTiled( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles )
+{
+    // Sort the tiles by file offset.
+    std::vector<std::pair<int, unsigned int>> offsets( numTiles );
+    for( unsigned int i = 0; i < numTiles; ++i )
+        offsets[i] = std::make_pair( getTileOffsetInBytesTiled( mipLevel, tiles[i] ), i );
+    std::sort( offsets.begin(), offsets.end() );
+
+    Stopwatch                                 stopwatch;
+    const std::shared_ptr<const ReadOnlyFile> file = getFile();
+    if( !file )
+        return false;
+
+    // Read the tiles in file order, so that runs of adjacent tiles are read sequentially.
+    for( unsigned int i = 0; i < numTiles; ++i )
+    {
+        if( !file->read( dest[offsets[i].second], TILE_SIZE_IN_BYTES, offsets[i].first ) )
+            return false;
+    }
+
+    // Stats tracking
+    {
+        std::unique_lock<std::mutex> statsLock( m_statsMutex );
+        m_numTilesRead += numTiles;
+        m_numBytesRead += static_cast<unsigned long long>( numTiles ) * TILE_SIZE_IN_BYTES;
+        m_totalReadTime += stopwatch.elapsed();
+    }
+
+    return true;
+}
+
 bool DDSImageReader::readMipLevelTiled( char* dest, unsigned int mipLevel )
 {
-    //std::unique_lock<std::mutex> lock( m_mutex );
     std::vector<char> tileBuff;
 
     // If the mip level is part of the mip tail, load the mip tail and
@@ -429,11 +620,11 @@ bool DDSImageReader::readMipLevelTiled( char* dest, unsigned int mipLevel )
 
 bool DDSImageReader::readMipTailTiled( char* dest, unsigned int mipTailFirstLevel )
 {
-    std::unique_lock<std::mutex> lock( m_mutex );
     Stopwatch stopwatch;
     OTK_ASSERT_MSG( mipTailFirstLevel == static_cast<unsigned int>(getMipTailStartLevel()), "Improper mip tail first level for tiled file." );
-    m_file.seekg( getMipLevelOffsetInBytesTiled( mipTailFirstLevel ) );
-    m_file.read( dest, getMipTailSize() );
+    const std::shared_ptr<const ReadOnlyFile> file = getFile();
+    if( !file || !file->read( dest, getMipTailSize(), getMipLevelOffsetInBytesTiled( mipTailFirstLevel ) ) )
+        return false;
 
     // Stats tracking
     {
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <OptiXToolkit/ImageSource/DecodedDataCache.h>
+
+namespace imageSource {
+
+const unsigned int DecodedDataCache::BAND_HEIGHT;
+const size_t       DecodedDataCache::DEFAULT_MAX_SIZE;
+
+std::shared_ptr<DecodedDataCache> DecodedDataCache::getInstance()
+{
+    static std::shared_ptr<DecodedDataCache> instance = std::make_shared<DecodedDataCache>();
+    return instance;
+}
+
+DecodedDataCache::DecodedDataCache( size_t maxSizeInBytes )
+    : m_maxSize( maxSizeInBytes )
+{
+}
+
+void DecodedDataCache::setMaxSize( size_t maxSizeInBytes )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_maxSize = maxSizeInBytes;
+    if( m_maxSize != 0 )
+        evict( m_maxSize );
+}
+
+size_t DecodedDataCache::getMaxSize() const
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    return m_maxSize;
+}
+
+size_t DecodedDataCache::getSize() const
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    return m_size;
+}
+
+unsigned long long DecodedDataCache::createImageId()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    const unsigned long long imageId = m_nextImageId++;
+    m_imageStats[imageId] = DecodedDataStatistics{};
+    return imageId;
+}
+
+std::shared_ptr<DecodedBand> DecodedDataCache::getBand( unsigned long long imageId, unsigned int mipLevel, unsigned int band, size_t sizeInBytes, unsigned int numBlocks )
+{
+    const Key                    key{imageId, mipLevel, band};
+    std::unique_lock<std::mutex> lock( m_mutex );
+    DecodedDataStatistics&       stats = m_imageStats[imageId];
+
+    auto it = m_bands.find( key );
+    if( it != m_bands.end() )
+    {
+        ++stats.numHits;
+        ++m_totals.numHits;
+        m_lruList.splice( m_lruList.begin(), m_lruList, it->second.lruPosition );
+        return it->second.band;
+    }
+    ++stats.numMisses;
+    ++m_totals.numMisses;
+
+    // Make room for the band before adding it, so that it isn't the one evicted.
+    if( m_maxSize != 0 )
+        evict( sizeInBytes < m_maxSize ? m_maxSize - sizeInBytes : 0 );
+
+    // The pixels are allocated by the first thread to decode a block, outside the cache's lock.
+    std::shared_ptr<DecodedBand> result( new DecodedBand );
+    result->blockStates.resize( numBlocks, DecodedBand::EMPTY );
+    m_lruList.push_front( key );
+    m_bands[key] = Entry{result, sizeInBytes, m_lruList.begin()};
+    m_size += sizeInBytes;
+    return result;
+}
+
+bool DecodedDataCache::hasBand( unsigned long long imageId, unsigned int mipLevel, unsigned int band ) const
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    return m_bands.find( Key{imageId, mipLevel, band} ) != m_bands.end();
+}
+
+void DecodedDataCache::removeImage( unsigned long long imageId )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    auto                         it = m_bands.lower_bound( Key{imageId, 0, 0} );
+    while( it != m_bands.end() && it->first.imageId == imageId )
+        erase( it++ );
+}
+
+void DecodedDataCache::releaseImageId( unsigned long long imageId )
+{
+    removeImage( imageId );
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_imageStats.erase( imageId );
+}
+
+DecodedDataStatistics DecodedDataCache::getStatistics( unsigned long long imageId ) const
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    auto                         it = m_imageStats.find( imageId );
+    return it != m_imageStats.end() ? it->second : DecodedDataStatistics{};
+}
+
+DecodedDataStatistics DecodedDataCache::getStatistics() const
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    return m_totals;
+}
+
+void DecodedDataCache::evict( size_t maxSize )
+{
+    while( m_size > maxSize && !m_lruList.empty() )
+    {
+        auto it = m_bands.find( m_lruList.back() );
+        ++m_imageStats[it->first.imageId].numEvictions;
+        ++m_totals.numEvictions;
+        erase( it );
+    }
+}
+
+void DecodedDataCache::erase( std::map<Key, Entry>::iterator it )
+{
+    m_size -= it->second.sizeInBytes;
+    m_lruList.erase( it->second.lruPosition );
+    m_bands.erase( it );
+}
+
+}  // namespace imageSource
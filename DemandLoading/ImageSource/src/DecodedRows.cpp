@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "DecodedRows.h"
+
+namespace imageSource {
+
+namespace {
+
+// Claim the band for decoding if nobody has decoded it yet.
+bool claimBand( DecodedBand& band, size_t sizeInBytes )
+{
+    std::unique_lock<std::mutex> lock( band.mutex );
+    if( band.blockStates[0] != DecodedBand::EMPTY )
+        return false;
+    band.blockStates[0] = DecodedBand::IN_PROGRESS;
+    if( band.pixels.empty() )
+        band.pixels.resize( sizeInBytes );
+    return true;
+}
+
+}  // namespace
+
+bool getDecodedRows( DecodedDataCache&                        cache,
+                     unsigned long long                       imageId,
+                     unsigned int                             mipLevel,
+                     const DecodedLevelLayout&                layout,
+                     unsigned int                             y0,
+                     unsigned int                             y1,
+                     std::mutex&                              levelMutex,
+                     const std::function<bool( char* dest )>& readLevel,
+                     const ReadRowsFunction&                  readRows,
+                     DecodedRows&                             rows )
+{
+    const unsigned int firstBand = y0 / DecodedDataCache::BAND_HEIGHT;
+    const unsigned int endBand   = ( y1 - 1 ) / DecodedDataCache::BAND_HEIGHT + 1;
+    rows.layout                  = layout;
+    rows.firstBand               = firstBand;
+    rows.bands.assign( endBand - firstBand, std::shared_ptr<DecodedBand>() );
+
+    // Use the cached bands if they have all been read (or are being read).
+    bool missing = false;
+    for( unsigned int i = firstBand; i < endBand && !missing; ++i )
+        missing = !cache.hasBand( imageId, mipLevel, i );
+    if( !missing )
+    {
+        for( unsigned int i = firstBand; i < endBand; ++i )
+        {
+            rows.bands[i - firstBand]         = cache.getBand( imageId, mipLevel, i, layout.getBandSizeInBytes( i ), 1 );
+            DecodedBand&                 band = *rows.bands[i - firstBand];
+            std::unique_lock<std::mutex> lock( band.mutex );
+            missing = missing || band.blockStates[0] == DecodedBand::EMPTY;
+        }
+    }
+
+    // If the rows can be read directly, read only the requested bands that nobody has claimed.
+    if( missing && readRows )
+    {
+        for( unsigned int i = firstBand; i < endBand; ++i )
+        {
+            rows.bands[i - firstBand] = cache.getBand( imageId, mipLevel, i, layout.getBandSizeInBytes( i ), 1 );
+            DecodedBand& band         = *rows.bands[i - firstBand];
+            if( !claimBand( band, layout.getBandSizeInBytes( i ) ) )
+                continue;
+            const unsigned int bandY0 = i * DecodedDataCache::BAND_HEIGHT;
+            const unsigned int bandY1 = std::min( bandY0 + DecodedDataCache::BAND_HEIGHT, layout.height );
+            const bool         ok     = readRows( band.pixels.data(), bandY0, bandY1 );
+            std::unique_lock<std::mutex> lock( band.mutex );
+            band.blockStates[0] = ok ? DecodedBand::DONE : DecodedBand::EMPTY;
+            band.blockDone.notify_all();
+        }
+    }
+
+    // Otherwise the whole level is read, so also claim as many of the level's other missing bands as
+    // fit in the cache with the requested ones; the rest would only evict bands that are in use.
+    // Get those first, so that the requested bands are the most recently used.  Holding the level's
+    // mutex while claiming and reading the bands ensures that the level is only read once.
+    else if( missing )
+    {
+        std::unique_lock<std::mutex>              levelLock( levelMutex );
+        std::vector<unsigned int>                 claimedIndices;
+        std::vector<std::shared_ptr<DecodedBand>> claimedBands;
+        const size_t                              maxSize = cache.getMaxSize();
+        size_t                                    size    = 0;
+        for( unsigned int i = firstBand; i < endBand; ++i )
+            size += layout.getBandSizeInBytes( i );
+        for( unsigned int i = 0; i < layout.getNumBands(); ++i )
+        {
+            const size_t bandSize = layout.getBandSizeInBytes( i );
+            if( ( i >= firstBand && i < endBand ) || ( maxSize != 0 && size + bandSize > maxSize )
+                || cache.hasBand( imageId, mipLevel, i ) )
+                continue;
+            std::shared_ptr<DecodedBand> band = cache.getBand( imageId, mipLevel, i, bandSize, 1 );
+            if( claimBand( *band, bandSize ) )
+            {
+                claimedIndices.push_back( i );
+                claimedBands.push_back( band );
+                size += bandSize;
+            }
+        }
+        for( unsigned int i = firstBand; i < endBand; ++i )
+        {
+            rows.bands[i - firstBand] = cache.getBand( imageId, mipLevel, i, layout.getBandSizeInBytes( i ), 1 );
+            if( claimBand( *rows.bands[i - firstBand], layout.getBandSizeInBytes( i ) ) )
+            {
+                claimedIndices.push_back( i );
+                claimedBands.push_back( rows.bands[i - firstBand] );
+            }
+        }
+
+        // Read the level, and copy it into the claimed bands.
+        if( !claimedBands.empty() )
+        {
+            std::vector<char> levelPixels( layout.height * layout.getRowSizeInBytes() );
+            const bool        ok = readLevel( levelPixels.data() );
+            for( size_t i = 0; i < claimedBands.size(); ++i )
+            {
+                DecodedBand& band = *claimedBands[i];
+                if( ok )
+                {
+                    const size_t offset = claimedIndices[i] * DecodedDataCache::BAND_HEIGHT * layout.getRowSizeInBytes();
+                    std::copy_n( &levelPixels[offset], layout.getBandSizeInBytes( claimedIndices[i] ), band.pixels.data() );
+                }
+                std::unique_lock<std::mutex> lock( band.mutex );
+                band.blockStates[0] = ok ? DecodedBand::DONE : DecodedBand::EMPTY;
+                band.blockDone.notify_all();
+            }
+        }
+    }
+
+    // Wait for the bands that other threads are reading.  If they failed, so does this read.
+    bool ok = true;
+    for( const std::shared_ptr<DecodedBand>& band : rows.bands )
+    {
+        std::unique_lock<std::mutex> lock( band->mutex );
+        band->blockDone.wait( lock, [&band] { return band->blockStates[0] != DecodedBand::IN_PROGRESS; } );
+        ok = ok && band->blockStates[0] == DecodedBand::DONE;
+    }
+    return ok;
+}
+
+}  // namespace imageSource
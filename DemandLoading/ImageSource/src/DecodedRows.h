@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <OptiXToolkit/ImageSource/DecodedDataCache.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace imageSource {
+
+/// The layout of a mip level in DecodedDataCache bands.
+struct DecodedLevelLayout
+{
+    unsigned int width;
+    unsigned int height;
+    size_t       pixelSizeInBytes;
+
+    unsigned int getNumBands() const { return ( height + DecodedDataCache::BAND_HEIGHT - 1 ) / DecodedDataCache::BAND_HEIGHT; }
+
+    size_t getRowSizeInBytes() const { return width * pixelSizeInBytes; }
+
+    size_t getBandSizeInBytes( unsigned int band ) const
+    {
+        return std::min( DecodedDataCache::BAND_HEIGHT, height - band * DecodedDataCache::BAND_HEIGHT ) * getRowSizeInBytes();
+    }
+};
+
+/// The bands that hold a range of rows of a mip level.  Holding them keeps them valid if they are
+/// evicted from the cache.
+struct DecodedRows
+{
+    DecodedLevelLayout                        layout;
+    unsigned int                              firstBand;
+    std::vector<std::shared_ptr<DecodedBand>> bands;
+
+    const char* row( unsigned int y ) const
+    {
+        const DecodedBand& band = *bands[y / DecodedDataCache::BAND_HEIGHT - firstBand];
+        return &band.pixels[( y % DecodedDataCache::BAND_HEIGHT ) * layout.getRowSizeInBytes()];
+    }
+
+    char* row( unsigned int y )
+    {
+        DecodedBand& band = *bands[y / DecodedDataCache::BAND_HEIGHT - firstBand];
+        return &band.pixels[( y % DecodedDataCache::BAND_HEIGHT ) * layout.getRowSizeInBytes()];
+    }
+};
+
+/// Reads rows y0 to y1 (exclusive) of a mip level into dest, for images that can read part of a level.
+using ReadRowsFunction = std::function<bool( char* dest, unsigned int y0, unsigned int y1 )>;
+
+/// Get the bands of rows y0 to y1 (exclusive) of a mip level.  If any of the bands isn't cached,
+/// the missing bands are read with readRows, if it is set.  Otherwise the level is decoded as a
+/// whole by readLevel, which fills a buffer with the level's pixels, and its other missing bands
+/// are cached as well, as far as they fit in the cache's budget.  The level's mutex is held while
+/// it is read, so that threads needing its bands wait for one read.  Returns false if the rows
+/// could not be read.
+bool getDecodedRows( DecodedDataCache&                        cache,
+                     unsigned long long                       imageId,
+                     unsigned int                             mipLevel,
+                     const DecodedLevelLayout&                layout,
+                     unsigned int                             y0,
+                     unsigned int                             y1,
+                     std::mutex&                              levelMutex,
+                     const std::function<bool( char* dest )>& readLevel,
+                     const ReadRowsFunction&                  readRows,
+                     DecodedRows&                             rows );
+
+}  // namespace imageSource
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -17,8 +17,10 @@
 #include <ImfTiledInputFile.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 using namespace Imf;
@@ -41,6 +43,57 @@ class ImfFrameBuffer: public Imf::FrameBuffer
     using Imf::FrameBuffer::FrameBuffer;
 };
 
+namespace {
+
+// The instances of tiled files beyond the first one of each file are counted against a limit shared
+// by all EXRReaders, so the number of open files doesn't grow with the number of textures.
+std::atomic<unsigned int> g_maxSharedTiledInputFiles{ std::max( 1U, std::thread::hardware_concurrency() ) };
+std::atomic<unsigned int> g_numSharedTiledInputFiles{ 0 };
+
+bool reserveSharedTiledInputFile()
+{
+    unsigned int numFiles = g_numSharedTiledInputFiles.load();
+    while( numFiles < g_maxSharedTiledInputFiles.load() )
+    {
+        if( g_numSharedTiledInputFiles.compare_exchange_weak( numFiles, numFiles + 1 ) )
+            return true;
+    }
+    return false;
+}
+
+void releaseSharedTiledInputFiles( unsigned int numFiles )
+{
+    g_numSharedTiledInputFiles -= numFiles;
+}
+
+}  // namespace
+
+/// Borrows an idle instance of the tiled file for the duration of a read.  No instance is borrowed
+/// if the reader is closed.
+class EXRReader::TiledFileLease
+{
+  public:
+    explicit TiledFileLease( EXRReader& reader )
+        : m_reader( reader )
+        , m_file( reader.acquireTiledInputFile() )
+    {
+    }
+
+    ~TiledFileLease()
+    {
+        if( m_file )
+            m_reader.releaseTiledInputFile( m_file );
+    }
+
+    explicit operator bool() const { return m_file != nullptr; }
+
+    ImfTiledInputFile& operator*() const { return *m_file; }
+
+  private:
+    EXRReader&         m_reader;
+    ImfTiledInputFile* m_file;
+};
+
 EXRReader::EXRReader( const std::string& filename, bool readBaseColor )
     : m_filename( filename )
     , m_pixelType( Imf::NUM_PIXELTYPES )
@@ -76,24 +129,34 @@ void EXRReader::open( TextureInfo* info )
         Stopwatch stopwatch;
         std::unique_lock<std::mutex> lock( m_mutex );
 
+        // Reads that overlapped a close may still hold instances of the tiled file.
+        if( !m_isOpen )
+            waitForTiledFileLeases( lock );
+
         // Check to see if the image is already open
-        if( !m_inputFile && !m_tiledInputFile )
+        if( !m_isOpen )
         {
             m_info.isValid = false;
 
             // Open input file. May throw.
             m_inputFile.reset( new ImfInputFile( m_filename.c_str() ) );
 
+            ImfTiledInputFile* tiledInputFile = nullptr;
+            closeTiledInputFiles();
             if( m_inputFile->header().hasTileDescription() )
             {
-                m_tiledInputFile.reset( new ImfTiledInputFile( m_filename.c_str() ) );
+                // The first instance of the tiled file is opened here, and more are opened as
+                // concurrent reads need them.
+                m_tiledInputFiles.emplace_back( new ImfTiledInputFile( m_filename.c_str() ) );
+                tiledInputFile       = m_tiledInputFiles.back().get();
+                m_numTiledInputFiles = 1;
 
                 // Note that non-power-of-two EXR files often have one fewer miplevel than one would expect
                 // (they don't round up from 1+log2(max(width/height))).
-                OTK_ASSERT( m_tiledInputFile->numLevels() != 0 );
-                m_info.numMipLevels = m_tiledInputFile->numLevels();
-                m_tileWidth         = m_tiledInputFile->tileXSize();
-                m_tileHeight        = m_tiledInputFile->tileYSize();
+                OTK_ASSERT( tiledInputFile->numLevels() != 0 );
+                m_info.numMipLevels = tiledInputFile->numLevels();
+                m_tileWidth         = tiledInputFile->tileXSize();
+                m_tileHeight        = tiledInputFile->tileYSize();
                 m_info.isTiled      = true;
             }
             else
@@ -129,7 +192,7 @@ void EXRReader::open( TextureInfo* info )
             // CUDA textures don't support float3, so we round up to four channels.
             m_info.numChannels = A ? 4 : ( B ? 4 : ( G ? 2 : 1 ) );
 
-            if( m_tiledInputFile && m_inputFile )
+            if( tiledInputFile )
                 m_inputFile.reset();
 
             // Read the base color from the file
@@ -143,7 +206,7 @@ void EXRReader::open( TextureInfo* info )
                 if( m_inputFile )
                     readScanlineData( buff );
                 else
-                    readActualTile( buff, getBitsPerPixel( m_info ) / BITS_PER_BYTE, m_info.numMipLevels - 1, 0, 0 );
+                    readActualTile( *tiledInputFile, buff, getBitsPerPixel( m_info ) / BITS_PER_BYTE, m_info.numMipLevels - 1, 0, 0 );
 
                 if( m_info.format == CU_AD_FORMAT_HALF )
                 {
@@ -165,7 +228,10 @@ void EXRReader::open( TextureInfo* info )
                 }
             }
 
+            if( tiledInputFile )
+                m_idleTiledInputFiles.push_back( tiledInputFile );
             m_info.isValid = true;
+            m_isOpen       = true;
         }
 
         m_totalReadTime += stopwatch.elapsed();
@@ -196,19 +262,106 @@ void EXRReader::setupFrameBuffer( ImfFrameBuffer& frameBuffer_, char* base, size
 // Close the image.
 void EXRReader::close()
 {
-    if( m_inputFile )
-        m_inputFile.reset();
-    
-    if( m_tiledInputFile )
-        m_tiledInputFile.reset();
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_isOpen = false;
+
+    // The instances of the tiled file are closed once the reads that hold them finish.  The image
+    // may be reopened meanwhile, in which case it stays open.
+    waitForTiledFileLeases( lock );
+    if( m_isOpen )
+        return;
+    m_inputFile.reset();
+    closeTiledInputFiles();
 }
 
-void EXRReader::readActualTile( char* dest, unsigned int rowPitch, unsigned int mipLevel, unsigned int tileX, unsigned int tileY )
+void EXRReader::waitForTiledFileLeases( std::unique_lock<std::mutex>& lock )
 {
-    OTK_ASSERT_MSG( isOpen(), "Attempting to read from image that isn't open." );
-    OTK_ASSERT( !m_inputFile );
+    // Reads that are waiting for an idle instance give up once the image is closed.
+    m_tiledInputFileReleased.notify_all();
+    m_tiledFileLeasesEnded.wait( lock, [this] { return m_numTiledFileLeases == 0; } );
+}
+
+void EXRReader::closeTiledInputFiles()
+{
+    m_idleTiledInputFiles.clear();
+    m_tiledInputFiles.clear();
+    if( m_numTiledInputFiles > 1 )
+        releaseSharedTiledInputFiles( m_numTiledInputFiles - 1 );
+    m_numTiledInputFiles = 0;
+}
+
+void EXRReader::setMaxSharedTiledInputFiles( unsigned int maxFiles )
+{
+    g_maxSharedTiledInputFiles = maxFiles;
+}
+
+unsigned int EXRReader::getNumSharedTiledInputFiles()
+{
+    return g_numSharedTiledInputFiles;
+}
+
+ImfTiledInputFile* EXRReader::acquireTiledInputFile()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    OTK_ASSERT_MSG( !m_inputFile, "Attempting to read tiled data from scanline image." );
+
+    // Wait for an idle instance unless the shared limit allows opening another one.  The file's
+    // first instance is always open, so a busy instance will be released.
+    while( m_isOpen && m_idleTiledInputFiles.empty() )
+    {
+        if( reserveSharedTiledInputFile() )
+            return openTiledInputFile( lock );
+        m_tiledInputFileReleased.wait( lock );
+    }
+    if( !m_isOpen )
+        return nullptr;
+    ImfTiledInputFile* file = m_idleTiledInputFiles.back();
+    m_idleTiledInputFiles.pop_back();
+    ++m_numTiledFileLeases;
+    return file;
+}
 
-    const Box2i dw = m_tiledInputFile->dataWindowForTile( tileX, tileY, mipLevel );
+ImfTiledInputFile* EXRReader::openTiledInputFile( std::unique_lock<std::mutex>& lock )
+{
+    // Open another instance of the file without holding the lock, since it reads the header and
+    // the tile offset table.
+    ++m_numTiledInputFiles;
+    ++m_numTiledFileLeases;
+    lock.unlock();
+    std::unique_ptr<ImfTiledInputFile> file;
+    try
+    {
+        file.reset( new ImfTiledInputFile( m_filename.c_str() ) );
+    }
+    catch( ... )
+    {
+        lock.lock();
+        --m_numTiledInputFiles;
+        releaseSharedTiledInputFiles( 1 );
+        if( --m_numTiledFileLeases == 0 )
+            m_tiledFileLeasesEnded.notify_all();
+        m_tiledInputFileReleased.notify_one();
+        throw;
+    }
+    lock.lock();
+    m_tiledInputFiles.push_back( std::move( file ) );
+    return m_tiledInputFiles.back().get();
+}
+
+void EXRReader::releaseTiledInputFile( ImfTiledInputFile* file )
+{
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        m_idleTiledInputFiles.push_back( file );
+        if( --m_numTiledFileLeases == 0 )
+            m_tiledFileLeasesEnded.notify_all();
+    }
+    m_tiledInputFileReleased.notify_one();
+}
+
+void EXRReader::readActualTile( ImfTiledInputFile& file, char* dest, unsigned int rowPitch, unsigned int mipLevel, unsigned int tileX, unsigned int tileY )
+{
+    const Box2i dw = file.dataWindowForTile( tileX, tileY, mipLevel );
 
     // Compute base pointer and strides for frame buffer
     const unsigned int bytesPerPixel = getBitsPerPixel( m_info ) / BITS_PER_BYTE;
@@ -220,14 +373,14 @@ void EXRReader::readActualTile( char* dest, unsigned int rowPitch, unsigned int
     ImfFrameBuffer frameBuffer;
     setupFrameBuffer( frameBuffer, base, xStride, yStride );
 
-    m_tiledInputFile->setFrameBuffer( frameBuffer );
-    m_tiledInputFile->readTile( tileX, tileY, mipLevel );
+    // Each instance of the file has its own frame buffer, so rebinding it doesn't affect other reads.
+    file.setFrameBuffer( frameBuffer );
+    file.readTile( tileX, tileY, mipLevel );
 }
 
 void EXRReader::readScanlineData( char* dest )
 {
-    OTK_ASSERT_MSG( isOpen(), "Attempting to read from image that isn't open." );
-    OTK_ASSERT( !m_tiledInputFile );
+    OTK_ASSERT( m_inputFile );
 
     const Box2i dw = m_inputFile->header().dataWindow();
 
@@ -247,16 +400,41 @@ void EXRReader::readScanlineData( char* dest )
 
 bool EXRReader::readTile( char* dest, unsigned int mipLevel, const Tile& tile, CUstream /*stream*/  )
 {
-    std::unique_lock<std::mutex> lock( m_mutex );
-    OTK_ASSERT_MSG( isOpen(), "Attempting to read from image that isn't open." );
-    OTK_ASSERT_MSG( !m_inputFile, "Attempting to read tiled data from scanline image." );
+    TiledFileLease file( *this );
+    if( !file )
+        return false;
+    return readTileFromFile( *file, dest, mipLevel, tile );
+}
+
+bool EXRReader::readTiles( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles, CUstream /*stream*/ )
+{
+    // Read the tiles in row-major order, which is the order in which tiles are stored in a level of
+    // a file with increasing-y line order.
+    std::vector<unsigned int> order( numTiles );
+    for( unsigned int i = 0; i < numTiles; ++i )
+        order[i] = i;
+    std::sort( order.begin(), order.end(), [tiles]( unsigned int a, unsigned int b ) {
+        return tiles[a].y < tiles[b].y || ( tiles[a].y == tiles[b].y && tiles[a].x < tiles[b].x );
+    } );
+
+    // Borrow a file instance for the whole batch, rather than for each tile.
+    TiledFileLease file( *this );
+    if( !file )
+        return false;
+    bool satisfied = true;
+    for( unsigned int i : order )
+        satisfied = readTileFromFile( *file, dest[i], mipLevel, tiles[i] ) && satisfied;
+    return satisfied;
+}
 
+bool EXRReader::readTileFromFile( ImfTiledInputFile& file, char* dest, unsigned int mipLevel, const Tile& tile )
+{
     // Stats tracking
     Stopwatch stopwatch;
 
     // We require that the requested tile size is an integer multiple of the EXR tile size.
-    const unsigned int actualTileWidth  = m_tiledInputFile->tileXSize();
-    const unsigned int actualTileHeight = m_tiledInputFile->tileYSize();
+    const unsigned int actualTileWidth  = file.tileXSize();
+    const unsigned int actualTileHeight = file.tileYSize();
     if( !( actualTileWidth <= tile.width && tile.width % actualTileWidth == 0 )
         || !( actualTileHeight <= tile.height && tile.height % actualTileHeight == 0 ) )
     {
@@ -275,8 +453,8 @@ bool EXRReader::readTile( char* dest, unsigned int mipLevel, const Tile& tile, C
     const size_t       actualTileSize = actualTileWidth * actualTileHeight * bytesPerPixel;
 
     // Don't request non-existent tiles on the edge of the texture
-    unsigned int levelWidthInActualTiles  = ( m_tiledInputFile->levelWidth( mipLevel ) + actualTileWidth - 1 ) / actualTileWidth;
-    unsigned int levelHeightInActualTiles = ( m_tiledInputFile->levelHeight( mipLevel ) + actualTileHeight - 1 ) / actualTileHeight;
+    unsigned int levelWidthInActualTiles  = ( file.levelWidth( mipLevel ) + actualTileWidth - 1 ) / actualTileWidth;
+    unsigned int levelHeightInActualTiles = ( file.levelHeight( mipLevel ) + actualTileHeight - 1 ) / actualTileHeight;
     numTilesX                             = std::min( numTilesX, levelWidthInActualTiles - actualTileX );
     numTilesY                             = std::min( numTilesY, levelHeightInActualTiles - actualTileY );
                 
@@ -285,34 +463,35 @@ bool EXRReader::readTile( char* dest, unsigned int mipLevel, const Tile& tile, C
         for( unsigned int i = 0; i < numTilesX; ++i )
         {
             char* start = dest + j * numTilesX * actualTileSize + i * actualTileWidth * bytesPerPixel;
-            readActualTile( start, rowPitch, mipLevel, actualTileX + i, actualTileY + j );
-
-            // Stats tracking
-            m_numBytesRead += actualTileSize;
+            readActualTile( file, start, rowPitch, mipLevel, actualTileX + i, actualTileY + j );
         }
     }
 
     // Stats tracking
+    const double                 elapsed = stopwatch.elapsed();
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_numBytesRead += numTilesX * numTilesY * actualTileSize;
     m_numTilesRead += 1;
-    m_totalReadTime += stopwatch.elapsed();
+    m_totalReadTime += elapsed;
 
     return true;
 }
 
 bool EXRReader::readMipLevel( char* dest, unsigned int mipLevel, unsigned int expectedWidth, unsigned int expectedHeight, CUstream /*stream*/ )
 {
-    std::unique_lock<std::mutex> lock( m_mutex );
     OTK_ASSERT_MSG( isOpen(), "Attempting to read from image that isn't open." );
 
     // Stats tracking
     Stopwatch stopwatch;
-    const Box2i dw = m_tiledInputFile ? m_tiledInputFile->dataWindowForLevel( mipLevel, mipLevel ) : m_inputFile->header().dataWindow();
 
     if( m_inputFile )
     {
+        std::unique_lock<std::mutex> inputFileLock( m_inputFileMutex );
+
         // Get window offset and dimensions.
-        const int width  = dw.max.x - dw.min.x + 1;
-        const int height = dw.max.y - dw.min.y + 1;
+        const Box2i dw     = m_inputFile->header().dataWindow();
+        const int   width  = dw.max.x - dw.min.x + 1;
+        const int   height = dw.max.y - dw.min.y + 1;
         (void)expectedWidth;   // silence unused variable warning
         (void)expectedHeight;  // silence unused variable warning
         OTK_ASSERT( width  == static_cast<int>( expectedWidth ) );
@@ -320,18 +499,27 @@ bool EXRReader::readMipLevel( char* dest, unsigned int mipLevel, unsigned int ex
         OTK_ASSERT( mipLevel == 0 );
 
         readScanlineData( dest );
-                
+        inputFileLock.unlock();
+
         // Stats tracking
         {
+            const double                 elapsed = stopwatch.elapsed();
+            std::unique_lock<std::mutex> lock( m_mutex );
             m_numTilesRead  += 1;
             m_numBytesRead  += width * height * getBitsPerPixel( m_info ) / BITS_PER_BYTE;
-            m_totalReadTime += stopwatch.elapsed();
+            m_totalReadTime += elapsed;
         }
     }
     else
     {
+        TiledFileLease leasedFile( *this );
+        if( !leasedFile )
+            return false;
+        ImfTiledInputFile& file = *leasedFile;
+
         // Get miplevel data window offset and dimensions.
-        const int width = dw.max.x - dw.min.x + 1;
+        const Box2i dw    = file.dataWindowForLevel( mipLevel, mipLevel );
+        const int   width = dw.max.x - dw.min.x + 1;
         OTK_ASSERT( width == static_cast<int>( expectedWidth ) );
         OTK_ASSERT( ( dw.max.y - dw.min.y + 1 ) == static_cast<int>( expectedHeight ) );
 
@@ -344,20 +532,22 @@ bool EXRReader::readMipLevel( char* dest, unsigned int mipLevel, unsigned int ex
         // Create frame buffer and read the tiles for the specified mipLevel.
         ImfFrameBuffer frameBuffer;
         setupFrameBuffer( frameBuffer, base, xStride, yStride );
-        m_tiledInputFile->setFrameBuffer( frameBuffer );
-        m_tiledInputFile->readTiles( 0, m_tiledInputFile->numXTiles( mipLevel ) - 1, 0, m_tiledInputFile->numYTiles( mipLevel ) - 1, mipLevel, mipLevel );
+        file.setFrameBuffer( frameBuffer );
+        file.readTiles( 0, file.numXTiles( mipLevel ) - 1, 0, file.numYTiles( mipLevel ) - 1, mipLevel, mipLevel );
 
         // Stats tracking
         {
-            const unsigned int actualTileWidth  = m_tiledInputFile->tileXSize();
-            const unsigned int actualTileHeight = m_tiledInputFile->tileYSize();
+            const unsigned int actualTileWidth  = file.tileXSize();
+            const unsigned int actualTileHeight = file.tileYSize();
             const size_t       actualTileSize   = actualTileWidth * actualTileHeight * bytesPerPixel;
-            const int          numXTiles        = m_tiledInputFile->numXTiles( mipLevel );
-            const int          numYTiles        = m_tiledInputFile->numYTiles( mipLevel );
+            const int          numXTiles        = file.numXTiles( mipLevel );
+            const int          numYTiles        = file.numYTiles( mipLevel );
+            const double       elapsed          = stopwatch.elapsed();
 
+            std::unique_lock<std::mutex> lock( m_mutex );
             m_numTilesRead += numXTiles * numYTiles;
             m_numBytesRead += numXTiles * numYTiles * actualTileSize;
-            m_totalReadTime += stopwatch.elapsed();
+            m_totalReadTime += elapsed;
         }
     }
 
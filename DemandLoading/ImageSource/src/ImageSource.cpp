@@ -72,6 +72,14 @@ unsigned long long ImageSource::getHash( CUstream stream )
     return hash;
 }
 
+bool ImageSource::readTiles( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles, CUstream stream )
+{
+    bool satisfied = true;
+    for( unsigned int i = 0; i < numTiles; ++i )
+        satisfied = readTile( dest[i], mipLevel, tiles[i], stream ) && satisfied;
+    return satisfied;
+}
+
 bool ImageSourceBase::readMipTail( char*        dest,
                                    unsigned int mipTailFirstLevel,
                                    unsigned int numMipLevels,
@@ -1,34 +1,326 @@
-// SPDX-FileCopyrightText: Copyright (c) 2021-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2021-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #include <OptiXToolkit/ImageSource/ImageSourceCache.h>
 
+#include <OptiXToolkit/ImageSource/TextureInfo.h>
+#include <OptiXToolkit/ImageSource/WrappedImageSource.h>
+
+#include <atomic>
+#include <list>
+#include <utility>
+
 namespace imageSource {
 
+class BudgetedImageSource;
+
+/// OpenReaderBudget tracks the open readers of an ImageSourceCache, most recently used first, and
+/// closes the least recently used idle readers that exceed the limit.  It is shared with the
+/// cached images, which may outlive the cache.
+class OpenReaderBudget
+{
+  public:
+    explicit OpenReaderBudget( unsigned int maxOpenReaders )
+        : m_maxOpenReaders( maxOpenReaders )
+    {
+    }
+
+    /// Set the limit, closing readers to meet it.
+    void setMaxOpenReaders( unsigned int maxOpenReaders );
+
+    /// Mark the image's reader as the most recently used.  If the reader was just opened, it is
+    /// added, and readers are closed to stay within the limit.
+    void touch( BudgetedImageSource* image, bool opened );
+
+    /// Stop tracking the image's reader, which is being closed or destroyed.
+    void remove( BudgetedImageSource* image );
+
+    /// Fill in the open reader counts of the statistics.
+    void getStatistics( CacheStatistics& stats ) const;
+
+  private:
+    mutable std::mutex              m_mutex;
+    unsigned int                    m_maxOpenReaders;
+    std::list<BudgetedImageSource*> m_lruList;  // Most recently used first.
+    unsigned long long              m_numOpens{};
+    unsigned long long              m_numCloses{};
+
+    void evict( BudgetedImageSource* keep );
+};
+
+/// BudgetedImageSource wraps a reader created by an ImageSourceCache, so that the cache can close
+/// it while it is idle.  Each read reopens the reader if it was closed, and marks it as used.
+class BudgetedImageSource : public WrappedImageSource
+{
+  public:
+    BudgetedImageSource( std::shared_ptr<ImageSource> reader, std::shared_ptr<OpenReaderBudget> budget )
+        : WrappedImageSource( std::move( reader ) )
+        , m_budget( std::move( budget ) )
+    {
+    }
+
+    ~BudgetedImageSource() override { m_budget->remove( this ); }
+
+    void open( TextureInfo* info ) override
+    {
+        ReadScope scope( *this );
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_isOpen = true;
+        }
+        if( info != nullptr )
+            *info = m_info;
+    }
+
+    void close() override
+    {
+        m_budget->remove( this );
+        std::unique_lock<std::mutex> lock( m_mutex );
+        if( m_readerOpen )
+            WrappedImageSource::close();
+        m_readerOpen = false;
+        m_isOpen     = false;
+    }
+
+    /// The image stays open while the cache has closed its reader.
+    bool isOpen() const override
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        return m_isOpen;
+    }
+
+    /// The info is kept while the reader is closed.
+    const TextureInfo& getInfo() const override { return m_hasInfo ? m_info : WrappedImageSource::getInfo(); }
+
+    bool readTile( char* dest, unsigned int mipLevel, const Tile& tile, CUstream stream ) override
+    {
+        ReadScope scope( *this );
+        return WrappedImageSource::readTile( dest, mipLevel, tile, stream );
+    }
+
+    bool readTiles( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles, CUstream stream ) override
+    {
+        ReadScope scope( *this );
+        return WrappedImageSource::readTiles( dest, mipLevel, tiles, numTiles, stream );
+    }
+
+    bool readMipLevel( char* dest, unsigned int mipLevel, unsigned int expectedWidth, unsigned int expectedHeight, CUstream stream ) override
+    {
+        ReadScope scope( *this );
+        return WrappedImageSource::readMipLevel( dest, mipLevel, expectedWidth, expectedHeight, stream );
+    }
+
+    bool readMipTail( char* dest, unsigned int mipTailFirstLevel, unsigned int numMipLevels, const uint2* mipLevelDims, CUstream stream ) override
+    {
+        ReadScope scope( *this );
+        return WrappedImageSource::readMipTail( dest, mipTailFirstLevel, numMipLevels, mipLevelDims, stream );
+    }
+
+    bool readBaseColor( float4& dest ) override
+    {
+        ReadScope scope( *this );
+        return WrappedImageSource::readBaseColor( dest );
+    }
+
+    /// The reader may need to read its file to build the extra data, so it is opened as for a read.
+    CUdeviceptr getSamplerExtraData( OptixDeviceContext optixContext ) override
+    {
+        ReadScope scope( *this );
+        return WrappedImageSource::getSamplerExtraData( optixContext );
+    }
+
+    /// Close the reader unless it is being read.  Called by the budget, holding its mutex.
+    bool tryCloseReader()
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        if( m_numActiveReads > 0 )
+            return false;
+        if( m_readerOpen )
+            WrappedImageSource::close();
+        m_readerOpen = false;
+        return true;
+    }
+
+  private:
+    friend class OpenReaderBudget;
+
+    // Keeps the reader open for the duration of a read, reopening it if necessary.
+    class ReadScope
+    {
+      public:
+        explicit ReadScope( BudgetedImageSource& image )
+            : m_image( image )
+        {
+            m_image.beginRead();
+        }
+        ~ReadScope() { m_image.endRead(); }
+
+      private:
+        BudgetedImageSource& m_image;
+    };
+
+    std::shared_ptr<OpenReaderBudget> m_budget;
+    mutable std::mutex                m_mutex;
+    bool                              m_isOpen{};
+    bool                              m_readerOpen{};
+    unsigned int                      m_numActiveReads{};
+    std::atomic<bool>                 m_hasInfo{ false };
+    TextureInfo                       m_info{};
+
+    // Guarded by the budget's mutex.
+    bool                                      m_inBudget{};
+    std::list<BudgetedImageSource*>::iterator m_lruPosition;
+
+    void beginRead()
+    {
+        bool opened = false;
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            if( !m_readerOpen )
+            {
+                TextureInfo info{};
+                WrappedImageSource::open( &info );
+                if( !m_hasInfo )
+                {
+                    m_info    = info;
+                    m_hasInfo = true;
+                }
+                m_readerOpen = true;
+                opened       = true;
+            }
+            ++m_numActiveReads;
+        }
+        m_budget->touch( this, opened );
+    }
+
+    void endRead()
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        --m_numActiveReads;
+    }
+};
+
+void OpenReaderBudget::setMaxOpenReaders( unsigned int maxOpenReaders )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_maxOpenReaders = maxOpenReaders;
+    evict( nullptr );
+}
+
+void OpenReaderBudget::touch( BudgetedImageSource* image, bool opened )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    if( image->m_inBudget )
+    {
+        m_lruList.splice( m_lruList.begin(), m_lruList, image->m_lruPosition );
+    }
+    else
+    {
+        m_lruList.push_front( image );
+        image->m_lruPosition = m_lruList.begin();
+        image->m_inBudget    = true;
+    }
+    if( opened )
+    {
+        ++m_numOpens;
+        evict( image );
+    }
+}
+
+void OpenReaderBudget::remove( BudgetedImageSource* image )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    if( image->m_inBudget )
+    {
+        m_lruList.erase( image->m_lruPosition );
+        image->m_inBudget = false;
+    }
+}
+
+void OpenReaderBudget::getStatistics( CacheStatistics& stats ) const
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    stats.numOpenReaders  = static_cast<unsigned int>( m_lruList.size() );
+    stats.numReaderOpens  = m_numOpens;
+    stats.numReaderCloses = m_numCloses;
+}
+
+void OpenReaderBudget::evict( BudgetedImageSource* keep )
+{
+    if( m_maxOpenReaders == 0 )
+        return;
+
+    // Readers that are being read are skipped, so the limit may be exceeded until they are idle.
+    auto it = m_lruList.end();
+    while( m_lruList.size() > m_maxOpenReaders && it != m_lruList.begin() )
+    {
+        --it;
+        if( *it == keep || !( *it )->tryCloseReader() )
+            continue;
+        ( *it )->m_inBudget = false;
+        it                  = m_lruList.erase( it );
+        ++m_numCloses;
+    }
+}
+
+ImageSourceCache::ImageSourceCache( unsigned int maxOpenReaders, CreateFunction createFunction )
+    : m_createFunction( createFunction ? std::move( createFunction ) : CreateFunction( []( const std::string& path ) { return createImageSource( path ); } ) )
+    , m_budget( std::make_shared<OpenReaderBudget>( maxOpenReaders ) )
+{
+}
+
+std::shared_ptr<ImageSource> ImageSourceCache::find( const std::string& path ) const
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    auto                         it = m_cache.find( path );
+    return it == m_cache.end() ? std::shared_ptr<ImageSource>() : it->second;
+}
+
 std::shared_ptr<ImageSource> ImageSourceCache::get( const std::string& path )
 {
     // Use a cached ImageSource if possible.
-    std::shared_ptr<ImageSource> imageSource{ find( path ) };
-    if( imageSource )
-        return imageSource;
+    std::unique_lock<std::mutex> lock( m_mutex );
+    auto                         it = m_cache.find( path );
+    if( it != m_cache.end() )
+        return it->second;
 
-    // Create a new ImageSource and cache it.
-    imageSource = createImageSource( path );
+    // Create a new ImageSource and cache it.  Creating a reader doesn't open its file, so the
+    // lock isn't held for long.
+    std::shared_ptr<ImageSource> imageSource = std::make_shared<BudgetedImageSource>( m_createFunction( path ), m_budget );
     m_cache[path] = imageSource;
     return imageSource;
 }
 
+void ImageSourceCache::set( const std::string& path, const std::shared_ptr<ImageSource>& image )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_cache[path] = image;
+}
+
+void ImageSourceCache::setMaxOpenReaders( unsigned int maxOpenReaders )
+{
+    m_budget->setMaxOpenReaders( maxOpenReaders );
+}
+
 CacheStatistics ImageSourceCache::getStatistics() const
 {
     CacheStatistics result{};
-    for (const auto &keyValue :  m_cache)
     {
-        ++result.numImageSources;
-        result.totalBytesRead += keyValue.second->getNumBytesRead();
-        result.totalTilesRead += keyValue.second->getNumTilesRead();
-        result.totalReadTime += keyValue.second->getTotalReadTime();
+        std::unique_lock<std::mutex> lock( m_mutex );
+        for( const auto& keyValue : m_cache )
+        {
+            ++result.numImageSources;
+            result.totalBytesRead += keyValue.second->getNumBytesRead();
+            result.totalTilesRead += keyValue.second->getNumTilesRead();
+            result.totalReadTime += keyValue.second->getTotalReadTime();
+            const DecodedDataStatistics decodedData = keyValue.second->getDecodedDataStatistics();
+            result.decodedData.numHits += decodedData.numHits;
+            result.decodedData.numMisses += decodedData.numMisses;
+            result.decodedData.numEvictions += decodedData.numEvictions;
+        }
     }
+    m_budget->getStatistics( result );
     return result;
 }
 
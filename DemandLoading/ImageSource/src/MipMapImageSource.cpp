@@ -1,17 +1,249 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #include <OptiXToolkit/ImageSource/MipMapImageSource.h>
 
+#include "DecodedRows.h"
+
 #include <OptiXToolkit/Error/ErrorCheck.h>
+#include <OptiXToolkit/ImageSource/HalfFloat.h>
+
+#include <vector_functions.h>
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <thread>
 
 namespace imageSource {
 
-MipMapImageSource::MipMapImageSource( std::shared_ptr<ImageSource> baseImage )
+namespace {
+
+// Mip levels (other than level 0) are generated in blocks of this many pixels on a side.
+const unsigned int MIP_BLOCK_SIZE = DecodedDataCache::BAND_HEIGHT;
+
+// Blocks are filtered in parallel when each thread would get at least this many.
+const unsigned int MIN_BLOCKS_PER_THREAD = 4;
+
+// Separable filter kernel for downsampling by two.  Destination pixel x is filtered from source
+// pixels 2x + firstTap, 2x + firstTap + 1, and so on.
+struct FilterKernel
+{
+    int                firstTap;
+    std::vector<float> weights;
+};
+
+double besselI0( double x )
+{
+    double sum  = 1.0;
+    double term = 1.0;
+    for( int k = 1; k < 32; ++k )
+    {
+        term *= ( x / ( 2 * k ) ) * ( x / ( 2 * k ) );
+        sum += term;
+    }
+    return sum;
+}
+
+FilterKernel makeKaiserKernel()
+{
+    // Sinc lowpass at half the source sample rate, windowed over 4 destination pixels.
+    const double pi     = 3.14159265358979323846;
+    const double radius = 4.0;
+    const double beta   = 4.0;
+
+    FilterKernel kernel{-3, std::vector<float>( 8 )};
+    double       sum = 0.0;
+    for( int i = 0; i < 8; ++i )
+    {
+        // Distance from the destination pixel's center, in source pixels.
+        const double d      = kernel.firstTap + i - 0.5;
+        const double sinc   = std::sin( pi * d / 2 ) / ( pi * d / 2 );
+        const double r      = d / radius;
+        const double window = besselI0( beta * std::sqrt( std::max( 0.0, 1.0 - r * r ) ) ) / besselI0( beta );
+        kernel.weights[i]   = static_cast<float>( sinc * window );
+        sum += kernel.weights[i];
+    }
+    for( float& weight : kernel.weights )
+        weight = static_cast<float>( weight / sum );
+    return kernel;
+}
+
+const FilterKernel& getFilterKernel( MipMapFilter filter )
+{
+    static const FilterKernel boxKernel{0, {0.5f, 0.5f}};
+    static const FilterKernel kaiserKernel = makeKaiserKernel();
+    return filter == MipMapFilter::KAISER ? kaiserKernel : boxKernel;
+}
+
+float srgbToLinear( float value )
+{
+    return value <= 0.04045f ? value / 12.92f : std::pow( ( value + 0.055f ) / 1.055f, 2.4f );
+}
+
+// Tables for converting 8-bit sRGB values to and from linear values.
+struct SrgbTables
+{
+    float toLinear[256];
+    float thresholds[255];  // Linear values halfway between consecutive sRGB values.
+
+    SrgbTables()
+    {
+        for( int i = 0; i < 256; ++i )
+            toLinear[i] = srgbToLinear( i / 255.0f );
+        for( int i = 0; i < 255; ++i )
+            thresholds[i] = srgbToLinear( ( i + 0.5f ) / 255.0f );
+    }
+
+    unsigned char fromLinear( float value ) const
+    {
+        return static_cast<unsigned char>( std::upper_bound( thresholds, thresholds + 255, value ) - thresholds );
+    }
+};
+
+const SrgbTables& getSrgbTables()
+{
+    static const SrgbTables tables;
+    return tables;
+}
+
+// Converts pixels between their texture format and linear float values.
+class PixelConverter
+{
+  public:
+    PixelConverter( const TextureInfo& info, bool isSrgb )
+        : m_format( info.format )
+        , m_numChannels( info.numChannels )
+        , m_numSrgbChannels( isSrgb && info.format == CU_AD_FORMAT_UNSIGNED_INT8 ? std::min( info.numChannels, 3u ) : 0 )
+        , m_srgb( getSrgbTables() )
+    {
+    }
+
+    bool isFilterable() const
+    {
+        return m_format == CU_AD_FORMAT_UNSIGNED_INT8 || m_format == CU_AD_FORMAT_UNSIGNED_INT16
+               || m_format == CU_AD_FORMAT_HALF || m_format == CU_AD_FORMAT_FLOAT;
+    }
+
+    void decode( const char* pixel, float* values ) const
+    {
+        switch( m_format )
+        {
+            case CU_AD_FORMAT_UNSIGNED_INT8:
+            {
+                const unsigned char* channels = reinterpret_cast<const unsigned char*>( pixel );
+                for( unsigned int c = 0; c < m_numChannels; ++c )
+                    values[c] = c < m_numSrgbChannels ? m_srgb.toLinear[channels[c]] : channels[c] * ( 1.0f / 255.0f );
+                break;
+            }
+            case CU_AD_FORMAT_UNSIGNED_INT16:
+                for( unsigned int c = 0; c < m_numChannels; ++c )
+                    values[c] = load<uint16_t>( pixel, c ) * ( 1.0f / 65535.0f );
+                break;
+            case CU_AD_FORMAT_HALF:
+                for( unsigned int c = 0; c < m_numChannels; ++c )
+                    values[c] = halfToFloat( load<uint16_t>( pixel, c ) );
+                break;
+            default:
+                for( unsigned int c = 0; c < m_numChannels; ++c )
+                    values[c] = load<float>( pixel, c );
+                break;
+        }
+    }
+
+    void encode( const float* values, char* pixel ) const
+    {
+        switch( m_format )
+        {
+            case CU_AD_FORMAT_UNSIGNED_INT8:
+            {
+                unsigned char* channels = reinterpret_cast<unsigned char*>( pixel );
+                for( unsigned int c = 0; c < m_numChannels; ++c )
+                    channels[c] = c < m_numSrgbChannels ? m_srgb.fromLinear( values[c] ) :
+                                                          static_cast<unsigned char>( toUnorm( values[c], 255.0f ) );
+                break;
+            }
+            case CU_AD_FORMAT_UNSIGNED_INT16:
+                for( unsigned int c = 0; c < m_numChannels; ++c )
+                    store( pixel, c, static_cast<uint16_t>( toUnorm( values[c], 65535.0f ) ) );
+                break;
+            case CU_AD_FORMAT_HALF:
+                for( unsigned int c = 0; c < m_numChannels; ++c )
+                    store( pixel, c, floatToHalf( values[c] ) );
+                break;
+            default:
+                for( unsigned int c = 0; c < m_numChannels; ++c )
+                    store( pixel, c, values[c] );
+                break;
+        }
+    }
+
+  private:
+    CUarray_format    m_format;
+    unsigned int      m_numChannels;
+    unsigned int      m_numSrgbChannels;
+    const SrgbTables& m_srgb;
+
+    template <typename T>
+    static T load( const char* pixel, unsigned int channel )
+    {
+        T value;
+        std::memcpy( &value, pixel + channel * sizeof( T ), sizeof( T ) );
+        return value;
+    }
+
+    template <typename T>
+    static void store( char* pixel, unsigned int channel, T value )
+    {
+        std::memcpy( pixel + channel * sizeof( T ), &value, sizeof( T ) );
+    }
+
+    // The Kaiser filter has negative lobes, so results can be out of range.
+    static unsigned int toUnorm( float value, float scale )
+    {
+        return static_cast<unsigned int>( std::min( std::max( value, 0.0f ), 1.0f ) * scale + 0.5f );
+    }
+};
+
+// Call function(i) for i in [0, count), spreading the calls over threads if there are enough.
+template <typename Function>
+void parallelFor( unsigned int count, const Function& function )
+{
+    const unsigned int numThreads = std::min( count / MIN_BLOCKS_PER_THREAD, std::max( std::thread::hardware_concurrency(), 1u ) );
+    if( numThreads <= 1 )
+    {
+        for( unsigned int i = 0; i < count; ++i )
+            function( i );
+        return;
+    }
+
+    std::atomic<unsigned int> next( 0 );
+    const auto                worker = [&next, count, &function] {
+        for( unsigned int i = next++; i < count; i = next++ )
+            function( i );
+    };
+    std::vector<std::thread> threads;
+    for( unsigned int i = 1; i < numThreads; ++i )
+        threads.emplace_back( worker );
+    worker();
+    for( std::thread& thread : threads )
+        thread.join();
+}
+
+}  // namespace
+
+MipMapImageSource::MipMapImageSource( std::shared_ptr<ImageSource>      baseImage,
+                                      MipMapFilter                      filter,
+                                      bool                              isSrgb,
+                                      std::shared_ptr<DecodedDataCache> cache )
     : WrappedImageSource( baseImage )
+    , m_filter( filter )
+    , m_isSrgb( isSrgb )
+    , m_cache( cache ? std::move( cache ) : DecodedDataCache::getInstance() )
+    , m_imageId( m_cache->createImageId() )
 {
     if( baseImage->isOpen() )
     {
@@ -19,6 +251,11 @@ MipMapImageSource::MipMapImageSource( std::shared_ptr<ImageSource> baseImage )
     }
 }
 
+MipMapImageSource::~MipMapImageSource()
+{
+    m_cache->releaseImageId( m_imageId );
+}
+
 void MipMapImageSource::getBaseInfo()
 {
     m_mipMapInfo = WrappedImageSource::getInfo();
@@ -38,7 +275,17 @@ void MipMapImageSource::getBaseInfo()
     }
     m_mipMapInfo.numMipLevels = numMipLevels;
     m_pixelStrideInBytes      = getBitsPerPixel( m_mipMapInfo ) / BITS_PER_BYTE;
-    m_mipLevels.resize( numMipLevels );
+
+    // Level 0 is read from the base image, so it has a single block per band.
+    m_mipLevels.clear();
+    for( unsigned int mipLevel = 0; mipLevel < numMipLevels; ++mipLevel )
+    {
+        MipLevel level;
+        level.width      = std::max( m_mipMapInfo.width >> mipLevel, 1u );
+        level.height     = std::max( m_mipMapInfo.height >> mipLevel, 1u );
+        level.numBlocksX = mipLevel == 0 ? 1 : ( level.width + MIP_BLOCK_SIZE - 1 ) / MIP_BLOCK_SIZE;
+        m_mipLevels.push_back( level );
+    }
 }
 
 void MipMapImageSource::open( TextureInfo* info )
@@ -63,7 +310,10 @@ void MipMapImageSource::open( TextureInfo* info )
 void MipMapImageSource::close()
 {
     WrappedImageSource::close();
+    m_cache->removeImage( m_imageId );
+    std::unique_lock<std::mutex> lock( m_dataMutex );
     m_mipMapInfo = TextureInfo{};
+    m_mipLevels.clear();
 }
 
 const TextureInfo& MipMapImageSource::getInfo() const
@@ -76,63 +326,221 @@ const TextureInfo& MipMapImageSource::getInfo() const
     return m_mipMapInfo;
 }
 
-inline void filterPixel( const char* source, char* dest, unsigned int pixelStride, CUarray_format /*format*/ )
+void MipMapImageSource::filterBlock( unsigned int mipLevel, unsigned int blockX, unsigned int blockY, const DecodedRows& source, DecodedRows& dest )
 {
-    std::copy_n( source, pixelStride, dest );
-}
+    const MipLevel&    level       = m_mipLevels[mipLevel];
+    const MipLevel&    sourceLevel = m_mipLevels[mipLevel - 1];
+    const unsigned int x0          = blockX * MIP_BLOCK_SIZE;
+    const unsigned int y0          = blockY * MIP_BLOCK_SIZE;
+    const unsigned int width       = std::min( level.width - x0, MIP_BLOCK_SIZE );
+    const unsigned int height      = std::min( level.height - y0, MIP_BLOCK_SIZE );
+    const unsigned int numChannels = m_mipMapInfo.numChannels;
+    const size_t       stride      = m_pixelStrideInBytes;
 
-const char* MipMapImageSource::getMipLevelBuffer( unsigned int mipLevel, CUstream stream )
-{
-    if( m_buffer.empty() )
+    const PixelConverter converter( m_mipMapInfo, m_isSrgb );
+    if( !converter.isFilterable() )
     {
-        m_buffer.resize( getTextureSizeInBytes( m_mipMapInfo ) );
-        m_mipLevels.resize( m_mipMapInfo.numMipLevels );
+        // Point sample formats that can't be averaged.
+        for( unsigned int y = 0; y < height; ++y )
+        {
+            const char* sourceRow = source.row( std::min( 2 * ( y0 + y ), sourceLevel.height - 1 ) );
+            char*       destRow   = dest.row( y0 + y );
+            for( unsigned int x = 0; x < width; ++x )
+            {
+                const unsigned int sx = std::min( 2 * ( x0 + x ), sourceLevel.width - 1 );
+                std::copy_n( sourceRow + sx * stride, stride, destRow + ( x0 + x ) * stride );
+            }
+        }
+        return;
     }
 
-    if( m_mipLevels[mipLevel] == nullptr )
+    // The source pixels under the filter taps, with the edge pixels repeated outside the level.
+    const FilterKernel& kernel      = getFilterKernel( m_filter );
+    const unsigned int  numTaps     = static_cast<unsigned int>( kernel.weights.size() );
+    const int           sx0         = 2 * static_cast<int>( x0 ) + kernel.firstTap;
+    const int           sy0         = 2 * static_cast<int>( y0 ) + kernel.firstTap;
+    const unsigned int  srcWidth    = 2 * ( width - 1 ) + numTaps;
+    const unsigned int  srcHeight   = 2 * ( height - 1 ) + numTaps;
+    const unsigned int  destRowSize = width * numChannels;
+
+    // Filter horizontally, converting each source row to floats.
+    std::vector<float> sourceRow( srcWidth * numChannels );
+    std::vector<float> rows( srcHeight * destRowSize, 0.0f );
+    for( unsigned int j = 0; j < srcHeight; ++j )
     {
-        unsigned int mipLevelWidth{ m_mipMapInfo.width };
-        unsigned int mipLevelHeight{ m_mipMapInfo.height };
+        const int   sy              = std::min( std::max( sy0 + static_cast<int>( j ), 0 ), static_cast<int>( sourceLevel.height ) - 1 );
+        const char* sourceRowPixels = source.row( sy );
+        for( unsigned int i = 0; i < srcWidth; ++i )
         {
-            size_t       levelSize{ m_pixelStrideInBytes * m_mipMapInfo.width * m_mipMapInfo.height };
-            char*        ptr{ m_buffer.data() };
-            for( unsigned int i = 0; i < mipLevel; ++i )
-            {
-                ptr += levelSize;
-                levelSize /= 4;
-                mipLevelWidth /= 2;
-                mipLevelHeight /= 2;
-            }
-            m_mipLevels[mipLevel] = ptr;
+            const int sx = std::min( std::max( sx0 + static_cast<int>( i ), 0 ), static_cast<int>( sourceLevel.width ) - 1 );
+            converter.decode( sourceRowPixels + sx * stride, &sourceRow[i * numChannels] );
         }
-        if( mipLevel == 0 )
+
+        float* row = &rows[j * destRowSize];
+        for( unsigned int t = 0; t < numTaps; ++t )
         {
-            if( !WrappedImageSource::readMipLevel( m_mipLevels[mipLevel], mipLevel, mipLevelWidth, mipLevelHeight, stream ) )
+            const float  weight = kernel.weights[t];
+            const float* in     = &sourceRow[t * numChannels];
+            for( unsigned int x = 0; x < width; ++x )
             {
-                return nullptr;
+                for( unsigned int c = 0; c < numChannels; ++c )
+                    row[x * numChannels + c] += weight * in[2 * x * numChannels + c];
             }
         }
-        else
+    }
+
+    // Filter vertically, and convert back to the texture format.
+    std::vector<float> destRow( destRowSize );
+    for( unsigned int y = 0; y < height; ++y )
+    {
+        std::fill( destRow.begin(), destRow.end(), 0.0f );
+        for( unsigned int t = 0; t < numTaps; ++t )
+        {
+            const float  weight = kernel.weights[t];
+            const float* in     = &rows[( 2 * y + t ) * destRowSize];
+            for( unsigned int i = 0; i < destRowSize; ++i )
+                destRow[i] += weight * in[i];
+        }
+
+        char* destPixels = dest.row( y0 + y ) + x0 * stride;
+        for( unsigned int x = 0; x < width; ++x )
+            converter.encode( &destRow[x * numChannels], destPixels + x * stride );
+    }
+}
+
+bool MipMapImageSource::readBaseRows( char* dest, unsigned int y0, unsigned int y1, CUstream stream )
+{
+    const MipLevel&    level              = m_mipLevels[0];
+    const unsigned int tileWidth          = WrappedImageSource::getTileWidth();
+    const unsigned int tileHeight         = WrappedImageSource::getTileHeight();
+    const unsigned int numTilesX          = ( level.width + tileWidth - 1 ) / tileWidth;
+    const size_t       tileRowSizeInBytes = static_cast<size_t>( tileWidth ) * m_pixelStrideInBytes;
+    const size_t       tileSizeInBytes    = tileHeight * tileRowSizeInBytes;
+    const size_t       rowSizeInBytes     = static_cast<size_t>( level.width ) * m_pixelStrideInBytes;
+
+    // Read the rows of tiles that overlap the rows, a row of tiles at a time.
+    std::vector<char>  tilePixels( numTilesX * tileSizeInBytes );
+    std::vector<char*> tileDests( numTilesX );
+    std::vector<Tile>  tiles( numTilesX );
+    for( unsigned int tileY = y0 / tileHeight; tileY * tileHeight < y1; ++tileY )
+    {
+        for( unsigned int tileX = 0; tileX < numTilesX; ++tileX )
+        {
+            tileDests[tileX] = &tilePixels[tileX * tileSizeInBytes];
+            tiles[tileX]     = Tile{tileX, tileY, tileWidth, tileHeight};
+        }
+        if( !WrappedImageSource::readTiles( tileDests.data(), 0, tiles.data(), numTilesX, stream ) )
+            return false;
+
+        // Copy the tiles' rows that were requested.  Tiles on the right edge may extend past the level.
+        const unsigned int rowBegin = std::max( y0, tileY * tileHeight );
+        const unsigned int rowEnd   = std::min( y1, ( tileY + 1 ) * tileHeight );
+        for( unsigned int tileX = 0; tileX < numTilesX; ++tileX )
+        {
+            const size_t copySizeInBytes = std::min( tileWidth, level.width - tileX * tileWidth ) * m_pixelStrideInBytes;
+            for( unsigned int y = rowBegin; y < rowEnd; ++y )
+                std::copy_n( tileDests[tileX] + ( y - tileY * tileHeight ) * tileRowSizeInBytes, copySizeInBytes,
+                             dest + ( y - y0 ) * rowSizeInBytes + tileX * tileRowSizeInBytes );
+        }
+    }
+    return true;
+}
+
+bool MipMapImageSource::getMipLevelRegion( unsigned int mipLevel, unsigned int x0, unsigned int y0, unsigned int x1, unsigned int y1, CUstream stream, DecodedRows& rows )
+{
+    const MipLevel&          level = m_mipLevels[mipLevel];
+    const DecodedLevelLayout layout{level.width, level.height, m_pixelStrideInBytes};
+    x1 = std::min( x1, level.width );
+    y1 = std::min( y1, level.height );
+    if( x0 >= x1 || y0 >= y1 )
+        return false;
+
+    // Level 0 is read from the base image, by rows if it is tiled and otherwise as a whole.
+    if( mipLevel == 0 )
+    {
+        const auto readLevel = [this, &level, stream]( char* levelPixels ) {
+            return WrappedImageSource::readMipLevel( levelPixels, 0, level.width, level.height, stream );
+        };
+        ReadRowsFunction readRows;
+        if( m_mipMapInfo.isTiled )
         {
-            // point sample from source to dest
-            const char* source = getMipLevelBuffer( mipLevel - 1, stream );
-            char*       dest   = m_mipLevels[mipLevel];
-            for( unsigned int y = 0; y < mipLevelHeight; ++y )
+            readRows = [this, stream]( char* dest, unsigned int rowsY0, unsigned int rowsY1 ) {
+                return readBaseRows( dest, rowsY0, rowsY1, stream );
+            };
+        }
+        return getDecodedRows( *m_cache, m_imageId, 0, layout, y0, y1, m_baseReadMutex, readLevel, readRows, rows );
+    }
+
+    // Each band of the level is a row of blocks.
+    const unsigned int bx0 = x0 / MIP_BLOCK_SIZE;
+    const unsigned int by0 = y0 / MIP_BLOCK_SIZE;
+    const unsigned int bx1 = ( x1 - 1 ) / MIP_BLOCK_SIZE + 1;
+    const unsigned int by1 = ( y1 - 1 ) / MIP_BLOCK_SIZE + 1;
+    rows.layout            = layout;
+    rows.firstBand         = by0;
+    rows.bands.clear();
+
+    // Claim the blocks that nobody has generated yet.
+    std::vector<uint2> claimedBlocks;
+    for( unsigned int by = by0; by < by1; ++by )
+    {
+        rows.bands.push_back( m_cache->getBand( m_imageId, mipLevel, by, layout.getBandSizeInBytes( by ), level.numBlocksX ) );
+        DecodedBand&                 band = *rows.bands.back();
+        std::unique_lock<std::mutex> lock( band.mutex );
+        if( band.pixels.empty() )
+            band.pixels.resize( layout.getBandSizeInBytes( by ) );
+        for( unsigned int bx = bx0; bx < bx1; ++bx )
+        {
+            if( band.blockStates[bx] == DecodedBand::EMPTY )
             {
-                for( unsigned int x = 0; x < mipLevelWidth; ++x )
-                {
-                    filterPixel( source, dest, m_pixelStrideInBytes, m_mipMapInfo.format );
-                    // skip every other source pixel
-                    source += m_pixelStrideInBytes * 2ULL;
-                    dest += m_pixelStrideInBytes;
-                }
-                // skip every other source scanline
-                source += static_cast<size_t>( m_pixelStrideInBytes * mipLevelWidth );
+                band.blockStates[bx] = DecodedBand::IN_PROGRESS;
+                claimedBlocks.push_back( make_uint2( bx, by ) );
             }
         }
     }
 
-    return m_mipLevels[mipLevel];
+    // Generate the claimed blocks without holding any locks, so other blocks of the level can be
+    // generated and read meanwhile.
+    if( !claimedBlocks.empty() )
+    {
+        // Get the region of the finer level under the filter taps.
+        const FilterKernel& kernel  = getFilterKernel( m_filter );
+        const int           numTaps = static_cast<int>( kernel.weights.size() );
+        const int           px0     = static_cast<int>( bx0 * MIP_BLOCK_SIZE );
+        const int           py0     = static_cast<int>( by0 * MIP_BLOCK_SIZE );
+        const int           px1     = static_cast<int>( std::min( bx1 * MIP_BLOCK_SIZE, level.width ) );
+        const int           py1     = static_cast<int>( std::min( by1 * MIP_BLOCK_SIZE, level.height ) );
+        DecodedRows         sourceRows;
+        const bool ok = getMipLevelRegion( mipLevel - 1, std::max( 2 * px0 + kernel.firstTap, 0 ), std::max( 2 * py0 + kernel.firstTap, 0 ),
+                                           2 * ( px1 - 1 ) + kernel.firstTap + numTaps,
+                                           2 * ( py1 - 1 ) + kernel.firstTap + numTaps, stream, sourceRows );
+        if( ok )
+            parallelFor( static_cast<unsigned int>( claimedBlocks.size() ), [this, mipLevel, &claimedBlocks, &sourceRows, &rows]( unsigned int i ) {
+                filterBlock( mipLevel, claimedBlocks[i].x, claimedBlocks[i].y, sourceRows, rows );
+            } );
+
+        for( const uint2& block : claimedBlocks )
+        {
+            DecodedBand&                 band = *rows.bands[block.y - by0];
+            std::unique_lock<std::mutex> lock( band.mutex );
+            band.blockStates[block.x] = ok ? DecodedBand::DONE : DecodedBand::EMPTY;
+            band.blockDone.notify_all();
+        }
+    }
+
+    // Wait for the blocks that other threads are generating.  If they failed, so does this read.
+    bool ok = true;
+    for( const std::shared_ptr<DecodedBand>& band : rows.bands )
+    {
+        std::unique_lock<std::mutex> lock( band->mutex );
+        for( unsigned int bx = bx0; bx < bx1; ++bx )
+        {
+            const unsigned char& state = band->blockStates[bx];
+            band->blockDone.wait( lock, [&state] { return state != DecodedBand::IN_PROGRESS; } );
+            ok = ok && state == DecodedBand::DONE;
+        }
+    }
+    return ok;
 }
 
 bool MipMapImageSource::readTile( char* dest, unsigned mipLevel, const Tile& tile, CUstream stream )
@@ -145,34 +553,24 @@ bool MipMapImageSource::readTile( char* dest, unsigned mipLevel, const Tile& til
         }
     }
 
-    const char* mipLevelBuffer;
+    const PixelPosition start = pixelPosition( tile );
+    DecodedRows         rows;
+    if( !getMipLevelRegion( mipLevel, start.x, start.y, start.x + tile.width, start.y + tile.height, stream, rows ) )
+        return false;
     {
         std::unique_lock<std::mutex> lock( m_dataMutex );
-        mipLevelBuffer = getMipLevelBuffer( mipLevel, stream );
-        if( mipLevelBuffer == nullptr )
-            return false;
-
         ++m_numTilesRead;
     }
-    unsigned int mipLevelWidth{ m_mipMapInfo.width };
-    unsigned int level{ mipLevel };
-    if( level > 0 )
-    {
-        do
-        {
-            mipLevelWidth /= 2;
-            level--;
-        } while( level > 0 );
-    }
-    const size_t        mipLevelRowStrideInBytes{ mipLevelWidth * m_pixelStrideInBytes };
-    const size_t        tileRowStrideInBytes{ tile.width * m_pixelStrideInBytes };
-    const PixelPosition start = pixelPosition( tile );
-    const char*         source{ &mipLevelBuffer[start.y * mipLevelRowStrideInBytes + start.x * m_pixelStrideInBytes] };
-    for( unsigned int i = 0; i < tile.height; ++i )
+
+    // Tiles on the right and bottom edges may extend past the mip level.
+    const MipLevel&    level = m_mipLevels[mipLevel];
+    const size_t       tileRowStrideInBytes{ tile.width * m_pixelStrideInBytes };
+    const size_t       copyRowSizeInBytes{ std::min( tile.width, level.width - start.x ) * m_pixelStrideInBytes };
+    const unsigned int numRows = std::min( tile.height, level.height - start.y );
+    for( unsigned int i = 0; i < numRows; ++i )
     {
-        std::copy_n( source, tileRowStrideInBytes, dest );
+        std::copy_n( rows.row( start.y + i ) + start.x * m_pixelStrideInBytes, copyRowSizeInBytes, dest );
         dest += tileRowStrideInBytes;
-        source += mipLevelRowStrideInBytes;
     }
 
     return true;
@@ -188,15 +586,15 @@ bool MipMapImageSource::readMipLevel( char* dest, unsigned int mipLevel, unsigne
         }
     }
 
-    const char* mipLevelBuffer;
-    {
-        std::unique_lock<std::mutex> lock( m_dataMutex );
-        mipLevelBuffer = getMipLevelBuffer( mipLevel, stream );
-        if( mipLevelBuffer == nullptr )
-            return false;
-    }
+    const MipLevel& level = m_mipLevels[mipLevel];
+    DecodedRows     rows;
+    if( !getMipLevelRegion( mipLevel, 0, 0, level.width, level.height, stream, rows ) )
+        return false;
 
-    std::copy_n( mipLevelBuffer, expectedWidth * expectedHeight * m_pixelStrideInBytes, dest );
+    const size_t rowSizeInBytes = static_cast<size_t>( level.width ) * m_pixelStrideInBytes;
+    const size_t sizeInBytes    = static_cast<size_t>( expectedWidth ) * expectedHeight * m_pixelStrideInBytes;
+    for( unsigned int y = 0; y < level.height && y * rowSizeInBytes < sizeInBytes; ++y )
+        std::copy_n( rows.row( y ), std::min( rowSizeInBytes, sizeInBytes - y * rowSizeInBytes ), dest + y * rowSizeInBytes );
     return true;
 }
 
@@ -218,7 +616,8 @@ bool MipMapImageSource::readMipTail( char*        dest,
     for( unsigned int mipLevel = mipTailFirstLevel; mipLevel < numMipLevels; ++mipLevel )
     {
         const uint2 levelDims = mipLevelDims[mipLevel];
-        readMipLevel( dest + offset, mipLevel, levelDims.x, levelDims.y, stream );
+        if( !readMipLevel( dest + offset, mipLevel, levelDims.x, levelDims.y, stream ) )
+            return false;
         offset += static_cast<size_t>( ( levelDims.x * levelDims.y * getBitsPerPixel( m_mipMapInfo ) ) / BITS_PER_BYTE );
     }
 
@@ -236,4 +635,16 @@ unsigned long long MipMapImageSource::getNumTilesRead() const
     return m_numTilesRead;
 }
 
+DecodedDataStatistics MipMapImageSource::getDecodedDataStatistics() const
+{
+    {
+        std::unique_lock<std::mutex> lock( m_dataMutex );
+        if( m_mipMappedBase )
+        {
+            return WrappedImageSource::getDecodedDataStatistics();
+        }
+    }
+    return m_cache->getStatistics( m_imageId );
+}
+
 }  // namespace imageSource
@@ -0,0 +1,178 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <OptiXToolkit/ImageSource/ReadOnlyFile.h>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace imageSource {
+
+#ifdef _WIN32
+
+bool ReadOnlyFile::open( const std::string& path, bool map )
+{
+    close();
+    HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+    if( file == INVALID_HANDLE_VALUE )
+        return false;
+    LARGE_INTEGER size;
+    if( !GetFileSizeEx( file, &size ) )
+    {
+        CloseHandle( file );
+        return false;
+    }
+    m_file = file;
+    m_size = static_cast<unsigned long long>( size.QuadPart );
+
+    // Empty files can't be mapped.
+    if( map && m_size > 0 )
+    {
+        m_mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+        if( m_mapping != nullptr )
+        {
+            m_data = static_cast<const char*>( MapViewOfFile( m_mapping, FILE_MAP_READ, 0, 0, 0 ) );
+            if( m_data == nullptr )
+            {
+                CloseHandle( m_mapping );
+                m_mapping = nullptr;
+            }
+        }
+    }
+    return true;
+}
+
+void ReadOnlyFile::close()
+{
+    if( m_data != nullptr )
+        UnmapViewOfFile( m_data );
+    if( m_mapping != nullptr )
+        CloseHandle( m_mapping );
+    if( m_file != nullptr )
+        CloseHandle( m_file );
+    m_file    = nullptr;
+    m_mapping = nullptr;
+    m_data    = nullptr;
+    m_size    = 0;
+}
+
+bool ReadOnlyFile::isOpen() const
+{
+    return m_file != nullptr;
+}
+
+bool ReadOnlyFile::read( char* dest, size_t size, unsigned long long offset ) const
+{
+    if( m_file == nullptr || offset + size > m_size )
+        return false;
+    if( const char* data = getData( offset, size ) )
+    {
+        std::memcpy( dest, data, size );
+        return true;
+    }
+
+    // ReadFile at an explicit offset doesn't depend on the file pointer, so threads can read concurrently.
+    while( size > 0 )
+    {
+        OVERLAPPED overlapped{};
+        overlapped.Offset     = static_cast<DWORD>( offset );
+        overlapped.OffsetHigh = static_cast<DWORD>( offset >> 32 );
+        const DWORD numBytes  = static_cast<DWORD>( std::min<size_t>( size, 1U << 30 ) );
+        DWORD       numRead   = 0;
+        if( !ReadFile( m_file, dest, numBytes, &numRead, &overlapped ) || numRead == 0 )
+            return false;
+        dest += numRead;
+        size -= numRead;
+        offset += numRead;
+    }
+    return true;
+}
+
+#else
+
+bool ReadOnlyFile::open( const std::string& path, bool map )
+{
+    close();
+    const int file = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+    if( file < 0 )
+        return false;
+    struct stat status;
+    if( fstat( file, &status ) != 0 )
+    {
+        ::close( file );
+        return false;
+    }
+    m_file = file;
+    m_size = static_cast<unsigned long long>( status.st_size );
+
+    // Empty files can't be mapped.
+    if( map && m_size > 0 )
+    {
+        void* data = mmap( nullptr, m_size, PROT_READ, MAP_SHARED, file, 0 );
+        if( data != MAP_FAILED )
+            m_data = static_cast<const char*>( data );
+    }
+    return true;
+}
+
+void ReadOnlyFile::close()
+{
+    if( m_data != nullptr )
+        munmap( const_cast<char*>( m_data ), m_size );
+    if( m_file >= 0 )
+        ::close( m_file );
+    m_file = -1;
+    m_data = nullptr;
+    m_size = 0;
+}
+
+bool ReadOnlyFile::isOpen() const
+{
+    return m_file >= 0;
+}
+
+bool ReadOnlyFile::read( char* dest, size_t size, unsigned long long offset ) const
+{
+    if( m_file < 0 || offset + size > m_size )
+        return false;
+    if( const char* data = getData( offset, size ) )
+    {
+        std::memcpy( dest, data, size );
+        return true;
+    }
+
+    // pread doesn't use the file position, so threads can read concurrently.
+    while( size > 0 )
+    {
+        const ssize_t numRead = pread( m_file, dest, size, static_cast<off_t>( offset ) );
+        if( numRead < 0 && errno == EINTR )
+            continue;
+        if( numRead <= 0 )
+            return false;
+        dest += numRead;
+        size -= static_cast<size_t>( numRead );
+        offset += static_cast<unsigned long long>( numRead );
+    }
+    return true;
+}
+
+#endif
+
+}  // namespace imageSource
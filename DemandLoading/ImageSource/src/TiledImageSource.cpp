@@ -1,9 +1,11 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #include <OptiXToolkit/ImageSource/TiledImageSource.h>
 
+#include "DecodedRows.h"
+
 #include <OptiXToolkit/Error/ErrorCheck.h>
 
 #include <algorithm>
@@ -13,8 +15,10 @@
 
 namespace imageSource {
 
-TiledImageSource::TiledImageSource( std::shared_ptr<ImageSource> baseImage )
+TiledImageSource::TiledImageSource( std::shared_ptr<ImageSource> baseImage, std::shared_ptr<DecodedDataCache> cache )
     : WrappedImageSource( baseImage )
+    , m_cache( cache ? std::move( cache ) : DecodedDataCache::getInstance() )
+    , m_imageId( m_cache->createImageId() )
 {
     if( baseImage->isOpen() )
     {
@@ -22,11 +26,25 @@ TiledImageSource::TiledImageSource( std::shared_ptr<ImageSource> baseImage )
     }
 }
 
+TiledImageSource::~TiledImageSource()
+{
+    m_cache->releaseImageId( m_imageId );
+}
+
 void TiledImageSource::getBaseInfo()
 {
     m_tiledInfo = WrappedImageSource::getInfo();
     m_baseIsTiled       = m_tiledInfo.isTiled;
     m_tiledInfo.isTiled = true;
+
+    m_mipDimensions.resize( m_tiledInfo.numMipLevels );
+    for( unsigned int mipLevel = 0; mipLevel < m_tiledInfo.numMipLevels; ++mipLevel )
+    {
+        m_mipDimensions[mipLevel].x = std::max( m_tiledInfo.width >> mipLevel, 1u );
+        m_mipDimensions[mipLevel].y = std::max( m_tiledInfo.height >> mipLevel, 1u );
+    }
+    while( m_levelMutexes.size() < m_tiledInfo.numMipLevels )
+        m_levelMutexes.emplace_back( new std::mutex );
 }
 
 void TiledImageSource::open( TextureInfo* info )
@@ -46,6 +64,8 @@ void TiledImageSource::open( TextureInfo* info )
 void TiledImageSource::close()
 {
     WrappedImageSource::close();
+    m_cache->removeImage( m_imageId );
+    std::unique_lock<std::mutex> lock( m_dataMutex );
     m_tiledInfo = TextureInfo{};
 }
 
@@ -59,71 +79,69 @@ const TextureInfo& TiledImageSource::getInfo() const
     return m_tiledInfo;
 }
 
-bool TiledImageSource::readTile( char* dest, unsigned int mipLevel, const Tile& tile, CUstream stream )
+bool TiledImageSource::readTiles( char* const* dest, unsigned int mipLevel, const Tile* tiles, unsigned int numTiles, CUstream stream )
 {
     {
         std::unique_lock<std::mutex> lock( m_dataMutex );
         if( m_baseIsTiled )
         {
-            return WrappedImageSource::readTile( dest, mipLevel, tile, stream);
+            return WrappedImageSource::readTiles( dest, mipLevel, tiles, numTiles, stream );
         }
     }
 
-    const char* mipLevelBuffer;
-    uint2 mipDimensions;
+    // Tiles are extracted from the cached mip levels.
+    return ImageSource::readTiles( dest, mipLevel, tiles, numTiles, stream );
+}
+
+bool TiledImageSource::readTile( char* dest, unsigned int mipLevel, const Tile& tile, CUstream stream )
+{
     {
         std::unique_lock<std::mutex> lock( m_dataMutex );
-
-        if( m_buffer.empty() )
+        if( m_baseIsTiled )
         {
-            m_buffer.resize( getTextureSizeInBytes( m_tiledInfo ) );
-            m_mipLevels.resize( m_tiledInfo.numMipLevels );
-            m_mipDimensions.resize( m_tiledInfo.numMipLevels );
+            return WrappedImageSource::readTile( dest, mipLevel, tile, stream);
         }
+    }
 
-        if( m_mipLevels[mipLevel] == nullptr )
-        {
-            size_t levelSize = ( m_tiledInfo.width * m_tiledInfo.height * getBitsPerPixel( m_tiledInfo ) ) / BITS_PER_BYTE;
-            char*        ptr            = m_buffer.data();
-            unsigned int mipLevelWidth  = m_tiledInfo.width;
-            unsigned int mipLevelHeight = m_tiledInfo.height;
-            for( unsigned int i = 0; i < mipLevel; ++i )
-            {
-                ptr += levelSize;
-                levelSize /= 4;
-                mipLevelWidth /= 2;
-                mipLevelHeight /= 2;
-            }
-            m_mipLevels[mipLevel] = ptr;
-            m_mipDimensions[mipLevel].x = mipLevelWidth;
-            m_mipDimensions[mipLevel].y = mipLevelHeight;
-            if( !WrappedImageSource::readMipLevel( m_mipLevels[mipLevel], mipLevel, mipLevelWidth, mipLevelHeight, stream ) )
-            {
-                OTK_ASSERT(false);
-                return false;
-            }    
-        }
+    uint2       mipDimensions;
+    size_t      pixelSizeInBytes;
+    std::mutex* levelMutex;
+    {
+        std::unique_lock<std::mutex> lock( m_dataMutex );
+        OTK_ASSERT_MSG( mipLevel < m_mipDimensions.size(), ( "Bad mip level " + std::to_string( mipLevel ) ).c_str() );
+        mipDimensions    = m_mipDimensions[mipLevel];
+        pixelSizeInBytes = getBitsPerPixel( m_tiledInfo ) / BITS_PER_BYTE;
+        levelMutex       = m_levelMutexes[mipLevel].get();
+    }
 
+    // Get the bands of the level that hold the tile's rows, reading the level if they aren't cached.
+    // The base image isn't tiled, so it can only read whole levels.
+    const PixelPosition      start = pixelPosition( tile );
+    const DecodedLevelLayout layout{mipDimensions.x, mipDimensions.y, pixelSizeInBytes};
+    const auto               readLevel = [this, mipLevel, mipDimensions, stream]( char* levelPixels ) {
+        return WrappedImageSource::readMipLevel( levelPixels, mipLevel, mipDimensions.x, mipDimensions.y, stream );
+    };
+    DecodedRows rows;
+    if( start.x >= mipDimensions.x || start.y >= mipDimensions.y
+        || !getDecodedRows( *m_cache, m_imageId, mipLevel, layout, start.y, std::min( start.y + tile.height, mipDimensions.y ),
+                            *levelMutex, readLevel, ReadRowsFunction(), rows ) )
+    {
+        return false;
+    }
+    {
+        std::unique_lock<std::mutex> lock( m_dataMutex );
         ++m_numTilesRead;
-        mipLevelBuffer = m_mipLevels[mipLevel];
-        mipDimensions = m_mipDimensions[mipLevel];
     }
 
-    OTK_ASSERT_MSG( mipLevelBuffer != nullptr, ( "Bad pointer for level " + std::to_string( mipLevel ) ).c_str() );
-    const size_t        pixelSizeInBytes         = getBitsPerPixel( m_tiledInfo ) / BITS_PER_BYTE;
     // Partial tile dimensions might be less than the nominal dimensions.
-    const size_t        sourceWidth              = std::min( tile.width, mipDimensions.x - tile.x * tile.width );
-    const size_t        sourceHeight             = std::min( tile.height, mipDimensions.y - tile.y * tile.height );
-    const size_t        sourceRowWidthInBytes    = sourceWidth * pixelSizeInBytes;
-    const size_t        sourceRowStrideInBytes   = mipDimensions.x * pixelSizeInBytes;
-    const size_t        destTileRowStrideInBytes = tile.width * pixelSizeInBytes;
-    const PixelPosition start                    = pixelPosition( tile );
-    const char*         source = mipLevelBuffer + start.y * sourceRowStrideInBytes + start.x * pixelSizeInBytes;
+    const size_t sourceWidth              = std::min( tile.width, mipDimensions.x - start.x );
+    const size_t sourceHeight             = std::min( tile.height, mipDimensions.y - start.y );
+    const size_t sourceRowWidthInBytes    = sourceWidth * pixelSizeInBytes;
+    const size_t destTileRowStrideInBytes = tile.width * pixelSizeInBytes;
     for( unsigned int i = 0; i < sourceHeight; ++i )
     {
-        std::copy_n( source, sourceRowWidthInBytes, dest );
+        std::copy_n( rows.row( start.y + i ) + start.x * pixelSizeInBytes, sourceRowWidthInBytes, dest );
         dest += destTileRowStrideInBytes;
-        source += sourceRowStrideInBytes;
     }
 
     return true;
@@ -164,4 +182,16 @@ unsigned long long TiledImageSource::getNumTilesRead() const
     return m_numTilesRead;
 }
 
+DecodedDataStatistics TiledImageSource::getDecodedDataStatistics() const
+{
+    {
+        std::unique_lock<std::mutex> lock( m_dataMutex );
+        if( m_baseIsTiled )
+        {
+            return WrappedImageSource::getDecodedDataStatistics();
+        }
+    }
+    return m_cache->getStatistics( m_imageId );
+}
+
 }  // namespace imageSource
@@ -0,0 +1,213 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <OptiXToolkit/ImageSource/CompressedTextureCacheManager.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// The converters are replaced by stub shell scripts.
+#ifndef _WIN32
+
+#include <sys/stat.h>
+
+using namespace imageSource;
+
+namespace {
+
+const unsigned int NUM_IMAGES = 6;
+
+bool fileExists( const std::string& path )
+{
+    struct stat status;
+    return stat( path.c_str(), &status ) == 0;
+}
+
+void writeFile( const std::string& path, const std::string& contents )
+{
+    std::ofstream file( path, std::ios::binary | std::ios::trunc );
+    file << contents;
+}
+
+unsigned int countLines( const std::string& path, const std::string& text )
+{
+    std::ifstream file( path );
+    std::string   line;
+    unsigned int  count = 0;
+    while( std::getline( file, line ) )
+        count += line == text ? 1 : 0;
+    return count;
+}
+
+}  // namespace
+
+class TestCompressedTextureCacheManager : public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+        m_dir = testing::TempDir() + "/TestCompressedTextureCacheManager";
+        std::system( ( "rm -rf \"" + m_dir + "\"" ).c_str() );
+        mkdir( m_dir.c_str(), 0755 );
+        m_log = m_dir + "/tool.log";
+
+        // The stub converters write their output file (the last argument), logging each run, and
+        // logging an overlap if another run of the same tool is in progress.
+        writeStub( "nvcompress", "$last" );
+        writeStub( "ntc-cli", "$last" );
+
+        m_options.cacheFolder       = m_dir + "/cache";
+        m_options.nvcompress        = m_dir + "/nvcompress";
+        m_options.ntcCli            = m_dir + "/ntc-cli";
+        m_options.saveTiled         = false;
+        m_options.maxJobs           = 4;
+        m_options.maxNvcompressJobs = 1;
+
+        for( unsigned int i = 0; i < NUM_IMAGES; ++i )
+        {
+            m_images.push_back( m_dir + "/image " + std::to_string( i ) + ".png" );
+            writeFile( m_images.back(), "image " + std::to_string( i ) );
+        }
+    }
+
+    void TearDown() override { std::system( ( "rm -rf \"" + m_dir + "\"" ).c_str() ); }
+
+  protected:
+    std::string                   m_dir;
+    std::string                   m_log;
+    std::vector<std::string>      m_images;
+    CompressedTextureCacheOptions m_options;
+
+    void writeStub( const std::string& tool, const std::string& output, int exitCode = 0 )
+    {
+        const std::string lock = m_dir + "/" + tool + ".lock";
+        std::ostringstream script;
+        script << "#!/bin/sh\n"
+               << "for last; do :; done\n"
+               << "mkdir \"" << lock << "\" 2>/dev/null || echo overlap >> \"" << m_log << "\"\n"
+               << "echo " << tool << " >> \"" << m_log << "\"\n"
+               << "sleep 0.02\n"
+               << "head -c 256 /dev/zero > \"" << output << "\"\n"
+               << "rmdir \"" << lock << "\"\n"
+               << "exit " << exitCode << "\n";
+        const std::string path = m_dir + "/" + tool;
+        writeFile( path, script.str() );
+        chmod( path.c_str(), 0755 );
+    }
+
+    std::string cacheFile( const std::string& input ) { return CompressedTextureCacheManager( m_options ).getCacheFilePath( input, ".dds" ); }
+};
+
+TEST_F( TestCompressedTextureCacheManager, ConvertsFilesInParallel )
+{
+    CompressedTextureCacheManager manager( m_options );
+    CompressedTextureCacheResults results = manager.cacheFiles( m_images, {} );
+
+    EXPECT_EQ( NUM_IMAGES, results.numConverted );
+    EXPECT_EQ( 0U, results.numSkipped );
+    EXPECT_TRUE( results.failedFiles.empty() );
+    EXPECT_EQ( NUM_IMAGES, countLines( m_log, "nvcompress" ) );
+    EXPECT_EQ( 0U, countLines( m_log, "overlap" ) );  // maxNvcompressJobs is 1
+    for( const std::string& image : m_images )
+    {
+        EXPECT_TRUE( fileExists( manager.getCacheFilePath( image, ".dds" ) ) );
+        EXPECT_FALSE( fileExists( manager.getCacheFilePath( image, ".part.dds" ) ) );
+    }
+}
+
+TEST_F( TestCompressedTextureCacheManager, SkipsUnchangedInputs )
+{
+    CompressedTextureCacheManager( m_options ).cacheFiles( m_images, {} );
+
+    // Change the size of one input.  Only that input is converted again.
+    writeFile( m_images[2], "a changed image" );
+    CompressedTextureCacheResults results = CompressedTextureCacheManager( m_options ).cacheFiles( m_images, {} );
+
+    EXPECT_EQ( 1U, results.numConverted );
+    EXPECT_EQ( NUM_IMAGES - 1, results.numSkipped );
+    EXPECT_EQ( NUM_IMAGES + 1, countLines( m_log, "nvcompress" ) );
+}
+
+TEST_F( TestCompressedTextureCacheManager, ChangedOptionsReconvert )
+{
+    CompressedTextureCacheManager( m_options ).cacheFiles( m_images, {} );
+
+    m_options.flags = "-fast";
+    CompressedTextureCacheResults results = CompressedTextureCacheManager( m_options ).cacheFiles( m_images, {} );
+
+    EXPECT_EQ( NUM_IMAGES, results.numConverted );
+    EXPECT_EQ( 2 * NUM_IMAGES, countLines( m_log, "nvcompress" ) );
+}
+
+TEST_F( TestCompressedTextureCacheManager, AdoptsCacheFilesNewerThanInputs )
+{
+    // Cache files made before the manifest was used are kept if they are newer than their inputs.
+    mkdir( m_options.cacheFolder.c_str(), 0755 );
+    for( const std::string& image : m_images )
+        writeFile( cacheFile( image ), "cached" );
+
+    CompressedTextureCacheResults results = CompressedTextureCacheManager( m_options ).cacheFiles( m_images, {} );
+    EXPECT_EQ( NUM_IMAGES, results.numSkipped );
+    EXPECT_EQ( 0U, countLines( m_log, "nvcompress" ) );
+}
+
+TEST_F( TestCompressedTextureCacheManager, FailedConversionsAreRetried )
+{
+    writeStub( "nvcompress", "$last", 1 );
+    m_options.maxRetries = 2;
+
+    CompressedTextureCacheManager manager( m_options );
+    CompressedTextureCacheResults results = manager.cacheFiles( m_images, {} );
+
+    EXPECT_EQ( 0U, results.numConverted );
+    EXPECT_EQ( NUM_IMAGES, results.failedFiles.size() );
+    EXPECT_EQ( NUM_IMAGES * ( 1 + m_options.maxRetries ), countLines( m_log, "nvcompress" ) );
+    for( const std::string& image : m_images )
+    {
+        EXPECT_FALSE( fileExists( manager.getCacheFilePath( image, ".dds" ) ) );
+        EXPECT_FALSE( fileExists( manager.getCacheFilePath( image, ".part.dds" ) ) );
+    }
+}
+
+TEST_F( TestCompressedTextureCacheManager, InputsWithTheSameCacheFileAreConvertedOnce )
+{
+    // A repeated input, and an input differing only in its extension, map to the same cache file.
+    std::vector<std::string> inputs = m_images;
+    inputs.push_back( m_images[0] );
+    inputs.push_back( m_dir + "/image 1.jpg" );
+    writeFile( inputs.back(), "image 1 as jpg" );
+
+    CompressedTextureCacheResults results = CompressedTextureCacheManager( m_options ).cacheFiles( inputs, {} );
+    EXPECT_EQ( NUM_IMAGES, results.numConverted );
+    EXPECT_EQ( 2U, results.numSkipped );
+    EXPECT_TRUE( results.failedFiles.empty() );
+    EXPECT_EQ( NUM_IMAGES, countLines( m_log, "nvcompress" ) );
+}
+
+TEST_F( TestCompressedTextureCacheManager, ConvertsTextureSets )
+{
+    const std::vector<std::vector<std::string>> textureSets{ { "set0.ntc", m_images[0], m_images[1] },
+                                                             { "set1.ntc", m_images[2], m_images[3] } };
+    m_options.maxNtcCliJobs = 1;
+
+    CompressedTextureCacheManager manager( m_options );
+    CompressedTextureCacheResults results = manager.cacheFiles( {}, textureSets );
+    EXPECT_EQ( 2U, results.numConverted );
+    EXPECT_EQ( 2U, countLines( m_log, "ntc-cli" ) );
+    EXPECT_EQ( 0U, countLines( m_log, "overlap" ) );
+    EXPECT_TRUE( fileExists( manager.getCacheFilePath( "set0.ntc", "" ) ) );
+
+    // A texture set is converted again when any of its inputs change.
+    writeFile( m_images[3], "a changed image" );
+    results = manager.cacheFiles( {}, textureSets );
+    EXPECT_EQ( 1U, results.numConverted );
+    EXPECT_EQ( 1U, results.numSkipped );
+}
+
+#endif  // _WIN32
@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <OptiXToolkit/ImageSource/DDSImageReader.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+using namespace imageSource;
+
+namespace {
+
+const unsigned int IMAGE_SIZE        = 512;
+const unsigned int NUM_MIP_LEVELS    = 3;
+const unsigned int BC1_BLOCK_SIZE    = 8;
+const unsigned int TILE_WIDTH        = 512;  // BC1 tiles are 512x256 pixels.
+const unsigned int TILE_HEIGHT       = 256;
+const unsigned int TILE_WIDTH_BLOCKS = TILE_WIDTH / BC_BLOCK_WIDTH;
+
+char blockByte( unsigned int mipLevel, unsigned int blockX, unsigned int blockY, unsigned int i )
+{
+    return static_cast<char>( blockX + 3 * blockY + 7 * mipLevel + i );
+}
+
+// Write a flat BC1 file whose blocks hold a pattern of their positions.
+std::string writeFlatDDS()
+{
+    const std::string fileName = testing::TempDir() + "/TestDDSImageReader.dds";
+
+    DDSFileHeader header{};
+    header.magicNumber           = DDS_MAGIC_NUMBER;
+    header.sizeCheck             = 124;
+    header.flags                 = 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000;  // caps, height, width, pixel format, mip count
+    header.height                = IMAGE_SIZE;
+    header.width                 = IMAGE_SIZE;
+    header.mipMapCount           = NUM_MIP_LEVELS;
+    header.pixelFormat.sizeCheck = 32;
+    header.pixelFormat.flags     = 0x4;  // fourCC
+    std::memcpy( header.pixelFormat.fourCCcode, "DXT1", 4 );
+
+    std::ofstream file( fileName, std::ios::binary );
+    file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+    for( unsigned int mipLevel = 0; mipLevel < NUM_MIP_LEVELS; ++mipLevel )
+    {
+        const unsigned int levelSizeInBlocks = ( IMAGE_SIZE >> mipLevel ) / BC_BLOCK_WIDTH;
+        for( unsigned int y = 0; y < levelSizeInBlocks; ++y )
+            for( unsigned int x = 0; x < levelSizeInBlocks; ++x )
+                for( unsigned int i = 0; i < BC1_BLOCK_SIZE; ++i )
+                    file.put( blockByte( mipLevel, x, y, i ) );
+    }
+    return fileName;
+}
+
+// Count the blocks of a tile that don't hold the expected pattern.
+unsigned int countBadBlocks( const std::vector<char>& tile, unsigned int mipLevel, unsigned int tileX, unsigned int tileY )
+{
+    const unsigned int levelSizeInBlocks = ( IMAGE_SIZE >> mipLevel ) / BC_BLOCK_WIDTH;
+    const unsigned int tileHeightBlocks  = TILE_HEIGHT / BC_BLOCK_HEIGHT;
+    unsigned int       numBad            = 0;
+    for( unsigned int y = 0; y < tileHeightBlocks && tileY * tileHeightBlocks + y < levelSizeInBlocks; ++y )
+    {
+        for( unsigned int x = 0; x < TILE_WIDTH_BLOCKS && tileX * TILE_WIDTH_BLOCKS + x < levelSizeInBlocks; ++x )
+        {
+            const char* block = &tile[( y * TILE_WIDTH_BLOCKS + x ) * BC1_BLOCK_SIZE];
+            for( unsigned int i = 0; i < BC1_BLOCK_SIZE; ++i )
+            {
+                if( block[i] != blockByte( mipLevel, tileX * TILE_WIDTH_BLOCKS + x, tileY * tileHeightBlocks + y, i ) )
+                {
+                    ++numBad;
+                    break;
+                }
+            }
+        }
+    }
+    return numBad;
+}
+
+// The tests are run with the file mapped or read, and with or without the mip level cache.
+class TestDDSImageReader : public testing::TestWithParam<std::tuple<bool, size_t>>
+{
+  protected:
+    void SetUp() override
+    {
+        m_options.mapFile         = std::get<0>( GetParam() );
+        m_options.maxMipCacheSize = std::get<1>( GetParam() );
+    }
+
+    DDSReaderOptions   m_options;
+    const std::string& m_flatFileName{ getFlatFileName() };
+
+    static const std::string& getFlatFileName()
+    {
+        static const std::string fileName = writeFlatDDS();
+        return fileName;
+    }
+};
+
+}  // namespace
+
+TEST_P( TestDDSImageReader, open )
+{
+    DDSImageReader reader( m_flatFileName, false, m_options );
+    TextureInfo    info{};
+
+    reader.open( &info );
+
+    EXPECT_TRUE( reader.isOpen() );
+    EXPECT_TRUE( info.isValid );
+    EXPECT_EQ( IMAGE_SIZE, info.width );
+    EXPECT_EQ( IMAGE_SIZE, info.height );
+    EXPECT_EQ( CU_AD_FORMAT_BC1_UNORM, info.format );
+    EXPECT_EQ( NUM_MIP_LEVELS, info.numMipLevels );
+    EXPECT_FALSE( reader.isFileTiled() );
+    EXPECT_EQ( TILE_WIDTH, reader.getTileWidth() );
+    EXPECT_EQ( TILE_HEIGHT, reader.getTileHeight() );
+}
+
+TEST_P( TestDDSImageReader, readTileFlat )
+{
+    DDSImageReader    reader( m_flatFileName, false, m_options );
+    std::vector<char> tile( TILE_SIZE_IN_BYTES );
+
+    for( unsigned int mipLevel = 0; mipLevel < NUM_MIP_LEVELS; ++mipLevel )
+    {
+        const unsigned int tileY = mipLevel == 0 ? 1 : 0;
+        ASSERT_TRUE( reader.readTile( tile.data(), mipLevel, Tile{ 0, tileY, TILE_WIDTH, TILE_HEIGHT }, CUstream{} ) );
+        EXPECT_EQ( 0U, countBadBlocks( tile, mipLevel, 0, tileY ) ) << "mip level " << mipLevel;
+    }
+    EXPECT_EQ( NUM_MIP_LEVELS, reader.getNumTilesRead() );
+}
+
+TEST_P( TestDDSImageReader, readTileTiled )
+{
+    const std::string tiledFileName = testing::TempDir() + "/TestDDSImageReaderTiled.dds";
+    {
+        DDSImageReader flatReader( m_flatFileName, false, m_options );
+        ASSERT_TRUE( flatReader.saveAsTiledFile( tiledFileName.c_str() ) );
+    }
+    DDSImageReader    reader( tiledFileName, false, m_options );
+    std::vector<char> tiles[2]{ std::vector<char>( TILE_SIZE_IN_BYTES ), std::vector<char>( TILE_SIZE_IN_BYTES ) };
+    char* const       dest[2]{ tiles[0].data(), tiles[1].data() };
+    const Tile        levelZeroTiles[2]{ Tile{ 0, 1, TILE_WIDTH, TILE_HEIGHT }, Tile{ 0, 0, TILE_WIDTH, TILE_HEIGHT } };
+
+    ASSERT_TRUE( reader.readTiles( dest, 0, levelZeroTiles, 2, CUstream{} ) );
+
+    EXPECT_TRUE( reader.isFileTiled() );
+    EXPECT_EQ( 0U, countBadBlocks( tiles[0], 0, 0, 1 ) );
+    EXPECT_EQ( 0U, countBadBlocks( tiles[1], 0, 0, 0 ) );
+}
+
+TEST_P( TestDDSImageReader, readMipLevelFlat )
+{
+    DDSImageReader     reader( m_flatFileName, false, m_options );
+    const unsigned int mipLevel = 1;
+    std::vector<char>  level( reader.getMipLevelSizeInBytes( mipLevel ) );
+
+    ASSERT_TRUE( reader.readMipLevel( level.data(), mipLevel, IMAGE_SIZE >> mipLevel, IMAGE_SIZE >> mipLevel, CUstream{} ) );
+
+    const unsigned int levelSizeInBlocks = ( IMAGE_SIZE >> mipLevel ) / BC_BLOCK_WIDTH;
+    EXPECT_EQ( blockByte( mipLevel, 0, 0, 0 ), level[0] );
+    EXPECT_EQ( blockByte( mipLevel, levelSizeInBlocks - 1, levelSizeInBlocks - 1, BC1_BLOCK_SIZE - 1 ), level.back() );
+}
+
+TEST_P( TestDDSImageReader, concurrentReadTiles )
+{
+    DDSImageReader           reader( m_flatFileName, false, m_options );
+    const unsigned int       numThreads = 4;
+    std::vector<unsigned>    numBad( numThreads );
+    std::vector<std::thread> threads;
+    for( unsigned int i = 0; i < numThreads; ++i )
+    {
+        threads.emplace_back( [&reader, &numBad, i] {
+            std::vector<char> tile( TILE_SIZE_IN_BYTES );
+            for( unsigned int j = 0; j < 20; ++j )
+            {
+                const unsigned int mipLevel = ( i + j ) % NUM_MIP_LEVELS;
+                const unsigned int tileY    = mipLevel == 0 ? j % 2 : 0;
+                if( !reader.readTile( tile.data(), mipLevel, Tile{ 0, tileY, TILE_WIDTH, TILE_HEIGHT }, CUstream{} ) )
+                    ++numBad[i];
+                else
+                    numBad[i] += countBadBlocks( tile, mipLevel, 0, tileY );
+            }
+        } );
+    }
+    for( std::thread& thread : threads )
+        thread.join();
+
+    for( unsigned int i = 0; i < numThreads; ++i )
+        EXPECT_EQ( 0U, numBad[i] ) << "thread " << i;
+    EXPECT_EQ( numThreads * 20ULL, reader.getNumTilesRead() );
+}
+
+TEST_P( TestDDSImageReader, closeWhileReading )
+{
+    // Reads that overlap a close either fail or read the right data; they must not read an
+    // unmapped or closed file.
+    DDSImageReader           reader( m_flatFileName, false, m_options );
+    const unsigned int       numThreads = 4;
+    std::vector<unsigned>    numBad( numThreads );
+    std::atomic<bool>        done{ false };
+    std::vector<std::thread> threads;
+    for( unsigned int i = 0; i < numThreads; ++i )
+    {
+        threads.emplace_back( [&reader, &numBad, &done, i] {
+            std::vector<char> tile( TILE_SIZE_IN_BYTES );
+            for( unsigned int j = 0; !done; ++j )
+            {
+                const unsigned int mipLevel = ( i + j ) % NUM_MIP_LEVELS;
+                if( reader.readTile( tile.data(), mipLevel, Tile{ 0, 0, TILE_WIDTH, TILE_HEIGHT }, CUstream{} ) )
+                    numBad[i] += countBadBlocks( tile, mipLevel, 0, 0 );
+            }
+        } );
+    }
+    for( unsigned int i = 0; i < 100; ++i )
+    {
+        reader.open( nullptr );
+        reader.close();
+    }
+    done = true;
+    for( std::thread& thread : threads )
+        thread.join();
+
+    for( unsigned int i = 0; i < numThreads; ++i )
+        EXPECT_EQ( 0U, numBad[i] ) << "thread " << i;
+}
+
+// The cache budget 64KB holds mip level 1 but not level 0, which is read a row of blocks at a time.
+INSTANTIATE_TEST_SUITE_P( MapAndCache,
+                          TestDDSImageReader,
+                          testing::Combine( testing::Bool(), testing::Values( size_t( 0 ), size_t( 65536 ), size_t( 1 ) << 20 ) ) );
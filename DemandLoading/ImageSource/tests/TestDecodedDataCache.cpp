@@ -0,0 +1,112 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <OptiXToolkit/ImageSource/DecodedDataCache.h>
+
+#include <gtest/gtest.h>
+
+using namespace imageSource;
+
+namespace {
+
+const size_t BAND_SIZE = 1000;
+
+class TestDecodedDataCache : public testing::Test
+{
+  protected:
+    DecodedDataCache   m_cache{ 3 * BAND_SIZE };
+    unsigned long long m_image{ m_cache.createImageId() };
+    unsigned long long m_otherImage{ m_cache.createImageId() };
+};
+
+}  // namespace
+
+TEST_F( TestDecodedDataCache, newBandIsEmpty )
+{
+    std::shared_ptr<DecodedBand> band = m_cache.getBand( m_image, 0, 0, BAND_SIZE, 4 );
+
+    ASSERT_TRUE( band );
+    EXPECT_EQ( 4U, band->blockStates.size() );
+    for( unsigned char state : band->blockStates )
+        EXPECT_EQ( DecodedBand::EMPTY, state );
+    EXPECT_EQ( BAND_SIZE, m_cache.getSize() );
+    EXPECT_TRUE( m_cache.hasBand( m_image, 0, 0 ) );
+    EXPECT_FALSE( m_cache.hasBand( m_image, 1, 0 ) );
+    EXPECT_FALSE( m_cache.hasBand( m_otherImage, 0, 0 ) );
+}
+
+TEST_F( TestDecodedDataCache, countsHitsAndMisses )
+{
+    std::shared_ptr<DecodedBand> band = m_cache.getBand( m_image, 0, 0, BAND_SIZE, 1 );
+
+    EXPECT_EQ( band, m_cache.getBand( m_image, 0, 0, BAND_SIZE, 1 ) );
+    m_cache.getBand( m_otherImage, 0, 0, BAND_SIZE, 1 );
+
+    const DecodedDataStatistics stats = m_cache.getStatistics( m_image );
+    EXPECT_EQ( 1ULL, stats.numHits );
+    EXPECT_EQ( 1ULL, stats.numMisses );
+    EXPECT_EQ( 0ULL, stats.numEvictions );
+    EXPECT_EQ( 2ULL, m_cache.getStatistics().numMisses );
+}
+
+TEST_F( TestDecodedDataCache, evictsLeastRecentlyUsed )
+{
+    m_cache.getBand( m_image, 0, 0, BAND_SIZE, 1 );
+    m_cache.getBand( m_image, 0, 1, BAND_SIZE, 1 );
+    m_cache.getBand( m_otherImage, 0, 0, BAND_SIZE, 1 );
+    m_cache.getBand( m_image, 0, 0, BAND_SIZE, 1 );  // band 1 is now the least recently used
+
+    m_cache.getBand( m_image, 1, 0, BAND_SIZE, 1 );
+
+    EXPECT_EQ( 3 * BAND_SIZE, m_cache.getSize() );
+    EXPECT_TRUE( m_cache.hasBand( m_image, 0, 0 ) );
+    EXPECT_FALSE( m_cache.hasBand( m_image, 0, 1 ) );
+    EXPECT_TRUE( m_cache.hasBand( m_otherImage, 0, 0 ) );
+    EXPECT_TRUE( m_cache.hasBand( m_image, 1, 0 ) );
+    EXPECT_EQ( 1ULL, m_cache.getStatistics( m_image ).numEvictions );
+    EXPECT_EQ( 0ULL, m_cache.getStatistics( m_otherImage ).numEvictions );
+}
+
+TEST_F( TestDecodedDataCache, evictedBandStaysValidWhileHeld )
+{
+    std::shared_ptr<DecodedBand> band = m_cache.getBand( m_image, 0, 0, BAND_SIZE, 1 );
+    band->pixels.assign( BAND_SIZE, 'x' );
+    band->blockStates[0] = DecodedBand::DONE;
+
+    m_cache.setMaxSize( BAND_SIZE / 2 );
+
+    EXPECT_FALSE( m_cache.hasBand( m_image, 0, 0 ) );
+    EXPECT_EQ( 0U, m_cache.getSize() );
+    EXPECT_EQ( 'x', band->pixels.back() );
+    EXPECT_NE( band, m_cache.getBand( m_image, 0, 0, BAND_SIZE, 1 ) );
+}
+
+TEST_F( TestDecodedDataCache, unlimitedBudget )
+{
+    m_cache.setMaxSize( 0 );
+    for( unsigned int i = 0; i < 10; ++i )
+        m_cache.getBand( m_image, 0, i, BAND_SIZE, 1 );
+
+    EXPECT_EQ( 10 * BAND_SIZE, m_cache.getSize() );
+    EXPECT_EQ( 0ULL, m_cache.getStatistics().numEvictions );
+}
+
+TEST_F( TestDecodedDataCache, removeImage )
+{
+    m_cache.getBand( m_image, 0, 0, BAND_SIZE, 1 );
+    m_cache.getBand( m_image, 2, 0, BAND_SIZE, 1 );
+    m_cache.getBand( m_otherImage, 0, 0, BAND_SIZE, 1 );
+
+    m_cache.removeImage( m_image );
+
+    EXPECT_EQ( BAND_SIZE, m_cache.getSize() );
+    EXPECT_FALSE( m_cache.hasBand( m_image, 0, 0 ) );
+    EXPECT_FALSE( m_cache.hasBand( m_image, 2, 0 ) );
+    EXPECT_TRUE( m_cache.hasBand( m_otherImage, 0, 0 ) );
+    EXPECT_EQ( 2ULL, m_cache.getStatistics( m_image ).numMisses );
+    EXPECT_EQ( 0ULL, m_cache.getStatistics( m_image ).numEvictions );
+
+    m_cache.releaseImageId( m_image );
+    EXPECT_EQ( 0ULL, m_cache.getStatistics( m_image ).numMisses );
+}
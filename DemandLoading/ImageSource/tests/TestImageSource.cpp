@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -23,8 +23,11 @@
 #include <vector_functions.h> // CUDA
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <cstring>
 #include <string>
+#include <thread>
 #include <vector>
 
 using namespace imageSource;
@@ -183,6 +186,170 @@ INSTANTIATE_READER_TESTS( ReadFineTileFloat )
 
 //------------------------------------------------------------------------------
 
+template <class ReaderType>
+void runReadTilesMatchesReadTile()
+{
+    ReaderType  floatReader( getSourceDir() + "/Textures/TiledMipMappedFloat.exr" );
+    TextureInfo floatInfo = {};
+    ASSERT_NO_THROW( floatReader.open( &floatInfo ) );
+
+    const unsigned int mipLevel = 0;
+    const unsigned int width    = floatReader.getTileWidth();
+    const unsigned int height   = floatReader.getTileHeight();
+
+    // Request the tiles out of file order.
+    const std::vector<Tile>          tiles{ { 1, 1, width, height }, { 0, 0, width, height }, { 1, 0, width, height } };
+    std::vector<std::vector<float4>> batched( tiles.size(), std::vector<float4>( width * height ) );
+    std::vector<char*>               dest;
+    for( std::vector<float4>& texels : batched )
+        dest.push_back( reinterpret_cast<char*>( texels.data() ) );
+    bool satisfied = false;
+    ASSERT_NO_THROW( satisfied = floatReader.readTiles( dest.data(), mipLevel, tiles.data(), static_cast<unsigned int>( tiles.size() ), nullptr ) );
+    EXPECT_TRUE( satisfied );
+
+    for( size_t i = 0; i < tiles.size(); ++i )
+    {
+        std::vector<float4> texels( width * height );
+        ASSERT_NO_THROW( floatReader.readTile( reinterpret_cast<char*>( texels.data() ), mipLevel, tiles[i], nullptr ) );
+        for( unsigned int y = 0; y < height; ++y )
+        {
+            for( unsigned int x = 0; x < width; ++x )
+                EXPECT_EQ( getTexel( x, y, texels, width ), getTexel( x, y, batched[i], width ) );
+        }
+    }
+}
+
+INSTANTIATE_READER_TESTS( ReadTilesMatchesReadTile )
+
+//------------------------------------------------------------------------------
+
+template <class ReaderType>
+void runReadTilesConcurrently()
+{
+    ReaderType  floatReader( getSourceDir() + "/Textures/TiledMipMappedFloat.exr" );
+    TextureInfo floatInfo = {};
+    ASSERT_NO_THROW( floatReader.open( &floatInfo ) );
+
+    const unsigned int mipLevel  = 0;
+    const unsigned int width     = floatReader.getTileWidth();
+    const unsigned int height    = floatReader.getTileHeight();
+    const unsigned int numTilesX = floatInfo.width / width;
+    const unsigned int numTilesY = floatInfo.height / height;
+    const size_t       tileSize  = width * height * sizeof( float4 );
+
+    // Read each tile serially for reference.
+    std::vector<std::vector<char>> expected( numTilesX * numTilesY, std::vector<char>( tileSize ) );
+    for( unsigned int i = 0; i < numTilesX * numTilesY; ++i )
+        ASSERT_NO_THROW( floatReader.readTile( expected[i].data(), mipLevel, { i % numTilesX, i / numTilesX, width, height }, nullptr ) );
+
+    // Read the tiles from several threads at once, each starting at a different tile.
+    const unsigned int       numThreads = 4;
+    std::vector<unsigned>    numBad( numThreads );
+    std::vector<std::thread> threads;
+    for( unsigned int t = 0; t < numThreads; ++t )
+    {
+        threads.emplace_back( [&, t] {
+            std::vector<char> tile( tileSize );
+            for( unsigned int j = 0; j < 4 * numTilesX * numTilesY; ++j )
+            {
+                const unsigned int i = ( t + j ) % ( numTilesX * numTilesY );
+                floatReader.readTile( tile.data(), mipLevel, { i % numTilesX, i / numTilesX, width, height }, nullptr );
+                if( std::memcmp( tile.data(), expected[i].data(), tileSize ) != 0 )
+                    ++numBad[t];
+            }
+        } );
+    }
+    for( std::thread& thread : threads )
+        thread.join();
+
+    for( unsigned int t = 0; t < numThreads; ++t )
+        EXPECT_EQ( 0U, numBad[t] ) << "thread " << t;
+}
+
+INSTANTIATE_READER_TESTS( ReadTilesConcurrently )
+
+#if OTK_USE_OPENEXR
+TEST_F( TestEXRReader, ReadTilesConcurrentlyWithinSharedFileLimit )
+{
+    // Two textures read concurrently share a limit of one additional file instance, and the
+    // instances are returned to the limit when the textures are closed.
+    EXRReader::setMaxSharedTiledInputFiles( 1 );
+    {
+        EXRReader   floatReader( getSourceDir() + "/Textures/TiledMipMappedFloat.exr" );
+        EXRReader   halfReader( getSourceDir() + "/Textures/TiledMipMappedHalf.exr" );
+        EXRReader*  readers[2] = { &floatReader, &halfReader };
+        TextureInfo info[2]    = {};
+        ASSERT_NO_THROW( floatReader.open( &info[0] ) );
+        ASSERT_NO_THROW( halfReader.open( &info[1] ) );
+
+        std::vector<std::thread> threads;
+        for( unsigned int t = 0; t < 4; ++t )
+        {
+            threads.emplace_back( [&, t] {
+                EXRReader&         reader = *readers[t % 2];
+                const unsigned int width  = reader.getTileWidth();
+                const unsigned int height = reader.getTileHeight();
+                std::vector<char>  tile( width * height * sizeof( float4 ) );
+                for( unsigned int j = 0; j < 64; ++j )
+                    EXPECT_TRUE( reader.readTile( tile.data(), 0, { j % ( info[t % 2].width / width ), 0, width, height }, nullptr ) );
+            } );
+        }
+        for( std::thread& thread : threads )
+            thread.join();
+
+        EXPECT_LE( EXRReader::getNumSharedTiledInputFiles(), 1U );
+    }
+    EXPECT_EQ( 0U, EXRReader::getNumSharedTiledInputFiles() );
+    EXRReader::setMaxSharedTiledInputFiles( std::max( 1U, std::thread::hardware_concurrency() ) );
+}
+
+TEST_F( TestEXRReader, CloseWhileReadingTiles )
+{
+    // Reads that overlap a close either fail or read the right data; they must not use a closed
+    // instance of the file.
+    EXRReader   reader( getSourceDir() + "/Textures/TiledMipMappedFloat.exr" );
+    TextureInfo info{};
+    ASSERT_NO_THROW( reader.open( &info ) );
+    const unsigned int width  = reader.getTileWidth();
+    const unsigned int height = reader.getTileHeight();
+    const size_t       tileSize = width * height * sizeof( float4 );
+    std::vector<char>  expected( tileSize );
+    ASSERT_TRUE( reader.readTile( expected.data(), 0, { 0, 0, width, height }, nullptr ) );
+
+    const unsigned int       numThreads = 4;
+    std::vector<unsigned>    numBad( numThreads );
+    std::atomic<bool>        done{ false };
+    std::vector<std::thread> threads;
+    for( unsigned int t = 0; t < numThreads; ++t )
+    {
+        threads.emplace_back( [&, t] {
+            std::vector<char> tile( tileSize );
+            while( !done )
+            {
+                if( reader.readTile( tile.data(), 0, { 0, 0, width, height }, nullptr )
+                    && std::memcmp( tile.data(), expected.data(), tileSize ) != 0 )
+                    ++numBad[t];
+            }
+        } );
+    }
+    for( unsigned int i = 0; i < 100; ++i )
+    {
+        reader.close();
+        reader.open( nullptr );
+    }
+    done = true;
+    for( std::thread& thread : threads )
+        thread.join();
+    reader.close();
+
+    for( unsigned int t = 0; t < numThreads; ++t )
+        EXPECT_EQ( 0U, numBad[t] ) << "thread " << t;
+    EXPECT_EQ( 0U, EXRReader::getNumSharedTiledInputFiles() );
+}
+#endif
+
+//------------------------------------------------------------------------------
+
 template <class ReaderType>
 void runReadFineScanlineFloat()
 {
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -8,7 +8,14 @@
 #include <OptiXToolkit/ImageSource/ImageSourceCache.h>
 #include <OptiXToolkit/ImageSource/TiledImageSource.h>
 
-#include <gtest/gtest.h>
+#include <OptiXToolkit/ImageSource/Testing/MockImageSource.h>
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
 
 using namespace imageSource;
 
@@ -58,3 +65,167 @@ TEST_F( TestImageSourceCache, setAdaptedReturnsAdapted )
     EXPECT_EQ( adapted, image );
 }
 #endif
+
+namespace {
+
+using MockImageSourcePtr = std::shared_ptr<otk::testing::MockImageSource>;
+
+// The readers are mocks that check that they are only read while they are open.
+class TestImageSourceCacheOpenReaders : public testing::Test
+{
+  protected:
+    void SetUp() override;
+
+    std::shared_ptr<ImageSource> get( const std::string& path ) { return m_cache.get( path ); }
+    bool                         readTile( const std::string& path );
+
+    TextureInfo                               m_info{};
+    std::map<std::string, MockImageSourcePtr> m_readers;
+    std::map<std::string, std::atomic<bool>>  m_readerOpen;
+    ImageSourceCache m_cache{ 2, [this]( const std::string& path ) { return std::shared_ptr<ImageSource>( m_readers[path] ); } };
+};
+
+void TestImageSourceCacheOpenReaders::SetUp()
+{
+    m_info.width        = 16;
+    m_info.height       = 16;
+    m_info.format       = CU_AD_FORMAT_UNSIGNED_INT8;
+    m_info.numChannels  = 4;
+    m_info.numMipLevels = 1;
+    m_info.isValid      = true;
+    m_info.isTiled      = true;
+    for( const char* path : { "a", "b", "c" } )
+    {
+        MockImageSourcePtr reader = std::make_shared<otk::testing::MockImageSource>();
+        std::atomic<bool>& isOpen = m_readerOpen[path];
+        isOpen                    = false;
+        EXPECT_CALL( *reader, open( testing::_ ) ).WillRepeatedly( [this, &isOpen]( TextureInfo* info ) {
+            EXPECT_FALSE( isOpen.exchange( true ) );
+            *info = m_info;
+        } );
+        EXPECT_CALL( *reader, close() ).WillRepeatedly( [&isOpen] { EXPECT_TRUE( isOpen.exchange( false ) ); } );
+        EXPECT_CALL( *reader, readTile( testing::_, 0, testing::_, testing::_ ) ).WillRepeatedly( [&isOpen]( char*, unsigned, const Tile&, CUstream ) {
+            return isOpen.load();
+        } );
+        EXPECT_CALL( *reader, getNumTilesRead() ).WillRepeatedly( testing::Return( 0ULL ) );
+        EXPECT_CALL( *reader, getNumBytesRead() ).WillRepeatedly( testing::Return( 0ULL ) );
+        EXPECT_CALL( *reader, getTotalReadTime() ).WillRepeatedly( testing::Return( 0.0 ) );
+        m_readers[path] = reader;
+    }
+}
+
+bool TestImageSourceCacheOpenReaders::readTile( const std::string& path )
+{
+    char dest[4 * 16 * 16];
+    return get( path )->readTile( dest, 0, Tile{ 0, 0, 16, 16 }, CUstream{} );
+}
+
+}  // namespace
+
+TEST_F( TestImageSourceCacheOpenReaders, closesLeastRecentlyUsedReaders )
+{
+    TextureInfo info{};
+    get( "a" )->open( &info );
+    get( "b" )->open( nullptr );
+    get( "c" )->open( nullptr );
+    const CacheStatistics stats = m_cache.getStatistics();
+
+    EXPECT_EQ( m_info, info );
+    EXPECT_FALSE( m_readerOpen["a"] );
+    EXPECT_TRUE( m_readerOpen["b"] );
+    EXPECT_TRUE( m_readerOpen["c"] );
+    EXPECT_TRUE( get( "a" )->isOpen() );
+    EXPECT_EQ( m_info, get( "a" )->getInfo() );
+    EXPECT_EQ( 2U, stats.numOpenReaders );
+    EXPECT_EQ( 3ULL, stats.numReaderOpens );
+    EXPECT_EQ( 1ULL, stats.numReaderCloses );
+}
+
+TEST_F( TestImageSourceCacheOpenReaders, readReopensClosedReader )
+{
+    get( "a" )->open( nullptr );
+    get( "b" )->open( nullptr );
+    get( "c" )->open( nullptr );
+
+    EXPECT_TRUE( readTile( "a" ) );
+
+    EXPECT_TRUE( m_readerOpen["a"] );
+    EXPECT_FALSE( m_readerOpen["b"] );
+    EXPECT_TRUE( m_readerOpen["c"] );
+    EXPECT_EQ( 4ULL, m_cache.getStatistics().numReaderOpens );
+}
+
+TEST_F( TestImageSourceCacheOpenReaders, readMarksReaderAsUsed )
+{
+    get( "a" )->open( nullptr );
+    get( "b" )->open( nullptr );
+
+    EXPECT_TRUE( readTile( "a" ) );
+    get( "c" )->open( nullptr );
+
+    EXPECT_TRUE( m_readerOpen["a"] );
+    EXPECT_FALSE( m_readerOpen["b"] );
+}
+
+TEST_F( TestImageSourceCacheOpenReaders, closeReleasesReader )
+{
+    get( "a" )->open( nullptr );
+    get( "b" )->open( nullptr );
+
+    get( "a" )->close();
+    get( "c" )->open( nullptr );
+
+    EXPECT_FALSE( get( "a" )->isOpen() );
+    EXPECT_TRUE( m_readerOpen["b"] );
+    EXPECT_EQ( 0ULL, m_cache.getStatistics().numReaderCloses );
+}
+
+TEST_F( TestImageSourceCacheOpenReaders, setMaxOpenReaders )
+{
+    get( "a" )->open( nullptr );
+    get( "b" )->open( nullptr );
+
+    m_cache.setMaxOpenReaders( 1 );
+
+    EXPECT_FALSE( m_readerOpen["a"] );
+    EXPECT_TRUE( m_readerOpen["b"] );
+    EXPECT_EQ( 1U, m_cache.getStatistics().numOpenReaders );
+}
+
+TEST_F( TestImageSourceCacheOpenReaders, concurrentReadsOnlyReadOpenReaders )
+{
+    const char* const        paths[] = { "a", "b", "c" };
+    std::atomic<int>         numFailed{ 0 };
+    std::vector<std::thread> threads;
+    for( unsigned int i = 0; i < 4; ++i )
+    {
+        threads.emplace_back( [&, i] {
+            for( unsigned int j = 0; j < 300; ++j )
+                if( !readTile( paths[( i + j ) % 3] ) )
+                    ++numFailed;
+        } );
+    }
+    for( std::thread& thread : threads )
+        thread.join();
+    const CacheStatistics stats = m_cache.getStatistics();
+
+    EXPECT_EQ( 0, numFailed );
+    EXPECT_LE( stats.numOpenReaders, 3U );
+    EXPECT_EQ( stats.numReaderOpens - stats.numReaderCloses, stats.numOpenReaders );
+}
+
+TEST_F( TestImageSourceCacheOpenReaders, forwardsSamplerExtraDataFromOpenReader )
+{
+    const CUdeviceptr        extraData = 0xdeadbeef;
+    const OptixDeviceContext context   = reinterpret_cast<OptixDeviceContext>( static_cast<uintptr_t>( 0x1234 ) );
+    std::atomic<bool>&       isOpen    = m_readerOpen["a"];
+    EXPECT_CALL( *m_readers["a"], getSamplerExtraData( context ) ).WillOnce( [&isOpen, extraData]( OptixDeviceContext ) {
+        EXPECT_TRUE( isOpen.load() );
+        return extraData;
+    } );
+    get( "a" )->open( nullptr );
+    get( "b" )->open( nullptr );
+    get( "c" )->open( nullptr );
+
+    EXPECT_EQ( extraData, get( "a" )->getSamplerExtraData( context ) );
+}
@@ -12,6 +12,8 @@
 #include <vector_functions.h>
 
 #include <algorithm>
+#include <thread>
+#include <vector>
 
 using namespace testing;
 using namespace imageSource;
@@ -35,8 +37,9 @@ class TestMipMapImageSource : public Test
     void SetUp() override;
 
     ExpectationSet expectCreate();
-    void           create();
+    void           create( MipMapFilter filter = MipMapFilter::BOX, bool isSrgb = false );
     ExpectationSet expectOpen();
+    void           expectReadBaseImage( const ExpectationSet& open, unsigned char ( *pixelValue )( unsigned int x, unsigned int y ) );
 
     MockImageSourcePtr       m_baseImage{std::make_shared<otk::testing::MockImageSource>()};
     imageSource::TextureInfo m_baseInfo{};
@@ -62,9 +65,9 @@ ExpectationSet TestMipMapImageSource::expectCreate()
     return create;
 }
 
-void TestMipMapImageSource::create()
+void TestMipMapImageSource::create( MipMapFilter filter, bool isSrgb )
 {
-    m_mipMapImage = std::make_shared<imageSource::MipMapImageSource>( m_baseImage );
+    m_mipMapImage = std::make_shared<imageSource::MipMapImageSource>( m_baseImage, filter, isSrgb );
 }
 
 ExpectationSet TestMipMapImageSource::expectOpen()
@@ -76,6 +79,26 @@ ExpectationSet TestMipMapImageSource::expectOpen()
     return open;
 }
 
+// Expect the base image to be read once, filling every channel of each pixel with the given value.
+void TestMipMapImageSource::expectReadBaseImage( const ExpectationSet& open, unsigned char ( *pixelValue )( unsigned int x, unsigned int y ) )
+{
+    const unsigned int pixelSizeInBytes{ getBitsPerPixel( m_baseInfo ) / BITS_PER_BYTE };
+    const auto fillMipLevel = [=]( char* dest, unsigned int /*mipLevel*/, unsigned int expectedWidth,
+                                   unsigned int expectedHeight, CUstream /*stream*/ ) {
+        for( unsigned int y = 0; y < expectedHeight; ++y )
+        {
+            for( unsigned int x = 0; x < expectedWidth; ++x )
+            {
+                std::fill( &dest[0], &dest[pixelSizeInBytes], static_cast<char>( pixelValue( x, y ) ) );
+                dest += pixelSizeInBytes;
+            }
+        }
+    };
+    EXPECT_CALL( *m_baseImage, readMipLevel( NotNull(), 0, m_baseInfo.width, m_baseInfo.height, m_stream ) )
+        .After( open )
+        .WillOnce( DoAll( fillMipLevel, Return( true ) ) );
+}
+
 }  // namespace
 
 TEST_F( TestMipMapImageSource, create )
@@ -188,6 +211,50 @@ TEST_F( TestMipMapImageSource, readTileMipLevelZeroSourcesDataFromReadMipLevelZe
     }
 }
 
+TEST_F( TestMipMapImageSource, readTileMipLevelZeroReadsOnlyItsRowsOfTiledBase )
+{
+    const unsigned int tileSize{ 64 };
+    const unsigned int pixelSizeInBytes{ getBitsPerPixel( m_baseInfo ) / BITS_PER_BYTE };
+    const auto fillTile = [=]( char* dest, unsigned int /*mipLevel*/, const Tile& tile, CUstream /*stream*/ ) {
+        for( unsigned int y = 0; y < tile.height; ++y )
+        {
+            for( unsigned int x = 0; x < tile.width; ++x )
+            {
+                const char val = static_cast<char>( ( tile.x * tile.width + x + tile.y * tile.height + y ) % 256 );
+                std::fill( &dest[0], &dest[pixelSizeInBytes], val );
+                dest += pixelSizeInBytes;
+            }
+        }
+    };
+    m_baseInfo.isTiled = true;
+    ExpectationSet open{ expectOpen() };
+    EXPECT_CALL( *m_baseImage, getTileWidth() ).WillRepeatedly( Return( tileSize ) );
+    EXPECT_CALL( *m_baseImage, getTileHeight() ).WillRepeatedly( Return( tileSize ) );
+    EXPECT_CALL( *m_baseImage, readTile( NotNull(), 0, Field( &Tile::y, 1 ), m_stream ) )
+        .Times( m_baseInfo.width / tileSize )
+        .After( open )
+        .WillRepeatedly( DoAll( fillTile, Return( true ) ) );
+    EXPECT_CALL( *m_baseImage, readMipLevel( _, _, _, _, _ ) ).Times( 0 );
+    create();
+    m_mipMapImage->open( nullptr );
+
+    // Only the row of base tiles that holds the tile is read, and it is read once.
+    std::vector<char> dest( tileSize * tileSize * pixelSizeInBytes );
+    ASSERT_TRUE( m_mipMapImage->readTile( dest.data(), 0, { 1, 1, tileSize, tileSize }, m_stream ) );
+    ASSERT_TRUE( m_mipMapImage->readTile( dest.data(), 0, { 2, 1, tileSize, tileSize }, m_stream ) );
+
+    for( unsigned int y = 0; y < tileSize; ++y )
+    {
+        for( unsigned int x = 0; x < tileSize; ++x )
+        {
+            for( unsigned int c = 0; c < pixelSizeInBytes; ++c )
+            {
+                EXPECT_EQ( static_cast<char>( ( 2 * tileSize + x + tileSize + y ) % 256 ), dest[( y * tileSize + x ) * pixelSizeInBytes + c] );
+            }
+        }
+    }
+}
+
 TEST_F( TestMipMapImageSource, readTileMipLevelOneSourcesDataFromMipLevelZero )
 {
     ExpectationSet     open{ expectOpen() };
@@ -277,6 +344,120 @@ TEST_F( TestMipMapImageSource, tracksTileReadCount )
     EXPECT_EQ( 2ULL, m_mipMapImage->getNumTilesRead() );
 }
 
+TEST_F( TestMipMapImageSource, boxFilterAveragesPixels )
+{
+    m_baseInfo.width       = 4;
+    m_baseInfo.height      = 4;
+    m_baseInfo.numChannels = 4;
+    ExpectationSet open{ expectOpen() };
+    expectReadBaseImage( open, []( unsigned int x, unsigned int y ) { return static_cast<unsigned char>( x % 2 * 100 + y % 2 * 20 ); } );
+    create();
+    m_mipMapImage->open( nullptr );
+
+    std::vector<unsigned char> dest( 2 * 2 * 4 );
+    ASSERT_TRUE( m_mipMapImage->readMipLevel( reinterpret_cast<char*>( dest.data() ), 1, 2, 2, m_stream ) );
+
+    for( unsigned char value : dest )
+        EXPECT_EQ( 60, value );
+}
+
+TEST_F( TestMipMapImageSource, srgbFilterAveragesInLinearSpace )
+{
+    m_baseInfo.width       = 2;
+    m_baseInfo.height      = 2;
+    m_baseInfo.numChannels = 4;
+    ExpectationSet open{ expectOpen() };
+    expectReadBaseImage( open, []( unsigned int x, unsigned int y ) { return static_cast<unsigned char>( ( x + y ) % 2 * 255 ); } );
+    create( MipMapFilter::BOX, true );
+    m_mipMapImage->open( nullptr );
+
+    std::vector<unsigned char> dest( 4 );
+    ASSERT_TRUE( m_mipMapImage->readMipLevel( reinterpret_cast<char*>( dest.data() ), 1, 1, 1, m_stream ) );
+
+    // Half intensity is 188 in sRGB.  Alpha is linear.
+    EXPECT_EQ( 188, dest[0] );
+    EXPECT_EQ( 188, dest[1] );
+    EXPECT_EQ( 188, dest[2] );
+    EXPECT_EQ( 128, dest[3] );
+}
+
+TEST_F( TestMipMapImageSource, kaiserFilterPreservesConstantImage )
+{
+    m_baseInfo.numChannels = 4;
+    ExpectationSet open{ expectOpen() };
+    expectReadBaseImage( open, []( unsigned int, unsigned int ) { return static_cast<unsigned char>( 77 ); } );
+    create( MipMapFilter::KAISER );
+    m_mipMapImage->open( nullptr );
+
+    std::vector<unsigned char> dest( 64 * 64 * 4 );
+    ASSERT_TRUE( m_mipMapImage->readTile( reinterpret_cast<char*>( dest.data() ), 2, { 0, 0, 64, 64 }, m_stream ) );
+
+    for( unsigned char value : dest )
+        EXPECT_EQ( 77, value );
+}
+
+TEST_F( TestMipMapImageSource, nonSquareMipLevelsAreAtLeastOnePixel )
+{
+    m_baseInfo.width  = 8;
+    m_baseInfo.height = 2;
+    ExpectationSet open{ expectOpen() };
+    expectReadBaseImage( open, []( unsigned int x, unsigned int ) { return static_cast<unsigned char>( x * 10 ); } );
+    create();
+    imageSource::TextureInfo info{};
+    m_mipMapImage->open( &info );
+    ASSERT_EQ( 4U, info.numMipLevels );
+
+    std::vector<unsigned char> level2( 2 * 4 );
+    ASSERT_TRUE( m_mipMapImage->readMipLevel( reinterpret_cast<char*>( level2.data() ), 2, 2, 1, m_stream ) );
+    EXPECT_EQ( 15, level2[0] );
+    EXPECT_EQ( 55, level2[4] );
+
+    std::vector<unsigned char> level3( 4 );
+    ASSERT_TRUE( m_mipMapImage->readMipLevel( reinterpret_cast<char*>( level3.data() ), 3, 1, 1, m_stream ) );
+    EXPECT_EQ( 35, level3[0] );
+}
+
+TEST_F( TestMipMapImageSource, concurrentReadTilesReadBaseImageOnce )
+{
+    m_baseInfo.width  = 1024;
+    m_baseInfo.height = 1024;
+    ExpectationSet open{ expectOpen() };
+    expectReadBaseImage( open, []( unsigned int x, unsigned int y ) { return static_cast<unsigned char>( x / 4 % 2 * 200 + y / 4 % 2 * 50 ); } );
+    create();
+    m_mipMapImage->open( nullptr );
+
+    // Each thread reads every tile of mip levels 1 and 2, in a different order.
+    const unsigned int       numThreads = 4;
+    std::vector<std::thread> threads;
+    std::vector<int>         failures( numThreads );
+    for( unsigned int t = 0; t < numThreads; ++t )
+    {
+        threads.emplace_back( [this, t, &failures] {
+            std::vector<unsigned char> dest( 64 * 64 * 4 );
+            for( unsigned int mipLevel = 1; mipLevel <= 2; ++mipLevel )
+            {
+                const unsigned int numTiles = 512 >> ( mipLevel - 1 ) >> 6;
+                for( unsigned int i = 0; i < numTiles * numTiles; ++i )
+                {
+                    const unsigned int tile = ( i + t * 7 ) % ( numTiles * numTiles );
+                    if( !m_mipMapImage->readTile( reinterpret_cast<char*>( dest.data() ), mipLevel,
+                                                  { tile % numTiles, tile / numTiles, 64, 64 }, m_stream ) )
+                        ++failures[t];
+                    // 2x2 blocks of each 4x4 checker square average to the checker value.
+                    if( mipLevel == 1 && dest[( 1 * 64 + 2 ) * 4] != 200 )
+                        ++failures[t];
+                }
+            }
+        } );
+    }
+    for( std::thread& thread : threads )
+        thread.join();
+
+    for( int failureCount : failures )
+        EXPECT_EQ( 0, failureCount );
+    EXPECT_EQ( numThreads * ( 64ULL + 16ULL ), m_mipMapImage->getNumTilesRead() );
+}
+
 namespace {
 
 class TestMipMapImageSourcePassThrough : public TestMipMapImageSource
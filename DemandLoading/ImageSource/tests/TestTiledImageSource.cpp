@@ -30,13 +30,13 @@ class TestTiledImageSource : public Test
     void SetUp() override;
 
     ExpectationSet expectCreate();
-    void           create();
+    void           create( std::shared_ptr<DecodedDataCache> cache = nullptr );
     ExpectationSet expectOpen();
     unsigned int   getPixelSizeInBytes() const
     {
         return getBitsPerPixel( m_baseInfo ) / BITS_PER_BYTE;
     }
-    void expectLevelZeroFilledAfter( const ExpectationSet& before );
+    void expectLevelZeroFilledAfter( const ExpectationSet& before, int times = 1 );
 
     MockImageSourcePtr       m_baseImage{std::make_shared<otk::testing::MockImageSource>()};
     imageSource::TextureInfo m_baseInfo{};
@@ -62,9 +62,9 @@ ExpectationSet TestTiledImageSource::expectCreate()
     return expect;
 }
 
-void TestTiledImageSource::create()
+void TestTiledImageSource::create( std::shared_ptr<DecodedDataCache> cache )
 {
-    m_tiledImage = std::make_shared<imageSource::TiledImageSource>( m_baseImage );
+    m_tiledImage = std::make_shared<imageSource::TiledImageSource>( m_baseImage, cache );
 }
 
 ExpectationSet TestTiledImageSource::expectOpen()
@@ -77,7 +77,7 @@ ExpectationSet TestTiledImageSource::expectOpen()
     return open;
 }
 
-void TestTiledImageSource::expectLevelZeroFilledAfter( const ExpectationSet& before )
+void TestTiledImageSource::expectLevelZeroFilledAfter( const ExpectationSet& before, int times )
 {
     const unsigned int mipLevel{ 0 };
     const unsigned int mipLevelWidth{ m_baseInfo.width };
@@ -97,8 +97,9 @@ void TestTiledImageSource::expectLevelZeroFilledAfter( const ExpectationSet& bef
         }
     };
     EXPECT_CALL( *m_baseImage, readMipLevel( NotNull(), mipLevel, mipLevelWidth, mipLevelHeight, m_stream ) )
+        .Times( times )
         .After( before )
-        .WillOnce( DoAll( fillMipLevel, Return( true ) ) );
+        .WillRepeatedly( DoAll( fillMipLevel, Return( true ) ) );
 }
 
 }  // namespace
@@ -370,6 +371,57 @@ TEST_F( TestTiledImageSource, tracksTileReadCount )
     EXPECT_EQ( 2ULL, m_tiledImage->getNumTilesRead() );
 }
 
+TEST_F( TestTiledImageSource, evictedBandsAreReadAgain )
+{
+    // The level has four bands, and the cache holds two.
+    const unsigned int tileSize{ 64 };
+    m_baseInfo.width      = tileSize;
+    m_baseInfo.height     = 4 * tileSize;
+    const size_t   bandSizeInBytes{ tileSize * tileSize * getPixelSizeInBytes() };
+    auto           cache = std::make_shared<DecodedDataCache>( 2 * bandSizeInBytes );
+    ExpectationSet before = expectOpen();
+    create( cache );
+    expectLevelZeroFilledAfter( before, 3 );
+    m_tiledImage->open( nullptr );
+    std::vector<char> dest( tileSize * tileSize * getPixelSizeInBytes() );
+
+    // Reading the level caches the requested band and only as many others as fit.
+    ASSERT_TRUE( m_tiledImage->readTile( dest.data(), 0, { 0, 0, tileSize, tileSize }, m_stream ) );
+    EXPECT_EQ( 2 * bandSizeInBytes, cache->getSize() );
+    ASSERT_TRUE( m_tiledImage->readTile( dest.data(), 0, { 0, 1, tileSize, tileSize }, m_stream ) );
+    ASSERT_TRUE( m_tiledImage->readTile( dest.data(), 0, { 0, 3, tileSize, tileSize }, m_stream ) );
+    const DecodedDataStatistics stats = m_tiledImage->getDecodedDataStatistics();
+    EXPECT_EQ( 1ULL, stats.numHits );
+    EXPECT_EQ( 4ULL, stats.numMisses );
+    EXPECT_EQ( 2ULL, stats.numEvictions );
+    EXPECT_EQ( 2 * bandSizeInBytes, cache->getSize() );
+
+    // An evicted band is read again.
+    ASSERT_TRUE( m_tiledImage->readTile( dest.data(), 0, { 0, 0, tileSize, tileSize }, m_stream ) );
+    for( unsigned int y = 0; y < tileSize; ++y )
+    {
+        EXPECT_THAT( dest, hasPixelRowValueSequence( y, tileSize, getPixelSizeInBytes(), y * tileSize ) );
+    }
+    EXPECT_LE( cache->getSize(), 2 * bandSizeInBytes );
+}
+
+TEST_F( TestTiledImageSource, closeRemovesCachedBands )
+{
+    auto           cache = std::make_shared<DecodedDataCache>();
+    ExpectationSet open{ expectOpen() };
+    EXPECT_CALL( *m_baseImage, close() ).After( open );
+    create( cache );
+    expectLevelZeroFilledAfter( open );
+    m_tiledImage->open( nullptr );
+    std::vector<char> dest( 64 * 64 * getPixelSizeInBytes() );
+    ASSERT_TRUE( m_tiledImage->readTile( dest.data(), 0, { 0, 0, 64, 64 }, m_stream ) );
+    EXPECT_NE( 0U, cache->getSize() );
+
+    m_tiledImage->close();
+
+    EXPECT_EQ( 0U, cache->getSize() );
+}
+
 namespace {
 
 class TestTiledImageSourcePassThrough : public TestTiledImageSource
@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+// Benchmark the suballocators that back MemoryPool, using the allocation patterns of the demand
+// loading library: fixed-size tiles (FixedSuballocator), short-lived staging buffers that are
+// released together (RingSuballocator), and mixed sizes with random lifetimes (HeapSuballocator,
+// TlsfSuballocator and BinnedSuballocator).  The suballocators only do address arithmetic, so no GPU is required.
+
+#include <OptiXToolkit/Memory/BinnedSuballocator.h>
+#include <OptiXToolkit/Memory/FixedSuballocator.h>
+#include <OptiXToolkit/Memory/HeapSuballocator.h>
+#include <OptiXToolkit/Memory/RingSuballocator.h>
+#include <OptiXToolkit/Memory/TlsfSuballocator.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace otk;
+
+namespace {
+
+const uint64_t ARENA_SIZE = 1ULL << 30;
+
+// Allocation sizes between 16 bytes and 64 KiB, favoring small sizes.
+std::vector<uint64_t> makeSizes( size_t numAllocs )
+{
+    std::mt19937                            rng( 42 );
+    std::uniform_int_distribution<unsigned> log2Size( 4, 16 );
+    std::vector<uint64_t>                   sizes( numAllocs );
+    for( uint64_t& size : sizes )
+        size = 1ULL << std::min( log2Size( rng ), log2Size( rng ) );
+    return sizes;
+}
+
+// Allocate the given sizes, then free them in random order.
+template <class Suballocator>
+void allocFreeRandom( Suballocator& suballocator, const std::vector<uint64_t>& sizes, std::vector<MemoryBlockDesc>& blocks, std::mt19937& rng )
+{
+    blocks.clear();
+    for( uint64_t size : sizes )
+        blocks.push_back( suballocator.alloc( size, 16 ) );
+    std::shuffle( blocks.begin(), blocks.end(), rng );
+    for( const MemoryBlockDesc& block : blocks )
+        suballocator.free( block );
+}
+
+template <class Suballocator>
+void BM_VariableSizeAllocFree( benchmark::State& state )
+{
+    const std::vector<uint64_t>  sizes = makeSizes( state.range( 0 ) );
+    std::vector<MemoryBlockDesc> blocks;
+    std::mt19937                 rng( 7 );
+    Suballocator                 suballocator;
+    suballocator.track( 0, ARENA_SIZE );
+    for( auto _ : state )
+        allocFreeRandom( suballocator, sizes, blocks, rng );
+    state.SetItemsProcessed( state.iterations() * sizes.size() );
+}
+
+// Keep the heap half full of long-lived blocks, and churn the rest, which fragments the free list.
+template <class Suballocator>
+void BM_VariableSizeFragmented( benchmark::State& state )
+{
+    const std::vector<uint64_t>  sizes = makeSizes( state.range( 0 ) );
+    std::vector<MemoryBlockDesc> blocks;
+    std::mt19937                 rng( 7 );
+    Suballocator                 suballocator;
+    suballocator.track( 0, ARENA_SIZE );
+    for( size_t i = 0; i < sizes.size(); ++i )
+    {
+        MemoryBlockDesc block = suballocator.alloc( sizes[i], 16 );
+        if( i % 2 == 0 )
+            suballocator.free( block );
+    }
+    for( auto _ : state )
+        allocFreeRandom( suballocator, sizes, blocks, rng );
+    state.SetItemsProcessed( state.iterations() * sizes.size() );
+}
+
+// Fill the heap with small blocks and free every other one, leaving many holes too small for the
+// tile-sized blocks that are then allocated and freed.  A first-fit search visits every hole.
+template <class Suballocator>
+void BM_VariableSizeSmallHoles( benchmark::State& state )
+{
+    const uint64_t holeSize = 256;
+    const uint64_t tileSize = 64 * 1024;
+    const uint64_t numHoles = state.range( 0 );
+    Suballocator   suballocator;
+    suballocator.track( 0, 2 * numHoles * holeSize + tileSize );
+    std::vector<MemoryBlockDesc> blocks;
+    for( uint64_t i = 0; i < 2 * numHoles; ++i )
+        blocks.push_back( suballocator.alloc( holeSize, 1 ) );
+    for( uint64_t i = 0; i < blocks.size(); i += 2 )
+        suballocator.free( blocks[i] );
+    for( auto _ : state )
+    {
+        MemoryBlockDesc block = suballocator.alloc( tileSize, tileSize );
+        benchmark::DoNotOptimize( block );
+        suballocator.free( block );
+    }
+    state.SetItemsProcessed( state.iterations() );
+}
+
+void BM_RingSuballocatorAllocFreeAll( benchmark::State& state )
+{
+    const std::vector<uint64_t> sizes = makeSizes( state.range( 0 ) );
+    RingSuballocator            suballocator( ARENA_SIZE / 16 );
+    suballocator.track( 0, ARENA_SIZE );
+    for( auto _ : state )
+    {
+        for( uint64_t size : sizes )
+            benchmark::DoNotOptimize( suballocator.alloc( size, 16 ) );
+        suballocator.freeAll();
+    }
+    state.SetItemsProcessed( state.iterations() * sizes.size() );
+}
+
+void BM_RingSuballocatorAllocFree( benchmark::State& state )
+{
+    const std::vector<uint64_t>  sizes = makeSizes( state.range( 0 ) );
+    std::vector<MemoryBlockDesc> blocks;
+    RingSuballocator             suballocator( ARENA_SIZE / 16 );
+    suballocator.track( 0, ARENA_SIZE );
+    for( auto _ : state )
+    {
+        // Free in allocation order, like staging buffers that are released as transfers finish.
+        blocks.clear();
+        for( uint64_t size : sizes )
+            blocks.push_back( suballocator.alloc( size, 16 ) );
+        for( const MemoryBlockDesc& block : blocks )
+            suballocator.free( block );
+    }
+    state.SetItemsProcessed( state.iterations() * sizes.size() );
+}
+
+void BM_FixedSuballocatorAllocFree( benchmark::State& state )
+{
+    const size_t          numItems = state.range( 0 );
+    const uint64_t        itemSize = 64 * 1024;
+    std::vector<uint64_t> items( numItems );
+    std::mt19937          rng( 7 );
+    FixedSuballocator     suballocator( itemSize, itemSize );
+    suballocator.track( 0, numItems * itemSize );
+    for( auto _ : state )
+    {
+        for( uint64_t& item : items )
+            item = suballocator.allocItem();
+        std::shuffle( items.begin(), items.end(), rng );
+        for( uint64_t item : items )
+            suballocator.freeItem( item );
+    }
+    state.SetItemsProcessed( state.iterations() * numItems );
+}
+
+void BM_BinnedSuballocatorAllocFree( benchmark::State& state )
+{
+    const std::vector<uint64_t>  sizes = makeSizes( state.range( 0 ) );
+    std::vector<MemoryBlockDesc> blocks;
+    std::mt19937                 rng( 7 );
+    BinnedSuballocator           suballocator( {16, 32, 64, 128, 256, 512}, {256, 256, 128, 128, 64, 64} );
+    suballocator.track( 0, ARENA_SIZE );
+    for( auto _ : state )
+        allocFreeRandom( suballocator, sizes, blocks, rng );
+    state.SetItemsProcessed( state.iterations() * sizes.size() );
+}
+
+}  // namespace
+
+BENCHMARK_TEMPLATE( BM_VariableSizeAllocFree, HeapSuballocator )->RangeMultiplier( 8 )->Range( 64, 1 << 15 );
+BENCHMARK_TEMPLATE( BM_VariableSizeAllocFree, TlsfSuballocator )->RangeMultiplier( 8 )->Range( 64, 1 << 15 );
+BENCHMARK_TEMPLATE( BM_VariableSizeFragmented, HeapSuballocator )->RangeMultiplier( 8 )->Range( 64, 1 << 15 );
+BENCHMARK_TEMPLATE( BM_VariableSizeFragmented, TlsfSuballocator )->RangeMultiplier( 8 )->Range( 64, 1 << 15 );
+BENCHMARK_TEMPLATE( BM_VariableSizeSmallHoles, HeapSuballocator )->RangeMultiplier( 8 )->Range( 64, 1 << 15 );
+BENCHMARK_TEMPLATE( BM_VariableSizeSmallHoles, TlsfSuballocator )->RangeMultiplier( 8 )->Range( 64, 1 << 15 );
+BENCHMARK( BM_RingSuballocatorAllocFreeAll )->RangeMultiplier( 8 )->Range( 64, 1 << 15 );
+BENCHMARK( BM_RingSuballocatorAllocFree )->RangeMultiplier( 8 )->Range( 64, 1 << 15 );
+BENCHMARK( BM_FixedSuballocatorAllocFree )->RangeMultiplier( 8 )->Range( 64, 1 << 15 );
+BENCHMARK( BM_BinnedSuballocatorAllocFree )->RangeMultiplier( 8 )->Range( 64, 1 << 15 );
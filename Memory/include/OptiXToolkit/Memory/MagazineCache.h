@@ -0,0 +1,272 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <OptiXToolkit/Error/ErrorCheck.h>
+#include <OptiXToolkit/Error/cuErrorCheck.h>
+#include <OptiXToolkit/Memory/MemoryBlockDesc.h>
+#include <OptiXToolkit/Memory/MemoryPool.h>
+
+#include <cuda.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace otk {
+
+// MagazineCache is a per-thread cache of fixed-size blocks in front of a MemoryPool, such as
+// tile-sized transfer buffers. Each thread that uses the cache gets its own magazine of free
+// blocks, so alloc and free normally don't touch the pool's mutex. When a magazine runs empty
+// it is refilled with a batch of blocks from the pool, and when it overflows, a batch of blocks
+// is returned to the pool, each under a single lock.
+//
+// Blocks freed with freeAsync are held by the freeing thread until their stream has passed the
+// free, and are then reused by that thread. Blocks in magazines are counted as allocated by the
+// pool, so the cache reports them separately in cachedSpace(), and currentFreeSpace() adds them
+// back in. The pool must outlive the cache. Only the cache's alloc flushes the magazines, so the
+// pool should not be shared with other allocations, which could fail while magazines hold free blocks.
+//
+template <class Allocator, class SubAllocator>
+class MagazineCache
+{
+  public:
+    /// Cache blocks of blockSize bytes with the given alignment. Each thread's magazine holds up to
+    /// magazineSize free blocks, and blocks move to and from the pool magazineSize/2 at a time.
+    MagazineCache( MemoryPool<Allocator, SubAllocator>* pool, uint64_t blockSize, uint64_t alignment = 1, unsigned int magazineSize = 16 )
+        : m_pool( pool )
+        , m_blockSize( blockSize )
+        , m_alignment( alignment )
+        , m_magazineSize( std::max( magazineSize, 2u ) )
+        , m_id( nextCacheId() )
+    {
+        OTK_ASSERT( m_pool != nullptr && m_blockSize > 0 );
+        OTK_ERROR_CHECK( cuCtxGetCurrent( &m_context ) );
+        OTK_ASSERT( m_context != nullptr );
+    }
+
+    /// Destructor. Returns all the cached blocks to the pool.
+    ~MagazineCache()
+    {
+        OTK_ERROR_CHECK_NOTHROW( cuCtxPushCurrent( m_context ) );
+        try
+        {
+            flush();
+            for( const std::shared_ptr<Magazine>& magazine : m_magazines )
+            {
+                for( CUevent event : magazine->events )
+                    OTK_ERROR_CHECK( cuEventDestroy( event ) );
+            }
+        }
+        catch( ... )
+        {
+        }
+        CUcontext ignored;
+        OTK_ERROR_CHECK_NOTHROW( cuCtxPopCurrent( &ignored ) );
+    }
+
+    /// Allocate a block of blockSize() bytes. Returns BAD_ADDR on failure.
+    MemoryBlockDesc alloc( CUstream stream = 0 )
+    {
+        {
+            Magazine&                    magazine = getMagazine();
+            std::unique_lock<std::mutex> lock( magazine.mutex );
+            if( magazine.blocks.empty() )
+                reclaimPendingBlocks( magazine, false );
+            if( magazine.blocks.empty() )
+            {
+                const unsigned int numBlocks = m_pool->allocBlocks( m_blockSize, m_alignment, m_magazineSize / 2, magazine.blocks, stream );
+                m_cachedSpace += numBlocks * m_blockSize;
+            }
+            if( !magazine.blocks.empty() )
+            {
+                MemoryBlockDesc block = magazine.blocks.back();
+                magazine.blocks.pop_back();
+                m_cachedSpace -= m_blockSize;
+                return block;
+            }
+        }
+
+        // The pool is exhausted, possibly because other threads are holding blocks in their
+        // magazines. Return them to the pool and try once more.
+        flush();
+        return m_pool->alloc( m_blockSize, m_alignment, stream );
+    }
+
+    /// Free a block immediately.
+    void free( const MemoryBlockDesc& block )
+    {
+        Magazine&                    magazine = getMagazine();
+        std::unique_lock<std::mutex> lock( magazine.mutex );
+        magazine.blocks.push_back( block );
+        m_cachedSpace += m_blockSize;
+        if( magazine.blocks.size() > m_magazineSize )
+            returnBlocks( magazine, m_magazineSize / 2 );
+    }
+
+    /// Free a block after operations currently in the stream have finished.
+    void freeAsync( const MemoryBlockDesc& block, CUstream stream )
+    {
+        OTK_ASSERT_CONTEXT_MATCHES_STREAM( stream );
+
+        // Events are recycled, so they must all belong to the cache's context.
+        CUcontext context;
+        OTK_ERROR_CHECK( cuCtxGetCurrent( &context ) );
+        if( context != m_context )
+        {
+            m_pool->freeAsync( block, stream );
+            return;
+        }
+
+        Magazine&                    magazine = getMagazine();
+        std::unique_lock<std::mutex> lock( magazine.mutex );
+        if( magazine.pendingBlocks.size() >= m_magazineSize )
+            reclaimPendingBlocks( magazine, false );
+        if( magazine.pendingBlocks.size() >= m_magazineSize )
+        {
+            lock.unlock();
+            m_pool->freeAsync( block, stream );
+            return;
+        }
+
+        CUevent event;
+        if( magazine.events.empty() )
+        {
+            OTK_ERROR_CHECK( cuEventCreate( &event, CU_EVENT_DEFAULT ) );
+        }
+        else
+        {
+            event = magazine.events.back();
+            magazine.events.pop_back();
+        }
+        OTK_ERROR_CHECK( cuEventRecord( event, stream ) );
+        magazine.pendingBlocks.push_back( PendingBlock{block, event} );
+    }
+
+    /// Return the cached blocks of every thread to the pool, waiting on blocks that were freed
+    /// asynchronously.
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock( m_mutex );
+        for( const std::shared_ptr<Magazine>& magazine : m_magazines )
+        {
+            std::unique_lock<std::mutex> magazineLock( magazine->mutex );
+            reclaimPendingBlocks( *magazine, true );
+            returnBlocks( *magazine, magazine->blocks.size() );
+        }
+    }
+
+    /// Return the size of the blocks given out by the cache.
+    uint64_t blockSize() const { return m_blockSize; }
+
+    /// Return the free space held in the threads' magazines.
+    uint64_t cachedSpace() const { return m_cachedSpace; }
+
+    /// Return the free space in the pool, including the space held in the magazines.
+    uint64_t currentFreeSpace() const { return m_pool->currentFreeSpace() + cachedSpace(); }
+
+    /// Return the amount of memory tracked (free or given out) by the pool.
+    uint64_t trackedSize() const { return m_pool->trackedSize(); }
+
+  private:
+    struct PendingBlock
+    {
+        MemoryBlockDesc block;
+        CUevent         event;
+    };
+
+    struct Magazine
+    {
+        std::mutex                   mutex;          // Only contended while the cache is flushed.
+        std::vector<MemoryBlockDesc> blocks;         // Free blocks, most recently freed last.
+        std::deque<PendingBlock>     pendingBlocks;  // Blocks freed asynchronously, in the order freed.
+        std::vector<CUevent>         events;         // Events for reuse by freeAsync.
+    };
+
+    struct ThreadMagazine
+    {
+        uint64_t                cacheId;
+        Magazine*               magazine;
+        std::weak_ptr<Magazine> owner;
+    };
+
+    MemoryPool<Allocator, SubAllocator>* m_pool;
+    uint64_t                             m_blockSize;
+    uint64_t                             m_alignment;
+    unsigned int                         m_magazineSize;
+    uint64_t                             m_id;  // Distinguishes caches in the threads' magazine lists.
+    CUcontext                            m_context;
+    std::atomic<uint64_t>                m_cachedSpace{0};
+
+    std::mutex                             m_mutex;  // Guards m_magazines.
+    std::vector<std::shared_ptr<Magazine>> m_magazines;
+
+    static uint64_t nextCacheId()
+    {
+        static std::atomic<uint64_t> nextId( 1 );
+        return nextId++;
+    }
+
+    // Get the calling thread's magazine, creating it on first use.
+    Magazine& getMagazine()
+    {
+        static thread_local std::vector<ThreadMagazine> threadMagazines;
+        for( const ThreadMagazine& threadMagazine : threadMagazines )
+        {
+            if( threadMagazine.cacheId == m_id )
+                return *threadMagazine.magazine;
+        }
+
+        // Forget the magazines of caches that have been destroyed.
+        threadMagazines.erase( std::remove_if( threadMagazines.begin(), threadMagazines.end(),
+                                               []( const ThreadMagazine& threadMagazine ) { return threadMagazine.owner.expired(); } ),
+                               threadMagazines.end() );
+
+        std::shared_ptr<Magazine> magazine( new Magazine );
+        {
+            std::unique_lock<std::mutex> lock( m_mutex );
+            m_magazines.push_back( magazine );
+        }
+        threadMagazines.push_back( ThreadMagazine{m_id, magazine.get(), magazine} );
+        return *magazine;
+    }
+
+    // Move asynchronously freed blocks whose events have completed to the free blocks, optionally
+    // waiting on the events. Called with the magazine locked.
+    void reclaimPendingBlocks( Magazine& magazine, bool waitOnEvents )
+    {
+        while( !magazine.pendingBlocks.empty() )
+        {
+            const PendingBlock& pendingBlock = magazine.pendingBlocks.front();
+            if( cuEventQuery( pendingBlock.event ) == CUDA_ERROR_NOT_READY )
+            {
+                if( waitOnEvents )
+                    OTK_ERROR_CHECK( cuEventSynchronize( pendingBlock.event ) );
+                else
+                    break;
+            }
+            magazine.blocks.push_back( pendingBlock.block );
+            magazine.events.push_back( pendingBlock.event );
+            magazine.pendingBlocks.pop_front();
+            m_cachedSpace += m_blockSize;
+        }
+    }
+
+    // Return the least recently freed blocks to the pool. Called with the magazine locked.
+    void returnBlocks( Magazine& magazine, size_t numBlocks )
+    {
+        if( numBlocks == 0 )
+            return;
+        m_pool->freeBlocks( magazine.blocks.data(), numBlocks );
+        magazine.blocks.erase( magazine.blocks.begin(), magazine.blocks.begin() + numBlocks );
+        m_cachedSpace -= numBlocks * m_blockSize;
+    }
+};
+
+}  // namespace otk
@@ -124,54 +124,27 @@ class MemoryPool
 
         std::unique_lock<std::mutex> lock( m_mutex );
         freeStagedBlocks( false );
-        size = ( size ) ? size : m_allocationGranularity;
-
-        // If no suballocator, use the allocator directly
-        if( !m_suballocator )
-            return MemoryBlockDesc{reinterpret_cast<uint64_t>( m_allocator->allocate( size, stream ) ), size, 0};
-
-        // Try to fill the request with the suballocator. If it fails, allocate more memory and try again.
-        MemoryBlockDesc block = m_suballocator->alloc( size, alignment );
-
-        if( ( block.isBad() ) && ( trackedSize() < m_maxSize ) && m_allocator )
-        {
-            // Make sure there is enough headroom (allocatable space) still on the card
-            if( m_headroom > 0 )
-            {
-                size_t freeMem, totalMem;
-                OTK_ERROR_CHECK( cuMemGetInfo( &freeMem, &totalMem ) );
-                if( freeMem < m_headroom )
-                    return block;
-            }
-
-            // Allocate enough memory for the current request at m_allocationGranularity increments.
-            size_t allocSize = m_allocationGranularity * ( ( size + m_allocationGranularity - 1 ) / m_allocationGranularity );
-            void* ptr = m_allocator->allocate( allocSize );
-            if( !ptr )
-                return block;
-            m_allocations.push_back( PtrSize{ptr, allocSize} );
+        return allocBlock( size, alignment, stream, true );
+    }
 
-            if( m_allocator->allocationIsHandle() )
-            {
-                // If the allocator returns handles, they are not pointers in a linear memory space, so
-                // construct an artificial linear memory space for the suballocator to use.
-                m_suballocator->track( getArenaStartAddress( static_cast<uint64_t>( m_allocations.size() - 1 ) ), allocSize );
-            }
-            else
-            {
-                m_suballocator->track( reinterpret_cast<uint64_t>( m_allocations.back().ptr ), allocSize );
-            }
-            block = m_suballocator->alloc( size, alignment );
-        }
+    /// Allocate up to numBlocks blocks with the given size and alignment, taking the lock once for the
+    /// whole batch. The blocks are appended to blocks. Returns the number of blocks allocated.
+    unsigned int allocBlocks( uint64_t size, uint64_t alignment, unsigned int numBlocks, std::vector<MemoryBlockDesc>& blocks, CUstream stream = 0 )
+    {
+        OTK_ASSERT_CONTEXT_MATCHES_STREAM( stream );
 
-        // If the allocation failed, wait on all the staged blocks and try the suballocator one last time
-        if( block.isBad() )
+        std::unique_lock<std::mutex> lock( m_mutex );
+        freeStagedBlocks( false );
+        unsigned int numAllocated = 0;
+        for( ; numAllocated < numBlocks; ++numAllocated )
         {
-            freeStagedBlocks( true );
-            block = m_suballocator->alloc( size, alignment );
+            // Only wait on staged blocks if nothing could be allocated without waiting.
+            MemoryBlockDesc block = allocBlock( size, alignment, stream, numAllocated == 0 );
+            if( block.isBad() )
+                break;
+            blocks.push_back( block );
         }
-
-        return block;
+        return numAllocated;
     }
 
     /// Allocate a single item. Works with FixedSuballocator.
@@ -227,6 +200,21 @@ class MemoryPool
             m_allocator->free( reinterpret_cast<void*>( block.ptr ), stream );
     }
 
+    /// Free a batch of blocks immediately, taking the lock once for the whole batch.
+    void freeBlocks( const MemoryBlockDesc* blocks, size_t numBlocks, CUstream stream = 0 )
+    {
+        OTK_ASSERT_CONTEXT_MATCHES_STREAM( stream );
+
+        std::unique_lock<std::mutex> lock( m_mutex );
+        for( size_t i = 0; i < numBlocks; ++i )
+        {
+            if( m_suballocator )
+                m_suballocator->free( blocks[i] );
+            else
+                m_allocator->free( reinterpret_cast<void*>( blocks[i].ptr ), stream );
+        }
+    }
+
     /// Free a single item (used with FixedSuballocator).
     void freeItem( uint64_t ptr ) { free( MemoryBlockDesc{ptr, m_suballocator->itemSize(), 0} ); }
 
@@ -390,6 +378,60 @@ class MemoryPool
 
     std::deque<StagedBlock> m_stagedBlocks;
 
+    // Allocate a block with the lock held. If the pool is exhausted and waitOnStagedBlocks is set,
+    // wait on the asynchronously freed blocks before giving up.
+    MemoryBlockDesc allocBlock( uint64_t size, uint64_t alignment, CUstream stream, bool waitOnStagedBlocks )
+    {
+        size = ( size ) ? size : m_allocationGranularity;
+
+        // If no suballocator, use the allocator directly
+        if( !m_suballocator )
+            return MemoryBlockDesc{reinterpret_cast<uint64_t>( m_allocator->allocate( size, stream ) ), size, 0};
+
+        // Try to fill the request with the suballocator. If it fails, allocate more memory and try again.
+        MemoryBlockDesc block = m_suballocator->alloc( size, alignment );
+
+        if( ( block.isBad() ) && ( trackedSize() < m_maxSize ) && m_allocator )
+        {
+            // Make sure there is enough headroom (allocatable space) still on the card
+            if( m_headroom > 0 )
+            {
+                size_t freeMem, totalMem;
+                OTK_ERROR_CHECK( cuMemGetInfo( &freeMem, &totalMem ) );
+                if( freeMem < m_headroom )
+                    return block;
+            }
+
+            // Allocate enough memory for the current request at m_allocationGranularity increments.
+            size_t allocSize = m_allocationGranularity * ( ( size + m_allocationGranularity - 1 ) / m_allocationGranularity );
+            void* ptr = m_allocator->allocate( allocSize );
+            if( !ptr )
+                return block;
+            m_allocations.push_back( PtrSize{ptr, allocSize} );
+
+            if( m_allocator->allocationIsHandle() )
+            {
+                // If the allocator returns handles, they are not pointers in a linear memory space, so
+                // construct an artificial linear memory space for the suballocator to use.
+                m_suballocator->track( getArenaStartAddress( static_cast<uint64_t>( m_allocations.size() - 1 ) ), allocSize );
+            }
+            else
+            {
+                m_suballocator->track( reinterpret_cast<uint64_t>( m_allocations.back().ptr ), allocSize );
+            }
+            block = m_suballocator->alloc( size, alignment );
+        }
+
+        // If the allocation failed, wait on all the staged blocks and try the suballocator one last time
+        if( block.isBad() && waitOnStagedBlocks )
+        {
+            freeStagedBlocks( true );
+            block = m_suballocator->alloc( size, alignment );
+        }
+
+        return block;
+    }
+
     // Free blocks with events that have finished
     inline void freeStagedBlocks( bool waitOnEvents )
     {
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -102,6 +102,20 @@ class SyncVector
         ensureDeviceMemory();
         OTK_ERROR_CHECK( cudaMemcpyAsync( m_device.devicePtr(), m_host.data(), m_host.size() * sizeof( T ), cudaMemcpyHostToDevice, stream ) );
     }
+    /// Asynchronously copy a range of host elements to the device.
+    ///
+    /// Device memory is not reallocated, so the whole vector must have been
+    /// copied to the device since it last grew.
+    ///
+    /// @param first The index of the first element to copy.
+    /// @param count The number of elements to copy.
+    /// @param stream The stream on which to issue the copy.
+    ///
+    void copyToDeviceAsync( size_t first, size_t count, CUstream stream )
+    {
+        OTK_ERROR_CHECK( cudaMemcpyAsync( static_cast<T*>( m_device.devicePtr() ) + first, m_host.data() + first,
+                                          count * sizeof( T ), cudaMemcpyHostToDevice, stream ) );
+    }
 
     /// Untyped pointer to the device memory.
     ///
@@ -0,0 +1,479 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <OptiXToolkit/Memory/MemoryBlockDesc.h>
+
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+namespace otk {
+
+// TlsfSuballocator tracks free blocks from an address space using a two-level
+// segregated fit (TLSF) scheme, and has the same interface as HeapSuballocator.
+//
+// Free blocks are kept in size classes. The first level divides sizes by powers
+// of two, and the second level divides each power of two into SL_COUNT linear
+// sub-ranges. A bitmap for each level records which size classes are non-empty,
+// so alloc() finds a free block of sufficient size with a few bit scans rather
+// than by searching the free blocks. Blocks are found by address with hash maps,
+// so free() merges adjacent free blocks in constant time. Since the memory being
+// suballocated may be device memory, no bookkeeping is stored in the blocks.
+//
+// alloc() rounds the request up to the next size class, so that any block in
+// that class or above is guaranteed to fit (including any padding for
+// alignment). Only if no such block exists are the smaller candidate blocks
+// checked individually, so alloc() and free() run in constant time except when
+// the heap is nearly exhausted. Like HeapSuballocator, allocations are taken
+// from the end of a free block, which usually leaves the remainder in place.
+//
+class TlsfSuballocator
+{
+  public:
+    TlsfSuballocator()
+    {
+        for( unsigned int fl = 0; fl < FL_COUNT; ++fl )
+        {
+            m_slBitmaps[fl] = 0;
+            for( unsigned int sl = 0; sl < SL_COUNT; ++sl )
+                m_freeLists[fl][sl] = NULL_BLOCK;
+        }
+    }
+    ~TlsfSuballocator() = default;
+
+    /// Tell the suballocator to track a memory segment.
+    /// This can be called multiple times to track multiple segments.
+    void track( uint64_t ptr, uint64_t size )
+    {
+        m_trackedSize += size;
+        free( MemoryBlockDesc{ptr, size, 0} );
+    }
+
+    /// Allocate a block from tracked memory. Returns the address to the allocated block.
+    /// On failure, BAD_ADDR is returned in the memory block.
+    MemoryBlockDesc alloc( uint64_t size, uint64_t alignment = 1 );
+
+    /// Free a block. The size must be correct to ensure correctness.
+    void free( const MemoryBlockDesc& memBlock );
+
+    /// Untrack memory that is currently tracked by the suballocator.
+    void untrack( uint64_t ptr, uint64_t size );
+
+    /// Return the current free space
+    uint64_t freeSpace() const { return m_freeSpace; }
+
+    /// Return the total memory tracked by suballocator
+    uint64_t trackedSize() const { return m_trackedSize; }
+
+    /// Return the number of free blocks.
+    size_t numFreeBlocks() const { return m_blocksByBegin.size(); }
+
+    /// Return the size of the largest free block.
+    uint64_t largestFreeBlock() const;
+
+    /// Return the external fragmentation of the free space, between 0 (all the free space is in
+    /// one block) and 1 (the free space is split into many small blocks).
+    double fragmentation() const
+    {
+        return m_freeSpace == 0 ? 0.0 : 1.0 - static_cast<double>( largestFreeBlock() ) / static_cast<double>( m_freeSpace );
+    }
+
+    /// Return true if the internal structure is valid (all blocks have non-zero size, none overlap
+    /// or abut, and each is in the correct size class).
+    bool validate() const;
+
+  private:
+    static const unsigned int SL_LOG2    = 5;
+    static const unsigned int SL_COUNT   = 1u << SL_LOG2;
+    static const unsigned int FL_COUNT   = 64 - SL_LOG2 + 1;
+    static const uint32_t     NULL_BLOCK = 0xFFFFFFFFu;
+
+    struct FreeBlock
+    {
+        uint64_t begin;
+        uint64_t size;
+        uint32_t prev;  // Links in the free list of the block's size class.
+        uint32_t next;
+    };
+
+    uint64_t m_trackedSize = 0;  // Total memory tracked by the suballocator
+    uint64_t m_freeSpace   = 0;  // Current free memory available
+
+    std::vector<FreeBlock> m_blocks;        // Free block storage, indexed by the free lists and maps.
+    std::vector<uint32_t>  m_unusedBlocks;  // Indices of unused entries in m_blocks.
+
+    std::unordered_map<uint64_t, uint32_t> m_blocksByBegin;  // Free blocks indexed by beginning address
+    std::unordered_map<uint64_t, uint32_t> m_blocksByEnd;    // Free blocks indexed by end address
+
+    uint64_t m_flBitmap = 0;                     // Bit fl is set if any list in m_freeLists[fl] is non-empty.
+    uint32_t m_slBitmaps[FL_COUNT];              // Bit sl of m_slBitmaps[fl] is set if m_freeLists[fl][sl] is non-empty.
+    uint32_t m_freeLists[FL_COUNT][SL_COUNT];    // Head of the free list for each size class.
+
+    static unsigned int findLastSet( uint64_t x );
+    static unsigned int findFirstSet( uint64_t x );
+
+    // Get the size class containing blocks of the given size.
+    static void mapping( uint64_t size, unsigned int& fl, unsigned int& sl );
+
+    // Find the head of the first non-empty free list in the size class (fl, sl) or above.
+    uint32_t findFreeList( unsigned int fl, unsigned int sl ) const;
+
+    // Check each block in the size classes at or above that of the given size, returning the first
+    // one that fits the aligned allocation.
+    uint32_t findFittingBlock( uint64_t size, uint64_t alignment ) const;
+
+    void insertBlock( uint64_t begin, uint64_t size );
+    void removeBlock( uint32_t index );
+
+    // Change the extent of a free block in place, moving it to another free list only if its
+    // size class changes.
+    void resizeBlock( uint32_t index, uint64_t begin, uint64_t end );
+
+    void linkBlock( uint32_t index );
+    void unlinkBlock( uint32_t index );
+};
+
+inline unsigned int TlsfSuballocator::findLastSet( uint64_t x )
+{
+#if defined( _MSC_VER )
+    unsigned long index;
+    _BitScanReverse64( &index, x );
+    return static_cast<unsigned int>( index );
+#else
+    return 63 - static_cast<unsigned int>( __builtin_clzll( x ) );
+#endif
+}
+
+inline unsigned int TlsfSuballocator::findFirstSet( uint64_t x )
+{
+#if defined( _MSC_VER )
+    unsigned long index;
+    _BitScanForward64( &index, x );
+    return static_cast<unsigned int>( index );
+#else
+    return static_cast<unsigned int>( __builtin_ctzll( x ) );
+#endif
+}
+
+inline void TlsfSuballocator::mapping( uint64_t size, unsigned int& fl, unsigned int& sl )
+{
+    // Sizes smaller than SL_COUNT have a size class each.
+    if( size < SL_COUNT )
+    {
+        fl = 0;
+        sl = static_cast<unsigned int>( size );
+        return;
+    }
+    const unsigned int log2Size = findLastSet( size );
+    fl = log2Size - SL_LOG2 + 1;
+    sl = static_cast<unsigned int>( size >> ( log2Size - SL_LOG2 ) ) - SL_COUNT;
+}
+
+inline uint32_t TlsfSuballocator::findFreeList( unsigned int fl, unsigned int sl ) const
+{
+    uint32_t slBitmap = m_slBitmaps[fl] & ( ~0u << sl );
+    if( slBitmap == 0 )
+    {
+        const uint64_t flBitmap = ( fl + 1 < 64 ) ? m_flBitmap & ( ~0ull << ( fl + 1 ) ) : 0;
+        if( flBitmap == 0 )
+            return NULL_BLOCK;
+        fl       = findFirstSet( flBitmap );
+        slBitmap = m_slBitmaps[fl];
+    }
+    return m_freeLists[fl][findFirstSet( slBitmap )];
+}
+
+inline uint32_t TlsfSuballocator::findFittingBlock( uint64_t size, uint64_t alignment ) const
+{
+    unsigned int fl, sl;
+    mapping( size, fl, sl );
+    while( fl < FL_COUNT )
+    {
+        const uint32_t slBitmap = m_slBitmaps[fl] & ( ~0u << sl );
+        if( slBitmap == 0 )
+        {
+            const uint64_t flBitmap = ( fl + 1 < 64 ) ? m_flBitmap & ( ~0ull << ( fl + 1 ) ) : 0;
+            if( flBitmap == 0 )
+                return NULL_BLOCK;
+            fl = findFirstSet( flBitmap );
+            sl = 0;
+            continue;
+        }
+        sl = findFirstSet( slBitmap );
+        for( uint32_t index = m_freeLists[fl][sl]; index != NULL_BLOCK; index = m_blocks[index].next )
+        {
+            const FreeBlock& block     = m_blocks[index];
+            const uint64_t   usedBegin = alignVal( block.begin, alignment );
+            if( usedBegin + size <= block.begin + block.size )
+                return index;
+        }
+        if( ++sl == SL_COUNT )
+        {
+            ++fl;
+            sl = 0;
+        }
+    }
+    return NULL_BLOCK;
+}
+
+inline void TlsfSuballocator::linkBlock( uint32_t index )
+{
+    unsigned int fl, sl;
+    mapping( m_blocks[index].size, fl, sl );
+    FreeBlock& block = m_blocks[index];
+    block.prev       = NULL_BLOCK;
+    block.next       = m_freeLists[fl][sl];
+    if( block.next != NULL_BLOCK )
+        m_blocks[block.next].prev = index;
+    m_freeLists[fl][sl] = index;
+    m_slBitmaps[fl] |= 1u << sl;
+    m_flBitmap |= 1ull << fl;
+}
+
+inline void TlsfSuballocator::unlinkBlock( uint32_t index )
+{
+    const FreeBlock& block = m_blocks[index];
+    unsigned int     fl, sl;
+    mapping( block.size, fl, sl );
+    if( block.prev != NULL_BLOCK )
+        m_blocks[block.prev].next = block.next;
+    else
+        m_freeLists[fl][sl] = block.next;
+    if( block.next != NULL_BLOCK )
+        m_blocks[block.next].prev = block.prev;
+    if( m_freeLists[fl][sl] == NULL_BLOCK )
+    {
+        m_slBitmaps[fl] &= ~( 1u << sl );
+        if( m_slBitmaps[fl] == 0 )
+            m_flBitmap &= ~( 1ull << fl );
+    }
+}
+
+inline void TlsfSuballocator::insertBlock( uint64_t begin, uint64_t size )
+{
+    uint32_t index;
+    if( m_unusedBlocks.empty() )
+    {
+        index = static_cast<uint32_t>( m_blocks.size() );
+        m_blocks.push_back( FreeBlock() );
+    }
+    else
+    {
+        index = m_unusedBlocks.back();
+        m_unusedBlocks.pop_back();
+    }
+
+    m_blocks[index].begin = begin;
+    m_blocks[index].size  = size;
+    linkBlock( index );
+    m_blocksByBegin[begin]      = index;
+    m_blocksByEnd[begin + size] = index;
+}
+
+inline void TlsfSuballocator::removeBlock( uint32_t index )
+{
+    unlinkBlock( index );
+    m_blocksByBegin.erase( m_blocks[index].begin );
+    m_blocksByEnd.erase( m_blocks[index].begin + m_blocks[index].size );
+    m_unusedBlocks.push_back( index );
+}
+
+inline void TlsfSuballocator::resizeBlock( uint32_t index, uint64_t begin, uint64_t end )
+{
+    FreeBlock&     block    = m_blocks[index];
+    const uint64_t oldBegin = block.begin;
+    const uint64_t oldEnd   = block.begin + block.size;
+
+    unsigned int oldFl, oldSl, newFl, newSl;
+    mapping( block.size, oldFl, oldSl );
+    mapping( end - begin, newFl, newSl );
+    const bool relink = oldFl != newFl || oldSl != newSl;
+    if( relink )
+        unlinkBlock( index );
+    block.begin = begin;
+    block.size  = end - begin;
+    if( relink )
+        linkBlock( index );
+
+    if( begin != oldBegin )
+    {
+        m_blocksByBegin.erase( oldBegin );
+        m_blocksByBegin[begin] = index;
+    }
+    if( end != oldEnd )
+    {
+        m_blocksByEnd.erase( oldEnd );
+        m_blocksByEnd[end] = index;
+    }
+}
+
+inline MemoryBlockDesc TlsfSuballocator::alloc( uint64_t size, uint64_t alignment )
+{
+    alignment = std::max( alignment, static_cast<uint64_t>( 1 ) );
+
+    // Can't allocate 0 size, or something larger than the free space
+    if( size == 0 || size > m_freeSpace )
+        return MemoryBlockDesc{BAD_ADDR, 0, 0};
+
+    // Round the request (with worst-case alignment padding) up to the next size class, so that
+    // the first block in any non-empty free list at or above that class fits.
+    uint32_t       index   = NULL_BLOCK;
+    const uint64_t request = size + ( alignment - 1 );
+    if( request >= size && request < ( 1ull << 63 ) )
+    {
+        uint64_t rounded = request;
+        if( rounded >= SL_COUNT )
+            rounded += ( 1ull << ( findLastSet( rounded ) - SL_LOG2 ) ) - 1;
+        unsigned int fl, sl;
+        mapping( rounded, fl, sl );
+        index = findFreeList( fl, sl );
+    }
+
+    // Otherwise, look for a block that fits among those that are large enough before alignment.
+    if( index == NULL_BLOCK )
+        index = findFittingBlock( size, alignment );
+    if( index == NULL_BLOCK )
+        return MemoryBlockDesc{BAD_ADDR, 0, 0};
+
+    // Allocate from the end of the block, so the remainder usually keeps its beginning address,
+    // and return any padding after the allocation to the free lists.
+    const uint64_t blockBegin = m_blocks[index].begin;
+    const uint64_t blockEnd   = blockBegin + m_blocks[index].size;
+    const uint64_t usedBegin  = ( blockEnd - size ) - ( blockEnd - size ) % alignment;
+    const uint64_t usedEnd    = usedBegin + size;
+    if( usedBegin == blockBegin )
+        removeBlock( index );
+    else
+        resizeBlock( index, blockBegin, usedBegin );
+    if( usedEnd != blockEnd )
+        insertBlock( usedEnd, blockEnd - usedEnd );
+
+    m_freeSpace -= size;
+    return MemoryBlockDesc{usedBegin, size, 0};
+}
+
+inline void TlsfSuballocator::free( const MemoryBlockDesc& memBlock )
+{
+    if( memBlock.size == 0 )
+        return;
+    const uint64_t begin = memBlock.ptr;
+    const uint64_t end   = memBlock.ptr + memBlock.size;
+    m_freeSpace += memBlock.size;
+
+    // Merge with the previous and next blocks if they are free, growing one of them in place.
+    auto           prevIt = m_blocksByEnd.find( begin );
+    auto           nextIt = m_blocksByBegin.find( end );
+    const uint32_t prev   = ( prevIt != m_blocksByEnd.end() ) ? prevIt->second : NULL_BLOCK;
+    const uint32_t next   = ( nextIt != m_blocksByBegin.end() ) ? nextIt->second : NULL_BLOCK;
+    if( prev != NULL_BLOCK && next != NULL_BLOCK )
+    {
+        const uint64_t nextEnd = m_blocks[next].begin + m_blocks[next].size;
+        removeBlock( next );
+        resizeBlock( prev, m_blocks[prev].begin, nextEnd );
+    }
+    else if( prev != NULL_BLOCK )
+        resizeBlock( prev, m_blocks[prev].begin, end );
+    else if( next != NULL_BLOCK )
+        resizeBlock( next, begin, m_blocks[next].begin + m_blocks[next].size );
+    else
+        insertBlock( begin, end - begin );
+}
+
+inline void TlsfSuballocator::untrack( uint64_t ptr, uint64_t size )
+{
+    // Find the free blocks that overlap the untracked region.  Untracking is rare, so a linear
+    // search of the free blocks is acceptable.
+    const uint64_t        end = ptr + size;
+    std::vector<uint32_t> overlapping;
+    for( const auto& entry : m_blocksByBegin )
+    {
+        const FreeBlock& block = m_blocks[entry.second];
+        if( block.begin < end && block.begin + block.size > ptr )
+            overlapping.push_back( entry.second );
+    }
+
+    // Remove the overlapping blocks, keeping any parts outside the region.
+    for( uint32_t index : overlapping )
+    {
+        const uint64_t blockBegin = m_blocks[index].begin;
+        const uint64_t blockEnd   = blockBegin + m_blocks[index].size;
+        removeBlock( index );
+        if( blockBegin < ptr )
+            insertBlock( blockBegin, ptr - blockBegin );
+        if( blockEnd > end )
+            insertBlock( end, blockEnd - end );
+        m_freeSpace -= std::min( blockEnd, end ) - std::max( blockBegin, ptr );
+    }
+
+    // Reduce the tracked size
+    m_trackedSize = ( size <= m_trackedSize ) ? m_trackedSize - size : 0ULL;
+}
+
+inline uint64_t TlsfSuballocator::largestFreeBlock() const
+{
+    if( m_flBitmap == 0 )
+        return 0;
+    const unsigned int fl      = findLastSet( m_flBitmap );
+    const unsigned int sl      = findLastSet( m_slBitmaps[fl] );
+    uint64_t           largest = 0;
+    for( uint32_t index = m_freeLists[fl][sl]; index != NULL_BLOCK; index = m_blocks[index].next )
+        largest = std::max( largest, m_blocks[index].size );
+    return largest;
+}
+
+inline bool TlsfSuballocator::validate() const
+{
+    // Check the free lists and bitmaps
+    uint64_t freeSpace = 0;
+    size_t   numBlocks = 0;
+    for( unsigned int fl = 0; fl < FL_COUNT; ++fl )
+    {
+        if( ( ( m_flBitmap >> fl ) & 1 ) != ( m_slBitmaps[fl] != 0 ? 1u : 0u ) )
+            return false;
+        for( unsigned int sl = 0; sl < SL_COUNT; ++sl )
+        {
+            if( ( ( m_slBitmaps[fl] >> sl ) & 1 ) != ( m_freeLists[fl][sl] != NULL_BLOCK ? 1u : 0u ) )
+                return false;
+            uint32_t prev = NULL_BLOCK;
+            for( uint32_t index = m_freeLists[fl][sl]; index != NULL_BLOCK; index = m_blocks[index].next )
+            {
+                const FreeBlock& block = m_blocks[index];
+                unsigned int     blockFl, blockSl;
+                mapping( block.size, blockFl, blockSl );
+                if( block.size == 0 || blockFl != fl || blockSl != sl || block.prev != prev )
+                    return false;
+                auto beginIt = m_blocksByBegin.find( block.begin );
+                auto endIt   = m_blocksByEnd.find( block.begin + block.size );
+                if( beginIt == m_blocksByBegin.end() || beginIt->second != index || endIt == m_blocksByEnd.end() || endIt->second != index )
+                    return false;
+                freeSpace += block.size;
+                ++numBlocks;
+                prev = index;
+            }
+        }
+    }
+    if( freeSpace != m_freeSpace || numBlocks != m_blocksByBegin.size() || numBlocks != m_blocksByEnd.size() )
+        return false;
+
+    // Check that no blocks overlap or abut (abutting blocks should have been merged)
+    std::vector<std::pair<uint64_t, uint64_t>> blocks;
+    for( const auto& entry : m_blocksByBegin )
+        blocks.push_back( std::make_pair( entry.first, m_blocks[entry.second].size ) );
+    std::sort( blocks.begin(), blocks.end() );
+    for( size_t i = 1; i < blocks.size(); ++i )
+    {
+        if( blocks[i - 1].first + blocks[i - 1].second >= blocks[i].first )
+            return false;
+    }
+    return true;
+}
+
+}  // namespace otk
@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <OptiXToolkit/Error/cudaErrorCheck.h>
+#include <OptiXToolkit/Memory/Allocators.h>
+#include <OptiXToolkit/Memory/HeapSuballocator.h>
+#include <OptiXToolkit/Memory/MagazineCache.h>
+#include <OptiXToolkit/Memory/MemoryPool.h>
+#include <OptiXToolkit/Memory/RingSuballocator.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace otk;
+
+namespace {
+
+const uint64_t BLOCK_SIZE    = 65536;
+const uint64_t ALLOC_SIZE    = 1 << 20;
+const unsigned MAGAZINE_SIZE = 8;
+
+}  // namespace
+
+class TestMagazineCache : public testing::Test
+{
+  public:
+    void SetUp() override
+    {
+        OTK_ERROR_CHECK( cudaSetDevice( 0 ) );
+        OTK_ERROR_CHECK( cudaFree( nullptr ) );
+    }
+};
+
+TEST_F( TestMagazineCache, RefillsInBatches )
+{
+    MemoryPool<HostAllocator, HeapSuballocator>    pool( new HostAllocator(), new HeapSuballocator(), ALLOC_SIZE, ALLOC_SIZE );
+    MagazineCache<HostAllocator, HeapSuballocator> cache( &pool, BLOCK_SIZE, BLOCK_SIZE, MAGAZINE_SIZE );
+
+    MemoryBlockDesc block = cache.alloc();
+    ASSERT_TRUE( block.isGood() );
+    EXPECT_EQ( BLOCK_SIZE, block.size );
+    EXPECT_EQ( 0ULL, block.ptr % BLOCK_SIZE );
+
+    // The first allocation takes half a magazine from the pool.
+    EXPECT_EQ( ALLOC_SIZE, cache.trackedSize() );
+    EXPECT_EQ( ALLOC_SIZE - MAGAZINE_SIZE / 2 * BLOCK_SIZE, pool.currentFreeSpace() );
+    EXPECT_EQ( ( MAGAZINE_SIZE / 2 - 1 ) * BLOCK_SIZE, cache.cachedSpace() );
+    EXPECT_EQ( ALLOC_SIZE - BLOCK_SIZE, cache.currentFreeSpace() );
+
+    // The next allocations come from the magazine.
+    for( unsigned int i = 1; i < MAGAZINE_SIZE / 2; ++i )
+        EXPECT_TRUE( cache.alloc().isGood() );
+    EXPECT_EQ( 0ULL, cache.cachedSpace() );
+    EXPECT_EQ( ALLOC_SIZE - MAGAZINE_SIZE / 2 * BLOCK_SIZE, pool.currentFreeSpace() );
+}
+
+TEST_F( TestMagazineCache, OverflowReturnsToPool )
+{
+    MemoryPool<HostAllocator, HeapSuballocator>    pool( new HostAllocator(), new HeapSuballocator(), ALLOC_SIZE, ALLOC_SIZE );
+    MagazineCache<HostAllocator, HeapSuballocator> cache( &pool, BLOCK_SIZE, 1, MAGAZINE_SIZE );
+
+    std::vector<MemoryBlockDesc> blocks;
+    for( uint64_t i = 0; i < ALLOC_SIZE / BLOCK_SIZE; ++i )
+    {
+        blocks.push_back( cache.alloc() );
+        ASSERT_TRUE( blocks.back().isGood() );
+    }
+    EXPECT_EQ( 0ULL, cache.currentFreeSpace() );
+
+    for( const MemoryBlockDesc& block : blocks )
+    {
+        cache.free( block );
+        EXPECT_LE( cache.cachedSpace(), MAGAZINE_SIZE * BLOCK_SIZE );
+    }
+    EXPECT_EQ( ALLOC_SIZE, cache.currentFreeSpace() );
+    EXPECT_EQ( ALLOC_SIZE, pool.currentFreeSpace() + cache.cachedSpace() );
+
+    cache.flush();
+    EXPECT_EQ( 0ULL, cache.cachedSpace() );
+    EXPECT_EQ( ALLOC_SIZE, pool.currentFreeSpace() );
+}
+
+TEST_F( TestMagazineCache, FreeAsyncReusesBlocks )
+{
+    CUstream stream;
+    OTK_ERROR_CHECK( cudaStreamCreate( &stream ) );
+
+    MemoryPool<HostAllocator, RingSuballocator>    pool( new HostAllocator(), new RingSuballocator( ALLOC_SIZE ), ALLOC_SIZE, ALLOC_SIZE );
+    MagazineCache<HostAllocator, RingSuballocator> cache( &pool, BLOCK_SIZE, 1, MAGAZINE_SIZE );
+
+    // Far more blocks are allocated than fit in the pool, so they must be recycled.
+    for( int i = 0; i < 1000; ++i )
+    {
+        MemoryBlockDesc block = cache.alloc( stream );
+        ASSERT_TRUE( block.isGood() );
+        cache.freeAsync( block, stream );
+    }
+    OTK_ERROR_CHECK( cudaStreamSynchronize( stream ) );
+    cache.flush();
+    EXPECT_EQ( 0ULL, cache.cachedSpace() );
+    OTK_ERROR_CHECK( cudaStreamDestroy( stream ) );
+}
+
+TEST_F( TestMagazineCache, ExhaustedPoolReclaimsOtherMagazines )
+{
+    MemoryPool<HostAllocator, HeapSuballocator>    pool( new HostAllocator(), new HeapSuballocator(), ALLOC_SIZE, ALLOC_SIZE );
+    MagazineCache<HostAllocator, HeapSuballocator> cache( &pool, BLOCK_SIZE, 1, MAGAZINE_SIZE );
+
+    // Leave blocks in another thread's magazine.
+    std::thread thread( [&cache] { cache.free( cache.alloc() ); } );
+    thread.join();
+    EXPECT_EQ( MAGAZINE_SIZE / 2 * BLOCK_SIZE, cache.cachedSpace() );
+
+    // Every block in the pool can still be allocated by this thread.
+    std::set<uint64_t> blocks;
+    for( uint64_t i = 0; i < ALLOC_SIZE / BLOCK_SIZE; ++i )
+    {
+        MemoryBlockDesc block = cache.alloc();
+        ASSERT_TRUE( block.isGood() );
+        EXPECT_TRUE( blocks.insert( block.ptr ).second );
+    }
+    EXPECT_TRUE( cache.alloc().isBad() );
+}
+
+TEST_F( TestMagazineCache, ManyThreads )
+{
+    MemoryPool<HostAllocator, HeapSuballocator>    pool( new HostAllocator(), new HeapSuballocator(), ALLOC_SIZE, 16 * ALLOC_SIZE );
+    MagazineCache<HostAllocator, HeapSuballocator> cache( &pool, BLOCK_SIZE, 1, MAGAZINE_SIZE );
+
+    const unsigned int       numThreads = 8;
+    std::atomic<bool>        failed( false );
+    std::vector<std::thread> threads;
+    for( unsigned int t = 0; t < numThreads; ++t )
+    {
+        threads.emplace_back( [&cache, &failed, t] {
+            std::vector<MemoryBlockDesc> blocks;
+            for( unsigned int i = 0; i < 10000; ++i )
+            {
+                if( ( i + t ) % 3 != 2 || blocks.empty() )
+                {
+                    MemoryBlockDesc block = cache.alloc();
+                    if( block.isBad() )
+                        failed = true;
+                    else
+                        blocks.push_back( block );
+                }
+                else
+                {
+                    cache.free( blocks.back() );
+                    blocks.pop_back();
+                }
+                if( blocks.size() > 16 )
+                {
+                    for( const MemoryBlockDesc& block : blocks )
+                        cache.free( block );
+                    blocks.clear();
+                }
+            }
+            for( const MemoryBlockDesc& block : blocks )
+                cache.free( block );
+        } );
+    }
+    for( std::thread& thread : threads )
+        thread.join();
+
+    EXPECT_FALSE( failed );
+    EXPECT_EQ( cache.trackedSize(), cache.currentFreeSpace() );
+    cache.flush();
+    EXPECT_EQ( pool.trackedSize(), pool.currentFreeSpace() );
+}
@@ -129,6 +129,24 @@ TEST_F( TestMemoryPool, HeapSuballocator )
     pool.free( m );
 }
 
+TEST_F( TestMemoryPool, AllocFreeBlocks )
+{
+    uint64_t allocSize = 1 << 20;
+    uint64_t maxSize   = 2 * ( 1 << 20 );
+
+    MemoryPool<HostAllocator, HeapSuballocator> pool( new HostAllocator(), new HeapSuballocator(), allocSize, maxSize );
+    std::vector<MemoryBlockDesc>                blocks;
+
+    // Batches grow the pool as needed, and stop when it is full.
+    EXPECT_EQ( 24U, pool.allocBlocks( 65536, 1, 24, blocks ) );
+    EXPECT_EQ( 8U, pool.allocBlocks( 65536, 1, 24, blocks ) );
+    EXPECT_EQ( 32U, blocks.size() );
+    EXPECT_EQ( 0ULL, pool.currentFreeSpace() );
+
+    pool.freeBlocks( blocks.data(), blocks.size() );
+    EXPECT_EQ( maxSize, pool.currentFreeSpace() );
+}
+
 TEST_F( TestMemoryPool, BinnedSuballocator )
 {
     uint64_t allocSize = 1 << 20;
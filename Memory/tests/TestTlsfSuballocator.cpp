@@ -0,0 +1,229 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <OptiXToolkit/Memory/TlsfSuballocator.h>
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace otk;
+
+class TestTlsfSuballocator : public testing::Test
+{
+  protected:
+    TlsfSuballocator suballocator;
+};
+
+TEST_F( TestTlsfSuballocator, track )
+{
+    suballocator.track( 0, 1024 );
+    suballocator.track( 2048, 65536 );
+
+    EXPECT_EQ( 2U, suballocator.numFreeBlocks() );
+    EXPECT_EQ( static_cast<uint64_t>( 1024 + 65536 ), suballocator.trackedSize() );
+    EXPECT_EQ( static_cast<uint64_t>( 1024 + 65536 ), suballocator.freeSpace() );
+    EXPECT_EQ( 65536ULL, suballocator.largestFreeBlock() );
+    EXPECT_TRUE( suballocator.validate() );
+}
+
+TEST_F( TestTlsfSuballocator, trackAdjacentMerges )
+{
+    suballocator.track( 0, 1024 );
+    suballocator.track( 1024, 1024 );
+
+    EXPECT_EQ( 1U, suballocator.numFreeBlocks() );
+    EXPECT_EQ( 2048ULL, suballocator.largestFreeBlock() );
+    EXPECT_TRUE( suballocator.validate() );
+}
+
+TEST_F( TestTlsfSuballocator, allocFailures )
+{
+    EXPECT_TRUE( suballocator.alloc( 1, 1 ).isBad() );
+
+    suballocator.track( 0, 1024 );
+    EXPECT_TRUE( suballocator.alloc( 0, 1 ).isBad() );
+    EXPECT_TRUE( suballocator.alloc( 1025, 1 ).isBad() );
+    EXPECT_EQ( 1024ULL, suballocator.freeSpace() );
+}
+
+TEST_F( TestTlsfSuballocator, allocMany )
+{
+    const uint64_t numAllocations = 1 << 20;
+    suballocator.track( 0, numAllocations );
+
+    for( uint64_t i = 0; i < numAllocations; ++i )
+    {
+        MemoryBlockDesc memBlock = suballocator.alloc( 1, 1 );
+        ASSERT_TRUE( memBlock.isGood() );
+    }
+    EXPECT_EQ( 0ULL, suballocator.freeSpace() );
+    EXPECT_TRUE( suballocator.alloc( 1, 1 ).isBad() );
+}
+
+TEST_F( TestTlsfSuballocator, allocExactSizeWithinSizeClass )
+{
+    // The only free block is in the same size class as the request, but isn't the smallest
+    // size in that class, so it must be found by the fallback search.
+    suballocator.track( 0, 1000 );
+    MemoryBlockDesc block = suballocator.alloc( 1000, 1 );
+    EXPECT_EQ( 0ULL, block.ptr );
+    EXPECT_EQ( 1000ULL, block.size );
+    EXPECT_EQ( 0U, suballocator.numFreeBlocks() );
+}
+
+TEST_F( TestTlsfSuballocator, alignment )
+{
+    suballocator.track( 3, 4096 );
+    MemoryBlockDesc block = suballocator.alloc( 100, 256 );
+    ASSERT_TRUE( block.isGood() );
+    EXPECT_EQ( 0ULL, block.ptr % 256 );
+    EXPECT_EQ( 4096ULL - 100, suballocator.freeSpace() );
+    EXPECT_TRUE( suballocator.validate() );
+
+    // Fill the remainder with aligned blocks.
+    unsigned int numBlocks = 1;
+    while( suballocator.alloc( 100, 256 ).isGood() )
+        ++numBlocks;
+    EXPECT_EQ( 15U, numBlocks );
+    EXPECT_TRUE( suballocator.validate() );
+}
+
+TEST_F( TestTlsfSuballocator, tilePoolPattern )
+{
+    // MemoryPool tracks each tile arena separately, with a gap between arenas, and allocates
+    // tile-aligned blocks of whole tiles.  Every tile must be allocatable.
+    const uint64_t tileSize  = 64 * 1024;
+    const uint64_t arenaSize = 2 * 1024 * 1024;
+    const uint64_t numArenas = 4;
+    const uint64_t numTiles  = numArenas * arenaSize / tileSize;
+    for( uint64_t arena = 0; arena < numArenas; ++arena )
+        suballocator.track( arena * 2 * arenaSize, arenaSize );
+
+    std::vector<MemoryBlockDesc> blocks;
+    for( uint64_t i = 0; i < numTiles; ++i )
+    {
+        blocks.push_back( suballocator.alloc( tileSize, tileSize ) );
+        ASSERT_TRUE( blocks.back().isGood() );
+        EXPECT_EQ( 0ULL, blocks.back().ptr % tileSize );
+    }
+    EXPECT_EQ( 0ULL, suballocator.freeSpace() );
+
+    // Free every other tile, then reallocate them.
+    for( uint64_t i = 0; i < numTiles; i += 2 )
+        suballocator.free( blocks[i] );
+    EXPECT_EQ( numTiles / 2, suballocator.numFreeBlocks() );
+    EXPECT_GT( suballocator.fragmentation(), 0.9 );
+    for( uint64_t i = 0; i < numTiles; i += 2 )
+        EXPECT_TRUE( suballocator.alloc( tileSize, tileSize ).isGood() );
+    EXPECT_TRUE( suballocator.alloc( tileSize, tileSize ).isBad() );
+    EXPECT_TRUE( suballocator.validate() );
+}
+
+TEST_F( TestTlsfSuballocator, freeMerges )
+{
+    suballocator.track( 0, 3072 );
+    MemoryBlockDesc a = suballocator.alloc( 1024, 1 );
+    MemoryBlockDesc b = suballocator.alloc( 1024, 1 );
+    MemoryBlockDesc c = suballocator.alloc( 1024, 1 );
+    EXPECT_EQ( 0U, suballocator.numFreeBlocks() );
+
+    suballocator.free( a );
+    suballocator.free( c );
+    EXPECT_EQ( 2U, suballocator.numFreeBlocks() );
+    EXPECT_DOUBLE_EQ( 0.5, suballocator.fragmentation() );
+
+    suballocator.free( b );
+    EXPECT_EQ( 1U, suballocator.numFreeBlocks() );
+    EXPECT_EQ( 3072ULL, suballocator.largestFreeBlock() );
+    EXPECT_DOUBLE_EQ( 0.0, suballocator.fragmentation() );
+    EXPECT_TRUE( suballocator.validate() );
+}
+
+TEST_F( TestTlsfSuballocator, untrack )
+{
+    suballocator.track( 0, 1024 );
+    suballocator.track( 2048, 1024 );
+
+    suballocator.untrack( 0, 1024 );
+    EXPECT_EQ( 1024ULL, suballocator.trackedSize() );
+    EXPECT_EQ( 1024ULL, suballocator.freeSpace() );
+    EXPECT_EQ( 1U, suballocator.numFreeBlocks() );
+    EXPECT_TRUE( suballocator.validate() );
+}
+
+TEST_F( TestTlsfSuballocator, untrackPartOfBlock )
+{
+    suballocator.track( 0, 1024 );
+    suballocator.track( 1024, 1024 );
+
+    suballocator.untrack( 512, 1024 );
+    EXPECT_EQ( 1024ULL, suballocator.freeSpace() );
+    EXPECT_EQ( 2U, suballocator.numFreeBlocks() );
+    EXPECT_TRUE( suballocator.validate() );
+}
+
+TEST_F( TestTlsfSuballocator, stress )
+{
+    // Randomly allocate and free blocks of random sizes and alignments, checking that allocated
+    // blocks never overlap and that the free space is accounted for.
+    const uint64_t heapSize = 1 << 24;
+    suballocator.track( 0, heapSize );
+
+    std::mt19937                            rng( 1234 );
+    std::uniform_int_distribution<unsigned> log2Size( 0, 16 );
+    std::uniform_int_distribution<unsigned> log2Align( 0, 12 );
+    std::map<uint64_t, uint64_t>            allocated;  // begin -> size
+    std::vector<MemoryBlockDesc>            blocks;
+    uint64_t                                allocatedSize = 0;
+
+    for( int i = 0; i < 100000; ++i )
+    {
+        if( blocks.empty() || rng() % 3 != 0 )
+        {
+            const uint64_t  size      = ( 1ULL << log2Size( rng ) ) + rng() % 64;
+            const uint64_t  alignment = 1ULL << log2Align( rng );
+            MemoryBlockDesc block     = suballocator.alloc( size, alignment );
+            if( block.isBad() )
+                continue;
+            ASSERT_EQ( 0ULL, block.ptr % alignment );
+            ASSERT_LE( block.ptr + block.size, heapSize );
+
+            auto next = allocated.lower_bound( block.ptr );
+            ASSERT_TRUE( next == allocated.end() || block.ptr + block.size <= next->first );
+            if( next != allocated.begin() )
+            {
+                auto prev = std::prev( next );
+                ASSERT_LE( prev->first + prev->second, block.ptr );
+            }
+            allocated[block.ptr] = block.size;
+            blocks.push_back( block );
+            allocatedSize += block.size;
+        }
+        else
+        {
+            const size_t index = rng() % blocks.size();
+            suballocator.free( blocks[index] );
+            allocated.erase( blocks[index].ptr );
+            allocatedSize -= blocks[index].size;
+            blocks[index] = blocks.back();
+            blocks.pop_back();
+        }
+        ASSERT_EQ( heapSize - allocatedSize, suballocator.freeSpace() );
+        if( i % 1000 == 0 )
+        {
+            ASSERT_TRUE( suballocator.validate() );
+        }
+    }
+
+    for( const MemoryBlockDesc& block : blocks )
+        suballocator.free( block );
+    EXPECT_EQ( heapSize, suballocator.freeSpace() );
+    EXPECT_EQ( 1U, suballocator.numFreeBlocks() );
+    EXPECT_TRUE( suballocator.validate() );
+}
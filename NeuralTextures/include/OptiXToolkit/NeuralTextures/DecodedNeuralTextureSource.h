@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+#include <OptiXToolkit/ImageSource/ImageSource.h>
+#include <OptiXToolkit/ImageSource/TextureInfo.h>
+#include "NtcHostDecoder.h"
+#include "NtcImageReader.h"
+
+namespace neuralTextures {
+
+/// DecodedNeuralTextureSource decodes a texture of an .ntc texture set on the host CPU, providing
+/// conventional float4 tiles and mip levels.  It allows neural textures to be used (or baked to
+/// other formats) without a GPU.  Channels missing from the texture are filled with zero.
+class DecodedNeuralTextureSource : public imageSource::ImageSourceBase
+{
+  public:
+    /// Create a source decoding the given texture of the texture set in the .ntc file, evaluating
+    /// the network with the given instruction set.  The file is not read until the source is opened.
+    explicit DecodedNeuralTextureSource( const std::string& filename, int textureIndex = 0, NtcSimd simd = NtcSimd::BEST );
+
+    /// The destructor is virtual.
+    ~DecodedNeuralTextureSource() override = default;
+
+    /// The open method initializes the given image info struct.
+    void open( imageSource::TextureInfo* info ) override;
+
+    /// The close operation, which closes the file.
+    void close() override;
+
+    /// Check if image is currently open.
+    bool isOpen() const override { return m_isOpen; }
+
+    /// Get the image info.  Valid only after calling open().
+    const imageSource::TextureInfo& getInfo() const override { return m_info; }
+
+    /// Return the mode in which the image fills part of itself
+    CUmemorytype getFillType() const override { return CU_MEMORYTYPE_HOST; }
+
+    /// Decode the specified tile into dest, which must be large enough to hold the tile.  Pixels
+    /// outside the bounds of the mip level are filled with black.
+    bool readTile( char* dest, unsigned int mipLevel, const imageSource::Tile& tile, CUstream stream ) override;
+
+    /// Decode the specified tiles, spreading them over threads.
+    bool readTiles( char* const* dest, unsigned int mipLevel, const imageSource::Tile* tiles, unsigned int numTiles, CUstream stream ) override;
+
+    /// Decode the specified mip level, spreading its rows over threads.  Returns true for success.
+    bool readMipLevel( char* dest, unsigned int mipLevel, unsigned int expectedWidth, unsigned int expectedHeight, CUstream stream ) override;
+
+    /// Decode the base color of the image (the 1x1 mip level), if it has one.
+    bool readBaseColor( float4& dest ) override;
+
+    /// Returns the number of latent bytes that have been read.
+    unsigned long long getNumBytesRead() const override { return m_imageReader.getNumLatentBytesRead(); }
+
+    /// Returns the number of tiles that have been decoded.
+    unsigned long long getNumTilesRead() const override { return m_numTilesRead; }
+
+    /// Returns the path of the .ntc file.
+    std::string getPath() const override { return m_filename; }
+
+    /// Get the instruction set used to evaluate the network.  Valid only after calling open().
+    NtcSimd getSimd() const { return m_decoder ? m_decoder->getSimd() : m_simd; }
+
+  private:
+    std::string                     m_filename;
+    int                             m_textureIndex;
+    NtcSimd                         m_simd;
+    NtcImageReader                  m_imageReader;
+    std::unique_ptr<NtcHostDecoder> m_decoder;
+    imageSource::TextureInfo        m_info{};
+    int                             m_firstChannel = 0;
+    int                             m_numChannels  = 0;
+    bool                            m_isOpen       = false;
+    std::atomic<unsigned long long> m_numTilesRead{ 0 };
+    std::mutex                      m_mutex;
+
+    // Decode a rectangle of a mip level into float4 pixels with the given row pitch (in pixels).
+    bool decodeRect( float4* dest, unsigned int rowPitch, unsigned int mipLevel, unsigned int xstart, unsigned int ystart,
+                     unsigned int width, unsigned int height ) const;
+};
+
+}  // namespace neuralTextures
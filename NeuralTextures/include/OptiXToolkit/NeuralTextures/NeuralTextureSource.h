@@ -1,9 +1,10 @@
-// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 
 #include <OptiXToolkit/ImageSource/ImageSource.h>
@@ -19,8 +20,11 @@ const uint32_t NTC_TEXTURE_SET_CHUNK_SIZE = 512;
 class NeuralTextureSource : public imageSource::ImageSourceBase
 {
   public:
-    /// Create a neural texture source with the specified dimensions
-    explicit NeuralTextureSource( const std::string& filename );
+    /// Create a neural texture source for the given .ntc file.  The file is not read until the
+    /// texture is opened, and then only its header and network weights are read.  The latents are
+    /// read as tiles and mip levels are requested, copying them from a memory mapping of the file
+    /// if mapFile is true.
+    explicit NeuralTextureSource( const std::string& filename, bool mapFile = true );
 
     /// The destructor is virtual.
     ~NeuralTextureSource() override = default;
@@ -28,8 +32,8 @@ class NeuralTextureSource : public imageSource::ImageSourceBase
     /// The open method initializes the given image info struct.
     void open( imageSource::TextureInfo* info ) override;
 
-    /// The close operation.
-    void close() override { m_isOpen = false; }
+    /// The close operation, which closes the file.
+    void close() override;
 
     /// Check if image is currently open.
     bool isOpen() const override { return m_isOpen; }
@@ -50,6 +54,12 @@ class NeuralTextureSource : public imageSource::ImageSourceBase
     /// Read the base color of the image (1x1 mip level) as a float4. Returns true on success.
     bool readBaseColor( float4& /*dest*/ ) override { return false; }
 
+    /// Returns the number of latent bytes that have been read.
+    unsigned long long getNumBytesRead() const override { return m_imageReader.getNumLatentBytesRead(); }
+
+    /// Returns the path of the .ntc file.
+    std::string getPath() const override { return m_filename; }
+
     /// Get the extra data for the sampler
     CUdeviceptr getSamplerExtraData( OptixDeviceContext optixContext ) override { return makeOptixInferenceData( optixContext ); }
 
@@ -62,9 +72,10 @@ class NeuralTextureSource : public imageSource::ImageSourceBase
   private:
 
     std::string m_filename;
+    bool m_mapFile;
     NtcImageReader m_imageReader;
-    imageSource::TextureInfo m_latentsInfo;
-    bool m_isOpen;
+    imageSource::TextureInfo m_latentsInfo{};
+    std::atomic<bool> m_isOpen;
     std::mutex m_mutex;
 };
 
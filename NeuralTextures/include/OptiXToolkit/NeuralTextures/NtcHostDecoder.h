@@ -0,0 +1,94 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+/// \file NtcHostDecoder.h
+/// Host-side evaluation of neural texture networks.
+
+#include <vector>
+
+#include "NtcImageReader.h"
+
+namespace neuralTextures {
+
+/// Instruction sets the host decoder can use to evaluate the network layers.
+enum class NtcSimd
+{
+    SCALAR,
+    NEON,
+    AVX2,
+    AVX512,
+    BEST  // The best instruction set supported by the host CPU
+};
+
+/// Get the best instruction set supported by the host CPU.
+NtcSimd getBestNtcSimd();
+
+/// Return true if the host CPU supports the instruction set.
+bool isNtcSimdSupported( NtcSimd simd );
+
+/// NtcHostDecoder decodes neural textures on the host CPU.  It samples the latents and evaluates
+/// the network as SampleTextureSet in InferenceOptix.h does on the device, rounding the inputs,
+/// activations and outputs of the layers to the precisions used there, so that neural textures
+/// can be decoded (or baked to conventional textures) on machines without a GPU.
+class NtcHostDecoder
+{
+  public:
+    /// Make a decoder for the texture set loaded by the reader, which must outlive the decoder.  If
+    /// the CPU doesn't support the requested instruction set, the best supported one is used.
+    explicit NtcHostDecoder( NtcImageReader& reader, NtcSimd simd = NtcSimd::BEST );
+
+    /// Return true if the network of the texture set can be decoded on the host.
+    bool isValid() const { return m_isValid; }
+
+    /// Get the instruction set used to evaluate the network layers.
+    NtcSimd getSimd() const { return m_simd; }
+
+    /// Decode a rectangle of a mip level of the texture set, writing NTC_MLP_OUTPUT_CHANNELS values
+    /// per texel to dest, in row major order.  Row 0 is the top row of the image, as in
+    /// ntcTex2DGrad.  The rectangle is clipped to the mip level, and dest holds the clipped
+    /// rectangle.  Threadsafe.
+    bool decodeRect( float* dest, int mipLevel, int xstart, int ystart, int width, int height ) const;
+
+  private:
+    struct Layer
+    {
+        int                inputChannels;
+        int                outputChannels;
+        std::vector<float> weights;  // Transposed, so the weights for an input channel are together
+        std::vector<float> biases;
+        std::vector<float> scales;      // Output layer only
+        std::vector<int>   intBiases;   // Output layer only
+    };
+
+    // Latents covering a rectangle of a latent mip level
+    struct LatentRect
+    {
+        int                   mipWidth;
+        int                   mipHeight;
+        int                   xstart;
+        int                   ystart;
+        int                   width;
+        int                   height;
+        int                   pixelStride;
+        std::vector<uint16_t> latents;
+    };
+
+    // Functions evaluating the network layers, using an instruction set
+    struct Kernels;
+
+    NtcImageReader&    m_reader;
+    NtcSimd            m_simd;
+    const Kernels*     m_kernels;
+    std::vector<Layer> m_layers;
+    bool               m_isValid = false;
+
+    bool loadNetwork();
+    bool readLatents( LatentRect& rect, int latentMip, int mipWidth, int mipHeight, int xstart, int ystart, int width, int height ) const;
+    void prepareInputs( float* inputs, const LatentRect* latents, int mipLevel, int mipWidth, int mipHeight, int x, int y ) const;
+    void evaluateNetwork( const float* inputs, float* outputs ) const;
+};
+
+}  // namespace neuralTextures
@@ -1,11 +1,14 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2019 - 2025  NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2019 - 2026  NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: BSD-3-Clause
  */
  
 #pragma once
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include <cuda_runtime.h>
@@ -13,6 +16,8 @@
 #include <optix_stubs.h>
 #include <rapidjson/document.h>
 
+#include <OptiXToolkit/ImageSource/ReadOnlyFile.h>
+
 #include "InferenceDataOptix.h"
 
 const uint32_t NTC_NETWORK_MAX_SIZE = 32768;
@@ -20,8 +25,31 @@ const uint32_t NTC_NETWORK_MAX_SIZE = 32768;
 class NtcImageReader
 {
   public:
-    /// Load an .ntc file
-    bool loadFile( const char* fileName );
+    /// A layer of the network. The offsets are byte offsets in the network data.
+    struct NtcNetworkLayer
+    {
+        int inputChannels = -1;
+        int outputChannels = -1;
+        int weightOffset = -1;
+        int weightSize = 0;
+        int scaleOffset = -1;
+        int scaleSize = 0;
+        int biasOffset = -1;
+        int biasSize = 0;
+        std::string weightType;
+        std::string scaleType;
+        std::string biasType;
+    };
+
+    /// Load the header, texture set description and network weights of an .ntc file.  The latents
+    /// are not loaded; they are read on demand by readLatentRectUshort, copying them from a memory
+    /// mapping of the file if mapFile is true.  The file is kept open until close() is called.
+    /// Loading the file again after close() only reopens it, since the description is parsed once.
+    bool loadFile( const char* fileName, bool mapFile = true );
+
+    /// Close the file.  The latents can't be read until the file is loaded again.  Reads that are in
+    /// progress keep the file open until they finish.
+    void close();
 
     /// Make the latent texture for the current cuda context
     CUtexObject makeLatentTexture();
@@ -32,9 +60,19 @@ class NtcImageReader
     /// Get the texture inference data for this texture
     const InferenceDataOptix& getInferenceData() { return m_inferenceData; }
 
-    /// Read a rectangle from a mip level of the latent texture into dest on the host.
+    /// Read a rectangle from a mip level of the latent texture into dest on the host.  Only the rows
+    /// of the latent layers that overlap the rectangle are read from the file.  Threadsafe.
     bool readLatentRectUshort( uint16_t* dest, int mipLevel, int xstart, int ystart, int width, int height );
 
+    /// Get the network layers.
+    const std::vector<NtcNetworkLayer>& getNetworkLayers() const { return m_hNetwork; }
+
+    /// Get the row major network weights, followed by the scales and biases of the layers.
+    const std::vector<char>& getNetworkData() const { return m_hNetworkData; }
+
+    /// Get the number of latent bytes read from the file (or copied from its mapping).
+    unsigned long long getNumLatentBytesRead() const { return m_numLatentBytesRead; }
+
   private:
 
     struct NtcFileHeader
@@ -46,24 +84,13 @@ class NtcImageReader
         uint64_t dataOffset;
         uint64_t dataSize;
     };
-    
-    struct NtcNetworkLayer
-    {
-        int inputChannels = -1;
-        int outputChannels = -1;
-        int weightOffset = -1;
-        int weightSize = 0;
-        int scaleOffset = -1;
-        int scaleSize = 0;
-        int biasOffset = -1;
-        int biasSize = 0;
-        std::string weightType;
-        std::string scaleType;
-        std::string biasType;
-    };
 
     InferenceDataOptix m_inferenceData{};
-    std::vector<char> m_hDataChunk;
+    std::shared_ptr<const imageSource::ReadOnlyFile> m_file;  // Accessed atomically.
+    bool m_loaded = false;
+    uint64_t m_dataOffset = 0;
+    uint64_t m_dataSize = 0;
+    std::atomic<unsigned long long> m_numLatentBytesRead{ 0 };
     std::vector<int> m_hLatentMipOffsets;
     std::vector<int> m_hLatentMipSizes;
     std::vector<NtcNetworkLayer> m_hNetwork;
@@ -71,8 +98,11 @@ class NtcImageReader
 
     bool parseTextureSetDescription( rapidjson::Document& doc );
     bool parseLatentsDescription( rapidjson::Document& doc );
-    bool parseNetworkDescription( rapidjson::Document& doc );
+    bool parseNetworkDescription( const imageSource::ReadOnlyFile& file, rapidjson::Document& doc );
     uint32_t getColorSpace( rapidjson::Document& doc, int channelNum );
+
+    // Read size bytes at the offset in the data chunk of the file into dest.
+    bool readDataChunk( const imageSource::ReadOnlyFile& file, void* dest, uint64_t offset, uint64_t size );
     
     bool convertNetworkToOptixInferencingOptimal( OptixDeviceContext optixContext, CUdeviceptr d_srcNetworkData,
                                                   CUdeviceptr d_dstMatrix, int d_dstSize );
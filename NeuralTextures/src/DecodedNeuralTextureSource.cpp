@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <OptiXToolkit/Error/cuErrorCheck.h>
+#include <OptiXToolkit/NeuralTextures/DecodedNeuralTextureSource.h>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace neuralTextures {
+
+namespace {
+
+// Mip levels are decoded in bands of rows, so that they can be spread over threads.
+const unsigned int ROWS_PER_BAND = 16;
+
+// Call function(i) for i in [0, count), spreading the calls over threads if there are enough.
+template <typename Function>
+bool parallelFor( unsigned int count, const Function& function )
+{
+    const unsigned int numThreads = std::min( count, std::max( std::thread::hardware_concurrency(), 1u ) );
+    std::atomic<bool> satisfied( true );
+    std::atomic<unsigned int> next( 0 );
+    const auto worker = [&next, &satisfied, count, &function] {
+        for( unsigned int i = next++; i < count; i = next++ )
+        {
+            if( !function( i ) )
+                satisfied = false;
+        }
+    };
+    std::vector<std::thread> threads;
+    for( unsigned int i = 1; i < numThreads; ++i )
+        threads.emplace_back( worker );
+    worker();
+    for( std::thread& thread : threads )
+        thread.join();
+    return satisfied;
+}
+
+}  // namespace
+
+DecodedNeuralTextureSource::DecodedNeuralTextureSource( const std::string& filename, int textureIndex, NtcSimd simd )
+    : m_filename( filename )
+    , m_textureIndex( textureIndex )
+    , m_simd( simd )
+{
+}
+
+void DecodedNeuralTextureSource::open( imageSource::TextureInfo* info )
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    if( !m_isOpen )
+    {
+        std::string errString = "Could not open NTC image file " + m_filename;
+        OTK_ERROR_CHECK_MSG( !m_imageReader.loadFile( m_filename.c_str() ), errString.c_str() );
+        const InferenceDataOptix& infData = m_imageReader.getInferenceData();
+        OTK_ERROR_CHECK_MSG( m_textureIndex < 0 || m_textureIndex >= infData.numTextures,
+                             ( "No texture " + std::to_string( m_textureIndex ) + " in NTC image file " + m_filename ).c_str() );
+
+        if( !m_decoder )
+            m_decoder.reset( new NtcHostDecoder( m_imageReader, m_simd ) );
+        OTK_ERROR_CHECK_MSG( !m_decoder->isValid(), ( "Could not decode the network of NTC image file " + m_filename ).c_str() );
+
+        m_firstChannel = infData.texFirstChannel[m_textureIndex];
+        m_numChannels  = std::min( static_cast<int>( infData.texNumChannels[m_textureIndex] ), 4 );
+
+        m_info.width        = infData.constants.imageWidth;
+        m_info.height       = infData.constants.imageHeight;
+        m_info.format       = CU_AD_FORMAT_FLOAT;
+        m_info.numChannels  = 4;
+        m_info.numMipLevels = infData.constants.imageMips;
+        m_info.isValid      = true;
+        m_info.isTiled      = true;
+    }
+
+    m_isOpen = true;
+    if( info != nullptr )
+    {
+        *info = m_info;
+    }
+}
+
+void DecodedNeuralTextureSource::close()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_imageReader.close();
+    m_isOpen = false;
+}
+
+bool DecodedNeuralTextureSource::decodeRect( float4* dest, unsigned int rowPitch, unsigned int mipLevel, unsigned int xstart,
+                                             unsigned int ystart, unsigned int width, unsigned int height ) const
+{
+    std::vector<float> outputs( static_cast<size_t>( width ) * height * NTC_MLP_OUTPUT_CHANNELS );
+    if( !m_decoder->decodeRect( outputs.data(), mipLevel, xstart, ystart, width, height ) )
+        return false;
+
+    for( unsigned int y = 0; y < height; ++y )
+    {
+        for( unsigned int x = 0; x < width; ++x )
+        {
+            const float* texel = &outputs[( static_cast<size_t>( y ) * width + x ) * NTC_MLP_OUTPUT_CHANNELS + m_firstChannel];
+            float        pixel[4]{};
+            std::copy( texel, texel + m_numChannels, pixel );
+            dest[static_cast<size_t>( y ) * rowPitch + x] = float4{ pixel[0], pixel[1], pixel[2], pixel[3] };
+        }
+    }
+    return true;
+}
+
+bool DecodedNeuralTextureSource::readTile( char* dest, unsigned int mipLevel, const imageSource::Tile& tile, CUstream /*stream*/ )
+{
+    if( !m_isOpen || mipLevel >= m_info.numMipLevels )
+        return false;
+
+    // Clip the tile to the mip level, filling the rest of it with black.
+    float4* pixels = reinterpret_cast<float4*>( dest );
+    std::memset( pixels, 0, static_cast<size_t>( tile.width ) * tile.height * sizeof( float4 ) );
+    const unsigned int mipWidth  = std::max( m_info.width >> mipLevel, 1u );
+    const unsigned int mipHeight = std::max( m_info.height >> mipLevel, 1u );
+    const unsigned int xstart    = tile.x * tile.width;
+    const unsigned int ystart    = tile.y * tile.height;
+    if( xstart >= mipWidth || ystart >= mipHeight )
+        return true;
+    const unsigned int width  = std::min( tile.width, mipWidth - xstart );
+    const unsigned int height = std::min( tile.height, mipHeight - ystart );
+
+    if( !decodeRect( pixels, tile.width, mipLevel, xstart, ystart, width, height ) )
+        return false;
+    ++m_numTilesRead;
+    return true;
+}
+
+bool DecodedNeuralTextureSource::readTiles( char* const* dest, unsigned int mipLevel, const imageSource::Tile* tiles, unsigned int numTiles, CUstream stream )
+{
+    return parallelFor( numTiles, [this, dest, mipLevel, tiles, stream]( unsigned int i ) {
+        return readTile( dest[i], mipLevel, tiles[i], stream );
+    } );
+}
+
+bool DecodedNeuralTextureSource::readMipLevel( char* dest, unsigned int mipLevel, unsigned int expectedWidth, unsigned int expectedHeight, CUstream /*stream*/ )
+{
+    if( !m_isOpen || mipLevel >= m_info.numMipLevels )
+        return false;
+
+    const unsigned int mipWidth  = std::max( m_info.width >> mipLevel, 1u );
+    const unsigned int mipHeight = std::max( m_info.height >> mipLevel, 1u );
+    OTK_ASSERT( expectedWidth == mipWidth && expectedHeight == mipHeight );
+    (void)expectedWidth;
+    (void)expectedHeight;
+
+    float4*            pixels   = reinterpret_cast<float4*>( dest );
+    const unsigned int numBands = ( mipHeight + ROWS_PER_BAND - 1 ) / ROWS_PER_BAND;
+    return parallelFor( numBands, [this, pixels, mipLevel, mipWidth, mipHeight]( unsigned int band ) {
+        const unsigned int ystart = band * ROWS_PER_BAND;
+        const unsigned int height = std::min( ROWS_PER_BAND, mipHeight - ystart );
+        return decodeRect( pixels + static_cast<size_t>( ystart ) * mipWidth, mipWidth, mipLevel, 0, ystart, mipWidth, height );
+    } );
+}
+
+bool DecodedNeuralTextureSource::readBaseColor( float4& dest )
+{
+    if( !m_isOpen || m_info.numMipLevels == 0 )
+        return false;
+
+    // The base color is the 1x1 mip level, which not every texture set has.
+    const unsigned int lastLevel = m_info.numMipLevels - 1;
+    if( std::max( m_info.width >> lastLevel, 1u ) != 1 || std::max( m_info.height >> lastLevel, 1u ) != 1 )
+        return false;
+    return decodeRect( &dest, 1, lastLevel, 0, 0, 1, 1 );
+}
+
+}  // namespace neuralTextures
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -10,8 +10,9 @@
 
 namespace neuralTextures {
 
-NeuralTextureSource::NeuralTextureSource( const std::string& filename )
+NeuralTextureSource::NeuralTextureSource( const std::string& filename, bool mapFile )
     : m_filename( filename )
+    , m_mapFile( mapFile )
     , m_isOpen( false )
 {
 }
@@ -22,17 +23,22 @@ void NeuralTextureSource::open( imageSource::TextureInfo* info )
     if( !m_isOpen )
     {
         std::string errString = "Could not open NTC image file " + m_filename;
-        bool success = m_imageReader.loadFile( m_filename.c_str() );
+        bool success = m_imageReader.loadFile( m_filename.c_str(), m_mapFile );
         OTK_ERROR_CHECK_MSG( !success, errString.c_str() );
-        InferenceDataOptix infData = m_imageReader.getInferenceData();
-
-        m_latentsInfo.width        = infData.latentWidth;
-        m_latentsInfo.height       = infData.latentHeight;
-        m_latentsInfo.format       = CU_AD_FORMAT_UNSIGNED_INT16;
-        m_latentsInfo.numChannels  = ( infData.latentFeatures != 12 ) ? infData.latentFeatures / 4 : 4;
-        m_latentsInfo.numMipLevels = infData.numLatentMips;
-        m_latentsInfo.isValid      = true;
-        m_latentsInfo.isTiled      = true;
+
+        // The info is set once, since reads that overlap a close and reopen use it.
+        if( !m_latentsInfo.isValid )
+        {
+            InferenceDataOptix infData = m_imageReader.getInferenceData();
+
+            m_latentsInfo.width        = infData.latentWidth;
+            m_latentsInfo.height       = infData.latentHeight;
+            m_latentsInfo.format       = CU_AD_FORMAT_UNSIGNED_INT16;
+            m_latentsInfo.numChannels  = ( infData.latentFeatures != 12 ) ? infData.latentFeatures / 4 : 4;
+            m_latentsInfo.numMipLevels = infData.numLatentMips;
+            m_latentsInfo.isValid      = true;
+            m_latentsInfo.isTiled      = true;
+        }
     }
 
     m_isOpen = true;
@@ -42,6 +48,13 @@ void NeuralTextureSource::open( imageSource::TextureInfo* info )
     }
 }
 
+void NeuralTextureSource::close()
+{
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_imageReader.close();
+    m_isOpen = false;
+}
+
 bool NeuralTextureSource::readTile( char* dest, unsigned int latentMipLevel, const imageSource::Tile& tile, CUstream stream )
 {
     (void) stream;
@@ -0,0 +1,809 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <OptiXToolkit/NeuralTextures/NtcHostDecoder.h>
+
+#include <OptiXToolkit/ImageSource/HalfFloat.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined( __x86_64__ ) || defined( _M_X64 )
+#define NTC_HOST_X86
+#include <immintrin.h>
+#if defined( _MSC_VER ) && !defined( __clang__ )
+#include <intrin.h>
+#define NTC_TARGET( isa )  // MSVC compiles intrinsics for any instruction set
+#else
+#define NTC_TARGET( isa ) __attribute__( ( target( isa ) ) )
+#endif
+#endif
+
+#if defined( __aarch64__ ) || defined( _M_ARM64 )
+#define NTC_HOST_NEON
+#include <arm_neon.h>
+#endif
+
+namespace neuralTextures {
+
+namespace {
+
+// Maximum number of channels in a network layer
+const int MAX_LAYER_CHANNELS = 128;
+
+// HGELUClamp quantization constants, as in InferenceOptix.h
+const float HGELU_MIN = -3.f / 16.f;
+const float HGELU_MAX = 3.f;
+const int   HGELU_BINS = 256;
+const float HGELU_STEP = ( HGELU_MAX - HGELU_MIN ) / float( HGELU_BINS - 1 );
+const float HGELU_INV_STEP = 1.f / HGELU_STEP;
+const int   HGELU_QMAX = int( HGELU_MAX / HGELU_STEP );
+const int   HGELU_QMIN = HGELU_QMAX - HGELU_BINS + 1;
+const int   HGELU_BIAS = -( HGELU_BINS / 2 ) - HGELU_QMIN;
+
+uint32_t floatToBits( float f )
+{
+    uint32_t bits;
+    memcpy( &bits, &f, sizeof( bits ) );
+    return bits;
+}
+
+float bitsToFloat( uint32_t bits )
+{
+    float f;
+    memcpy( &f, &bits, sizeof( f ) );
+    return f;
+}
+
+// Round a float to the nearest integer, ties to even.  Adding 2^23 leaves no fraction bits, so
+// the addition rounds, which is faster than calling nearbyint.
+float roundToInteger( float f )
+{
+    const float magic = 8388608.f;
+    const float a = std::fabs( f );
+    return a < magic ? std::copysign( ( a + magic ) - magic, f ) : f;
+}
+
+// Round a float to the nearest half (fp16) value, ties to even.
+float roundToHalf( float f )
+{
+    const uint32_t sign = floatToBits( f ) & 0x80000000u;
+    uint32_t       bits = floatToBits( f ) & 0x7fffffffu;
+    if( bits >= 0x477ff000u )  // 65520 and above round to infinity
+        bits = 0x7f800000u;
+    else if( bits < 0x38800000u )  // Half subnormals are multiples of 2^-24
+        bits = floatToBits( roundToInteger( bitsToFloat( bits ) * 16777216.f ) / 16777216.f );
+    else
+        bits = ( bits + 0xfffu + ( ( bits >> 13 ) & 1u ) ) & 0xffffe000u;
+    return bitsToFloat( sign | bits );
+}
+
+// Round a float to the nearest FP8 E4M3 value, ties to even, saturating at +-448.
+float roundToE4M3( float f )
+{
+    const uint32_t sign = floatToBits( f ) & 0x80000000u;
+    uint32_t       bits = floatToBits( f ) & 0x7fffffffu;
+    if( bits < 0x3c800000u )  // E4M3 subnormals are multiples of 2^-9
+        bits = floatToBits( roundToInteger( bitsToFloat( bits ) * 512.f ) / 512.f );
+    else
+        bits = ( bits + 0x7ffffu + ( ( bits >> 20 ) & 1u ) ) & 0xfff00000u;
+    return bitsToFloat( sign | std::min( bits, floatToBits( 448.f ) ) );
+}
+
+float e4m3ToFloat( uint8_t value )
+{
+    const int   exponent = ( value >> 3 ) & 0xf;
+    const int   mantissa = value & 0x7;
+    const float sign     = ( value & 0x80 ) ? -1.f : 1.f;
+    if( exponent == 0xf && mantissa == 0x7 )  // NaN
+        return 0.f;
+    if( exponent == 0 )
+        return sign * std::ldexp( static_cast<float>( mantissa ), -9 );
+    return sign * std::ldexp( static_cast<float>( 8 + mantissa ), exponent - 10 );
+}
+
+float fracf( float x )
+{
+    return x - std::floor( x );
+}
+
+// Activation function of the hidden layers, in half precision with fused multiply-adds as on the device.
+float activate( float x, bool scaleActivation )
+{
+    const float oneThird = roundToHalf( 1.0f / 3.0f );
+    float       tmp      = std::min( std::max( roundToHalf( std::fma( x, oneThird, 0.5f ) ), 0.0f ), 1.0f );
+    float       result   = roundToHalf( std::min( x, 3.0f ) * tmp );
+    if( scaleActivation )
+        result = roundToHalf( std::fma( result, HGELU_INV_STEP, static_cast<float>( HGELU_BIAS ) ) );
+    return result;
+}
+
+// Find the latent texel at the corner before the texture coordinate, and the weight of the next texel,
+// as SampleLatentGrid does.
+int latentCorner( float uv, int latentSize, float* weight )
+{
+    const float d      = 1.0f / latentSize;
+    const float u      = uv - d * 0.5f;
+    const float corner = std::floor( u * latentSize );
+    *weight            = ( u - corner * d ) * latentSize;
+    return static_cast<int>( corner );
+}
+
+// Half bytes of a latent texel
+inline int halfByte( uint16_t latent, int idx )
+{
+    return ( latent >> ( 4 * idx ) ) & 0xf;
+}
+
+//------------------------------------------------------------------------------
+// Kernels evaluating the network layers.  matVec computes the matrix-vector product of a layer,
+// whose weights are stored with the outputs for each input together:
+//     outputs[n] = biases[n] + sum_k( weights[k * numOutputs + n] * inputs[k] )
+// The other kernels round values in place to the precisions of the device, and apply the
+// activation function of the hidden layers.  All of the kernels fuse their multiply-adds, summing
+// the products in the same order, so the vector kernels match the scalar ones exactly.
+
+void matVecTail( int start, const float* weights, const float* biases, const float* inputs, int numInputs, int numOutputs, float* outputs )
+{
+    for( int n = start; n < numOutputs; ++n )
+        outputs[n] = biases[n];
+    for( int k = 0; k < numInputs; ++k )
+    {
+        const float* w = weights + k * numOutputs;
+        for( int n = start; n < numOutputs; ++n )
+            outputs[n] = std::fma( w[n], inputs[k], outputs[n] );
+    }
+}
+
+void matVecScalar( const float* weights, const float* biases, const float* inputs, int numInputs, int numOutputs, float* outputs )
+{
+    matVecTail( 0, weights, biases, inputs, numInputs, numOutputs, outputs );
+}
+
+void roundToHalfScalar( float* values, int count )
+{
+    for( int i = 0; i < count; ++i )
+        values[i] = roundToHalf( values[i] );
+}
+
+void roundToE4M3Scalar( float* values, int count )
+{
+    for( int i = 0; i < count; ++i )
+        values[i] = roundToE4M3( values[i] );
+}
+
+void activateScalar( float* values, int count, bool scaleActivation )
+{
+    for( int i = 0; i < count; ++i )
+        values[i] = activate( roundToHalf( values[i] ), scaleActivation );
+}
+
+#ifdef NTC_HOST_X86
+
+// CPUs with AVX2 and FMA also have F16C.
+#define NTC_TARGET_AVX2 NTC_TARGET( "avx2,fma,f16c" )
+#define NTC_TARGET_AVX512 NTC_TARGET( "avx512f" )
+
+NTC_TARGET_AVX2
+void matVecAvx2( const float* weights, const float* biases, const float* inputs, int numInputs, int numOutputs, float* outputs )
+{
+    // Accumulate 32 outputs at a time, so that the fused multiply-adds are independent.
+    int n = 0;
+    for( ; n + 32 <= numOutputs; n += 32 )
+    {
+        __m256 sum0 = _mm256_loadu_ps( biases + n );
+        __m256 sum1 = _mm256_loadu_ps( biases + n + 8 );
+        __m256 sum2 = _mm256_loadu_ps( biases + n + 16 );
+        __m256 sum3 = _mm256_loadu_ps( biases + n + 24 );
+        for( int k = 0; k < numInputs; ++k )
+        {
+            const float* w = weights + k * numOutputs + n;
+            const __m256 x = _mm256_set1_ps( inputs[k] );
+            sum0 = _mm256_fmadd_ps( _mm256_loadu_ps( w ), x, sum0 );
+            sum1 = _mm256_fmadd_ps( _mm256_loadu_ps( w + 8 ), x, sum1 );
+            sum2 = _mm256_fmadd_ps( _mm256_loadu_ps( w + 16 ), x, sum2 );
+            sum3 = _mm256_fmadd_ps( _mm256_loadu_ps( w + 24 ), x, sum3 );
+        }
+        _mm256_storeu_ps( outputs + n, sum0 );
+        _mm256_storeu_ps( outputs + n + 8, sum1 );
+        _mm256_storeu_ps( outputs + n + 16, sum2 );
+        _mm256_storeu_ps( outputs + n + 24, sum3 );
+    }
+    for( ; n + 8 <= numOutputs; n += 8 )
+    {
+        __m256 sum = _mm256_loadu_ps( biases + n );
+        for( int k = 0; k < numInputs; ++k )
+            sum = _mm256_fmadd_ps( _mm256_loadu_ps( weights + k * numOutputs + n ), _mm256_set1_ps( inputs[k] ), sum );
+        _mm256_storeu_ps( outputs + n, sum );
+    }
+    matVecTail( n, weights, biases, inputs, numInputs, numOutputs, outputs );
+}
+
+NTC_TARGET_AVX2
+inline __m256 roundToHalfAvx2( __m256 x )
+{
+    return _mm256_cvtph_ps( _mm256_cvtps_ph( x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ) );
+}
+
+NTC_TARGET_AVX2
+void roundToHalfAvx2( float* values, int count )
+{
+    int i = 0;
+    for( ; i + 8 <= count; i += 8 )
+        _mm256_storeu_ps( values + i, roundToHalfAvx2( _mm256_loadu_ps( values + i ) ) );
+    roundToHalfScalar( values + i, count - i );
+}
+
+NTC_TARGET_AVX2
+void roundToE4M3Avx2( float* values, int count )
+{
+    const __m256  signMask = _mm256_set1_ps( -0.0f );
+    const __m256  magic    = _mm256_set1_ps( 8388608.f );
+    const __m256i one      = _mm256_set1_epi32( 1 );
+    int i = 0;
+    for( ; i + 8 <= count; i += 8 )
+    {
+        const __m256 x = _mm256_loadu_ps( values + i );
+        const __m256 a = _mm256_andnot_ps( signMask, x );
+
+        // Normal values keep 3 mantissa bits, and subnormals are multiples of 2^-9.
+        __m256i bits = _mm256_castps_si256( a );
+        __m256i odd = _mm256_and_si256( _mm256_srli_epi32( bits, 20 ), one );
+        bits = _mm256_add_epi32( bits, _mm256_add_epi32( _mm256_set1_epi32( 0x7ffff ), odd ) );
+        const __m256 normal = _mm256_castsi256_ps( _mm256_and_si256( bits, _mm256_set1_epi32( static_cast<int>( 0xfff00000u ) ) ) );
+        const __m256 subnormal = _mm256_mul_ps( _mm256_sub_ps( _mm256_add_ps( _mm256_mul_ps( a, _mm256_set1_ps( 512.f ) ), magic ), magic ),
+                                                _mm256_set1_ps( 1.f / 512.f ) );
+        __m256 result = _mm256_blendv_ps( normal, subnormal, _mm256_cmp_ps( a, _mm256_set1_ps( 1.f / 64.f ), _CMP_LT_OQ ) );
+        result = _mm256_min_ps( result, _mm256_set1_ps( 448.f ) );
+        _mm256_storeu_ps( values + i, _mm256_or_ps( result, _mm256_and_ps( x, signMask ) ) );
+    }
+    roundToE4M3Scalar( values + i, count - i );
+}
+
+NTC_TARGET_AVX2
+void activateAvx2( float* values, int count, bool scaleActivation )
+{
+    const __m256 oneThird = _mm256_set1_ps( roundToHalf( 1.0f / 3.0f ) );
+    int i = 0;
+    for( ; i + 8 <= count; i += 8 )
+    {
+        const __m256 x = roundToHalfAvx2( _mm256_loadu_ps( values + i ) );
+        __m256 tmp = roundToHalfAvx2( _mm256_fmadd_ps( x, oneThird, _mm256_set1_ps( 0.5f ) ) );
+        tmp = _mm256_min_ps( _mm256_max_ps( tmp, _mm256_setzero_ps() ), _mm256_set1_ps( 1.0f ) );
+        __m256 result = roundToHalfAvx2( _mm256_mul_ps( _mm256_min_ps( x, _mm256_set1_ps( 3.0f ) ), tmp ) );
+        if( scaleActivation )
+            result = roundToHalfAvx2( _mm256_fmadd_ps( result, _mm256_set1_ps( HGELU_INV_STEP ),
+                                                       _mm256_set1_ps( static_cast<float>( HGELU_BIAS ) ) ) );
+        _mm256_storeu_ps( values + i, result );
+    }
+    activateScalar( values + i, count - i, scaleActivation );
+}
+
+// GCC warns of uninitialized values in its AVX-512 intrinsics.
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+NTC_TARGET_AVX512
+void matVecAvx512( const float* weights, const float* biases, const float* inputs, int numInputs, int numOutputs, float* outputs )
+{
+    // Accumulate 64 outputs at a time, so that the fused multiply-adds are independent.
+    int n = 0;
+    for( ; n + 64 <= numOutputs; n += 64 )
+    {
+        __m512 sum0 = _mm512_loadu_ps( biases + n );
+        __m512 sum1 = _mm512_loadu_ps( biases + n + 16 );
+        __m512 sum2 = _mm512_loadu_ps( biases + n + 32 );
+        __m512 sum3 = _mm512_loadu_ps( biases + n + 48 );
+        for( int k = 0; k < numInputs; ++k )
+        {
+            const float* w = weights + k * numOutputs + n;
+            const __m512 x = _mm512_set1_ps( inputs[k] );
+            sum0 = _mm512_fmadd_ps( _mm512_loadu_ps( w ), x, sum0 );
+            sum1 = _mm512_fmadd_ps( _mm512_loadu_ps( w + 16 ), x, sum1 );
+            sum2 = _mm512_fmadd_ps( _mm512_loadu_ps( w + 32 ), x, sum2 );
+            sum3 = _mm512_fmadd_ps( _mm512_loadu_ps( w + 48 ), x, sum3 );
+        }
+        _mm512_storeu_ps( outputs + n, sum0 );
+        _mm512_storeu_ps( outputs + n + 16, sum1 );
+        _mm512_storeu_ps( outputs + n + 32, sum2 );
+        _mm512_storeu_ps( outputs + n + 48, sum3 );
+    }
+    for( ; n + 16 <= numOutputs; n += 16 )
+    {
+        __m512 sum = _mm512_loadu_ps( biases + n );
+        for( int k = 0; k < numInputs; ++k )
+            sum = _mm512_fmadd_ps( _mm512_loadu_ps( weights + k * numOutputs + n ), _mm512_set1_ps( inputs[k] ), sum );
+        _mm512_storeu_ps( outputs + n, sum );
+    }
+    matVecTail( n, weights, biases, inputs, numInputs, numOutputs, outputs );
+}
+
+NTC_TARGET_AVX512
+inline __m512 roundToHalfAvx512( __m512 x )
+{
+    return _mm512_cvtph_ps( _mm512_cvtps_ph( x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ) );
+}
+
+NTC_TARGET_AVX512
+void roundToHalfAvx512( float* values, int count )
+{
+    int i = 0;
+    for( ; i + 16 <= count; i += 16 )
+        _mm512_storeu_ps( values + i, roundToHalfAvx512( _mm512_loadu_ps( values + i ) ) );
+    roundToHalfScalar( values + i, count - i );
+}
+
+NTC_TARGET_AVX512
+void roundToE4M3Avx512( float* values, int count )
+{
+    const __m512i signMask = _mm512_set1_epi32( static_cast<int>( 0x80000000u ) );
+    const __m512  magic    = _mm512_set1_ps( 8388608.f );
+    const __m512i one      = _mm512_set1_epi32( 1 );
+    int i = 0;
+    for( ; i + 16 <= count; i += 16 )
+    {
+        const __m512i x = _mm512_castps_si512( _mm512_loadu_ps( values + i ) );
+        const __m512i sign = _mm512_and_si512( x, signMask );
+        const __m512  a = _mm512_castsi512_ps( _mm512_andnot_si512( signMask, x ) );
+
+        // Normal values keep 3 mantissa bits, and subnormals are multiples of 2^-9.
+        __m512i bits = _mm512_castps_si512( a );
+        __m512i odd = _mm512_and_si512( _mm512_srli_epi32( bits, 20 ), one );
+        bits = _mm512_add_epi32( bits, _mm512_add_epi32( _mm512_set1_epi32( 0x7ffff ), odd ) );
+        const __m512 normal = _mm512_castsi512_ps( _mm512_and_si512( bits, _mm512_set1_epi32( static_cast<int>( 0xfff00000u ) ) ) );
+        const __m512 subnormal = _mm512_mul_ps( _mm512_sub_ps( _mm512_add_ps( _mm512_mul_ps( a, _mm512_set1_ps( 512.f ) ), magic ), magic ),
+                                                _mm512_set1_ps( 1.f / 512.f ) );
+        __m512 result = _mm512_mask_blend_ps( _mm512_cmp_ps_mask( a, _mm512_set1_ps( 1.f / 64.f ), _CMP_LT_OQ ), normal, subnormal );
+        result = _mm512_min_ps( result, _mm512_set1_ps( 448.f ) );
+        _mm512_storeu_ps( values + i, _mm512_castsi512_ps( _mm512_or_si512( _mm512_castps_si512( result ), sign ) ) );
+    }
+    roundToE4M3Scalar( values + i, count - i );
+}
+
+NTC_TARGET_AVX512
+void activateAvx512( float* values, int count, bool scaleActivation )
+{
+    const __m512 oneThird = _mm512_set1_ps( roundToHalf( 1.0f / 3.0f ) );
+    int i = 0;
+    for( ; i + 16 <= count; i += 16 )
+    {
+        const __m512 x = roundToHalfAvx512( _mm512_loadu_ps( values + i ) );
+        __m512 tmp = roundToHalfAvx512( _mm512_fmadd_ps( x, oneThird, _mm512_set1_ps( 0.5f ) ) );
+        tmp = _mm512_min_ps( _mm512_max_ps( tmp, _mm512_setzero_ps() ), _mm512_set1_ps( 1.0f ) );
+        __m512 result = roundToHalfAvx512( _mm512_mul_ps( _mm512_min_ps( x, _mm512_set1_ps( 3.0f ) ), tmp ) );
+        if( scaleActivation )
+            result = roundToHalfAvx512( _mm512_fmadd_ps( result, _mm512_set1_ps( HGELU_INV_STEP ),
+                                                         _mm512_set1_ps( static_cast<float>( HGELU_BIAS ) ) ) );
+        _mm512_storeu_ps( values + i, result );
+    }
+    activateScalar( values + i, count - i, scaleActivation );
+}
+
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic pop
+#endif
+
+bool getX86Features( bool* avx2, bool* avx512 )
+{
+#if defined( _MSC_VER ) && !defined( __clang__ )
+    int info[4];
+    __cpuid( info, 0 );
+    const int maxLeaf = info[0];
+    __cpuid( info, 1 );
+    const bool osxsave = ( info[2] & ( 1 << 27 ) ) != 0;
+    const bool fma     = ( info[2] & ( 1 << 12 ) ) != 0;
+    const bool f16c    = ( info[2] & ( 1 << 29 ) ) != 0;
+    if( !osxsave || maxLeaf < 7 )
+        return false;
+    const unsigned long long xcr0 = _xgetbv( 0 );
+    __cpuidex( info, 7, 0 );
+    *avx2   = fma && f16c && ( xcr0 & 0x6 ) == 0x6 && ( info[1] & ( 1 << 5 ) ) != 0;
+    *avx512 = ( xcr0 & 0xe6 ) == 0xe6 && ( info[1] & ( 1 << 16 ) ) != 0;
+#else
+    __builtin_cpu_init();
+    *avx2   = __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" );
+    *avx512 = __builtin_cpu_supports( "avx512f" );
+#endif
+    return true;
+}
+
+#endif  // NTC_HOST_X86
+
+#ifdef NTC_HOST_NEON
+
+void matVecNeon( const float* weights, const float* biases, const float* inputs, int numInputs, int numOutputs, float* outputs )
+{
+    // Accumulate 16 outputs at a time, so that the fused multiply-adds are independent.
+    int n = 0;
+    for( ; n + 16 <= numOutputs; n += 16 )
+    {
+        float32x4_t sum0 = vld1q_f32( biases + n );
+        float32x4_t sum1 = vld1q_f32( biases + n + 4 );
+        float32x4_t sum2 = vld1q_f32( biases + n + 8 );
+        float32x4_t sum3 = vld1q_f32( biases + n + 12 );
+        for( int k = 0; k < numInputs; ++k )
+        {
+            const float* w = weights + k * numOutputs + n;
+            const float  x = inputs[k];
+            sum0 = vfmaq_n_f32( sum0, vld1q_f32( w ), x );
+            sum1 = vfmaq_n_f32( sum1, vld1q_f32( w + 4 ), x );
+            sum2 = vfmaq_n_f32( sum2, vld1q_f32( w + 8 ), x );
+            sum3 = vfmaq_n_f32( sum3, vld1q_f32( w + 12 ), x );
+        }
+        vst1q_f32( outputs + n, sum0 );
+        vst1q_f32( outputs + n + 4, sum1 );
+        vst1q_f32( outputs + n + 8, sum2 );
+        vst1q_f32( outputs + n + 12, sum3 );
+    }
+    for( ; n + 4 <= numOutputs; n += 4 )
+    {
+        float32x4_t sum = vld1q_f32( biases + n );
+        for( int k = 0; k < numInputs; ++k )
+            sum = vfmaq_n_f32( sum, vld1q_f32( weights + k * numOutputs + n ), inputs[k] );
+        vst1q_f32( outputs + n, sum );
+    }
+    matVecTail( n, weights, biases, inputs, numInputs, numOutputs, outputs );
+}
+
+inline float32x4_t roundToHalfNeon( float32x4_t x )
+{
+    return vcvt_f32_f16( vcvt_f16_f32( x ) );
+}
+
+void roundToHalfNeon( float* values, int count )
+{
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 )
+        vst1q_f32( values + i, roundToHalfNeon( vld1q_f32( values + i ) ) );
+    roundToHalfScalar( values + i, count - i );
+}
+
+void roundToE4M3Neon( float* values, int count )
+{
+    const uint32x4_t  signMask = vdupq_n_u32( 0x80000000u );
+    const float32x4_t magic    = vdupq_n_f32( 8388608.f );
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 )
+    {
+        const uint32x4_t  x = vreinterpretq_u32_f32( vld1q_f32( values + i ) );
+        const float32x4_t a = vreinterpretq_f32_u32( vbicq_u32( x, signMask ) );
+
+        // Normal values keep 3 mantissa bits, and subnormals are multiples of 2^-9.
+        uint32x4_t bits = vreinterpretq_u32_f32( a );
+        bits = vaddq_u32( bits, vaddq_u32( vdupq_n_u32( 0x7ffffu ), vandq_u32( vshrq_n_u32( bits, 20 ), vdupq_n_u32( 1 ) ) ) );
+        const float32x4_t normal = vreinterpretq_f32_u32( vandq_u32( bits, vdupq_n_u32( 0xfff00000u ) ) );
+        const float32x4_t subnormal = vmulq_n_f32( vsubq_f32( vaddq_f32( vmulq_n_f32( a, 512.f ), magic ), magic ), 1.f / 512.f );
+        float32x4_t result = vbslq_f32( vcltq_f32( a, vdupq_n_f32( 1.f / 64.f ) ), subnormal, normal );
+        result = vminq_f32( result, vdupq_n_f32( 448.f ) );
+        vst1q_f32( values + i, vreinterpretq_f32_u32( vorrq_u32( vreinterpretq_u32_f32( result ), vandq_u32( x, signMask ) ) ) );
+    }
+    roundToE4M3Scalar( values + i, count - i );
+}
+
+void activateNeon( float* values, int count, bool scaleActivation )
+{
+    const float oneThird = roundToHalf( 1.0f / 3.0f );
+    int i = 0;
+    for( ; i + 4 <= count; i += 4 )
+    {
+        const float32x4_t x = roundToHalfNeon( vld1q_f32( values + i ) );
+        float32x4_t tmp = roundToHalfNeon( vfmaq_n_f32( vdupq_n_f32( 0.5f ), x, oneThird ) );
+        tmp = vminq_f32( vmaxq_f32( tmp, vdupq_n_f32( 0.0f ) ), vdupq_n_f32( 1.0f ) );
+        float32x4_t result = roundToHalfNeon( vmulq_f32( vminq_f32( x, vdupq_n_f32( 3.0f ) ), tmp ) );
+        if( scaleActivation )
+            result = roundToHalfNeon( vfmaq_n_f32( vdupq_n_f32( static_cast<float>( HGELU_BIAS ) ), result, HGELU_INV_STEP ) );
+        vst1q_f32( values + i, result );
+    }
+    activateScalar( values + i, count - i, scaleActivation );
+}
+
+#endif  // NTC_HOST_NEON
+
+}  // namespace
+
+struct NtcHostDecoder::Kernels
+{
+    void ( *matVec )( const float* weights, const float* biases, const float* inputs, int numInputs, int numOutputs, float* outputs );
+    void ( *roundToHalf )( float* values, int count );
+    void ( *roundToE4M3 )( float* values, int count );
+    void ( *activate )( float* values, int count, bool scaleActivation );
+};
+
+bool isNtcSimdSupported( NtcSimd simd )
+{
+#ifdef NTC_HOST_X86
+    bool avx2 = false;
+    bool avx512 = false;
+    getX86Features( &avx2, &avx512 );
+#endif
+
+    switch( simd )
+    {
+        case NtcSimd::SCALAR:
+        case NtcSimd::BEST:
+            return true;
+#ifdef NTC_HOST_NEON
+        case NtcSimd::NEON:
+            return true;
+#endif
+#ifdef NTC_HOST_X86
+        case NtcSimd::AVX2:
+            return avx2;
+        case NtcSimd::AVX512:
+            return avx512;
+#endif
+        default:
+            return false;
+    }
+}
+
+NtcSimd getBestNtcSimd()
+{
+    for( NtcSimd simd : { NtcSimd::AVX512, NtcSimd::AVX2, NtcSimd::NEON } )
+    {
+        if( isNtcSimdSupported( simd ) )
+            return simd;
+    }
+    return NtcSimd::SCALAR;
+}
+
+NtcHostDecoder::NtcHostDecoder( NtcImageReader& reader, NtcSimd simd )
+    : m_reader( reader )
+    , m_simd( ( simd != NtcSimd::BEST && isNtcSimdSupported( simd ) ) ? simd : getBestNtcSimd() )
+{
+    static const Kernels scalarKernels{ matVecScalar, roundToHalfScalar, roundToE4M3Scalar, activateScalar };
+    m_kernels = &scalarKernels;
+#ifdef NTC_HOST_X86
+    static const Kernels avx2Kernels{ matVecAvx2, roundToHalfAvx2, roundToE4M3Avx2, activateAvx2 };
+    static const Kernels avx512Kernels{ matVecAvx512, roundToHalfAvx512, roundToE4M3Avx512, activateAvx512 };
+    if( m_simd == NtcSimd::AVX2 )
+        m_kernels = &avx2Kernels;
+    else if( m_simd == NtcSimd::AVX512 )
+        m_kernels = &avx512Kernels;
+#endif
+#ifdef NTC_HOST_NEON
+    static const Kernels neonKernels{ matVecNeon, roundToHalfNeon, roundToE4M3Neon, activateNeon };
+    if( m_simd == NtcSimd::NEON )
+        m_kernels = &neonKernels;
+#endif
+    m_isValid = loadNetwork();
+}
+
+bool NtcHostDecoder::loadNetwork()
+{
+    // The hidden layers have FP8 weights and half biases.  The output layer has int8 weights,
+    // int32 biases and float scales.
+    const std::vector<NtcImageReader::NtcNetworkLayer>& layers = m_reader.getNetworkLayers();
+    const std::vector<char>& data = m_reader.getNetworkData();
+    if( layers.size() < 2 || layers[0].inputChannels != NTC_MLP_INPUT_CHANNELS )
+        return false;
+
+    m_layers.resize( layers.size() );
+    for( unsigned int i = 0; i < layers.size(); ++i )
+    {
+        const NtcImageReader::NtcNetworkLayer& src = layers[i];
+        Layer& layer = m_layers[i];
+        const bool isOutputLayer = ( i == layers.size() - 1 );
+        const int  K = layer.inputChannels = src.inputChannels;
+        const int  N = layer.outputChannels = src.outputChannels;
+
+        if( K <= 0 || N <= 0 || K > MAX_LAYER_CHANNELS || N > MAX_LAYER_CHANNELS || ( i > 0 && K != layers[i - 1].outputChannels ) )
+            return false;
+        if( isOutputLayer && N > NTC_MLP_OUTPUT_CHANNELS )
+            return false;
+        if( src.weightType != ( isOutputLayer ? "Int8" : "FloatE4M3" ) || src.weightOffset < 0 || src.weightSize != N * K
+            || src.weightOffset + src.weightSize > static_cast<int>( data.size() ) )
+            return false;
+
+        // Transpose the row major weights.
+        const uint8_t* weights = reinterpret_cast<const uint8_t*>( &data[src.weightOffset] );
+        layer.weights.resize( N * K );
+        for( int n = 0; n < N; ++n )
+        {
+            for( int k = 0; k < K; ++k )
+            {
+                const uint8_t w = weights[n * K + k];
+                layer.weights[k * N + n] = isOutputLayer ? static_cast<float>( static_cast<int8_t>( w ) ) : e4m3ToFloat( w );
+            }
+        }
+
+        const int biasElementSize = isOutputLayer ? 4 : 2;
+        if( src.biasType != ( isOutputLayer ? "Int32" : "Float16" ) || src.biasOffset < 0 || src.biasSize != N * biasElementSize
+            || src.biasOffset + src.biasSize > static_cast<int>( data.size() ) )
+            return false;
+        layer.biases.resize( N, 0.0f );
+        for( int n = 0; n < N; ++n )
+        {
+            if( isOutputLayer )
+            {
+                int32_t bias;
+                memcpy( &bias, &data[src.biasOffset + n * 4], sizeof( bias ) );
+                layer.intBiases.push_back( bias );
+            }
+            else
+            {
+                uint16_t bias;
+                memcpy( &bias, &data[src.biasOffset + n * 2], sizeof( bias ) );
+                layer.biases[n] = imageSource::halfToFloat( bias );
+            }
+        }
+
+        if( isOutputLayer )
+        {
+            if( src.scaleType != "Float32" || src.scaleOffset < 0 || src.scaleSize != N * 4
+                || src.scaleOffset + src.scaleSize > static_cast<int>( data.size() ) )
+                return false;
+            layer.scales.resize( N );
+            memcpy( layer.scales.data(), &data[src.scaleOffset], src.scaleSize );
+        }
+    }
+    return true;
+}
+
+bool NtcHostDecoder::readLatents( LatentRect& rect, int latentMip, int mipWidth, int mipHeight, int xstart, int ystart, int width, int height ) const
+{
+    const InferenceDataOptix& infData = m_reader.getInferenceData();
+    rect.mipWidth = std::max( infData.latentWidth >> latentMip, 1 );
+    rect.mipHeight = std::max( infData.latentHeight >> latentMip, 1 );
+
+    // Find the latents sampled by the corner texels.  Rows of the image are flipped on the latent grid.
+    float weight;
+    const int texelTop = mipHeight - 1 - ystart;
+    const int texelBottom = mipHeight - ystart - height;
+    const int x0 = latentCorner( ( xstart + 0.5f ) / mipWidth, rect.mipWidth, &weight );
+    const int x1 = latentCorner( ( xstart + width - 0.5f ) / mipWidth, rect.mipWidth, &weight ) + 1;
+    const int y0 = latentCorner( ( texelBottom + 0.5f ) / mipHeight, rect.mipHeight, &weight );
+    const int y1 = latentCorner( ( texelTop + 0.5f ) / mipHeight, rect.mipHeight, &weight ) + 1;
+
+    rect.xstart = std::min( std::max( x0, 0 ), rect.mipWidth - 1 );
+    rect.ystart = std::min( std::max( y0, 0 ), rect.mipHeight - 1 );
+    rect.width = std::min( std::max( x1, 0 ), rect.mipWidth - 1 ) - rect.xstart + 1;
+    rect.height = std::min( std::max( y1, 0 ), rect.mipHeight - 1 ) - rect.ystart + 1;
+
+    const int numLatentTextures = infData.latentFeatures / NTC_FEATURES_PER_LAYER;
+    rect.pixelStride = ( numLatentTextures != 3 ) ? numLatentTextures : 4;
+    rect.latents.assign( static_cast<size_t>( rect.width ) * rect.height * rect.pixelStride, 0 );
+    return m_reader.readLatentRectUshort( rect.latents.data(), latentMip, rect.xstart, rect.ystart, rect.width, rect.height );
+}
+
+void NtcHostDecoder::prepareInputs( float* inputs, const LatentRect* latents, int mipLevel, int mipWidth, int mipHeight, int x, int y ) const
+{
+    const InferenceDataOptix& infData = m_reader.getInferenceData();
+    const NtcColorMipConstants& colorMip = infData.constants.colorMips[mipLevel];
+    const int texelX = x;
+    const int texelY = mipHeight - 1 - y;
+    const float u = ( texelX + 0.5f ) / mipWidth;
+    const float v = ( texelY + 0.5f ) / mipHeight;
+
+    std::fill( inputs, inputs + NTC_MLP_INPUT_CHANNELS, 0.0f );
+
+    // Bilinearly interpolate the features of the two latent mip levels, converting the
+    // half bytes with range [0 .. 15] to [-1.0 .. 1.0]
+    const float scale = 2.0f / 15.0f;
+    const float bias = -1.0f;
+    const int numLayers = std::min( infData.latentFeatures, NTC_MLP_FEATURES ) / NTC_FEATURES_PER_LAYER;
+    for( int level = 0; level < 2; ++level )
+    {
+        const LatentRect& rect = latents[level];
+        float wx, wy;
+        const int cx = latentCorner( u, rect.mipWidth, &wx );
+        const int cy = latentCorner( v, rect.mipHeight, &wy );
+        const int x0 = std::min( std::max( cx, rect.xstart ), rect.xstart + rect.width - 1 ) - rect.xstart;
+        const int x1 = std::min( std::max( cx + 1, rect.xstart ), rect.xstart + rect.width - 1 ) - rect.xstart;
+        const int y0 = std::min( std::max( cy, rect.ystart ), rect.ystart + rect.height - 1 ) - rect.ystart;
+        const int y1 = std::min( std::max( cy + 1, rect.ystart ), rect.ystart + rect.height - 1 ) - rect.ystart;
+
+        const uint16_t* s00 = &rect.latents[( y0 * rect.width + x0 ) * rect.pixelStride];
+        const uint16_t* s10 = &rect.latents[( y0 * rect.width + x1 ) * rect.pixelStride];
+        const uint16_t* s01 = &rect.latents[( y1 * rect.width + x0 ) * rect.pixelStride];
+        const uint16_t* s11 = &rect.latents[( y1 * rect.width + x1 ) * rect.pixelStride];
+
+        const float w00 = ( 1.0f - wx ) * ( 1.0f - wy );
+        const float w10 = wx * ( 1.0f - wy );
+        const float w01 = ( 1.0f - wx ) * wy;
+        const float w11 = wx * wy;
+
+        float* features = inputs + level * NTC_MLP_FEATURES;
+        for( int layer = 0; layer < numLayers; ++layer )
+        {
+            for( int i = 0; i < NTC_FEATURES_PER_LAYER; ++i )
+            {
+                features[layer * NTC_FEATURES_PER_LAYER + i] =
+                    scale * ( w00 * halfByte( s00[layer], i ) + w10 * halfByte( s10[layer], i )
+                              + w01 * halfByte( s01[layer], i ) + w11 * halfByte( s11[layer], i ) ) + bias;
+            }
+        }
+    }
+
+    // Encode the sample position
+    float* encoding = inputs + 2 * NTC_MLP_FEATURES;
+    float posx = texelX * colorMip.positionScale;
+    float posy = texelY * colorMip.positionScale;
+    for( int wave = 0; wave < NTC_MLP_POS_ENC_WAVES; ++wave )
+    {
+        encoding[0] = fracf( posx ) * 2 - 1;
+        encoding[1] = fracf( posy ) * 2 - 1;
+        encoding[2] = fracf( posx + 0.25f ) * 2 - 1;
+        encoding[3] = fracf( posy + 0.25f ) * 2 - 1;
+        encoding += 4;
+        posx *= 2.f;
+        posy *= 2.f;
+    }
+    encoding[0] = colorMip.positionLod;
+    encoding[1] = colorMip.positionLod;
+
+    // The network inputs are half values.
+    m_kernels->roundToHalf( inputs, NTC_MLP_INPUT_CHANNELS );
+}
+
+void NtcHostDecoder::evaluateNetwork( const float* inputs, float* outputs ) const
+{
+    float layerInputs[MAX_LAYER_CHANNELS];
+    float layerOutputs[MAX_LAYER_CHANNELS];
+    std::copy( inputs, inputs + NTC_MLP_INPUT_CHANNELS, layerInputs );
+
+    // The hidden layers convert their inputs to FP8, and their outputs are half values.  The
+    // activation of the last hidden layer is scaled to the range of the output layer's int8 inputs.
+    const int numHiddenLayers = static_cast<int>( m_layers.size() ) - 1;
+    for( int i = 0; i < numHiddenLayers; ++i )
+    {
+        const Layer& layer = m_layers[i];
+        m_kernels->roundToE4M3( layerInputs, layer.inputChannels );
+        m_kernels->matVec( layer.weights.data(), layer.biases.data(), layerInputs, layer.inputChannels, layer.outputChannels, layerOutputs );
+        m_kernels->activate( layerOutputs, layer.outputChannels, i == numHiddenLayers - 1 );
+        std::copy( layerOutputs, layerOutputs + layer.outputChannels, layerInputs );
+    }
+
+    // The output layer multiplies int8 values, which are summed exactly in floats.
+    const Layer& layer = m_layers.back();
+    for( int k = 0; k < layer.inputChannels; ++k )
+        layerInputs[k] = std::min( std::max( roundToInteger( layerInputs[k] ), -128.0f ), 127.0f );
+    m_kernels->matVec( layer.weights.data(), layer.biases.data(), layerInputs, layer.inputChannels, layer.outputChannels, layerOutputs );
+    for( int n = 0; n < NTC_MLP_OUTPUT_CHANNELS; ++n )
+    {
+        outputs[n] = ( n < layer.outputChannels ) ?
+            static_cast<float>( static_cast<int>( layerOutputs[n] ) + layer.intBiases[n] ) * layer.scales[n] : 0.0f;
+    }
+}
+
+bool NtcHostDecoder::decodeRect( float* dest, int mipLevel, int xstart, int ystart, int width, int height ) const
+{
+    const InferenceDataOptix& infData = m_reader.getInferenceData();
+    const NtcTextureSetConstants& tsc = infData.constants;
+    if( !m_isValid || mipLevel < 0 || mipLevel >= tsc.imageMips )
+        return false;
+
+    const int mipWidth = std::max( tsc.imageWidth >> mipLevel, 1 );
+    const int mipHeight = std::max( tsc.imageHeight >> mipLevel, 1 );
+    width = std::min( width, mipWidth - xstart );
+    height = std::min( height, mipHeight - ystart );
+    if( xstart < 0 || ystart < 0 || width <= 0 || height <= 0 )
+        return xstart >= 0 && ystart >= 0;
+
+    // Read the latents of the rectangle from the neural mip level and the one after it.
+    const int neuralMip = tsc.colorMips[mipLevel].neuralMip;
+    LatentRect latents[2];
+    for( int level = 0; level < 2; ++level )
+    {
+        const int latentMip = std::min( neuralMip + level, infData.numLatentMips - 1 );
+        if( !readLatents( latents[level], latentMip, mipWidth, mipHeight, xstart, ystart, width, height ) )
+            return false;
+    }
+
+    float inputs[NTC_MLP_INPUT_CHANNELS];
+    for( int y = 0; y < height; ++y )
+    {
+        for( int x = 0; x < width; ++x )
+        {
+            prepareInputs( inputs, latents, mipLevel, mipWidth, mipHeight, xstart + x, ystart + y );
+            evaluateNetwork( inputs, &dest[( static_cast<size_t>( y ) * width + x ) * NTC_MLP_OUTPUT_CHANNELS] );
+        }
+    }
+    return true;
+}
+
+}  // namespace neuralTextures
@@ -1,10 +1,10 @@
 /*
- * SPDX-FileCopyrightText: Copyright (c) 2019 - 2025  NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-FileCopyrightText: Copyright (c) 2019 - 2026  NVIDIA CORPORATION & AFFILIATES. All rights reserved.
  * SPDX-License-Identifier: BSD-3-Clause
  */
 
 #include <math.h>
-#include <fstream>
+#include <algorithm>
 
 #include <rapidjson/writer.h>
 #include <rapidjson/stringbuffer.h>
@@ -14,25 +14,39 @@
 #define OPTIX_CHK( call ) if( call != OPTIX_SUCCESS ) return false
 #define CUDA_CHK( call ) if( call != CUDA_SUCCESS ) return false
 
-bool NtcImageReader::loadFile( const char* fileName )
+bool NtcImageReader::loadFile( const char* fileName, bool mapFile )
 {
     const uint32_t NTEX_MAGIC_NUMBER = 0x5845544E; // "NTEX"
     const uint32_t NTEX_SUPPORTED_VERSION = 0x100;
 
-    std::ifstream file( fileName, std::ios::binary );
-    if( !file.is_open() )
+    std::shared_ptr<imageSource::ReadOnlyFile> file( new imageSource::ReadOnlyFile );
+    if( !file->open( fileName, mapFile ) )
         return false;
 
+    // The description is parsed once, since reads that overlap a close and reload use it.
+    if( m_loaded )
+    {
+        std::atomic_store( &m_file, std::shared_ptr<const imageSource::ReadOnlyFile>( std::move( file ) ) );
+        return true;
+    }
+
     // Read file header
     NtcFileHeader header{};
-    file.read( reinterpret_cast<char*>( &header ), sizeof( NtcFileHeader ) );
+    if( !file->read( reinterpret_cast<char*>( &header ), sizeof( NtcFileHeader ), 0 ) )
+        return false;
     if( header.magicNumber != NTEX_MAGIC_NUMBER || header.version != NTEX_SUPPORTED_VERSION )
         return false;
+    if( header.dataOffset > file->getSize() )
+        return false;
+
+    // The data chunk can be padded past the end of the file.
+    m_dataOffset = header.dataOffset;
+    m_dataSize = std::min<uint64_t>( header.dataSize, file->getSize() - header.dataOffset );
 
     // Read json text
     std::vector<char> jsonText( header.jsonSize + 1, '\0' );
-    file.seekg( header.jsonOffset );
-    file.read( jsonText.data(), header.jsonSize );
+    if( !file->read( jsonText.data(), header.jsonSize, header.jsonOffset ) )
+        return false;
 
     // Parse json document and fill in texture description
     rapidjson::Document jsonDoc;
@@ -42,31 +56,37 @@ bool NtcImageReader::loadFile( const char* fileName )
     if( !parseTextureSetDescription( jsonDoc ) )
         return false;
 
-    // Figure out how much of the data chunk to read
-    bool loadLatents = true;
-    int dataChunkReadSize = static_cast<int>(header.dataSize);
-    if( !loadLatents )
-    {
-        int latentOffsetViewIdx = jsonDoc["latents"][0]["view"].GetInt();
-        int latentOffset = jsonDoc["views"][latentOffsetViewIdx]["offset"].GetInt();
-        dataChunkReadSize = latentOffset;
-    }
-    
-    // Read data chunk, parse latents and network weights
-    m_hDataChunk.resize( dataChunkReadSize, '\0' );
-
-    file.seekg( header.dataOffset );
-    file.read( m_hDataChunk.data(), dataChunkReadSize );
+    // Parse latents and network weights. Only the network weights are read from the data chunk;
+    // the latents are read on demand.
     if( !parseLatentsDescription( jsonDoc ) )
         return false;
-    if( !parseNetworkDescription( jsonDoc ) )
+    if( !parseNetworkDescription( *file, jsonDoc ) )
         return false;
 
+    std::atomic_store( &m_file, std::shared_ptr<const imageSource::ReadOnlyFile>( std::move( file ) ) );
+    m_loaded = true;
+
     //printTextureSetDescription();
     return true;
 }
 
 
+void NtcImageReader::close()
+{
+    // Reads that are in progress hold their own references to the file, which is closed (and
+    // unmapped) when the last of them finishes.
+    std::atomic_store( &m_file, std::shared_ptr<const imageSource::ReadOnlyFile>() );
+}
+
+
+bool NtcImageReader::readDataChunk( const imageSource::ReadOnlyFile& file, void* dest, uint64_t offset, uint64_t size )
+{
+    if( offset + size > m_dataSize )
+        return false;
+    return file.read( static_cast<char*>( dest ), static_cast<size_t>( size ), m_dataOffset + offset );
+}
+
+
 bool NtcImageReader::parseTextureSetDescription( rapidjson::Document& doc )
 {
     try
@@ -142,7 +162,7 @@ bool NtcImageReader::parseLatentsDescription( rapidjson::Document& doc )
 {
     try 
     {
-        // The latent data is held in m_hDataChunk. Read the offsets and sizes
+        // The latent data is read from the data chunk on demand. Read the offsets and sizes
         m_hLatentMipOffsets.resize( doc["latents"].Size(), 0 );
         m_hLatentMipSizes.resize( doc["latents"].Size(), 0 );
         m_inferenceData.numLatentMips = static_cast<int>( doc["latents"].Size() );
@@ -164,7 +184,7 @@ bool NtcImageReader::parseLatentsDescription( rapidjson::Document& doc )
 }
 
 
-bool NtcImageReader::parseNetworkDescription( rapidjson::Document& doc )
+bool NtcImageReader::parseNetworkDescription( const imageSource::ReadOnlyFile& file, rapidjson::Document& doc )
 {
     try
     {
@@ -191,6 +211,17 @@ bool NtcImageReader::parseNetworkDescription( rapidjson::Document& doc )
         m_hNetwork.resize( network["layers"].Size() );
         int offset = 0;
 
+        // Read a data view from the data chunk to the end of m_hNetworkData
+        auto readView = [&]( int viewIdx, int& viewOffset, int& viewSize ) {
+            int srcOffset = doc["views"][viewIdx]["offset"].GetInt();
+            viewSize = doc["views"][viewIdx]["storedSize"].GetInt();
+            viewOffset = offset;
+            if( offset + viewSize > maxNetworkSizeInBytes || !readDataChunk( file, &m_hNetworkData[offset], srcOffset, viewSize ) )
+                return false;
+            offset += viewSize;
+            return true;
+        };
+
         // Read the network matrix weights first so network layers are all together
         for( unsigned int layerId = 0; layerId < network["layers"].Size(); ++layerId )
         {
@@ -200,15 +231,9 @@ bool NtcImageReader::parseNetworkDescription( rapidjson::Document& doc )
             layer.inputChannels = networkLayer["inputChannels"].GetInt();
             layer.outputChannels = networkLayer["outputChannels"].GetInt();
             
-            if( networkLayer.HasMember( "weightView" ) )
-            {
-                int viewIdx = networkLayer["weightView"].GetInt();
-                int srcOffset = doc["views"][viewIdx]["offset"].GetInt();
-                layer.weightSize = doc["views"][viewIdx]["storedSize"].GetInt();
-                layer.weightOffset = offset;
-                memcpy( &m_hNetworkData[offset], &m_hDataChunk[srcOffset], layer.weightSize );
-                offset += layer.weightSize;
-            }
+            if( networkLayer.HasMember( "weightView" ) &&
+                !readView( networkLayer["weightView"].GetInt(), layer.weightOffset, layer.weightSize ) )
+                return false;
 
             if( networkLayer.HasMember( "weightType" ) )
                 layer.weightType = networkLayer["weightType"].GetString();
@@ -224,24 +249,12 @@ bool NtcImageReader::parseNetworkDescription( rapidjson::Document& doc )
             rapidjson::Value& networkLayer = network["layers"][layerId];
             NtcNetworkLayer& layer = m_hNetwork[layerId];
 
-            if( networkLayer.HasMember( "scaleView" ) )
-            {
-                int viewIdx = networkLayer["scaleView"].GetInt();
-                int srcOffset = doc["views"][viewIdx]["offset"].GetInt();
-                layer.scaleSize = doc["views"][viewIdx]["storedSize"].GetInt();
-                layer.scaleOffset = offset;
-                memcpy( &m_hNetworkData[offset], &m_hDataChunk[srcOffset], layer.scaleSize );
-                offset += layer.scaleSize;
-            }
-            if( networkLayer.HasMember( "biasView" ) )
-            {
-                int viewIdx = networkLayer["biasView"].GetInt();
-                int srcOffset = doc["views"][viewIdx]["offset"].GetInt();
-                layer.biasSize = doc["views"][viewIdx]["storedSize"].GetInt();
-                layer.biasOffset = offset;
-                memcpy( &m_hNetworkData[offset], &m_hDataChunk[srcOffset], layer.biasSize );
-                offset += layer.biasSize;
-            }
+            if( networkLayer.HasMember( "scaleView" ) &&
+                !readView( networkLayer["scaleView"].GetInt(), layer.scaleOffset, layer.scaleSize ) )
+                return false;
+            if( networkLayer.HasMember( "biasView" ) &&
+                !readView( networkLayer["biasView"].GetInt(), layer.biasOffset, layer.biasSize ) )
+                return false;
         }
 
         m_hNetworkData.resize( offset );
@@ -257,29 +270,41 @@ bool NtcImageReader::parseNetworkDescription( rapidjson::Document& doc )
 
 bool NtcImageReader::readLatentRectUshort( uint16_t* dest, int mipLevel, int xstart, int ystart, int width, int height )
 {
+    const std::shared_ptr<const imageSource::ReadOnlyFile> file = std::atomic_load( &m_file );
+    if( mipLevel < 0 || mipLevel >= static_cast<int>( m_hLatentMipOffsets.size() ) || !file )
+        return false;
+
     int numLatentTextures = m_inferenceData.latentFeatures / 4;
     int destPixelStride = (numLatentTextures != 3) ? numLatentTextures : 4;
 
     int mipWidth = m_inferenceData.latentWidth >> mipLevel;
     int mipHeight = m_inferenceData.latentHeight >> mipLevel;
-    int latentOffset = m_hLatentMipOffsets[mipLevel];
+    uint64_t latentOffset = m_hLatentMipOffsets[mipLevel];
+    uint64_t layerSize = static_cast<uint64_t>( mipWidth ) * mipHeight * sizeof( uint16_t );
 
-    uint16_t* src = (uint16_t*) &m_hDataChunk[latentOffset];
     width = std::min( width, mipWidth - xstart );
     height = std::min( height, mipHeight - ystart );
+    if( width <= 0 || height <= 0 )
+        return true;
+
+    // The latent layers are stored one after another. Read the part of each row of a layer that
+    // overlaps the rectangle, or the overlapping rows all at once if they are whole rows.
+    int rowsPerRead = ( xstart == 0 && width == mipWidth ) ? height : 1;
+    std::vector<uint16_t> src( static_cast<size_t>( width ) * rowsPerRead );
+    uint64_t srcSize = src.size() * sizeof( uint16_t );
 
-    for( int y = 0; y < height; ++y )
+    for( int c = 0; c < numLatentTextures; ++c )
     {
-        for( int x = 0; x < width; ++x )
+        for( int y = 0; y < height; y += rowsPerRead )
         {
-            uint16_t* pixelDest = &dest[( y * width + x ) * destPixelStride];
-            for( int c = 0; c < numLatentTextures; ++c )
-            {
-                int srcLayerOffset = mipWidth * mipHeight * c;
-                int srcPixelOffset = ( y + ystart ) * mipWidth + ( x + xstart );
-                uint16_t* pixelSrc = &src[srcLayerOffset + srcPixelOffset];
-                pixelDest[c] = *pixelSrc;
-            }
+            uint64_t srcPixelOffset = static_cast<uint64_t>( y + ystart ) * mipWidth + xstart;
+            if( !readDataChunk( *file, src.data(), latentOffset + layerSize * c + srcPixelOffset * sizeof( uint16_t ), srcSize ) )
+                return false;
+            m_numLatentBytesRead += srcSize;
+
+            uint16_t* pixelDest = &dest[static_cast<size_t>( y ) * width * destPixelStride + c];
+            for( size_t i = 0; i < src.size(); ++i )
+                pixelDest[i * destPixelStride] = src[i];
         }
     }
     return true;
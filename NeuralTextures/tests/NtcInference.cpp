@@ -0,0 +1,149 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "NtcInference.h"
+#include "NtcInferenceCuda.h"
+
+#include <OptiXToolkit/Error/cuErrorCheck.h>
+#include <OptiXToolkit/Error/cudaErrorCheck.h>
+#include <OptiXToolkit/Error/optixErrorCheck.h>
+#include <OptiXToolkit/NeuralTextures/NtcImageReader.h>
+#include <OptiXToolkit/OptiXMemory/CompileOptions.h>
+
+#include <optix.h>
+#include <optix_stack_size.h>
+#include <optix_stubs.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+template <typename T>
+struct SbtRecord
+{
+    __align__( OPTIX_SBT_RECORD_ALIGNMENT ) char header[OPTIX_SBT_RECORD_HEADER_SIZE];
+    T data;
+};
+
+enum ProgramGroups
+{
+    GROUP_RAYGEN = 0,
+    GROUP_MISS,
+    NUM_GROUPS
+};
+
+void* makeSbtRecord( OptixProgramGroup group )
+{
+    void*          devRecord;
+    SbtRecord<int> record;
+    OTK_ERROR_CHECK( cudaMalloc( &devRecord, sizeof( record ) ) );
+    OTK_ERROR_CHECK( optixSbtRecordPackHeader( group, &record ) );
+    OTK_ERROR_CHECK( cudaMemcpy( devRecord, &record, sizeof( record ), cudaMemcpyHostToDevice ) );
+    return devRecord;
+}
+
+}  // namespace
+
+std::vector<float4> decodeMipLevelOnDevice( const std::string& fileName, unsigned int mipLevel )
+{
+    // Initialize CUDA and create the OptiX context.
+    OTK_ERROR_CHECK( cudaFree( nullptr ) );
+    CUcontext cudaContext;
+    OTK_ERROR_CHECK( cuCtxGetCurrent( &cudaContext ) );
+    OTK_ERROR_CHECK( optixInit() );
+    OptixDeviceContextOptions contextOptions{};
+    OptixDeviceContext        context;
+    OTK_ERROR_CHECK( optixDeviceContextCreate( cudaContext, &contextOptions, &context ) );
+
+    // Load the network weights and latents to the device.
+    NtcImageReader reader;
+    if( !reader.loadFile( fileName.c_str() ) )
+        throw std::runtime_error( "Could not open NTC image file " + fileName );
+    InferenceDataOptix infData = reader.getInferenceData();
+    OTK_ERROR_CHECK( cuMemAlloc( &infData.d_mlpWeights, NTC_NETWORK_MAX_SIZE ) );
+    if( !reader.prepareDeviceNetwork( context, infData.d_mlpWeights, NTC_NETWORK_MAX_SIZE ) )
+        throw std::runtime_error( "Could not prepare the network of NTC image file " + fileName );
+    infData.latentTexture = reader.makeLatentTexture();
+
+    const unsigned int width  = std::max( infData.constants.imageWidth >> mipLevel, 1 );
+    const unsigned int height = std::max( infData.constants.imageHeight >> mipLevel, 1 );
+
+    NtcInferenceParams params{};
+    params.mipLevel = static_cast<int>( mipLevel );
+    OTK_ERROR_CHECK( cudaMalloc( reinterpret_cast<void**>( &params.infData ), sizeof( InferenceDataOptix ) ) );
+    OTK_ERROR_CHECK( cudaMemcpy( params.infData, &infData, sizeof( InferenceDataOptix ), cudaMemcpyHostToDevice ) );
+    OTK_ERROR_CHECK( cudaMalloc( reinterpret_cast<void**>( &params.outputs ), width * height * sizeof( float4 ) ) );
+    void* devParams;
+    OTK_ERROR_CHECK( cudaMalloc( &devParams, sizeof( params ) ) );
+    OTK_ERROR_CHECK( cudaMemcpy( devParams, &params, sizeof( params ), cudaMemcpyHostToDevice ) );
+
+    // Create the pipeline, which has only a raygen program.
+    OptixPipelineCompileOptions pipelineOptions{};
+    pipelineOptions.traversableGraphFlags            = OPTIX_TRAVERSABLE_GRAPH_FLAG_ALLOW_SINGLE_GAS;
+    pipelineOptions.exceptionFlags                   = OPTIX_EXCEPTION_FLAG_NONE;
+    pipelineOptions.pipelineLaunchParamsVariableName = "params";
+
+    OptixModuleCompileOptions compileOptions{};
+    compileOptions.maxRegisterCount = OPTIX_COMPILE_DEFAULT_MAX_REGISTER_COUNT;
+    otk::configModuleCompileOptions( compileOptions );
+    OptixModule module;
+    OTK_ERROR_CHECK_LOG( optixModuleCreate( context, &compileOptions, &pipelineOptions, NtcInferenceCudaText(),
+                                            NtcInferenceCudaSize, LOG, &LOG_SIZE, &module ) );
+
+    OptixProgramGroupOptions groupOptions{};
+    OptixProgramGroupDesc    descs[NUM_GROUPS]{};
+    descs[GROUP_RAYGEN].kind                     = OPTIX_PROGRAM_GROUP_KIND_RAYGEN;
+    descs[GROUP_RAYGEN].raygen.module            = module;
+    descs[GROUP_RAYGEN].raygen.entryFunctionName = "__raygen__decodeMipLevel";
+    descs[GROUP_MISS].kind                       = OPTIX_PROGRAM_GROUP_KIND_MISS;
+    OptixProgramGroup groups[NUM_GROUPS];
+    OTK_ERROR_CHECK_LOG( optixProgramGroupCreate( context, descs, NUM_GROUPS, &groupOptions, LOG, &LOG_SIZE, groups ) );
+
+    const unsigned int       maxTraceDepth = 0;
+    OptixPipelineLinkOptions linkOptions{};
+    linkOptions.maxTraceDepth = maxTraceDepth;
+    OptixPipeline pipeline;
+    OTK_ERROR_CHECK_LOG( optixPipelineCreate( context, &pipelineOptions, &linkOptions, groups, NUM_GROUPS, LOG, &LOG_SIZE, &pipeline ) );
+
+    OptixStackSizes stackSizes{};
+    for( OptixProgramGroup group : groups )
+        OTK_ERROR_CHECK( optixUtilAccumulateStackSizes( group, &stackSizes, pipeline ) );
+    unsigned int directCallableTraversalStackSize;
+    unsigned int directCallableStateStackSize;
+    unsigned int continuationStackSize;
+    OTK_ERROR_CHECK( optixUtilComputeStackSizes( &stackSizes, maxTraceDepth, 0, 0, &directCallableTraversalStackSize,
+                                                 &directCallableStateStackSize, &continuationStackSize ) );
+    OTK_ERROR_CHECK( optixPipelineSetStackSize( pipeline, directCallableTraversalStackSize, directCallableStateStackSize,
+                                                continuationStackSize, 1 ) );
+
+    OptixShaderBindingTable sbt{};
+    sbt.raygenRecord            = reinterpret_cast<CUdeviceptr>( makeSbtRecord( groups[GROUP_RAYGEN] ) );
+    sbt.missRecordBase          = reinterpret_cast<CUdeviceptr>( makeSbtRecord( groups[GROUP_MISS] ) );
+    sbt.missRecordStrideInBytes = sizeof( SbtRecord<int> );
+    sbt.missRecordCount         = 1;
+
+    // Decode the mip level.
+    OTK_ERROR_CHECK( optixLaunch( pipeline, CUstream{}, reinterpret_cast<CUdeviceptr>( devParams ), sizeof( params ), &sbt, width, height, 1 ) );
+    std::vector<float4> texels( width * height );
+    OTK_ERROR_CHECK( cudaMemcpy( texels.data(), params.outputs, texels.size() * sizeof( float4 ), cudaMemcpyDeviceToHost ) );
+
+    // Clean up, including the mipmapped array of the latent texture.
+    OTK_ERROR_CHECK( cudaFree( reinterpret_cast<void*>( sbt.raygenRecord ) ) );
+    OTK_ERROR_CHECK( cudaFree( reinterpret_cast<void*>( sbt.missRecordBase ) ) );
+    OTK_ERROR_CHECK( optixPipelineDestroy( pipeline ) );
+    for( OptixProgramGroup group : groups )
+        OTK_ERROR_CHECK( optixProgramGroupDestroy( group ) );
+    OTK_ERROR_CHECK( optixModuleDestroy( module ) );
+    OTK_ERROR_CHECK( cudaFree( devParams ) );
+    OTK_ERROR_CHECK( cudaFree( params.outputs ) );
+    OTK_ERROR_CHECK( cudaFree( params.infData ) );
+    CUDA_RESOURCE_DESC latentDesc;
+    OTK_ERROR_CHECK( cuTexObjectGetResourceDesc( &latentDesc, infData.latentTexture ) );
+    OTK_ERROR_CHECK( cuTexObjectDestroy( infData.latentTexture ) );
+    OTK_ERROR_CHECK( cuMipmappedArrayDestroy( latentDesc.res.mipmap.hMipmappedArray ) );
+    OTK_ERROR_CHECK( cuMemFree( infData.d_mlpWeights ) );
+    OTK_ERROR_CHECK( optixDeviceContextDestroy( context ) );
+    return texels;
+}
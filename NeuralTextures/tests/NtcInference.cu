@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "NtcInference.h"
+
+#include <cuda_fp16.h>
+#include <optix.h>
+
+#include <OptiXToolkit/NeuralTextures/InferenceOptix.h>
+
+extern "C" {
+__constant__ NtcInferenceParams params;
+}
+
+extern "C" __global__ void __raygen__decodeMipLevel()
+{
+    const uint3         launchDim   = optixGetLaunchDimensions();
+    const uint3         launchIndex = optixGetLaunchIndex();
+    InferenceDataOptix* infData     = params.infData;
+
+    OptixCoopVec<float, NTC_MLP_OUTPUT_CHANNELS> out;
+    SampleTextureSet( out, infData->constants, infData->latentTexture, infData->latentFeatures, infData->latentWidth,
+                      infData->latentHeight, infData->d_mlpWeights, launchIndex.x, launchIndex.y, params.mipLevel );
+
+    // Keep the channels of the first texture, as DecodedNeuralTextureSource does.
+    const int start       = infData->texFirstChannel[0];
+    const int numChannels = infData->texNumChannels[0];
+    float4    texel;
+    texel.x = out[start];
+    texel.y = ( numChannels > 1 ) ? out[start + 1] : 0.0f;
+    texel.z = ( numChannels > 2 ) ? out[start + 2] : 0.0f;
+    texel.w = ( numChannels > 3 ) ? out[start + 3] : 0.0f;
+    params.outputs[launchIndex.y * launchDim.x + launchIndex.x] = texel;
+}
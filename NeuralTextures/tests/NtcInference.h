@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <cuda.h>
+#include <cuda_runtime.h>  // for float4
+
+#include <OptiXToolkit/NeuralTextures/InferenceDataOptix.h>
+
+#ifndef __CUDACC__
+#include <string>
+#include <vector>
+#endif
+
+// Launch parameters of the kernel in NtcInference.cu, which decodes a mip level of the first texture
+// in a texture set with SampleTextureSet from InferenceOptix.h.  The launch dimensions are the
+// dimensions of the mip level.
+struct NtcInferenceParams
+{
+    InferenceDataOptix* infData;
+    int                 mipLevel;
+    float4*             outputs;  // One per texel, in rows.
+};
+
+#ifndef __CUDACC__
+/// Decode a mip level of the first texture in an .ntc file on the current CUDA device, as
+/// DecodedNeuralTextureSource::readMipLevel does on the host.
+std::vector<float4> decodeMipLevelOnDevice( const std::string& fileName, unsigned int mipLevel );
+#endif
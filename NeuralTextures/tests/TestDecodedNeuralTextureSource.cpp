@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <cuda_runtime.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include "NtcInference.h"
+#include "SourceDir.h"  // generated from SourceDir.h.in
+#include <OptiXToolkit/NeuralTextures/DecodedNeuralTextureSource.h>
+
+using namespace neuralTextures;
+
+namespace {
+
+// Mip level 4 of colors.ntc (26x26 float4 texels), as decoded by the scalar host decoder when it was
+// written.  The recorded output was not produced by the device inference, so it is not an
+// independent reference: it detects regressions in the host decoder without a GPU, and the SIMD
+// decoders are checked for consistency with the scalar one.  ScalarMatchesDeviceInference compares
+// the scalar decoder with the device inference when a CUDA device is present.
+const unsigned int RECORDED_MIP_LEVEL = 4;
+
+// Four half precision ulps of values in [1,2).  The host decoders fuse multiply-adds and round to
+// half precision as the device does, so only the order of summation in the device's matrix
+// multiplies can change the last bits of a layer's outputs.
+const float DECODER_TOLERANCE = 4.0f / 1024.0f;
+
+std::vector<float4> loadRecordedOutput( unsigned int width, unsigned int height )
+{
+    std::ifstream file( getSourceDir() + "/Textures/colors.mip4.scalar.f32", std::ios::binary );
+    std::vector<float4> pixels( width * height );
+    file.read( reinterpret_cast<char*>( pixels.data() ), pixels.size() * sizeof( float4 ) );
+    if( !file )
+        pixels.clear();
+    return pixels;
+}
+
+void expectNear( const float4& expected, const float4& actual, float tolerance )
+{
+    EXPECT_NEAR( expected.x, actual.x, tolerance );
+    EXPECT_NEAR( expected.y, actual.y, tolerance );
+    EXPECT_NEAR( expected.z, actual.z, tolerance );
+    EXPECT_NEAR( expected.w, actual.w, tolerance );
+}
+
+bool hasCudaDevice()
+{
+    int numDevices = 0;
+    return cudaGetDeviceCount( &numDevices ) == cudaSuccess && numDevices > 0;
+}
+
+}  // namespace
+
+class TestDecodedNeuralTextureSource : public testing::Test
+{
+  protected:
+    std::string m_fileName = getSourceDir() + "/Textures/colors.ntc";
+
+    std::vector<float4> decodeMipLevel( NtcSimd simd, unsigned int mipLevel = RECORDED_MIP_LEVEL )
+    {
+        DecodedNeuralTextureSource image( m_fileName, 0, simd );
+        imageSource::TextureInfo info;
+        image.open( &info );
+        EXPECT_EQ( simd, image.getSimd() );
+
+        m_width = std::max( info.width >> mipLevel, 1U );
+        m_height = std::max( info.height >> mipLevel, 1U );
+        std::vector<float4> pixels( m_width * m_height );
+        EXPECT_TRUE( image.readMipLevel( reinterpret_cast<char*>( pixels.data() ), mipLevel, m_width, m_height, CUstream{} ) );
+        return pixels;
+    }
+
+    unsigned int m_width = 0;
+    unsigned int m_height = 0;
+};
+
+TEST_F( TestDecodedNeuralTextureSource, Open )
+{
+    DecodedNeuralTextureSource image( m_fileName );
+    imageSource::TextureInfo info;
+    image.open( &info );
+
+    EXPECT_EQ( 422U, info.width );
+    EXPECT_EQ( 425U, info.height );
+    EXPECT_EQ( 9U, info.numMipLevels );
+    EXPECT_EQ( CU_AD_FORMAT_FLOAT, info.format );
+    EXPECT_EQ( 4U, info.numChannels );
+    EXPECT_EQ( 0ULL, image.getNumBytesRead() );
+    EXPECT_EQ( getBestNtcSimd(), image.getSimd() );
+}
+
+// Regression check of the scalar host decoder against its recorded output.
+TEST_F( TestDecodedNeuralTextureSource, ScalarMatchesRecordedOutput )
+{
+    const std::vector<float4> pixels = decodeMipLevel( NtcSimd::SCALAR );
+    const std::vector<float4> recorded = loadRecordedOutput( m_width, m_height );
+    ASSERT_FALSE( recorded.empty() );
+    for( size_t i = 0; i < pixels.size(); ++i )
+        expectNear( recorded[i], pixels[i], DECODER_TOLERANCE );
+}
+
+// Consistency check of the SIMD host decoders against the scalar one.
+TEST_F( TestDecodedNeuralTextureSource, SimdMatchesScalar )
+{
+    const std::vector<float4> scalar = decodeMipLevel( NtcSimd::SCALAR );
+    for( NtcSimd simd : { NtcSimd::NEON, NtcSimd::AVX2, NtcSimd::AVX512 } )
+    {
+        if( !isNtcSimdSupported( simd ) )
+            continue;
+        const std::vector<float4> pixels = decodeMipLevel( simd );
+        for( size_t i = 0; i < pixels.size(); ++i )
+            expectNear( scalar[i], pixels[i], DECODER_TOLERANCE );
+    }
+}
+
+// Comparison of the host decoder with the inference in InferenceOptix.h on the device.
+TEST_F( TestDecodedNeuralTextureSource, ScalarMatchesDeviceInference )
+{
+    if( !hasCudaDevice() )
+        GTEST_SKIP() << "No CUDA device, skipping comparison with the device inference";
+
+    for( unsigned int mipLevel : { 0U, RECORDED_MIP_LEVEL } )
+    {
+        const std::vector<float4> pixels = decodeMipLevel( NtcSimd::SCALAR, mipLevel );
+        const std::vector<float4> device = decodeMipLevelOnDevice( m_fileName, mipLevel );
+        ASSERT_EQ( pixels.size(), device.size() );
+        for( size_t i = 0; i < pixels.size(); ++i )
+            expectNear( device[i], pixels[i], DECODER_TOLERANCE );
+    }
+}
+
+TEST_F( TestDecodedNeuralTextureSource, ReadTileMatchesMipLevel )
+{
+    DecodedNeuralTextureSource image( m_fileName );
+    imageSource::TextureInfo info;
+    image.open( &info );
+    const unsigned int width = info.width >> RECORDED_MIP_LEVEL;
+    const unsigned int height = info.height >> RECORDED_MIP_LEVEL;
+    std::vector<float4> pixels( width * height );
+    EXPECT_TRUE( image.readMipLevel( reinterpret_cast<char*>( pixels.data() ), RECORDED_MIP_LEVEL, width, height, CUstream{} ) );
+
+    // The tile overhangs the right edge of the mip level, where it is black.
+    const imageSource::Tile tile{ 1, 0, 16, 16 };
+    std::vector<float4> tileData( tile.width * tile.height );
+    EXPECT_TRUE( image.readTile( reinterpret_cast<char*>( tileData.data() ), RECORDED_MIP_LEVEL, tile, CUstream{} ) );
+    for( unsigned int y = 0; y < tile.height; ++y )
+    {
+        for( unsigned int x = 0; x < tile.width; ++x )
+        {
+            const unsigned int mipX = tile.x * tile.width + x;
+            const float4 expected = mipX < width ? pixels[y * width + mipX] : float4{};
+            expectNear( expected, tileData[y * tile.width + x], 0.0f );
+        }
+    }
+}
+
+TEST_F( TestDecodedNeuralTextureSource, ReadTilesMatchesReadTile )
+{
+    DecodedNeuralTextureSource image( m_fileName );
+    image.open( nullptr );
+
+    const unsigned int numTiles = 8;
+    const unsigned int tileWidth = 32;
+    std::vector<imageSource::Tile> tiles;
+    std::vector<std::vector<float4>> tileData( numTiles, std::vector<float4>( tileWidth * tileWidth ) );
+    std::vector<char*> dest;
+    for( unsigned int i = 0; i < numTiles; ++i )
+    {
+        tiles.push_back( imageSource::Tile{ i % 4, i / 4, tileWidth, tileWidth } );
+        dest.push_back( reinterpret_cast<char*>( tileData[i].data() ) );
+    }
+    EXPECT_TRUE( image.readTiles( dest.data(), 0, tiles.data(), numTiles, CUstream{} ) );
+    EXPECT_EQ( numTiles, image.getNumTilesRead() );
+
+    std::vector<float4> expected( tileWidth * tileWidth );
+    for( unsigned int i = 0; i < numTiles; ++i )
+    {
+        EXPECT_TRUE( image.readTile( reinterpret_cast<char*>( expected.data() ), 0, tiles[i], CUstream{} ) );
+        for( unsigned int j = 0; j < expected.size(); ++j )
+            expectNear( expected[j], tileData[i][j], 0.0f );
+    }
+}
+
+TEST_F( TestDecodedNeuralTextureSource, BaseColorIsLastMipLevel )
+{
+    DecodedNeuralTextureSource image( m_fileName );
+    imageSource::TextureInfo info;
+    image.open( &info );
+
+    float4 baseColor{};
+    float4 pixel{};
+    EXPECT_TRUE( image.readBaseColor( baseColor ) );
+    EXPECT_TRUE( image.readMipLevel( reinterpret_cast<char*>( &pixel ), info.numMipLevels - 1, 1, 1, CUstream{} ) );
+    expectNear( pixel, baseColor, 0.0f );
+}
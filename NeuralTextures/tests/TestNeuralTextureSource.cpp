@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -8,6 +8,10 @@
 #include <optix.h>
 #include <optix_function_table_definition.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "SourceDir.h"  // generated from SourceDir.h.in
 #include <OptiXToolkit/NeuralTextures/NeuralTextureSource.h>
 
@@ -38,3 +42,99 @@ TEST_F( TestNeuralTextureSource, Loading )
     EXPECT_EQ( infData.constants.imageWidth, 422 );
     EXPECT_EQ( infData.constants.imageHeight, 425 );
 }
+
+TEST_F( TestNeuralTextureSource, OpenReadsNoLatents )
+{
+    std::string fileName = getSourceDir() + "/Textures/colors.ntc";
+    NeuralTextureSource image( fileName );
+    image.open( nullptr );
+
+    EXPECT_EQ( 0ULL, image.getNumBytesRead() );
+    EXPECT_EQ( fileName, image.getPath() );
+}
+
+TEST_F( TestNeuralTextureSource, ReadTileReadsOnlyTile )
+{
+    std::string fileName = getSourceDir() + "/Textures/colors.ntc";
+    NeuralTextureSource image( fileName );
+    imageSource::TextureInfo info;
+    image.open( &info );
+
+    const imageSource::Tile tile{ 1, 2, 32, 32 };
+    std::vector<uint16_t> tileData( tile.width * tile.height * info.numChannels );
+    EXPECT_TRUE( image.readTile( reinterpret_cast<char*>( tileData.data() ), 0, tile, CUstream{} ) );
+    EXPECT_EQ( tileData.size() * sizeof( uint16_t ), image.getNumBytesRead() );
+}
+
+TEST_F( TestNeuralTextureSource, MappedAndReadLatentsMatch )
+{
+    std::string fileName = getSourceDir() + "/Textures/colors.ntc";
+    NeuralTextureSource mappedImage( fileName, true );
+    NeuralTextureSource readImage( fileName, false );
+    imageSource::TextureInfo info;
+    mappedImage.open( &info );
+    readImage.open( nullptr );
+
+    const unsigned int mipLevel = 1;
+    const unsigned int width = info.width >> mipLevel;
+    const unsigned int height = info.height >> mipLevel;
+    std::vector<uint16_t> mappedData( width * height * info.numChannels );
+    std::vector<uint16_t> readData( mappedData.size() );
+    EXPECT_TRUE( mappedImage.readMipLevel( reinterpret_cast<char*>( mappedData.data() ), mipLevel, width, height, CUstream{} ) );
+    EXPECT_TRUE( readImage.readMipLevel( reinterpret_cast<char*>( readData.data() ), mipLevel, width, height, CUstream{} ) );
+    EXPECT_EQ( mappedData, readData );
+    EXPECT_EQ( mappedData.size() * sizeof( uint16_t ), mappedImage.getNumBytesRead() );
+
+    // A tile holds the same latents as the corresponding part of the mip level.
+    const imageSource::Tile tile{ 1, 1, 16, 16 };
+    std::vector<uint16_t> tileData( tile.width * tile.height * info.numChannels );
+    EXPECT_TRUE( readImage.readTile( reinterpret_cast<char*>( tileData.data() ), mipLevel, tile, CUstream{} ) );
+    for( unsigned int y = 0; y < tile.height; ++y )
+    {
+        for( unsigned int x = 0; x < tile.width * info.numChannels; ++x )
+        {
+            unsigned int mipIndex = ( ( tile.y * tile.height + y ) * width + tile.x * tile.width ) * info.numChannels + x;
+            EXPECT_EQ( readData[mipIndex], tileData[y * tile.width * info.numChannels + x] );
+        }
+    }
+}
+
+TEST_F( TestNeuralTextureSource, CloseWhileReading )
+{
+    // Reads that overlap a close either fail or read the right latents; they must not read an
+    // unmapped or closed file.
+    std::string fileName = getSourceDir() + "/Textures/colors.ntc";
+    NeuralTextureSource image( fileName, true );
+    imageSource::TextureInfo info;
+    image.open( &info );
+    const imageSource::Tile tile{ 1, 1, 32, 32 };
+    std::vector<uint16_t> expected( tile.width * tile.height * info.numChannels );
+    ASSERT_TRUE( image.readTile( reinterpret_cast<char*>( expected.data() ), 0, tile, CUstream{} ) );
+
+    const unsigned int numThreads = 4;
+    std::vector<unsigned int> numBad( numThreads );
+    std::atomic<bool> done{ false };
+    std::vector<std::thread> threads;
+    for( unsigned int i = 0; i < numThreads; ++i )
+    {
+        threads.emplace_back( [&, i] {
+            std::vector<uint16_t> tileData( expected.size() );
+            while( !done )
+            {
+                if( image.readTile( reinterpret_cast<char*>( tileData.data() ), 0, tile, CUstream{} ) && tileData != expected )
+                    ++numBad[i];
+            }
+        } );
+    }
+    for( unsigned int i = 0; i < 100; ++i )
+    {
+        image.close();
+        image.open( nullptr );
+    }
+    done = true;
+    for( std::thread& thread : threads )
+        thread.join();
+
+    for( unsigned int i = 0; i < numThreads; ++i )
+        EXPECT_EQ( 0U, numBad[i] ) << "thread " << i;
+}
@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+/// \file BakeCache.h
+/// Persistent cache of Opacity Micromap baking results.
+
+#include <OptiXToolkit/CuOmmBaking/CuOmmBaking.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace cuOmmBaking {
+
+    /// This struct specifies options for a BakeCache.
+    struct BakeCacheOptions
+    {
+        /// Directory holding the cache files. It is created when the first bake is stored.
+        std::string directory = "ommBakeCache";
+
+        /// Maximum total size of the cache files in bytes.
+        /// When storing a bake would exceed this size, the least recently used cache files are evicted.
+        size_t maxSizeInBytes = size_t( 1 ) << 30;
+    };
+
+    /// Counters of the outcomes of BakeCache::bakeOpacityMicromaps calls.
+    struct BakeCacheStatistics
+    {
+        unsigned int numHits;          ///< Bakes restored from the cache.
+        unsigned int numMisses;        ///< Bakes executed and stored in the cache.
+        unsigned int numUncacheable;   ///< Bakes executed without the cache, because an input has no content hash.
+        unsigned int numEvictions;     ///< Cache files removed to stay within BakeCacheOptions::maxSizeInBytes.
+        unsigned int numCorruptFiles;  ///< Cache files removed because they failed validation.
+    };
+
+    /// A content-addressed, on-disk cache of the outputs of BakeOpacityMicromaps.
+    ///
+    /// Bakes are keyed by a hash of everything that determines their outputs: the contents of the
+    /// index, texture coordinate, texture index and transform buffers, the texture contents and descriptors,
+    /// the BakeOptions that affect baking (format, flags, maximumSizeInBytes and subdivisionScale) and a
+    /// version of the baking algorithm. The backend is not part of the key, since both backends produce identical outputs.
+    ///
+    /// Each cache file holds the Opacity Micromap Array data, descriptors, histogram, per input index buffers
+    /// and usage counts of one bake, followed by a checksum. Files failing validation are discarded and re-baked.
+    ///
+    /// The contents of state textures are hashed by the cache. The contents of cuda textures can't be read back
+    /// in general, so their content hashes are supplied by the user with setTextureHash. Bakes using a cuda texture
+    /// without a content hash are executed without the cache.
+    ///
+    /// All member functions are thread-safe.
+    class BakeCache
+    {
+      public:
+        /// Create a cache in the directory specified by the options.
+        explicit BakeCache( const BakeCacheOptions& options );
+
+        ~BakeCache();
+
+        BakeCache( const BakeCache& ) = delete;
+        BakeCache& operator=( const BakeCache& ) = delete;
+
+        /// Set the content hash of a cuda texture. The hash must change whenever the texels, dimensions
+        /// or format of the texture change. The sampler state of the texture is hashed by the cache.
+        void setTextureHash( cudaTextureObject_t texObject, unsigned long long hash );
+
+        /// Forget the content hash of a cuda texture, e.g. before destroying the texture object.
+        void removeTextureHash( cudaTextureObject_t texObject );
+
+        /// Execute Opacity Micromap baking, or restore its outputs from the cache.
+        ///
+        /// Takes the same arguments as BakeOpacityMicromaps, and writes the same outputs to the same buffers.
+        /// Unlike BakeOpacityMicromaps, this function synchronizes with the stream: it reads the input buffers
+        /// to compute the cache key, and reads back the outputs of a bake to store them.
+        ///
+        /// \param[out] cacheHit  Optional, set to true if the outputs were restored from the cache.
+        Result bakeOpacityMicromaps(
+            const BakeOptions*       options,
+            unsigned                 numInputs,
+            const BakeInputDesc*     inputs,
+            const BakeInputBuffers*  inputBuffers,
+            const BakeBuffers*       buffers,
+            cudaStream_t             stream   = 0,
+            bool*                    cacheHit = nullptr );
+
+        /// Return the total size of the cache files in bytes.
+        size_t getSizeInBytes() const;
+
+        /// Return the counters of bakeOpacityMicromaps outcomes.
+        BakeCacheStatistics getStatistics() const;
+
+        /// Remove all cache files.
+        void clear();
+
+      private:
+        class Impl;
+        std::unique_ptr<Impl> m_impl;
+    };
+
+}  // namespace cuOmmBaking
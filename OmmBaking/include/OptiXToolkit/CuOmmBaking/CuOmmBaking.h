@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -42,6 +42,21 @@ namespace cuOmmBaking {
     inline constexpr BakeFlags operator&( BakeFlags x, BakeFlags y ) { return static_cast< BakeFlags > ( static_cast< uint32_t >( x ) & static_cast< uint32_t >( y ) ); }
     inline constexpr BakeFlags operator~( BakeFlags x) { return static_cast< BakeFlags > ( ~static_cast< uint32_t >( x ) ); }
 
+    /// Processor used to run the baking, in BakeOptions::backend.
+    enum class BakeBackend : uint32_t
+    {
+        /// Baking runs asynchronously on the CUDA device, in the stream passed to BakeOpacityMicromaps.
+        CUDA,
+
+        /// Baking runs synchronously on the host, using multiple threads. No CUDA device is required.
+        /// All CUdeviceptr members of the bake inputs and buffers hold host pointers, only TextureType::STATE
+        /// textures are supported, and the stream argument of BakeOpacityMicromaps is ignored.
+        /// The baked outputs are identical to those of the CUDA backend.
+        HOST,
+
+        MAX_NUM
+    };
+
     /// This struct specifies options for Opacity Micromap baking.
     struct BakeOptions
     {
@@ -79,6 +94,10 @@ namespace cuOmmBaking {
         /// 
         /// If set to zero, no target subdivision level is used.
         float subdivisionScale = 0.5f;
+
+        /// Processor used to run the baking.
+        /// \see BakeBackend
+        BakeBackend backend = BakeBackend::CUDA;
     };
 
     /// Format of texture coordinates used in BakeInputDesc::texCoordFormat.
@@ -487,6 +506,7 @@ namespace cuOmmBaking {
     /// 
     /// This function is thread-safe. 
     /// This function does NOT synchronize with the device, all device tasks is executed asynchronously in the provided stream.
+    /// When BakeOptions::backend is BakeBackend::HOST, the baking is executed on the host and has completed when this function returns.
     ///  
     /// \param[in] options            Baking options.
     /// \param[in] numInputs          Number of elements in inputs (must be at least 1).
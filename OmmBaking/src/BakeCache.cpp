@@ -0,0 +1,822 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "Util/Exception.h"
+
+#include "CuOmmBakingImpl.h"
+
+#include <OptiXToolkit/CuOmmBaking/BakeCache.h>
+#include <OptiXToolkit/ShaderUtil/ContentHash.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace cuOmmBaking {
+
+namespace {
+
+// Version of the baking algorithm, part of every cache key.
+// Increment whenever a change to the baking changes its outputs, to invalidate existing cache files.
+const uint32_t BAKE_ALGORITHM_VERSION = 1;
+
+// Cache file layout:
+//     BakeCacheFileHeader
+//     payload: BakeCacheFileCounts, uint64 { indexBufferSizeInBytes, numMicromapUsageCounts } per input,
+//              histogram entries, micromap descs, micromap data, { index buffer, usage counts } per input
+// The header holds the full key, so that a file is never used for another key, and a checksum of the payload.
+const uint32_t BAKE_CACHE_FILE_MAGIC   = 0x434d4d4f;  // "OMMC"
+const uint32_t BAKE_CACHE_FILE_VERSION = 1;
+const char*    BAKE_CACHE_FILE_EXTENSION = ".omm";
+
+struct BakeCacheFileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint64_t key[2];
+    uint64_t payloadSizeInBytes;
+    uint64_t payloadChecksum;
+};
+
+struct BakeCacheFileCounts
+{
+    uint32_t indexFormat;
+    uint32_t numInputs;
+    uint32_t numMicromapHistogramEntries;
+    uint32_t numMicromapDescs;
+    uint64_t compactedSizeInBytes;
+};
+
+uint64_t checksum( const std::vector<uint8_t>& data )
+{
+    uint64_t hash[2];
+    otk::hashContent( data.data(), data.size(), hash );
+    return hash[0];
+}
+
+uint32_t getIndexSizeInBytes( IndexFormat format )
+{
+    switch( format )
+    {
+        case IndexFormat::I8_UINT:
+            return 1;
+        case IndexFormat::I16_UINT:
+            return 2;
+        case IndexFormat::I32_UINT:
+            return 4;
+        default:
+            return 0;
+    }
+}
+
+// size in bytes of a micromap with the given descriptor, as laid out by the baker.
+uint64_t getOmmSizeInBytes( const OptixOpacityMicromapDesc& desc )
+{
+    const uint32_t logStatesPerByte = ( desc.format == OPTIX_OPACITY_MICROMAP_FORMAT_2_STATE ) ? 3 : 2;
+    const uint32_t logSizeInBytes   = std::max( 2u * desc.subdivisionLevel, logStatesPerByte ) - logStatesPerByte;
+    return uint64_t( 1 ) << logSizeInBytes;
+}
+
+// Accesses the buffers of bake inputs and outputs, which hold host pointers when baking on the host.
+class BufferAccess
+{
+  public:
+    BufferAccess( bool host, cudaStream_t stream )
+        : m_host( host )
+        , m_stream( stream )
+    {
+    }
+
+    void read( void* dst, CUdeviceptr src, size_t sizeInBytes ) const
+    {
+        if( sizeInBytes == 0 )
+            return;
+        if( m_host )
+            memcpy( dst, reinterpret_cast<const void*>( src ), sizeInBytes );
+        else
+            checkCudaError( cudaMemcpy( dst, reinterpret_cast<const void*>( src ), sizeInBytes, cudaMemcpyDeviceToHost ), "cudaMemcpy", __FILE__, __LINE__ );
+    }
+
+    // Read numElements elements of elementSize bytes, strideInBytes apart, into a tightly packed vector.
+    std::vector<uint8_t> readStrided( CUdeviceptr src, size_t numElements, size_t elementSize, size_t strideInBytes ) const
+    {
+        std::vector<uint8_t> result( numElements * elementSize );
+        if( numElements == 0 || strideInBytes == elementSize )
+        {
+            read( result.data(), src, result.size() );
+            return result;
+        }
+        std::vector<uint8_t> span( ( numElements - 1 ) * strideInBytes + elementSize );
+        read( span.data(), src, span.size() );
+        for( size_t i = 0; i < numElements; ++i )
+            memcpy( &result[i * elementSize], &span[i * strideInBytes], elementSize );
+        return result;
+    }
+
+    // Write to an output buffer. Writes to device buffers are complete after synchronize().
+    void write( CUdeviceptr dst, const void* src, size_t sizeInBytes ) const
+    {
+        if( sizeInBytes == 0 )
+            return;
+        if( m_host )
+            memcpy( reinterpret_cast<void*>( dst ), src, sizeInBytes );
+        else
+            checkCudaError( cudaMemcpyAsync( reinterpret_cast<void*>( dst ), src, sizeInBytes, cudaMemcpyHostToDevice, m_stream ), "cudaMemcpyAsync", __FILE__, __LINE__ );
+    }
+
+    void synchronize() const
+    {
+        if( !m_host )
+            checkCudaError( cudaStreamSynchronize( m_stream ), "cudaStreamSynchronize", __FILE__, __LINE__ );
+    }
+
+  private:
+    bool         m_host;
+    cudaStream_t m_stream;
+};
+
+// Appends values to a cache file payload.
+class PayloadWriter
+{
+  public:
+    void write( const void* data, size_t sizeInBytes )
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>( data );
+        m_payload.insert( m_payload.end(), bytes, bytes + sizeInBytes );
+    }
+
+    template <typename T>
+    void writeValue( const T& value )
+    {
+        write( &value, sizeof( T ) );
+    }
+
+    std::vector<uint8_t>& get() { return m_payload; }
+
+  private:
+    std::vector<uint8_t> m_payload;
+};
+
+// Reads values from a cache file payload, failing instead of reading past its end.
+class PayloadReader
+{
+  public:
+    explicit PayloadReader( const std::vector<uint8_t>& payload )
+        : m_payload( payload )
+    {
+    }
+
+    // Return a pointer to the next sizeInBytes bytes, or null if the payload is too short.
+    const uint8_t* read( uint64_t sizeInBytes )
+    {
+        if( sizeInBytes > m_payload.size() - m_offset )
+            return nullptr;
+        const uint8_t* data = m_payload.data() + m_offset;
+        m_offset += sizeInBytes;
+        return data;
+    }
+
+    template <typename T>
+    bool readValue( T& value )
+    {
+        const uint8_t* data = read( sizeof( T ) );
+        if( data )
+            memcpy( &value, data, sizeof( T ) );
+        return data != nullptr;
+    }
+
+    bool atEnd() const { return m_offset == m_payload.size(); }
+
+  private:
+    const std::vector<uint8_t>& m_payload;
+    size_t                      m_offset = 0;
+};
+
+// The outputs of a bake, as stored in a cache file.
+struct BakeOutputs
+{
+    BakeCacheFileCounts                             counts = {};
+    std::vector<OptixOpacityMicromapHistogramEntry> histogram;
+    std::vector<OptixOpacityMicromapDesc>           descs;
+    std::vector<uint8_t>                            data;
+    std::vector<std::vector<uint8_t>>               indexBuffers;
+    std::vector<std::vector<OptixOpacityMicromapUsageCount>> usageCounts;
+};
+
+}  // namespace
+
+class BakeCache::Impl
+{
+  public:
+    explicit Impl( const BakeCacheOptions& options )
+        : m_options( options )
+    {
+    }
+
+    void setTextureHash( cudaTextureObject_t texObject, unsigned long long hash )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_textureHashes[texObject] = hash;
+    }
+
+    void removeTextureHash( cudaTextureObject_t texObject )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        m_textureHashes.erase( texObject );
+    }
+
+    Result bakeOpacityMicromaps( const BakeOptions*      options,
+                                 unsigned                numInputs,
+                                 const BakeInputDesc*    inputs,
+                                 const BakeInputBuffers* inputBuffers,
+                                 const BakeBuffers*      buffers,
+                                 cudaStream_t            stream,
+                                 bool*                   cacheHit );
+
+    size_t getSizeInBytes() const;
+
+    BakeCacheStatistics getStatistics() const
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+        return m_statistics;
+    }
+
+    void clear();
+
+  private:
+    BakeCacheOptions                                  m_options;
+    mutable std::mutex                                m_mutex;
+    std::map<cudaTextureObject_t, unsigned long long> m_textureHashes;
+    BakeCacheStatistics                               m_statistics = {};
+    std::atomic<uint32_t>                             m_partialFileCounter{ 0 };
+
+    bool        computeKey( const BufferAccess& access, const BakeOptions& options, unsigned numInputs, const BakeInputDesc* inputs, uint64_t key[2] );
+    void        hashStateTexture( const BufferAccess& access, const StateTextureDesc& texture, otk::ContentHasher& hasher );
+    std::string getFilePath( const uint64_t key[2] ) const;
+    bool        load( const std::string& filePath, const uint64_t key[2], BakeOutputs& outputs );
+    void        store( const std::string& filePath, const uint64_t key[2], const BakeOutputs& outputs );
+    void        evict();
+    void        count( unsigned int BakeCacheStatistics::*counter, unsigned int n = 1 );
+};
+
+void BakeCache::Impl::count( unsigned int BakeCacheStatistics::*counter, unsigned int n )
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+    m_statistics.*counter += n;
+}
+
+void BakeCache::Impl::hashStateTexture( const BufferAccess& access, const StateTextureDesc& texture, otk::ContentHasher& hasher )
+{
+    const uint64_t width  = texture.width;
+    const uint64_t height = texture.height;
+
+    // the same default pitch as the baker.
+    const uint64_t pitchInBits = texture.pitchInBits ? texture.pitchInBits : 2;
+    if( width == 0 || height == 0 )
+        return;
+
+    const uint64_t       sizeInBits = ( height - 1 ) * pitchInBits + 2 * width;
+    std::vector<uint8_t> states( ( sizeInBits + 7 ) / 8 );
+    access.read( states.data(), texture.stateBuffer, states.size() );
+
+    // hash the texel states only, so that padding between rows doesn't affect the key.
+    const uint64_t rowBits = 2 * width;
+    if( pitchInBits % 8 == 0 )
+    {
+        for( uint64_t y = 0; y < height; ++y )
+        {
+            const uint8_t* row = &states[y * pitchInBits / 8];
+            hasher.add( row, rowBits / 8 );
+            if( rowBits % 8 )
+                hasher.addValue<uint8_t>( row[rowBits / 8] & ( ( 1u << ( rowBits % 8 ) ) - 1 ) );
+        }
+    }
+    else
+    {
+        std::vector<uint8_t> packed( ( width * height * 2 + 7 ) / 8 );
+        for( uint64_t y = 0, dst = 0; y < height; ++y )
+        {
+            for( uint64_t x = 0; x < width; ++x, dst += 2 )
+            {
+                const uint64_t src   = y * pitchInBits + 2 * x;
+                const uint8_t  state = ( states[src >> 3] >> ( src & 7 ) ) & 0x3;
+                packed[dst >> 3] |= state << ( dst & 7 );
+            }
+        }
+        hasher.add( packed.data(), packed.size() );
+    }
+}
+
+bool BakeCache::Impl::computeKey( const BufferAccess& access, const BakeOptions& options, unsigned numInputs, const BakeInputDesc* inputs, uint64_t key[2] )
+{
+    otk::ContentHasher hasher;
+    hasher.addValue( BAKE_ALGORITHM_VERSION );
+    hasher.addValue( options.format );
+    hasher.addValue( options.flags );
+    hasher.addValue( options.maximumSizeInBytes );
+    hasher.addValue( options.subdivisionScale );
+    hasher.addValue( numInputs );
+
+    // The baker bakes textures with equivalent descriptors as one texture, identified by the order of first use,
+    // which affects the outputs. The key holds that identifier for every texture reference, and the descriptor
+    // and contents for every distinct texture.
+    std::map<TextureDesc, uint32_t> textureIds;
+
+    for( unsigned inputIdx = 0; inputIdx < numInputs; ++inputIdx )
+    {
+        const BakeInputDesc& input        = inputs[inputIdx];
+        const uint32_t       numTriangles = getNumTriangles( input );
+
+        hasher.addValue( input.indexFormat );
+        hasher.addValue( input.texCoordFormat );
+        hasher.addValue( input.transformFormat );
+        hasher.addValue( input.textureIndexFormat );
+        hasher.addValue( input.numTextures );
+        hasher.addValue( numTriangles );
+
+        uint64_t numTexCoords = input.numTexCoords;
+        if( input.indexFormat != IndexFormat::NONE )
+        {
+            const uint32_t       indexSize   = getIndexSizeInBytes( input.indexFormat );
+            const uint32_t       tripletSize = 3 * indexSize;
+            std::vector<uint8_t> indices     = access.readStrided( input.indexBuffer, numTriangles, tripletSize,
+                                                                   input.indexTripletStrideInBytes ? input.indexTripletStrideInBytes : tripletSize );
+            hasher.add( indices.data(), indices.size() );
+
+            // only the referenced texture coordinates affect the outputs.
+            uint32_t maxIndex = 0;
+            for( size_t i = 0; i < indices.size(); i += indexSize )
+            {
+                uint32_t index = 0;
+                memcpy( &index, &indices[i], indexSize );
+                maxIndex = std::max( maxIndex, index );
+            }
+            numTexCoords = uint64_t( maxIndex ) + 1;
+        }
+
+        const size_t         texCoordSize = sizeof( float2 );
+        std::vector<uint8_t> texCoords    = access.readStrided( input.texCoordBuffer, numTexCoords, texCoordSize,
+                                                                input.texCoordStrideInBytes ? input.texCoordStrideInBytes : texCoordSize );
+        hasher.add( texCoords.data(), texCoords.size() );
+
+        if( input.transformFormat == UVTransformFormat::MATRIX_FLOAT2X3 )
+        {
+            float transform[6];
+            access.read( transform, input.transform, sizeof( transform ) );
+            hasher.add( transform, sizeof( transform ) );
+        }
+
+        if( input.textureIndexFormat != IndexFormat::NONE )
+        {
+            const uint32_t       indexSize = getIndexSizeInBytes( input.textureIndexFormat );
+            std::vector<uint8_t> indices   = access.readStrided( input.textureIndexBuffer, numTriangles, indexSize,
+                                                                 input.textureIndexStrideInBytes ? input.textureIndexStrideInBytes : indexSize );
+            hasher.add( indices.data(), indices.size() );
+        }
+
+        for( unsigned textureIdx = 0; textureIdx < input.numTextures; ++textureIdx )
+        {
+            const TextureDesc& texture = input.textures[textureIdx];
+
+            auto inserted = textureIds.emplace( texture, static_cast<uint32_t>( textureIds.size() ) );
+            hasher.addValue( inserted.first->second );
+            if( !inserted.second )
+                continue;
+
+            hasher.addValue( texture.type );
+            if( texture.type == TextureType::STATE )
+            {
+                hasher.addValue( texture.state.width );
+                hasher.addValue( texture.state.height );
+                hasher.addValue( texture.state.filterKernelWidthInTexels );
+                hasher.addValue( texture.state.addressMode[0] );
+                hasher.addValue( texture.state.addressMode[1] );
+                hashStateTexture( access, texture.state, hasher );
+            }
+            else
+            {
+                unsigned long long contentHash;
+                {
+                    std::lock_guard<std::mutex> lock( m_mutex );
+                    auto                        it = m_textureHashes.find( texture.cuda.texObject );
+                    if( it == m_textureHashes.end() )
+                        return false;
+                    contentHash = it->second;
+                }
+
+                cudaTextureDesc texDesc;
+                if( cudaGetTextureObjectTextureDesc( &texDesc, texture.cuda.texObject ) != cudaSuccess )
+                    return false;
+
+                hasher.addValue( contentHash );
+                hasher.addValue( texture.cuda.alphaMode );
+                hasher.addValue( texture.cuda.transparencyCutoff );
+                hasher.addValue( texture.cuda.opacityCutoff );
+                hasher.addValue( texture.cuda.filterKernelWidthInTexels );
+                hasher.addValue( texDesc.addressMode[0] );
+                hasher.addValue( texDesc.addressMode[1] );
+                hasher.addValue( texDesc.filterMode );
+                hasher.addValue( texDesc.readMode );
+            }
+        }
+    }
+
+    hasher.get( key );
+    return true;
+}
+
+std::string BakeCache::Impl::getFilePath( const uint64_t key[2] ) const
+{
+    char name[33];
+    snprintf( name, sizeof( name ), "%016" PRIx64 "%016" PRIx64, key[0], key[1] );
+    return ( fs::path( m_options.directory ) / ( std::string( name ) + BAKE_CACHE_FILE_EXTENSION ) ).string();
+}
+
+bool BakeCache::Impl::load( const std::string& filePath, const uint64_t key[2], BakeOutputs& outputs )
+{
+    std::ifstream file( filePath, std::ios::binary );
+    if( !file )
+        return false;
+
+    BakeCacheFileHeader header = {};
+    std::vector<uint8_t> payload;
+    bool valid = static_cast<bool>( file.read( reinterpret_cast<char*>( &header ), sizeof( header ) ) ) && header.magic == BAKE_CACHE_FILE_MAGIC
+                 && header.version == BAKE_CACHE_FILE_VERSION && header.key[0] == key[0] && header.key[1] == key[1];
+    if( valid )
+    {
+        std::error_code ec;
+        valid = fs::file_size( filePath, ec ) == sizeof( header ) + header.payloadSizeInBytes && !ec;
+    }
+    if( valid )
+    {
+        payload.resize( header.payloadSizeInBytes );
+        valid = static_cast<bool>( file.read( reinterpret_cast<char*>( payload.data() ), payload.size() ) ) && checksum( payload ) == header.payloadChecksum;
+    }
+
+    PayloadReader reader( payload );
+    valid = valid && reader.readValue( outputs.counts );
+
+    // read an array of values, checking that it fits in the payload before allocating it.
+    auto readArray = [&reader]( auto& array, uint64_t numElems ) {
+        using T = typename std::decay_t<decltype( array )>::value_type;
+        if( numElems > ( std::numeric_limits<uint64_t>::max() / sizeof( T ) ) )
+            return false;
+        const uint8_t* data = reader.read( numElems * sizeof( T ) );
+        if( !data )
+            return false;
+        array.resize( numElems );
+        memcpy( array.data(), data, numElems * sizeof( T ) );
+        return true;
+    };
+
+    std::vector<uint64_t> sizes;
+    valid = valid && readArray( sizes, 2 * uint64_t( outputs.counts.numInputs ) ) && readArray( outputs.histogram, outputs.counts.numMicromapHistogramEntries )
+            && readArray( outputs.descs, outputs.counts.numMicromapDescs ) && readArray( outputs.data, outputs.counts.compactedSizeInBytes );
+
+    outputs.indexBuffers.resize( valid ? outputs.counts.numInputs : 0 );
+    outputs.usageCounts.resize( valid ? outputs.counts.numInputs : 0 );
+    for( uint32_t i = 0; valid && i < outputs.counts.numInputs; ++i )
+        valid = readArray( outputs.indexBuffers[i], sizes[2 * i] ) && readArray( outputs.usageCounts[i], sizes[2 * i + 1] );
+
+    valid = valid && reader.atEnd();
+    if( !valid )
+    {
+        file.close();
+        std::error_code ec;
+        fs::remove( filePath, ec );
+        count( &BakeCacheStatistics::numCorruptFiles );
+        return false;
+    }
+
+    // mark the file as recently used for eviction.
+    std::error_code ec;
+    fs::last_write_time( filePath, fs::file_time_type::clock::now(), ec );
+    return true;
+}
+
+void BakeCache::Impl::store( const std::string& filePath, const uint64_t key[2], const BakeOutputs& outputs )
+{
+    PayloadWriter writer;
+    writer.writeValue( outputs.counts );
+    for( uint32_t i = 0; i < outputs.counts.numInputs; ++i )
+    {
+        writer.writeValue<uint64_t>( outputs.indexBuffers[i].size() );
+        writer.writeValue<uint64_t>( outputs.usageCounts[i].size() );
+    }
+    writer.write( outputs.histogram.data(), outputs.histogram.size() * sizeof( OptixOpacityMicromapHistogramEntry ) );
+    writer.write( outputs.descs.data(), outputs.descs.size() * sizeof( OptixOpacityMicromapDesc ) );
+    writer.write( outputs.data.data(), outputs.data.size() );
+    for( uint32_t i = 0; i < outputs.counts.numInputs; ++i )
+    {
+        writer.write( outputs.indexBuffers[i].data(), outputs.indexBuffers[i].size() );
+        writer.write( outputs.usageCounts[i].data(), outputs.usageCounts[i].size() * sizeof( OptixOpacityMicromapUsageCount ) );
+    }
+    const std::vector<uint8_t>& payload = writer.get();
+
+    BakeCacheFileHeader header = {};
+    header.magic               = BAKE_CACHE_FILE_MAGIC;
+    header.version             = BAKE_CACHE_FILE_VERSION;
+    header.key[0]              = key[0];
+    header.key[1]              = key[1];
+    header.payloadSizeInBytes  = payload.size();
+    header.payloadChecksum     = checksum( payload );
+
+    if( sizeof( header ) + payload.size() > m_options.maxSizeInBytes )
+        return;
+
+    std::error_code ec;
+    fs::create_directories( m_options.directory, ec );
+
+    // write a uniquely named partial file, and rename it once complete, so that concurrent loads
+    // never see a partially written file.
+    const std::string partialFilePath = filePath + "." + std::to_string( m_partialFileCounter++ ) + ".part";
+    {
+        std::ofstream file( partialFilePath, std::ios::binary | std::ios::trunc );
+        file.write( reinterpret_cast<const char*>( &header ), sizeof( header ) );
+        file.write( reinterpret_cast<const char*>( payload.data() ), payload.size() );
+        if( !file.flush() )
+        {
+            file.close();
+            fs::remove( partialFilePath, ec );
+            return;
+        }
+    }
+    fs::rename( partialFilePath, filePath, ec );
+    if( ec )
+    {
+        fs::remove( partialFilePath, ec );
+        return;
+    }
+
+    evict();
+}
+
+void BakeCache::Impl::evict()
+{
+    struct CacheFile
+    {
+        fs::path            path;
+        uintmax_t           size;
+        fs::file_time_type  time;
+    };
+
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    std::error_code        ec;
+    std::vector<CacheFile> files;
+    uintmax_t              totalSize = 0;
+    for( const fs::directory_entry& entry : fs::directory_iterator( m_options.directory, ec ) )
+    {
+        if( entry.path().extension() != BAKE_CACHE_FILE_EXTENSION )
+            continue;
+        CacheFile file{ entry.path(), entry.file_size( ec ), entry.last_write_time( ec ) };
+        if( ec )
+            continue;
+        totalSize += file.size;
+        files.push_back( file );
+    }
+    if( totalSize <= m_options.maxSizeInBytes )
+        return;
+
+    // remove the least recently used files first.
+    std::sort( files.begin(), files.end(), []( const CacheFile& a, const CacheFile& b ) { return a.time < b.time; } );
+    for( const CacheFile& file : files )
+    {
+        if( totalSize <= m_options.maxSizeInBytes )
+            break;
+        if( fs::remove( file.path, ec ) )
+        {
+            totalSize -= file.size;
+            ++m_statistics.numEvictions;
+        }
+    }
+}
+
+size_t BakeCache::Impl::getSizeInBytes() const
+{
+    std::error_code ec;
+    size_t          totalSize = 0;
+    for( const fs::directory_entry& entry : fs::directory_iterator( m_options.directory, ec ) )
+    {
+        if( entry.path().extension() == BAKE_CACHE_FILE_EXTENSION )
+            totalSize += entry.file_size( ec );
+    }
+    return totalSize;
+}
+
+void BakeCache::Impl::clear()
+{
+    std::lock_guard<std::mutex> lock( m_mutex );
+
+    std::error_code       ec;
+    std::vector<fs::path> files;
+    for( const fs::directory_entry& entry : fs::directory_iterator( m_options.directory, ec ) )
+    {
+        if( entry.path().extension() == BAKE_CACHE_FILE_EXTENSION )
+            files.push_back( entry.path() );
+    }
+    for( const fs::path& file : files )
+        fs::remove( file, ec );
+}
+
+Result BakeCache::Impl::bakeOpacityMicromaps( const BakeOptions*      options,
+                                              unsigned                numInputs,
+                                              const BakeInputDesc*    inputs,
+                                              const BakeInputBuffers* inputBuffers,
+                                              const BakeBuffers*      buffers,
+                                              cudaStream_t            stream,
+                                              bool*                   cacheHit )
+{
+    if( cacheHit )
+        *cacheHit = false;
+
+    // Validates the arguments, and provides the output sizes a cache file must match.
+    std::vector<BakeInputBuffers> preBakeInputBuffers( numInputs );
+    BakeBuffers                   preBakeBuffers = {};
+    const Result                  preBakeResult = GetPreBakeInfo( options, numInputs, inputs, preBakeInputBuffers.data(), &preBakeBuffers );
+    if( preBakeResult != Result::SUCCESS )
+        return preBakeResult;
+
+    // let BakeOpacityMicromaps report missing output buffers.
+    bool hasOutputBuffers = inputBuffers && buffers && buffers->outputBuffer && buffers->perMicromapDescBuffer && buffers->micromapHistogramEntriesBuffer;
+    for( unsigned i = 0; hasOutputBuffers && i < numInputs; ++i )
+        hasOutputBuffers = ( inputBuffers[i].indexBuffer || !preBakeInputBuffers[i].indexBufferSizeInBytes )
+                           && ( inputBuffers[i].micromapUsageCountsBuffer || !preBakeInputBuffers[i].numMicromapUsageCounts );
+    if( !hasOutputBuffers )
+        return BakeOpacityMicromaps( options, numInputs, inputs, inputBuffers, buffers, stream );
+
+    try
+    {
+        const BufferAccess access( options->backend == BakeBackend::HOST, stream );
+
+        // the inputs may still be written in the stream.
+        access.synchronize();
+
+        uint64_t key[2];
+        if( !computeKey( access, *options, numInputs, inputs, key ) )
+        {
+            count( &BakeCacheStatistics::numUncacheable );
+            return BakeOpacityMicromaps( options, numInputs, inputs, inputBuffers, buffers, stream );
+        }
+
+        const std::string filePath = getFilePath( key );
+        const bool        postBakeInfo =
+            ( options->flags & BakeFlags::ENABLE_POST_BAKE_INFO ) == BakeFlags::ENABLE_POST_BAKE_INFO && buffers->postBakeInfoBuffer;
+
+        BakeOutputs outputs;
+        if( load( filePath, key, outputs ) )
+        {
+            bool matches = outputs.counts.indexFormat == static_cast<uint32_t>( preBakeBuffers.indexFormat )
+                           && outputs.counts.numInputs == numInputs
+                           && outputs.histogram.size() == preBakeBuffers.numMicromapHistogramEntries
+                           && outputs.descs.size() <= preBakeBuffers.numMicromapDescs
+                           && outputs.data.size() <= preBakeBuffers.outputBufferSizeInBytes;
+            for( unsigned i = 0; matches && i < numInputs; ++i )
+                matches = outputs.indexBuffers[i].size() == preBakeInputBuffers[i].indexBufferSizeInBytes
+                          && outputs.usageCounts[i].size() == preBakeInputBuffers[i].numMicromapUsageCounts;
+
+            if( matches )
+            {
+                access.write( buffers->micromapHistogramEntriesBuffer, outputs.histogram.data(), outputs.histogram.size() * sizeof( OptixOpacityMicromapHistogramEntry ) );
+                access.write( buffers->perMicromapDescBuffer, outputs.descs.data(), outputs.descs.size() * sizeof( OptixOpacityMicromapDesc ) );
+                access.write( buffers->outputBuffer, outputs.data.data(), outputs.data.size() );
+                for( unsigned i = 0; i < numInputs; ++i )
+                {
+                    access.write( inputBuffers[i].indexBuffer, outputs.indexBuffers[i].data(), outputs.indexBuffers[i].size() );
+                    access.write( inputBuffers[i].micromapUsageCountsBuffer, outputs.usageCounts[i].data(),
+                                  outputs.usageCounts[i].size() * sizeof( OptixOpacityMicromapUsageCount ) );
+                }
+
+                PostBakeInfo info         = {};
+                info.numMicromapDescs     = outputs.counts.numMicromapDescs;
+                info.compactedSizeInBytes = static_cast<unsigned int>( outputs.counts.compactedSizeInBytes );
+                if( postBakeInfo )
+                    access.write( buffers->postBakeInfoBuffer, &info, sizeof( info ) );
+
+                // the outputs are copied from pageable host memory, which is released on return.
+                access.synchronize();
+
+                count( &BakeCacheStatistics::numHits );
+                if( cacheHit )
+                    *cacheHit = true;
+                return Result::SUCCESS;
+            }
+
+            // sizes that don't match the inputs are as invalid as a bad checksum.
+            std::error_code ec;
+            fs::remove( filePath, ec );
+            count( &BakeCacheStatistics::numCorruptFiles );
+        }
+
+        const Result bakeResult = BakeOpacityMicromaps( options, numInputs, inputs, inputBuffers, buffers, stream );
+        if( bakeResult != Result::SUCCESS )
+            return bakeResult;
+        access.synchronize();
+        count( &BakeCacheStatistics::numMisses );
+
+        // read back the outputs, keeping only the used descriptors and data.
+        outputs                       = {};
+        outputs.counts.indexFormat    = static_cast<uint32_t>( preBakeBuffers.indexFormat );
+        outputs.counts.numInputs      = numInputs;
+        outputs.counts.numMicromapHistogramEntries = static_cast<uint32_t>( preBakeBuffers.numMicromapHistogramEntries );
+
+        outputs.histogram.resize( preBakeBuffers.numMicromapHistogramEntries );
+        access.read( outputs.histogram.data(), buffers->micromapHistogramEntriesBuffer, outputs.histogram.size() * sizeof( OptixOpacityMicromapHistogramEntry ) );
+        for( const OptixOpacityMicromapHistogramEntry& entry : outputs.histogram )
+            outputs.counts.numMicromapDescs += entry.count;
+        if( outputs.counts.numMicromapDescs > preBakeBuffers.numMicromapDescs )
+            throw Exception( Result::ERROR_INTERNAL, "Baked histogram exceeds the number of micromap descriptors." );
+
+        outputs.descs.resize( outputs.counts.numMicromapDescs );
+        access.read( outputs.descs.data(), buffers->perMicromapDescBuffer, outputs.descs.size() * sizeof( OptixOpacityMicromapDesc ) );
+        for( const OptixOpacityMicromapDesc& desc : outputs.descs )
+            outputs.counts.compactedSizeInBytes = std::max<uint64_t>( outputs.counts.compactedSizeInBytes, desc.byteOffset + getOmmSizeInBytes( desc ) );
+        if( outputs.counts.compactedSizeInBytes > preBakeBuffers.outputBufferSizeInBytes )
+            throw Exception( Result::ERROR_INTERNAL, "Baked micromap descriptors exceed the output buffer." );
+
+        outputs.data.resize( outputs.counts.compactedSizeInBytes );
+        access.read( outputs.data.data(), buffers->outputBuffer, outputs.data.size() );
+
+        outputs.indexBuffers.resize( numInputs );
+        outputs.usageCounts.resize( numInputs );
+        for( unsigned i = 0; i < numInputs; ++i )
+        {
+            outputs.indexBuffers[i].resize( preBakeInputBuffers[i].indexBufferSizeInBytes );
+            access.read( outputs.indexBuffers[i].data(), inputBuffers[i].indexBuffer, outputs.indexBuffers[i].size() );
+            outputs.usageCounts[i].resize( preBakeInputBuffers[i].numMicromapUsageCounts );
+            access.read( outputs.usageCounts[i].data(), inputBuffers[i].micromapUsageCountsBuffer,
+                         outputs.usageCounts[i].size() * sizeof( OptixOpacityMicromapUsageCount ) );
+        }
+
+        store( filePath, key, outputs );
+    }
+    catch( const Exception& exception )
+    {
+        std::cerr << exception.what() << std::endl;
+        return exception.getResult();
+    }
+    catch( ... )
+    {
+        return Result::ERROR_INTERNAL;
+    }
+
+    return Result::SUCCESS;
+}
+
+BakeCache::BakeCache( const BakeCacheOptions& options )
+    : m_impl( new Impl( options ) )
+{
+}
+
+BakeCache::~BakeCache() = default;
+
+void BakeCache::setTextureHash( cudaTextureObject_t texObject, unsigned long long hash )
+{
+    m_impl->setTextureHash( texObject, hash );
+}
+
+void BakeCache::removeTextureHash( cudaTextureObject_t texObject )
+{
+    m_impl->removeTextureHash( texObject );
+}
+
+Result BakeCache::bakeOpacityMicromaps( const BakeOptions*      options,
+                                        unsigned                numInputs,
+                                        const BakeInputDesc*    inputs,
+                                        const BakeInputBuffers* inputBuffers,
+                                        const BakeBuffers*      buffers,
+                                        cudaStream_t            stream,
+                                        bool*                   cacheHit )
+{
+    return m_impl->bakeOpacityMicromaps( options, numInputs, inputs, inputBuffers, buffers, stream, cacheHit );
+}
+
+size_t BakeCache::getSizeInBytes() const
+{
+    return m_impl->getSizeInBytes();
+}
+
+BakeCacheStatistics BakeCache::getStatistics() const
+{
+    return m_impl->getStatistics();
+}
+
+void BakeCache::clear()
+{
+    m_impl->clear();
+}
+
+}  // namespace cuOmmBaking
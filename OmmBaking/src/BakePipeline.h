@@ -0,0 +1,571 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+/// \file BakePipeline.h
+/// Per-element work of the baking stages, shared by the CUDA kernels in CuOmmBakingImpl.cu and the
+/// host implementation in CuOmmBakingHost.cpp.  Both backends must produce identical results, so all
+/// floating point math in this file uses the helpers below, which call explicitly rounded CUDA intrinsics
+/// on the device and emulate them on the host, so that fast math and fma contraction don't apply.
+
+#include "CuOmmBakingImpl.h"
+#include "Evaluate.h"
+#include "Triangle.h"
+
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+#ifndef __CUDACC__
+// optix_micromap.h uses the __uint_as_float intrinsic, which the host compiler doesn't provide.
+inline float __uint_as_float( unsigned int i )
+{
+    float f;
+    memcpy( &f, &i, sizeof( f ) );
+    return f;
+}
+#endif
+
+#include <optix_micromap.h>
+
+// Areas are summed in fixed point, in units of 1/16th texel, making the sum independent of the order of summation.
+// Areas are clamped to 2^27 texels, so the sum over 2^32 omms fits in 64 bits.
+#define OMM_AREA_FIXED_POINT_SCALE 16.f
+#define OMM_AREA_MAX_IN_TEXELS 134217728.f
+
+// returns true if the value is not a number.
+inline __host__ __device__ bool isNaN( float f )
+{
+#ifdef __CUDA_ARCH__
+    return isnan( f );
+#else
+    return std::isnan( f );
+#endif
+}
+
+// a / b, rounded towards zero, like __fdiv_rz.
+inline __host__ __device__ float divRoundTowardZero( float a, float b )
+{
+#ifdef __CUDA_ARCH__
+    return __fdiv_rz( a, b );
+#else
+    float q = a / b;
+    if( std::isinf( q ) && std::isfinite( a ) && b != 0.f )
+        return std::copysign( FLT_MAX, q );
+    // the product of two floats is exact in double precision.
+    if( std::isfinite( q ) && std::fabs( ( double )q * ( double )b ) > std::fabs( ( double )a ) )
+        q = std::nextafter( q, 0.f );
+    return q;
+#endif
+}
+
+// 1 / x, rounded down, like __frcp_rd.
+inline __host__ __device__ float reciprocalRoundDown( float x )
+{
+#ifdef __CUDA_ARCH__
+    return __frcp_rd( x );
+#else
+    float r = 1.f / x;
+    if( std::isfinite( r ) && r != 0.f )
+    {
+        const double p = ( double )r * ( double )x;
+        if( x > 0.f ? p > 1.0 : p < 1.0 )
+            r = std::nextafter( r, -INFINITY );
+    }
+    return r;
+#endif
+}
+
+// a * b + c for finite arguments, rounded towards zero, like __fmaf_rz.
+inline __host__ __device__ float fmaRoundTowardZero( float a, float b, float c )
+{
+#ifdef __CUDA_ARCH__
+    return __fmaf_rz( a, b, c );
+#else
+    // the product is exact in double precision, and s + e is the exact sum.
+    const double p  = ( double )a * ( double )b;
+    const double s  = p + ( double )c;
+    const double pp = s - ( double )c;
+    const double e  = ( p - pp ) + ( ( double )c - ( s - pp ) );
+
+    float r = ( float )s;
+    if( !std::isfinite( r ) )
+        return std::isfinite( s ) ? std::copysign( FLT_MAX, r ) : r;
+
+    // step towards zero if r is further from zero than s + e.
+    const double diff = ( ( double )r - s ) - e;
+    if( ( r > 0.f && diff > 0.0 ) || ( r < 0.f && diff < 0.0 ) )
+        r = std::nextafter( r, 0.f );
+    return r;
+#endif
+}
+
+// convert to float, rounding up, like __ull2float_ru.
+inline __host__ __device__ float uint64ToFloatRoundUp( uint64_t x )
+{
+#ifdef __CUDA_ARCH__
+    return __ull2float_ru( x );
+#else
+    float f = ( float )x;
+    if( f < 18446744073709551616.f && ( uint64_t )f < x )
+        f = std::nextafter( f, INFINITY );
+    return f;
+#endif
+}
+
+// convert to float, rounding down, like __uint2float_rd.
+inline __host__ __device__ float uint32ToFloatRoundDown( uint32_t x )
+{
+#ifdef __CUDA_ARCH__
+    return __uint2float_rd( x );
+#else
+    float f = ( float )x;
+    if( ( uint64_t )f > x )
+        f = std::nextafter( f, 0.f );
+    return f;
+#endif
+}
+
+// number of leading zero bits, like __clz.
+inline __host__ __device__ uint32_t countLeadingZeros( uint32_t x )
+{
+#ifdef __CUDA_ARCH__
+    return __clz( x );
+#else
+    uint32_t n = 32;
+    for( ; x; x >>= 1 )
+        --n;
+    return n;
+#endif
+}
+
+// a * b, rounded to nearest, like __fmul_rn. Neither this nor the helpers below are contracted into an fma by
+// the compiler, regardless of fast math. The products and sums of two floats computed in double precision round
+// to the same float as the exact result.
+inline __host__ __device__ float mulRoundNearest( float a, float b )
+{
+#ifdef __CUDA_ARCH__
+    return __fmul_rn( a, b );
+#else
+    return ( float )( ( double )a * ( double )b );
+#endif
+}
+
+// a + b, rounded to nearest, like __fadd_rn.
+inline __host__ __device__ float addRoundNearest( float a, float b )
+{
+#ifdef __CUDA_ARCH__
+    return __fadd_rn( a, b );
+#else
+    return ( float )( ( double )a + ( double )b );
+#endif
+}
+
+// a - b, rounded to nearest, like __fsub_rn.
+inline __host__ __device__ float subRoundNearest( float a, float b )
+{
+#ifdef __CUDA_ARCH__
+    return __fsub_rn( a, b );
+#else
+    return ( float )( ( double )a - ( double )b );
+#endif
+}
+
+// a * b + c, rounded to nearest, like __fmaf_rn.
+inline __host__ __device__ float fmaRoundNearest( float a, float b, float c )
+{
+#ifdef __CUDA_ARCH__
+    return __fmaf_rn( a, b, c );
+#else
+    return std::fma( a, b, c );
+#endif
+}
+
+inline __host__ __device__ float2 mulRoundNearest( float2 a, float2 b )
+{
+    return { mulRoundNearest( a.x, b.x ), mulRoundNearest( a.y, b.y ) };
+}
+
+inline __host__ __device__ float2 subRoundNearest( float2 a, float2 b )
+{
+    return { subRoundNearest( a.x, b.x ), subRoundNearest( a.y, b.y ) };
+}
+
+// p + s * du + t * dv, rounded like the CUDA kernels.
+inline __host__ __device__ float2 interpolateRoundNearest( float2 p, float s, float2 du, float t, float2 dv )
+{
+    return { fmaRoundNearest( t, dv.x, fmaRoundNearest( s, du.x, p.x ) ), fmaRoundNearest( t, dv.y, fmaRoundNearest( s, du.y, p.y ) ) };
+}
+
+// the area of the triangle, like Triangle::Area, rounded like the CUDA kernels.
+inline __host__ __device__ float triangleArea( const Triangle& triangle )
+{
+    const float2 e0 = subRoundNearest( triangle.uv1, triangle.uv0 );
+    const float2 e1 = subRoundNearest( triangle.uv2, triangle.uv0 );
+    return 0.5f * fabsf( subRoundNearest( mulRoundNearest( e0.x, e1.y ), mulRoundNearest( e0.y, e1.x ) ) );
+}
+
+// a la std::upper_bound, specialized for ForwardIt=uint32_t
+template <class T, typename Compare>
+__host__ __device__ uint32_t upper_bound( uint32_t first, uint32_t last, T value, Compare comp )
+{
+    while( first < last )
+    {
+        uint32_t m = ( first + last ) / 2;
+        if( !comp( value, m ) )
+            first = m + 1;
+        else
+            last = m;
+    };
+
+    return first;
+}
+
+inline __host__ __device__ uint32_t getLogStatesPerByte( OptixOpacityMicromapFormat format )
+{
+    return ( format == OPTIX_OPACITY_MICROMAP_FORMAT_2_STATE ) ? 3 : 2;
+}
+
+// size of an omm in bytes. zero if the size doesn't fit in 32 bits.
+inline __host__ __device__ uint32_t getOmmSizeInBytes( uint32_t subdivisionLevel, uint32_t logStatesPerByte )
+{
+    const uint32_t logSizeInBytes = max( 2u * subdivisionLevel, logStatesPerByte ) - logStatesPerByte;
+    return ( logSizeInBytes < 32 ) ? ( 1u << logSizeInBytes ) : 0u;
+}
+
+// area in fixed point units, clamping non-real and very large areas.
+inline __host__ __device__ uint32_t areaToFixedPoint( float area )
+{
+    if( !( area >= 0.f ) )
+        area = 0.f;
+    area = fminf( area, OMM_AREA_MAX_IN_TEXELS );
+    return ( uint32_t )ceilf( mulRoundNearest( area, OMM_AREA_FIXED_POINT_SCALE ) );
+}
+
+inline __host__ __device__ OpacityStateSet sampleTextureState( const TextureInput* textures, Triangle triangle, unsigned resolution )
+{
+    const TextureData& texture = textures[triangle.texture].data;
+
+    const float2 scale = { ( float )texture.width, ( float )texture.height };
+
+    float2 uv0 = mulRoundNearest( triangle.uv0, scale );
+    float2 uv1 = mulRoundNearest( triangle.uv1, scale );
+    float2 uv2 = mulRoundNearest( triangle.uv2, scale );
+
+    return sampleMemoryTexture( texture, uv0, uv1, uv2, texture.filterKernelRadiusInTexels, resolution );
+}
+
+inline __host__ __device__ void setupBakeInputTriangle( const SetupBakeInputParams& params, uint32_t index )
+{
+    TriangleID id = {};
+    id.triangleIndex = index;
+    id.inputIndex = params.inputIdx;
+
+    Triangle triangle = loadTriangle( params.input, index );
+
+    OpacityStateSet state = {};
+    // filter out invalid triangles
+    if( !isNaN( triangleArea( triangle ) ) )
+        state = sampleTextureState( params.textures, triangle, 16 );
+
+    id.uniform = 1;
+    if( params.format == OPTIX_OPACITY_MICROMAP_FORMAT_2_STATE )
+    {
+        // conservatively mark everything as opaque except fully transparent triangles.
+        if( state.isTransparent() )
+        {
+            id.state = OPTIX_OPACITY_MICROMAP_STATE_TRANSPARENT;
+        }
+        else if( state.hasTransparent() )
+        {
+            // has a mixture of transparent and non-transparent states.
+            id.uniform = 0;
+        }
+        else
+        {
+            // mixtures of opaque and unknown are marked as opaque.
+            id.state = OPTIX_OPACITY_MICROMAP_STATE_OPAQUE;
+        }
+    }
+    else // OPTIX_OPACITY_MICROMAP_FORMAT_4_STATE
+    {
+        if( !state.isUniform() )
+        {
+            // has a mixture of states
+            id.uniform = 0;
+        }
+        else
+        {
+            if( state.isTransparent() )
+            {
+                id.state = OPTIX_OPACITY_MICROMAP_STATE_TRANSPARENT;
+            }
+            else if( state.isOpaque() )
+            {
+                id.state = OPTIX_OPACITY_MICROMAP_STATE_OPAQUE;
+            }
+            else
+            {
+                id.state = OPTIX_OPACITY_MICROMAP_STATE_UNKNOWN_OPAQUE;
+            }
+        }
+    }
+
+    uint32_t key = 0;
+    if( id.uniform == 0 )
+    {
+        id.uniform = 0;
+        key = hash( canonicalizeTriangle( triangle, params.textures ) );
+    }
+
+    params.outTriangleIDs[index] = id;
+    params.outHashKeys[index] = key;
+}
+
+inline __host__ __device__ void markFirstOmmOccuranceTriangle( const MarkFirstOmmOccuranceParams& params, uint32_t index )
+{
+    bool isNewDuplicateGroup;
+
+    TriangleID id = params.inTriangleIDs[index];
+
+    // skip fully opaque/transparent triangles
+    if( id.uniform )
+    {
+        isNewDuplicateGroup = false;
+    }
+    else
+    {
+        // early out hash check. if the hashes don't match there's no need to perform the costly collision check.
+        if( index > 0 && params.inHashKeys[index - 1] == params.inHashKeys[index] )
+        {
+            TriangleID prevId = params.inTriangleIDs[index-1];
+
+            Triangle nextTriangle = loadTriangle( params.inBakeInputs[id.inputIndex].desc, id.triangleIndex );
+            Triangle prevTriangle = loadTriangle( params.inBakeInputs[prevId.inputIndex].desc, prevId.triangleIndex );
+
+            if( prevTriangle.texture != nextTriangle.texture )
+            {
+                isNewDuplicateGroup = true;
+            }
+            else
+            {
+                // compare the canonicalized triangles to match near identical triangles and match under wrapping.
+                nextTriangle = canonicalizeTriangle( nextTriangle, params.inBakeInputs[id.inputIndex].inTextures );
+                prevTriangle = canonicalizeTriangle( prevTriangle, params.inBakeInputs[id.inputIndex].inTextures );
+
+                isNewDuplicateGroup = ( nextTriangle != prevTriangle );
+            }
+        }
+        else
+        {
+            isNewDuplicateGroup = true;
+        }
+    }
+
+    params.outMarkers[index] = isNewDuplicateGroup ? 1 : 0;
+}
+
+// index == numTriangles writes the number of omms.
+inline __host__ __device__ void generateAssignmentTriangle( const GenerateAssignmentParams& params, uint32_t index )
+{
+    if( index < params.numTriangles )
+    {
+        TriangleID id = params.inTriangleIDs[index];
+        uint32_t   assignment = 0;
+        if( !id.uniform ) {
+            assignment = params.inAssignment[index] - 1;
+
+            // crude method to prevent omm array overflow by marking any excess omms as unkown.
+            if( assignment >= params.maxOmms )
+            {
+                assignment = ( uint32_t )OPTIX_OPACITY_MICROMAP_PREDEFINED_INDEX_FULLY_UNKNOWN_OPAQUE;
+            }
+            // write out a representative triangle id for each duplicate group
+            else if( index == 0 || assignment != (params.inAssignment[index - 1] - 1) )
+            {
+                params.outOmmTriangleId[assignment] = id;
+
+                const BakeInput& input = params.inBakeInputs[id.inputIndex];
+
+                Triangle triangle = loadTriangle( input.desc, id.triangleIndex );
+
+                // compute area in texels
+                const TextureInput& textureInput = input.inTextures[triangle.texture];
+                float2 scale = {
+                    ( float )textureInput.data.width,
+                    ( float )textureInput.data.height };
+                triangle.uv0 = mulRoundNearest( triangle.uv0, scale );
+                triangle.uv1 = mulRoundNearest( triangle.uv1, scale );
+                triangle.uv2 = mulRoundNearest( triangle.uv2, scale );
+
+                params.outOmmArea[assignment] = areaToFixedPoint( triangleArea( triangle ) );
+            }
+        } else if( id.state == 0 ) {
+            assignment = ( uint32_t )OPTIX_OPACITY_MICROMAP_PREDEFINED_INDEX_FULLY_TRANSPARENT;
+        } else if( id.state == 1 ) {
+            assignment = ( uint32_t )OPTIX_OPACITY_MICROMAP_PREDEFINED_INDEX_FULLY_OPAQUE;
+        } else if( id.state == 2 ) {
+            assignment = ( uint32_t )OPTIX_OPACITY_MICROMAP_PREDEFINED_INDEX_FULLY_UNKNOWN_TRANSPARENT;
+        } else if( id.state == 3 ) {
+            assignment = ( uint32_t )OPTIX_OPACITY_MICROMAP_PREDEFINED_INDEX_FULLY_UNKNOWN_OPAQUE;
+        }
+
+        void* outAssignments = params.inBakeInputs[id.inputIndex].outAssignments;
+        if( params.indexFormat == cuOmmBaking::IndexFormat::I16_UINT )
+            (( uint16_t* )outAssignments)[id.triangleIndex] = ( uint16_t )assignment;
+        else
+            (( uint32_t* )outAssignments)[id.triangleIndex] = assignment;
+    }
+    else if( index == params.numTriangles )
+    {
+        // copy total number of omms, clamped to the maximum number of omms
+        *params.outNumOmms = index ? min( params.maxOmms, params.inAssignment[params.numTriangles - 1] ) : 0u;
+    }
+}
+
+// the subdivision level whose micro-triangle count is nearest to numMicroTriangles on a log scale, at least one.
+// equivalent to max( 1, roundf( 0.5f * log2f( numMicroTriangles ) ) ), without the rounding errors of log2f.
+inline __host__ __device__ uint32_t getTargetSubdivisionLevel( float numMicroTriangles )
+{
+    if( !( numMicroTriangles >= 1.f ) )
+        return 1;
+    if( numMicroTriangles > FLT_MAX )
+        return ~0u;
+
+    // numMicroTriangles = m * 2^exp, with m in [0.5,1)
+    int exp;
+    frexpf( numMicroTriangles, &exp );
+    return max( 1u, ( uint32_t )exp >> 1 );
+}
+
+// the total omm area in texels, rounded up.
+inline __host__ __device__ float loadSumArea( const GenerateLayoutParams& params )
+{
+    return params.inSumArea ? mulRoundNearest( uint64ToFloatRoundUp( *params.inSumArea ), 1.f / OMM_AREA_FIXED_POINT_SCALE ) : 0.f;
+}
+
+// the subdivision level of an omm, maximized within the omm's share of the omm array size.
+inline __host__ __device__ uint32_t getOmmSubdivisionLevel( const GenerateLayoutParams& params, uint32_t numOmms, float sumArea, uint32_t index )
+{
+    const uint32_t logStatesPerByte = getLogStatesPerByte( params.format );
+
+    const float area = mulRoundNearest( uint32ToFloatRoundDown( params.inOmmArea[index] ), 1.f / OMM_AREA_FIXED_POINT_SCALE );
+
+    // the normalized weight determines the available share of omm data in bytes for this omm.
+    // the subdivision level is maximized within this available size bytes.
+    // the size share needs to be conservative to prevent over allocation and buffer overflow due to numerical rounding.
+    float normalizedWeight = ( sumArea > 0 )
+        ? divRoundTowardZero( area, sumArea )
+        : reciprocalRoundDown( ( float )numOmms );
+    const float maxSize = floorf( fmaRoundTowardZero( normalizedWeight, ( float )( params.maxOmmArraySizeInBytes - numOmms ), 1.f ) );
+    uint32_t maxSizeInBytes = ( maxSize < 4294967296.f ) ? ( uint32_t )maxSize : ~0u;
+    uint32_t maxLogSizeInBytes = 31 - countLeadingZeros( maxSizeInBytes );
+    uint32_t maxSubdivisionLevel = ( maxLogSizeInBytes + logStatesPerByte ) / 2;
+
+    uint32_t subdivisionLevel = maxSubdivisionLevel;
+
+    // clamp the subdivision level based on the target micro-triangle density
+    if( params.microTrianglesPerTexel )
+    {
+        uint32_t targetSubdivisionLevel = getTargetSubdivisionLevel( mulRoundNearest( area, params.microTrianglesPerTexel ) );
+
+        if( subdivisionLevel > targetSubdivisionLevel )
+            subdivisionLevel = targetSubdivisionLevel;
+    }
+
+    if( subdivisionLevel > OPTIX_OPACITY_MICROMAP_MAX_SUBDIVISION_LEVEL )
+        subdivisionLevel = OPTIX_OPACITY_MICROMAP_MAX_SUBDIVISION_LEVEL;
+
+    return subdivisionLevel;
+}
+
+// the omm assignment of a triangle, with predefined I16 indices sign extended to 32 bits.
+inline __host__ __device__ uint32_t loadAssignment( cuOmmBaking::IndexFormat indexFormat, const void* assignments, uint32_t index )
+{
+    if( indexFormat == cuOmmBaking::IndexFormat::I16_UINT )
+    {
+        uint16_t assignment16 = ( ( const uint16_t* )assignments )[index];
+
+        // preserve predefined assignments
+        if( assignment16 >= ( uint16_t )( -4 ) )
+            return (uint32_t)(int32_t)(int16_t)assignment16;
+        return assignment16;
+    }
+
+    return ( ( const uint32_t* )assignments )[index];
+}
+
+inline __host__ __device__ OpacityStateSet evaluateMicroTriangleOpacity( const BakeInput* input, uint32_t subdivisionLevel, TriangleID id, uint32_t microTriangleIndex )
+{
+    float2 uv0, uv1, uv2;
+    optixMicromapIndexToBaseBarycentrics(
+        microTriangleIndex,
+        subdivisionLevel,
+        uv0, uv1, uv2 );
+
+    Triangle triangle = loadTriangle( input[id.inputIndex].desc, id.triangleIndex );
+
+    float2 du = subRoundNearest( triangle.uv1, triangle.uv0 );
+    float2 dv = subRoundNearest( triangle.uv2, triangle.uv0 );
+
+    // convert micro-triangle uvs to texture uvs
+    const float2 base = triangle.uv0;
+    triangle.uv0 = interpolateRoundNearest( base, uv0.x, du, uv0.y, dv );
+    triangle.uv1 = interpolateRoundNearest( base, uv1.x, du, uv1.y, dv );
+    triangle.uv2 = interpolateRoundNearest( base, uv2.x, du, uv2.y, dv );
+
+    return sampleTextureState( input[id.inputIndex].inTextures, triangle, 1 );
+}
+
+// the opacity state of a slot in the omm array data, in the omm format.
+// slots past the end of the data and the unused slots of omms smaller than a byte are opaque (2-state) or unknown-opaque (4-state).
+inline __host__ __device__ uint32_t evaluateOmmOpacityState( const EvaluateOmmOpacityParams& params, uint32_t numOmms, uint64_t numMicroTriangles, uint64_t index )
+{
+    const uint32_t logStatesPerByte = getLogStatesPerByte( params.format );
+
+    OpacityStateSet state = {};
+
+    if( index < numMicroTriangles )
+    {
+        uint32_t byteIndex = ( uint32_t )( index >> logStatesPerByte );
+
+        // Binary search in the prefix summed assignments to map the triangle index to a bake input.
+        uint32_t ommIndex = upper_bound( 0, numOmms, byteIndex, [&]( uint32_t value, uint32_t element ) { return value < params.inDescs[element].byteOffset; } ) - 1;
+
+        assert( ommIndex < numOmms );
+
+        OptixOpacityMicromapDesc desc = params.inDescs[ommIndex];
+
+        uint32_t microTriangleIndex = ( uint32_t )( index - ( ( uint64_t )desc.byteOffset << logStatesPerByte ) );
+
+        TriangleID id = params.inTriangleIdPerOmm[ommIndex];
+
+        assert( !id.uniform );
+
+        uint32_t subdivisionLevel = desc.subdivisionLevel;
+
+        // 2-state subdiv level 0 and 1, and 4-state subdiv level 0 cover less than one byte.
+        if( microTriangleIndex < ( 1u << ( 2 * subdivisionLevel ) ) )
+        {
+            state = evaluateMicroTriangleOpacity( params.inBakeInputs, subdivisionLevel, id, microTriangleIndex );
+        }
+    }
+
+    if( params.format == OPTIX_OPACITY_MICROMAP_FORMAT_2_STATE )
+    {
+        // all but fully transparent micro triangles are marked as opaque
+        if( state.isTransparent() )
+            return OPTIX_OPACITY_MICROMAP_STATE_TRANSPARENT;
+        return OPTIX_OPACITY_MICROMAP_STATE_OPAQUE;
+    }
+
+    // OPTIX_OPACITY_MICROMAP_FORMAT_4_STATE
+    if( state.isTransparent() )
+        return OPTIX_OPACITY_MICROMAP_STATE_TRANSPARENT;
+    if( state.isOpaque() )
+        return OPTIX_OPACITY_MICROMAP_STATE_OPAQUE;
+    return OPTIX_OPACITY_MICROMAP_STATE_UNKNOWN_OPAQUE;
+}
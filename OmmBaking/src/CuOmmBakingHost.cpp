@@ -0,0 +1,347 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "BakePipeline.h"
+#include "Texture.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+uint32_t getNumWorkerThreads()
+{
+    return std::max( 1u, std::thread::hardware_concurrency() );
+}
+
+// Calls func( begin, end ) for consecutive ranges of at most grainSize items covering [0,count), distributed over all hardware threads.
+template <typename Func>
+void parallelFor( uint64_t count, uint64_t grainSize, Func func )
+{
+    const uint64_t numChunks  = ( count + grainSize - 1 ) / grainSize;
+    const uint32_t numThreads = ( uint32_t )std::min<uint64_t>( numChunks, getNumWorkerThreads() );
+
+    if( numThreads <= 1 )
+    {
+        if( count )
+            func( uint64_t( 0 ), count );
+        return;
+    }
+
+    std::atomic<uint64_t> nextChunk( 0 );
+    auto worker = [&]() {
+        for( uint64_t chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++ )
+            func( chunk * grainSize, std::min( count, ( chunk + 1 ) * grainSize ) );
+    };
+
+    std::vector<std::thread> threads;
+    for( uint32_t i = 1; i < numThreads; ++i )
+        threads.emplace_back( worker );
+    worker();
+    for( std::thread& thread : threads )
+        thread.join();
+}
+
+// Grain size splitting numItems into a few chunks per thread, but no chunks smaller than minGrainSize.
+uint64_t getGrainSize( uint64_t numItems, uint64_t minGrainSize )
+{
+    const uint64_t numChunks = 4ull * getNumWorkerThreads();
+    return std::max( minGrainSize, ( numItems + numChunks - 1 ) / numChunks );
+}
+
+// Parallel prefix sum. load( i ) returns item i, store( i, sum ) receives the sum over items [0,i] when inclusive, or [0,i) otherwise.
+// Integer sums are exact, so the result doesn't depend on the chunking.
+template <typename T, typename Load, typename Store>
+void parallelScan( uint32_t numItems, bool inclusive, Load load, Store store )
+{
+    const uint64_t grainSize = getGrainSize( numItems, 1 << 14 );
+    const uint64_t numChunks = ( numItems + grainSize - 1 ) / grainSize;
+
+    std::vector<T> chunkSums( numChunks, T( 0 ) );
+    parallelFor( numChunks, 1, [&]( uint64_t begin, uint64_t end ) {
+        for( uint64_t chunk = begin; chunk < end; ++chunk )
+        {
+            T sum = T( 0 );
+            for( uint64_t i = chunk * grainSize; i < std::min<uint64_t>( numItems, ( chunk + 1 ) * grainSize ); ++i )
+                sum += load( ( uint32_t )i );
+            chunkSums[chunk] = sum;
+        }
+    } );
+
+    T offset = T( 0 );
+    for( T& sum : chunkSums )
+    {
+        const T chunkSum = sum;
+        sum = offset;
+        offset += chunkSum;
+    }
+
+    parallelFor( numChunks, 1, [&]( uint64_t begin, uint64_t end ) {
+        for( uint64_t chunk = begin; chunk < end; ++chunk )
+        {
+            T sum = chunkSums[chunk];
+            for( uint64_t i = chunk * grainSize; i < std::min<uint64_t>( numItems, ( chunk + 1 ) * grainSize ); ++i )
+            {
+                const T item = load( ( uint32_t )i );
+                if( inclusive )
+                    sum += item;
+                store( ( uint32_t )i, sum );
+                if( !inclusive )
+                    sum += item;
+            }
+        }
+    } );
+}
+
+}  // namespace
+
+void hostSetupBakeInput( SetupBakeInputParams params )
+{
+    parallelFor( params.numTriangles, 256, [&]( uint64_t begin, uint64_t end ) {
+        for( uint64_t index = begin; index < end; ++index )
+            setupBakeInputTriangle( params, ( uint32_t )index );
+    } );
+}
+
+void hostSortPairs( const uint32_t* keysIn, uint32_t* keysOut, const TriangleID* valuesIn, TriangleID* valuesOut, uint32_t numItems )
+{
+    struct Pair
+    {
+        uint32_t   key;
+        TriangleID value;
+    };
+
+    auto less = []( const Pair& a, const Pair& b ) { return a.key < b.key; };
+
+    // stable sort runs in parallel, followed by rounds of pairwise stable merges.
+    // the order of equal keys is preserved, matching the stable radix sort of the cuda backend.
+    const uint64_t runLength = getGrainSize( numItems, 1 << 14 );
+
+    std::vector<Pair> pairs( numItems );
+    std::vector<Pair> merged( numItems );
+    parallelFor( numItems, runLength, [&]( uint64_t begin, uint64_t end ) {
+        for( uint64_t i = begin; i < end; ++i )
+            pairs[i] = Pair{ keysIn[i], valuesIn[i] };
+        std::stable_sort( pairs.begin() + begin, pairs.begin() + end, less );
+    } );
+
+    for( uint64_t width = runLength; width < numItems; width *= 2 )
+    {
+        parallelFor( numItems, 2 * width, [&]( uint64_t begin, uint64_t end ) {
+            const uint64_t middle = std::min( begin + width, end );
+            std::merge( pairs.begin() + begin, pairs.begin() + middle, pairs.begin() + middle, pairs.begin() + end, merged.begin() + begin, less );
+        } );
+        std::swap( pairs, merged );
+    }
+
+    parallelFor( numItems, runLength, [&]( uint64_t begin, uint64_t end ) {
+        for( uint64_t i = begin; i < end; ++i )
+        {
+            keysOut[i]   = pairs[i].key;
+            valuesOut[i] = pairs[i].value;
+        }
+    } );
+}
+
+void hostMarkFirstOmmOccurance( MarkFirstOmmOccuranceParams params )
+{
+    parallelFor( params.numTriangles, 1024, [&]( uint64_t begin, uint64_t end ) {
+        for( uint64_t index = begin; index < end; ++index )
+            markFirstOmmOccuranceTriangle( params, ( uint32_t )index );
+    } );
+}
+
+void hostInclusiveSum( const uint32_t* in, uint32_t* out, uint32_t numItems )
+{
+    parallelScan<uint32_t>(
+        numItems, true, [&]( uint32_t i ) { return in[i]; }, [&]( uint32_t i, uint32_t sum ) { out[i] = sum; } );
+}
+
+void hostGenerateAssignment( GenerateAssignmentParams params )
+{
+    // one extra item writes the number of omms
+    parallelFor( ( uint64_t )params.numTriangles + 1, 1024, [&]( uint64_t begin, uint64_t end ) {
+        for( uint64_t index = begin; index < end; ++index )
+            generateAssignmentTriangle( params, ( uint32_t )index );
+    } );
+}
+
+void hostSumOmmArea( const uint32_t* inOmmArea, uint64_t* outSumArea, uint32_t numItems )
+{
+    std::mutex mutex;
+    uint64_t   sum = 0;
+    parallelFor( numItems, getGrainSize( numItems, 1 << 14 ), [&]( uint64_t begin, uint64_t end ) {
+        uint64_t partialSum = 0;
+        for( uint64_t i = begin; i < end; ++i )
+            partialSum += inOmmArea[i];
+        std::lock_guard<std::mutex> lock( mutex );
+        sum += partialSum;
+    } );
+    *outSumArea = sum;
+}
+
+void hostGenerateLayout( GenerateLayoutParams params )
+{
+    const uint32_t numOmms          = *params.inNumOmms;
+    const float    sumArea          = loadSumArea( params );
+    const uint32_t logStatesPerByte = getLogStatesPerByte( params.format );
+
+    std::mutex mutex;
+    parallelFor( numOmms, 1024, [&]( uint64_t begin, uint64_t end ) {
+        // sizes and histograms are accumulated locally, like the per block accumulation of the cuda kernel.
+        uint32_t histogram[OPTIX_OPACITY_MICROMAP_MAX_SUBDIVISION_LEVEL + 1] = {};
+        uint32_t sizeInBytes = 0;
+
+        for( uint64_t index = begin; index < end; ++index )
+        {
+            const uint32_t subdivisionLevel = getOmmSubdivisionLevel( params, numOmms, sumArea, ( uint32_t )index );
+
+            sizeInBytes += getOmmSizeInBytes( subdivisionLevel, logStatesPerByte );
+
+            OptixOpacityMicromapDesc desc = {};
+            desc.byteOffset = 0;
+            desc.subdivisionLevel = subdivisionLevel;
+            desc.format = params.format;
+
+            params.ioDescs[index] = desc;
+
+            histogram[subdivisionLevel]++;
+        }
+
+        std::lock_guard<std::mutex> lock( mutex );
+        for( uint32_t level = 0; level <= OPTIX_OPACITY_MICROMAP_MAX_SUBDIVISION_LEVEL; ++level )
+            params.ioHistogram[level].count += histogram[level];
+        *params.ioSizeInBytes += sizeInBytes;
+    } );
+}
+
+void hostGenerateStartOffsets( OptixOpacityMicromapDesc* descs, uint32_t numItems, OptixOpacityMicromapFormat format )
+{
+    const uint32_t logStatesPerByte = getLogStatesPerByte( format );
+
+    // the size is read from the subdivision level and the offset written to the byte offset, so the scan can be in place.
+    parallelScan<uint32_t>(
+        numItems, false,
+        [&]( uint32_t i ) {
+            const uint32_t sizeInBytes = getOmmSizeInBytes( descs[i].subdivisionLevel, logStatesPerByte );
+            return sizeInBytes ? sizeInBytes : 1;
+        },
+        [&]( uint32_t i, uint32_t sum ) { descs[i].byteOffset = sum; } );
+}
+
+void hostGenerateInputHistogram( GenerateInputHistogramParams params )
+{
+    std::mutex mutex;
+    parallelFor( params.numTriangles, getGrainSize( params.numTriangles, 1 << 14 ), [&]( uint64_t begin, uint64_t end ) {
+        uint32_t histogram[OPTIX_OPACITY_MICROMAP_MAX_SUBDIVISION_LEVEL + 1] = {};
+
+        for( uint64_t index = begin; index < end; ++index )
+        {
+            uint32_t assignment = loadAssignment( params.indexFormat, params.inAssignment, ( uint32_t )index );
+
+            // skip predefined assignments
+            if( assignment < ( uint32_t )( -4 ) )
+                histogram[params.inDescs[assignment].subdivisionLevel]++;
+        }
+
+        std::lock_guard<std::mutex> lock( mutex );
+        for( uint32_t level = 0; level <= OPTIX_OPACITY_MICROMAP_MAX_SUBDIVISION_LEVEL; ++level )
+            params.ioHistogram[level].count += histogram[level];
+    } );
+}
+
+void hostEvaluateOmmOpacity( EvaluateOmmOpacityParams params )
+{
+    const uint32_t sizeInBytes = *params.inSizeInBytes;
+    const uint32_t numOmms     = *params.inNumOmms;
+
+    assert( sizeInBytes <= params.dataSizeInBytes );
+
+    const uint32_t logStatesPerByte = getLogStatesPerByte( params.format );
+
+    const uint64_t numMicroTriangles = ( uint64_t )sizeInBytes << logStatesPerByte;
+
+    // the cuda kernel writes whole words of 32 micro triangles, one per warp lane, padding the last word with the default state.
+    const uint64_t numWords = ( numMicroTriangles + 31 ) / 32;
+
+    parallelFor( numWords, 16, [&]( uint64_t begin, uint64_t end ) {
+        for( uint64_t word = begin; word < end; ++word )
+        {
+            if( params.format == OPTIX_OPACITY_MICROMAP_FORMAT_2_STATE )
+            {
+                uint32_t mask = 0;
+                for( uint32_t lane = 0; lane < 32; ++lane )
+                    mask |= evaluateOmmOpacityState( params, numOmms, numMicroTriangles, word * 32 + lane ) << lane;
+                ( ( uint32_t* )params.ioData )[word] |= mask;
+            }
+            else // OPTIX_OPACITY_MICROMAP_FORMAT_4_STATE
+            {
+                uint64_t mask = 0;
+                for( uint32_t lane = 0; lane < 32; ++lane )
+                    mask |= ( uint64_t )evaluateOmmOpacityState( params, numOmms, numMicroTriangles, word * 32 + lane ) << ( 2 * lane );
+                ( ( uint64_t* )params.ioData )[word] |= mask;
+            }
+        }
+    } );
+}
+
+cudaError_t hostSummedAreaTable( StateTextureConfig config, const uint8_t* input, uint2* outputSat )
+{
+    // same limits as the cuda implementation, keeping the results identical
+    if( 2 * config.width > std::numeric_limits<unsigned short>::max() )
+        return cudaErrorInvalidValue;
+    if( 2 * config.height * config.width > std::numeric_limits<unsigned int>::max() )
+        return cudaErrorInvalidValue;
+
+    const uint32_t width  = config.width;
+    const uint32_t height = config.height;
+
+    // the table is column major. sum each column first, so both passes access memory contiguously.
+    parallelFor( width, 16, [&]( uint64_t begin, uint64_t end ) {
+        for( uint64_t x = begin; x < end; ++x )
+        {
+            uint2  sum    = { 0, 0 };
+            uint2* column = outputSat + x * height;
+            for( uint32_t y = 0; y < height; ++y )
+            {
+                const uint64_t bidx  = x * 2 + ( uint64_t )y * config.pitchInBits;
+                const uint32_t shift = bidx & 7;
+
+                const cuOmmBaking::OpacityState state = ( cuOmmBaking::OpacityState )( ( input[bidx >> 3] >> shift ) & 0x3 );
+
+                if( state == cuOmmBaking::OpacityState::STATE_TRANSPARENT )
+                    sum.x += 2;
+                else if( state == cuOmmBaking::OpacityState::STATE_OPAQUE )
+                    sum.y += 2;
+                else if( state == cuOmmBaking::OpacityState::STATE_RESERVED )
+                {
+                    sum.x += 1;
+                    sum.y += 1;
+                }
+
+                column[y] = sum;
+            }
+        }
+    } );
+
+    // accumulate the columns, splitting the rows over the threads.
+    parallelFor( height, 1024, [&]( uint64_t begin, uint64_t end ) {
+        for( uint64_t x = 1; x < width; ++x )
+        {
+            const uint2* prev   = outputSat + ( x - 1 ) * height;
+            uint2*       column = outputSat + x * height;
+            for( uint64_t y = begin; y < end; ++y )
+            {
+                column[y].x += prev[y].x;
+                column[y].y += prev[y].y;
+            }
+        }
+    } );
+
+    return cudaSuccess;
+}
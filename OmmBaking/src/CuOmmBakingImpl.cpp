@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdarg>
+#include <cstring>
 #include <map>
 #include <memory>
 #include <string>
@@ -81,19 +82,6 @@ namespace cuOmmBaking {
 // The intermediate horizontally summed values are 16 bit
 #define SAT_TEMP_BUFFER_ALIGNMENT_IN_BYTES sizeof(ushort2)
 
-template <typename T>
-void CudaMemcpyAsync( BufferLayout<T>& out, const std::vector<T>& in, cudaStream_t stream )
-{
-    OMM_CUDA_CHECK( cudaMemcpyAsync( out.access(), in.data(), out.getNumBytes(), cudaMemcpyHostToDevice, stream ) );
-}
-
-
-template <typename T>
-void CudaMemsetAsync( BufferLayout<T>& out, cudaStream_t stream )
-{
-    OMM_CUDA_CHECK( cudaMemsetAsync( out.access(), 0, out.getNumBytes(), stream ) );
-}
-
 uint32_t getNumTriangles( const BakeInputDesc& input )
 {
     return ( input.indexFormat != IndexFormat::NONE ? input.numIndexTriplets : ( input.numTexCoords / 3 ) );
@@ -177,6 +165,9 @@ public:
 
         virtual cudaError_t build( void* temp, size_t& tempStorageInBytes, cudaStream_t stream ) = 0;
 
+        // build the summed area table on the host, for BakeBackend::HOST.
+        virtual cudaError_t buildOnHost() = 0;
+
         virtual TextureData get( const cuOmmBaking::TextureDesc& /*desc*/ )
         {
             TextureData textureInput = {};
@@ -216,6 +207,11 @@ public:
             return ::launchSummedAreaTable( temp, tempStorageInBytes, m_config, m_input, m_satBuf.isMaterialized() ? m_satBuf.access() : 0, stream );
         }
 
+        cudaError_t buildOnHost()
+        {
+            return ::hostSummedAreaTable( m_config, m_input, m_satBuf.access() );
+        }
+
         virtual TextureData get( const cuOmmBaking::TextureDesc& desc )
         {
             TextureData input = TextureBase::get( desc );
@@ -254,6 +250,12 @@ public:
             return ::launchSummedAreaTable( temp, tempStorageInBytes, m_config, m_texture, m_satBuf.isMaterialized() ? m_satBuf.access() : 0, stream );
         }
 
+        cudaError_t buildOnHost()
+        {
+            // rejected during validation
+            return cudaErrorNotSupported;
+        }
+
         virtual TextureData get( const cuOmmBaking::TextureDesc& desc )
         {
             TextureData input = TextureBase::get( desc );
@@ -292,10 +294,11 @@ public:
 
         validate( *options );
 
+        Baker::m_options = *options;
+
         for( unsigned int i = 0; i < numInputs; ++i )
             validate( inputs[i], i, isPreBake );
 
-        Baker::m_options = *options;
         Baker::m_inputs = std::vector<BakeInputDesc>( inputs, inputs + numInputs );
 
         uint64_t numTexels = 0;
@@ -554,19 +557,23 @@ public:
                         break;
                     };
 
-                    size_t tempStorageInBytes = 0;
-                    cudaError_t error = texture->build( 0, tempStorageInBytes, 0 );
-
-                    if( error == cudaErrorInvalidChannelDescriptor )
+                    // the host backend builds the summed area tables in place, without temporary storage.
+                    if( !isHostBackend() )
                     {
-                        throw Exception( Result::ERROR_INVALID_VALUE, stringf( "Unsupported format for inputs[%zu].textures[%zu].cuda.texObject.", inputIdx, i ) );
-                    }
-                    else
-                    {
-                        OMM_CUDA_CHECK( error );
-                    }
+                        size_t tempStorageInBytes = 0;
+                        cudaError_t error = texture->build( 0, tempStorageInBytes, 0 );
+
+                        if( error == cudaErrorInvalidChannelDescriptor )
+                        {
+                            throw Exception( Result::ERROR_INVALID_VALUE, stringf( "Unsupported format for inputs[%zu].textures[%zu].cuda.texObject.", inputIdx, i ) );
+                        }
+                        else
+                        {
+                            OMM_CUDA_CHECK( error );
+                        }
 
-                    satTempStorageInBytes = std::max( satTempStorageInBytes, tempStorageInBytes );
+                        satTempStorageInBytes = std::max( satTempStorageInBytes, tempStorageInBytes );
+                    }
 
                     texture->aggregateInto( m_satAggregateBuf );
 
@@ -644,36 +651,40 @@ public:
                 
         m_dataBuf.setNumElems( ( Baker::m_options.maximumSizeInBytes + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t ) );
 
+        // the host backend needs no temporary storage for sorting, scanning and reduction.
+        if( !isHostBackend() )
         {
-            size_t tempSizeInBytes = 0;
-            cudaError_t error = SortPairs<uint32_t, TriangleID>()( 0, tempSizeInBytes, 0, 0, 0, 0, m_numTriangles, 0, sizeof( uint32_t ) * 8, 0 );
-            OMM_CUDA_CHECK( error );
+            {
+                size_t tempSizeInBytes = 0;
+                cudaError_t error = SortPairs<uint32_t, TriangleID>()( 0, tempSizeInBytes, 0, 0, 0, 0, m_numTriangles, 0, sizeof( uint32_t ) * 8, 0 );
+                OMM_CUDA_CHECK( error );
 
-            m_sortTempBuf.setNumBytes( tempSizeInBytes ).setAlignmentInBytes( CUB_TEMP_BUFFER_ALIGNMENT_IN_BYTES );
-        }
+                m_sortTempBuf.setNumBytes( tempSizeInBytes ).setAlignmentInBytes( CUB_TEMP_BUFFER_ALIGNMENT_IN_BYTES );
+            }
 
-        {
-            size_t tempSizeInBytes = 0;
-            cudaError_t error = InclusiveSum<uint32_t*, uint32_t*>()( 0, tempSizeInBytes, 0, 0, m_numTriangles );
-            OMM_CUDA_CHECK( error );
+            {
+                size_t tempSizeInBytes = 0;
+                cudaError_t error = InclusiveSum<uint32_t*, uint32_t*>()( 0, tempSizeInBytes, 0, 0, m_numTriangles );
+                OMM_CUDA_CHECK( error );
 
-            m_sumTempBuf.setNumBytes( tempSizeInBytes ).setAlignmentInBytes( CUB_TEMP_BUFFER_ALIGNMENT_IN_BYTES );
-        }
+                m_sumTempBuf.setNumBytes( tempSizeInBytes ).setAlignmentInBytes( CUB_TEMP_BUFFER_ALIGNMENT_IN_BYTES );
+            }
 
-        {
-            size_t tempSizeInBytes = 0;
-            cudaError_t error = ReduceRoundUp<float*, float*, float>()( 0, tempSizeInBytes, 0, 0, m_numTriangles );
-            OMM_CUDA_CHECK( error );
+            {
+                size_t tempSizeInBytes = 0;
+                cudaError_t error = launchSumOmmArea( 0, tempSizeInBytes, 0, 0, m_maxNumOmms, 0 );
+                OMM_CUDA_CHECK( error );
 
-            m_reduceTempBuf.setNumBytes( tempSizeInBytes ).setAlignmentInBytes( CUB_TEMP_BUFFER_ALIGNMENT_IN_BYTES );
-        }
+                m_reduceTempBuf.setNumBytes( tempSizeInBytes ).setAlignmentInBytes( CUB_TEMP_BUFFER_ALIGNMENT_IN_BYTES );
+            }
 
-        {
-            size_t tempSizeInBytes = 0;
-            cudaError_t error = launchGenerateStartOffsets( 0, tempSizeInBytes, 0, 0, m_maxNumOmms, m_options.format, 0 );
-            OMM_CUDA_CHECK( error );
+            {
+                size_t tempSizeInBytes = 0;
+                cudaError_t error = launchGenerateStartOffsets( 0, tempSizeInBytes, 0, 0, m_maxNumOmms, m_options.format, 0 );
+                OMM_CUDA_CHECK( error );
 
-            m_offsetTempBuf.setNumBytes( tempSizeInBytes ).setAlignmentInBytes( CUB_TEMP_BUFFER_ALIGNMENT_IN_BYTES );
+                m_offsetTempBuf.setNumBytes( tempSizeInBytes ).setAlignmentInBytes( CUB_TEMP_BUFFER_ALIGNMENT_IN_BYTES );
+            }
         }
 
         /* Visualization of buffer usage in the different phases of baking.
@@ -690,7 +701,7 @@ public:
         * m_inMarkersBuf     32b             nTri                .   .   .   .   xxxxx   .   .   .   .   .   .
         * m_outAssignmentBuf 32b             nTri                .   .   .   .   .   xxxxx   .   .   .   .   .
         * m_ommIdBuf         64b             min( nByte, nTri )  .   .   .   .   .   .   xxxxxxxxxxxxxxxxxxxxx
-        * m_sumAreaBuf       32b             1                   .   .   .   .   .   .   .   xxxxx   .   .   .
+        * m_sumAreaBuf       64b             1                   .   .   .   .   .   .   .   xxxxx   .   .   .
         * m_ommAreaBuf       32b             min( nByte, nTri )  .   .   .   .   .   .   xxxxxxxxx   .   .   .
         * m_inputBuf                                             .   xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
         * m_textureBuf                                           .   xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx
@@ -893,19 +904,30 @@ public:
     {
         uint32_t maxOmmArraySizeInBytes = m_dataBuf.getNumBytes();
 
-        int device;
-        OMM_CUDA_CHECK( cudaGetDevice( &device ) );
+        uint32_t numThreads = 0;
+        if( !isHostBackend() )
+        {
+            int device;
+            OMM_CUDA_CHECK( cudaGetDevice( &device ) );
 
-        cudaDeviceProp props;
-        OMM_CUDA_CHECK( cudaGetDeviceProperties( &props, device ) );
+            cudaDeviceProp props;
+            OMM_CUDA_CHECK( cudaGetDeviceProperties( &props, device ) );
 
-        uint32_t numThreads = props.multiProcessorCount * 512u;
+            numThreads = props.multiProcessorCount * 512u;
+        }
 
         // 1. Build texture summed area tables.
 
         // build opacity summed area tables per texture
         for( auto itr : m_textureMap )
         {
+            if( isHostBackend() )
+            {
+                // not OMM_CUDA_CHECK, which synchronizes with the device in debug builds.
+                checkCudaError( itr.second->buildOnHost(), "buildOnHost()", __FILE__, __LINE__ );
+                continue;
+            }
+
             size_t tempStorageInBytes = m_satTempBuf.getNumBytes();
 
             cudaError_t error = itr.second->build( m_satTempBuf.access(), tempStorageInBytes, stream );
@@ -977,8 +999,8 @@ public:
             textureInputOffset += m_inputs[i].numTextures;
         }
 
-        CudaMemcpyAsync( m_textureBuf, textureInputs, stream );
-        CudaMemcpyAsync( m_inputBuf, bakeInputs, stream );
+        copyToBuffer( m_textureBuf, textureInputs, stream );
+        copyToBuffer( m_inputBuf, bakeInputs, stream );
 
         // 3. Setup triangles, detect uniforms and generate hashes for duplicate detection.
 
@@ -995,13 +1017,21 @@ public:
             params.input          = m_inputs[i];
             params.format         = m_options.format;
 
-            OMM_CUDA_CHECK( launchSetupBakeInput( params, stream ) );
+            if( isHostBackend() )
+                hostSetupBakeInput( params );
+            else
+                OMM_CUDA_CHECK( launchSetupBakeInput( params, stream ) );
 
             triangleOffset += params.numTriangles;
         }
 
         // 4. Sort triangles by their hash keys
 
+        if( isHostBackend() )
+        {
+            hostSortPairs( m_inHashBuf.access(), m_outHashBuf.access(), m_inIdBuf.access(), m_outIdBuf.access(), m_numTriangles );
+        }
+        else
         {
             // sort triangles by hash key
             size_t tempSizeInBytes = m_sortTempBuf.getNumBytes();
@@ -1020,11 +1050,19 @@ public:
             params.outMarkers = m_inMarkersBuf.access();
             params.inBakeInputs = m_inputBuf.access();
 
-            OMM_CUDA_CHECK( launchMarkFirstOmmOccurance( params, stream ) );
+            if( isHostBackend() )
+                hostMarkFirstOmmOccurance( params );
+            else
+                OMM_CUDA_CHECK( launchMarkFirstOmmOccurance( params, stream ) );
         }
 
         // 6. Generate flat omm assignment
 
+        if( isHostBackend() )
+        {
+            hostInclusiveSum( m_inMarkersBuf.access(), m_outAssignmentBuf.access(), m_numTriangles );
+        }
+        else
         {
             size_t tempSizeInBytes = m_sumTempBuf.getNumBytes();
             cudaError_t error = InclusiveSum<uint32_t*, uint32_t*>()(
@@ -1034,7 +1072,7 @@ public:
 
         // 7. Scatter the assignments into the per-input assigment buffers. Output omm area.
 
-        CudaMemsetAsync( m_ommAreaBuf, stream );
+        clearBuffer( m_ommAreaBuf, stream );
 
         {
             GenerateAssignmentParams params;
@@ -1048,27 +1086,35 @@ public:
             params.inBakeInputs = m_inputBuf.access();
             params.indexFormat = m_indexFormat;
 
-            OMM_CUDA_CHECK( launchGenerateAssignment( params, stream ) );
+            if( isHostBackend() )
+                hostGenerateAssignment( params );
+            else
+                OMM_CUDA_CHECK( launchGenerateAssignment( params, stream ) );
         }
 
-        // 8. Sum the omm area. Use roundup mode to compute a conservative upper bound on the sum.
-        // Rounding up is necceseary to prevent overflows in the assignment.
+        // 8. Sum the omm area. The areas are summed in fixed point, so the sum is exact and independent of the summation order.
+        // The sum is rounded up when converted to float, to prevent overflows in the assignment.
 
+        if( isHostBackend() )
+        {
+            hostSumOmmArea( m_ommAreaBuf.access(), m_sumAreaBuf.access(), m_maxNumOmms );
+        }
+        else
         {
             size_t tempSizeInBytes = m_reduceTempBuf.getNumBytes();
-            cudaError_t error = ReduceRoundUp<float*, float*, float>()( m_reduceTempBuf.access(), tempSizeInBytes, m_ommAreaBuf.access(), m_sumAreaBuf.access(), m_numTriangles, stream );
+            cudaError_t error = launchSumOmmArea( m_reduceTempBuf.access(), tempSizeInBytes, m_ommAreaBuf.access(), m_sumAreaBuf.access(), m_maxNumOmms, stream );
             OMM_CUDA_CHECK( error );
         }
 
         // 9. Generate omm descriptors, assign subdivision levels, compute total omm array size and subdivision level histogram.
         
-        CudaMemsetAsync( m_sizeInBytesBuf, stream );
+        clearBuffer( m_sizeInBytesBuf, stream );
 
         // initialize the histogram
         std::vector<OptixOpacityMicromapHistogramEntry> histogram( m_histogramBuf.getNumElems(), OptixOpacityMicromapHistogramEntry { 0, 0, m_options.format } );
         for( size_t i = 0; i < histogram.size(); ++i )
             histogram[i].subdivisionLevel = i;
-        CudaMemcpyAsync( m_histogramBuf, histogram, stream );
+        copyToBuffer( m_histogramBuf, histogram, stream );
 
         // assign subdivision levels to omms
         {
@@ -1083,11 +1129,19 @@ public:
             params.microTrianglesPerTexel = ( m_options.subdivisionScale != 0.f ) ? ( 1.f / ( m_options.subdivisionScale * m_options.subdivisionScale ) ) : 0.f;
             params.format = m_options.format;
 
-            OMM_CUDA_CHECK( launchGenerateLayout( params, m_numTriangles, stream ) );
+            if( isHostBackend() )
+                hostGenerateLayout( params );
+            else
+                OMM_CUDA_CHECK( launchGenerateLayout( params, m_numTriangles, stream ) );
         }
 
         // 10. Generate omm desc byte offsets by summing over the omm sizes in bytes.
 
+        if( isHostBackend() )
+        {
+            hostGenerateStartOffsets( m_descBuf.access(), m_descBuf.getNumElems(), m_options.format );
+        }
+        else
         {
             size_t temp_storage_bytes = m_offsetTempBuf.getNumBytes();
             OMM_CUDA_CHECK( launchGenerateStartOffsets( m_offsetTempBuf.access(), temp_storage_bytes, m_descBuf.access(), m_descBuf.access(), m_descBuf.getNumElems(), m_options.format, stream ) );
@@ -1101,7 +1155,7 @@ public:
 
         for( uint32_t i = 0; i < m_inputs.size(); ++i )
         {
-            CudaMemcpyAsync( m_outOmmUsageDescs[i], usage, stream );
+            copyToBuffer( m_outOmmUsageDescs[i], usage, stream );
 
             GenerateInputHistogramParams params;
             params.indexFormat  = m_indexFormat;
@@ -1109,12 +1163,15 @@ public:
             params.inAssignment = bakeInputs[i].outAssignments;
             params.inDescs      = m_descBuf.access();
             params.ioHistogram  = m_outOmmUsageDescs[i].access();
-            OMM_CUDA_CHECK( launchGenerateInputHistogram( params, stream ) );
+            if( isHostBackend() )
+                hostGenerateInputHistogram( params );
+            else
+                OMM_CUDA_CHECK( launchGenerateInputHistogram( params, stream ) );
         }
 
         // 12. Evaluate the opacity states of all micro triangles in the opacity micromap array
 
-        CudaMemsetAsync( m_dataBuf, stream );
+        clearBuffer( m_dataBuf, stream );
 
         // evaluate the opacity of all microtriangles in the array
         {
@@ -1131,12 +1188,35 @@ public:
             const uint32_t maxThreads = m_dataBuf.getNumBytes() * ( ( m_options.format == OPTIX_OPACITY_MICROMAP_FORMAT_2_STATE ) ? 8 : 4 );
 
             // use the maximum data size as a limit for the number of threads launched
-            OMM_CUDA_CHECK( launchEvaluateOmmOpacity( params, std::min<uint32_t>( numThreads, maxThreads ), stream ) );
+            if( isHostBackend() )
+                hostEvaluateOmmOpacity( params );
+            else
+                OMM_CUDA_CHECK( launchEvaluateOmmOpacity( params, std::min<uint32_t>( numThreads, maxThreads ), stream ) );
         }
     }
 
 private:
 
+    bool isHostBackend() const { return m_options.backend == BakeBackend::HOST; }
+
+    template <typename T>
+    void copyToBuffer( BufferLayout<T>& out, const std::vector<T>& in, cudaStream_t stream )
+    {
+        if( isHostBackend() )
+            memcpy( out.access(), in.data(), out.getNumBytes() );
+        else
+            OMM_CUDA_CHECK( cudaMemcpyAsync( out.access(), in.data(), out.getNumBytes(), cudaMemcpyHostToDevice, stream ) );
+    }
+
+    template <typename T>
+    void clearBuffer( BufferLayout<T>& out, cudaStream_t stream )
+    {
+        if( isHostBackend() )
+            memset( out.access(), 0, out.getNumBytes() );
+        else
+            OMM_CUDA_CHECK( cudaMemsetAsync( out.access(), 0, out.getNumBytes(), stream ) );
+    }
+
     void validate( const BakeOptions& options )
     {
         if( ( options.flags & ~( BakeFlags::ENABLE_POST_BAKE_INFO ) ) != BakeFlags::NONE )
@@ -1154,6 +1234,9 @@ private:
             throw Exception( Result::ERROR_INVALID_VALUE, stringf( "Invalid value %i for options.format.", options.format ) );
             break;
         }
+
+        if( options.backend >= BakeBackend::MAX_NUM )
+            throw Exception( Result::ERROR_INVALID_VALUE, stringf( "Invalid value %u for options.backend.", ( uint32_t )options.backend ) );
     }
 
     void validate( const TextureDesc& texture, uint32_t inputIdx, uint32_t textureIdx, bool isPreBake )
@@ -1161,6 +1244,9 @@ private:
         switch( texture.type )
         {
         case TextureType::CUDA:
+            if( isHostBackend() )
+                throw Exception( Result::ERROR_INVALID_VALUE, stringf( "Invalid value for inputs[%u].textures[%u].type. CUDA textures are not supported by BakeBackend::HOST.", inputIdx, textureIdx ) );
+
             if( texture.cuda.texObject == 0 )
                 throw Exception( Result::ERROR_INVALID_VALUE, stringf( "Invalid value for inputs[%u].textures[%u].cuda.texObject. Must not be zero.", inputIdx, textureIdx ) );
 
@@ -1410,8 +1496,8 @@ private:
     BufferLayout<uint32_t>     m_inHashBuf, m_outHashBuf;
     BufferLayout<uint32_t>     m_inMarkersBuf, m_outAssignmentBuf;
     BufferLayout<TriangleID>   m_ommIdBuf;
-    BufferLayout<float>        m_sumAreaBuf;
-    BufferLayout<float>        m_ommAreaBuf;
+    BufferLayout<uint64_t>     m_sumAreaBuf;
+    BufferLayout<uint32_t>     m_ommAreaBuf;
     BufferLayout<BakeInput>   m_inputBuf;
     BufferLayout<TextureInput> m_textureBuf;
 
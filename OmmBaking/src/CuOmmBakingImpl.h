@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -130,16 +130,16 @@ struct GenerateAssignmentParams
     // per omm triangle ID of one of the triangles in the dupplicate group
     TriangleID* outOmmTriangleId;
 
-    // area in texels per opacticy micromap.
-    float* outOmmArea;
+    // area per opacticy micromap, in 1/16th texels.
+    uint32_t* outOmmArea;
 };
 
 struct GenerateLayoutParams
 {
-    // per opacticy micromaps area in texels.
-    const float* inOmmArea;
-    // total area summed over all opacticy micromaps.
-    const float* inSumArea;
+    // per opacticy micromaps area in 1/16th texels.
+    const uint32_t* inOmmArea;
+    // total area summed over all opacticy micromaps, in 1/16th texels.
+    const uint64_t* inSumArea;
     // total number of opacticy micromaps.
     const uint32_t* inNumOmms;
     // input buffer of opacticy micromap weights.
@@ -227,23 +227,14 @@ cudaError_t launchGenerateInputHistogram( GenerateInputHistogramParams params, c
 // evaluate the opacity of all micro triangles in all opacity micro maps.
 cudaError_t launchEvaluateOmmOpacity( EvaluateOmmOpacityParams params, unsigned int numThreads, cudaStream_t stream );
 
-// Functor encapsulating cuda cub Reduction.
-// The template implementations are exlicitly instanciated in OmmBakingImpl.cu
-template <
-    typename InputIteratorT,
-    typename OutputIteratorT,
-    typename T>
-struct ReduceRoundUp
-{
-    cudaError_t operator()(
-        void*           d_temp_storage,     ///< [in] Device-accessible allocation of temporary storage.  When NULL, the required allocation size is written to \p temp_storage_bytes and no work is done.
-        size_t&         temp_storage_bytes, ///< [in,out] Reference to size in bytes of \p d_temp_storage allocation
-        InputIteratorT  d_in,               ///< [in] Pointer to the input sequence of data items
-        OutputIteratorT d_out,              ///< [out] Pointer to the output aggregate
-        int             num_items,          ///< [in] Total number of input items (i.e., length of \p d_in)
-        cudaStream_t    stream = 0          ///< [in] <b>[optional]</b> CUDA stream to launch kernels within.  Default is stream<sub>0</sub>.
-      ) const; 
-};
+// sum the fixed point omm areas.
+cudaError_t launchSumOmmArea(
+    void*           temp,
+    size_t&         tempSizeInBytes,
+    const uint32_t* inOmmArea,
+    uint64_t*       outSumArea,
+    unsigned int    numItems,
+    cudaStream_t    stream );
 
 // Functor encapsulating cuda cub InclusiveSum.
 // The template implementations are exlicitly instanciated in OmmBakingImpl.cu
@@ -278,3 +269,36 @@ struct SortPairs
         cudaStream_t  stream = 0                     ///< [in] <b>[optional]</b> CUDA stream to launch kernels within.  Default is stream<sub>0</sub>.
       ) const;
 };
+
+// Host implementations of the baking stages, used by BakeBackend::HOST.
+// They take the same parameters as their launch counterparts, with host pointers, and complete before returning.
+
+void hostSetupBakeInput( SetupBakeInputParams params );
+
+// stable sort of (key,value) pairs by key, producing the same order as SortPairs.
+void hostSortPairs( const uint32_t* keysIn, uint32_t* keysOut, const TriangleID* valuesIn, TriangleID* valuesOut, uint32_t numItems );
+
+void hostMarkFirstOmmOccurance( MarkFirstOmmOccuranceParams params );
+
+void hostInclusiveSum( const uint32_t* in, uint32_t* out, uint32_t numItems );
+
+void hostGenerateAssignment( GenerateAssignmentParams params );
+
+void hostSumOmmArea( const uint32_t* inOmmArea, uint64_t* outSumArea, uint32_t numItems );
+
+void hostGenerateLayout( GenerateLayoutParams params );
+
+void hostGenerateStartOffsets( OptixOpacityMicromapDesc* descs, uint32_t numItems, OptixOpacityMicromapFormat format );
+
+void hostGenerateInputHistogram( GenerateInputHistogramParams params );
+
+void hostEvaluateOmmOpacity( EvaluateOmmOpacityParams params );
+
+namespace cuOmmBaking {
+
+uint32_t getNumTriangles( const BakeInputDesc& input );
+
+// Orders texture descriptors. The baker bakes textures with equivalent descriptors as one texture.
+bool operator<( const TextureDesc& a, const TextureDesc& b );
+
+}  // namespace cuOmmBaking
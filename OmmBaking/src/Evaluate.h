@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -14,22 +14,22 @@ using otk::max;
 // Struct to track opacity states in an area.
 struct OpacityStateSet
 {
-    __device__ OpacityStateSet() {}
+    __host__ __device__ OpacityStateSet() {}
 
-    __device__ OpacityStateSet( uint32_t transparent, uint32_t opaque, uint32_t unknown )
+    __host__ __device__ OpacityStateSet( uint32_t transparent, uint32_t opaque, uint32_t unknown )
     {
         h.x = (transparent != 0);
         h.y = (opaque != 0 );
         h.z = (unknown != 0 );
     }
 
-    __device__ OpacityStateSet& operator+=( OpacityStateSet state )
+    __host__ __device__ OpacityStateSet& operator+=( OpacityStateSet state )
     {
         *this = *this + state;
         return *this;
     }
 
-    __device__ OpacityStateSet operator+( OpacityStateSet state ) const
+    __host__ __device__ OpacityStateSet operator+( OpacityStateSet state ) const
     {
         // we don't actually care about the count, just if it's zero or not.
         // by using logic or we don't have to deal with overflows.
@@ -37,7 +37,7 @@ struct OpacityStateSet
     }
 
     // return true if the set is a mixture of multiple states
-    __device__ bool isMixed() const
+    __host__ __device__ bool isMixed() const
     {
         if( ( ( h.x != 0 ) + ( h.y != 0 ) + ( h.z != 0 ) ) > 1 )
             return true;
@@ -45,7 +45,7 @@ struct OpacityStateSet
     }
 
     // return true if the set has only transparent states
-    __device__ bool isTransparent() const
+    __host__ __device__ bool isTransparent() const
     {
         if( ( h.x != 0 ) && ( h.y == 0 ) && ( h.z == 0 ) )
             return true;
@@ -53,7 +53,7 @@ struct OpacityStateSet
     }
 
     // return true if the set has only opaque states
-    __device__ bool isOpaque() const
+    __host__ __device__ bool isOpaque() const
     {
         if( ( h.x == 0 ) && ( h.y != 0 ) && ( h.z == 0 ) )
             return true;
@@ -61,7 +61,7 @@ struct OpacityStateSet
     }
 
     // return true if the set has transparent states
-    __device__ bool hasTransparent() const
+    __host__ __device__ bool hasTransparent() const
     {
         if( h.x != 0 )
             return true;
@@ -69,7 +69,7 @@ struct OpacityStateSet
     }
 
     // return true if the set is single state
-    __device__ bool isUniform() const
+    __host__ __device__ bool isUniform() const
     {
         if( ( ( h.x != 0 ) + ( h.y != 0 ) + ( h.z != 0 ) ) == 1 )
             return true;
@@ -80,7 +80,7 @@ struct OpacityStateSet
     uint3 h = {};
 };
 
-__device__ OpacityStateSet evalSumTableTile( const TextureData& texture )
+inline __host__ __device__ OpacityStateSet evalSumTableTile( const TextureData& texture )
 {
     const int width = texture.width;
     const int height = texture.height;
@@ -95,7 +95,7 @@ __device__ OpacityStateSet evalSumTableTile( const TextureData& texture )
 
 // evaluate a range within one tile in the sum table
 // pre: the aabb should be within the range [0,width)x[0,height)
-__device__ OpacityStateSet evalSumTableTile( const TextureData& texture, int2 lo, int2 hi, int2 tile )
+inline __host__ __device__ OpacityStateSet evalSumTableTile( const TextureData& texture, int2 lo, int2 hi, int2 tile )
 {
     int width = texture.width;
     int height = texture.height;
@@ -129,7 +129,7 @@ __device__ OpacityStateSet evalSumTableTile( const TextureData& texture, int2 lo
 
 
 // pre: the aabb should not be more 2^15 texels in either dimension to prevent overflows
-__device__ OpacityStateSet evalSumTable( const TextureData& texture, int2 inLo, int2 inHi )
+inline __host__ __device__ OpacityStateSet evalSumTable( const TextureData& texture, int2 inLo, int2 inHi )
 {
     int2 lo = inLo, hi = inHi;
 
@@ -196,7 +196,7 @@ __device__ OpacityStateSet evalSumTable( const TextureData& texture, int2 inLo,
     return states;
 }
 
-__device__ OpacityStateSet sampleMemoryTexture( const TextureData& texture, float2 uv0, float2 uv1, float2 uv2, float filterKernelRadiusInTexels, unsigned int resolution = 1 )
+inline __host__ __device__ OpacityStateSet sampleMemoryTexture( const TextureData& texture, float2 uv0, float2 uv1, float2 uv2, float filterKernelRadiusInTexels, unsigned int resolution = 1 )
 {
     auto eval = [&]( int2 lo, int2 hi ) -> OpacityStateSet { return evalSumTable( texture, lo, hi ); };
 
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -22,6 +22,12 @@ cudaError_t launchSummedAreaTable(
     uint2* outputSat,    
     cudaStream_t stream );
 
+// Host implementation of the state texture summed area table, used by BakeBackend::HOST.
+cudaError_t hostSummedAreaTable(
+    StateTextureConfig config,
+    const uint8_t* input,
+    uint2* outputSat );
+
 struct CudaTextureConfig
 {
     uint32_t width;
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -8,16 +8,18 @@
 #include "Util/XXH.h"
 #include <OptiXToolkit/ShaderUtil/vec_math.h>
 
+#include <cstring>
+
 // vec_math.h provides operator!= for float2
 
 struct Triangle
 {
-    __device__ bool operator!=( Triangle key )
+    __host__ __device__ bool operator!=( Triangle key )
     {
         return uv0 != key.uv0 || uv1 != key.uv1 || uv2 != key.uv2 || texture != key.texture;
     }
 
-    __device__ float Area() const
+    __host__ __device__ float Area() const
     {
         const float2 e0 = uv1 - uv0;
         const float2 e1 = uv2 - uv0;
@@ -29,7 +31,7 @@ struct Triangle
     uint64_t texture;
 };
 
-__device__ uint3 loadIndices( const cuOmmBaking::BakeInputDesc& inputDesc, unsigned int index )
+inline __host__ __device__ uint3 loadIndices( const cuOmmBaking::BakeInputDesc& inputDesc, unsigned int index )
 {
     const void* indexPtr = ( const char* )inputDesc.indexBuffer + index * inputDesc.indexTripletStrideInBytes;
 
@@ -56,13 +58,13 @@ __device__ uint3 loadIndices( const cuOmmBaking::BakeInputDesc& inputDesc, unsig
     return idx3;
 }
 
-__device__ float2 loadTexcoord( const cuOmmBaking::BakeInputDesc& inputDesc, unsigned int index )
+inline __host__ __device__ float2 loadTexcoord( const cuOmmBaking::BakeInputDesc& inputDesc, unsigned int index )
 {
     const float* texcoord = ( const float* )( ( const char* )inputDesc.texCoordBuffer + index * inputDesc.texCoordStrideInBytes );
     return make_float2( texcoord[0], texcoord[1] );
 }
 
-__device__ Triangle loadTriangle( const cuOmmBaking::BakeInputDesc& inputDesc, unsigned int index )
+inline __host__ __device__ Triangle loadTriangle( const cuOmmBaking::BakeInputDesc& inputDesc, unsigned int index )
 {
     Triangle tri;
 
@@ -108,7 +110,7 @@ __device__ Triangle loadTriangle( const cuOmmBaking::BakeInputDesc& inputDesc, u
 }
 
 // convert uv to quantized (integer) representation
-__device__ float2 quantizeUV( float2 uv, const TextureInput& textureInput )
+inline __host__ __device__ float2 quantizeUV( float2 uv, const TextureInput& textureInput )
 {
     float2 f = textureInput.quantizationFrequency;
 
@@ -122,7 +124,7 @@ __device__ float2 quantizeUV( float2 uv, const TextureInput& textureInput )
 }
 
 // snap uv to the nearest quantizable value
-__device__ float2 snapUV( float2 uv, const TextureInput& textureInput )
+inline __host__ __device__ float2 snapUV( float2 uv, const TextureInput& textureInput )
 {
     float2 f = textureInput.quantizationFrequency;
     float2 p = textureInput.quantizationPeriod;
@@ -137,7 +139,7 @@ __device__ float2 snapUV( float2 uv, const TextureInput& textureInput )
 }
 
 // unwrap and quantize triangle coordinates
-__device__ Triangle canonicalizeTriangle( Triangle in, const TextureInput* textureInputs )
+inline __host__ __device__ Triangle canonicalizeTriangle( Triangle in, const TextureInput* textureInputs )
 {
     const TextureInput& textureInput = textureInputs[in.texture];
 
@@ -171,9 +173,21 @@ __device__ Triangle canonicalizeTriangle( Triangle in, const TextureInput* textu
     return out;
 }
 
-__device__ uint32_t hash( Triangle key )
+// reinterpret the bits of a float as an unsigned integer
+inline __host__ __device__ uint32_t floatAsUint( float f )
+{
+#ifdef __CUDA_ARCH__
+    return __float_as_uint( f );
+#else
+    uint32_t u;
+    memcpy( &u, &f, sizeof( u ) );
+    return u;
+#endif
+}
+
+inline __host__ __device__ uint32_t hash( Triangle key )
 {
-    const uint32_t data[8] = { __float_as_uint( key.uv0.x ), __float_as_uint( key.uv0.y ), __float_as_uint( key.uv1.x ), __float_as_uint( key.uv1.y ), __float_as_uint( key.uv2.x ), __float_as_uint( key.uv2.y ), ( uint32_t )( key.texture & 0xFFFFFFFF ), ( uint32_t )( key.texture >> 32 ) };
+    const uint32_t data[8] = { floatAsUint( key.uv0.x ), floatAsUint( key.uv0.y ), floatAsUint( key.uv1.x ), floatAsUint( key.uv1.y ), floatAsUint( key.uv2.x ), floatAsUint( key.uv2.y ), ( uint32_t )( key.texture & 0xFFFFFFFF ), ( uint32_t )( key.texture >> 32 ) };
 
     return XXH( { data[0], data[1], data[2], data[3] }, { data[4], data[5], data[6], data[7] } );
 }
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -11,18 +11,18 @@
 namespace rasterize
 {
     using otk::dot;
-    __device__ float cross( const float2& a, const float2& b )
+    inline __host__ __device__ float cross( const float2& a, const float2& b )
     {
         return a.x * b.y - a.y * b.x;
     }
 
-    __device__ float2 perp( const float2& a )
+    inline __host__ __device__ float2 perp( const float2& a )
     {
         return { a.y, -a.x };
     }
 
     template <typename T>
-    __device__ void swap( T& a, T& b )
+    __host__ __device__ void swap( T& a, T& b )
     {
         T tmp = a;
         a = b;
@@ -30,13 +30,13 @@ namespace rasterize
     }
 
     template <typename T>
-    __device__ T min( const T& a, const T& b )
+    __host__ __device__ T min( const T& a, const T& b )
     {
         return ( a > b ) ? b : a;
     }
 
     template <typename T>
-    __device__ T max( const T& a, const T& b )
+    __host__ __device__ T max( const T& a, const T& b )
     {
         return ( a < b ) ? b : a;
     }
@@ -45,7 +45,7 @@ namespace rasterize
     // the triangle is rasterized in up to N non-overlapping integer AABB in texel space.
     // the function returns the sum of all AABB evaluations.
     template <typename T, typename U>
-    __device__ T rasterize( U            eval,  // evaluation function
+    __host__ __device__ T rasterize( U            eval,  // evaluation function
         float2       v0,
         float2       v1,
         float2       v2,
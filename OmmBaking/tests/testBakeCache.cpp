@@ -0,0 +1,252 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "testHostScene.h"
+
+#include <OptiXToolkit/CuOmmBaking/BakeCache.h>
+#include <OptiXToolkit/CuOmmBaking/CuOmmBaking.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// The cache tests bake on the host, so they run without a CUDA device.
+
+namespace {  // anonymous
+
+// A grid of triangles over one disc texture, with set padding bits between the rows of the texture,
+// so that they differ from textures without padding.
+Scene makeScene( float radiusScale = 1.f, uint32_t paddingInBits = 0 )
+{
+    StateTexture texture = makeDiscTexture( 32, 32, paddingInBits, radiusScale );
+    for( uint32_t y = 0; y < texture.height; ++y )
+    {
+        for( uint32_t bit = 2 * texture.width; bit < texture.pitchInBits; ++bit )
+        {
+            const uint32_t i = bit + y * texture.pitchInBits;
+            texture.states[i / 8] |= 1u << ( i % 8 );
+        }
+    }
+
+    Scene scene;
+    scene.textures = { texture };
+    scene.inputs   = { makeGrid( 6, { 0.f, 0.f }, { 1.f, 1.f } ) };
+    return scene;
+}
+
+// The outputs of a bake through the cache.
+struct CacheBakeResult : BakeResult
+{
+    cuOmmBaking::Result result   = cuOmmBaking::Result::SUCCESS;
+    bool                cacheHit = false;
+};
+
+void expectEqual( const CacheBakeResult& a, const CacheBakeResult& b )
+{
+    ASSERT_EQ( a.postBakeInfo.numMicromapDescs, b.postBakeInfo.numMicromapDescs );
+    EXPECT_EQ( a.postBakeInfo.compactedSizeInBytes, b.postBakeInfo.compactedSizeInBytes );
+    EXPECT_EQ( 0, memcmp( a.histogram.data(), b.histogram.data(), a.histogram.size() * sizeof( OptixOpacityMicromapHistogramEntry ) ) );
+    EXPECT_EQ( 0, memcmp( a.descs.data(), b.descs.data(), a.postBakeInfo.numMicromapDescs * sizeof( OptixOpacityMicromapDesc ) ) );
+    EXPECT_EQ( 0, memcmp( a.data.data(), b.data.data(), a.postBakeInfo.compactedSizeInBytes ) );
+    EXPECT_TRUE( a.indexBuffers == b.indexBuffers );
+    ASSERT_EQ( a.usageCounts.size(), b.usageCounts.size() );
+    for( size_t i = 0; i < a.usageCounts.size(); ++i )
+        EXPECT_EQ( 0, memcmp( a.usageCounts[i].data(), b.usageCounts[i].data(), a.usageCounts[i].size() * sizeof( OptixOpacityMicromapUsageCount ) ) );
+}
+
+class OmmBakingCache : public testing::Test
+{
+  protected:
+    std::string                   m_dir;
+    cuOmmBaking::BakeCacheOptions m_cacheOptions;
+    cuOmmBaking::BakeOptions      m_options;
+
+    void SetUp() override
+    {
+        m_dir = testing::TempDir() + "/OmmBakingCache";
+        fs::remove_all( m_dir );
+        m_cacheOptions.directory = m_dir;
+        m_options.backend        = cuOmmBaking::BakeBackend::HOST;
+        m_options.flags          = cuOmmBaking::BakeFlags::ENABLE_POST_BAKE_INFO;
+    }
+
+    void TearDown() override { fs::remove_all( m_dir ); }
+
+    // Bake the scene, through the cache if one is given.
+    CacheBakeResult bake( cuOmmBaking::BakeCache* cache, const Scene& scene )
+    {
+        CacheBakeResult result;
+        BakeFunction    bakeWithCache;
+        if( cache )
+        {
+            bakeWithCache = [cache, &result]( const cuOmmBaking::BakeOptions* options, unsigned numInputs, const cuOmmBaking::BakeInputDesc* inputs,
+                                              const cuOmmBaking::BakeInputBuffers* inputBuffers, const cuOmmBaking::BakeBuffers* buffers ) {
+                return cache->bakeOpacityMicromaps( options, numInputs, inputs, inputBuffers, buffers, 0, &result.cacheHit );
+            };
+        }
+        result.result = bakeScene( scene, m_options, result, bakeWithCache );
+        return result;
+    }
+
+    std::vector<fs::path> getCacheFiles() const
+    {
+        std::vector<fs::path> files;
+        for( const fs::directory_entry& entry : fs::directory_iterator( m_dir ) )
+            files.push_back( entry.path() );
+        return files;
+    }
+};
+
+}  // namespace
+
+TEST_F( OmmBakingCache, RestoresIdenticalOutputs )
+{
+    const Scene           scene = makeScene();
+    const CacheBakeResult expected = bake( nullptr, scene );
+    ASSERT_EQ( cuOmmBaking::Result::SUCCESS, expected.result );
+    ASSERT_GT( expected.postBakeInfo.numMicromapDescs, 0u );
+
+    cuOmmBaking::BakeCache cache( m_cacheOptions );
+    const CacheBakeResult  miss = bake( &cache, scene );
+    ASSERT_EQ( cuOmmBaking::Result::SUCCESS, miss.result );
+    EXPECT_FALSE( miss.cacheHit );
+    expectEqual( expected, miss );
+    EXPECT_EQ( 1u, getCacheFiles().size() );
+
+    // A new cache object over the same directory, as in a later run.
+    cuOmmBaking::BakeCache cache2( m_cacheOptions );
+    const CacheBakeResult  hit = bake( &cache2, scene );
+    ASSERT_EQ( cuOmmBaking::Result::SUCCESS, hit.result );
+    EXPECT_TRUE( hit.cacheHit );
+    expectEqual( expected, hit );
+
+    EXPECT_EQ( 1u, cache.getStatistics().numMisses );
+    EXPECT_EQ( 1u, cache2.getStatistics().numHits );
+}
+
+TEST_F( OmmBakingCache, ChangedInputsMiss )
+{
+    cuOmmBaking::BakeCache cache( m_cacheOptions );
+    ASSERT_FALSE( bake( &cache, makeScene() ).cacheHit );
+
+    // texture contents
+    EXPECT_FALSE( bake( &cache, makeScene( 0.8f ) ).cacheHit );
+
+    // texture coordinates
+    Scene scene = makeScene();
+    scene.inputs[0].texCoords[3].x += 0.01f;
+    EXPECT_FALSE( bake( &cache, scene ).cacheHit );
+
+    // options
+    m_options.subdivisionScale = 1.f;
+    EXPECT_FALSE( bake( &cache, makeScene() ).cacheHit );
+    m_options.format = OPTIX_OPACITY_MICROMAP_FORMAT_2_STATE;
+    EXPECT_FALSE( bake( &cache, makeScene() ).cacheHit );
+
+    EXPECT_EQ( 5u, cache.getStatistics().numMisses );
+    EXPECT_EQ( 0u, cache.getStatistics().numHits );
+
+    m_options.subdivisionScale = cuOmmBaking::BakeOptions().subdivisionScale;
+    m_options.format           = cuOmmBaking::BakeOptions().format;
+    EXPECT_TRUE( bake( &cache, makeScene() ).cacheHit );
+}
+
+TEST_F( OmmBakingCache, IgnoresRowPadding )
+{
+    cuOmmBaking::BakeCache cache( m_cacheOptions );
+    const CacheBakeResult  expected = bake( &cache, makeScene() );
+    ASSERT_FALSE( expected.cacheHit );
+
+    // the same states with set padding bits between the rows, at byte and non-byte aligned pitches.
+    for( uint32_t paddingInBits : { 8u, 6u } )
+    {
+        const CacheBakeResult result = bake( &cache, makeScene( 1.f, paddingInBits ) );
+        EXPECT_TRUE( result.cacheHit ) << paddingInBits;
+        expectEqual( expected, result );
+    }
+}
+
+TEST_F( OmmBakingCache, KeyIncludesTextureSharing )
+{
+    // Two inputs sharing a texture produce shared omms, unlike two inputs with identical copies of a texture.
+    Scene shared = makeScene();
+    shared.textures.push_back( shared.textures[0] );
+    shared.inputs.push_back( shared.inputs[0] );
+    Scene copied              = shared;
+    copied.inputs[1].textures = { 1 };
+
+    cuOmmBaking::BakeCache cache( m_cacheOptions );
+    const CacheBakeResult  sharedResult = bake( &cache, shared );
+    const CacheBakeResult  copiedResult = bake( &cache, copied );
+    ASSERT_EQ( cuOmmBaking::Result::SUCCESS, sharedResult.result );
+    ASSERT_EQ( cuOmmBaking::Result::SUCCESS, copiedResult.result );
+    EXPECT_FALSE( copiedResult.cacheHit );
+    EXPECT_LT( sharedResult.postBakeInfo.numMicromapDescs, copiedResult.postBakeInfo.numMicromapDescs );
+
+    EXPECT_TRUE( bake( &cache, shared ).cacheHit );
+}
+
+TEST_F( OmmBakingCache, RebakesCorruptFiles )
+{
+    const Scene scene = makeScene();
+    {
+        cuOmmBaking::BakeCache cache( m_cacheOptions );
+        bake( &cache, scene );
+    }
+
+    // flip a bit in the payload
+    const std::vector<fs::path> files = getCacheFiles();
+    ASSERT_EQ( 1u, files.size() );
+    {
+        std::fstream file( files[0], std::ios::binary | std::ios::in | std::ios::out );
+        file.seekg( -1, std::ios::end );
+        const char last = static_cast<char>( file.get() );
+        file.seekp( -1, std::ios::end );
+        file.put( static_cast<char>( last ^ 1 ) );
+    }
+
+    cuOmmBaking::BakeCache cache( m_cacheOptions );
+    const CacheBakeResult  result = bake( &cache, scene );
+    ASSERT_EQ( cuOmmBaking::Result::SUCCESS, result.result );
+    EXPECT_FALSE( result.cacheHit );
+    expectEqual( bake( nullptr, scene ), result );
+    EXPECT_EQ( 1u, cache.getStatistics().numCorruptFiles );
+
+    // the re-baked file replaces the corrupt one
+    EXPECT_TRUE( bake( &cache, scene ).cacheHit );
+}
+
+TEST_F( OmmBakingCache, EvictsLeastRecentlyUsedFiles )
+{
+    // Find the size of one cache file, and allow two of them.
+    size_t fileSize;
+    {
+        cuOmmBaking::BakeCache cache( m_cacheOptions );
+        bake( &cache, makeScene( 1.f ) );
+        fileSize = cache.getSizeInBytes();
+        cache.clear();
+        EXPECT_EQ( 0u, cache.getSizeInBytes() );
+    }
+    ASSERT_GT( fileSize, 0u );
+    m_cacheOptions.maxSizeInBytes = 2 * fileSize + fileSize / 2;
+
+    cuOmmBaking::BakeCache cache( m_cacheOptions );
+    bake( &cache, makeScene( 1.f ) );
+    bake( &cache, makeScene( 1.05f ) );
+
+    // use the first bake, making the second the least recently used.
+    EXPECT_TRUE( bake( &cache, makeScene( 1.f ) ).cacheHit );
+
+    bake( &cache, makeScene( 1.1f ) );
+    EXPECT_EQ( 1u, cache.getStatistics().numEvictions );
+    EXPECT_LE( cache.getSizeInBytes(), m_cacheOptions.maxSizeInBytes );
+
+    EXPECT_TRUE( bake( &cache, makeScene( 1.f ) ).cacheHit );
+    EXPECT_FALSE( bake( &cache, makeScene( 1.05f ) ).cacheHit );
+}
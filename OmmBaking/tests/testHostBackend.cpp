@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include "testHostScene.h"
+
+#include <OptiXToolkit/CuOmmBaking/CuOmmBaking.h>
+
+#include <cuda_runtime.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {  // anonymous
+
+class OmmBakingHostBackend : public testing::Test
+{
+  protected:
+    cuOmmBaking::BakeOptions m_options;
+
+    void SetUp() override { m_options.flags = cuOmmBaking::BakeFlags::ENABLE_POST_BAKE_INFO; }
+
+    static bool hasCudaDevice()
+    {
+        int numDevices = 0;
+        return cudaGetDeviceCount( &numDevices ) == cudaSuccess && numDevices > 0;
+    }
+
+    cuOmmBaking::Result bake( const Scene& scene, cuOmmBaking::BakeBackend backend, BakeResult& result )
+    {
+        cuOmmBaking::BakeOptions options = m_options;
+        options.backend                  = backend;
+        return bakeScene( scene, options, result );
+    }
+
+    // Bake the scene with both backends and expect identical outputs.
+    void expectBackendsMatch( const Scene& scene )
+    {
+        if( !hasCudaDevice() )
+            GTEST_SKIP() << "No CUDA device, skipping comparison with the CUDA backend";
+
+        BakeResult host;
+        BakeResult cuda;
+        ASSERT_EQ( cuOmmBaking::Result::SUCCESS, bake( scene, cuOmmBaking::BakeBackend::HOST, host ) );
+        ASSERT_EQ( cuOmmBaking::Result::SUCCESS, bake( scene, cuOmmBaking::BakeBackend::CUDA, cuda ) );
+
+        EXPECT_GT( host.postBakeInfo.numMicromapDescs, 0u );
+        ASSERT_EQ( cuda.postBakeInfo.numMicromapDescs, host.postBakeInfo.numMicromapDescs );
+        ASSERT_EQ( cuda.postBakeInfo.compactedSizeInBytes, host.postBakeInfo.compactedSizeInBytes );
+
+        for( size_t i = 0; i < cuda.descs.size(); ++i )
+        {
+            EXPECT_EQ( cuda.descs[i].byteOffset, host.descs[i].byteOffset ) << "desc " << i;
+            EXPECT_EQ( cuda.descs[i].subdivisionLevel, host.descs[i].subdivisionLevel ) << "desc " << i;
+            EXPECT_EQ( cuda.descs[i].format, host.descs[i].format ) << "desc " << i;
+        }
+        EXPECT_TRUE( cuda.data == host.data );
+
+        ASSERT_EQ( cuda.histogram.size(), host.histogram.size() );
+        for( size_t i = 0; i < cuda.histogram.size(); ++i )
+        {
+            EXPECT_EQ( cuda.histogram[i].count, host.histogram[i].count ) << "histogram entry " << i;
+            EXPECT_EQ( cuda.histogram[i].subdivisionLevel, host.histogram[i].subdivisionLevel ) << "histogram entry " << i;
+        }
+
+        ASSERT_EQ( cuda.indexBuffers.size(), host.indexBuffers.size() );
+        for( size_t i = 0; i < cuda.indexBuffers.size(); ++i )
+        {
+            EXPECT_TRUE( cuda.indexBuffers[i] == host.indexBuffers[i] ) << "index buffer " << i;
+
+            ASSERT_EQ( cuda.usageCounts[i].size(), host.usageCounts[i].size() );
+            for( size_t j = 0; j < cuda.usageCounts[i].size(); ++j )
+                EXPECT_EQ( cuda.usageCounts[i][j].count, host.usageCounts[i][j].count ) << "input " << i << ", usage count " << j;
+        }
+    }
+};
+
+}  // namespace
+
+TEST_F( OmmBakingHostBackend, TwoStateMatchesCuda )
+{
+    Scene scene;
+    scene.textures = { makeDiscTexture( 64, 64 ) };
+    scene.inputs   = { makeGrid( 8, { 0.f, 0.f }, { 1.f, 1.f } ) };
+
+    m_options.format = OPTIX_OPACITY_MICROMAP_FORMAT_2_STATE;
+    expectBackendsMatch( scene );
+}
+
+TEST_F( OmmBakingHostBackend, FourStateMatchesCuda )
+{
+    Scene scene;
+    scene.textures = { makeDiscTexture( 64, 48, 6 ) };
+    scene.textures[0].filterKernelWidthInTexels = 1.f;
+    scene.inputs = { makeGrid( 8, { 0.f, 0.f }, { 1.f, 1.f } ) };
+
+    m_options.format = OPTIX_OPACITY_MICROMAP_FORMAT_4_STATE;
+    expectBackendsMatch( scene );
+}
+
+TEST_F( OmmBakingHostBackend, AddressModesMatchCuda )
+{
+    const cudaTextureAddressMode modes[3][2] = {
+        { cudaAddressModeWrap, cudaAddressModeMirror }, { cudaAddressModeMirror, cudaAddressModeWrap }, { cudaAddressModeClamp, cudaAddressModeClamp } };
+
+    for( const auto& mode : modes )
+    {
+        Scene scene;
+        scene.textures                 = { makeDiscTexture( 32, 32 ) };
+        scene.textures[0].addressMode[0] = mode[0];
+        scene.textures[0].addressMode[1] = mode[1];
+        scene.inputs                   = { makeGrid( 10, { -1.5f, -2.f }, { 2.5f, 3.f } ) };
+
+        m_options.format = OPTIX_OPACITY_MICROMAP_FORMAT_4_STATE;
+        expectBackendsMatch( scene );
+    }
+}
+
+TEST_F( OmmBakingHostBackend, MultipleInputsMatchCuda )
+{
+    Scene scene;
+    scene.textures = { makeDiscTexture( 64, 64 ), makeDiscTexture( 16, 32 ) };
+
+    // repeating uvs produce duplicate omms within and across inputs
+    Input repeated = makeGrid( 12, { 0.f, 0.f }, { 3.f, 3.f } );
+    Input transformed = makeGrid( 6, { 0.f, 0.f }, { 1.f, 1.f } );
+    transformed.transform = { 0.5f, 0.25f, 0.1f, -0.25f, 0.5f, 0.3f };
+    transformed.textures = { 0, 1 };
+    for( size_t i = 0; i < transformed.indices.size(); ++i )
+        transformed.textureIndices.push_back( ( i / 3 ) % 2 );
+
+    // non-indexed input
+    Input soup;
+    for( const uint3& triangle : repeated.indices )
+    {
+        soup.texCoords.push_back( repeated.texCoords[triangle.x] );
+        soup.texCoords.push_back( repeated.texCoords[triangle.y] );
+        soup.texCoords.push_back( repeated.texCoords[triangle.z] );
+    }
+    soup.textures = { 1 };
+
+    scene.inputs = { repeated, transformed, soup };
+
+    m_options.format = OPTIX_OPACITY_MICROMAP_FORMAT_2_STATE;
+    expectBackendsMatch( scene );
+    m_options.format = OPTIX_OPACITY_MICROMAP_FORMAT_4_STATE;
+    expectBackendsMatch( scene );
+}
+
+TEST_F( OmmBakingHostBackend, SizeConstraintMatchesCuda )
+{
+    Scene scene;
+    scene.textures = { makeDiscTexture( 128, 128 ) };
+    scene.inputs   = { makeGrid( 16, { 0.f, 0.f }, { 1.f, 1.f } ) };
+
+    m_options.format             = OPTIX_OPACITY_MICROMAP_FORMAT_4_STATE;
+    m_options.subdivisionScale   = 0.25f;
+    m_options.maximumSizeInBytes = 1000;
+    expectBackendsMatch( scene );
+
+    m_options.subdivisionScale = 0.f;
+    expectBackendsMatch( scene );
+}
+
+TEST_F( OmmBakingHostBackend, BakesUniformTexture )
+{
+    Scene scene;
+    scene.textures = { makeUniformTexture( 16, 16, cuOmmBaking::OpacityState::STATE_OPAQUE ) };
+    scene.inputs   = { makeGrid( 4, { 0.f, 0.f }, { 1.f, 1.f } ) };
+
+    BakeResult result;
+    ASSERT_EQ( cuOmmBaking::Result::SUCCESS, bake( scene, cuOmmBaking::BakeBackend::HOST, result ) );
+
+    EXPECT_EQ( 0u, result.postBakeInfo.numMicromapDescs );
+    EXPECT_EQ( 0u, result.postBakeInfo.compactedSizeInBytes );
+
+    // all triangles are assigned the predefined fully opaque index
+    const std::vector<uint8_t>& indices = result.indexBuffers[0];
+    ASSERT_EQ( scene.inputs[0].indices.size() * sizeof( uint16_t ), indices.size() );
+    for( size_t i = 0; i < indices.size() / sizeof( uint16_t ); ++i )
+    {
+        int16_t index;
+        memcpy( &index, indices.data() + i * sizeof( uint16_t ), sizeof( index ) );
+        EXPECT_EQ( OPTIX_OPACITY_MICROMAP_PREDEFINED_INDEX_FULLY_OPAQUE, index );
+    }
+}
+
+TEST_F( OmmBakingHostBackend, BakesMixedTexture )
+{
+    Scene scene;
+    scene.textures = { makeDiscTexture( 64, 64 ) };
+    scene.inputs   = { makeGrid( 8, { 0.f, 0.f }, { 1.f, 1.f } ) };
+
+    BakeResult result;
+    ASSERT_EQ( cuOmmBaking::Result::SUCCESS, bake( scene, cuOmmBaking::BakeBackend::HOST, result ) );
+    EXPECT_GT( result.postBakeInfo.numMicromapDescs, 0u );
+
+    // the histogram counts all omms in the array
+    uint32_t numOmms = 0;
+    for( const OptixOpacityMicromapHistogramEntry& entry : result.histogram )
+        numOmms += entry.count;
+    EXPECT_EQ( result.postBakeInfo.numMicromapDescs, numOmms );
+
+    // the omms are laid out back to back, with 4 micro triangle states per byte
+    uint32_t byteOffset = 0;
+    for( const OptixOpacityMicromapDesc& desc : result.descs )
+    {
+        EXPECT_EQ( OPTIX_OPACITY_MICROMAP_FORMAT_4_STATE, desc.format );
+        EXPECT_EQ( byteOffset, desc.byteOffset );
+        byteOffset += std::max( 1u, ( 1u << ( 2 * desc.subdivisionLevel ) ) / 4 );
+    }
+    EXPECT_EQ( result.postBakeInfo.compactedSizeInBytes, byteOffset );
+}
+
+TEST_F( OmmBakingHostBackend, RejectsCudaTextures )
+{
+    const float2 texCoords[3] = { { 0.f, 0.f }, { 1.f, 0.f }, { 0.f, 1.f } };
+
+    cuOmmBaking::TextureDesc texture = {};
+    texture.type                     = cuOmmBaking::TextureType::CUDA;
+    texture.cuda.texObject           = 1;
+
+    cuOmmBaking::BakeInputDesc input = {};
+    input.texCoordFormat             = cuOmmBaking::TexCoordFormat::UV32_FLOAT2;
+    input.texCoordBuffer             = reinterpret_cast<CUdeviceptr>( texCoords );
+    input.numTexCoords               = 3;
+    input.numTextures                = 1;
+    input.textures                   = &texture;
+
+    m_options.backend = cuOmmBaking::BakeBackend::HOST;
+
+    cuOmmBaking::BakeInputBuffers inputBuffers = {};
+    cuOmmBaking::BakeBuffers      buffers      = {};
+    EXPECT_EQ( cuOmmBaking::Result::ERROR_INVALID_VALUE, cuOmmBaking::GetPreBakeInfo( &m_options, 1, &input, &inputBuffers, &buffers ) );
+}
@@ -0,0 +1,285 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include <OptiXToolkit/CuOmmBaking/CuBuffer.h>
+#include <OptiXToolkit/CuOmmBaking/CuOmmBaking.h>
+
+#include <OptiXToolkit/Error/cudaErrorCheck.h>
+
+#include <cuda_runtime.h>
+
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+// Bake inputs and outputs in host memory, shared by the host backend and bake cache tests.
+
+// A 2-bit per texel opacity state texture in host memory.
+struct StateTexture
+{
+    uint32_t               width  = 0;
+    uint32_t               height = 0;
+    uint32_t               pitchInBits = 0;
+    std::vector<uint8_t>   states;
+    cudaTextureAddressMode addressMode[2] = { cudaAddressModeWrap, cudaAddressModeWrap };
+    float                  filterKernelWidthInTexels = 0.f;
+};
+
+// A bake input in host memory. Textures index into Scene::textures.
+struct Input
+{
+    std::vector<float2>   texCoords;
+    std::vector<uint3>    indices;
+    std::vector<uint32_t> textureIndices;
+    std::vector<uint32_t> textures = { 0 };
+    std::vector<float>    transform;
+};
+
+struct Scene
+{
+    std::vector<StateTexture> textures;
+    std::vector<Input>        inputs;
+};
+
+// The outputs of a bake, in host memory.
+struct BakeResult
+{
+    std::vector<std::vector<uint8_t>>                        indexBuffers;
+    std::vector<std::vector<OptixOpacityMicromapUsageCount>> usageCounts;
+    std::vector<OptixOpacityMicromapHistogramEntry>          histogram;
+    std::vector<OptixOpacityMicromapDesc>                    descs;
+    std::vector<uint8_t>                                     data;
+    cuOmmBaking::PostBakeInfo                                postBakeInfo = {};
+};
+
+// Texture with opaque discs on a transparent background, with unknown texels along the disc edges.
+// The radii of the discs are scaled by radiusScale.
+inline StateTexture makeDiscTexture( uint32_t width, uint32_t height, uint32_t paddingInBits = 0, float radiusScale = 1.f )
+{
+    const float discs[3][3] = { { 0.3f, 0.3f, 0.2f }, { 0.7f, 0.6f, 0.25f }, { 0.2f, 0.8f, 0.1f } };
+    const float edgeWidth   = 1.5f / width;
+
+    StateTexture texture;
+    texture.width       = width;
+    texture.height      = height;
+    texture.pitchInBits = 2 * width + paddingInBits;
+    texture.states.resize( ( texture.pitchInBits * height + 7 ) / 8 );
+
+    for( uint32_t y = 0; y < height; ++y )
+    {
+        for( uint32_t x = 0; x < width; ++x )
+        {
+            const float u = ( x + 0.5f ) / width;
+            const float v = ( y + 0.5f ) / height;
+
+            cuOmmBaking::OpacityState state = cuOmmBaking::OpacityState::STATE_TRANSPARENT;
+            for( const auto& disc : discs )
+            {
+                const float d      = std::sqrt( ( u - disc[0] ) * ( u - disc[0] ) + ( v - disc[1] ) * ( v - disc[1] ) );
+                const float radius = disc[2] * radiusScale;
+                if( d < radius - edgeWidth )
+                    state = cuOmmBaking::OpacityState::STATE_OPAQUE;
+                else if( d <= radius + edgeWidth && state != cuOmmBaking::OpacityState::STATE_OPAQUE )
+                    state = cuOmmBaking::OpacityState::STATE_UNKNOWN;
+            }
+
+            const uint32_t bit = x * 2 + y * texture.pitchInBits;
+            texture.states[bit / 8] |= ( uint8_t )state << ( bit % 8 );
+        }
+    }
+
+    return texture;
+}
+
+inline StateTexture makeUniformTexture( uint32_t width, uint32_t height, cuOmmBaking::OpacityState state )
+{
+    StateTexture texture;
+    texture.width       = width;
+    texture.height      = height;
+    texture.pitchInBits = 2 * width;
+    texture.states.resize( ( texture.pitchInBits * height + 7 ) / 8, ( uint8_t )( ( uint32_t )state * 0x55 ) );
+    return texture;
+}
+
+// Indexed grid of resolution x resolution quads with two triangles each, spanning the given uv range.
+inline Input makeGrid( uint32_t resolution, float2 uvMin, float2 uvMax )
+{
+    Input input;
+    for( uint32_t y = 0; y <= resolution; ++y )
+        for( uint32_t x = 0; x <= resolution; ++x )
+            input.texCoords.push_back( { uvMin.x + ( uvMax.x - uvMin.x ) * x / resolution, uvMin.y + ( uvMax.y - uvMin.y ) * y / resolution } );
+
+    for( uint32_t y = 0; y < resolution; ++y )
+    {
+        for( uint32_t x = 0; x < resolution; ++x )
+        {
+            const uint32_t i0 = x + y * ( resolution + 1 );
+            const uint32_t i1 = i0 + 1;
+            const uint32_t i2 = i0 + resolution + 1;
+            const uint32_t i3 = i2 + 1;
+            input.indices.push_back( { i0, i1, i2 } );
+            input.indices.push_back( { i1, i3, i2 } );
+        }
+    }
+    return input;
+}
+
+// Host or device memory for the inputs and outputs of a bake.
+class Memory
+{
+  public:
+    explicit Memory( cuOmmBaking::BakeBackend backend )
+        : m_backend( backend )
+    {
+    }
+
+    CUdeviceptr alloc( size_t sizeInBytes )
+    {
+        const size_t count = ( sizeInBytes + sizeof( uint64_t ) - 1 ) / sizeof( uint64_t );
+        if( m_backend == cuOmmBaking::BakeBackend::HOST )
+        {
+            m_host.emplace_back( count );
+            return reinterpret_cast<CUdeviceptr>( m_host.back().data() );
+        }
+        m_device.emplace_back( count );
+        return m_device.back().get();
+    }
+
+    template <typename T>
+    CUdeviceptr upload( const std::vector<T>& data )
+    {
+        if( data.empty() )
+            return 0;
+        const size_t sizeInBytes = data.size() * sizeof( T );
+        CUdeviceptr  ptr         = alloc( sizeInBytes );
+        if( m_backend == cuOmmBaking::BakeBackend::HOST )
+            memcpy( reinterpret_cast<void*>( ptr ), data.data(), sizeInBytes );
+        else
+            OTK_ERROR_CHECK( cudaMemcpy( reinterpret_cast<void*>( ptr ), data.data(), sizeInBytes, cudaMemcpyHostToDevice ) );
+        return ptr;
+    }
+
+    template <typename T>
+    std::vector<T> download( CUdeviceptr ptr, size_t count )
+    {
+        std::vector<T> data( count );
+        if( count == 0 )
+            return data;
+        if( m_backend == cuOmmBaking::BakeBackend::HOST )
+            memcpy( data.data(), reinterpret_cast<const void*>( ptr ), count * sizeof( T ) );
+        else
+            OTK_ERROR_CHECK( cudaMemcpy( data.data(), reinterpret_cast<const void*>( ptr ), count * sizeof( T ), cudaMemcpyDeviceToHost ) );
+        return data;
+    }
+
+  private:
+    cuOmmBaking::BakeBackend           m_backend;
+    std::vector<std::vector<uint64_t>> m_host;
+    std::vector<CuBuffer<uint64_t>>    m_device;
+};
+
+// Bakes the inputs into the buffers, like cuOmmBaking::BakeOpacityMicromaps.
+using BakeFunction = std::function<cuOmmBaking::Result( const cuOmmBaking::BakeOptions*      options,
+                                                        unsigned                             numInputs,
+                                                        const cuOmmBaking::BakeInputDesc*    inputs,
+                                                        const cuOmmBaking::BakeInputBuffers* inputBuffers,
+                                                        const cuOmmBaking::BakeBuffers*      buffers )>;
+
+// Bake the scene in the memory of the backend in the options, with bake if it is set and
+// cuOmmBaking::BakeOpacityMicromaps otherwise.  Requires BakeFlags::ENABLE_POST_BAKE_INFO.
+inline cuOmmBaking::Result bakeScene( const Scene& scene, const cuOmmBaking::BakeOptions& options, BakeResult& result, const BakeFunction& bake = BakeFunction() )
+{
+    Memory memory( options.backend );
+
+    std::vector<std::vector<cuOmmBaking::TextureDesc>> textures( scene.inputs.size() );
+    std::vector<cuOmmBaking::BakeInputDesc>            inputs( scene.inputs.size() );
+
+    std::vector<CUdeviceptr> stateBuffers;
+    for( const StateTexture& texture : scene.textures )
+        stateBuffers.push_back( memory.upload( texture.states ) );
+
+    for( size_t i = 0; i < scene.inputs.size(); ++i )
+    {
+        const Input& input = scene.inputs[i];
+
+        for( uint32_t textureIdx : input.textures )
+        {
+            const StateTexture&      texture = scene.textures[textureIdx];
+            cuOmmBaking::TextureDesc desc    = {};
+            desc.type                        = cuOmmBaking::TextureType::STATE;
+            desc.state.width                 = texture.width;
+            desc.state.height                = texture.height;
+            desc.state.pitchInBits           = texture.pitchInBits;
+            desc.state.stateBuffer           = stateBuffers[textureIdx];
+            desc.state.addressMode[0]        = texture.addressMode[0];
+            desc.state.addressMode[1]        = texture.addressMode[1];
+            desc.state.filterKernelWidthInTexels = texture.filterKernelWidthInTexels;
+            textures[i].push_back( desc );
+        }
+
+        cuOmmBaking::BakeInputDesc& desc = inputs[i];
+        desc                             = {};
+        desc.texCoordFormat              = cuOmmBaking::TexCoordFormat::UV32_FLOAT2;
+        desc.texCoordBuffer              = memory.upload( input.texCoords );
+        desc.numTexCoords                = ( unsigned int )input.texCoords.size();
+        if( !input.indices.empty() )
+        {
+            desc.indexFormat      = cuOmmBaking::IndexFormat::I32_UINT;
+            desc.indexBuffer      = memory.upload( input.indices );
+            desc.numIndexTriplets = ( unsigned int )input.indices.size();
+        }
+        if( !input.transform.empty() )
+        {
+            desc.transformFormat = cuOmmBaking::UVTransformFormat::MATRIX_FLOAT2X3;
+            desc.transform       = memory.upload( input.transform );
+        }
+        desc.numTextures = ( unsigned int )textures[i].size();
+        desc.textures    = textures[i].data();
+        if( !input.textureIndices.empty() )
+        {
+            desc.textureIndexFormat = cuOmmBaking::IndexFormat::I32_UINT;
+            desc.textureIndexBuffer = memory.upload( input.textureIndices );
+        }
+    }
+
+    std::vector<cuOmmBaking::BakeInputBuffers> inputBuffers( inputs.size() );
+    cuOmmBaking::BakeBuffers                    buffers = {};
+    cuOmmBaking::Result res = cuOmmBaking::GetPreBakeInfo( &options, ( unsigned )inputs.size(), inputs.data(), inputBuffers.data(), &buffers );
+    if( res != cuOmmBaking::Result::SUCCESS )
+        return res;
+
+    for( cuOmmBaking::BakeInputBuffers& inputBuffer : inputBuffers )
+    {
+        inputBuffer.indexBuffer               = memory.alloc( inputBuffer.indexBufferSizeInBytes );
+        inputBuffer.micromapUsageCountsBuffer = memory.alloc( inputBuffer.numMicromapUsageCounts * sizeof( OptixOpacityMicromapUsageCount ) );
+    }
+    buffers.outputBuffer                   = memory.alloc( buffers.outputBufferSizeInBytes );
+    buffers.perMicromapDescBuffer          = memory.alloc( buffers.numMicromapDescs * sizeof( OptixOpacityMicromapDesc ) );
+    buffers.micromapHistogramEntriesBuffer = memory.alloc( buffers.numMicromapHistogramEntries * sizeof( OptixOpacityMicromapHistogramEntry ) );
+    buffers.postBakeInfoBuffer             = memory.alloc( buffers.postBakeInfoBufferSizeInBytes );
+    buffers.tempBuffer                     = memory.alloc( buffers.tempBufferSizeInBytes );
+
+    if( bake )
+        res = bake( &options, ( unsigned )inputs.size(), inputs.data(), inputBuffers.data(), &buffers );
+    else
+        res = cuOmmBaking::BakeOpacityMicromaps( &options, ( unsigned )inputs.size(), inputs.data(), inputBuffers.data(), &buffers, 0 );
+    if( res != cuOmmBaking::Result::SUCCESS )
+        return res;
+
+    result.postBakeInfo = memory.download<cuOmmBaking::PostBakeInfo>( buffers.postBakeInfoBuffer, 1 )[0];
+    result.histogram    = memory.download<OptixOpacityMicromapHistogramEntry>( buffers.micromapHistogramEntriesBuffer, buffers.numMicromapHistogramEntries );
+    result.descs        = memory.download<OptixOpacityMicromapDesc>( buffers.perMicromapDescBuffer, result.postBakeInfo.numMicromapDescs );
+    result.data         = memory.download<uint8_t>( buffers.outputBuffer, result.postBakeInfo.compactedSizeInBytes );
+    result.indexBuffers.clear();
+    result.usageCounts.clear();
+    for( const cuOmmBaking::BakeInputBuffers& inputBuffer : inputBuffers )
+    {
+        result.indexBuffers.push_back( memory.download<uint8_t>( inputBuffer.indexBuffer, inputBuffer.indexBufferSizeInBytes ) );
+        result.usageCounts.push_back( memory.download<OptixOpacityMicromapUsageCount>( inputBuffer.micromapUsageCountsBuffer, inputBuffer.numMicromapUsageCounts ) );
+    }
+    return res;
+}
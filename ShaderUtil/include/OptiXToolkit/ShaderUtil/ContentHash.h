@@ -0,0 +1,152 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+// The stripe loop and the round functions below are those of XXH64, from the xxHash library:
+//
+//  Copyright( c ) 2012 - 2021 Yann Collet
+//  All rights reserved.
+//
+//  BSD 2 - Clause License( https://www.opensource.org/licenses/bsd-license.php)
+//
+//  Redistribution and use in source and binary forms, with or without modification,
+//  are permitted provided that the following conditions are met :
+//
+//  * Redistributions of source code must retain the above copyright notice, this
+//  list of conditions and the following disclaimer.
+//
+//  * Redistributions in binary form must reproduce the above copyright notice, this
+//  list of conditions and the following disclaimer in the documentation and /or
+//  other materials provided with the distribution.
+//
+//  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+//  ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+//  DISCLAIMED.IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+//  ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+//  ( INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+//  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION ) HOWEVER CAUSED AND ON
+//  ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+//  ( INCLUDING NEGLIGENCE OR OTHERWISE ) ARISING IN ANY WAY OUT OF THE USE OF THIS
+//  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+
+#pragma once
+
+/// \file ContentHash.h
+/// A streaming 128-bit hash of host data, for content-addressed caches and deduplication.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace otk {
+
+/// ContentHasher computes a 128-bit hash of the bytes added to it.  It runs the four independent
+/// lanes of the XXH64 stripe loop, which hash at close to memory bandwidth, and folds the 256-bit
+/// lane state into two 64-bit values, merged in different orders so that each depends on the whole
+/// state.  A partial final stripe is padded with zeros; the total size is mixed into the result.
+///
+/// The hash is not cryptographic.  For n distinct inputs, the probability that any two of them
+/// have equal hashes is about n^2 / 2^129 (under 2^-65 for 2^32 inputs), so callers may treat equal
+/// hashes as equal contents when the inputs are not chosen adversarially.
+class ContentHasher
+{
+  public:
+    /// Add size bytes of data to the hash.
+    void add( const void* data, size_t size )
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>( data );
+        m_totalSize += size;
+        if( m_stripeSize )
+        {
+            const size_t n = std::min( size, STRIPE_SIZE - m_stripeSize );
+            memcpy( m_stripe + m_stripeSize, bytes, n );
+            m_stripeSize += n;
+            bytes += n;
+            size -= n;
+            if( m_stripeSize < STRIPE_SIZE )
+                return;
+            consume( m_stripe );
+            m_stripeSize = 0;
+        }
+        for( ; size >= STRIPE_SIZE; bytes += STRIPE_SIZE, size -= STRIPE_SIZE )
+            consume( bytes );
+        memcpy( m_stripe, bytes, size );
+        m_stripeSize = size;
+    }
+
+    /// Add the bytes of a trivially copyable value to the hash.
+    template <typename T>
+    void addValue( T value )
+    {
+        add( &value, sizeof( T ) );
+    }
+
+    /// Get the hash of the bytes added so far.  More bytes can be added afterwards.
+    void get( uint64_t hash[2] ) const
+    {
+        ContentHasher tail = *this;
+        if( tail.m_stripeSize )
+        {
+            memset( tail.m_stripe + tail.m_stripeSize, 0, STRIPE_SIZE - tail.m_stripeSize );
+            tail.consume( tail.m_stripe );
+        }
+        const uint64_t* v = tail.m_lanes;
+
+        uint64_t h = rotl( v[0], 1 ) + rotl( v[1], 7 ) + rotl( v[2], 12 ) + rotl( v[3], 18 );
+        h          = mergeRound( mergeRound( mergeRound( mergeRound( h, v[0] ), v[1] ), v[2] ), v[3] );
+
+        uint64_t h2 = rotl( v[3], 3 ) + rotl( v[2], 11 ) + rotl( v[1], 23 ) + rotl( v[0], 37 );
+        h2          = mergeRound( mergeRound( mergeRound( mergeRound( h2, v[3] ), v[2] ), v[1] ), v[0] );
+
+        hash[0] = avalanche( h + m_totalSize );
+        hash[1] = avalanche( h2 + m_totalSize * PRIME64_5 );
+    }
+
+  private:
+    static const size_t   STRIPE_SIZE = 32;
+    static const uint64_t PRIME64_1   = 0x9E3779B185EBCA87ULL;
+    static const uint64_t PRIME64_2   = 0xC2B2AE3D27D4EB4FULL;
+    static const uint64_t PRIME64_3   = 0x165667B19E3779F9ULL;
+    static const uint64_t PRIME64_4   = 0x85EBCA77C2B2AE63ULL;
+    static const uint64_t PRIME64_5   = 0x27D4EB2F165667C5ULL;
+
+    uint64_t m_lanes[4]            = { PRIME64_1 + PRIME64_2, PRIME64_2, 0, 0 - PRIME64_1 };
+    uint8_t  m_stripe[STRIPE_SIZE] = {};
+    size_t   m_stripeSize          = 0;
+    uint64_t m_totalSize           = 0;
+
+    static uint64_t rotl( uint64_t x, int r ) { return ( x << r ) | ( x >> ( 64 - r ) ); }
+
+    static uint64_t mixLane( uint64_t acc, uint64_t input ) { return rotl( acc + input * PRIME64_2, 31 ) * PRIME64_1; }
+
+    static uint64_t mergeRound( uint64_t acc, uint64_t val ) { return ( acc ^ mixLane( 0, val ) ) * PRIME64_1 + PRIME64_4; }
+
+    static uint64_t avalanche( uint64_t h )
+    {
+        h ^= h >> 33;
+        h *= PRIME64_2;
+        h ^= h >> 29;
+        h *= PRIME64_3;
+        return h ^ ( h >> 32 );
+    }
+
+    void consume( const uint8_t* stripe )
+    {
+        uint64_t lanes[4];
+        memcpy( lanes, stripe, sizeof( lanes ) );
+        for( int i = 0; i < 4; ++i )
+            m_lanes[i] = mixLane( m_lanes[i], lanes[i] );
+    }
+};
+
+/// Compute the 128-bit ContentHasher hash of size bytes of data.
+inline void hashContent( const void* data, size_t size, uint64_t hash[2] )
+{
+    ContentHasher hasher;
+    hasher.add( data, size );
+    hasher.get( hash );
+}
+
+}  // namespace otk
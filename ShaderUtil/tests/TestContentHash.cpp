@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <OptiXToolkit/ShaderUtil/ContentHash.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace otk;
+
+namespace {
+
+std::vector<uint8_t> makeData( size_t size )
+{
+    std::vector<uint8_t> data( size );
+    for( size_t i = 0; i < size; ++i )
+        data[i] = static_cast<uint8_t>( i * 131 + ( i >> 8 ) );
+    return data;
+}
+
+}  // namespace
+
+TEST( TestContentHash, IncrementalMatchesOneShot )
+{
+    const std::vector<uint8_t> data = makeData( 1000 );
+    uint64_t                   expected[2];
+    hashContent( data.data(), data.size(), expected );
+
+    // Add the data in pieces that straddle the 32-byte stripes.
+    for( size_t pieceSize : { 1, 7, 31, 32, 33, 100 } )
+    {
+        ContentHasher hasher;
+        for( size_t i = 0; i < data.size(); i += pieceSize )
+            hasher.add( &data[i], std::min( pieceSize, data.size() - i ) );
+        uint64_t hash[2];
+        hasher.get( hash );
+        EXPECT_EQ( expected[0], hash[0] ) << "piece size " << pieceSize;
+        EXPECT_EQ( expected[1], hash[1] ) << "piece size " << pieceSize;
+    }
+}
+
+TEST( TestContentHash, GetDoesNotConsumeState )
+{
+    const std::vector<uint8_t> data = makeData( 100 );
+    ContentHasher              hasher;
+    hasher.add( data.data(), 50 );
+    uint64_t partial[2];
+    hasher.get( partial );
+    hasher.add( &data[50], 50 );
+
+    uint64_t hash[2];
+    uint64_t expected[2];
+    hasher.get( hash );
+    hashContent( data.data(), data.size(), expected );
+    EXPECT_EQ( expected[0], hash[0] );
+    EXPECT_EQ( expected[1], hash[1] );
+}
+
+TEST( TestContentHash, ZeroPaddingDoesNotCollide )
+{
+    // The partial last stripe is padded with zeros, but the size is part of the hash.
+    std::vector<uint8_t> data = makeData( 40 );
+    uint64_t             hash[2];
+    hashContent( data.data(), data.size(), hash );
+    data.push_back( 0 );
+    uint64_t padded[2];
+    hashContent( data.data(), data.size(), padded );
+    EXPECT_NE( hash[0], padded[0] );
+    EXPECT_NE( hash[1], padded[1] );
+}
+
+TEST( TestContentHash, EveryBitChangesBothHalves )
+{
+    std::vector<uint8_t> data = makeData( 64 );
+    uint64_t             original[2];
+    hashContent( data.data(), data.size(), original );
+    for( size_t bit = 0; bit < data.size() * 8; ++bit )
+    {
+        data[bit / 8] ^= static_cast<uint8_t>( 1 << ( bit % 8 ) );
+        uint64_t hash[2];
+        hashContent( data.data(), data.size(), hash );
+        EXPECT_NE( original[0], hash[0] ) << "bit " << bit;
+        EXPECT_NE( original[1], hash[1] ) << "bit " << bit;
+        data[bit / 8] ^= static_cast<uint8_t>( 1 << ( bit % 8 ) );
+    }
+}
@@ -237,6 +237,13 @@ inline OptixInstancePredicate hasInstanceSbtOffset( unsigned int offset )
     };
 }
 
+inline OptixInstancePredicate hasInstanceVisibilityMask( unsigned int mask )
+{
+    return [mask]( ::testing::MatchResultListener* listener, const OptixInstance& instance ) {
+        return hasEqualValues( listener, "visibility mask", mask, instance.visibilityMask );
+    };
+}
+
 // Apply predicates to a specific OptixInstance from a vector of instances.
 template <typename... Predicates>
 OptixInstanceVectorPredicate hasInstance( unsigned int index, const Predicates&... preds )
@@ -489,6 +496,20 @@ MATCHER( isBuildOperation, "" )
     return true;
 }
 
+// OptixAccelBuildOptions
+MATCHER( isUpdateOperation, "" )
+{
+    if( arg->operation != OPTIX_BUILD_OPERATION_UPDATE )
+    {
+        *result_listener << "build operation is " << arg->operation << ", expected OPTIX_BUILD_OPERATION_UPDATE ("
+                         << OPTIX_BUILD_OPERATION_UPDATE << ')';
+        return false;
+    }
+
+    *result_listener << "build operation is OPTIX_BUILD_OPERATION_UPDATE (" << OPTIX_BUILD_OPERATION_UPDATE << ')';
+    return true;
+}
+
 // OptixAccelBuildOptions
 MATCHER( buildAllowsUpdate, "" )
 {
@@ -518,6 +539,20 @@ MATCHER( buildAllowsRandomVertexAccess, "" )
     return true;
 }
 
+// OptixAccelBuildOptions
+MATCHER( buildAllowsCompaction, "" )
+{
+    if( ( arg->buildFlags & OPTIX_BUILD_FLAG_ALLOW_COMPACTION ) == 0 )
+    {
+        *result_listener << "build flag OPTIX_BUILD_FLAG_ALLOW_COMPACTION (" << OPTIX_BUILD_FLAG_ALLOW_COMPACTION
+                         << ") not set in value " << arg->buildFlags;
+        return false;
+    }
+    *result_listener << "build flag OPTIX_BUILD_FLAG_ALLOW_COMPACTION (" << OPTIX_BUILD_FLAG_ALLOW_COMPACTION
+                     << ") set in value " << arg->buildFlags;
+    return true;
+}
+
 inline OptixCustomPrimitiveBuildInputPredicate hasNumCustomPrimitives( unsigned int numPrims )
 {
     return [=]( ::testing::MatchResultListener* listener, const OptixBuildInputCustomPrimitiveArray& prims ) {
@@ -395,6 +395,20 @@ TEST_F( TestOptixAccelBuildOptionsMatchers, isBuildOperation )
     EXPECT_THAT( &m_data, isBuildOperation() );
 }
 
+TEST_F( TestOptixAccelBuildOptionsMatchers, notUpdateOperation )
+{
+    m_data.operation = OPTIX_BUILD_OPERATION_BUILD;
+
+    EXPECT_THAT( &m_data, Not( isUpdateOperation() ) );
+}
+
+TEST_F( TestOptixAccelBuildOptionsMatchers, isUpdateOperation )
+{
+    m_data.operation = OPTIX_BUILD_OPERATION_UPDATE;
+
+    EXPECT_THAT( &m_data, isUpdateOperation() );
+}
+
 TEST_F( TestOptixAccelBuildOptionsMatchers, allowsUpdate )
 {
     m_data.buildFlags = OPTIX_BUILD_FLAG_ALLOW_UPDATE;
@@ -419,6 +433,18 @@ TEST_F( TestOptixAccelBuildOptionsMatchers, doesNotAllowRandomVertexAccess )
     EXPECT_THAT( &m_data, Not( buildAllowsRandomVertexAccess() ) );
 }
 
+TEST_F( TestOptixAccelBuildOptionsMatchers, allowsCompaction )
+{
+    m_data.buildFlags = OPTIX_BUILD_FLAG_ALLOW_COMPACTION;
+
+    EXPECT_THAT( &m_data, buildAllowsCompaction() );
+}
+
+TEST_F( TestOptixAccelBuildOptionsMatchers, doesNotAllowCompaction )
+{
+    EXPECT_THAT( &m_data, Not( buildAllowsCompaction() ) );
+}
+
 class TestOptixPipelineCompileOptionMatchers : public TestOptixStructMatcher<OptixPipelineCompileOptions>
 {
 };
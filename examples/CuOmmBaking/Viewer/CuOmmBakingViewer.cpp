@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -6,6 +6,7 @@
 #include "CuOmmBakingViewerKernelCuda.h"
 #include "LaunchParams.h"
 
+#include <OptiXToolkit/CuOmmBaking/BakeCache.h>
 #include <OptiXToolkit/CuOmmBaking/CuOmmBaking.h>
 #include <OptiXToolkit/Error/cudaErrorCheck.h>
 #include <OptiXToolkit/Error/optixErrorCheck.h>
@@ -14,6 +15,8 @@
 #include <optix_stack_size.h>
 #include <optix_stubs.h>
 
+#include <filesystem>
+#include <memory>
 #include <sstream>
 
 using namespace ommBakingApp;
@@ -97,6 +100,7 @@ class OmmBakingViewer : public OmmBakingApp
 
     void initOptixPipelines( const char* moduleCode, const size_t moduleCodeSize );
     void setTextureName( const char* textureName ) { m_textureName = textureName; }
+    void setBakeCacheDirectory( const char* directory );
 
   protected:
 
@@ -116,8 +120,19 @@ class OmmBakingViewer : public OmmBakingApp
     std::vector<PerDeviceState> m_state;
 
     std::string m_textureName;
+
+    std::unique_ptr<cuOmmBaking::BakeCache> m_bakeCache;
 };
 
+void OmmBakingViewer::setBakeCacheDirectory( const char* directory )
+{
+    if( !directory[0] )
+        return;
+    cuOmmBaking::BakeCacheOptions options;
+    options.directory = directory;
+    m_bakeCache.reset( new cuOmmBaking::BakeCache( options ) );
+}
+
 void OmmBakingViewer::createTexture( int device_idx )
 {
     PerDeviceState &state = m_state[device_idx];
@@ -217,6 +232,16 @@ void OmmBakingViewer::buildAccel( const PerDeviceOptixState& optixState )
         texture.cuda.texObject = state.texture.get();
         texture.cuda.transparencyCutoff = 0.f;
         texture.cuda.opacityCutoff = 1.f;
+
+        // The cache can't read back cuda textures, so identify the texture by its file.
+        if( m_bakeCache )
+        {
+            std::error_code    ec;
+            unsigned long long hash = std::hash<std::string>()( m_textureName );
+            hash = hash * 31 + std::filesystem::file_size( m_textureName, ec );
+            hash = hash * 31 + std::filesystem::last_write_time( m_textureName, ec ).time_since_epoch().count();
+            m_bakeCache->setTextureHash( texture.cuda.texObject, hash );
+        }
     }
     else
     {
@@ -289,7 +314,10 @@ void OmmBakingViewer::buildAccel( const PerDeviceOptixState& optixState )
             buffers.postBakeInfoBuffer = d_postBakeInfo.get();
             buffers.tempBuffer = d_temp.get();
 
-            BAKING_CHECK( cuOmmBaking::BakeOpacityMicromaps( &ommOptions, 1, &input, &inputBuffers, &buffers, 0 ) );
+            if( m_bakeCache )
+                BAKING_CHECK( m_bakeCache->bakeOpacityMicromaps( &ommOptions, 1, &input, &inputBuffers, &buffers, 0 ) );
+            else
+                BAKING_CHECK( cuOmmBaking::BakeOpacityMicromaps( &ommOptions, 1, &input, &inputBuffers, &buffers, 0 ) );
 
             // Download data that is needed on the host to build the OptiX Opacity Micromap Array
             h_usageCounts.resize( inputBuffers.numMicromapUsageCounts );
@@ -533,6 +561,7 @@ void printUsage( const char* argv0 )
 {
     std::cerr << "\nUsage: " << argv0 << " [options]\n\n";
     std::cout << "Options:  --texture <texturefile.exr>, --dim=<width>x<height>, --file <outputfile.ppm> --no-gl-interop\n";
+    std::cout << "          --bake-cache <directory>  Reuse opacity micromaps baked by earlier runs\n";
     std::cout << "Keyboard: <ESC>:exit, WASD:pan, QE:zoom, C:recenter, K:visualize unknowns\n";
     std::cout << "Mouse:    <LMB>:pan, <RMB>:zoom\n" << std::endl;
     exit(0);
@@ -544,6 +573,7 @@ int main( int argc, char* argv[] )
     int         windowHeight = 768;
     const char* textureName  = "";
     const char* outFileName  = "";
+    const char* bakeCacheDir = "";
     bool        glInterop    = true;
 
     for( int i = 1; i < argc; ++i )
@@ -555,6 +585,8 @@ int main( int argc, char* argv[] )
             textureName = argv[++i];
         else if( ( arg == "--file" ) && !lastArg )
             outFileName = argv[++i];
+        else if( ( arg == "--bake-cache" ) && !lastArg )
+            bakeCacheDir = argv[++i];
         else if( arg.substr( 0, 6 ) == "--dim=" )
             otk::parseDimensions( arg.substr( 6 ).c_str(), windowWidth, windowHeight );
         else if( arg == "--no-gl-interop" )
@@ -565,6 +597,7 @@ int main( int argc, char* argv[] )
 
     OmmBakingViewer app( "Opacity Micromap Viewer", windowWidth, windowHeight, outFileName, glInterop );
     app.setTextureName( textureName );
+    app.setBakeCacheDirectory( bakeCacheDir );
     app.initOptixPipelines( CuOmmBakingViewerCudaText(), CuOmmBakingViewerCudaSize );
     app.startLaunchLoop();
     
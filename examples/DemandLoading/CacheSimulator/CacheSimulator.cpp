@@ -0,0 +1,186 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+// Utility to simulate the texture tile cache of a demand loader on the requests in a trace file.
+
+#include <OptiXToolkit/DemandLoading/CacheSimulator.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace demandLoading;
+
+namespace {
+
+const double MEGABYTE = 1024.0 * 1024.0;
+
+struct Settings
+{
+    std::string                 traceFile;
+    std::vector<EvictionPolicy> policies;
+    std::vector<size_t>         budgetsInMB;
+    unsigned int                deviceIndex    = 0;
+    int                         maxStagedPages = -1;
+    int                         maxStalePages  = -1;
+    bool                        printFrames    = false;
+};
+
+int usage( const char* program )
+{
+    // clang-format off
+    std::cerr << "Usage: " << program << " [options] <trace file>\n"
+        "\n"
+        "Simulate the texture tile cache of a demand loader on the page requests in a trace file.\n"
+        "The recorded demand loader options are used unless they are overridden.\n"
+        "\n"
+        "Options:\n"
+        "  --policy <name>   Eviction policy: lru-threshold, random, clock, arc, 2q or all.\n"
+        "                    May be repeated.  Defaults to the recorded policy.\n"
+        "  --mem <MB>        Texture memory budget (maxTexMemPerDevice) in MB, 0 for unlimited.\n"
+        "                    May be a comma separated list.  Defaults to the recorded budget.\n"
+        "  --staged <n>      Maximum staged pages (maxStagedPages).\n"
+        "  --stale <n>       Maximum stale pages pulled per launch (maxStalePages).\n"
+        "  --device <n>      Device index of the requests to simulate (default 0).\n"
+        "  --frames          Print the statistics of every frame as CSV.\n";
+    // clang-format on
+    return -1;
+}
+
+bool parseArgs( int argc, char* argv[], Settings& settings )
+{
+    for( int i = 1; i < argc; ++i )
+    {
+        const std::string arg     = argv[i];
+        const bool        hasNext = i + 1 < argc;
+        if( arg == "--policy" && hasNext )
+        {
+            const std::string name = argv[++i];
+            EvictionPolicy    policy;
+            if( name == "all" )
+            {
+                for( int p = 0; p <= static_cast<int>( EvictionPolicy::TWO_Q ); ++p )
+                    settings.policies.push_back( static_cast<EvictionPolicy>( p ) );
+            }
+            else if( findEvictionPolicy( name.c_str(), policy ) )
+                settings.policies.push_back( policy );
+            else
+                throw std::runtime_error( "Unknown eviction policy: " + name );
+        }
+        else if( arg == "--mem" && hasNext )
+        {
+            std::stringstream budgets( argv[++i] );
+            std::string       budget;
+            while( std::getline( budgets, budget, ',' ) )
+                settings.budgetsInMB.push_back( static_cast<size_t>( std::strtoull( budget.c_str(), nullptr, 10 ) ) );
+        }
+        else if( arg == "--staged" && hasNext )
+            settings.maxStagedPages = std::atoi( argv[++i] );
+        else if( arg == "--stale" && hasNext )
+            settings.maxStalePages = std::atoi( argv[++i] );
+        else if( arg == "--device" && hasNext )
+            settings.deviceIndex = static_cast<unsigned int>( std::atoi( argv[++i] ) );
+        else if( arg == "--frames" )
+            settings.printFrames = true;
+        else if( arg[0] != '-' && settings.traceFile.empty() )
+            settings.traceFile = arg;
+        else
+            return false;
+    }
+    return !settings.traceFile.empty();
+}
+
+void printFrames( const std::vector<CacheSimulatorStats>& frames )
+{
+    std::cout << "frame,time_ms,requests,hits,restores,loads,reloads,dropped,staged,evicted,resident\n";
+    for( size_t i = 0; i < frames.size(); ++i )
+    {
+        const CacheSimulatorStats& frame = frames[i];
+        std::cout << i << ',' << frame.timestamp / 1.0e6 << ',' << frame.numRequests << ',' << frame.numHits << ','
+                  << frame.numRestores << ',' << frame.numLoads << ',' << frame.numReloads << ',' << frame.numDropped << ','
+                  << frame.numStaged << ',' << frame.numEvicted << ',' << frame.numResidentPages << '\n';
+    }
+}
+
+void printSummary( EvictionPolicy policy, size_t budgetInMB, const CacheSimulatorStats& totals )
+{
+    const double numFrames = totals.numFrames ? totals.numFrames : 1.0;
+    std::cout << std::left << std::setw( 14 ) << getEvictionPolicyName( policy ) << std::right << std::setw( 9 )
+              << ( budgetInMB ? std::to_string( budgetInMB ) : std::string( "unlimited" ) ) << std::fixed
+              << std::setprecision( 4 ) << std::setw( 10 ) << totals.hitRate() << std::setprecision( 1 ) << std::setw( 12 )
+              << totals.bytesRead / MEGABYTE << std::setw( 12 ) << totals.bytesReread / MEGABYTE << std::setw( 12 )
+              << totals.churn() / numFrames << std::setw( 10 ) << totals.numDropped << std::setw( 10 )
+              << totals.numResidentPages << '\n';
+}
+
+void simulate( const Settings& settings )
+{
+    Options options = getTraceFileOptions( settings.traceFile.c_str(), settings.deviceIndex );
+    if( settings.maxStagedPages >= 0 )
+        options.maxStagedPages = static_cast<unsigned int>( settings.maxStagedPages );
+    if( settings.maxStalePages >= 0 )
+        options.maxStalePages = static_cast<unsigned int>( settings.maxStalePages );
+
+    std::vector<EvictionPolicy> policies = settings.policies;
+    if( policies.empty() )
+        policies.push_back( getDefaultEvictionPolicy( options ) );
+    std::vector<size_t> budgetsInMB = settings.budgetsInMB;
+    if( budgetsInMB.empty() )
+        budgetsInMB.push_back( static_cast<size_t>( options.maxTexMemPerDevice / MEGABYTE ) );
+
+    if( !settings.printFrames )
+        std::cout << "policy         budgetMB   hitRate      readMB    rereadMB churn/frame   dropped  resident\n";
+    for( EvictionPolicy policy : policies )
+    {
+        for( size_t budgetInMB : budgetsInMB )
+        {
+            options.maxTexMemPerDevice = budgetInMB * static_cast<size_t>( MEGABYTE );
+            const std::vector<CacheSimulatorStats> frames =
+                simulateTraceFile( settings.traceFile.c_str(), options, policy, settings.deviceIndex );
+
+            CacheSimulatorStats totals;
+            for( const CacheSimulatorStats& frame : frames )
+                totals += frame;
+
+            if( settings.printFrames )
+            {
+                std::cout << "# policy " << getEvictionPolicyName( policy ) << ", budget " << budgetInMB << " MB\n";
+                printFrames( frames );
+            }
+            else
+            {
+                printSummary( policy, budgetInMB, totals );
+            }
+        }
+    }
+}
+
+}  // namespace
+
+int main( int argc, char* argv[] )
+{
+    try
+    {
+        Settings settings;
+        if( !parseArgs( argc, argv, settings ) )
+            return usage( argv[0] );
+        simulate( settings );
+    }
+    catch( const std::exception& bang )
+    {
+        std::cerr << bang.what() << '\n';
+        return 1;
+    }
+    catch( ... )
+    {
+        std::cerr << "Unknown exception\n";
+        return 2;
+    }
+    return 0;
+}
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2022-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2022-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -12,7 +12,6 @@
 #endif
 
 #include <cuda_runtime.h>
-#include <omp.h>
 
 #include <OptiXToolkit/ImageSource/CompressedTextureCacheManager.h>
 
@@ -66,7 +65,7 @@ void printUsage( char* program )
         "   --verbose | -v                               turn on verbose output.\n"
         "   --multiGPU | -mg                             use multiple GPUs if available.\n"
         "   --showErrors | -e                            show errors from external programs.\n"
-        "   --threads | -t <numThreads>                  number of threads to use. (default 8, 1 for NTC)\n"
+        "   --threads | -t <numThreads>                  number of files to convert at once. (default 8, 1 for NTC)\n"
         "\n"
         "DDS Compression Options:\n"
         "   --nvcompress | -nc <nvcompress executable>   nvcompress executable path.\n"
@@ -164,6 +163,9 @@ int main( int argc, char* argv[] )
 
     if( numThreads == 0 )
         numThreads = ntcCliFound ? DEFAULT_NTC_THREADS : DEFAULT_NVCOMPRESS_THREADS;
+    options.maxJobs           = numThreads;
+    options.maxNvcompressJobs = numThreads;
+    options.maxNtcCliJobs     = numThreads;
 
     if( !nvcompressFound && !ntcCliFound )
     {
@@ -265,110 +267,28 @@ int main( int argc, char* argv[] )
     }
 
     //
-    // Convert the images
+    // Convert the images.  Files that are unchanged since they were cached are skipped.
     //
 
-    if( numThreads > 1 )
-        cacheManager.setVerbose( false );
-
-    // Convert the source images to DDS.
-    if( nvcompressFound )
+    if( !nvcompressFound )
+        sourceImages.clear();
+    if( !ntcCliFound )
+        textureSets.clear();
+    if( verbose )
     {
-        if ( verbose )
-        {
-            printf( "Found %d image files. Processing...\n", static_cast<int>( sourceImages.size() ) );
-        }
-
-        // Sometimes nvcompress can fail due to insufficient device
-        // memory if too many threads are in flight. Try each conversion
-        // several times, reducing the number of threads on each pass.
-
-        const int numPasses = 4;
-        int passThreads[numPasses] = {numThreads, 3, 1, 1};
-        unsigned int conversionCount = 0;
-
-        for( int pass = 0; pass < numPasses; ++pass )
-        {
-            omp_set_num_threads( passThreads[pass] );
-            #pragma omp parallel for schedule(dynamic)
-            for( unsigned int i = 0; i < sourceImages.size(); ++i )
-            {
-                std::string outputImage = cacheManager.getCacheFilePath( sourceImages[i], ".dds" );
-                bool outFileExists = fs::exists( outputImage );
-                bool doPrint = verbose && ( !outFileExists || ( pass == 0 ) );
-
-                if( doPrint )
-                    printf( "Converting: \"%s\" ==> \"%s\"\n", sourceImages[i].c_str(), outputImage.c_str() );
-
-                if( outFileExists )
-                {
-                    if( pass == 0 )
-                    conversionCount++;
-                }
-                else
-                {
-                    if( cacheManager.cacheFileAsDDS( sourceImages[i], idx % numCudaDevices ) )
-                        conversionCount++;
-                    else if( verbose )
-                        printf( "GPU busy converting %s. Will retry.\n", outputImage.c_str() );
-                }
-            }
-
-            // Turn off verbose printing after first pass.
-            verbose = false;
-
-            // Check if all the conversions are done.
-            if( conversionCount >= sourceImages.size() )
-                break;
-        }
-
-        if( conversionCount != sourceImages.size() )
-        {
-            std::cerr << "Error: Failed to convert all source images.\n";
-            printUsage( argv[0] );
-        }
+        printf( "Found %d image files and %d texture sets. Processing...\n", static_cast<int>( sourceImages.size() ),
+                static_cast<int>( textureSets.size() ) );
     }
 
-    // Convert the texture sets to NTC.
-    if( ntcCliFound )
-    {
-        if( verbose )
-        {
-            printf( "Found %d texture sets. Processing...\n", static_cast<int>( textureSets.size() ) );
-        }
-
-        unsigned int conversionCount = 0;
+    CompressedTextureCacheResults results = cacheManager.cacheFiles( sourceImages, textureSets, numCudaDevices );
+    if( verbose )
+        printf( "Converted %u files, skipped %u unchanged files.\n", results.numConverted, results.numSkipped );
 
-        omp_set_num_threads( numThreads );
-        #pragma omp parallel for schedule(dynamic)
-        for( const auto& textureSet : textureSets )
-        {
-            std::string outputImage = cacheManager.getCacheFilePath( textureSet[0], "" );
-            bool outFileExists = fs::exists( outputImage );
-            bool doPrint = verbose && !outFileExists;
-            if( doPrint )
-                printf( "Compressing texture set: \"%s\"\n", outputImage.c_str() );
-            else if( verbose )
-                printf( "Skipping existing texture set \"%s\".\n", outputImage.c_str() );
-
-            if( outFileExists )
-            {
-                conversionCount++;
-            }
-            else
-            {
-                if( cacheManager.cacheTextureSetAsNtc( textureSet, idx % numCudaDevices ) )
-                    conversionCount++;
-                else
-                    printf( "Error: Compressing texture set \"%s\" failed.\n", outputImage.c_str() );
-            }
-        }
-
-        if( conversionCount != textureSets.size() )
-        {
-            std::cerr << "Error: Failed to convert all texture sets.\n";
-            printUsage( argv[0] );
-        }
+    if( !results.failedFiles.empty() )
+    {
+        for( const std::string& failedFile : results.failedFiles )
+            std::cerr << "Error: Failed to make \"" << failedFile << "\".\n";
+        printUsage( argv[0] );
     }
 
     return 0;
@@ -1,10 +1,11 @@
-// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #include "DemandPbrtScene/DeviceTriangles.h"
 #include "DemandPbrtScene/Params.h"
 #include "DemandPbrtScene/PhongShade.h"
+#include "DemandPbrtScene/VertexAttributes.h"
 
 #include <OptiXToolkit/DemandLoading/Texture2D.h>
 #include <OptiXToolkit/ShaderUtil/ray_cone.h>
@@ -690,10 +691,10 @@ __device__ __forceinline__ float2 adjustUV( float2 uv )
     return make_float2( uv.x, 1.f - uv.y );
 }
 
-__device__ __forceinline__ float2 interpolateUVs( const TriangleUVs& uv )
+__device__ __forceinline__ float2 interpolateUVs( const float2 ( &uv )[3] )
 {
     const float2 bc = optixGetTriangleBarycentrics();
-    return adjustUV( uv.UV[0] ) * ( 1.0f - bc.x - bc.y ) + adjustUV( uv.UV[1] ) * bc.x + adjustUV( uv.UV[2] ) * bc.y;
+    return adjustUV( uv[0] ) * ( 1.0f - bc.x - bc.y ) + adjustUV( uv[1] ) * bc.x + adjustUV( uv[2] ) * bc.y;
 }
 
 __device__ __forceinline__ uint_t getPartialAlphaTextureId()
@@ -725,7 +726,7 @@ __device__ __forceinline__ uint_t getPartialAlphaTextureId()
     return alphaTextureId;
 }
 
-__device__ __forceinline__ float2 getTriangleUVs( TriangleUVs** uvs, const uint_t index )
+__device__ __forceinline__ float2 getTriangleUVs( IndexedUVs** uvs, const uint_t index )
 {
 #ifndef NDEBUG
     static const float2 zero{};
@@ -735,15 +736,17 @@ __device__ __forceinline__ float2 getTriangleUVs( TriangleUVs** uvs, const uint_
         return zero;
     }
 #endif
-    const TriangleUVs* triangleUVs = uvs[index];
+    const IndexedUVs* indexedUVs = uvs[index];
 #ifndef NDEBUG
-    if( triangleUVs == nullptr )
+    if( indexedUVs == nullptr )
     {
         printf( "Parameters uvs array for material %u is nullptr!\n", index );
         return zero;
     }
 #endif
-    return interpolateUVs( triangleUVs[optixGetPrimitiveIndex()] );
+    float2 triangleUVs[3];
+    fetchVertexUVs( *indexedUVs, optixGetPrimitiveIndex(), triangleUVs );
+    return interpolateUVs( triangleUVs );
 }
 
 
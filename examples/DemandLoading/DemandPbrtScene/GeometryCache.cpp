@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -7,9 +7,13 @@
 #include "DemandPbrtScene/Conversions.h"
 #include "DemandPbrtScene/MaterialAdapters.h"
 #include "DemandPbrtScene/Stopwatch.h"
+#include "DemandPbrtScene/VertexAttributes.h"
 
 #include <OptiXToolkit/Error/ErrorCheck.h>
+#include <OptiXToolkit/Error/cuErrorCheck.h>
+#include <OptiXToolkit/Error/cudaErrorCheck.h>
 #include <OptiXToolkit/Error/optixErrorCheck.h>
+#include <OptiXToolkit/Memory/DeviceBuffer.h>
 #include <OptiXToolkit/Memory/SyncVector.h>
 #include <OptiXToolkit/PbrtSceneLoader/MeshReader.h>
 
@@ -17,7 +21,13 @@
 #include <chrono>
 #include <cstdint>
 #include <filesystem>
+#include <iomanip>
 #include <iterator>
+#include <list>
+#include <map>
+#include <sstream>
+#include <utility>
+#include <vector>
 
 using namespace otk::pbrt;
 
@@ -64,16 +74,65 @@ static std::string objectPrimitiveCacheKey( const ObjectDefinition& object, Geom
     return "object." + object.name + '.' + toString( primitive ) + '.' + materialFlagsToString( flags );
 }
 
+// FNV-1a hash of the bytes of the elements of a vector.
+template <typename T>
+static std::uint64_t hashElements( std::uint64_t hash, const std::vector<T>& values )
+{
+    const auto* bytes{ reinterpret_cast<const unsigned char*>( values.data() ) };
+    for( size_t i = 0; i < values.size() * sizeof( T ); ++i )
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static std::string triangleMeshCacheKey( const TriangleMeshData& mesh )
+{
+    std::uint64_t hash{ 0xcbf29ce484222325ULL };
+    hash = hashElements( hash, mesh.indices );
+    hash = hashElements( hash, mesh.points );
+    hash = hashElements( hash, mesh.normals );
+    hash = hashElements( hash, mesh.uvs );
+    std::ostringstream key;
+    key << "triangleMesh." << mesh.indices.size() << '.' << mesh.points.size() << '.' << mesh.normals.size() << '.'
+        << mesh.uvs.size() << '.' << std::hex << std::setw( 16 ) << std::setfill( '0' ) << hash;
+    return key.str();
+}
+
+static bool equalTriangleMeshes( const TriangleMeshData& lhs, const TriangleMeshData& rhs )
+{
+    return lhs.indices == rhs.indices && lhs.points == rhs.points && lhs.normals == rhs.normals && lhs.uvs == rhs.uvs;
+}
+
+static std::string sphereCacheKey( const SphereData& sphere )
+{
+    std::ostringstream key;
+    key << "sphere." << std::hexfloat << sphere.radius;
+    return key.str();
+}
+
+// Allocate a device buffer for the host elements and copy them to it asynchronously on the stream.
+template <typename T>
+static otk::DeviceBuffer copyToNewDeviceBufferAsync( const T* elements, size_t count, CUstream stream )
+{
+    otk::DeviceBuffer buffer( count * sizeof( T ) );
+    OTK_ERROR_CHECK( cudaMemcpyAsync( buffer.devicePtr(), elements, buffer.size(), cudaMemcpyHostToDevice, stream ) );
+    return buffer;
+}
+
 namespace {
 
 class GeometryCacheImpl : public GeometryCache
 {
   public:
-    GeometryCacheImpl( FileSystemInfoPtr fileSystemInfo )
+    GeometryCacheImpl( FileSystemInfoPtr fileSystemInfo, unsigned long long maxDeviceMemory, bool quantizeAttributes )
         : m_fileSystemInfo( std::move( fileSystemInfo ) )
+        , m_maxDeviceMemory( maxDeviceMemory )
+        , m_quantizeAttributes( quantizeAttributes )
     {
     }
-    ~GeometryCacheImpl() override = default;
+    ~GeometryCacheImpl() override;
 
     GeometryCacheEntry getShape( OptixDeviceContext context, CUstream stream, const ShapeDefinition& shape ) override;
 
@@ -84,36 +143,89 @@ class GeometryCacheImpl : public GeometryCache
                                   GeometryPrimitive       primitive,
                                   MaterialFlags           flags ) override;
 
+    void releaseEntry( const GeometryCacheEntry& entry ) override;
+
     GeometryCacheStatistics getStatistics() const override { return m_stats; }
 
   private:
-    GeometryCacheEntry cacheGeometry( const std::string& key, GeometryCacheEntry entry );
+    struct CacheRecord
+    {
+        GeometryCacheEntry               entry;
+        std::vector<otk::DeviceBuffer>   buffers;      // device memory held by the entry
+        unsigned long long               sizeInBytes;  // total size of buffers
+        unsigned int                     refCount;     // outstanding references returned to callers
+        std::list<std::string>::iterator lruPosition;  // position of the key in m_lruKeys
+        TriangleMeshData                 triangleMesh;  // contents of a triangle mesh, whose key only holds a hash
+    };
+
+    // Device copies of the vertex attributes of a triangle GAS.
+    struct DeviceAttributes
+    {
+        std::vector<otk::DeviceBuffer> buffers;
+        IndexedNormals*                normals{};
+        IndexedUVs*                    uvs{};
+    };
+
+    const GeometryCacheEntry* findGeometry( const std::string& key );
+    GeometryCacheEntry cacheGeometry( const std::string& key, GeometryCacheEntry entry, std::vector<otk::DeviceBuffer> buffers );
+    void               evictUnreferencedGeometry();
     GeometryCacheEntry getPlyMesh( OptixDeviceContext context, CUstream stream, const PlyMeshData& plyMesh );
     GeometryCacheEntry getTriangleMesh( OptixDeviceContext context, CUstream stream, const TriangleMeshData& mesh );
     GeometryCacheEntry getSphere( OptixDeviceContext context, CUstream stream, const SphereData& sphere );
-    GeometryCacheEntry buildTriangleGAS( OptixDeviceContext context, CUstream stream );
-    GeometryCacheEntry buildSphereGAS( OptixDeviceContext context, CUstream stream );
-    GeometryCacheEntry buildGAS( OptixDeviceContext     context,
+    GeometryCacheEntry buildTriangleGAS( const std::string& key, OptixDeviceContext context, CUstream stream );
+    GeometryCacheEntry buildSphereGAS( const std::string& key, OptixDeviceContext context, CUstream stream );
+    GeometryCacheEntry buildGAS( const std::string&     key,
+                                 OptixDeviceContext     context,
                                  CUstream               stream,
                                  GeometryPrimitive      primitive,
-                                 TriangleNormals*       normals,
-                                 TriangleUVs*           uvs,
+                                 DeviceAttributes       attributes,
                                  const OptixBuildInput& build );
+    DeviceAttributes   copyAttributesToDeviceAsync( CUstream stream );
+    void               createBuildResources();
+    void               clearBuildInputs( CUstream stream );
     void               appendPlyMesh( const pbrt::Transform& transform, const PlyMeshData& plyMesh );
     void               appendTriangleMesh( const pbrt::Transform& transform, const TriangleMeshData& mesh );
     void               appendSphere( const pbrt::Transform& transform, const SphereData& sphereData );
 
-    FileSystemInfoPtr                         m_fileSystemInfo;
-    std::map<std::string, GeometryCacheEntry> m_geomCache;
-    otk::SyncVector<float3>                   m_vertices;
-    otk::SyncVector<std::uint32_t>            m_indices;
-    otk::SyncVector<float>                    m_radii;
-    otk::SyncVector<TriangleNormals>          m_normals;
-    otk::SyncVector<TriangleUVs>              m_uvs;
-    std::vector<uint_t>                       m_primitiveGroupEndIndices;
-    GeometryCacheStatistics                   m_stats{};
+    FileSystemInfoPtr                  m_fileSystemInfo;
+    unsigned long long                 m_maxDeviceMemory;
+    bool                               m_quantizeAttributes;
+    std::map<std::string, CacheRecord> m_geomCache;
+    std::map<CUdeviceptr, std::string> m_accelBufferKeys;
+    std::list<std::string>             m_lruKeys;  // most recently used first
+    otk::SyncVector<float3>            m_vertices;
+    otk::SyncVector<std::uint32_t>     m_indices;
+    otk::SyncVector<float>             m_radii;
+    // Vertex attributes parallel to m_vertices; vertices of shapes without the attribute hold zero.
+    // The host data, including quantized copies, is staged in members so that it remains valid
+    // until it has been copied to the device, which clearBuildInputs waits for.
+    std::vector<float3>                m_normals;
+    std::vector<float2>                m_uvs;
+    std::vector<uint_t>                m_octNormals;
+    std::vector<ushort2>               m_quantizedUVs;
+    IndexedNormals                     m_indexedNormals{};
+    IndexedUVs                         m_indexedUVs{};
+    std::vector<uint_t>                m_primitiveGroupEndIndices;
+    GeometryCacheStatistics            m_stats{};
+    // Build resources, created on the first build.  The temp buffer only grows, so builds rarely
+    // free device memory, which would wait for the device.
+    otk::DeviceBuffer                  m_buildTemp;
+    otk::DeviceBuffer                  m_compactedSize;
+    std::uint64_t*                     m_hostCompactedSize{};  // pinned, so the copy can complete asynchronously
+    CUevent                            m_uploadsDone{};        // the staged host data has been copied to the device
+    CUevent                            m_buildDone{};          // the last build has finished with its inputs
 };
 
+GeometryCacheImpl::~GeometryCacheImpl()
+{
+    if( m_uploadsDone != nullptr )
+    {
+        OTK_ERROR_CHECK_NOTHROW( cuEventDestroy( m_uploadsDone ) );
+        OTK_ERROR_CHECK_NOTHROW( cuEventDestroy( m_buildDone ) );
+        OTK_ERROR_CHECK_NOTHROW( cuMemFreeHost( m_hostCompactedSize ) );
+    }
+}
+
 GeometryCacheEntry GeometryCacheImpl::getShape( OptixDeviceContext context, CUstream stream, const ShapeDefinition& shape )
 {
     if( shape.type == SHAPE_TYPE_PLY_MESH )
@@ -136,16 +248,12 @@ GeometryCacheEntry GeometryCacheImpl::getObject( OptixDeviceContext      context
                                                  MaterialFlags           flags )
 {
     const std::string cacheKey{ objectPrimitiveCacheKey( object, primitive, flags ) };
-    if( const auto it{ m_geomCache.find( cacheKey ) }; it != m_geomCache.end() )
+    if( const GeometryCacheEntry* cached{ findGeometry( cacheKey ) } )
     {
-        return it->second;
+        return *cached;
     }
 
-    m_vertices.clear();
-    m_indices.clear();
-    m_normals.clear();
-    m_uvs.clear();
-    m_primitiveGroupEndIndices.clear();
+    clearBuildInputs( stream );
 
     switch( primitive )
     {
@@ -164,7 +272,7 @@ GeometryCacheEntry GeometryCacheImpl::getObject( OptixDeviceContext      context
                     }
                 }
             }
-            return cacheGeometry( cacheKey, buildTriangleGAS( context, stream ) );
+            return buildTriangleGAS( cacheKey, context, stream );
 
         case GeometryPrimitive::SPHERE:
             for( const ShapeDefinition& shape : shapes )
@@ -174,7 +282,7 @@ GeometryCacheEntry GeometryCacheImpl::getObject( OptixDeviceContext      context
                     appendSphere( shape.transform, shape.sphere );
                 }
             }
-            return cacheGeometry( cacheKey, buildSphereGAS( context, stream ) );
+            return buildSphereGAS( cacheKey, context, stream );
 
         case GeometryPrimitive::NONE:
             break;
@@ -183,61 +291,166 @@ GeometryCacheEntry GeometryCacheImpl::getObject( OptixDeviceContext      context
     throw std::runtime_error( "Unknown primitive type " + toString( primitive ) );
 }
 
-GeometryCacheEntry GeometryCacheImpl::cacheGeometry( const std::string& key, GeometryCacheEntry entry )
+const GeometryCacheEntry* GeometryCacheImpl::findGeometry( const std::string& key )
 {
-    m_geomCache[key] = entry;
+    const auto it{ m_geomCache.find( key ) };
+    if( it == m_geomCache.end() )
+    {
+        return nullptr;
+    }
+
+    CacheRecord& record{ it->second };
+    ++record.refCount;
+    m_lruKeys.splice( m_lruKeys.begin(), m_lruKeys, record.lruPosition );
+    ++m_stats.numCacheHits;
+    return &record.entry;
+}
+
+GeometryCacheEntry GeometryCacheImpl::cacheGeometry( const std::string& key, GeometryCacheEntry entry, std::vector<otk::DeviceBuffer> buffers )
+{
+    unsigned long long sizeInBytes{};
+    for( const otk::DeviceBuffer& buffer : buffers )
+    {
+        sizeInBytes += buffer.size();
+    }
+    m_lruKeys.push_front( key );
+    m_geomCache[key]                     = CacheRecord{ entry, std::move( buffers ), sizeInBytes, 1U, m_lruKeys.begin(), {} };
+    m_accelBufferKeys[entry.accelBuffer] = key;
+    ++m_stats.numCacheMisses;
+    m_stats.deviceMemoryUsed += sizeInBytes;
+    evictUnreferencedGeometry();
     return entry;
 }
 
+void GeometryCacheImpl::releaseEntry( const GeometryCacheEntry& entry )
+{
+    const auto key{ m_accelBufferKeys.find( entry.accelBuffer ) };
+    if( key == m_accelBufferKeys.end() )
+    {
+        throw std::runtime_error( "Released geometry is not in the geometry cache" );
+    }
+    CacheRecord& record{ m_geomCache[key->second] };
+    if( record.refCount == 0 )
+    {
+        throw std::runtime_error( "Released unreferenced geometry " + key->second );
+    }
+    --record.refCount;
+    evictUnreferencedGeometry();
+}
+
+void GeometryCacheImpl::evictUnreferencedGeometry()
+{
+    if( m_maxDeviceMemory == 0 )
+    {
+        return;
+    }
+
+    // Walk from the least recently used entry, freeing unreferenced entries until we are within budget.
+    auto pos{ m_lruKeys.end() };
+    while( m_stats.deviceMemoryUsed > m_maxDeviceMemory && pos != m_lruKeys.begin() )
+    {
+        --pos;
+        const auto it{ m_geomCache.find( *pos ) };
+        const CacheRecord& record{ it->second };
+        if( record.refCount > 0 )
+        {
+            continue;
+        }
+
+        m_stats.deviceMemoryUsed -= record.sizeInBytes;
+        ++m_stats.numEvictions;
+        m_accelBufferKeys.erase( record.entry.accelBuffer );
+        m_geomCache.erase( it );
+        pos = m_lruKeys.erase( pos );
+    }
+}
+
 GeometryCacheEntry GeometryCacheImpl::getPlyMesh( OptixDeviceContext context, CUstream stream, const PlyMeshData& plyMesh )
 {
     const std::string cacheKey{ plyMeshCacheKey( plyMesh ) };
-    if( const auto it{ m_geomCache.find( cacheKey ) }; it != m_geomCache.end() )
+    if( const GeometryCacheEntry* cached{ findGeometry( cacheKey ) } )
     {
-        return it->second;
+        return *cached;
     }
 
-    m_vertices.clear();
-    m_indices.clear();
-    m_normals.clear();
-    m_uvs.clear();
-    m_primitiveGroupEndIndices.clear();
+    clearBuildInputs( stream );
     appendPlyMesh( pbrt::Transform(), plyMesh );
-    return cacheGeometry( cacheKey, buildTriangleGAS( context, stream ) );
+    return buildTriangleGAS( cacheKey, context, stream );
 }
 
 GeometryCacheEntry GeometryCacheImpl::getTriangleMesh( OptixDeviceContext context, CUstream stream, const TriangleMeshData& triangleMesh )
 {
-    // TODO: implement a cache for trianglemesh shapes?
-    m_vertices.clear();
-    m_indices.clear();
-    m_normals.clear();
-    m_uvs.clear();
-    m_primitiveGroupEndIndices.clear();
+    // A cached mesh with the same hash is only used if its contents are equal; meshes whose hashes
+    // collide are cached under the hash key with a collision count appended.
+    const std::string hashKey{ triangleMeshCacheKey( triangleMesh ) };
+    std::string       cacheKey{ hashKey };
+    for( unsigned int collisions = 1;; ++collisions )
+    {
+        const auto it{ m_geomCache.find( cacheKey ) };
+        if( it == m_geomCache.end() )
+        {
+            break;
+        }
+        if( equalTriangleMeshes( it->second.triangleMesh, triangleMesh ) )
+        {
+            return *findGeometry( cacheKey );
+        }
+        cacheKey = hashKey + '.' + std::to_string( collisions );
+    }
+
+    clearBuildInputs( stream );
     appendTriangleMesh( pbrt::Transform(), triangleMesh );
-    return buildTriangleGAS( context, stream );
+    const GeometryCacheEntry entry{ buildTriangleGAS( cacheKey, context, stream ) };
+    m_geomCache[cacheKey].triangleMesh = triangleMesh;
+    return entry;
 }
 
-GeometryCacheEntry GeometryCacheImpl::buildGAS( OptixDeviceContext     context,
+GeometryCacheEntry GeometryCacheImpl::buildGAS( const std::string&     key,
+                                                OptixDeviceContext     context,
                                                 CUstream               stream,
                                                 GeometryPrimitive      primitive,
-                                                TriangleNormals*       normals,
-                                                TriangleUVs*           uvs,
+                                                DeviceAttributes       attributes,
                                                 const OptixBuildInput& build )
 {
+    // Compaction waits for the build to emit its compacted size before the entry can be returned,
+    // so small GASes, for which compaction saves little, are built without it and not waited for.
+    const unsigned int numPrimitives{ primitive == GeometryPrimitive::TRIANGLE ? build.triangleArray.numIndexTriplets :
+                                                                                 build.sphereArray.numVertices };
+    const bool             compact{ numPrimitives >= MIN_COMPACTED_GAS_PRIMITIVES };
     OptixAccelBuildOptions options{};
-    options.buildFlags = OPTIX_BUILD_FLAG_ALLOW_RANDOM_VERTEX_ACCESS;
+    options.buildFlags = OPTIX_BUILD_FLAG_ALLOW_RANDOM_VERTEX_ACCESS | ( compact ? OPTIX_BUILD_FLAG_ALLOW_COMPACTION : 0U );
     options.operation  = OPTIX_BUILD_OPERATION_BUILD;
     OptixAccelBufferSizes sizes{};
     OTK_ERROR_CHECK( optixAccelComputeMemoryUsage( context, &options, &build, 1, &sizes ) );
 
-    otk::DeviceBuffer temp;
-    temp.resize( sizes.tempSizeInBytes );
+    createBuildResources();
+    m_buildTemp.resize( sizes.tempSizeInBytes );
     otk::DeviceBuffer output;
     output.resize( sizes.outputSizeInBytes );
+    OptixAccelEmitDesc emitted{};
+    emitted.type   = OPTIX_PROPERTY_TYPE_COMPACTED_SIZE;
+    emitted.result = m_compactedSize;
+    OTK_ERROR_CHECK( cuEventRecord( m_uploadsDone, stream ) );
     OptixTraversableHandle traversable{};
-    OTK_ERROR_CHECK( optixAccelBuild( context, stream, &options, &build, 1, temp, temp.size(), output, output.size(),
-                                      &traversable, nullptr, 0 ) );
+    OTK_ERROR_CHECK( optixAccelBuild( context, stream, &options, &build, 1, m_buildTemp, m_buildTemp.size(), output,
+                                      output.size(), &traversable, compact ? &emitted : nullptr, compact ? 1U : 0U ) );
+
+    if( compact )
+    {
+        OTK_ERROR_CHECK( cudaMemcpyAsync( m_hostCompactedSize, m_compactedSize.devicePtr(), sizeof( std::uint64_t ),
+                                          cudaMemcpyDeviceToHost, stream ) );
+        OTK_ERROR_CHECK( cuEventRecord( m_buildDone, stream ) );
+        OTK_ERROR_CHECK( cuEventSynchronize( m_buildDone ) );
+        if( *m_hostCompactedSize < output.size() )
+        {
+            otk::DeviceBuffer compacted;
+            compacted.resize( *m_hostCompactedSize );
+            OTK_ERROR_CHECK( optixAccelCompact( context, stream, traversable, compacted, compacted.size(), &traversable ) );
+            m_stats.compactionBytesSaved += output.size() - compacted.size();
+            output = std::move( compacted );
+        }
+    }
+    OTK_ERROR_CHECK( cuEventRecord( m_buildDone, stream ) );
 #ifndef NDEBUG
     OTK_CUDA_SYNC_CHECK();
 #endif
@@ -249,15 +462,114 @@ GeometryCacheEntry GeometryCacheImpl::buildGAS( OptixDeviceContext     context,
             break;
         case GeometryPrimitive::TRIANGLE:
             m_stats.numTriangles += build.triangleArray.numIndexTriplets;
-            m_stats.numNormals += static_cast<unsigned int>( m_normals.size() * VERTS_PER_TRI );
-            m_stats.numUVs += static_cast<unsigned int>( m_uvs.size() * VERTS_PER_TRI );
+            m_stats.numNormals += static_cast<unsigned int>( m_normals.size() );
+            m_stats.numUVs += static_cast<unsigned int>( m_uvs.size() );
             break;
         case GeometryPrimitive::SPHERE:
             m_stats.numSpheres += build.sphereArray.numVertices;
             break;
     }
 
-    return { output.detach(), traversable, primitive, normals, uvs, m_primitiveGroupEndIndices };
+    const GeometryCacheEntry entry{ output, traversable, primitive, attributes.normals, attributes.uvs, m_primitiveGroupEndIndices };
+    attributes.buffers.push_back( std::move( output ) );
+    return cacheGeometry( key, entry, std::move( attributes.buffers ) );
+}
+
+void GeometryCacheImpl::createBuildResources()
+{
+    if( m_uploadsDone != nullptr )
+    {
+        return;
+    }
+    OTK_ERROR_CHECK( cuEventCreate( &m_uploadsDone, CU_EVENT_DISABLE_TIMING ) );
+    OTK_ERROR_CHECK( cuEventCreate( &m_buildDone, CU_EVENT_DISABLE_TIMING ) );
+    OTK_ERROR_CHECK( cuMemAllocHost( reinterpret_cast<void**>( &m_hostCompactedSize ), sizeof( std::uint64_t ) ) );
+    m_compactedSize.resize( sizeof( std::uint64_t ) );
+}
+
+void GeometryCacheImpl::clearBuildInputs( CUstream stream )
+{
+    // Builds are not waited for, so the previous build may still be copying the staged host data,
+    // and reading the build inputs and temp buffer, possibly on another stream.
+    if( m_uploadsDone != nullptr )
+    {
+        OTK_ERROR_CHECK( cuEventSynchronize( m_uploadsDone ) );
+        OTK_ERROR_CHECK( cuStreamWaitEvent( stream, m_buildDone, 0 ) );
+    }
+    m_vertices.clear();
+    m_indices.clear();
+    m_radii.clear();
+    m_normals.clear();
+    m_uvs.clear();
+    m_primitiveGroupEndIndices.clear();
+}
+
+GeometryCacheImpl::DeviceAttributes GeometryCacheImpl::copyAttributesToDeviceAsync( CUstream stream )
+{
+    DeviceAttributes result;
+    if( m_normals.empty() && m_uvs.empty() )
+    {
+        return result;
+    }
+
+    // The attributes are looked up through the triangle indices, so the entry keeps its own copy
+    // of the index buffer; the build input index buffer is reused by the next build.
+    static_assert( sizeof( uint3 ) == VERTS_PER_TRI * sizeof( std::uint32_t ), "uint3 must alias three indices" );
+    result.buffers.push_back( copyToNewDeviceBufferAsync( &m_indices[0], m_indices.size(), stream ) );
+    const uint3* indices{ static_cast<const uint3*>( result.buffers.back().devicePtr() ) };
+
+    if( !m_normals.empty() )
+    {
+        m_normals.resize( m_vertices.size() );
+        m_indexedNormals = IndexedNormals{ indices, nullptr, nullptr };
+        if( m_quantizeAttributes )
+        {
+            m_octNormals.resize( m_normals.size() );
+            std::transform( m_normals.begin(), m_normals.end(), m_octNormals.begin(),
+                            []( const float3& normal ) { return encodeOctahedralNormal( normal ); } );
+            result.buffers.push_back( copyToNewDeviceBufferAsync( m_octNormals.data(), m_octNormals.size(), stream ) );
+            m_indexedNormals.octNormals = static_cast<const uint_t*>( result.buffers.back().devicePtr() );
+        }
+        else
+        {
+            result.buffers.push_back( copyToNewDeviceBufferAsync( m_normals.data(), m_normals.size(), stream ) );
+            m_indexedNormals.normals = static_cast<const float3*>( result.buffers.back().devicePtr() );
+        }
+        result.buffers.push_back( copyToNewDeviceBufferAsync( &m_indexedNormals, 1, stream ) );
+        result.normals = static_cast<IndexedNormals*>( result.buffers.back().devicePtr() );
+    }
+
+    if( !m_uvs.empty() )
+    {
+        m_uvs.resize( m_vertices.size() );
+        m_indexedUVs = IndexedUVs{ indices, nullptr, nullptr, make_float2( 0.0f, 0.0f ), make_float2( 0.0f, 0.0f ) };
+        if( m_quantizeAttributes )
+        {
+            float2 uvMin{ m_uvs[0] };
+            float2 uvMax{ m_uvs[0] };
+            for( const float2& uv : m_uvs )
+            {
+                uvMin = make_float2( std::min( uvMin.x, uv.x ), std::min( uvMin.y, uv.y ) );
+                uvMax = make_float2( std::max( uvMax.x, uv.x ), std::max( uvMax.y, uv.y ) );
+            }
+            m_indexedUVs.uvMin   = uvMin;
+            m_indexedUVs.uvScale = quantizedUVScale( uvMin, uvMax );
+            m_quantizedUVs.resize( m_uvs.size() );
+            std::transform( m_uvs.begin(), m_uvs.end(), m_quantizedUVs.begin(),
+                            [&]( const float2& uv ) { return quantizeUV( uv, uvMin, m_indexedUVs.uvScale ); } );
+            result.buffers.push_back( copyToNewDeviceBufferAsync( m_quantizedUVs.data(), m_quantizedUVs.size(), stream ) );
+            m_indexedUVs.quantizedUVs = static_cast<const ushort2*>( result.buffers.back().devicePtr() );
+        }
+        else
+        {
+            result.buffers.push_back( copyToNewDeviceBufferAsync( m_uvs.data(), m_uvs.size(), stream ) );
+            m_indexedUVs.uvs = static_cast<const float2*>( result.buffers.back().devicePtr() );
+        }
+        result.buffers.push_back( copyToNewDeviceBufferAsync( &m_indexedUVs, 1, stream ) );
+        result.uvs = static_cast<IndexedUVs*>( result.buffers.back().devicePtr() );
+    }
+
+    return result;
 }
 
 template <typename Container>
@@ -292,7 +604,9 @@ void GeometryCacheImpl::appendPlyMesh( const pbrt::Transform& transform, const P
                     [=]( int index ) { return static_cast<std::uint32_t>( index + indexOffset ); } );
     m_primitiveGroupEndIndices.push_back( containerSize( m_indices ) / VERTS_PER_TRI );
 
-    const size_t numTriangles{ buffers.indices.size() / VERTS_PER_TRI };
+    // The closest hit program looks up vertex attributes through the index buffer of the GAS,
+    // so they are stored per vertex as in the PLY file.  Vertices of earlier shapes without
+    // the attribute are padded with zero to keep the attributes parallel to the vertices.
     if( meshInfo.numNormals > 0 )
     {
         if( meshInfo.numNormals != meshInfo.numVertices )
@@ -301,25 +615,13 @@ void GeometryCacheImpl::appendPlyMesh( const pbrt::Transform& transform, const P
                                       + std::to_string( meshInfo.numNormals ) );
         }
 
-        // When building the GAS, we have the luxury of supplying the vertex array and the
-        // index array, but in the closest hit program, we only have the primitive index,
-        // not the vertex/normal index.  So we size the array of TriangleNormals structures
-        // to the number of primitives and use the index array to select the appropriate normal
-        // for each vertex.
-        //
-        growContainer( m_normals, numTriangles );
-        for( size_t face = 0; face < numTriangles; ++face )
+        m_normals.resize( indexOffset );
+        growContainer( m_normals, meshInfo.numVertices );
+        for( int i = 0; i < meshInfo.numVertices; ++i )
         {
-            TriangleNormals normals;
-            for( size_t vert = 0; vert < VERTS_PER_TRI; ++vert )
-            {
-                // 3 coords per vertex
-                // 3 vertices per face, 3 indices per face
-                const int idx{ buffers.indices[face * VERTS_PER_TRI + vert] * 3 };
-                normals.N[vert] = make_float3( buffers.normalCoords[idx + 0], buffers.normalCoords[idx + 1],
-                                               buffers.normalCoords[idx + 2] );
-            }
-            m_normals.push_back( normals );
+            // 3 coords per vertex
+            m_normals.push_back( make_float3( buffers.normalCoords[i * 3 + 0], buffers.normalCoords[i * 3 + 1],
+                                              buffers.normalCoords[i * 3 + 2] ) );
         }
     }
 
@@ -331,23 +633,12 @@ void GeometryCacheImpl::appendPlyMesh( const pbrt::Transform& transform, const P
                                       + " vertex texture coordinates, got " + std::to_string( meshInfo.numTextureCoordinates ) );
         }
 
-        // When building the GAS, we have the luxury of supplying the vertex array and the
-        // index array, but in the closest hit program, we only have the primitive index,
-        // not the vertex/normal/uv index.  So we size the array of TriangleUVs structures
-        // to the number of primitives and use the index array to select the appropriate normal
-        // for each vertex.
-        growContainer( m_uvs, numTriangles );
-        for( size_t face = 0; face < numTriangles; ++face )
+        m_uvs.resize( indexOffset );
+        growContainer( m_uvs, meshInfo.numVertices );
+        for( int i = 0; i < meshInfo.numVertices; ++i )
         {
-            TriangleUVs uvs;
-            for( size_t vert = 0; vert < VERTS_PER_TRI; ++vert )
-            {
-                // 2 coords per vertex
-                // 3 vertices per face, 3 indices per face
-                const int idx{ buffers.indices[face * VERTS_PER_TRI + vert] * 2 };
-                uvs.UV[vert] = make_float2( buffers.uvCoords[idx + 0], buffers.uvCoords[idx + 1] );
-            }
-            m_uvs.push_back( uvs );
+            // 2 coords per vertex
+            m_uvs.push_back( make_float2( buffers.uvCoords[i * 2 + 0], buffers.uvCoords[i * 2 + 1] ) );
         }
     }
 }
@@ -366,38 +657,32 @@ void GeometryCacheImpl::appendTriangleMesh( const pbrt::Transform& transform, co
                     [=]( const int index ) { return static_cast<std::uint32_t>( index + indexOffset ); } );
     m_primitiveGroupEndIndices.push_back( containerSize( m_indices ) / VERTS_PER_TRI );
 
-    const size_t numTriangles{ triangleMesh.indices.size() / VERTS_PER_TRI };
+    // Vertex attributes are stored per vertex, padded with zero for vertices of earlier shapes without them.
     if( !triangleMesh.normals.empty() )
     {
-        // When building the GAS, we have the luxury of supplying the vertex array and the
-        // index array, but in the closest hit program, we only have the primitive index,
-        // not the vertex/normal index.  So we size the array of TriangleNormals structures
-        // to the number of primitives and use the index array to select the appropriate normal
-        // for each vertex.
-        growContainer( m_normals, numTriangles );
-        for( size_t i = 0; i < numTriangles; ++i )
+        if( triangleMesh.normals.size() != triangleMesh.points.size() )
         {
-            TriangleNormals normals;
-            for( int j = 0; j < VERTS_PER_TRI; ++j )
-            {
-                normals.N[j] = toFloat3( transform( triangleMesh.normals[triangleMesh.indices[i * VERTS_PER_TRI + j]] ) );
-            }
-            m_normals.push_back( normals );
+            throw std::runtime_error( "Expected " + std::to_string( triangleMesh.points.size() ) + " vertex normals, got "
+                                      + std::to_string( triangleMesh.normals.size() ) );
         }
+
+        m_normals.resize( indexOffset );
+        growContainer( m_normals, triangleMesh.normals.size() );
+        std::transform( triangleMesh.normals.begin(), triangleMesh.normals.end(), std::back_inserter( m_normals ),
+                        [&]( const pbrt::Point3f& normal ) { return toFloat3( transform( normal ) ); } );
     }
     if( !triangleMesh.uvs.empty() )
     {
-        const auto toFloat2{ []( const pbrt::Point2f& value ) { return make_float2( value.x, value.y ); } };
-        growContainer( m_uvs, numTriangles );
-        for( size_t i = 0; i < numTriangles; ++i )
+        if( triangleMesh.uvs.size() != triangleMesh.points.size() )
         {
-            TriangleUVs uvs;
-            for( int vert = 0; vert < VERTS_PER_TRI; ++vert )
-            {
-                uvs.UV[vert] = toFloat2( triangleMesh.uvs[triangleMesh.indices[i * VERTS_PER_TRI + vert]] );
-            }
-            m_uvs.push_back( uvs );
+            throw std::runtime_error( "Expected " + std::to_string( triangleMesh.points.size() )
+                                      + " vertex texture coordinates, got " + std::to_string( triangleMesh.uvs.size() ) );
         }
+
+        const auto toFloat2{ []( const pbrt::Point2f& value ) { return make_float2( value.x, value.y ); } };
+        m_uvs.resize( indexOffset );
+        growContainer( m_uvs, triangleMesh.uvs.size() );
+        std::transform( triangleMesh.uvs.begin(), triangleMesh.uvs.end(), std::back_inserter( m_uvs ), toFloat2 );
     }
 }
 
@@ -413,7 +698,7 @@ void GeometryCacheImpl::appendSphere( const pbrt::Transform& transform, const Sp
     m_radii.push_back( scale.m[0][0] * sphere.radius ); // use X scale factor only
 }
 
-GeometryCacheEntry GeometryCacheImpl::buildSphereGAS( OptixDeviceContext context, CUstream stream )
+GeometryCacheEntry GeometryCacheImpl::buildSphereGAS( const std::string& key, OptixDeviceContext context, CUstream stream )
 {
     m_vertices.copyToDeviceAsync( stream );
     m_radii.copyToDeviceAsync( stream );
@@ -423,56 +708,55 @@ GeometryCacheEntry GeometryCacheImpl::buildSphereGAS( OptixDeviceContext context
 
     OptixBuildInputSphereArray& spheres = build.sphereArray;
 
-    CUdeviceptr vertexBuffers[]{ m_vertices.detach() };
+    CUdeviceptr vertexBuffers[]{ m_vertices };
     spheres.vertexBuffers = vertexBuffers;
     spheres.numVertices   = 1;
-    CUdeviceptr radiusBuffers[]{ m_radii.detach() };
+    CUdeviceptr radiusBuffers[]{ m_radii };
     spheres.radiusBuffers = radiusBuffers;
     spheres.singleRadius  = 1;
     const uint_t flags    = OPTIX_GEOMETRY_FLAG_NONE;
     spheres.flags         = &flags;
     spheres.numSbtRecords = 1;
 
-    return buildGAS( context, stream, GeometryPrimitive::SPHERE, nullptr, nullptr, build );
+    return buildGAS( key, context, stream, GeometryPrimitive::SPHERE, {}, build );
 }
 
 GeometryCacheEntry GeometryCacheImpl::getSphere( OptixDeviceContext context, CUstream stream, const SphereData& sphere )
 {
-    m_vertices.clear();
-    m_radii.clear();
-    m_primitiveGroupEndIndices.clear();
+    const std::string cacheKey{ sphereCacheKey( sphere ) };
+    if( const GeometryCacheEntry* cached{ findGeometry( cacheKey ) } )
+    {
+        return *cached;
+    }
+
+    clearBuildInputs( stream );
     appendSphere( pbrt::Transform(), sphere );
-    return buildSphereGAS( context, stream );
+    return buildSphereGAS( cacheKey, context, stream );
 }
 
-GeometryCacheEntry GeometryCacheImpl::buildTriangleGAS( OptixDeviceContext context, CUstream stream )
+GeometryCacheEntry GeometryCacheImpl::buildTriangleGAS( const std::string& key, OptixDeviceContext context, CUstream stream )
 {
     m_vertices.copyToDeviceAsync( stream );
     m_indices.copyToDeviceAsync( stream );
-    m_normals.copyToDevice();
-    m_uvs.copyToDevice();
+    DeviceAttributes attributes{ copyAttributesToDeviceAsync( stream ) };
 
     OptixBuildInput build{};
     build.type = OPTIX_BUILD_INPUT_TYPE_TRIANGLES;
 
     OptixBuildInputTriangleArray& triangles = build.triangleArray;
 
-    CUdeviceptr m_vertexBuffers[]{ m_vertices.detach() };
+    CUdeviceptr m_vertexBuffers[]{ m_vertices };
     triangles.vertexBuffers    = m_vertexBuffers;
     triangles.numVertices      = m_vertices.size();
     triangles.vertexFormat     = OPTIX_VERTEX_FORMAT_FLOAT3;
-    triangles.indexBuffer      = m_indices.detach();
+    triangles.indexBuffer      = m_indices;
     triangles.numIndexTriplets = m_indices.size() / VERTS_PER_TRI;
     triangles.indexFormat      = OPTIX_INDICES_FORMAT_UNSIGNED_INT3;
     const uint_t flags         = OPTIX_GEOMETRY_FLAG_NONE;
     triangles.flags            = &flags;
     triangles.numSbtRecords    = 1;
 
-    TriangleNormals* triangleNormals = m_normals.typedDevicePtr();
-    TriangleUVs*     triangleUVs     = m_uvs.typedDevicePtr();
-    static_cast<void>( m_normals.detach() );
-    static_cast<void>( m_uvs.detach() );
-    return buildGAS( context, stream, GeometryPrimitive::TRIANGLE, triangleNormals, triangleUVs, build );
+    return buildGAS( key, context, stream, GeometryPrimitive::TRIANGLE, std::move( attributes ), build );
 }
 
 class FileSystemInfoImpl : public FileSystemInfo
@@ -492,9 +776,9 @@ FileSystemInfoPtr createFileSystemInfo()
     return std::make_shared<FileSystemInfoImpl>();
 }
 
-GeometryCachePtr createGeometryCache( FileSystemInfoPtr fileSystemInfo )
+GeometryCachePtr createGeometryCache( FileSystemInfoPtr fileSystemInfo, unsigned long long maxDeviceMemory, bool quantizeAttributes )
 {
-    return std::make_shared<GeometryCacheImpl>( std::move( fileSystemInfo ) );
+    return std::make_shared<GeometryCacheImpl>( std::move( fileSystemInfo ), maxDeviceMemory, quantizeAttributes );
 }
 
 }  // namespace demandPbrtScene
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -73,7 +73,8 @@ class PbrtGeometryResolver : public GeometryResolver
 
     // Scene data
     OptixTraversableHandle          m_proxyInstanceTraversable{};
-    std::map<uint_t, SceneProxyPtr> m_sceneProxies;  // indexed by proxy geometry id
+    std::map<uint_t, SceneProxyPtr> m_sceneProxies;     // indexed by proxy geometry id
+    std::vector<SceneProxyPtr>      m_realizedProxies;  // hold the cached geometry in the scene
     bool                            m_resolveOneGeometry{};
     GeometryResolverStatistics      m_stats{};
 };
@@ -174,6 +175,9 @@ bool PbrtGeometryResolver::resolveProxyGeometry( CUstream stream, OptixDeviceCon
         // add instance to TLAS instances
         const GeometryInstance geom{ removedProxy->createGeometry( context, stream ) };
         updateNeeded = m_materialResolver->resolveMaterialForGeometry( proxyGeomId, geom, sync );
+        // The proxy holds the geometry cache's reference to the realized geometry, which stays in
+        // the scene until the resolver is destroyed.
+        m_realizedProxies.push_back( removedProxy );
         ++m_stats.numGeometriesRealized;
     }
     ++m_stats.numProxyGeometriesResolved;
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -136,6 +136,11 @@ void ImGuiUserInterface::renderGeometryCacheStatistics() const
         ImGui::Text( "UVs: %u", stats.numUVs );
         ImGui::Text( "Total bytes read: %llu", stats.totalBytesRead );
         ImGui::Text( "Total read time: %.3f secs", stats.totalReadTime );
+        ImGui::Text( "Hits: %u", stats.numCacheHits );
+        ImGui::Text( "Misses: %u", stats.numCacheMisses );
+        ImGui::Text( "Evictions: %u", stats.numEvictions );
+        ImGui::Text( "Compaction bytes saved: %llu", stats.compactionBytesSaved );
+        ImGui::Text( "Device memory used: %llu", stats.deviceMemoryUsed );
         ImGui::TreePop();
         ImGui::Spacing();
     }
@@ -149,6 +154,12 @@ void ImGuiUserInterface::renderImageCacheStatistics( const char* label, const im
         ImGui::Text( "Num tiles read: %llu", stats.totalTilesRead );
         ImGui::Text( "Num bytes read: %llu", stats.totalBytesRead );
         ImGui::Text( "Read time: %.3f secs", stats.totalReadTime );
+        ImGui::Text( "Decoded band hits: %llu", stats.decodedData.numHits );
+        ImGui::Text( "Decoded band misses: %llu", stats.decodedData.numMisses );
+        ImGui::Text( "Decoded band evictions: %llu", stats.decodedData.numEvictions );
+        ImGui::Text( "Open readers: %u", stats.numOpenReaders );
+        ImGui::Text( "Reader opens: %llu", stats.numReaderOpens );
+        ImGui::Text( "Reader closes: %llu", stats.numReaderCloses );
         ImGui::TreePop();
         ImGui::Spacing();
     }
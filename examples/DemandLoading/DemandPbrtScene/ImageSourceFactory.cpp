@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -20,11 +20,16 @@ namespace demandPbrtScene {
 using ImageSourcePtr = std::shared_ptr<imageSource::ImageSource>;
 
 namespace {
+
+// Limit the open image files, so that scenes with many textures don't exhaust file handles.
+const unsigned int MAX_OPEN_IMAGE_FILES = 256;
+
 class ImageSourceFactoryImpl : public ImageSourceFactory
 {
   public:
     ImageSourceFactoryImpl( const Options& options )
         : m_options( options )
+        , m_fileCache( MAX_OPEN_IMAGE_FILES )
     {
     }
     ~ImageSourceFactoryImpl() override = default;
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -29,6 +29,7 @@ namespace demandPbrtScene {
         "   --bg=<red>/<green>/<blue>   Set image background color; defaults to black\n"
         "   --warmup=<count>            Render <count> frames before saving to file\n"
         "   --face-forward              Flip the direction of back face normals\n"
+        "   --quantize-attributes       Store mesh normals octahedrally encoded and texture coordinates in 16 bits\n"
         "   --render-mode=<mode>        Specify the initial rendering mode, where <mode> is one of:\n"
         "                               primary     Use primary ray only (default)\n"
         "                               near        Use near ambient occlusion\n"
@@ -200,6 +201,10 @@ Options parseOptions( int argc, char* argv[], const std::function<UsageFn>& usag
         {
             options.faceForward = true;
         }
+        else if( arg == "--quantize-attributes" )
+        {
+            options.quantizeAttributes = true;
+        }
         else if( beginsWith( arg, "--render-mode=" ) )
         {
             const std::string value{ extractValue( arg ) };
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -84,6 +84,57 @@ inline uint_t proxyMaterialSbtOffsetForPrimitive( GeometryPrimitive primitive )
     throw std::runtime_error( "Unsupported primitive " + std::to_string( +primitive ) );
 }
 
+// A proxy's reference to the cached geometry it created, released when the proxy is destroyed.
+// The geometry resolver keeps realized proxies for as long as their geometry is in the scene.
+class GeometryReference
+{
+  public:
+    explicit GeometryReference( GeometryCachePtr geometryCache )
+        : m_geometryCache( std::move( geometryCache ) )
+    {
+    }
+    GeometryReference( const GeometryReference& rhs )            = delete;
+    GeometryReference& operator=( const GeometryReference& rhs ) = delete;
+    ~GeometryReference() { release(); }
+
+    const GeometryCacheEntry& getShape( OptixDeviceContext context, CUstream stream, const ShapeDefinition& shape )
+    {
+        return hold( m_geometryCache->getShape( context, stream, shape ) );
+    }
+
+    const GeometryCacheEntry& getObject( OptixDeviceContext      context,
+                                         CUstream                stream,
+                                         const ObjectDefinition& object,
+                                         const ShapeList&        shapes,
+                                         GeometryPrimitive       primitive,
+                                         MaterialFlags           flags )
+    {
+        return hold( m_geometryCache->getObject( context, stream, object, shapes, primitive, flags ) );
+    }
+
+  private:
+    GeometryCachePtr   m_geometryCache;
+    GeometryCacheEntry m_entry{};
+    bool               m_held{};
+
+    const GeometryCacheEntry& hold( GeometryCacheEntry entry )
+    {
+        release();
+        m_entry = std::move( entry );
+        m_held  = true;
+        return m_entry;
+    }
+
+    void release()
+    {
+        if( m_held )
+        {
+            m_held = false;
+            m_geometryCache->releaseEntry( m_entry );
+        }
+    }
+};
+
 class WholeSceneProxy : public SceneProxy
 {
   public:
@@ -114,7 +165,7 @@ class ShapeProxy : public SceneProxy
         : m_pageId( pageId )
         , m_scene( std::move( scene ) )
         , m_shapeIndex( shapeIndex )
-        , m_geometryCache( std::move( geometryCache ) )
+        , m_geometry( std::move( geometryCache ) )
     {
     }
     ~ShapeProxy() override = default;
@@ -141,7 +192,7 @@ class ShapeProxy : public SceneProxy
     GeometryInstance createGeometryFromShape( OptixDeviceContext context, CUstream stream, const ShapeDefinition& shape );
 
   private:
-    GeometryCachePtr               m_geometryCache;
+    GeometryReference              m_geometry;
     otk::SyncVector<float3>        m_vertices;
     otk::SyncVector<std::uint16_t> m_indices;
 };
@@ -199,7 +250,7 @@ class InstancePrimitiveProxy : public SceneProxy
 
   private:
     const Options&          m_options;
-    GeometryCachePtr        m_geometryCache;
+    GeometryReference       m_geometry;
     uint_t                  m_pageId;
     OptixAabb               m_bounds;
     SceneDescriptionPtr     m_scene;
@@ -219,7 +270,7 @@ InstancePrimitiveProxy::InstancePrimitiveProxy( const Options&      options,
                                                 GeometryPrimitive   primitive,
                                                 MaterialFlags       flags )
     : m_options( options )
-    , m_geometryCache( std::move( geometryCache ) )
+    , m_geometry( std::move( geometryCache ) )
     , m_pageId( id )
     , m_bounds( bounds )
     , m_scene( std::move( scene ) )
@@ -243,8 +294,8 @@ GeometryInstance InstancePrimitiveProxy::createGeometry( OptixDeviceContext cont
         return primitiveForType( shape.type ) == m_primitive  //
                && shapeMaterialFlags( shape ) == m_flags;
     } ) };
-    const GeometryCacheEntry result{
-        m_geometryCache->getObject( context, stream, m_scene->objects[m_name], shapes, m_primitive, m_flags ) };
+    const GeometryCacheEntry& result{
+        m_geometry.getObject( context, stream, m_scene->objects[m_name], shapes, m_primitive, m_flags ) };
     // create MaterialGroups for each shape in the GAS
     int                        i{};
     std::vector<MaterialGroup> groups;
@@ -272,7 +323,7 @@ class InstanceProxy : public SceneProxy
   public:
     InstanceProxy( const Options& options, GeometryCachePtr geometryCache, uint_t pageId, SceneDescriptionPtr scene, uint_t instanceIndex )
         : m_options( options )
-        , m_geometryCache( std::move( geometryCache ) )
+        , m_geometry( std::move( geometryCache ) )
         , m_pageId( pageId )
         , m_scene( scene )
         , m_instanceIndex( instanceIndex )
@@ -290,8 +341,8 @@ class InstanceProxy : public SceneProxy
 
   private:
     // Dependencies
-    const Options&   m_options;
-    GeometryCachePtr m_geometryCache;
+    const Options&    m_options;
+    GeometryReference m_geometry;
 
     // Proxy data
     uint_t              m_pageId;
@@ -362,7 +413,7 @@ GeometryInstance InstanceProxy::createGeometry( OptixDeviceContext context, CUst
         throw std::runtime_error( "Attempt to get geometry for decomposable proxy" );
     }
 
-    const GeometryCacheEntry result{ m_geometryCache->getObject( context, stream, m_scene->objects[m_name], shapes, primitive, flags ) };
+    const GeometryCacheEntry& result{ m_geometry.getObject( context, stream, m_scene->objects[m_name], shapes, primitive, flags ) };
     // create MaterialGroups for each shape in the GAS
     int                        i{};
     std::vector<MaterialGroup> groups;
@@ -444,7 +495,7 @@ GeometryInstance ShapeProxy::createGeometryFromShape( OptixDeviceContext context
             throw std::runtime_error( "Unsupported shape type " + shape.type );
     }
 
-    const GeometryCacheEntry entry = m_geometryCache->getShape( context, stream, shape );
+    const GeometryCacheEntry& entry = m_geometry.getShape( context, stream, shape );
     OTK_ASSERT( entry.primitiveGroupEndIndices.size() == 1U );
     return { entry.accelBuffer,                                                                             //
              primitive,                                                                                     //
@@ -1,10 +1,11 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
 #pragma once
 
 #include "DemandPbrtScene/Params.h"
+#include "DemandPbrtScene/VertexAttributes.h"
 
 #include <OptiXToolkit/DemandGeometry/DemandGeometry.h>
 #include <OptiXToolkit/ShaderUtil/DebugLocation.h>
@@ -41,22 +42,24 @@ static __device__ void getTriangleData( float3 ( &vertices )[3], float3& worldNo
     const uint_t                 sbtGASIndex{ optixGetSbtGASIndex() };
     optixGetTriangleVertexData( gas, primIdx, sbtGASIndex, 0.f, vertices );
 
+    float3 objectNormal{};
     if( params.instanceNormals != nullptr && params.instanceNormals[instanceId] != nullptr )
     {
-        const TriangleNormals& normals{ params.instanceNormals[instanceId][primIdx] };
-        const float2           uv{ optixGetTriangleBarycentrics() };
-        const float3           uDir( normals.N[1] - normals.N[0] );
-        const float3           vDir( normals.N[2] - normals.N[0] );
-        worldNormal = optixTransformNormalFromObjectToWorldSpace( normals.N[0] + uDir * uv.x + vDir * uv.y );
-        worldNormal = otk::normalize( worldNormal );
+        float3 normals[3];
+        fetchVertexNormals( *params.instanceNormals[instanceId], primIdx, normals );
+        const float2 uv{ optixGetTriangleBarycentrics() };
+        const float3 uDir( normals[1] - normals[0] );
+        const float3 vDir( normals[2] - normals[0] );
+        objectNormal = normals[0] + uDir * uv.x + vDir * uv.y;
     }
-    else
+    // Shapes merged into an object without normals have zero vertex normals; use the face normal.
+    if( otk::dot( objectNormal, objectNormal ) == 0.0f )
     {
         const float3 p12( vertices[1] - vertices[0] );
         const float3 p13( vertices[2] - vertices[0] );
-        const float3 objectNormal{ otk::cross( p12, p13 ) };
-        worldNormal               = otk::normalize( optixTransformNormalFromObjectToWorldSpace( objectNormal ) );
+        objectNormal = otk::cross( p12, p13 );
     }
+    worldNormal = otk::normalize( optixTransformNormalFromObjectToWorldSpace( objectNormal ) );
     if( params.useFaceForward && optixIsBackFaceHit() )
     {
         worldNormal = -worldNormal;
@@ -83,7 +86,8 @@ struct TriMeshMaterialDebugInfo
         const bool                   back{ optixIsBackFaceHit() };
         if( params.instanceNormals != nullptr && params.instanceNormals[instanceId] != nullptr )
         {
-            const TriangleNormals& normals{ params.instanceNormals[instanceId][primIdx] };
+            float3 normals[3];
+            fetchVertexNormals( *params.instanceNormals[instanceId], primIdx, normals );
             printf(                                                                                                  //
                 "[%u, %u]: prim: %u, GAS index: %u, GAS: %llx, F: %s B: %s\n"                                        //
                 "    P0: [%g,%g,%g], P1: [%g,%g,%g], P2: [%g,%g,%g],\n"                                              //
@@ -93,9 +97,9 @@ struct TriMeshMaterialDebugInfo
                 vertices[0].x, vertices[0].y, vertices[0].z,                                                         //
                 vertices[1].x, vertices[1].y, vertices[1].z,                                                         //
                 vertices[2].x, vertices[2].y, vertices[2].z,                                                         //
-                normals.N[0].x, normals.N[0].y, normals.N[0].z,                                                      //
-                normals.N[1].x, normals.N[1].y, normals.N[1].z,                                                      //
-                normals.N[2].x, normals.N[2].y, normals.N[2].z,                                                      //
+                normals[0].x, normals[0].y, normals[0].z,                                                            //
+                normals[1].x, normals[1].y, normals[1].z,                                                            //
+                normals[2].x, normals[2].y, normals[2].z,                                                            //
                 uv.x, uv.y,                                                                                          //
                 worldNormal.x, worldNormal.y, worldNormal.z );                                                       //
         }
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -25,11 +25,15 @@ struct GeometryCacheEntry
     CUdeviceptr            accelBuffer;  // device pointer to geometry acceleration structure
     OptixTraversableHandle traversable;  // traversable handle for this GAS
     GeometryPrimitive      primitive;    // primitive type stored in this GAS
-    TriangleNormals*       devNormals;   // device pointer to per-primitive normals, nullptr if none
-    TriangleUVs*           devUVs;       // device pointer to per-primitive texture coordinates, nullptr if none
+    IndexedNormals*        devNormals;   // device pointer to indexed vertex normals, nullptr if none
+    IndexedUVs*            devUVs;       // device pointer to indexed vertex texture coordinates, nullptr if none
     std::vector<uint_t>    primitiveGroupEndIndices;  // primitive indices that end each group
 };
 
+// Geometry is built asynchronously on the stream passed to the cache; GASes with at least this many
+// primitives are also compacted, which waits for their build to finish.
+const unsigned int MIN_COMPACTED_GAS_PRIMITIVES = 1024U;
+
 class GeometryCache
 {
   public:
@@ -44,6 +48,10 @@ class GeometryCache
                                           GeometryPrimitive                  primitive,
                                           MaterialFlags                      flags ) = 0;
 
+    // Release the reference to an entry obtained from getShape or getObject.  Unreferenced entries
+    // may be freed to stay within the device memory budget, so no pending device work may use them.
+    virtual void releaseEntry( const GeometryCacheEntry& entry ) = 0;
+
     virtual GeometryCacheStatistics getStatistics() const = 0;
 };
 
@@ -59,6 +67,10 @@ using FileSystemInfoPtr = std::shared_ptr<FileSystemInfo>;
 
 FileSystemInfoPtr createFileSystemInfo();
 
-GeometryCachePtr createGeometryCache( FileSystemInfoPtr fileSystemInfo );
+// The cache frees unreferenced entries to keep its device memory below maxDeviceMemory bytes; zero means no limit.
+// When quantizeAttributes is true, mesh normals are stored octahedrally encoded and texture coordinates in 16 bits.
+GeometryCachePtr createGeometryCache( FileSystemInfoPtr  fileSystemInfo,
+                                      unsigned long long maxDeviceMemory    = 0,
+                                      bool               quantizeAttributes = false );
 
 }  // namespace demandPbrtScene
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -15,6 +15,11 @@ struct GeometryCacheStatistics
     unsigned int       numUVs;
     unsigned long long totalBytesRead;
     double             totalReadTime;
+    unsigned int       numCacheHits;          // requests satisfied by a cached GAS
+    unsigned int       numCacheMisses;        // requests that built a new GAS
+    unsigned int       numEvictions;          // unreferenced GASes freed to stay within the memory budget
+    unsigned long long compactionBytesSaved;  // total bytes saved by compacting GASes
+    unsigned long long deviceMemoryUsed;      // bytes of device memory held by cached GASes and their attributes
 };
 
 }  // namespace demandPbrtScene
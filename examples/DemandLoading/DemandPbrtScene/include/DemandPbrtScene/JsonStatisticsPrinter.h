@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -35,7 +35,12 @@ inline std::ostream& operator<<( std::ostream& str, const Json<GeometryCacheStat
     DUMP_JSON_MEMBER( numNormals ) << ',';
     DUMP_JSON_MEMBER( numUVs ) << ',';
     DUMP_JSON_MEMBER( totalBytesRead ) << ',';
-    DUMP_JSON_MEMBER( totalReadTime );
+    DUMP_JSON_MEMBER( totalReadTime ) << ',';
+    DUMP_JSON_MEMBER( numCacheHits ) << ',';
+    DUMP_JSON_MEMBER( numCacheMisses ) << ',';
+    DUMP_JSON_MEMBER( numEvictions ) << ',';
+    DUMP_JSON_MEMBER( compactionBytesSaved ) << ',';
+    DUMP_JSON_MEMBER( deviceMemoryUsed );
     str << '}';
     return str;
 }
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -23,6 +23,7 @@ struct Options
     int              height{ 512 };
     float3           background{};
     int              warmupFrames{ 0 };
+    bool             quantizeAttributes{};
     bool             oneShotGeometry{};
     bool             oneShotMaterial{};
     bool             verboseLoading{};
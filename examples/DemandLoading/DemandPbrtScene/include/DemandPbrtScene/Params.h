@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -192,34 +192,26 @@ inline bool operator!=( const PhongMaterial& lhs, const PhongMaterial& rhs )
     return !( lhs == rhs );
 }
 
-struct TriangleUVs
+// Per-vertex normals of a triangle mesh, looked up through the triangle index buffer.
+// Exactly one of normals and octNormals is non-null.
+struct IndexedNormals
 {
-    float2 UV[3];
+    const uint3*  indices;     // vertex indices of each triangle, indexed by primitive index
+    const float3* normals;     // per-vertex normals
+    const uint_t* octNormals;  // per-vertex normals quantized with encodeOctahedralNormal
 };
 
-inline bool operator==( const TriangleUVs& lhs, const TriangleUVs& rhs )
+// Per-vertex texture coordinates of a triangle mesh, looked up through the triangle index buffer.
+// Exactly one of uvs and quantizedUVs is non-null.
+struct IndexedUVs
 {
-    return lhs.UV[0] == rhs.UV[0] && lhs.UV[1] == rhs.UV[1] && lhs.UV[2] == rhs.UV[2];
-}
-inline bool operator!=( const TriangleUVs& lhs, const TriangleUVs& rhs )
-{
-    return !( lhs == rhs );
-}
-
-struct TriangleNormals
-{
-    float3 N[3];
+    const uint3*   indices;       // vertex indices of each triangle, indexed by primitive index
+    const float2*  uvs;           // per-vertex texture coordinates
+    const ushort2* quantizedUVs;  // per-vertex texture coordinates quantized to uvMin + q * uvScale
+    float2         uvMin;
+    float2         uvScale;
 };
 
-inline bool operator==( const TriangleNormals& lhs, const TriangleNormals& rhs )
-{
-    return lhs.N[0] == rhs.N[0] && lhs.N[1] == rhs.N[1] && lhs.N[2] == rhs.N[2];
-}
-inline bool operator!=( const TriangleNormals& lhs, const TriangleNormals& rhs )
-{
-    return !( lhs == rhs );
-}
-
 struct LookAtParams
 {
     float3 lookAt;
@@ -283,14 +275,14 @@ struct Params
     uint_t                        numPrimitiveMaterials;   // one entry per material group per instance
     const PrimitiveMaterialRange* primitiveMaterials;      // indexed by MaterialIndex::primitiveMaterialBegin
 
-    // An array of pointers to arrays of per-face data, one per geometry instance.
-    // If the pointer is nullptr, then the instance has no per-face data.
-    uint_t            numInstanceNormals;  //
-    TriangleNormals** instanceNormals;     // indexed by instanceId, then by primitive index
-    uint_t            numInstanceUVs;      //
-    TriangleUVs**     instanceUVs;         // indexed by instanceId, then by primitive index
-    uint_t            numPartialUVs;       //
-    TriangleUVs**     partialUVs;          // indexed by materialId, then by primitive index
+    // An array of pointers to indexed vertex attributes, one per geometry instance.
+    // If the pointer is nullptr, then the instance has no such vertex attribute.
+    uint_t           numInstanceNormals;  //
+    IndexedNormals** instanceNormals;     // indexed by instanceId
+    uint_t           numInstanceUVs;      //
+    IndexedUVs**     instanceUVs;         // indexed by instanceId
+    uint_t           numPartialUVs;       //
+    IndexedUVs**     partialUVs;          // indexed by materialId
 
     uint_t minAlphaTextureId;
     uint_t maxAlphaTextureId;
@@ -25,6 +25,11 @@ class PbrtAlphaMapImageSource : public imageSource::WrappedImageSource
 
     bool readTile( char* buffer, unsigned int mipLevel, const imageSource::Tile& tile, CUstream stream ) override;
 
+    bool readTiles( char* const* buffers, unsigned int mipLevel, const imageSource::Tile* tiles, unsigned int numTiles, CUstream stream ) override
+    {
+        return ImageSource::readTiles( buffers, mipLevel, tiles, numTiles, stream );
+    }
+
     bool readMipLevel( char* buffer, unsigned int mipLevel, unsigned int expectedWidth, unsigned int expectedHeight, CUstream stream ) override;
 
     bool readMipTail( char*        dest,
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -37,8 +37,8 @@ struct GeometryInstance
     GeometryPrimitive          primitive;
     OptixInstance              instance;
     std::vector<MaterialGroup> groups;      // {Material,primitiveIndexEnd} for each group
-    TriangleNormals*           devNormals;  // device pointer to per-primitive normals, nullptr if none
-    TriangleUVs*               devUVs;      // device pointer to per-vertex UVs, nullptr if none
+    IndexedNormals*            devNormals;  // device pointer to indexed vertex normals, nullptr if none
+    IndexedUVs*                devUVs;      // device pointer to indexed vertex UVs, nullptr if none
 };
 
 class SceneProxy
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -22,10 +22,10 @@ struct SceneSyncState
     uint_t                            maxDiffuseTextureId{};
     otk::SyncVector<OptixInstance>    topLevelInstances;    // OptixInstance array for building TLIAS
     otk::SyncVector<PartialMaterial>  partialMaterials;     // indexed by materialId
-    otk::SyncVector<TriangleUVs*>     partialUVs;           // indexed by materialId
+    otk::SyncVector<IndexedUVs*>      partialUVs;           // indexed by materialId
     otk::SyncVector<PhongMaterial>    realizedMaterials;    // indexed by values in instanceMaterialIds
-    otk::SyncVector<TriangleNormals*> realizedNormals;      // indexed by instance id, then by primitive index
-    otk::SyncVector<TriangleUVs*>     realizedUVs;          // indexed by instance id, then by primitive index
+    otk::SyncVector<IndexedNormals*>  realizedNormals;      // indexed by instance id
+    otk::SyncVector<IndexedUVs*>      realizedUVs;          // indexed by instance id
     otk::SyncVector<DirectionalLight> directionalLights;    // defined by the scene
     otk::SyncVector<InfiniteLight>    infiniteLights;       // defined by the scene
     otk::SyncVector<MaterialIndex>    materialIndices;      // indexed by instanceId, one entry per instance
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#pragma once
+
+#include "DemandPbrtScene/Params.h"
+
+#include <OptiXToolkit/ShaderUtil/Preprocessor.h>
+#include <OptiXToolkit/ShaderUtil/vec_math.h>
+
+#include <vector_functions.h>
+#include <vector_types.h>
+
+namespace demandPbrtScene {
+
+// Octahedral normal encoding packs a unit vector into two 16-bit signed normalized values.
+// The code with both halves equal to -32768 is never produced for a unit vector and encodes
+// the zero vector, used for vertices without a normal.
+constexpr uint_t OCTAHEDRAL_ZERO_NORMAL{ 0x80008000U };
+
+OTK_INLINE OTK_HOSTDEVICE uint_t packSnorm16( float value )
+{
+    const float clamped{ fminf( fmaxf( value, -1.0f ), 1.0f ) };
+    return static_cast<uint_t>( static_cast<int>( roundf( clamped * 32767.0f ) ) ) & 0xFFFFU;
+}
+
+OTK_INLINE OTK_HOSTDEVICE float unpackSnorm16( uint_t bits )
+{
+    return fmaxf( static_cast<float>( static_cast<short>( bits & 0xFFFFU ) ) / 32767.0f, -1.0f );
+}
+
+OTK_INLINE OTK_HOSTDEVICE float signNotZero( float value )
+{
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+OTK_INLINE OTK_HOSTDEVICE uint_t encodeOctahedralNormal( const float3& normal )
+{
+    const float length1{ fabsf( normal.x ) + fabsf( normal.y ) + fabsf( normal.z ) };
+    if( length1 == 0.0f )
+    {
+        return OCTAHEDRAL_ZERO_NORMAL;
+    }
+    float u{ normal.x / length1 };
+    float v{ normal.y / length1 };
+    if( normal.z < 0.0f )
+    {
+        // Fold the lower hemisphere over the diagonals of the square.
+        const float foldedU{ ( 1.0f - fabsf( v ) ) * signNotZero( u ) };
+        const float foldedV{ ( 1.0f - fabsf( u ) ) * signNotZero( v ) };
+        u = foldedU;
+        v = foldedV;
+    }
+    return packSnorm16( u ) | ( packSnorm16( v ) << 16 );
+}
+
+OTK_INLINE OTK_HOSTDEVICE float3 decodeOctahedralNormal( uint_t bits )
+{
+    if( bits == OCTAHEDRAL_ZERO_NORMAL )
+    {
+        return make_float3( 0.0f, 0.0f, 0.0f );
+    }
+    float       u{ unpackSnorm16( bits ) };
+    float       v{ unpackSnorm16( bits >> 16 ) };
+    const float z{ 1.0f - fabsf( u ) - fabsf( v ) };
+    if( z < 0.0f )
+    {
+        const float unfoldedU{ ( 1.0f - fabsf( v ) ) * signNotZero( u ) };
+        const float unfoldedV{ ( 1.0f - fabsf( u ) ) * signNotZero( v ) };
+        u = unfoldedU;
+        v = unfoldedV;
+    }
+    return otk::normalize( make_float3( u, v, z ) );
+}
+
+// Texture coordinates are quantized to 16 bits over the bounding rectangle of a mesh's coordinates.
+OTK_INLINE OTK_HOSTDEVICE float2 quantizedUVScale( const float2& uvMin, const float2& uvMax )
+{
+    return make_float2( ( uvMax.x - uvMin.x ) / 65535.0f, ( uvMax.y - uvMin.y ) / 65535.0f );
+}
+
+OTK_INLINE OTK_HOSTDEVICE unsigned short quantizeUVComponent( float value, float minValue, float scale )
+{
+    if( scale == 0.0f )
+    {
+        return 0;
+    }
+    const float steps{ fminf( fmaxf( roundf( ( value - minValue ) / scale ), 0.0f ), 65535.0f ) };
+    return static_cast<unsigned short>( steps );
+}
+
+OTK_INLINE OTK_HOSTDEVICE ushort2 quantizeUV( const float2& uv, const float2& uvMin, const float2& uvScale )
+{
+    return make_ushort2( quantizeUVComponent( uv.x, uvMin.x, uvScale.x ), quantizeUVComponent( uv.y, uvMin.y, uvScale.y ) );
+}
+
+OTK_INLINE OTK_HOSTDEVICE float2 dequantizeUV( const ushort2& uv, const float2& uvMin, const float2& uvScale )
+{
+    return make_float2( uvMin.x + uv.x * uvScale.x, uvMin.y + uv.y * uvScale.y );
+}
+
+// Fetch the normals of the three vertices of a triangle through the index buffer.
+OTK_INLINE OTK_HOSTDEVICE void fetchVertexNormals( const IndexedNormals& normals, uint_t primIdx, float3 ( &result )[3] )
+{
+    const uint3  tri{ normals.indices[primIdx] };
+    const uint_t vertices[3]{ tri.x, tri.y, tri.z };
+    for( int i = 0; i < 3; ++i )
+    {
+        result[i] = normals.octNormals != nullptr ? decodeOctahedralNormal( normals.octNormals[vertices[i]] ) :
+                                                    normals.normals[vertices[i]];
+    }
+}
+
+// Fetch the texture coordinates of the three vertices of a triangle through the index buffer.
+OTK_INLINE OTK_HOSTDEVICE void fetchVertexUVs( const IndexedUVs& uvs, uint_t primIdx, float2 ( &result )[3] )
+{
+    const uint3  tri{ uvs.indices[primIdx] };
+    const uint_t vertices[3]{ tri.x, tri.y, tri.z };
+    for( int i = 0; i < 3; ++i )
+    {
+        result[i] = uvs.quantizedUVs != nullptr ? dequantizeUV( uvs.quantizedUVs[vertices[i]], uvs.uvMin, uvs.uvScale ) :
+                                                  uvs.uvs[vertices[i]];
+    }
+}
+
+}  // namespace demandPbrtScene
@@ -13,6 +13,7 @@
 #include <DemandPbrtScene/Conversions.h>
 #include <DemandPbrtScene/GeometryCache.h>
 #include <DemandPbrtScene/SceneProxy.h>
+#include <DemandPbrtScene/VertexAttributes.h>
 
 #include <OptiXToolkit/DemandGeometry/Testing/MockGeometryLoader.h>
 #include <OptiXToolkit/Error/cuErrorCheck.h>
@@ -30,6 +31,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <iterator>
 #include <type_traits>
 
@@ -58,12 +60,12 @@ inline void PrintTo( const OptixAabb& value, std::ostream* str )
 
 namespace demandPbrtScene {
 
-inline void PrintTo( const TriangleNormals& value, std::ostream* str )
+inline void PrintTo( const IndexedNormals& value, std::ostream* str )
 {
     *str << value;
 }
 
-inline void PrintTo( const TriangleUVs& value, std::ostream* str )
+inline void PrintTo( const IndexedUVs& value, std::ostream* str )
 {
     *str << value;
 }
@@ -75,6 +77,83 @@ inline bool operator==( const GeometryCacheEntry& lhs, const GeometryCacheEntry&
 
 }  // namespace demandPbrtScene
 
+// Copy an array of device elements to the host.
+template <typename T>
+static std::vector<T> copyToHost( const T* devElements, size_t count )
+{
+    std::vector<T> result( count );
+    OTK_ERROR_CHECK( cudaMemcpy( result.data(), devElements, sizeof( T ) * count, cudaMemcpyDeviceToHost ) );
+    return result;
+}
+
+static uint_t numIndexedVertices( const std::vector<uint3>& indices )
+{
+    uint_t numVertices{};
+    for( const uint3& tri : indices )
+    {
+        numVertices = std::max( { numVertices, tri.x + 1, tri.y + 1, tri.z + 1 } );
+    }
+    return numVertices;
+}
+
+// Read back the normals of the vertices of each triangle through the device index buffer.
+static std::vector<float3> getDeviceTriangleNormals( const IndexedNormals* devNormals, size_t numTriangles )
+{
+    const IndexedNormals      normals{ copyToHost( devNormals, 1 )[0] };
+    const std::vector<uint3>  indices{ copyToHost( normals.indices, numTriangles ) };
+    const uint_t              numVertices{ numIndexedVertices( indices ) };
+    std::vector<float3>       vertexNormals;
+    std::vector<uint_t>       octNormals;
+    IndexedNormals            hostNormals{ indices.data(), nullptr, nullptr };
+    if( normals.octNormals != nullptr )
+    {
+        octNormals             = copyToHost( normals.octNormals, numVertices );
+        hostNormals.octNormals = octNormals.data();
+    }
+    else
+    {
+        vertexNormals       = copyToHost( normals.normals, numVertices );
+        hostNormals.normals = vertexNormals.data();
+    }
+    std::vector<float3> result;
+    for( uint_t tri = 0; tri < numTriangles; ++tri )
+    {
+        float3 triangle[3];
+        fetchVertexNormals( hostNormals, tri, triangle );
+        result.insert( result.end(), std::begin( triangle ), std::end( triangle ) );
+    }
+    return result;
+}
+
+// Read back the texture coordinates of the vertices of each triangle through the device index buffer.
+static std::vector<float2> getDeviceTriangleUVs( const IndexedUVs* devUVs, size_t numTriangles )
+{
+    const IndexedUVs         uvs{ copyToHost( devUVs, 1 )[0] };
+    const std::vector<uint3> indices{ copyToHost( uvs.indices, numTriangles ) };
+    const uint_t             numVertices{ numIndexedVertices( indices ) };
+    std::vector<float2>      vertexUVs;
+    std::vector<ushort2>     quantizedUVs;
+    IndexedUVs               hostUVs{ indices.data(), nullptr, nullptr, uvs.uvMin, uvs.uvScale };
+    if( uvs.quantizedUVs != nullptr )
+    {
+        quantizedUVs         = copyToHost( uvs.quantizedUVs, numVertices );
+        hostUVs.quantizedUVs = quantizedUVs.data();
+    }
+    else
+    {
+        vertexUVs   = copyToHost( uvs.uvs, numVertices );
+        hostUVs.uvs = vertexUVs.data();
+    }
+    std::vector<float2> result;
+    for( uint_t tri = 0; tri < numTriangles; ++tri )
+    {
+        float2 triangle[3];
+        fetchVertexUVs( hostUVs, tri, triangle );
+        result.insert( result.end(), std::begin( triangle ), std::end( triangle ) );
+    }
+    return result;
+}
+
 MATCHER_P( hasDeviceTriangleNormals, triangleMesh, "" )
 {
     if( arg == nullptr )
@@ -82,23 +161,22 @@ MATCHER_P( hasDeviceTriangleNormals, triangleMesh, "" )
         *result_listener << "pointer to triangle normals is nullptr";
         return false;
     }
-    std::vector<TriangleNormals> actual;
-    actual.resize( triangleMesh->indices.size() / 3 );
-    OTK_ERROR_CHECK( cudaMemcpy( actual.data(), arg, sizeof( TriangleNormals ) * actual.size(), cudaMemcpyDeviceToHost ) );
-    bool       result{ true };
+    const size_t              numTriangles{ triangleMesh->indices.size() / 3 };
+    const std::vector<float3> actual{ getDeviceTriangleNormals( arg, numTriangles ) };
+    bool                      result{ true };
     const auto toFloat3{ []( const pbrt::Point3f& val ) { return make_float3( val.x, val.y, val.z ); } };
-    for( size_t tri = 0; tri < actual.size(); ++tri )
+    for( size_t tri = 0; tri < numTriangles; ++tri )
     {
         for( int vert = 0; vert < 3; ++vert )
         {
             const float3 expected{ toFloat3( triangleMesh->normals[triangleMesh->indices[tri * 3 + vert]] ) };
-            if( actual[tri].N[vert] != expected )
+            if( actual[tri * 3 + vert] != expected )
             {
                 if( !result )
                 {
                     *result_listener << "; ";
                 }
-                *result_listener << "index " << tri << " has normal " << actual[tri].N[vert] << ", expected " << expected;
+                *result_listener << "index " << tri << " has normal " << actual[tri * 3 + vert] << ", expected " << expected;
                 result = false;
             }
         }
@@ -117,27 +195,26 @@ MATCHER_P( hasDevicePlyNormals, buffers, "" )
         *result_listener << "pointer to ply normals is nullptr";
         return false;
     }
-    std::vector<TriangleNormals> actual;
-    actual.resize( buffers->indices.size() / 3 );
-    OTK_ERROR_CHECK( cudaMemcpy( actual.data(), arg, sizeof( TriangleNormals ) * actual.size(), cudaMemcpyDeviceToHost ) );
-    bool       result{ true };
-    const auto toFloat3{ [&]( size_t tri, int vert ) {
+    const size_t              numTriangles{ buffers->indices.size() / 3 };
+    const std::vector<float3> actual{ getDeviceTriangleNormals( arg, numTriangles ) };
+    bool                      result{ true };
+    const auto                toFloat3{ [&]( size_t tri, int vert ) {
         return make_float3( buffers->normalCoords[buffers->indices[tri * 3 + vert] * 3 + 0],
                             buffers->normalCoords[buffers->indices[tri * 3 + vert] * 3 + 1],
                             buffers->normalCoords[buffers->indices[tri * 3 + vert] * 3 + 2] );
     } };
-    for( size_t tri = 0; tri < actual.size(); ++tri )
+    for( size_t tri = 0; tri < numTriangles; ++tri )
     {
         for( int vert = 0; vert < 3; ++vert )
         {
             const float3 expected{ toFloat3( tri, vert ) };
-            if( actual[tri].N[vert] != expected )
+            if( actual[tri * 3 + vert] != expected )
             {
                 if( !result )
                 {
                     *result_listener << "; ";
                 }
-                *result_listener << "triangle " << tri << ", vertex " << vert << " has normal " << actual[tri].N[vert]
+                *result_listener << "triangle " << tri << ", vertex " << vert << " has normal " << actual[tri * 3 + vert]
                                  << ", expected " << expected;
                 result = false;
             }
@@ -157,26 +234,25 @@ MATCHER_P( hasDevicePlyUVs, buffers, "" )
         *result_listener << "pointer to ply uvs is nullptr";
         return false;
     }
-    std::vector<TriangleUVs> actual;
-    actual.resize( buffers->indices.size() / 3 );
-    OTK_ERROR_CHECK( cudaMemcpy( actual.data(), arg, sizeof( TriangleUVs ) * actual.size(), cudaMemcpyDeviceToHost ) );
-    bool       result{ true };
-    const auto toFloat2{ [&]( size_t tri, int vert ) {
+    const size_t              numTriangles{ buffers->indices.size() / 3 };
+    const std::vector<float2> actual{ getDeviceTriangleUVs( arg, numTriangles ) };
+    bool                      result{ true };
+    const auto                toFloat2{ [&]( size_t tri, int vert ) {
         return make_float2( buffers->uvCoords[buffers->indices[tri * 3 + vert] * 2 + 0],
                             buffers->uvCoords[buffers->indices[tri * 3 + vert] * 2 + 1] );
     } };
-    for( size_t tri = 0; tri < actual.size(); ++tri )
+    for( size_t tri = 0; tri < numTriangles; ++tri )
     {
         for( int vert = 0; vert < 3; ++vert )
         {
             const float2 expected{ toFloat2( tri, vert ) };
-            if( actual[tri].UV[vert] != expected )
+            if( actual[tri * 3 + vert] != expected )
             {
                 if( !result )
                 {
                     *result_listener << "; ";
                 }
-                *result_listener << "triangle " << tri << ", vertex " << vert << " has uv " << actual[tri].UV[vert]
+                *result_listener << "triangle " << tri << ", vertex " << vert << " has uv " << actual[tri * 3 + vert]
                                  << ", expected " << expected;
                 result = false;
             }
@@ -226,23 +302,22 @@ MATCHER_P( hasDeviceTriangleUVs, triangleMesh, "" )
         *result_listener << "pointer to triangle UVs is nullptr";
         return false;
     }
-    std::vector<TriangleUVs> actual;
-    actual.resize( triangleMesh->indices.size() / 3 );
-    OTK_ERROR_CHECK( cudaMemcpy( actual.data(), arg, sizeof( TriangleUVs ) * actual.size(), cudaMemcpyDeviceToHost ) );
-    bool       result{ true };
+    const size_t              numTriangles{ triangleMesh->indices.size() / 3 };
+    const std::vector<float2> actual{ getDeviceTriangleUVs( arg, numTriangles ) };
+    bool                      result{ true };
     const auto toFloat2{ []( const pbrt::Point2f& val ) { return make_float2( val.x, val.y ); } };
-    for( size_t tri = 0; tri < actual.size(); ++tri )
+    for( size_t tri = 0; tri < numTriangles; ++tri )
     {
         for( int vert = 0; vert < 3; ++vert )
         {
             const float2 expected{ toFloat2( triangleMesh->uvs[triangleMesh->indices[tri * 3 + vert]] ) };
-            if( actual[tri].UV[vert] != expected )
+            if( actual[tri * 3 + vert] != expected )
             {
                 if( !result )
                 {
                     *result_listener << "; ";
                 }
-                *result_listener << "index " << tri << " has UV " << actual[tri].UV[vert] << ", expected " << expected;
+                *result_listener << "index " << tri << " has UV " << actual[tri * 3 + vert] << ", expected " << expected;
                 result = false;
             }
         }
@@ -276,18 +351,16 @@ class TestGeometryCache : public Test
         OTK_ERROR_CHECK( cuStreamCreate( &m_stream, 0 ) );
         m_accelSizes.tempSizeInBytes   = 1234U;
         m_accelSizes.outputSizeInBytes = 5678U;
+        m_compactedSize                = m_accelSizes.outputSizeInBytes;
         m_expectedFlags.push_back( OPTIX_GEOMETRY_FLAG_NONE );
     }
 
-    void TearDown() override
+    void TearDown() override { OTK_ERROR_CHECK( cuStreamDestroy( m_stream ) ); }
+
+    void emitCompactedSize( const OptixAccelEmitDesc* emitted )
     {
-        if( m_geom.devNormals )
-            OTK_ERROR_CHECK( cudaFree( m_geom.devNormals ) );
-        if( m_geom.devUVs )
-            OTK_ERROR_CHECK( cudaFree( m_geom.devUVs ) );
-        if( m_geom.accelBuffer )
-            OTK_ERROR_CHECK( cuMemFree( m_geom.accelBuffer ) );
-        OTK_ERROR_CHECK( cuStreamDestroy( m_stream ) );
+        const std::uint64_t size{ m_compactedSize };
+        OTK_ERROR_CHECK( cudaMemcpy( otk::bit_cast<void*>( emitted->result ), &size, sizeof( size ), cudaMemcpyHostToDevice ) );
     }
 
     template <typename OptionMatcher, typename BuildInputMatcher>
@@ -303,9 +376,10 @@ class TestGeometryCache : public Test
     Expectation configureAccelBuild( OptionMatcher& expectedOptions, BuildInputMatcher& expectedInput, OptixTraversableHandle result )
     {
         const uint_t numBuildInputs{ 1 };
+        const uint_t numEmittedProperties{ 0 };
         return EXPECT_CALL( m_optix, accelBuild( m_fakeContext, m_stream, expectedOptions, expectedInput, numBuildInputs,
                                                  Ne( CUdeviceptr{} ), m_accelSizes.tempSizeInBytes, Ne( CUdeviceptr{} ),
-                                                 m_accelSizes.outputSizeInBytes, NotNull(), nullptr, 0 ) )
+                                                 m_accelSizes.outputSizeInBytes, NotNull(), IsNull(), numEmittedProperties ) )
             .WillOnce( DoAll( SetArgPointee<9>( result ), Return( OPTIX_SUCCESS ) ) );
     }
     template <typename OptionMatcher, typename BuildInputMatcher>
@@ -314,6 +388,33 @@ class TestGeometryCache : public Test
         return configureAccelBuild( expectedOptions, expectedInput, m_fakeGeomAS );
     }
 
+    template <typename OptionMatcher, typename BuildInputMatcher>
+    Expectation configureCompactingAccelBuild( OptionMatcher& expectedOptions, BuildInputMatcher& expectedInput )
+    {
+        const uint_t numBuildInputs{ 1 };
+        const uint_t numEmittedProperties{ 1 };
+        return EXPECT_CALL( m_optix, accelBuild( m_fakeContext, m_stream, expectedOptions, expectedInput, numBuildInputs,
+                                                 Ne( CUdeviceptr{} ), m_accelSizes.tempSizeInBytes, Ne( CUdeviceptr{} ),
+                                                 m_accelSizes.outputSizeInBytes, NotNull(),
+                                                 Pointee( Field( &OptixAccelEmitDesc::type, OPTIX_PROPERTY_TYPE_COMPACTED_SIZE ) ),
+                                                 numEmittedProperties ) )
+            .WillOnce( DoAll( SetArgPointee<9>( m_fakeGeomAS ), WithArg<10>( Invoke( this, &TestGeometryCache::emitCompactedSize ) ),
+                              Return( OPTIX_SUCCESS ) ) );
+    }
+
+    void configureAccelBuilds( int count )
+    {
+        const uint_t numBuildInputs{ 1 };
+        const uint_t numEmittedProperties{ 0 };
+        EXPECT_CALL( m_optix, accelComputeMemoryUsage( m_fakeContext, NotNull(), NotNull(), numBuildInputs, NotNull() ) )
+            .Times( count )
+            .WillRepeatedly( DoAll( SetArgPointee<4>( m_accelSizes ), Return( OPTIX_SUCCESS ) ) );
+        EXPECT_CALL( m_optix, accelBuild( m_fakeContext, m_stream, NotNull(), NotNull(), numBuildInputs, _, _, _, _,
+                                          NotNull(), IsNull(), numEmittedProperties ) )
+            .Times( count )
+            .WillRepeatedly( DoAll( SetArgPointee<9>( m_fakeGeomAS ), Return( OPTIX_SUCCESS ) ) );
+    }
+
     void expectPlyFileSizeReturned()
     {
         EXPECT_CALL( *m_fileSystemInfo, getSize( StrEq( ARBITRARY_PLY_FILENAME ) ) ).WillRepeatedly( Return( ARBITRARY_PLY_FILE_SIZE ) );
@@ -326,6 +427,7 @@ class TestGeometryCache : public Test
     OptixDeviceContext     m_fakeContext{ otk::bit_cast<OptixDeviceContext>( 0xf00df00dULL ) };
     GeometryCacheEntry     m_geom{};
     OptixAccelBufferSizes  m_accelSizes{};
+    size_t                 m_compactedSize{};
     OptixTraversableHandle m_fakeGeomAS{ 0xfeedf00dU };
     std::vector<uint_t>    m_expectedFlags;
 };
@@ -402,6 +504,20 @@ static ShapeDefinition singleTriangleTriangleMesh( MeshData& buffers )
     return shape;
 }
 
+static ShapeDefinition largeTriangleMesh()
+{
+    static std::vector<pbrt::Point3f> points{ P3{ 0.0f, 0.0f, 0.0f }, P3{ 1.0f, 0.0f, 0.0f }, P3{ 1.0f, 1.0f, 1.0f } };
+    std::vector<int>                  indices;
+    for( uint_t i = 0; i < MIN_COMPACTED_GAS_PRIMITIVES; ++i )
+    {
+        indices.insert( indices.end(), { 0, 1, 2 } );
+    }
+    ShapeDefinition shape{};
+    shape.type         = SHAPE_TYPE_TRIANGLE_MESH;
+    shape.triangleMesh = TriangleMeshData{ indices, points, {}, {} };
+    return shape;
+}
+
 static ShapeDefinition singleTriangleTriangleMeshWithNormals( MeshData& buffers )
 {
     ShapeDefinition                   shape{ singleTriangleTriangleMesh( buffers ) };
@@ -452,23 +568,59 @@ static ShapeDefinition twoTriangleTriangleMesh( MeshData& buffers )
     return shape;
 }
 
-static TriangleNormals expectedNormal()
+namespace {
+
+// Indexed vertex normals of a single triangle in device memory.
+class DeviceTriangleNormals
 {
-    TriangleNormals actual;
-    actual.N[0] = make_float3( 1.0f, 0.0f, 0.0f );
-    actual.N[1] = make_float3( 0.0f, 1.0f, 0.0f );
-    actual.N[2] = make_float3( 0.0f, 0.0f, 1.0f );
-    return actual;
-}
+  public:
+    DeviceTriangleNormals()
+    {
+        OTK_ERROR_CHECK( cudaFree( nullptr ) );
+        m_indices.push_back( make_uint3( 0, 1, 2 ) );
+        m_indices.copyToDevice();
+        m_normals.push_back( make_float3( 1.0f, 0.0f, 0.0f ) );
+        m_normals.push_back( make_float3( 0.0f, 1.0f, 0.0f ) );
+        m_normals.push_back( make_float3( 0.0f, 0.0f, 1.0f ) );
+        m_normals.copyToDevice();
+        m_indexedNormals.push_back( IndexedNormals{ m_indices.typedDevicePtr(), m_normals.typedDevicePtr(), nullptr } );
+        m_indexedNormals.copyToDevice();
+    }
+
+    IndexedNormals* typedDevicePtr() { return m_indexedNormals.typedDevicePtr(); }
+
+  private:
+    otk::SyncVector<uint3>          m_indices;
+    otk::SyncVector<float3>         m_normals;
+    otk::SyncVector<IndexedNormals> m_indexedNormals;
+};
 
-static TriangleUVs expectedUV()
+// Indexed vertex texture coordinates of a single triangle in device memory.
+class DeviceTriangleUVs
 {
-    TriangleUVs actual;
-    actual.UV[0] = make_float2( 1.0f, 0.0f );
-    actual.UV[1] = make_float2( 0.0f, 1.0f );
-    actual.UV[2] = make_float2( 0.0f, 0.0f );
-    return actual;
-}
+  public:
+    DeviceTriangleUVs()
+    {
+        OTK_ERROR_CHECK( cudaFree( nullptr ) );
+        m_indices.push_back( make_uint3( 0, 1, 2 ) );
+        m_indices.copyToDevice();
+        m_uvs.push_back( make_float2( 1.0f, 0.0f ) );
+        m_uvs.push_back( make_float2( 0.0f, 1.0f ) );
+        m_uvs.push_back( make_float2( 0.0f, 0.0f ) );
+        m_uvs.copyToDevice();
+        m_indexedUVs.push_back( IndexedUVs{ m_indices.typedDevicePtr(), m_uvs.typedDevicePtr(), nullptr, {}, {} } );
+        m_indexedUVs.copyToDevice();
+    }
+
+    IndexedUVs* typedDevicePtr() { return m_indexedUVs.typedDevicePtr(); }
+
+  private:
+    otk::SyncVector<uint3>      m_indices;
+    otk::SyncVector<float2>     m_uvs;
+    otk::SyncVector<IndexedUVs> m_indexedUVs;
+};
+
+}  // namespace
 
 static ShapeDefinition singleSphere()
 {
@@ -483,6 +635,13 @@ static ShapeDefinition singleSphere()
     return shape;
 }
 
+static ShapeDefinition sphereWithRadius( float radius )
+{
+    ShapeDefinition shape{ singleSphere() };
+    shape.sphere.radius = radius;
+    return shape;
+}
+
 static ShapeDefinition translateTriangleMesh( TestObject& object, int index, float tx, float ty, float tz )
 {
     ShapeDefinition mesh{ singleTriangleTriangleMesh( object.buffers[index] ) };
@@ -807,11 +966,7 @@ TEST( TestHasDeviceTriangleNormals, normalsPointerIsNull )
 
 TEST( TestHasDeviceTriangleNormals, normalsDontMatchFirstVertex )
 {
-    OTK_ERROR_CHECK( cudaFree( nullptr ) );
-    otk::SyncVector<TriangleNormals> actual;
-    actual.resize( 1 );
-    actual[0] = expectedNormal();
-    actual.copyToDevice();
+    DeviceTriangleNormals actual;
     const TriangleMeshData triangleMesh{ { 0, 1, 2 }, {}, { P3{ 0.0f, 1.0f, 0.0f }, P3{ 0.0f, 1.0f, 0.0f }, P3{ 0.0f, 0.0f, 1.0f } } };
 
     EXPECT_THAT( actual.typedDevicePtr(), Not( hasDeviceTriangleNormals( &triangleMesh ) ) );
@@ -819,11 +974,7 @@ TEST( TestHasDeviceTriangleNormals, normalsDontMatchFirstVertex )
 
 TEST( TestHasDeviceTriangleNormals, normalsDontMatchSecondVertex )
 {
-    OTK_ERROR_CHECK( cudaFree( nullptr ) );
-    otk::SyncVector<TriangleNormals> actual;
-    actual.resize( 1 );
-    actual[0] = expectedNormal();
-    actual.copyToDevice();
+    DeviceTriangleNormals actual;
     TriangleMeshData triangleMesh{ { 0, 1, 2 }, {}, { P3{ 1.0f, 0.0f, 0.0f }, P3{ 0.0f, 0.0f, 1.0f }, P3{ 0.0f, 0.0f, 1.0f } } };
 
     EXPECT_THAT( actual.typedDevicePtr(), Not( hasDeviceTriangleNormals( &triangleMesh ) ) );
@@ -831,11 +982,7 @@ TEST( TestHasDeviceTriangleNormals, normalsDontMatchSecondVertex )
 
 TEST( TestHasDeviceTriangleNormals, normalsDontMatchThirdVertex )
 {
-    OTK_ERROR_CHECK( cudaFree( nullptr ) );
-    otk::SyncVector<TriangleNormals> actual;
-    actual.resize( 1 );
-    actual[0] = expectedNormal();
-    actual.copyToDevice();
+    DeviceTriangleNormals actual;
     TriangleMeshData triangleMesh{ { 0, 1, 2 }, {}, { P3{ 1.0f, 0.0f, 0.0f }, P3{ 0.0f, 1.0f, 0.0f }, P3{ 1.0f, 0.0f, 0.0f } } };
 
     EXPECT_THAT( actual.typedDevicePtr(), Not( hasDeviceTriangleNormals( &triangleMesh ) ) );
@@ -843,11 +990,7 @@ TEST( TestHasDeviceTriangleNormals, normalsDontMatchThirdVertex )
 
 TEST( TestHasDeviceTriangleNormals, allNormalsMatch )
 {
-    OTK_ERROR_CHECK( cudaFree( nullptr ) );
-    otk::SyncVector<TriangleNormals> actual;
-    actual.resize( 1 );
-    actual[0] = expectedNormal();
-    actual.copyToDevice();
+    DeviceTriangleNormals actual;
     TriangleMeshData triangleMesh{ { 0, 1, 2 }, {}, { P3{ 1.0f, 0.0f, 0.0f }, P3{ 0.0f, 1.0f, 0.0f }, P3{ 0.0f, 0.0f, 1.0f } } };
 
     EXPECT_THAT( actual.typedDevicePtr(), hasDeviceTriangleNormals( &triangleMesh ) );
@@ -892,11 +1035,7 @@ TEST( TestHasDeviceTriangleUVs, uvsPointerIsNull )
 
 TEST( TestHasDeviceTriangleUVs, uvsDontMatchFirstVertex )
 {
-    OTK_ERROR_CHECK( cudaFree( nullptr ) );
-    otk::SyncVector<TriangleUVs> actual;
-    actual.resize( 1 );
-    actual[0] = expectedUV();
-    actual.copyToDevice();
+    DeviceTriangleUVs actual;
     const TriangleMeshData triangleMesh{ { 0, 1, 2 }, {}, {}, { P2{ 1.0f, 1.0f }, P2{ 0.0f, 1.0f }, P2{ 0.0f, 0.0f } } };
 
     EXPECT_THAT( actual.typedDevicePtr(), Not( hasDeviceTriangleUVs( &triangleMesh ) ) );
@@ -904,11 +1043,7 @@ TEST( TestHasDeviceTriangleUVs, uvsDontMatchFirstVertex )
 
 TEST( TestHasDeviceTriangleUVs, uvsDontMatchSecondVertex )
 {
-    OTK_ERROR_CHECK( cudaFree( nullptr ) );
-    otk::SyncVector<TriangleUVs> actual;
-    actual.resize( 1 );
-    actual[0] = expectedUV();
-    actual.copyToDevice();
+    DeviceTriangleUVs actual;
     const TriangleMeshData triangleMesh{ { 0, 1, 2 }, {}, {}, { P2{ 1.0f, 0.0f }, P2{ 1.0f, 1.0f }, P2{ 0.0f, 0.0f } } };
 
     EXPECT_THAT( actual.typedDevicePtr(), Not( hasDeviceTriangleUVs( &triangleMesh ) ) );
@@ -916,11 +1051,7 @@ TEST( TestHasDeviceTriangleUVs, uvsDontMatchSecondVertex )
 
 TEST( TestHasDeviceTriangleUVs, uvsDontMatchThirdVertex )
 {
-    OTK_ERROR_CHECK( cudaFree( nullptr ) );
-    otk::SyncVector<TriangleUVs> actual;
-    actual.resize( 1 );
-    actual[0] = expectedUV();
-    actual.copyToDevice();
+    DeviceTriangleUVs actual;
     const TriangleMeshData triangleMesh{ { 0, 1, 2 }, {}, {}, { P2{ 1.0f, 0.0f }, P2{ 0.0f, 1.0f }, P2{ 1.0f, 1.0f } } };
 
     EXPECT_THAT( actual.typedDevicePtr(), Not( hasDeviceTriangleUVs( &triangleMesh ) ) );
@@ -928,11 +1059,7 @@ TEST( TestHasDeviceTriangleUVs, uvsDontMatchThirdVertex )
 
 TEST( TestHasDeviceTriangleUVs, allUVsMatch )
 {
-    OTK_ERROR_CHECK( cudaFree( nullptr ) );
-    otk::SyncVector<TriangleUVs> actual;
-    actual.resize( 1 );
-    actual[0] = expectedUV();
-    actual.copyToDevice();
+    DeviceTriangleUVs actual;
     const TriangleMeshData triangleMesh{ { 0, 1, 2 }, {}, {}, { P2{ 1.0f, 0.0f }, P2{ 0.0f, 1.0f }, P2{ 0.0f, 0.0f } } };
 
     EXPECT_THAT( actual.typedDevicePtr(), hasDeviceTriangleUVs( &triangleMesh ) );
@@ -969,6 +1096,63 @@ TEST_F( TestGeometryCache, constructTriangleASForTriangleMeshWithUVs )
     EXPECT_EQ( 1U, m_geom.primitiveGroupEndIndices[0] );
 }
 
+TEST_F( TestGeometryCache, storesOneNormalPerSharedVertex )
+{
+    ShapeDefinition shape{};
+    shape.type         = SHAPE_TYPE_TRIANGLE_MESH;
+    shape.triangleMesh = TriangleMeshData{ { 0, 1, 2, 0, 2, 3 },
+                                           { P3{ 0.0f, 0.0f, 0.0f }, P3{ 1.0f, 0.0f, 0.0f }, P3{ 1.0f, 1.0f, 0.0f }, P3{ 0.0f, 1.0f, 0.0f } },
+                                           { P3{ 1.0f, 0.0f, 0.0f }, P3{ 0.0f, 1.0f, 0.0f }, P3{ 0.0f, 0.0f, 1.0f }, P3{ -1.0f, 0.0f, 0.0f } },
+                                           {} };
+    configureAccelBuilds( 1 );
+
+    m_geom = m_geometryCache->getShape( m_fakeContext, m_stream, shape );
+    OTK_ERROR_CHECK( cudaDeviceSynchronize() );
+    const Stats stats{ m_geometryCache->getStatistics() };
+
+    EXPECT_THAT( m_geom.devNormals, hasDeviceTriangleNormals( &shape.triangleMesh ) );
+    EXPECT_EQ( 2, stats.numTriangles );
+    EXPECT_EQ( 4, stats.numNormals );
+}
+
+TEST_F( TestGeometryCache, quantizesTriangleMeshNormals )
+{
+    m_geometryCache = createGeometryCache( m_fileSystemInfo, 0, true );
+    MeshData        buffers;
+    ShapeDefinition shape{ singleTriangleTriangleMeshWithNormals( buffers ) };
+    configureAccelBuilds( 1 );
+
+    m_geom = m_geometryCache->getShape( m_fakeContext, m_stream, shape );
+    OTK_ERROR_CHECK( cudaDeviceSynchronize() );
+    const IndexedNormals normals{ copyToHost( m_geom.devNormals, 1 )[0] };
+
+    EXPECT_EQ( nullptr, normals.normals );
+    EXPECT_NE( nullptr, normals.octNormals );
+    EXPECT_THAT( m_geom.devNormals, hasDeviceTriangleNormals( &shape.triangleMesh ) );
+}
+
+TEST_F( TestGeometryCache, quantizesTriangleMeshUVs )
+{
+    m_geometryCache = createGeometryCache( m_fileSystemInfo, 0, true );
+    MeshData        buffers;
+    ShapeDefinition shape{ singleTriangleTriangleMeshWithUVs( buffers ) };
+    configureAccelBuilds( 1 );
+
+    m_geom = m_geometryCache->getShape( m_fakeContext, m_stream, shape );
+    OTK_ERROR_CHECK( cudaDeviceSynchronize() );
+    const IndexedUVs          uvs{ copyToHost( m_geom.devUVs, 1 )[0] };
+    const std::vector<float2> actual{ getDeviceTriangleUVs( m_geom.devUVs, 1 ) };
+
+    EXPECT_EQ( nullptr, uvs.uvs );
+    EXPECT_NE( nullptr, uvs.quantizedUVs );
+    ASSERT_EQ( 3U, actual.size() );
+    for( int vert = 0; vert < 3; ++vert )
+    {
+        EXPECT_NEAR( shape.triangleMesh.uvs[vert].x, actual[vert].x, 1.0e-4f ) << "vertex " << vert;
+        EXPECT_NEAR( shape.triangleMesh.uvs[vert].y, actual[vert].y, 1.0e-4f ) << "vertex " << vert;
+    }
+}
+
 TEST_F( TestGeometryCache, twoPlyInstancesShareSameGAS )
 {
     expectPlyFileSizeReturned();
@@ -1059,6 +1243,28 @@ TEST_F( TestGeometryCache, constructTriangleASForObjectTwoMeshes )
     EXPECT_EQ( 0, stats.totalBytesRead );
 }
 
+TEST_F( TestGeometryCache, padsNormalsOfObjectMeshWithoutNormals )
+{
+    TestObject object{ twoTriangleMeshes() };
+    object.shapes[1].triangleMesh.normals = { P3{ 1.0f, 0.0f, 0.0f }, P3{ 0.0f, 1.0f, 0.0f }, P3{ 0.0f, 0.0f, 1.0f } };
+    configureAccelBuilds( 1 );
+
+    const GeometryCacheEntry result{ m_geometryCache->getObject( m_fakeContext, m_stream, object.object, object.shapes,
+                                                                 GeometryPrimitive::TRIANGLE, MaterialFlags::NONE ) };
+    OTK_ERROR_CHECK( cudaDeviceSynchronize() );
+    const std::vector<float3> actual{ getDeviceTriangleNormals( result.devNormals, 2 ) };
+    const Stats               stats{ m_geometryCache->getStatistics() };
+
+    ASSERT_EQ( 6U, actual.size() );
+    for( int vert = 0; vert < 3; ++vert )
+    {
+        EXPECT_EQ( make_float3( 0.0f, 0.0f, 0.0f ), actual[vert] ) << "vertex " << vert;
+        const pbrt::Point3f& expected{ object.shapes[1].triangleMesh.normals[vert] };
+        EXPECT_EQ( make_float3( expected.x, expected.y, expected.z ), actual[3 + vert] ) << "vertex " << vert;
+    }
+    EXPECT_EQ( 6, stats.numNormals );
+}
+
 TEST_F( TestGeometryCache, cachesTriangleASForObjectTwoMeshes )
 {
     const TestObject object{ twoTriangleMeshes() };
@@ -1197,3 +1403,174 @@ TEST_F( TestGeometryCache, constructSphereASForObjectOneTriMeshOneSphere )
     EXPECT_EQ( 0, stats.numUVs );
     EXPECT_EQ( 0, stats.totalBytesRead );
 }
+
+TEST_F( TestGeometryCache, duplicateTriangleMeshesShareSameGAS )
+{
+    MeshData              buffers;
+    const ShapeDefinition shape{ singleTriangleTriangleMesh( buffers ) };
+    const ShapeDefinition duplicate{ shape };
+    const auto            expectedOptions{ buildAllowsRandomVertexAccess() };
+    const auto            expectedInput{ AllOf( NotNull(), hasTriangleBuildInput( 0, hasDeviceIndices( buffers.indices ) ) ) };
+    configureAccelComputeMemoryUsage( expectedOptions, expectedInput );
+    configureAccelBuild( expectedOptions, expectedInput );
+
+    m_geom = m_geometryCache->getShape( m_fakeContext, m_stream, shape );
+    const GeometryCacheEntry geom2{ m_geometryCache->getShape( m_fakeContext, m_stream, duplicate ) };
+    const Stats              stats{ m_geometryCache->getStatistics() };
+
+    EXPECT_EQ( geom2, m_geom );
+    EXPECT_EQ( 1, stats.numTraversables );
+    EXPECT_EQ( 1, stats.numCacheHits );
+    EXPECT_EQ( 1, stats.numCacheMisses );
+}
+
+TEST_F( TestGeometryCache, differentTriangleMeshesBuildSeparateGASes )
+{
+    MeshData              buffers;
+    const ShapeDefinition shape{ singleTriangleTriangleMesh( buffers ) };
+    const ShapeDefinition otherShape{ singleTriangleTriangleMeshWithUVs( buffers ) };
+    configureAccelBuilds( 2 );
+
+    m_geom = m_geometryCache->getShape( m_fakeContext, m_stream, shape );
+    const GeometryCacheEntry geom2{ m_geometryCache->getShape( m_fakeContext, m_stream, otherShape ) };
+    const Stats              stats{ m_geometryCache->getStatistics() };
+
+    EXPECT_NE( geom2.accelBuffer, m_geom.accelBuffer );
+    EXPECT_EQ( 2, stats.numTraversables );
+    EXPECT_EQ( 0, stats.numCacheHits );
+    EXPECT_EQ( 2, stats.numCacheMisses );
+}
+
+TEST_F( TestGeometryCache, smallGASIsNotCompacted )
+{
+    const ShapeDefinition shape{ singleSphere() };
+    const auto            expectedOptions{ AllOf( buildAllowsRandomVertexAccess(), Not( buildAllowsCompaction() ) ) };
+    const auto            expectedInput{ NotNull() };
+    configureAccelComputeMemoryUsage( expectedOptions, expectedInput );
+    configureAccelBuild( expectedOptions, expectedInput );
+
+    m_geom = m_geometryCache->getShape( m_fakeContext, m_stream, shape );
+    const Stats stats{ m_geometryCache->getStatistics() };
+
+    EXPECT_EQ( m_fakeGeomAS, m_geom.traversable );
+    EXPECT_EQ( 0U, stats.compactionBytesSaved );
+}
+
+TEST_F( TestGeometryCache, compactsGASWhenSmaller )
+{
+    m_compactedSize = 1000U;
+    const ShapeDefinition        shape{ largeTriangleMesh() };
+    const auto                   expectedOptions{ AllOf( buildAllowsRandomVertexAccess(), buildAllowsCompaction() ) };
+    const auto                   expectedInput{ NotNull() };
+    const OptixTraversableHandle compactedGAS{ 0xc0ffeeU };
+    configureAccelComputeMemoryUsage( expectedOptions, expectedInput );
+    const Expectation build{ configureCompactingAccelBuild( expectedOptions, expectedInput ) };
+    EXPECT_CALL( m_optix, accelCompact( m_fakeContext, m_stream, m_fakeGeomAS, Ne( CUdeviceptr{} ), m_compactedSize, NotNull() ) )
+        .After( build )
+        .WillOnce( DoAll( SetArgPointee<5>( compactedGAS ), Return( OPTIX_SUCCESS ) ) );
+
+    m_geom = m_geometryCache->getShape( m_fakeContext, m_stream, shape );
+    const Stats stats{ m_geometryCache->getStatistics() };
+
+    EXPECT_NE( CUdeviceptr{}, m_geom.accelBuffer );
+    EXPECT_EQ( compactedGAS, m_geom.traversable );
+    EXPECT_EQ( m_accelSizes.outputSizeInBytes - m_compactedSize, stats.compactionBytesSaved );
+    EXPECT_EQ( m_compactedSize, stats.deviceMemoryUsed );
+}
+
+TEST_F( TestGeometryCache, doesNotCompactGASWhenNotSmaller )
+{
+    const ShapeDefinition shape{ largeTriangleMesh() };
+    const auto            expectedOptions{ buildAllowsCompaction() };
+    const auto            expectedInput{ NotNull() };
+    configureAccelComputeMemoryUsage( expectedOptions, expectedInput );
+    configureCompactingAccelBuild( expectedOptions, expectedInput );
+
+    m_geom = m_geometryCache->getShape( m_fakeContext, m_stream, shape );
+    const Stats stats{ m_geometryCache->getStatistics() };
+
+    EXPECT_EQ( m_fakeGeomAS, m_geom.traversable );
+    EXPECT_EQ( 0U, stats.compactionBytesSaved );
+    EXPECT_EQ( m_accelSizes.outputSizeInBytes, stats.deviceMemoryUsed );
+}
+
+TEST_F( TestGeometryCache, referencedGeometryIsNotEvicted )
+{
+    m_geometryCache = createGeometryCache( m_fileSystemInfo, 1U );
+    configureAccelBuilds( 1 );
+
+    m_geom = m_geometryCache->getShape( m_fakeContext, m_stream, singleSphere() );
+    const Stats stats{ m_geometryCache->getStatistics() };
+
+    EXPECT_EQ( 0, stats.numEvictions );
+    EXPECT_EQ( m_accelSizes.outputSizeInBytes, stats.deviceMemoryUsed );
+}
+
+TEST_F( TestGeometryCache, releasedGeometryIsEvictedOverBudget )
+{
+    m_geometryCache = createGeometryCache( m_fileSystemInfo, 1U );
+    configureAccelBuilds( 1 );
+    m_geom = m_geometryCache->getShape( m_fakeContext, m_stream, singleSphere() );
+
+    m_geometryCache->releaseEntry( m_geom );
+    const Stats stats{ m_geometryCache->getStatistics() };
+
+    EXPECT_EQ( 1, stats.numEvictions );
+    EXPECT_EQ( 0U, stats.deviceMemoryUsed );
+}
+
+TEST_F( TestGeometryCache, releasedGeometryIsReusedWithinBudget )
+{
+    configureAccelBuilds( 1 );
+    m_geom = m_geometryCache->getShape( m_fakeContext, m_stream, singleSphere() );
+    m_geometryCache->releaseEntry( m_geom );
+
+    const GeometryCacheEntry geom2{ m_geometryCache->getShape( m_fakeContext, m_stream, singleSphere() ) };
+    const Stats              stats{ m_geometryCache->getStatistics() };
+
+    EXPECT_EQ( geom2, m_geom );
+    EXPECT_EQ( 0, stats.numEvictions );
+    EXPECT_EQ( 1, stats.numCacheHits );
+    EXPECT_EQ( 1, stats.numCacheMisses );
+}
+
+TEST_F( TestGeometryCache, evictsLeastRecentlyUsedGeometry )
+{
+    m_geometryCache = createGeometryCache( m_fileSystemInfo, 2U * m_accelSizes.outputSizeInBytes );
+    configureAccelBuilds( 4 );
+    const ShapeDefinition    sphere1{ sphereWithRadius( 1.0f ) };
+    const ShapeDefinition    sphere2{ sphereWithRadius( 2.0f ) };
+    const ShapeDefinition    sphere3{ sphereWithRadius( 3.0f ) };
+    const GeometryCacheEntry geom1{ m_geometryCache->getShape( m_fakeContext, m_stream, sphere1 ) };
+    const GeometryCacheEntry geom2{ m_geometryCache->getShape( m_fakeContext, m_stream, sphere2 ) };
+    m_geometryCache->releaseEntry( geom1 );
+    m_geometryCache->releaseEntry( geom2 );
+    m_geometryCache->releaseEntry( m_geometryCache->getShape( m_fakeContext, m_stream, sphere1 ) );
+
+    static_cast<void>( m_geometryCache->getShape( m_fakeContext, m_stream, sphere3 ) );
+    const Stats statsAfterEviction{ m_geometryCache->getStatistics() };
+    static_cast<void>( m_geometryCache->getShape( m_fakeContext, m_stream, sphere1 ) );
+    static_cast<void>( m_geometryCache->getShape( m_fakeContext, m_stream, sphere2 ) );
+    const Stats stats{ m_geometryCache->getStatistics() };
+
+    EXPECT_EQ( 1, statsAfterEviction.numEvictions );
+    EXPECT_EQ( 2U * m_accelSizes.outputSizeInBytes, statsAfterEviction.deviceMemoryUsed );
+    EXPECT_EQ( 1, stats.numEvictions );
+    EXPECT_EQ( 2, stats.numCacheHits );
+    EXPECT_EQ( 4, stats.numCacheMisses );
+    EXPECT_EQ( 3U * m_accelSizes.outputSizeInBytes, stats.deviceMemoryUsed );
+}
+
+TEST_F( TestGeometryCache, releasingUnknownGeometryThrows )
+{
+    EXPECT_THROW( m_geometryCache->releaseEntry( GeometryCacheEntry{} ), std::runtime_error );
+}
+
+TEST_F( TestGeometryCache, releasingUnreferencedGeometryThrows )
+{
+    configureAccelBuilds( 1 );
+    m_geom = m_geometryCache->getShape( m_fakeContext, m_stream, singleSphere() );
+    m_geometryCache->releaseEntry( m_geom );
+
+    EXPECT_THROW( m_geometryCache->releaseEntry( m_geom ), std::runtime_error );
+}
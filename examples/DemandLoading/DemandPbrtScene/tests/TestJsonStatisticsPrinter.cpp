@@ -55,13 +55,19 @@ void TestJsonStatisticsPrinter::SetUp()
     m_stats.scene.numObjects = 26;
     m_stats.scene.numObjectShapes = 27;
     m_stats.scene.numObjectInstances = 28;
+    m_stats.geometryCache.numCacheHits = 29;
+    m_stats.geometryCache.numCacheMisses = 30;
+    m_stats.geometryCache.numEvictions = 31;
+    m_stats.geometryCache.compactionBytesSaved = 32U;
+    m_stats.geometryCache.deviceMemoryUsed = 33U;
 
     // If this is a string literal inside EXPECT_EQ it fails to compile on msvc due to the fileName JSON value escapes.
     m_expectedStatsJson =
         // clang-format off
         R"json({)json"
         R"json("numFramesRendered":1234,)json"
-        R"json("geometryCache":{"numTraversables":1,"numTriangles":2,"numSpheres":3,"numNormals":4,"numUVs":5,"totalBytesRead":6,"totalReadTime":7},)json"
+        R"json("geometryCache":{"numTraversables":1,"numTriangles":2,"numSpheres":3,"numNormals":4,"numUVs":5,"totalBytesRead":6,"totalReadTime":7,)json"
+            R"json("numCacheHits":29,"numCacheMisses":30,"numEvictions":31,"compactionBytesSaved":32,"deviceMemoryUsed":33},)json"
         R"json("imageSourceFactory":{)json"
         R"json("fileSources":{"numImageSources":8,"totalTilesRead":9,"totalBytesRead":10,"totalReadTime":11},)json"
         R"json("alphaSources":{"numImageSources":0,"totalTilesRead":0,"totalBytesRead":0,"totalReadTime":0},)json"
@@ -474,7 +474,7 @@ TEST_F( TestMaterialResolverRequestedProxyIds, resolveAlphaCutOutMaterialPartial
 {
     const uint_t proxyGeomId{ 1111 };
     m_geom.groups[0].material.flags = MaterialFlags::ALPHA_MAP;
-    TriangleUVs* fakeUVs{ reinterpret_cast<TriangleUVs*>( 0xdeadbeefULL ) };
+    IndexedUVs* fakeUVs{ reinterpret_cast<IndexedUVs*>( 0xdeadbeefULL ) };
     m_geom.devUVs                     = fakeUVs;
     m_geom.groups[0].alphaMapFileName = ALPHA_MAP_PATH;
     EXPECT_CALL( *m_demandTextureCache, hasAlphaTextureForFile( _ ) ).WillOnce( Return( false ) );
@@ -506,7 +506,7 @@ TEST_F( TestMaterialResolverRequestedProxyIds, resolveAlphaCutOutMaterialFull )
     const uint_t alphaTextureId{ 333 };
     m_geom.groups[0].material.flags          = MaterialFlags::ALPHA_MAP | MaterialFlags::ALPHA_MAP_ALLOCATED;
     m_geom.groups[0].material.alphaTextureId = alphaTextureId;
-    TriangleUVs* fakeUVs{ reinterpret_cast<TriangleUVs*>( 0xdeadbeefULL ) };
+    IndexedUVs* fakeUVs{ reinterpret_cast<IndexedUVs*>( 0xdeadbeefULL ) };
     m_geom.devUVs                     = fakeUVs;
     m_geom.groups[0].alphaMapFileName = ALPHA_MAP_PATH;
     EXPECT_CALL( *m_demandTextureCache, hasAlphaTextureForFile( _ ) ).WillOnce( Return( false ) );
@@ -542,9 +542,9 @@ TEST_F( TestMaterialResolverRequestedProxyIds, resolveAlphaCutOutMaterialFull )
 
 TEST_F( TestMaterialResolverRequestedProxyIds, resolveDiffuseMaterial )
 {
-    const uint_t     proxyGeomId{ 1111 };
-    TriangleUVs*     fakeUVs{ reinterpret_cast<TriangleUVs*>( 0xdeadbeefULL ) };
-    TriangleNormals* fakeNormals{ reinterpret_cast<TriangleNormals*>( 0xbaadf00dULL ) };
+    const uint_t    proxyGeomId{ 1111 };
+    IndexedUVs*     fakeUVs{ reinterpret_cast<IndexedUVs*>( 0xdeadbeefULL ) };
+    IndexedNormals* fakeNormals{ reinterpret_cast<IndexedNormals*>( 0xbaadf00dULL ) };
     m_geom.groups[0].material.flags     = MaterialFlags::DIFFUSE_MAP;
     m_geom.devUVs                       = fakeUVs;
     m_geom.devNormals                   = fakeNormals;
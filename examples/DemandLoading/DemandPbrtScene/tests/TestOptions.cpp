@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2023-2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2023-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -315,6 +315,20 @@ TEST_F( TestOptions, missingWarmupCountInvalid )
     const demandPbrtScene::Options options = getOptions( { "DemandPbrtScene", "--warmup=", "scene.pbrt" } );
 }
 
+TEST_F( TestOptions, attributesNotQuantizedByDefault )
+{
+    const demandPbrtScene::Options options = getOptions( { "DemandPbrtScene", "scene.pbrt" } );
+
+    EXPECT_FALSE( options.quantizeAttributes );
+}
+
+TEST_F( TestOptions, quantizeAttributes )
+{
+    const demandPbrtScene::Options options = getOptions( { "DemandPbrtScene", "--quantize-attributes", "scene.pbrt" } );
+
+    EXPECT_TRUE( options.quantizeAttributes );
+}
+
 TEST_F( TestOptions, parseDebugPixel )
 {
     const demandPbrtScene::Options options = getOptions( { "DemandPbrtScene", "--debug=384/256", "scene.pbrt" } );
@@ -545,6 +545,7 @@ class MockGeometryCache : public StrictMock<GeometryCache>
                    const ShapeList&        shapes,
                    GeometryPrimitive       primitive,
                    MaterialFlags           flags ) );
+    MOCK_METHOD( void, releaseEntry, (const GeometryCacheEntry&), ( override ) );
     MOCK_METHOD( GeometryCacheStatistics, getStatistics, (), ( const override ) );
 };
 
@@ -725,18 +726,25 @@ class TestSceneProxy : public Test
         {
             if( !shape.triangleMesh.normals.empty() )
             {
-                entry.devNormals = otk::bit_cast<TriangleNormals*>( 0xbaadf00dbaaabaaaULL );
+                entry.devNormals = otk::bit_cast<IndexedNormals*>( 0xbaadf00dbaaabaaaULL );
             }
             if( !shape.triangleMesh.uvs.empty() )
             {
-                entry.devUVs = otk::bit_cast<TriangleUVs*>( 0xbaaabaaaf00dbaadULL );
+                entry.devUVs = otk::bit_cast<IndexedUVs*>( 0xbaaabaaaf00dbaadULL );
             }
         }
         entry.primitiveGroupEndIndices.push_back( ARBITRARY_PRIMITIVE_GROUP_END );
         EXPECT_CALL( *m_geometryCache, getShape( m_fakeContext, m_stream, shape ) ).WillOnce( Return( entry ) );
+        expectEntryReleased( entry );
         return entry;
     }
 
+    // The proxy releases the geometry it created when it is destroyed.
+    void expectEntryReleased( const GeometryCacheEntry& entry )
+    {
+        EXPECT_CALL( *m_geometryCache, releaseEntry( Field( &GeometryCacheEntry::accelBuffer, entry.accelBuffer ) ) );
+    }
+
     CUstream               m_stream{ otk::bit_cast<CUstream>( 0xbaadfeedfeedfeedULL ) };
     uint_t                 m_pageId{ 10 };
     MockGeometryLoaderPtr  m_geometryLoader{ std::make_shared<MockGeometryLoader>() };
@@ -797,6 +805,28 @@ TEST_F( TestSceneProxy, constructTriangleASForSingleTriangleMesh )
     EXPECT_EQ( nullptr, geom.devUVs );
 }
 
+TEST_F( TestSceneProxy, destroyingProxyReleasesGeometry )
+{
+    m_scene = singleTriangleScene();
+    expectProxyBoundsAdded( m_scene->bounds, m_pageId );
+    m_proxy = m_factory->scene( m_scene );
+    GeometryCacheEntry entry{};
+    entry.accelBuffer = CUdeviceptr{ 0xf00dbaadf00dbaadULL };
+    entry.traversable = m_fakeGeometryAS;
+    entry.primitiveGroupEndIndices.push_back( ARBITRARY_PRIMITIVE_GROUP_END );
+    MockFunction<void()> geometryCreated;
+    {
+        InSequence sequence;
+        EXPECT_CALL( *m_geometryCache, getShape( m_fakeContext, m_stream, m_scene->freeShapes[0] ) ).WillOnce( Return( entry ) );
+        EXPECT_CALL( geometryCreated, Call() );
+        expectEntryReleased( entry );
+    }
+
+    m_proxy->createGeometry( m_fakeContext, m_stream );
+    geometryCreated.Call();
+    m_proxy.reset();
+}
+
 TEST_F( TestSceneProxy, constructTriangleASForSingleTriangleMeshWithNormals )
 {
     m_scene = singleTriangleWithNormalsScene();
@@ -1296,6 +1326,7 @@ TEST_F( TestSceneProxy, coarseObjectSamePrimitiveYieldsSingleGeometry )
     EXPECT_CALL( *m_geometryCache, getObject( m_fakeContext, m_stream, m_scene->objects[name], m_scene->objectShapes[name],
                                               GeometryPrimitive::TRIANGLE, MaterialFlags::NONE ) )
         .WillOnce( Return( triangles ) );
+    expectEntryReleased( triangles );
 
     const GeometryInstance geom{ m_proxy->createGeometry( m_fakeContext, m_stream ) };
 
@@ -1352,6 +1383,7 @@ TEST_F( TestSceneProxy, coarseObjectInstanceMixedMaterialsGeometry )
     EXPECT_CALL( *m_geometryCache,
                  getObject( m_fakeContext, m_stream, m_scene->objects[name], m_scene->objectShapes[name], primitive, flags ) )
         .WillOnce( Return( triangles ) );
+    expectEntryReleased( triangles );
 
     const GeometryInstance geom{ m_proxy->createGeometry( m_fakeContext, m_stream ) };
 
@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: Copyright (c) 2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-License-Identifier: BSD-3-Clause
+//
+
+#include <DemandPbrtScene/VertexAttributes.h>
+
+#include <OptiXToolkit/ShaderUtil/vec_math.h>
+#include <OptiXToolkit/ShaderUtil/vec_printers.h>
+
+#include <gtest/gtest.h>
+
+#include <vector_functions.h>
+
+using namespace demandPbrtScene;
+using namespace otk;
+
+namespace {
+
+void expectNear( const float3& expected, const float3& actual, float tolerance )
+{
+    EXPECT_NEAR( expected.x, actual.x, tolerance ) << expected << " != " << actual;
+    EXPECT_NEAR( expected.y, actual.y, tolerance ) << expected << " != " << actual;
+    EXPECT_NEAR( expected.z, actual.z, tolerance ) << expected << " != " << actual;
+}
+
+}  // namespace
+
+TEST( TestOctahedralNormal, zeroNormalUsesReservedCode )
+{
+    const uint_t bits{ encodeOctahedralNormal( make_float3( 0.0f, 0.0f, 0.0f ) ) };
+
+    EXPECT_EQ( OCTAHEDRAL_ZERO_NORMAL, bits );
+    EXPECT_EQ( make_float3( 0.0f, 0.0f, 0.0f ), decodeOctahedralNormal( bits ) );
+}
+
+TEST( TestOctahedralNormal, axisNormalsRoundTripExactly )
+{
+    const float3 normals[]{ make_float3( 1.0f, 0.0f, 0.0f ), make_float3( -1.0f, 0.0f, 0.0f ),
+                            make_float3( 0.0f, 1.0f, 0.0f ), make_float3( 0.0f, -1.0f, 0.0f ),
+                            make_float3( 0.0f, 0.0f, 1.0f ), make_float3( 0.0f, 0.0f, -1.0f ) };
+
+    for( const float3& normal : normals )
+    {
+        EXPECT_EQ( normal, decodeOctahedralNormal( encodeOctahedralNormal( normal ) ) );
+    }
+}
+
+TEST( TestOctahedralNormal, unitNormalsRoundTripWithinTolerance )
+{
+    const float3 normals[]{ normalize( make_float3( 1.0f, 2.0f, 3.0f ) ), normalize( make_float3( -1.0f, 2.0f, -3.0f ) ),
+                            normalize( make_float3( 0.3f, -0.7f, -0.1f ) ), normalize( make_float3( -5.0f, -1.0f, 0.5f ) ) };
+
+    for( const float3& normal : normals )
+    {
+        const float3 decoded{ decodeOctahedralNormal( encodeOctahedralNormal( normal ) ) };
+
+        expectNear( normal, decoded, 1.0e-4f );
+        EXPECT_NEAR( 1.0f, length( decoded ), 1.0e-6f );
+    }
+}
+
+TEST( TestOctahedralNormal, encodingIgnoresLength )
+{
+    const float3 normal{ make_float3( 2.0f, -4.0f, 4.0f ) };
+
+    EXPECT_EQ( encodeOctahedralNormal( normalize( normal ) ), encodeOctahedralNormal( normal ) );
+}
+
+TEST( TestQuantizedUV, boundsQuantizeToEndpoints )
+{
+    const float2 uvMin{ make_float2( -1.0f, 2.0f ) };
+    const float2 uvMax{ make_float2( 3.0f, 4.0f ) };
+    const float2 scale{ quantizedUVScale( uvMin, uvMax ) };
+
+    const ushort2 low{ quantizeUV( uvMin, uvMin, scale ) };
+    const ushort2 high{ quantizeUV( uvMax, uvMin, scale ) };
+
+    EXPECT_EQ( 0, low.x );
+    EXPECT_EQ( 0, low.y );
+    EXPECT_EQ( 65535, high.x );
+    EXPECT_EQ( 65535, high.y );
+}
+
+TEST( TestQuantizedUV, roundTripsWithinOneStep )
+{
+    const float2 uvMin{ make_float2( -1.0f, 2.0f ) };
+    const float2 uvMax{ make_float2( 3.0f, 4.0f ) };
+    const float2 scale{ quantizedUVScale( uvMin, uvMax ) };
+    const float2 uv{ make_float2( 0.123f, 3.456f ) };
+
+    const float2 decoded{ dequantizeUV( quantizeUV( uv, uvMin, scale ), uvMin, scale ) };
+
+    EXPECT_NEAR( uv.x, decoded.x, scale.x );
+    EXPECT_NEAR( uv.y, decoded.y, scale.y );
+}
+
+TEST( TestQuantizedUV, constantComponentDecodesToMinimum )
+{
+    const float2 uvMin{ make_float2( 0.5f, 0.25f ) };
+    const float2 uvMax{ make_float2( 0.5f, 1.0f ) };
+    const float2 scale{ quantizedUVScale( uvMin, uvMax ) };
+
+    const float2 decoded{ dequantizeUV( quantizeUV( make_float2( 0.5f, 1.0f ), uvMin, scale ), uvMin, scale ) };
+
+    EXPECT_EQ( 0.5f, decoded.x );
+    EXPECT_NEAR( 1.0f, decoded.y, scale.y );
+}
+
+TEST( TestFetchVertexNormals, readsNormalsThroughIndices )
+{
+    const uint3          indices[]{ make_uint3( 0, 1, 2 ), make_uint3( 2, 1, 3 ) };
+    const float3         normals[]{ make_float3( 1.0f, 0.0f, 0.0f ), make_float3( 0.0f, 1.0f, 0.0f ),
+                                    make_float3( 0.0f, 0.0f, 1.0f ), make_float3( -1.0f, 0.0f, 0.0f ) };
+    const IndexedNormals indexed{ indices, normals, nullptr };
+
+    float3 result[3];
+    fetchVertexNormals( indexed, 1, result );
+
+    EXPECT_EQ( normals[2], result[0] );
+    EXPECT_EQ( normals[1], result[1] );
+    EXPECT_EQ( normals[3], result[2] );
+}
+
+TEST( TestFetchVertexNormals, decodesOctahedralNormals )
+{
+    const uint3          indices[]{ make_uint3( 2, 0, 1 ) };
+    const float3         normals[]{ make_float3( 1.0f, 0.0f, 0.0f ), make_float3( 0.0f, -1.0f, 0.0f ),
+                                    make_float3( 0.0f, 0.0f, -1.0f ) };
+    const uint_t         octNormals[]{ encodeOctahedralNormal( normals[0] ), encodeOctahedralNormal( normals[1] ),
+                                       encodeOctahedralNormal( normals[2] ) };
+    const IndexedNormals indexed{ indices, nullptr, octNormals };
+
+    float3 result[3];
+    fetchVertexNormals( indexed, 0, result );
+
+    EXPECT_EQ( normals[2], result[0] );
+    EXPECT_EQ( normals[0], result[1] );
+    EXPECT_EQ( normals[1], result[2] );
+}
+
+TEST( TestFetchVertexUVs, readsUVsThroughIndices )
+{
+    const uint3      indices[]{ make_uint3( 0, 1, 2 ), make_uint3( 3, 2, 1 ) };
+    const float2     uvs[]{ make_float2( 0.0f, 0.0f ), make_float2( 1.0f, 0.0f ), make_float2( 1.0f, 1.0f ),
+                            make_float2( 0.0f, 1.0f ) };
+    const IndexedUVs indexed{ indices, uvs, nullptr, {}, {} };
+
+    float2 result[3];
+    fetchVertexUVs( indexed, 1, result );
+
+    EXPECT_EQ( uvs[3], result[0] );
+    EXPECT_EQ( uvs[2], result[1] );
+    EXPECT_EQ( uvs[1], result[2] );
+}
+
+TEST( TestFetchVertexUVs, dequantizesUVs )
+{
+    const uint3      indices[]{ make_uint3( 1, 2, 0 ) };
+    const float2     uvMin{ make_float2( 0.0f, 0.0f ) };
+    const float2     scale{ quantizedUVScale( uvMin, make_float2( 2.0f, 1.0f ) ) };
+    const ushort2    quantized[]{ quantizeUV( make_float2( 0.0f, 0.0f ), uvMin, scale ),
+                                  quantizeUV( make_float2( 2.0f, 0.0f ), uvMin, scale ),
+                                  quantizeUV( make_float2( 2.0f, 1.0f ), uvMin, scale ) };
+    const IndexedUVs indexed{ indices, nullptr, quantized, uvMin, scale };
+
+    float2 result[3];
+    fetchVertexUVs( indexed, 0, result );
+
+    EXPECT_NEAR( 2.0f, result[0].x, scale.x );
+    EXPECT_NEAR( 0.0f, result[0].y, scale.y );
+    EXPECT_NEAR( 2.0f, result[1].x, scale.x );
+    EXPECT_NEAR( 1.0f, result[1].y, scale.y );
+    EXPECT_NEAR( 0.0f, result[2].x, scale.x );
+    EXPECT_NEAR( 0.0f, result[2].y, scale.y );
+}
@@ -1,4 +1,4 @@
-// SPDX-FileCopyrightText: Copyright (c) 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+// SPDX-FileCopyrightText: Copyright (c) 2024-2026 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
 // SPDX-License-Identifier: BSD-3-Clause
 //
 
@@ -25,14 +25,16 @@ inline std::ostream& operator<<( std::ostream& str, const InfiniteLight& value )
                << ", textureId: " << value.skyboxTextureId << " }";
 }
 
-inline std::ostream& operator<<( std::ostream& str, const TriangleNormals& value )
+inline std::ostream& operator<<( std::ostream& str, const IndexedNormals& value )
 {
-    return str << "0: " << value.N[0] << ", 1: " << value.N[1] << ", 2: " << value.N[2];
+    return str << "IndexedNormals{ indices: " << value.indices << ", normals: " << value.normals
+               << ", octNormals: " << value.octNormals << " }";
 }
 
-inline std::ostream& operator<<( std::ostream& str, const TriangleUVs& value )
+inline std::ostream& operator<<( std::ostream& str, const IndexedUVs& value )
 {
-    return str << "0: " << value.UV[0] << ", 1: " << value.UV[1] << ", 2: " << value.UV[2];
+    return str << "IndexedUVs{ indices: " << value.indices << ", uvs: " << value.uvs << ", quantizedUVs: " << value.quantizedUVs
+               << ", min: " << value.uvMin << ", scale: " << value.uvScale << " }";
 }
 
 inline std::ostream& operator<<( std::ostream& str, const PartialMaterial& value )